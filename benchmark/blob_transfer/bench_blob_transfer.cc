@@ -0,0 +1,97 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "client/client.h"
+#include "client/rpc_client.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+/**
+ * Benchmark for (striped) blob transfer over RPC, e.g., over loopback:
+ *
+ *    ./vineyardd --socket=/tmp/vineyard.sock --rpc_socket_port=9600
+ *    ./bench_blob_transfer 127.0.0.1:9600 1024 8
+ *
+ * which transfers a 1024MB blob with 1, 2, 4 and 8 connections.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_blob_transfer <rpc_endpoint> [size in MB] "
+        "[max connections] [chunk size in KB]\n");
+    return 1;
+  }
+  std::string rpc_endpoint(argv[1]);
+  size_t size = (argc > 2 ? std::stoul(argv[2]) : 256) * 1024 * 1024;
+  size_t max_connections = argc > 3 ? std::stoul(argv[3]) : 8;
+  size_t chunk_size = argc > 4 ? std::stoul(argv[4]) * 1024
+                               : RPCClient::default_transfer_chunk_size;
+
+  RPCClient client;
+  VINEYARD_CHECK_OK(client.Connect(rpc_endpoint));
+
+  // half random and half zero-filled content, to make the compression
+  // neither trivial nor useless.
+  auto writer = RemoteBlobWriter::Make(size);
+  {
+    std::mt19937_64 rng(42);
+    uint64_t* data = reinterpret_cast<uint64_t*>(writer->data());
+    for (size_t index = 0; index < size / sizeof(uint64_t); ++index) {
+      data[index] = (index / 4096) % 2 == 0 ? rng() : 0;
+    }
+  }
+
+  auto throughput = [size](std::chrono::steady_clock::time_point start) {
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    return static_cast<double>(size) / 1024 / 1024 / 1024 / seconds;
+  };
+
+  for (size_t connections = 1; connections <= max_connections;
+       connections *= 2) {
+    VINEYARD_CHECK_OK(client.SetTransferConcurrency(connections, chunk_size));
+
+    auto start = std::chrono::steady_clock::now();
+    ObjectID blob_id = InvalidObjectID();
+    VINEYARD_CHECK_OK(client.CreateRemoteBlob(writer, blob_id));
+    double put_throughput = throughput(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<RemoteBlob>> blobs;
+    VINEYARD_CHECK_OK(client.GetRemoteBlobs({blob_id}, blobs));
+    double get_throughput = throughput(start);
+
+    CHECK_EQ(blobs[0]->allocated_size(), size);
+    CHECK_EQ(memcmp(blobs[0]->data(), writer->data(), size), 0);
+    VINEYARD_CHECK_OK(client.DelData(blob_id));
+
+    LOG(INFO) << "connections = " << connections
+              << ", chunk size = " << chunk_size
+              << ": put = " << put_throughput << " GB/s"
+              << ", get = " << get_throughput << " GB/s";
+  }
+
+  client.Disconnect();
+  return 0;
+}
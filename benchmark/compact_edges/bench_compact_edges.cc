@@ -0,0 +1,146 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basic/ds/arrow.h"
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/property_graph_types.h"
+#include "graph/fragment/property_graph_utils_impl.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using nbr_unit_t = property_graph_utils::NbrUnit<uint64_t, uint64_t>;
+
+/**
+ * Benchmark for the compact (varint + delta encoded) edges of fragments,
+ * compared with the plain CSR, e.g.,
+ *
+ *    ./bench_compact_edges /var/run/vineyard.sock 1048576 16 8
+ *
+ * which generates a random graph of 1M vertices with an average degree of
+ * 16, and reports the encoding time with 1 thread and with 8 threads, the
+ * compression ratio and the throughput of scanning all neighbors, for both
+ * the varint (v8) and the StreamVByte codecs.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_compact_edges <ipc_socket> [<vertices>] [<degree>] "
+        "[<threads>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  uint64_t vnum = argc > 2 ? std::stoul(argv[2]) : 1024 * 1024;
+  uint64_t degree = argc > 3 ? std::stoul(argv[3]) : 16;
+  int concurrency =
+      argc > 4 ? std::stoi(argv[4])
+               : std::max<int>(std::thread::hardware_concurrency(), 1);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  // a random graph whose adjacency lists are sorted, as the fragment does
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<uint64_t> degrees(0, degree * 2);
+  std::uniform_int_distribution<uint64_t> vertices(0, vnum - 1);
+  auto offsets = std::make_shared<FixedInt64Builder>(client, vnum + 1);
+  offsets->data()[0] = 0;
+  for (uint64_t v = 0; v < vnum; ++v) {
+    offsets->data()[v + 1] = offsets->data()[v] + degrees(rng);
+  }
+  const int64_t enum_ = offsets->data()[vnum];
+  std::vector<nbr_unit_t> edges(enum_);
+  for (int64_t e = 0; e < enum_; ++e) {
+    edges[e] = nbr_unit_t(vertices(rng), e);
+  }
+  for (uint64_t v = 0; v < vnum; ++v) {
+    std::sort(edges.begin() + offsets->data()[v],
+              edges.begin() + offsets->data()[v + 1],
+              [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+                return lhs.vid < rhs.vid;
+              });
+  }
+  const int64_t* raw_offsets = offsets->data();
+
+  auto measure = [](auto&& fn) {
+    auto start = GetCurrentTime();
+    fn();
+    return GetCurrentTime() - start;
+  };
+
+  uint64_t expected = 0;
+  double plain_seconds = measure([&]() {
+    for (uint64_t v = 0; v < vnum; ++v) {
+      for (int64_t e = raw_offsets[v]; e < raw_offsets[v + 1]; ++e) {
+        expected += edges[e].vid;
+      }
+    }
+  });
+
+  for (auto codec :
+       {CompactEdgesCodec::kVarint8, CompactEdgesCodec::kStreamVByte}) {
+    for (int threads : {1, concurrency}) {
+      std::shared_ptr<PodArrayBuilder<nbr_unit_t>> e_list;
+      VINEYARD_CHECK_OK(
+          PodArrayBuilder<nbr_unit_t>::Make(client, enum_, e_list));
+      memcpy(e_list->data(), edges.data(), enum_ * sizeof(nbr_unit_t));
+      std::shared_ptr<FixedUInt8Builder> ce_list;
+      std::shared_ptr<FixedInt64Builder> e_boffsets;
+      double encode_seconds = measure([&]() {
+        CHECK(varint_encoding_edges_impl<uint64_t, uint64_t>(
+            client, e_list, ce_list, offsets, e_boffsets, codec, threads));
+      });
+
+      const uint8_t* encoded = ce_list->data();
+      const int64_t* boffsets = e_boffsets->data();
+      uint64_t sum = 0;
+      double compact_seconds = measure([&]() {
+        for (uint64_t v = 0; v < vnum; ++v) {
+          property_graph_utils::CompactAdjList<uint64_t, uint64_t> adj_list(
+              encoded + boffsets[v], encoded + boffsets[v + 1],
+              raw_offsets[v + 1] - raw_offsets[v], nullptr, codec);
+          for (auto& nbr : adj_list) {
+            sum += nbr.neighbor().GetValue();
+          }
+        }
+      });
+      CHECK_EQ(sum, expected);
+
+      double ratio = static_cast<double>(boffsets[vnum]) /
+                     (enum_ * sizeof(nbr_unit_t));
+      LOG(INFO) << (codec == CompactEdgesCodec::kVarint8 ? "varint"
+                                                         : "streamvbyte")
+                << ", " << threads << " threads: encoding = " << encode_seconds
+                << " s, compression ratio = " << ratio
+                << ", scan = " << enum_ / compact_seconds / 1e6
+                << " M edges/s (plain CSR: " << enum_ / plain_seconds / 1e6
+                << " M edges/s)";
+    }
+  }
+
+  client.Disconnect();
+  return 0;
+}
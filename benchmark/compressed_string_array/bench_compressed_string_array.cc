@@ -0,0 +1,164 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow.h"
+#include "basic/ds/compressed_string_array.h"
+#include "basic/ds/hashmap.h"
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+std::shared_ptr<arrow::LargeStringArray> generate_keys(const std::string& kind,
+                                                       const int64_t count) {
+  std::mt19937_64 rng(0);
+  arrow::LargeStringBuilder builder;
+  char buffer[128];
+  for (int64_t i = 0; i < count; ++i) {
+    if (kind == "url") {
+      snprintf(buffer, sizeof(buffer),
+               "http://dbpedia.org/resource/Category:Entity_%ld",
+               static_cast<long>(i));  // NOLINT(runtime/int)
+    } else {
+      snprintf(buffer, sizeof(buffer), "%08lx-%04lx-4%03lx-a%03lx-%012lx",
+               static_cast<unsigned long>(rng() & 0xffffffff),  // NOLINT
+               static_cast<unsigned long>(rng() & 0xffff),      // NOLINT
+               static_cast<unsigned long>(rng() & 0xfff),       // NOLINT
+               static_cast<unsigned long>(rng() & 0xfff),       // NOLINT
+               static_cast<unsigned long>(rng() & 0xffffffffffff));  // NOLINT
+    }
+    CHECK_ARROW_ERROR(builder.Append(buffer));
+  }
+  std::shared_ptr<arrow::Array> array;
+  CHECK_ARROW_ERROR(builder.Finish(&array));
+  return std::dynamic_pointer_cast<arrow::LargeStringArray>(array);
+}
+
+/**
+ * Benchmark for the compressed string oids, compared with the string array
+ * and the hashmap that the vertex map uses, e.g.,
+ *
+ *    ./bench_compressed_string_array /var/run/vineyard.sock 4194304
+ *
+ * which stores 4M URLs and 4M UUIDs in both ways, and reports the memory
+ * usage, the latency of looking up keys and of accessing keys by index.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./bench_compressed_string_array <ipc_socket> [<keys>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  int64_t count = argc > 2 ? std::stol(argv[2]) : 4 * 1024 * 1024;
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  std::mt19937_64 rng(1);
+  std::uniform_int_distribution<int64_t> indices(0, count - 1);
+  std::vector<int64_t> queries(1024 * 1024);
+  for (auto& query : queries) {
+    query = indices(rng);
+  }
+
+  auto measure = [&](auto&& fn) {
+    auto start = GetCurrentTime();
+    fn();
+    return (GetCurrentTime() - start) * 1e9 / queries.size();
+  };
+
+  for (std::string kind : {"url", "uuid"}) {
+    auto keys = generate_keys(kind, count);
+
+    // the oid array and the hashmap, as the vertex map does
+    using hashmap_t = Hashmap<arrow_string_view, int64_t>;
+    std::shared_ptr<Object> object;
+    LargeStringArrayBuilder array_builder(client, keys);
+    VINEYARD_CHECK_OK(array_builder.Seal(client, object));
+    auto array = std::dynamic_pointer_cast<LargeStringArray>(object);
+    HashmapBuilder<arrow_string_view, int64_t> hashmap_builder(client);
+    hashmap_builder.AssociateDataBuffer(array->GetBuffer());
+    hashmap_builder.reserve(count);
+    for (int64_t i = 0; i < count; ++i) {
+      hashmap_builder.emplace(array->GetArray()->GetView(i), i);
+    }
+    VINEYARD_CHECK_OK(hashmap_builder.Seal(client, object));
+    auto hashmap = std::dynamic_pointer_cast<hashmap_t>(object);
+    size_t plain_bytes =
+        array->meta().MemoryUsage() +
+        hashmap->bucket_count() * sizeof(hashmap_t::Entry);
+
+    auto start = GetCurrentTime();
+    CompressedStringArrayBuilder compressed_builder(client, keys);
+    VINEYARD_CHECK_OK(compressed_builder.Seal(client, object));
+    double build_seconds = GetCurrentTime() - start;
+    auto compressed = std::dynamic_pointer_cast<CompressedStringArray>(object);
+    size_t compressed_bytes = compressed->meta().MemoryUsage();
+
+    int64_t plain_sum = 0, compressed_sum = 0;
+    double plain_find = measure([&]() {
+      for (int64_t query : queries) {
+        plain_sum += hashmap->find(keys->GetView(query))->second;
+      }
+    });
+    double compressed_find = measure([&]() {
+      for (int64_t query : queries) {
+        compressed_sum += compressed->Find(keys->GetView(query));
+      }
+    });
+    CHECK_EQ(plain_sum, compressed_sum);
+
+    size_t plain_length = 0, compressed_length = 0;
+    double plain_access = measure([&]() {
+      for (int64_t query : queries) {
+        plain_length += array->GetArray()->GetView(query).size();
+      }
+    });
+    std::string value;
+    double compressed_access = measure([&]() {
+      for (int64_t query : queries) {
+        compressed->GetString(query, value);
+        compressed_length += value.size();
+      }
+    });
+    CHECK_EQ(plain_length, compressed_length);
+
+    LOG(INFO) << count << " " << kind << "s: memory = " << plain_bytes
+              << " bytes (plain), " << compressed_bytes
+              << " bytes (compressed, built in " << build_seconds
+              << " s); lookup = " << plain_find << " ns (plain), "
+              << compressed_find << " ns (compressed); access by index = "
+              << plain_access << " ns (plain), " << compressed_access
+              << " ns (compressed)";
+
+    VINEYARD_CHECK_OK(client.DelData(
+        {array->id(), hashmap->id(), compressed->id()}, true, true));
+  }
+
+  client.Disconnect();
+  return 0;
+}
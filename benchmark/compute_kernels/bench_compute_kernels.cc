@@ -0,0 +1,179 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "arrow/api.h"
+#include "arrow/compute/api.h"
+
+#include "basic/ds/arrow.h"
+#include "basic/ds/compute.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+/**
+ * Benchmark for the compute kernels on vineyard arrays, compared with
+ * arrow's compute functions on the same arrays, e.g.,
+ *
+ *    ./bench_compute_kernels /var/run/vineyard.sock 64 8
+ *
+ * which runs sum, min/max, filter, take and cast on an array of 64M doubles,
+ * with 1 thread and with 8 threads.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_compute_kernels <ipc_socket> [<M elements>] "
+        "[<threads>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  int64_t length = (argc > 2 ? std::stol(argv[2]) : 64) * 1024 * 1024;
+  size_t concurrency =
+      argc > 3 ? std::stoul(argv[3])
+               : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  std::shared_ptr<FixedNumericArrayBuilder<double>> values_builder;
+  std::shared_ptr<FixedNumericArrayBuilder<int64_t>> indices_builder;
+  VINEYARD_CHECK_OK(
+      FixedNumericArrayBuilder<double>::Make(client, length, values_builder));
+  VINEYARD_CHECK_OK(
+      FixedNumericArrayBuilder<int64_t>::Make(client, length, indices_builder));
+  arrow::BooleanBuilder mask_builder;
+  CHECK_ARROW_ERROR(mask_builder.Reserve(length));
+  for (int64_t i = 0; i < length; ++i) {
+    values_builder->data()[i] = i * 0.5;
+    indices_builder->data()[i] = (i * 7919) % length;
+    mask_builder.UnsafeAppend(i % 3 != 0);
+  }
+  std::shared_ptr<arrow::BooleanArray> arrow_mask;
+  CHECK_ARROW_ERROR(mask_builder.Finish(&arrow_mask));
+
+  auto values = std::dynamic_pointer_cast<NumericArray<double>>(
+      values_builder->Seal(client));
+  auto indices = std::dynamic_pointer_cast<NumericArray<int64_t>>(
+      indices_builder->Seal(client));
+  auto mask = std::dynamic_pointer_cast<BooleanArray>(
+      BooleanArrayBuilder(client, arrow_mask).Seal(client));
+
+  auto measure = [](auto&& fn) {
+    fn();  // warmup
+    auto start = std::chrono::steady_clock::now();
+    const int rounds = 5;
+    for (int round = 0; round < rounds; ++round) {
+      fn();
+    }
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           rounds;
+  };
+  auto drop = [&](std::shared_ptr<Object> const& object) {
+    VINEYARD_CHECK_OK(client.DelData(object->id(), false, true));
+  };
+
+  for (size_t threads : {static_cast<size_t>(1), concurrency}) {
+    compute::ComputeOptions options;
+    options.concurrency = threads;
+    std::string result = std::to_string(threads) + " threads: ";
+    result += "sum = " + std::to_string(measure([&]() {
+                double sum = 0;
+                VINEYARD_CHECK_OK(compute::Sum(*values, sum, options));
+              })) +
+              " ms";
+    result += ", min/max = " + std::to_string(measure([&]() {
+                double min_value = 0, max_value = 0;
+                VINEYARD_CHECK_OK(compute::Min(*values, min_value, options));
+                VINEYARD_CHECK_OK(compute::Max(*values, max_value, options));
+              })) +
+              " ms";
+    result += ", filter = " + std::to_string(measure([&]() {
+                std::shared_ptr<NumericArray<double>> out;
+                VINEYARD_CHECK_OK(
+                    compute::Filter(client, *values, *mask, out, options));
+                drop(out);
+              })) +
+              " ms";
+    result += ", take = " + std::to_string(measure([&]() {
+                std::shared_ptr<NumericArray<double>> out;
+                VINEYARD_CHECK_OK(
+                    compute::Take(client, *values, *indices, out, options));
+                drop(out);
+              })) +
+              " ms";
+    result += ", cast = " + std::to_string(measure([&]() {
+                std::shared_ptr<NumericArray<int32_t>> out;
+                VINEYARD_CHECK_OK(compute::Cast(client, *values, out, options));
+                drop(out);
+              })) +
+              " ms";
+    LOG(INFO) << result;
+  }
+
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 1000000
+  {
+    // arrow's kernels allocate the results from the default memory pool
+    arrow::Datum arrow_values(
+        std::static_pointer_cast<arrow::Array>(values->GetArray()));
+    arrow::Datum arrow_indices(
+        std::static_pointer_cast<arrow::Array>(indices->GetArray()));
+    arrow::Datum arrow_filter(
+        std::static_pointer_cast<arrow::Array>(arrow_mask));
+    std::string result = "arrow compute: ";
+    result += "sum = " + std::to_string(measure([&]() {
+                CHECK_ARROW_ERROR(arrow::compute::Sum(arrow_values).status());
+              })) +
+              " ms";
+    result += ", min/max = " + std::to_string(measure([&]() {
+                CHECK_ARROW_ERROR(
+                    arrow::compute::MinMax(arrow_values).status());
+              })) +
+              " ms";
+    result += ", filter = " + std::to_string(measure([&]() {
+                CHECK_ARROW_ERROR(
+                    arrow::compute::Filter(arrow_values, arrow_filter)
+                        .status());
+              })) +
+              " ms";
+    result += ", take = " + std::to_string(measure([&]() {
+                CHECK_ARROW_ERROR(
+                    arrow::compute::Take(arrow_values, arrow_indices).status());
+              })) +
+              " ms";
+    result += ", cast = " + std::to_string(measure([&]() {
+                arrow::compute::CastOptions cast_options =
+                    arrow::compute::CastOptions::Unsafe(arrow::int32());
+                CHECK_ARROW_ERROR(
+                    arrow::compute::Cast(arrow_values, cast_options).status());
+              })) +
+              " ms";
+    LOG(INFO) << result;
+  }
+#endif
+
+  VINEYARD_CHECK_OK(client.DelData({values->id(), indices->id(), mask->id()},
+                                   false, true));
+  client.Disconnect();
+  return 0;
+}
@@ -0,0 +1,180 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/utils/partitioner.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = int64_t;
+
+/**
+ * Reports how the partitioning would shape the fragments: every fragment
+ * keeps the edges of its inner vertices, thus a cut edge is stored on both
+ * sides, and its endpoints are replicated as outer vertices.
+ */
+template <typename PARTITIONER_T>
+void report(const std::string& name, const PARTITIONER_T& partitioner,
+            const fid_t fnum, const int64_t vnum,
+            const std::vector<oid_t>& srcs, const std::vector<oid_t>& dsts,
+            const double seconds) {
+  std::vector<fid_t> fids(vnum);
+  std::vector<size_t> vertex_load(fnum, 0), edge_load(fnum, 0);
+  for (oid_t v = 0; v < vnum; ++v) {
+    fids[v] = partitioner.GetPartitionId(v);
+    vertex_load[fids[v]] += 1;
+  }
+  // (fragment, vertex) pairs of the outer vertices
+  std::vector<std::pair<fid_t, oid_t>> outers;
+  size_t cut = 0;
+  for (size_t e = 0; e < srcs.size(); ++e) {
+    fid_t src_fid = fids[srcs[e]], dst_fid = fids[dsts[e]];
+    edge_load[src_fid] += 1;
+    if (src_fid != dst_fid) {
+      cut += 1;
+      edge_load[dst_fid] += 1;
+      outers.emplace_back(src_fid, dsts[e]);
+      outers.emplace_back(dst_fid, srcs[e]);
+    }
+  }
+  std::sort(outers.begin(), outers.end());
+  size_t replicas = std::unique(outers.begin(), outers.end()) - outers.begin();
+
+  auto imbalance = [](const std::vector<size_t>& loads) {
+    double sum = std::accumulate(loads.begin(), loads.end(), 0.0);
+    return *std::max_element(loads.begin(), loads.end()) * loads.size() / sum;
+  };
+  LOG(INFO) << name << ": edge-cut = "
+            << static_cast<double>(cut) / srcs.size()
+            << ", vertex balance (max/avg) = " << imbalance(vertex_load)
+            << ", edge balance (max/avg) = " << imbalance(edge_load)
+            << ", replication factor = "
+            << static_cast<double>(vnum + replicas) / vnum
+            << ", partitioning = " << seconds << " s";
+}
+
+template <typename PARTITIONER_T>
+void run_fennel(const std::string& name, PARTITIONER_T& partitioner,
+                const fid_t fnum, const int64_t vnum,
+                const std::vector<oid_t>& srcs,
+                const std::vector<oid_t>& dsts) {
+  auto start = GetCurrentTime();
+  partitioner.Init(fnum);
+  for (oid_t v = 0; v < vnum; ++v) {
+    partitioner.AddVertex(v);
+  }
+  for (size_t e = 0; e < srcs.size(); ++e) {
+    partitioner.AddEdge(srcs[e], dsts[e]);
+  }
+  partitioner.Finalize();
+  report(name, partitioner, fnum, vnum, srcs, dsts, GetCurrentTime() - start);
+}
+
+/**
+ * Benchmark for the graph partitioners, e.g.,
+ *
+ *    ./bench_graph_partitioner 1048576 16 16
+ *
+ * which generates a power-law graph of 1M vertices with an average degree of
+ * 16, where most edges fall into randomly scattered communities, and reports
+ * the edge-cut ratio, the balance of vertices and edges, and the replication
+ * factor of the hash, segmented, fennel, LDG and degree-aware fennel
+ * partitioning into 16 fragments.
+ */
+int main(int argc, char** argv) {
+  if (argc > 1 && std::string(argv[1]) == "--help") {
+    printf(
+        "usage ./bench_graph_partitioner [<vertices>] [<degree>] [<fnum>] "
+        "[<hub_degree>]");
+    return 1;
+  }
+  int64_t vnum = argc > 1 ? std::stol(argv[1]) : 1024 * 1024;
+  int64_t degree = argc > 2 ? std::stol(argv[2]) : 16;
+  fid_t fnum = argc > 3 ? std::stoi(argv[3]) : 16;
+  size_t hub_degree = argc > 4 ? std::stoul(argv[4]) : 16 * degree;
+
+  // skewed endpoints: small ranks are the hubs, and the ranks are shuffled
+  // so that neither hubs nor communities are contiguous in oids
+  std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::vector<oid_t> ranks(vnum);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  std::shuffle(ranks.begin(), ranks.end(), rng);
+  auto skewed = [&](const int64_t count) {
+    return std::min(static_cast<int64_t>(std::pow(uniform(rng), 3) * count),
+                    count - 1);
+  };
+  const int64_t community_size = std::max<int64_t>(vnum / 256, 1);
+  std::vector<oid_t> srcs(vnum * degree), dsts(vnum * degree);
+  for (size_t e = 0; e < srcs.size(); ++e) {
+    int64_t src_rank = skewed(vnum), dst_rank;
+    if (uniform(rng) < 0.8) {
+      // the community of a vertex is a range of ranks
+      int64_t base = src_rank / community_size * community_size;
+      dst_rank = std::min(base + skewed(community_size), vnum - 1);
+    } else {
+      dst_rank = skewed(vnum);
+    }
+    srcs[e] = ranks[src_rank];
+    dsts[e] = ranks[dst_rank];
+  }
+  LOG(INFO) << "Generated " << vnum << " vertices and " << srcs.size()
+            << " edges into " << fnum << " fragments";
+
+  {
+    auto start = GetCurrentTime();
+    HashPartitioner<oid_t> partitioner;
+    partitioner.Init(fnum);
+    report("hash", partitioner, fnum, vnum, srcs, dsts,
+           GetCurrentTime() - start);
+  }
+  {
+    auto start = GetCurrentTime();
+    std::vector<oid_t> oid_list(vnum);
+    std::iota(oid_list.begin(), oid_list.end(), 0);
+    SegmentedPartitioner<oid_t> partitioner;
+    partitioner.Init(fnum, oid_list);
+    report("segmented", partitioner, fnum, vnum, srcs, dsts,
+           GetCurrentTime() - start);
+  }
+  {
+    FennelPartitioner<oid_t> partitioner;
+    run_fennel("fennel", partitioner, fnum, vnum, srcs, dsts);
+  }
+  {
+    FennelPartitioner<oid_t> partitioner;
+    partitioner.set_mode(FennelPartitionerBase::Mode::kLDG);
+    run_fennel("ldg", partitioner, fnum, vnum, srcs, dsts);
+  }
+  {
+    FennelPartitioner<oid_t> partitioner;
+    partitioner.set_hub_degree_threshold(hub_degree);
+    run_fennel("fennel (hubs of degree > " + std::to_string(hub_degree) + ")",
+               partitioner, fnum, vnum, srcs, dsts);
+    LOG(INFO) << "placed " << partitioner.hub_num() << " hubs";
+  }
+  return 0;
+}
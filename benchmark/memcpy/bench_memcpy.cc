@@ -0,0 +1,94 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "common/memory/memcpy.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+/**
+ * Benchmark for memcpy of different sizes and concurrency, e.g.,
+ *
+ *    ./bench_memcpy 1024 16
+ *
+ * which copies buffers from 64KB up to 1024MB, with the `inline_memcpy`,
+ * the `nontemporal_memcpy`, the `concurrent_memcpy` with 1, 2, 4, ..., 16
+ * threads, and the self-tuned `concurrent_memcpy`.
+ */
+int main(int argc, char** argv) {
+  size_t max_size = (argc > 1 ? std::stoul(argv[1]) : 1024) * 1024 * 1024;
+  size_t max_concurrency =
+      argc > 2 ? std::stoul(argv[2])
+               : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  auto const& profile = memory::memcpy_profile();
+  LOG(INFO) << "L2 cache = " << profile.l2_cache_size
+            << ", L3 cache = " << profile.l3_cache_size
+            << ", concurrent threshold = " << profile.concurrent_threshold
+            << ", non-temporal threshold = " << profile.nontemporal_threshold
+            << ", max concurrency = " << profile.max_concurrency;
+
+  std::unique_ptr<uint8_t[]> src(new uint8_t[max_size]);
+  std::unique_ptr<uint8_t[]> dst(new uint8_t[max_size]);
+  memset(src.get(), 1, max_size);
+  memset(dst.get(), 0, max_size);
+
+  // repeat small copies to make the measurement meaningful
+  auto measure = [&](size_t size, auto&& copy) {
+    size_t rounds = std::max<size_t>(1, (256 * 1024 * 1024) / size);
+    copy(dst.get(), src.get(), size);  // warmup
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+      copy(dst.get(), src.get(), size);
+    }
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    CHECK_EQ(memcmp(dst.get(), src.get(), size), 0);
+    return static_cast<double>(size) * rounds / 1024 / 1024 / 1024 / seconds;
+  };
+
+  for (size_t size = 64 * 1024; size <= max_size; size *= 4) {
+    std::string result = "size = " + std::to_string(size / 1024) + "KB: ";
+    result += "inline = " +
+              std::to_string(measure(size, memory::inline_memcpy)) + " GB/s";
+    result += ", non-temporal = " +
+              std::to_string(measure(size, memory::nontemporal_memcpy)) +
+              " GB/s";
+    for (size_t concurrency = 1; concurrency <= max_concurrency;
+         concurrency *= 2) {
+      double throughput =
+          measure(size, [concurrency](void* dst, const void* src, size_t n) {
+            return memory::concurrent_memcpy(dst, src, n, concurrency);
+          });
+      result += ", " + std::to_string(concurrency) +
+                " threads = " + std::to_string(throughput) + " GB/s";
+    }
+    double throughput =
+        measure(size, [](void* dst, const void* src, size_t n) {
+          return memory::concurrent_memcpy(dst, src, n);
+        });
+    result += ", self-tuned = " + std::to_string(throughput) + " GB/s";
+    LOG(INFO) << result;
+  }
+  return 0;
+}
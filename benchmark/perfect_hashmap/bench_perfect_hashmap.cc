@@ -0,0 +1,152 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basic/ds/hashmap.h"
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = int64_t;
+using vid_t = uint64_t;
+
+/**
+ * Benchmark for the hashmap and the perfect hashmap that the vertex map uses
+ * for oids, e.g.,
+ *
+ *    ./bench_perfect_hashmap /var/run/vineyard.sock 16777216 8
+ *
+ * which builds both maps of 16M keys, with the perfect hashmap built using
+ * 1 to 8 threads and a few gammas, and reports the time of building and of
+ * constructing the sealed map by `GetObject()`, the memory usage, and the
+ * throughput of looking up random keys.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./bench_perfect_hashmap <ipc_socket> [<keys>] [<threads>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  int64_t count = argc > 2 ? std::stol(argv[2]) : 16 * 1024 * 1024;
+  int concurrency =
+      argc > 3 ? std::stoi(argv[3])
+               : std::max<int>(std::thread::hardware_concurrency(), 1);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  std::mt19937_64 rng(0);
+  std::vector<oid_t> keys(count);
+  for (int64_t i = 0; i < count; ++i) {
+    keys[i] = i * 7 + 1;
+  }
+  std::shuffle(keys.begin(), keys.end(), rng);
+  std::uniform_int_distribution<int64_t> indices(0, count - 1);
+  std::vector<oid_t> queries(16 * 1024 * 1024);
+  for (auto& query : queries) {
+    query = keys[indices(rng)];
+  }
+
+  auto measure = [](auto&& fn) {
+    auto start = GetCurrentTime();
+    fn();
+    return GetCurrentTime() - start;
+  };
+
+  auto report = [&](const std::string& name, const double build_seconds,
+                    const std::shared_ptr<Object>& sealed, auto&& lookup) {
+    std::shared_ptr<Object> object;
+    double construct_seconds = measure(
+        [&]() { VINEYARD_CHECK_OK(client.GetObject(sealed->id(), object)); });
+    vid_t sum = 0;
+    double lookup_seconds = measure([&]() { sum = lookup(object); });
+    CHECK_NE(sum, 0);
+    LOG(INFO) << name << ": build = " << build_seconds
+              << " s, construct = " << construct_seconds * 1e3
+              << " ms, memory = " << object->meta().MemoryUsage()
+              << " bytes, lookup = "
+              << queries.size() / lookup_seconds / 1e6 << " M/s";
+    VINEYARD_CHECK_OK(client.DelData(sealed->id(), true, true));
+  };
+
+  {
+    using hashmap_t = Hashmap<oid_t, vid_t>;
+    std::shared_ptr<Object> sealed;
+    double build_seconds = measure([&]() {
+      HashmapBuilder<oid_t, vid_t> builder(client);
+      builder.reserve(count);
+      for (int64_t i = 0; i < count; ++i) {
+        builder.emplace(keys[i], i);
+      }
+      VINEYARD_CHECK_OK(builder.Seal(client, sealed));
+    });
+    report("hashmap", build_seconds, sealed,
+           [&](const std::shared_ptr<Object>& object) {
+             auto hashmap = std::dynamic_pointer_cast<hashmap_t>(object);
+             vid_t sum = 0;
+             for (oid_t query : queries) {
+               sum += hashmap->find(query)->second;
+             }
+             return sum;
+           });
+  }
+
+  std::vector<int> threads = {1};
+  for (int t = 2; t < concurrency; t *= 2) {
+    threads.push_back(t);
+  }
+  if (concurrency > 1) {
+    threads.push_back(concurrency);
+  }
+  for (int thread : threads) {
+    for (double gamma : {1.0, 2.0, 2.5, 4.0}) {
+      using perfect_hashmap_t = PerfectHashmap<oid_t, vid_t>;
+      std::shared_ptr<Object> sealed;
+      double build_seconds = measure([&]() {
+        PerfectHashmapBuilder<oid_t, vid_t> builder(client);
+        builder.set_concurrency(thread);
+        builder.set_gamma(gamma);
+        VINEYARD_CHECK_OK(builder.ComputeHash(client, keys.data(),
+                                              static_cast<vid_t>(0), count));
+        VINEYARD_CHECK_OK(builder.Seal(client, sealed));
+      });
+      report("perfect hashmap (" + std::to_string(thread) +
+                 " threads, gamma = " + std::to_string(gamma) + ")",
+             build_seconds, sealed,
+             [&](const std::shared_ptr<Object>& object) {
+               auto hashmap =
+                   std::dynamic_pointer_cast<perfect_hashmap_t>(object);
+               vid_t sum = 0;
+               for (oid_t query : queries) {
+                 sum += *hashmap->find(query);
+               }
+               return sum;
+             });
+    }
+  }
+
+  client.Disconnect();
+  return 0;
+}
@@ -0,0 +1,92 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+/**
+ * Benchmark for building tables of 10 to 10,000 columns into vineyard, e.g.,
+ *
+ *    ./bench_table_builder /var/run/vineyard.sock 1024 8
+ *
+ * which builds tables of 1024MB int64 columns, with 1 thread and with 8
+ * threads, and reports the throughput in GB/s.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./bench_table_builder <ipc_socket> [<MB>] [<threads>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  size_t total_size = (argc > 2 ? std::stoul(argv[2]) : 1024) * 1024 * 1024;
+  size_t concurrency =
+      argc > 3 ? std::stoul(argv[3])
+               : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  for (size_t ncolumns : {10, 100, 1000, 10000}) {
+    int64_t nrows = total_size / ncolumns / sizeof(int64_t);
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    for (size_t cindex = 0; cindex < ncolumns; ++cindex) {
+      arrow::Int64Builder builder;
+      CHECK_ARROW_ERROR(builder.Reserve(nrows));
+      for (int64_t i = 0; i < nrows; ++i) {
+        builder.UnsafeAppend(i);
+      }
+      std::shared_ptr<arrow::Array> column;
+      CHECK_ARROW_ERROR(builder.Finish(&column));
+      fields.emplace_back(arrow::field("f" + std::to_string(cindex),
+                                       arrow::int64()));
+      columns.emplace_back(column);
+    }
+    auto table = arrow::Table::Make(arrow::schema(fields), columns);
+
+    std::string result = std::to_string(ncolumns) + " columns: ";
+    for (size_t threads : {static_cast<size_t>(1), concurrency}) {
+      TableBuilder builder(client, table);
+      builder.set_concurrency(threads);
+      auto start = std::chrono::steady_clock::now();
+      std::shared_ptr<Object> object;
+      VINEYARD_CHECK_OK(builder.Seal(client, object));
+      double seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+      VINEYARD_CHECK_OK(client.DelData(object->id(), false, true));
+      result += std::to_string(threads) + " threads = " +
+                std::to_string(static_cast<double>(total_size) / 1024 / 1024 /
+                               1024 / seconds) +
+                " GB/s, ";
+    }
+    LOG(INFO) << result;
+  }
+
+  client.Disconnect();
+  return 0;
+}
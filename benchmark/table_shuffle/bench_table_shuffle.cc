@@ -0,0 +1,111 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "grape/worker/comm_spec.h"
+
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+#include "graph/utils/table_shuffler.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+/**
+ * Benchmark for shuffling tables between workers, e.g.,
+ *
+ *    mpirun -n 4 ./bench_table_shuffle 16 65536
+ *
+ * which shuffles 16M rows (of an int64, a double and a string column) on
+ * each worker, in batches of 64K rows, by the hash of the int64 column, and
+ * reports the throughput of the slowest worker.
+ */
+int main(int argc, char** argv) {
+  int64_t rows = (argc > 1 ? std::stol(argv[1]) : 16) * 1024 * 1024;
+  int64_t batch_rows = argc > 2 ? std::stol(argv[2]) : 64 * 1024;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+    const fid_t fnum = comm_spec.fnum();
+
+    auto schema = arrow::schema({arrow::field("id", arrow::int64()),
+                                 arrow::field("value", arrow::float64()),
+                                 arrow::field("name", arrow::large_utf8())});
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches_send;
+    std::vector<std::vector<std::vector<int64_t>>> offset_lists;
+    int64_t bytes = 0;
+    for (int64_t begin = 0; begin < rows; begin += batch_rows) {
+      int64_t length = std::min(batch_rows, rows - begin);
+      arrow::Int64Builder ids;
+      arrow::DoubleBuilder values;
+      arrow::LargeStringBuilder names;
+      offset_lists.emplace_back(fnum);
+      for (int64_t i = 0; i < length; ++i) {
+        int64_t id = (begin + i) * comm_spec.worker_num() +
+                     comm_spec.worker_id();
+        CHECK_ARROW_ERROR(ids.Append(id));
+        CHECK_ARROW_ERROR(values.Append(id * 0.5));
+        CHECK_ARROW_ERROR(names.Append("vertex-" + std::to_string(id)));
+        offset_lists.back()[(id * 0x9E3779B97F4A7C15ULL >> 32) % fnum]
+            .emplace_back(i);
+      }
+      std::shared_ptr<arrow::Array> id_array, value_array, name_array;
+      CHECK_ARROW_ERROR(ids.Finish(&id_array));
+      CHECK_ARROW_ERROR(values.Finish(&value_array));
+      CHECK_ARROW_ERROR(names.Finish(&name_array));
+      batches_send.emplace_back(arrow::RecordBatch::Make(
+          schema, length, {id_array, value_array, name_array}));
+      for (auto const& column : batches_send.back()->columns()) {
+        for (auto const& buffer : column->data()->buffers) {
+          bytes += buffer == nullptr ? 0 : buffer->size();
+        }
+      }
+    }
+
+    MPI_Barrier(comm_spec.comm());
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
+    auto start = GetCurrentTime();
+    auto result = ShuffleTableByOffsetLists(comm_spec, schema, batches_send,
+                                            offset_lists, batches_recv);
+    double seconds = GetCurrentTime() - start;
+    CHECK(result);
+
+    int64_t rows_recv = 0, total_rows_recv = 0, total_bytes = 0;
+    for (auto const& batch : batches_recv) {
+      rows_recv += batch == nullptr ? 0 : batch->num_rows();
+    }
+    double max_seconds = 0;
+    MPI_Allreduce(&rows_recv, &total_rows_recv, 1, MPI_INT64_T, MPI_SUM,
+                  comm_spec.comm());
+    MPI_Allreduce(&bytes, &total_bytes, 1, MPI_INT64_T, MPI_SUM,
+                  comm_spec.comm());
+    MPI_Allreduce(&seconds, &max_seconds, 1, MPI_DOUBLE, MPI_MAX,
+                  comm_spec.comm());
+    CHECK_EQ(total_rows_recv, rows * comm_spec.worker_num());
+    LOG_IF(INFO, comm_spec.worker_id() == 0)
+        << "Shuffled " << total_rows_recv << " rows (" << total_bytes
+        << " bytes) between " << comm_spec.worker_num()
+        << " workers: " << max_seconds << " s, "
+        << total_bytes / max_seconds / 1024 / 1024 << " MB/s";
+  }
+  grape::FinalizeMPIComm();
+  return 0;
+}
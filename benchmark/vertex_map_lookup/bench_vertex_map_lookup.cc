@@ -0,0 +1,132 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/vertex_map/arrow_vertex_map.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = int64_t;
+using vid_t = property_graph_types::VID_TYPE;
+using vertex_map_t = ArrowVertexMap<oid_t, vid_t>;
+
+/**
+ * Benchmark for resolving oids to gids in the vertex map, one by one with
+ * `GetGid()` and in batch with `GetGids()`, e.g.,
+ *
+ *    ./bench_vertex_map_lookup /var/run/vineyard.sock 16777216 8
+ *
+ * which builds vertex maps (with the hashmap and the perfect hashmap) of 16M
+ * vertices over 4 fragments, and reports the throughput of resolving 16M
+ * random oids.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_vertex_map_lookup <ipc_socket> [<vertices>] "
+        "[<threads>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  int64_t vnum = argc > 2 ? std::stol(argv[2]) : 16 * 1024 * 1024;
+  int concurrency =
+      argc > 3 ? std::stoi(argv[3])
+               : std::max<int>(std::thread::hardware_concurrency(), 1);
+  const fid_t fnum = 4;
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  // vertices are partitioned by `oid % fnum`
+  std::vector<std::shared_ptr<arrow::Int64Array>> oid_arrays(fnum);
+  for (fid_t fid = 0; fid < fnum; ++fid) {
+    arrow::Int64Builder builder;
+    for (oid_t oid = fid; oid < vnum; oid += fnum) {
+      CHECK_ARROW_ERROR(builder.Append(oid * 7 + 1));
+    }
+    std::shared_ptr<arrow::Array> array;
+    CHECK_ARROW_ERROR(builder.Finish(&array));
+    oid_arrays[fid] = std::dynamic_pointer_cast<arrow::Int64Array>(array);
+  }
+
+  std::mt19937_64 rng(0);
+  std::uniform_int_distribution<oid_t> vertices(0, vnum - 1);
+  arrow::Int64Builder query_builder;
+  std::vector<fid_t> fids(vnum);
+  for (int64_t i = 0; i < vnum; ++i) {
+    oid_t oid = vertices(rng);
+    fids[i] = oid % fnum;
+    CHECK_ARROW_ERROR(query_builder.Append(oid * 7 + 1));
+  }
+  std::shared_ptr<arrow::Array> query_array;
+  CHECK_ARROW_ERROR(query_builder.Finish(&query_array));
+  auto queries = std::dynamic_pointer_cast<arrow::Int64Array>(query_array);
+
+  auto measure = [](auto&& fn) {
+    auto start = GetCurrentTime();
+    fn();
+    return GetCurrentTime() - start;
+  };
+
+  for (bool use_perfect_hash : {false, true}) {
+    BasicArrowVertexMapBuilder<oid_t, vid_t> builder(
+        client, fnum, 1, {oid_arrays}, use_perfect_hash);
+    std::shared_ptr<Object> object;
+    VINEYARD_CHECK_OK(builder.Seal(client, object));
+    auto vm = std::dynamic_pointer_cast<vertex_map_t>(object);
+
+    std::vector<vid_t> expected(vnum);
+    double single_seconds = measure([&]() {
+      for (int64_t i = 0; i < vnum; ++i) {
+        CHECK(vm->GetGid(fids[i], 0, queries->Value(i), expected[i]));
+      }
+    });
+
+    std::string result =
+        std::string(use_perfect_hash ? "perfect hashmap" : "hashmap") +
+        ": GetGid = " + std::to_string(vnum / single_seconds / 1e6) +
+        " M/s, ";
+    for (int threads : {1, concurrency}) {
+      std::shared_ptr<ArrowArrayType<vid_t>> gids;
+      double batch_seconds = measure([&]() {
+        VINEYARD_CHECK_OK(vm->GetGids(0, queries, fids, gids, threads));
+      });
+      for (int64_t i = 0; i < vnum; ++i) {
+        CHECK_EQ(gids->Value(i), expected[i]);
+      }
+      result += "GetGids (" + std::to_string(threads) +
+                " threads) = " + std::to_string(vnum / batch_seconds / 1e6) +
+                " M/s, ";
+    }
+    LOG(INFO) << result;
+    VINEYARD_CHECK_OK(client.DelData(vm->id(), true, true));
+  }
+
+  client.Disconnect();
+  return 0;
+}
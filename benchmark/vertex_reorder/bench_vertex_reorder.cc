@@ -0,0 +1,251 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow_utils.h"
+#include "client/client.h"
+#include "common/util/functions.h"
+#include "common/util/logging.h"
+
+#include "graph/fragment/arrow_fragment.h"
+#include "graph/fragment/graph_schema.h"
+#include "graph/vertex_map/arrow_vertex_map.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = int64_t;
+using vid_t = property_graph_types::VID_TYPE;
+using fragment_t = ArrowFragment<oid_t, vid_t>;
+using vertex_map_t = ArrowVertexMap<oid_t, vid_t>;
+
+template <typename T>
+std::shared_ptr<arrow::Array> to_arrow_array(const std::vector<T>& values) {
+  typename ConvertToArrowType<T>::BuilderType builder;
+  CHECK_ARROW_ERROR(builder.AppendValues(values));
+  std::shared_ptr<arrow::Array> array;
+  CHECK_ARROW_ERROR(builder.Finish(&array));
+  return array;
+}
+
+/**
+ * Builds a single fragment from the vertices (in the order of `oids`) and
+ * the edges (in oids), where the inner vertices are optionally reordered.
+ */
+std::shared_ptr<fragment_t> build_fragment(Client& client,
+                                           const std::vector<oid_t>& oids,
+                                           const std::vector<oid_t>& srcs,
+                                           const std::vector<oid_t>& dsts,
+                                           const bool reorder,
+                                           const int concurrency) {
+  auto oid_array =
+      std::dynamic_pointer_cast<arrow::Int64Array>(to_arrow_array(oids));
+  BasicArrowVertexMapBuilder<oid_t, vid_t> vm_builder(client, 1, 1,
+                                                      {{oid_array}});
+  std::shared_ptr<Object> vm_object;
+  VINEYARD_CHECK_OK(vm_builder.Seal(client, vm_object));
+  auto vm = std::dynamic_pointer_cast<vertex_map_t>(vm_object);
+
+  // the "value" property scales the contributions of neighbors
+  std::vector<double> values(oids.size(), 1.0);
+  std::vector<vid_t> src_gids(srcs.size()), dst_gids(dsts.size());
+  std::vector<double> weights(srcs.size());
+  for (size_t e = 0; e < srcs.size(); ++e) {
+    CHECK(vm->GetGid(0, 0, srcs[e], src_gids[e]));
+    CHECK(vm->GetGid(0, 0, dsts[e], dst_gids[e]));
+    weights[e] = 1.0;
+  }
+
+  std::vector<std::shared_ptr<arrow::Table>> vertex_tables{arrow::Table::Make(
+      arrow::schema({arrow::field("value", arrow::float64())}),
+      {to_arrow_array(values)})};
+  std::vector<std::shared_ptr<arrow::Table>> edge_tables{arrow::Table::Make(
+      arrow::schema({arrow::field("src", arrow::uint64()),
+                     arrow::field("dst", arrow::uint64()),
+                     arrow::field("weight", arrow::float64())}),
+      {to_arrow_array(src_gids), to_arrow_array(dst_gids),
+       to_arrow_array(weights)})};
+
+  PropertyGraphSchema schema;
+  schema.set_fnum(1);
+  auto vertex_entry =
+      schema.CreateEntry("v", PropertyGraphSchema::VERTEX_TYPE_NAME);
+  vertex_entry->AddProperty("value", arrow::float64());
+  auto edge_entry =
+      schema.CreateEntry("e", PropertyGraphSchema::EDGE_TYPE_NAME);
+  edge_entry->AddRelation("v", "v");
+  edge_entry->AddProperty("weight", arrow::float64());
+
+  BasicArrowFragmentBuilder<oid_t, vid_t> builder(client, vm);
+  builder.SetPropertyGraphSchema(std::move(schema));
+  builder.set_reorder_vertices(reorder);
+  auto start = GetCurrentTime();
+  auto result = builder.Init(0, 1, std::move(vertex_tables),
+                             std::move(edge_tables), true, concurrency);
+  CHECK(result);
+  std::shared_ptr<Object> fragment_object;
+  // the reordered fragment comes with a new vertex map, and the given one
+  // has been deleted by the builder
+  VINEYARD_CHECK_OK(builder.Seal(client, fragment_object));
+  LOG(INFO) << (reorder ? "reordered" : "original")
+            << " fragment: build = " << GetCurrentTime() - start << " s";
+  return std::dynamic_pointer_cast<fragment_t>(fragment_object);
+}
+
+// pull-based PageRank, returns the ranks indexed by oids
+std::vector<double> pagerank(const fragment_t& frag, const int rounds) {
+  auto vertices = frag.InnerVertices(0);
+  const size_t vnum = vertices.size();
+  std::vector<double> ranks(vnum, 1.0 / vnum), contributions(vnum);
+  for (int round = 0; round < rounds; ++round) {
+    for (auto v : vertices) {
+      int degree = frag.GetLocalOutDegree(v, 0);
+      contributions[frag.vertex_offset(v)] =
+          degree == 0 ? 0 : ranks[frag.vertex_offset(v)] / degree;
+    }
+    for (auto v : vertices) {
+      double sum = 0;
+      for (auto& nbr : frag.GetIncomingAdjList(v, 0)) {
+        // accesses both the states and the properties of neighbors
+        sum += contributions[frag.vertex_offset(nbr.neighbor())] *
+               frag.GetData<double>(nbr.neighbor(), 0);
+      }
+      ranks[frag.vertex_offset(v)] = 0.15 / vnum + 0.85 * sum;
+    }
+  }
+  std::vector<double> result(vnum);
+  for (auto v : vertices) {
+    result[frag.GetId(v)] = ranks[frag.vertex_offset(v)];
+  }
+  return result;
+}
+
+// BFS from the vertex of oid `source`, returns the depths indexed by oids
+std::vector<int64_t> bfs(const fragment_t& frag, const oid_t source) {
+  auto vertices = frag.InnerVertices(0);
+  const size_t vnum = vertices.size();
+  std::vector<int64_t> depths(vnum, -1);
+  std::vector<fragment_t::vertex_t> current, next;
+  fragment_t::vertex_t root;
+  CHECK(frag.GetInnerVertex(0, source, root));
+  depths[frag.vertex_offset(root)] = 0;
+  current.emplace_back(root);
+  for (int64_t depth = 1; !current.empty(); ++depth) {
+    next.clear();
+    for (auto const& v : current) {
+      for (auto& nbr : frag.GetOutgoingAdjList(v, 0)) {
+        auto u = nbr.neighbor();
+        if (depths[frag.vertex_offset(u)] == -1) {
+          depths[frag.vertex_offset(u)] = depth;
+          next.emplace_back(u);
+        }
+      }
+    }
+    std::swap(current, next);
+  }
+  std::vector<int64_t> result(vnum);
+  for (auto v : vertices) {
+    result[frag.GetId(v)] = depths[frag.vertex_offset(v)];
+  }
+  return result;
+}
+
+/**
+ * Benchmark for reordering the vertices of fragments by degrees, e.g.,
+ *
+ *    ./bench_vertex_reorder /var/run/vineyard.sock 4194304 16 8
+ *
+ * which generates a power-law graph of 4M vertices with an average degree of
+ * 16, where the vertices arrive in random order, and reports the time of
+ * PageRank and BFS on the fragments with and without reordering. Running it
+ * under `perf stat -e cache-misses` shows the reduction of cache misses.
+ */
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf(
+        "usage ./bench_vertex_reorder <ipc_socket> [<vertices>] [<degree>] "
+        "[<threads>]");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+  int64_t vnum = argc > 2 ? std::stol(argv[2]) : 4 * 1024 * 1024;
+  int64_t degree = argc > 3 ? std::stol(argv[3]) : 16;
+  int concurrency =
+      argc > 4 ? std::stoi(argv[4])
+               : std::max<int>(std::thread::hardware_concurrency(), 1);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  // skewed endpoints: small oids are the hubs
+  std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> uniform(0, 1);
+  auto skewed = [&]() {
+    return std::min(static_cast<oid_t>(std::pow(uniform(rng), 3) * vnum),
+                    vnum - 1);
+  };
+  std::vector<oid_t> srcs(vnum * degree), dsts(vnum * degree);
+  for (size_t e = 0; e < srcs.size(); ++e) {
+    srcs[e] = skewed();
+    dsts[e] = skewed();
+  }
+  // vertices arrive in random order
+  std::vector<oid_t> oids(vnum);
+  std::iota(oids.begin(), oids.end(), 0);
+  std::shuffle(oids.begin(), oids.end(), rng);
+
+  auto measure = [](auto&& fn) {
+    auto start = GetCurrentTime();
+    fn();
+    return GetCurrentTime() - start;
+  };
+
+  std::vector<double> expected_ranks;
+  std::vector<int64_t> expected_depths;
+  for (bool reorder : {false, true}) {
+    auto frag = build_fragment(client, oids, srcs, dsts, reorder, concurrency);
+    std::vector<double> ranks;
+    std::vector<int64_t> depths;
+    double pagerank_seconds = measure([&]() { ranks = pagerank(*frag, 10); });
+    double bfs_seconds = measure([&]() { depths = bfs(*frag, 0); });
+    if (!reorder) {
+      expected_ranks = std::move(ranks);
+      expected_depths = std::move(depths);
+    } else {
+      for (int64_t i = 0; i < vnum; ++i) {
+        CHECK_LT(std::abs(ranks[i] - expected_ranks[i]), 1e-9);
+        CHECK_EQ(depths[i], expected_depths[i]);
+      }
+    }
+    LOG(INFO) << (reorder ? "reordered" : "original")
+              << " fragment: pagerank (10 rounds) = " << pagerank_seconds
+              << " s, bfs = " << bfs_seconds << " s";
+    VINEYARD_CHECK_OK(client.DelData(frag->id(), true, true));
+  }
+
+  client.Disconnect();
+  return 0;
+}
@@ -16,14 +16,19 @@ limitations under the License.
 #include "basic/ds/arrow.h"  // NOLINT(build/include)
 
 #include <algorithm>
+#include <limits>
+#include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "arrow/api.h"      // IWYU pragma: keep
 #include "arrow/io/api.h"   // IWYU pragma: keep
 #include "arrow/ipc/api.h"  // IWYU pragma: keep
+#include "arrow/util/bit_util.h"
+#include "arrow/util/bitmap_ops.h"
 #if defined(ARROW_VERSION) && ARROW_VERSION >= 7000000
 #include "arrow/visit_type_inline.h"  // IWYU pragma: keep
 #else
@@ -33,6 +38,7 @@ limitations under the License.
 #include "basic/ds/arrow_shim/concatenate.h"
 #include "basic/ds/arrow_shim/memory_pool.h"
 #include "basic/ds/arrow_utils.h"
+#include "basic/utils.h"
 #include "client/client.h"
 #include "client/ds/blob.h"
 #include "common/util/logging.h"  // IWYU pragma: keep
@@ -145,6 +151,10 @@ class ArrowArrayBuilderVisitor {
     builder_ = std::make_shared<FixedSizeListArrayBuilder>(client_, array_);
     return Status::OK();
   }
+  Status Visit(const arrow::DictionaryType*) {
+    builder_ = std::make_shared<DictionaryArrayBuilder>(client_, array_);
+    return Status::OK();
+  }
 
   Status Visit(const arrow::DataType* type) {
     return Status::NotImplemented(
@@ -227,6 +237,32 @@ std::shared_ptr<ObjectBuilder> BuildArray(
   return builder;
 }
 
+Status SealBuilders(Client& client,
+                    std::vector<std::shared_ptr<ObjectBuilder>> const& builders,
+                    std::vector<std::shared_ptr<Object>>& objects,
+                    const size_t concurrency) {
+  objects.resize(builders.size());
+  if (concurrency <= 1 || builders.size() <= 1) {
+    for (size_t idx = 0; idx < builders.size(); ++idx) {
+      RETURN_ON_ERROR(builders[idx]->Seal(client, objects[idx]));
+    }
+    return Status::OK();
+  }
+  // the copies into blobs run concurrently, while the requests to vineyardd
+  // are serialized by the client
+  std::vector<Status> status(builders.size());
+  parallel_for(
+      static_cast<size_t>(0), builders.size(),
+      [&](const size_t idx) {
+        status[idx] = builders[idx]->Seal(client, objects[idx]);
+      },
+      std::min(concurrency, builders.size()), 1);
+  for (auto const& s : status) {
+    RETURN_ON_ERROR(s);
+  }
+  return Status::OK();
+}
+
 std::shared_ptr<arrow::Array> CastToArray(std::shared_ptr<Object> object) {
   if (auto arr = std::dynamic_pointer_cast<FixedSizeBinaryArray>(object)) {
     return arr->GetArray();
@@ -253,6 +289,240 @@ std::shared_ptr<arrow::Array> CastToArray(std::shared_ptr<Object> object) {
   return nullptr;
 }
 
+/**
+ * @brief Project the metadata tree of SchemaProxy to the given columns, and
+ * returns the indices of the columns in the original schema.
+ */
+static Status ProjectSchema(json& tree, std::vector<std::string> const& columns,
+                            std::vector<int>& indices) {
+  if (!tree.contains("schema_binary_")) {
+    return Status::NotImplemented(
+        "projection requires the schema in binary format");
+  }
+  json binary =
+      json::parse(tree["schema_binary_"].get_ref<const std::string&>());
+  std::vector<uint8_t> bytes;
+  if (binary.is_binary()) {
+    bytes = binary.get_binary();
+  } else if (binary.contains("bytes")) {
+    binary["bytes"].get_to(bytes);
+  } else {
+    return Status::Invalid("Invalid schema binary: " + binary.dump());
+  }
+  // the memo is required to read the schemas with dictionary fields
+  arrow::ipc::DictionaryMemo memo;
+  arrow::io::BufferReader reader(
+      arrow::Buffer::Wrap(bytes.data(), bytes.size()));
+  std::shared_ptr<arrow::Schema> schema;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(schema,
+                                   arrow::ipc::ReadSchema(&reader, &memo));
+
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  indices.clear();
+  for (auto const& column : columns) {
+    int index = schema->GetFieldIndex(column);
+    if (index == -1) {
+      return Status::KeyError("column '" + column + "' not found");
+    }
+    indices.emplace_back(index);
+    fields.emplace_back(schema->field(index));
+  }
+  auto projected = std::make_shared<arrow::Schema>(fields, schema->metadata());
+
+  std::shared_ptr<arrow::Buffer> buffer;
+  RETURN_ON_ERROR(SerializeSchema(*projected, &buffer));
+  json textual;
+  RETURN_ON_ERROR(arrow_shim::SchemaToJSON(projected, textual));
+  tree["schema_textual_"] = json_to_string(textual);
+  tree["schema_binary_"] = json_to_string(json::binary(
+      std::vector<uint8_t>(buffer->data(), buffer->data() + buffer->size())));
+  return Status::OK();
+}
+
+static Status ProjectRecordBatch(json& tree,
+                                 std::vector<std::string> const& columns) {
+  std::vector<int> indices;
+  RETURN_ON_ERROR(ProjectSchema(tree["schema_"], columns, indices));
+
+  std::vector<json> projected;
+  for (int index : indices) {
+    projected.emplace_back(tree["__columns_-" + std::to_string(index)]);
+  }
+  size_t column_num = tree["__columns_-size"].get<size_t>();
+  for (size_t index = 0; index < column_num; ++index) {
+    tree.erase("__columns_-" + std::to_string(index));
+  }
+  for (size_t index = 0; index < projected.size(); ++index) {
+    tree["__columns_-" + std::to_string(index)] = std::move(projected[index]);
+  }
+  tree["__columns_-size"] = projected.size();
+  tree["column_num_"] = projected.size();
+  return Status::OK();
+}
+
+/**
+ * @brief Stitch the validity bitmaps of the arrays into one blob, or an empty
+ * blob if there are no nulls.
+ */
+static Status StitchNullBitmaps(
+    Client& client, std::vector<std::shared_ptr<arrow::Array>> const& arrays,
+    const int64_t length, int64_t& null_count,
+    std::shared_ptr<ObjectBase>& bitmap) {
+  null_count = 0;
+  for (auto const& array : arrays) {
+    null_count += array->null_count();
+  }
+  if (null_count == 0) {
+    bitmap = Blob::MakeEmpty(client);
+    return Status::OK();
+  }
+  std::unique_ptr<BlobWriter> writer;
+  RETURN_ON_ERROR(client.CreateBlob((length + 7) / 8, writer));
+  uint8_t* target = reinterpret_cast<uint8_t*>(writer->data());
+  target[(length + 7) / 8 - 1] = 0;
+  int64_t position = 0;
+  for (auto const& array : arrays) {
+    if (array->null_count() == 0) {
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 7000000
+      arrow::bit_util::SetBitsTo(target, position, array->length(), true);
+#else
+      arrow::BitUtil::SetBitsTo(target, position, array->length(), true);
+#endif
+    } else {
+      arrow::internal::CopyBitmap(array->null_bitmap_data(), array->offset(),
+                                  array->length(), target, position);
+    }
+    position += array->length();
+  }
+  bitmap = std::shared_ptr<BlobWriter>(std::move(writer));
+  return Status::OK();
+}
+
+/**
+ * @brief Rebase the value offsets of the list arrays into one blob, and
+ * collect the slices of their values.
+ */
+template <typename ArrayType>
+static Status RebaseValueOffsets(
+    Client& client, std::vector<std::shared_ptr<arrow::Array>> const& arrays,
+    const int64_t length, std::shared_ptr<ObjectBase>& offsets,
+    std::vector<std::shared_ptr<arrow::Array>>& values) {
+  using offset_type = typename ArrayType::offset_type;
+  // the positions of each array in the output offsets and values
+  std::vector<int64_t> positions(arrays.size() + 1, 0);
+  std::vector<int64_t> bases(arrays.size() + 1, 0);
+  values.resize(arrays.size());
+  for (size_t index = 0; index < arrays.size(); ++index) {
+    auto array = std::dynamic_pointer_cast<ArrayType>(arrays[index]);
+    int64_t first = 0, last = 0;
+    if (array->length() > 0) {
+      first = array->value_offset(0);
+      last = array->value_offset(array->length());
+    }
+    values[index] = array->values()->Slice(first, last - first);
+    positions[index + 1] = positions[index] + array->length();
+    bases[index + 1] = bases[index] + (last - first);
+  }
+  if (bases.back() > std::numeric_limits<offset_type>::max()) {
+    return Status::Invalid("Offset value overflow when concatenating arrays");
+  }
+
+  std::unique_ptr<BlobWriter> writer;
+  RETURN_ON_ERROR(
+      client.CreateBlob((length + 1) * sizeof(offset_type), writer));
+  offset_type* target = reinterpret_cast<offset_type*>(writer->data());
+  auto rebase = [&](const size_t index) {
+    auto array = std::dynamic_pointer_cast<ArrayType>(arrays[index]);
+    if (array->length() == 0) {
+      return;
+    }
+    const offset_type* source = array->raw_value_offsets();
+    const offset_type delta =
+        static_cast<offset_type>(bases[index]) - source[0];
+    offset_type* output = target + positions[index];
+    for (int64_t i = 0; i < array->length(); ++i) {
+      output[i] = source[i] + delta;
+    }
+  };
+  static constexpr int64_t kParallelThreshold = 1024 * 1024;
+  size_t concurrency = nested_parallelism(arrays.size());
+  if (concurrency > 1 && length >= kParallelThreshold) {
+    parallel_for(static_cast<size_t>(0), arrays.size(), rebase, concurrency);
+  } else {
+    for (size_t index = 0; index < arrays.size(); ++index) {
+      rebase(index);
+    }
+  }
+  target[length] = static_cast<offset_type>(bases.back());
+  offsets = std::shared_ptr<BlobWriter>(std::move(writer));
+  return Status::OK();
+}
+
+/**
+ * @brief Build the consolidated column, whose values have been allocated
+ * from the pool, without copying the values again.
+ *
+ * The values are taken as a blob, and the column is rebuilt over the blob
+ * with a non-owning buffer, as the buffer from the pool must not outlive the
+ * pool.
+ */
+static Status BuildConsolidatedColumn(
+    Client& client, memory::VineyardMemoryPool& pool,
+    std::shared_ptr<arrow::Array>& column,
+    std::shared_ptr<ObjectBuilder>& builder) {
+  auto array = std::dynamic_pointer_cast<arrow::FixedSizeListArray>(column);
+  auto values = array->values();
+  std::unique_ptr<BlobWriter> writer;
+  auto status = pool.Take(values->data()->buffers[1], writer);
+  if (status.IsObjectNotExists()) {
+    // empty columns
+    return BuildArray(client, column, builder);
+  }
+  RETURN_ON_ERROR(status);
+  column = std::make_shared<arrow::FixedSizeListArray>(
+      array->type(), array->length(),
+      std::make_shared<arrow::PrimitiveArray>(
+          values->type(), values->length(),
+          std::make_shared<arrow::Buffer>(
+              reinterpret_cast<const uint8_t*>(writer->data()),
+              writer->size())));
+  array = std::dynamic_pointer_cast<arrow::FixedSizeListArray>(column);
+  values = array->values();
+
+  std::shared_ptr<ObjectBuilder> values_builder;
+#define MAKE_VALUES_BUILDER(TYPE_ID, T)                                  \
+  case arrow::Type::TYPE_ID: {                                           \
+    std::shared_ptr<FixedNumericArrayBuilder<T>> typed_builder;          \
+    RETURN_ON_ERROR(FixedNumericArrayBuilder<T>::Make(                   \
+        client, std::move(writer), values->length(), typed_builder));    \
+    values_builder = typed_builder;                                      \
+    break;                                                               \
+  }
+
+  switch (values->type()->id()) {
+    MAKE_VALUES_BUILDER(INT8, int8_t);
+    MAKE_VALUES_BUILDER(INT16, int16_t);
+    MAKE_VALUES_BUILDER(INT32, int32_t);
+    MAKE_VALUES_BUILDER(INT64, int64_t);
+    MAKE_VALUES_BUILDER(UINT8, uint8_t);
+    MAKE_VALUES_BUILDER(UINT16, uint16_t);
+    MAKE_VALUES_BUILDER(UINT32, uint32_t);
+    MAKE_VALUES_BUILDER(UINT64, uint64_t);
+    MAKE_VALUES_BUILDER(FLOAT, float);
+    MAKE_VALUES_BUILDER(DOUBLE, double);
+  default:
+    VINEYARD_DISCARD(writer->Abort(client));
+    return Status::NotImplemented("cannot consolidate columns of type " +
+                                  values->type()->ToString());
+  }
+#undef MAKE_VALUES_BUILDER
+
+  builder = std::make_shared<FixedSizeListArrayBuilder>(
+      client, array->length(), array->list_type()->list_size(),
+      values_builder);
+  return Status::OK();
+}
+
 }  // namespace detail
 
 #ifndef TAKE_BUFFER_AND_APPLY
@@ -787,47 +1057,39 @@ BaseListArrayBuilder<ArrayType>::BaseListArrayBuilder(
 
 template <typename ArrayType>
 Status BaseListArrayBuilder<ArrayType>::Build(Client& client) {
-  std::shared_ptr<arrow::Array> array;
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      array, arrow_shim::Concatenate(std::move(this->arrays_)));
-  std::shared_ptr<ArrayType> array_ =
-      std::dynamic_pointer_cast<ArrayType>(array);
-
-  // FIXME: list array is not optimized yet.
-
-  this->set_length_(array_->length());
-  this->set_null_count_(array_->null_count());
-  this->set_offset_(array_->offset());
-
-  {
-    std::unique_ptr<BlobWriter> buffer_writer;
-    RETURN_ON_ERROR(
-        client.CreateBlob(array_->value_offsets()->size(), buffer_writer));
-    memcpy(buffer_writer->data(), array_->value_offsets()->data(),
-           array_->value_offsets()->size());
-
-    this->set_buffer_offsets_(
-        std::shared_ptr<BlobWriter>(std::move(buffer_writer)));
-  }
+  if (this->arrays_.empty()) {
+    return Status::Invalid("Must pass at least one array");
+  }
+  // the offsets and bitmaps are rebased and stitched into blobs directly,
+  // and the values of all chunks are concatenated into blobs in one copy,
+  // without concatenating the list arrays first.
+  int64_t length = 0;
+  for (auto const& array : this->arrays_) {
+    length += array->length();
+  }
+  auto value_type = this->arrays_[0]->type()->field(0)->type();
+
+  std::shared_ptr<ObjectBase> offsets, null_bitmap;
+  std::vector<std::shared_ptr<arrow::Array>> values;
+  int64_t null_count = 0;
+  RETURN_ON_ERROR(detail::RebaseValueOffsets<ArrayType>(
+      client, this->arrays_, length, offsets, values));
+  RETURN_ON_ERROR(detail::StitchNullBitmaps(client, this->arrays_, length,
+                                            null_count, null_bitmap));
+  this->arrays_.clear();  // release the reference
+
+  this->set_length_(length);
+  this->set_null_count_(null_count);
+  this->set_offset_(0);
+  this->set_buffer_offsets_(offsets);
   {
     // Assuming the list is not nested.
     // We need to split the definition to .cc if someday we need to consider
     // nested list in list case.
-    this->set_values_(detail::BuildArray(client, array_->values()));
-  }
-  {
-    if (array->null_bitmap() && array->null_count() > 0) {
-      std::unique_ptr<BlobWriter> bitmap_buffer_writer;
-      RETURN_ON_ERROR(client.CreateBlob(array->null_bitmap()->size(),
-                                        bitmap_buffer_writer));
-      memcpy(bitmap_buffer_writer->data(), array->null_bitmap()->data(),
-             array->null_bitmap()->size());
-      this->set_null_bitmap_(
-          std::shared_ptr<BlobWriter>(std::move(bitmap_buffer_writer)));
-    } else {
-      this->set_null_bitmap_(Blob::MakeEmpty(client));
-    }
+    this->set_values_(detail::BuildArray(
+        client, std::make_shared<arrow::ChunkedArray>(values, value_type)));
   }
+  this->set_null_bitmap_(null_bitmap);
   return Status::OK();
 }
 
@@ -867,27 +1129,320 @@ FixedSizeListArrayBuilder::FixedSizeListArrayBuilder(
   this->arrays_ = ref->chunks();
 }
 
+FixedSizeListArrayBuilder::FixedSizeListArrayBuilder(
+    Client& client, const size_t length, const int32_t list_size,
+    std::shared_ptr<ObjectBuilder> values)
+    : FixedSizeListArrayBaseBuilder(client),
+      prebuilt_length_(length),
+      prebuilt_list_size_(list_size),
+      prebuilt_values_(values) {}
+
 Status FixedSizeListArrayBuilder::Build(Client& client) {
-  std::shared_ptr<arrow::Array> array;
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      array, arrow_shim::Concatenate(std::move(this->arrays_)));
-  std::shared_ptr<ArrayType> array_ =
-      std::dynamic_pointer_cast<ArrayType>(array);
+  if (prebuilt_values_) {
+    this->set_length_(prebuilt_length_);
+    this->set_list_size_(prebuilt_list_size_);
+    this->set_values_(prebuilt_values_);
+    prebuilt_values_.reset();  // release the reference
+    return Status::OK();
+  }
+  if (this->arrays_.empty()) {
+    return Status::Invalid("Must pass at least one array");
+  }
 
-  // FIXME: list array is not optimized yet.
+  // concatenate the values of all chunks into blobs in one copy, without
+  // concatenating the list arrays first.
+  auto type =
+      std::dynamic_pointer_cast<arrow::FixedSizeListType>(arrays_[0]->type());
+  const int32_t list_size = type->list_size();
+  int64_t length = 0;
+  std::vector<std::shared_ptr<arrow::Array>> values;
+  for (auto const& chunk : this->arrays_) {
+    auto array = std::dynamic_pointer_cast<ArrayType>(chunk);
+    values.emplace_back(array->values()->Slice(array->offset() * list_size,
+                                               array->length() * list_size));
+    length += array->length();
+  }
+  this->arrays_.clear();  // release the reference
 
-  this->set_length_(array_->length());
-  this->set_list_size_(array_->list_type()->list_size());
+  this->set_length_(length);
+  this->set_list_size_(list_size);
 
   {
     // Assuming the list is not nested.
     // We need to split the definition to .cc if someday we need to consider
     // nested list in list case.
-    this->set_values_(detail::BuildArray(client, array_->values()));
+    this->set_values_(detail::BuildArray(
+        client,
+        std::make_shared<arrow::ChunkedArray>(values, type->value_type())));
   }
   return Status::OK();
 }
 
+void DictionaryArray::PostConstruct(const ObjectMeta& meta) {
+  auto indices = detail::CastToArray(indices_);
+  auto dictionary = detail::CastToArray(dictionary_);
+  this->array_ = std::make_shared<arrow::DictionaryArray>(
+      arrow::dictionary(indices->type(), dictionary->type(), this->ordered_),
+      indices, dictionary);
+}
+
+DictionaryArrayBuilder::DictionaryArrayBuilder(
+    Client& client, const std::shared_ptr<ArrayType> array)
+    : DictionaryArrayBaseBuilder(client) {
+  std::shared_ptr<arrow::Array> ref;
+  VINEYARD_CHECK_OK(detail::Copy(array, ref, true));
+  this->arrays_.emplace_back(ref);
+}
+
+DictionaryArrayBuilder::DictionaryArrayBuilder(
+    Client& client, const std::vector<std::shared_ptr<ArrayType>>& arrays)
+    : DictionaryArrayBaseBuilder(client) {
+  for (auto const& array : arrays) {
+    std::shared_ptr<arrow::Array> ref;
+    VINEYARD_CHECK_OK(detail::Copy(array, ref, true));
+    this->arrays_.emplace_back(ref);
+  }
+}
+
+DictionaryArrayBuilder::DictionaryArrayBuilder(
+    Client& client, const std::shared_ptr<arrow::ChunkedArray> array)
+    : DictionaryArrayBaseBuilder(client) {
+  std::shared_ptr<arrow::ChunkedArray> ref;
+  VINEYARD_CHECK_OK(detail::Copy(array, ref, true));
+  this->arrays_ = ref->chunks();
+}
+
+DictionaryArrayBuilder::DictionaryArrayBuilder(
+    Client& client, const std::shared_ptr<Object> dictionary,
+    const std::shared_ptr<arrow::Array> indices, const bool ordered)
+    : DictionaryArrayBuilder(client, dictionary,
+                             std::make_shared<arrow::ChunkedArray>(indices),
+                             ordered) {}
+
+DictionaryArrayBuilder::DictionaryArrayBuilder(
+    Client& client, const std::shared_ptr<Object> dictionary,
+    const std::shared_ptr<arrow::ChunkedArray> indices, const bool ordered)
+    : DictionaryArrayBaseBuilder(client),
+      shared_dictionary_(dictionary),
+      shared_ordered_(ordered) {
+  this->arrays_ = indices->chunks();
+  this->shared_index_type_ = indices->type();
+}
+
+namespace detail {
+
+template <typename T>
+static Status CheckDictionaryIndices(const arrow::Array& indices,
+                                     const int64_t dictionary_size) {
+  auto const& array = dynamic_cast<const arrow::NumericArray<T>&>(indices);
+  for (int64_t index = 0; index < array.length(); ++index) {
+    if (array.IsNull(index)) {
+      continue;
+    }
+    // n.b.: large unsigned values become negative as well
+    int64_t value = static_cast<int64_t>(array.Value(index));
+    if (value < 0 || value >= dictionary_size) {
+      return Status::Invalid("The dictionary index " +
+                             std::to_string(array.Value(index)) +
+                             " is out of the range of the dictionary of size " +
+                             std::to_string(dictionary_size));
+    }
+  }
+  return Status::OK();
+}
+
+static Status CheckDictionaryIndices(
+    const std::shared_ptr<arrow::Array>& indices,
+    const int64_t dictionary_size) {
+  switch (indices->type_id()) {
+  case arrow::Type::INT8:
+    return CheckDictionaryIndices<arrow::Int8Type>(*indices, dictionary_size);
+  case arrow::Type::UINT8:
+    return CheckDictionaryIndices<arrow::UInt8Type>(*indices, dictionary_size);
+  case arrow::Type::INT16:
+    return CheckDictionaryIndices<arrow::Int16Type>(*indices, dictionary_size);
+  case arrow::Type::UINT16:
+    return CheckDictionaryIndices<arrow::UInt16Type>(*indices,
+                                                     dictionary_size);
+  case arrow::Type::INT32:
+    return CheckDictionaryIndices<arrow::Int32Type>(*indices, dictionary_size);
+  case arrow::Type::UINT32:
+    return CheckDictionaryIndices<arrow::UInt32Type>(*indices,
+                                                     dictionary_size);
+  case arrow::Type::INT64:
+    return CheckDictionaryIndices<arrow::Int64Type>(*indices, dictionary_size);
+  case arrow::Type::UINT64:
+    return CheckDictionaryIndices<arrow::UInt64Type>(*indices,
+                                                     dictionary_size);
+  default:
+    return Status::Invalid("The dictionary indices must be integers, got " +
+                           indices->type()->ToString());
+  }
+}
+
+static Status UnifyDictionaries(
+    const std::vector<std::shared_ptr<arrow::Array>>& chunks,
+    std::shared_ptr<arrow::DictionaryType>& type,
+    std::shared_ptr<arrow::Array>& dictionary,
+    std::vector<std::shared_ptr<arrow::Array>>& indices) {
+  using ArrayType = arrow::DictionaryArray;
+  type = std::dynamic_pointer_cast<arrow::DictionaryType>(chunks[0]->type());
+  dictionary = std::dynamic_pointer_cast<ArrayType>(chunks[0])->dictionary();
+  bool unified = true;
+  for (auto const& chunk : chunks) {
+    auto array = std::dynamic_pointer_cast<ArrayType>(chunk);
+    if (array->dictionary() != dictionary &&
+        !array->dictionary()->Equals(dictionary)) {
+      unified = false;
+      break;
+    }
+  }
+
+  // the chunks with different dictionaries are transposed to the unified
+  // dictionary, then the dictionary is stored only once.
+  indices.clear();
+  if (unified) {
+    for (auto const& chunk : chunks) {
+      indices.emplace_back(
+          std::dynamic_pointer_cast<ArrayType>(chunk)->indices());
+    }
+    return Status::OK();
+  }
+  std::shared_ptr<arrow::DataType> index_type = type->index_type();
+  std::unique_ptr<arrow::DictionaryUnifier> unifier;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      unifier, arrow::DictionaryUnifier::Make(type->value_type()));
+  std::vector<std::shared_ptr<arrow::Buffer>> transposes;
+  for (auto const& chunk : chunks) {
+    std::shared_ptr<arrow::Buffer> transpose;
+    RETURN_ON_ARROW_ERROR(unifier->Unify(
+        *std::dynamic_pointer_cast<ArrayType>(chunk)->dictionary(),
+        &transpose));
+    transposes.emplace_back(transpose);
+  }
+  std::shared_ptr<arrow::DataType> unified_type;
+  RETURN_ON_ARROW_ERROR(unifier->GetResult(&unified_type, &dictionary));
+  // keep the original index type unless the unified dictionary needs a
+  // wider one
+  auto unified_index_type =
+      std::dynamic_pointer_cast<arrow::DictionaryType>(unified_type)
+          ->index_type();
+  if (std::dynamic_pointer_cast<arrow::FixedWidthType>(unified_index_type)
+          ->bit_width() >
+      std::dynamic_pointer_cast<arrow::FixedWidthType>(index_type)
+          ->bit_width()) {
+    index_type = unified_index_type;
+  }
+  type = std::dynamic_pointer_cast<arrow::DictionaryType>(
+      arrow::dictionary(index_type, type->value_type(), type->ordered()));
+  for (size_t index = 0; index < chunks.size(); ++index) {
+    auto array = std::dynamic_pointer_cast<ArrayType>(chunks[index]);
+    std::shared_ptr<arrow::Array> transposed;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        transposed,
+        array->Transpose(
+            type, dictionary,
+            reinterpret_cast<const int32_t*>(transposes[index]->data())));
+    indices.emplace_back(
+        std::dynamic_pointer_cast<ArrayType>(transposed)->indices());
+  }
+  return Status::OK();
+}
+
+static Status ShareDictionaries(
+    Client& client, std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
+    std::map<int64_t, std::shared_ptr<Object>>& dictionaries) {
+  if (batches.size() < 2) {
+    return Status::OK();
+  }
+  auto schema = batches[0]->schema();
+  std::vector<std::shared_ptr<arrow::Field>> fields = schema->fields();
+  std::vector<std::vector<std::shared_ptr<arrow::Array>>> columns(
+      batches.size());
+  for (size_t index = 0; index < batches.size(); ++index) {
+    columns[index] = batches[index]->columns();
+  }
+  for (int column = 0; column < schema->num_fields(); ++column) {
+    if (fields[column]->type()->id() != arrow::Type::DICTIONARY) {
+      continue;
+    }
+    std::vector<std::shared_ptr<arrow::Array>> chunks;
+    for (auto const& batch : batches) {
+      chunks.emplace_back(batch->column(column));
+    }
+    std::shared_ptr<arrow::DictionaryType> type;
+    std::shared_ptr<arrow::Array> dictionary;
+    std::vector<std::shared_ptr<arrow::Array>> indices;
+    RETURN_ON_ERROR(UnifyDictionaries(chunks, type, dictionary, indices));
+    std::shared_ptr<Object> object;
+    RETURN_ON_ERROR(BuildArray(client, dictionary)->Seal(client, object));
+    dictionaries[column] = object;
+    fields[column] = fields[column]->WithType(type);
+    for (size_t index = 0; index < batches.size(); ++index) {
+      columns[index][column] =
+          std::make_shared<arrow::DictionaryArray>(type, indices[index],
+                                                   dictionary);
+    }
+  }
+  if (dictionaries.empty()) {
+    return Status::OK();
+  }
+  schema = arrow::schema(fields, schema->metadata());
+  for (size_t index = 0; index < batches.size(); ++index) {
+    batches[index] = arrow::RecordBatch::Make(
+        schema, batches[index]->num_rows(), columns[index]);
+  }
+  return Status::OK();
+}
+
+}  // namespace detail
+
+Status DictionaryArrayBuilder::Build(Client& client) {
+  if (shared_dictionary_) {
+    // only the indices are copied, the dictionary object is referenced
+    auto dictionary = detail::CastToArray(shared_dictionary_);
+    if (dictionary == nullptr) {
+      return Status::Invalid("The shared dictionary is not an array: " +
+                             shared_dictionary_->meta().GetTypeName());
+    }
+    for (auto const& chunk : this->arrays_) {
+      RETURN_ON_ERROR(
+          detail::CheckDictionaryIndices(chunk, dictionary->length()));
+    }
+    auto indices = std::make_shared<arrow::ChunkedArray>(this->arrays_,
+                                                         shared_index_type_);
+    this->arrays_.clear();  // release the reference
+    this->set_length_(indices->length());
+    this->set_ordered_(shared_ordered_);
+    this->set_indices_(detail::BuildArray(client, indices));
+    this->set_dictionary_(shared_dictionary_);
+    shared_dictionary_.reset();
+    return Status::OK();
+  }
+  if (this->arrays_.empty()) {
+    return Status::Invalid("Must pass at least one array");
+  }
+
+  std::shared_ptr<arrow::DictionaryType> type;
+  std::shared_ptr<arrow::Array> dictionary;
+  std::vector<std::shared_ptr<arrow::Array>> indices;
+  RETURN_ON_ERROR(
+      detail::UnifyDictionaries(this->arrays_, type, dictionary, indices));
+  this->arrays_.clear();  // release the reference
+
+  int64_t length = 0;
+  for (auto const& chunk : indices) {
+    length += chunk->length();
+  }
+  this->set_length_(length);
+  this->set_ordered_(type->ordered());
+  this->set_indices_(detail::BuildArray(
+      client,
+      std::make_shared<arrow::ChunkedArray>(indices, type->index_type())));
+  this->set_dictionary_(detail::BuildArray(client, dictionary));
+  return Status::OK();
+}
+
 void SchemaProxy::PostConstruct(const ObjectMeta& meta) {
   std::shared_ptr<arrow::Buffer> wrapper;
   // the binary value is not roundtrip, see also:
@@ -948,6 +1503,11 @@ void RecordBatch::PostConstruct(const ObjectMeta& meta) {
   }
 }
 
+Status RecordBatch::Project(json& tree,
+                            std::vector<std::string> const& columns) const {
+  return detail::ProjectRecordBatch(tree, columns);
+}
+
 std::shared_ptr<arrow::RecordBatch> RecordBatch::GetRecordBatch() const {
   if (this->batch_ == nullptr) {
     this->batch_ = arrow::RecordBatch::Make(this->schema_.GetSchema(),
@@ -992,11 +1552,55 @@ Status RecordBatchBuilder::Build(Client& client) {
   }
   batches_.clear();  // release the reference
 
+  // the dictionary-encoded columns may reference a shared dictionary
+  auto build_column = [&](const int64_t idx,
+                          std::shared_ptr<ObjectBuilder>& builder) -> Status {
+    auto column = std::make_shared<arrow::ChunkedArray>(column_chunks[idx]);
+    column_chunks[idx].clear();  // release the reference
+    auto dictionary = shared_dictionaries_.find(idx);
+    if (dictionary == shared_dictionaries_.end()) {
+      return detail::BuildArray(client, column, builder);
+    }
+    auto type =
+        std::dynamic_pointer_cast<arrow::DictionaryType>(column->type());
+    if (type == nullptr) {
+      return Status::Invalid("The column " + std::to_string(idx) +
+                             " is not dictionary-encoded: " +
+                             column->type()->ToString());
+    }
+    std::vector<std::shared_ptr<arrow::Array>> indices;
+    for (auto const& chunk : column->chunks()) {
+      indices.emplace_back(
+          std::dynamic_pointer_cast<arrow::DictionaryArray>(chunk)->indices());
+    }
+    builder = std::make_shared<DictionaryArrayBuilder>(
+        client, dictionary->second,
+        std::make_shared<arrow::ChunkedArray>(indices, type->index_type()),
+        type->ordered());
+    return Status::OK();
+  };
+
+  if (concurrency_ > 1) {
+    // build the columns into vineyard concurrently
+    std::vector<std::shared_ptr<ObjectBuilder>> builders(num_columns);
+    for (int64_t idx = 0; idx < num_columns; ++idx) {
+      RETURN_ON_ERROR(build_column(idx, builders[idx]));
+    }
+    std::vector<std::shared_ptr<Object>> columns;
+    RETURN_ON_ERROR(
+        detail::SealBuilders(client, builders, columns, concurrency_));
+    builders.clear();  // release the reference
+    for (auto const& column : columns) {
+      this->add_columns_(column);
+    }
+    return Status::OK();
+  }
+
   // build the columns into vineyard
   for (int64_t idx = 0; idx < num_columns; ++idx) {
-    this->add_columns_(detail::BuildArray(
-        client, std::make_shared<arrow::ChunkedArray>(column_chunks[idx])));
-    column_chunks[idx].clear();  // release the reference
+    std::shared_ptr<ObjectBuilder> builder;
+    RETURN_ON_ERROR(build_column(idx, builder));
+    this->add_columns_(builder);
   }
   return Status::OK();
 }
@@ -1076,9 +1680,16 @@ Status RecordBatchConsolidator::ConsolidateColumns(
   for (int64_t const& column : columns) {
     columns_to_consolidate.push_back(this->arrow_columns_[column]);
   }
+  // the consolidated column is filled into blobs directly
   std::shared_ptr<arrow::Array> consolidated_column;
-  RETURN_ON_ERROR(vineyard::ConsolidateColumns(columns_to_consolidate,
-                                               consolidated_column));
+  std::shared_ptr<ObjectBuilder> consolidated_builder;
+  {
+    memory::VineyardMemoryPool pool(client);
+    RETURN_ON_ERROR(vineyard::ConsolidateColumns(columns_to_consolidate,
+                                                 consolidated_column, &pool));
+    RETURN_ON_ERROR(detail::BuildConsolidatedColumn(
+        client, pool, consolidated_column, consolidated_builder));
+  }
 
   this->column_num_ -= (columns.size() - 1);
   std::vector<int64_t> sorted_column_indexes(columns);
@@ -1092,7 +1703,7 @@ Status RecordBatchConsolidator::ConsolidateColumns(
                                      schema_->RemoveField(index_to_remove));
   }
   this->arrow_columns_.emplace_back(consolidated_column);
-  this->add_columns_(detail::BuildArray(client, consolidated_column));
+  this->add_columns_(consolidated_builder);
   RETURN_ON_ARROW_ERROR_AND_ASSIGN(
       schema_, schema_->AddField(schema_->num_fields(),
                                  ::arrow::field(consolidate_name,
@@ -1117,12 +1728,31 @@ void Table::PostConstruct(const ObjectMeta& meta) {
   this->meta_.GetKeyValue("num_rows_", this->num_rows_);
   this->meta_.GetKeyValue("num_columns_", this->num_columns_);
   this->meta_.GetKeyValue("batch_num_", this->batch_num_);
+  if (this->meta_.HasKey("version_")) {
+    this->meta_.GetKeyValue("version_", this->version_);
+    this->meta_.GetKeyValue("previous_version_", this->previous_version_);
+  }
   for (auto iter = this->LocalBegin(); iter != this->LocalEnd();
        iter.NextLocal()) {
     this->batches_.emplace_back(std::dynamic_pointer_cast<RecordBatch>(*iter));
   }
 }
 
+Status Table::Project(json& tree,
+                      std::vector<std::string> const& columns) const {
+  std::vector<int> indices;
+  RETURN_ON_ERROR(detail::ProjectSchema(tree["schema_"], columns, indices));
+  size_t batch_num = tree.value("partitions_-size", static_cast<size_t>(0));
+  for (size_t index = 0; index < batch_num; ++index) {
+    auto& batch = tree["partitions_-" + std::to_string(index)];
+    if (batch.is_object() && batch.contains("__columns_-size")) {
+      RETURN_ON_ERROR(detail::ProjectRecordBatch(batch, columns));
+    }
+  }
+  tree["num_columns_"] = columns.size();
+  return Status::OK();
+}
+
 std::shared_ptr<arrow::Table> Table::GetTable() const {
   if (this->table_ == nullptr) {
     if (batch_num_ > 0) {
@@ -1166,20 +1796,50 @@ Status TableBuilder::Build(Client& client) {
   }
   tables_.clear();  // release the reference
 
+  // the dictionary-encoded columns of all batches share one dictionary,
+  // rather than storing a dictionary for every batch
+  std::map<int64_t, std::shared_ptr<Object>> dictionaries;
+  if (!merge_chunks_) {
+    RETURN_ON_ERROR(detail::ShareDictionaries(client, batches, dictionaries));
+  }
+  auto make_builder = [&](const std::shared_ptr<arrow::RecordBatch>& batch) {
+    auto builder = std::make_shared<RecordBatchBuilder>(client, batch);
+    for (auto const& item : dictionaries) {
+      builder->set_shared_dictionary(item.first, item.second);
+    }
+    return builder;
+  };
+
   this->set_num_rows_(num_rows);
   this->set_num_columns_(batches[0]->num_columns());
   RETURN_ON_ERROR(this->set_schema(batches[0]->schema()));
 
   if (merge_chunks_) {
     this->set_batch_num_(1);
-    RETURN_ON_ERROR(
-        this->AddMember(std::make_shared<RecordBatchBuilder>(client, batches)));
+    auto builder = std::make_shared<RecordBatchBuilder>(client, batches);
+    builder->set_concurrency(concurrency_);
+    RETURN_ON_ERROR(this->AddMember(builder));
     batches.clear();  // release the reference
+  } else if (concurrency_ > 1) {
+    this->set_batch_num_(batches.size());
+    // parallelize over batches when there are enough of them, otherwise
+    // over the columns inside each batch
+    const bool over_batches = batches.size() >= concurrency_;
+    std::vector<std::shared_ptr<ObjectBuilder>> builders;
+    for (auto const& batch : batches) {
+      auto builder = make_builder(batch);
+      builder->set_concurrency(over_batches ? 1 : concurrency_);
+      builders.emplace_back(builder);
+    }
+    batches.clear();  // release the reference
+    std::vector<std::shared_ptr<Object>> objects;
+    RETURN_ON_ERROR(detail::SealBuilders(client, builders, objects,
+                                         over_batches ? concurrency_ : 1));
+    this->AddMembers(objects);
   } else {
     this->set_batch_num_(batches.size());
     for (auto const& batch : batches) {
-      RETURN_ON_ERROR(
-          this->AddMember(std::make_shared<RecordBatchBuilder>(client, batch)));
+      RETURN_ON_ERROR(this->AddMember(make_builder(batch)));
     }
     batches.clear();  // release the reference
   }
@@ -1352,4 +2012,192 @@ Status TableConsolidator::Build(Client& client) {
   return Status::OK();
 }
 
+TableAppender::TableAppender(Client& client,
+                             const std::shared_ptr<arrow::Schema> schema)
+    : TableBuilder(client, nullptr) {
+  column_num_ = schema->num_fields();
+  schema_ = schema;
+}
+
+TableAppender::TableAppender(Client& client, const std::shared_ptr<Table> table)
+    : TableBuilder(client, nullptr) {
+  row_num_ = table->num_rows();
+  column_num_ = table->num_columns();
+  version_ = table->version() + 1;
+  schema_ = table->schema();
+  base_ = table;
+}
+
+Status TableAppender::Append(Client& client,
+                             const std::shared_ptr<arrow::RecordBatch> batch) {
+  if (!batch->schema()->Equals(*schema_, false)) {
+    return Status::Invalid(
+        "The appended batch doesn't have a matched schema: expects " +
+        schema_->ToString() + ", but got " + batch->schema()->ToString());
+  }
+  if (batch->num_rows() == 0) {
+    return Status::OK();
+  }
+  batches_.emplace_back(batch);
+  row_num_ += batch->num_rows();
+  return Status::OK();
+}
+
+Status TableAppender::Append(Client& client,
+                             const std::shared_ptr<arrow::Table> table) {
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  RETURN_ON_ERROR(TableToRecordBatches(table, &batches));
+  for (auto const& batch : batches) {
+    RETURN_ON_ERROR(this->Append(client, batch));
+  }
+  return Status::OK();
+}
+
+namespace detail {
+
+/**
+ * @brief A record batch of the next version: either a batch of the previous
+ * version that is shared by its metadata, or a run of rows that will be
+ * copied into a new record batch.
+ */
+struct AppendedRun {
+  size_t num_rows = 0;
+  bool mergeable = true;
+  std::string key;
+  ObjectMeta meta;
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+};
+
+}  // namespace detail
+
+constexpr size_t TableAppender::default_max_rewritten_rows;
+
+Status TableAppender::Build(Client& client) {
+  std::vector<detail::AppendedRun> runs;
+  auto materialize = [&](detail::AppendedRun& run) -> Status {
+    if (run.batches.empty()) {
+      std::shared_ptr<RecordBatch> batch;
+      RETURN_ON_ERROR(base_->meta().GetMember(run.key, batch));
+      run.batches.emplace_back(batch->GetRecordBatch());
+    }
+    return Status::OK();
+  };
+  // merges the trailing runs that are not larger than twice of the new one,
+  // thus the sizes of runs decrease geometrically, until the rows of the
+  // previous version that would be copied exceed the limit of this build
+  size_t rewritten_rows = 0;
+  auto push = [&](detail::AppendedRun run) -> Status {
+    while (compact_ && run.mergeable && !runs.empty() &&
+           runs.back().mergeable && runs.back().num_rows <= 2 * run.num_rows) {
+      detail::AppendedRun& last = runs.back();
+      if (last.batches.empty()) {
+        if (rewritten_rows + last.num_rows > max_rewritten_rows_) {
+          break;
+        }
+        rewritten_rows += last.num_rows;
+      }
+      RETURN_ON_ERROR(materialize(last));
+      last.batches.insert(last.batches.end(), run.batches.begin(),
+                          run.batches.end());
+      last.num_rows += run.num_rows;
+      run = std::move(last);
+      runs.pop_back();
+    }
+    runs.emplace_back(std::move(run));
+    return Status::OK();
+  };
+
+  if (base_ != nullptr) {
+    // share the record batches (including the remote ones) of the previous
+    // version, by their metadata rather than copying the blobs
+    for (size_t index = 0; index < base_->size(); ++index) {
+      detail::AppendedRun run;
+      run.key = detail::index_to_key(index);
+      RETURN_ON_ERROR(base_->meta().GetMemberMeta(run.key, run.meta));
+      run.meta.GetKeyValue("row_num_", run.num_rows);
+      run.mergeable = run.meta.IsLocal();
+      runs.emplace_back(std::move(run));
+    }
+    this->AddMember("schema_",
+                    std::static_pointer_cast<Object>(base_->schema_));
+    this->AddKeyValue("previous_version_", base_->id());
+  } else {
+    RETURN_ON_ERROR(this->set_schema(schema_));
+    this->AddKeyValue("previous_version_", InvalidObjectID());
+  }
+  for (auto const& batch : batches_) {
+    detail::AppendedRun run;
+    run.num_rows = batch->num_rows();
+    run.batches.emplace_back(batch);
+    RETURN_ON_ERROR(push(std::move(run)));
+  }
+  batches_.clear();
+
+  for (auto const& run : runs) {
+    if (run.batches.empty()) {
+      this->AddMember(run.meta);
+    } else {
+      RETURN_ON_ERROR(this->AddMember(
+          std::make_shared<RecordBatchBuilder>(client, run.batches)));
+    }
+  }
+  this->set_batch_num_(runs.size());
+  this->set_num_rows_(row_num_);
+  this->set_num_columns_(column_num_);
+  this->AddKeyValue("version_", version_);
+  return Status::OK();
+}
+
+Status TableAppender::Publish(Client& client, const std::string& name,
+                              std::shared_ptr<Table>& table) {
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(this->Seal(client, object));
+  RETURN_ON_ERROR(client.Persist(object->id()));
+  auto status = client.PutName(
+      object->id(), name, base_ ? base_->id() : InvalidObjectID());
+  if (!status.ok()) {
+    // another writer has published first: drop this version, but keep the
+    // record batches that are still shared by other versions
+    VINEYARD_DISCARD(client.DelData(object->id(), false, true));
+    return status;
+  }
+  table = std::dynamic_pointer_cast<Table>(object);
+  return Status::OK();
+}
+
+Status TableAppender::Latest(Client& client, const std::string& name,
+                             std::shared_ptr<Table>& table, const bool wait) {
+  ObjectID id = InvalidObjectID();
+  RETURN_ON_ERROR(client.GetName(name, id, wait));
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(client.GetObject(id, object));
+  table = std::dynamic_pointer_cast<Table>(object);
+  if (table == nullptr) {
+    return Status::Invalid("The object associated with '" + name +
+                           "' is not a table: " + object->meta().GetTypeName());
+  }
+  return Status::OK();
+}
+
+Status ImportTable(Client& client, const std::string& path,
+                   std::shared_ptr<Table>& table) {
+  std::shared_ptr<arrow::Table> arrow_table;
+  RETURN_ON_ERROR(ReadTableFromFile(path, &arrow_table));
+  TableBuilder builder(client, arrow_table);
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(builder.Seal(client, object));
+  table = std::dynamic_pointer_cast<Table>(object);
+  return Status::OK();
+}
+
+Status ExportTable(const std::shared_ptr<Table>& table, const int fd,
+                   const bool file_format) {
+  return WriteTableToFd(table->GetTable(), fd, file_format);
+}
+
+Status ExportTable(const std::shared_ptr<Table>& table,
+                   const std::string& path, const bool file_format) {
+  return WriteTableToFile(table->GetTable(), path, file_format);
+}
+
 }  // namespace vineyard
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MODULES_BASIC_DS_ARROW_H_
 #define MODULES_BASIC_DS_ARROW_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -47,6 +48,15 @@ std::shared_ptr<ObjectBuilder> BuildArray(Client& client,
 std::shared_ptr<ObjectBuilder> BuildArray(
     Client& client, std::shared_ptr<arrow::ChunkedArray> array);
 
+/**
+ * @brief Seal the builders using at most `concurrency` threads, the sealed
+ * objects are returned in the same order of the builders.
+ */
+Status SealBuilders(Client& client,
+                    std::vector<std::shared_ptr<ObjectBuilder>> const& builders,
+                    std::vector<std::shared_ptr<Object>>& objects,
+                    const size_t concurrency = 1);
+
 }  // namespace detail
 
 /**
@@ -405,10 +415,66 @@ class FixedSizeListArrayBuilder : public FixedSizeListArrayBaseBuilder {
   FixedSizeListArrayBuilder(Client& client,
                             const std::shared_ptr<arrow::ChunkedArray> array);
 
+  /**
+   * @brief Build the list array from the builder of its values, e.g., the
+   * consolidated columns that have already been filled into blobs.
+   */
+  FixedSizeListArrayBuilder(Client& client, const size_t length,
+                            const int32_t list_size,
+                            std::shared_ptr<ObjectBuilder> values);
+
   Status Build(Client& client) override;
 
  private:
   std::vector<std::shared_ptr<arrow::Array>> arrays_;
+
+  size_t prebuilt_length_ = 0;
+  int32_t prebuilt_list_size_ = 0;
+  std::shared_ptr<ObjectBuilder> prebuilt_values_;
+};
+
+/**
+ * @brief DictionaryArrayBuilder is designed for constructing Arrow arrays of
+ * dictionary data type, i.e., categorical columns.
+ *
+ * The dictionaries of the chunks are unified into one dictionary object, and
+ * the indices are transposed accordingly. To share a dictionary that has
+ * already been sealed, e.g., across tables, pass the dictionary object (see
+ * `DictionaryArray::GetDictionary()`) together with the indices, then only
+ * the indices are copied into blobs. The indices are checked against the size
+ * of the shared dictionary when building.
+ */
+class DictionaryArrayBuilder : public DictionaryArrayBaseBuilder {
+ public:
+  using ArrayType = arrow::DictionaryArray;
+
+  DictionaryArrayBuilder(Client& client,
+                         const std::shared_ptr<ArrayType> array);
+
+  DictionaryArrayBuilder(Client& client,
+                         const std::vector<std::shared_ptr<ArrayType>>& array);
+
+  DictionaryArrayBuilder(Client& client,
+                         const std::shared_ptr<arrow::ChunkedArray> array);
+
+  DictionaryArrayBuilder(Client& client,
+                         const std::shared_ptr<Object> dictionary,
+                         const std::shared_ptr<arrow::Array> indices,
+                         const bool ordered = false);
+
+  DictionaryArrayBuilder(Client& client,
+                         const std::shared_ptr<Object> dictionary,
+                         const std::shared_ptr<arrow::ChunkedArray> indices,
+                         const bool ordered = false);
+
+  Status Build(Client& client) override;
+
+ private:
+  std::vector<std::shared_ptr<arrow::Array>> arrays_;
+
+  std::shared_ptr<Object> shared_dictionary_;
+  std::shared_ptr<arrow::DataType> shared_index_type_;
+  bool shared_ordered_ = false;
 };
 
 #undef BUILD_NULL_BITMAP
@@ -443,10 +509,30 @@ class RecordBatchBuilder : public RecordBatchBaseBuilder {
       Client& client,
       const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches);
 
+  /**
+   * @brief Copy and seal the columns using at most `concurrency` threads,
+   * the columns are built one after another by default.
+   */
+  void set_concurrency(const size_t concurrency) {
+    this->concurrency_ = concurrency;
+  }
+
+  /**
+   * @brief Reference the sealed `dictionary` for the dictionary-encoded
+   * `column` rather than storing its dictionary again. The column must be
+   * encoded against the same dictionary.
+   */
+  void set_shared_dictionary(const int64_t column,
+                             const std::shared_ptr<Object> dictionary) {
+    this->shared_dictionaries_[column] = dictionary;
+  }
+
   Status Build(Client& client) override;
 
  private:
   std::vector<std::shared_ptr<arrow::RecordBatch>> batches_;
+  std::map<int64_t, std::shared_ptr<Object>> shared_dictionaries_;
+  size_t concurrency_ = 1;
 };
 
 /**
@@ -509,6 +595,14 @@ class TableBuilder : public CollectionBuilder<RecordBatch> {
                const std::vector<std::shared_ptr<arrow::Table>>& table,
                const bool merge_chunks = false);
 
+  /**
+   * @brief Copy and seal the record batches and their columns using at most
+   * `concurrency` threads, the columns are built one after another by default.
+   */
+  void set_concurrency(const size_t concurrency) {
+    this->concurrency_ = concurrency;
+  }
+
   Status Build(Client& client) override;
 
   void set_num_rows(const size_t num_rows);
@@ -532,6 +626,7 @@ class TableBuilder : public CollectionBuilder<RecordBatch> {
  private:
   std::vector<std::shared_ptr<arrow::Table>> tables_;
   bool merge_chunks_ = false;
+  size_t concurrency_ = 1;
 };
 
 /**
@@ -579,5 +674,119 @@ class TableConsolidator : public TableBuilder {
       record_batch_consolidators_;
 };
 
+/**
+ * @brief TableAppender builds the next version of an append-only table.
+ *
+ * Every version is a sealed table that works as the manifest of the version:
+ * the record batches of the previous version are shared by object id and
+ * only the appended rows are copied into new blobs, thus an append costs
+ * O(new rows) rather than O(table). Readers pin a version by holding the
+ * object id of the table, and writers publish a new version by re-pointing a
+ * name to it, e.g.,
+ *
+ *     std::shared_ptr<Table> current, next;
+ *     VINEYARD_CHECK_OK(TableAppender::Latest(client, "events", current));
+ *     TableAppender appender(client, current);
+ *     VINEYARD_CHECK_OK(appender.Append(client, batch));
+ *     VINEYARD_CHECK_OK(appender.Publish(client, "events", next));
+ *
+ * By default every appended batch becomes a record batch of the new version,
+ * thus the manifest grows with the number of appends. To bound it, the
+ * trailing small batches can be merged when appending, see `set_compact()`.
+ *
+ * Publishing is a compare-and-swap on the name: it fails with `ObjectExists`
+ * if another writer has published a version after this appender started, and
+ * the writer can then append to the latest version again.
+ *
+ * Deleting an old version with `deep = true` releases its manifest, and the
+ * record batches that have been merged away by newer versions, as the record
+ * batches that are still referenced by newer versions won't be deleted.
+ */
+class TableAppender : public TableBuilder {
+ public:
+  /**
+   * @brief Start an empty table (of version 0) with the given schema.
+   */
+  TableAppender(Client& client, std::shared_ptr<arrow::Schema> schema);
+
+  /**
+   * @brief Start the next version of the given table.
+   */
+  TableAppender(Client& client, std::shared_ptr<Table> table);
+
+  Status Append(Client& client, std::shared_ptr<arrow::RecordBatch> batch);
+
+  Status Append(Client& client, std::shared_ptr<arrow::Table> table);
+
+  static constexpr size_t default_max_rewritten_rows = 1024 * 1024;
+
+  /**
+   * @brief Whether to merge the trailing small record batches, disabled by
+   * default, i.e., an append never copies existing rows.
+   *
+   * When enabled, the appended batches are merged with the trailing record
+   * batches that are not larger than twice of them, like a binary counter,
+   * thus the sizes of record batches decrease geometrically. To bound the
+   * cost of a single append, at most `max_rewritten_rows` rows of the
+   * previous versions are copied by a build, and the merging stops at the
+   * first record batch beyond that.
+   */
+  void set_compact(
+      const bool compact,
+      const size_t max_rewritten_rows = default_max_rewritten_rows) {
+    compact_ = compact;
+    max_rewritten_rows_ = max_rewritten_rows;
+  }
+
+  Status Build(Client& client) override;
+
+  /**
+   * @brief Seal and persist the new version, and associate the `name` with
+   * it if the name is still associated with the version this appender
+   * started from (or with nothing, for the first version). Readers that
+   * resolve the name either see the previous version or this one, never a
+   * partially appended table.
+   *
+   * If another writer has published first, the new version is deleted and
+   * an `ObjectExists` error is returned.
+   */
+  Status Publish(Client& client, const std::string& name,
+                 std::shared_ptr<Table>& table);
+
+  /**
+   * @brief Resolve the latest published version of the table that is
+   * associated with the `name`.
+   */
+  static Status Latest(Client& client, const std::string& name,
+                       std::shared_ptr<Table>& table, const bool wait = false);
+
+ private:
+  size_t row_num_ = 0, column_num_ = 0, version_ = 0;
+  bool compact_ = false;
+  size_t max_rewritten_rows_ = default_max_rewritten_rows;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::shared_ptr<Table> base_;
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches_;
+};
+
+/**
+ * @brief Import an arrow IPC stream or file (i.e., feather v2) as a vineyard
+ * table. The file is memory-mapped and its buffers are copied into blobs
+ * exactly once.
+ */
+Status ImportTable(Client& client, const std::string& path,
+                   std::shared_ptr<Table>& table);
+
+/**
+ * @brief Export the vineyard table as an arrow IPC stream, or an IPC file
+ * (i.e., feather v2) if `file_format` is true, to the file descriptor (a file,
+ * or a socket). The buffers are written directly from the mapped blobs.
+ */
+Status ExportTable(const std::shared_ptr<Table>& table, const int fd,
+                   const bool file_format = false);
+
+Status ExportTable(const std::shared_ptr<Table>& table,
+                   const std::string& path, const bool file_format = true);
+
 }  // namespace vineyard
 #endif  // MODULES_BASIC_DS_ARROW_H_
@@ -69,6 +69,9 @@
 #include "arrow/visitor_inline.h"
 #endif
 
+#include "basic/utils.h"
+#include "common/memory/memcpy.h"
+
 namespace vineyard {
 
 namespace arrow_shim {
@@ -711,16 +714,37 @@ Result<std::shared_ptr<Array>> Concatenate(ArrayVector&& arrays,
 
 Result<std::shared_ptr<Buffer>> ConcatenateBuffers(
     std::vector<std::shared_ptr<Buffer>>&& buffers, MemoryPool* pool) {
-  int64_t out_length = 0;
-  for (const auto& buffer : buffers) {
-    out_length += buffer->size();
+  // the position of each buffer in the output
+  std::vector<int64_t> positions(buffers.size() + 1, 0);
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    positions[i + 1] = positions[i] + buffers[i]->size();
   }
+  int64_t out_length = positions.back();
   ARROW_ASSIGN_OR_RAISE(auto out, AllocateBuffer(out_length, pool));
   auto out_data = out->mutable_data();
-  for (auto& buffer : buffers) {
-    std::memcpy(out_data, buffer->data(), buffer->size());
-    out_data += buffer->size();
-    buffer.reset();  // release the reference
+
+  // many small buffers are copied by multiple threads, one buffer per thread,
+  // and large buffers are copied by `concurrent_memcpy`
+  static constexpr int64_t kParallelThreshold = 16 * 1024 * 1024;
+  static constexpr int64_t kLargeBufferThreshold = 4 * 1024 * 1024;
+  size_t concurrency = nested_parallelism(buffers.size());
+  if (concurrency > 1 && out_length >= kParallelThreshold &&
+      out_length / static_cast<int64_t>(buffers.size()) <
+          kLargeBufferThreshold) {
+    parallel_for(
+        static_cast<size_t>(0), buffers.size(),
+        [&](const size_t i) {
+          std::memcpy(out_data + positions[i], buffers[i]->data(),
+                      buffers[i]->size());
+          buffers[i].reset();  // release the reference
+        },
+        concurrency);
+  } else {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      vineyard::memory::concurrent_memcpy(
+          out_data + positions[i], buffers[i]->data(), buffers[i]->size());
+      buffers[i].reset();  // release the reference
+    }
   }
   return std::move(out);
 }
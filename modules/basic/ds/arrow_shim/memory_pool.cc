@@ -15,9 +15,11 @@ limitations under the License.
 
 #include "basic/ds/arrow_shim/memory_pool.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "arrow/buffer.h"
 
@@ -28,7 +30,22 @@ namespace vineyard {
 
 namespace memory {
 
-VineyardMemoryPool::VineyardMemoryPool(Client& client) : client_(client) {
+namespace detail {
+
+// the default alignment of arrow buffers
+static constexpr size_t kSlabAlignment = 64;
+
+inline size_t align_up(const size_t size, const size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace detail
+
+VineyardMemoryPool::VineyardMemoryPool(Client& client)
+    : VineyardMemoryPool(client, 0) {}
+
+VineyardMemoryPool::VineyardMemoryPool(Client& client, const size_t slab_size)
+    : client_(client), slab_size_(slab_size) {
   bytes_allocated_.store(0);
   total_bytes_allocated_.store(0);
   num_allocations_.store(0);
@@ -39,36 +56,129 @@ VineyardMemoryPool::~VineyardMemoryPool() {
   for (auto& it : buffers_) {
     VINEYARD_DISCARD(it.second->Abort(client_));
   }
+  for (auto& slab : slabs_) {
+    if (slab->finalized) {
+      for (auto const& blob : slab->blobs) {
+        VINEYARD_DISCARD(client_.DropBuffer(blob.second, slab->fd));
+      }
+    } else {
+      // recycle the whole slab
+      VINEYARD_DISCARD(client_.ReleaseArena(slab->fd, {}, {}));
+    }
+  }
 }
 
 arrow::Status VineyardMemoryPool::Allocate(int64_t size, uint8_t** out) {
-  if (size > 0) {
-    std::unique_ptr<BlobWriter> sbuffer;
-    auto status = client_.CreateBlob(size, sbuffer);
-    if (!status.ok()) {
-      return arrow::Status(arrow::StatusCode::OutOfMemory, status.ToString());
-    }
+  return allocate(size, detail::kSlabAlignment, out);
+}
 
-    *out = reinterpret_cast<uint8_t*>(sbuffer->Buffer()->mutable_data());
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      bytes_allocated_.fetch_add(size);
-      total_bytes_allocated_.fetch_add(size);
-      num_allocations_.fetch_add(1);
-      buffers_.emplace(reinterpret_cast<uintptr_t>(*out), std::move(sbuffer));
+arrow::Status VineyardMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
+                                             uint8_t** ptr) {
+  return reallocate(old_size, new_size, detail::kSlabAlignment, ptr);
+}
+
+void VineyardMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  std::unique_ptr<BlobWriter> sbuffer;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (freeSlice(buffer)) {
+      return;
     }
-    return arrow::Status::OK();
-  } else {
+    auto it = buffers_.find(reinterpret_cast<uintptr_t>(buffer));
+    if (it != buffers_.end()) {
+      sbuffer = std::move(it->second);
+      bytes_allocated_.fetch_sub(size);
+      buffers_.erase(it);
+    }
+  }
+  if (sbuffer) {
+    VINEYARD_CHECK_OK(sbuffer->Abort(client_));
+  }
+}
+
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 11000000
+arrow::Status VineyardMemoryPool::Allocate(int64_t size, int64_t alignment,
+                                           uint8_t** out) {
+  return allocate(size, alignment, out);
+}
+
+arrow::Status VineyardMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
+                                             int64_t alignment, uint8_t** ptr) {
+  return reallocate(old_size, new_size, alignment, ptr);
+}
+
+void VineyardMemoryPool::Free(uint8_t* buffer, int64_t size,
+                              int64_t alignment) {
+  return this->Free(buffer, size);
+}
+#endif
+
+arrow::Status VineyardMemoryPool::allocate(int64_t size, int64_t alignment,
+                                           uint8_t** out) {
+  if (size <= 0) {
     *out = nullptr;
     return arrow::Status::OK();
   }
+  if (static_cast<size_t>(size) <= slab_size_ / 4) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto status = allocateFromSlab(
+        size, std::max<size_t>(alignment, detail::kSlabAlignment), out);
+    if (!status.ok()) {
+      return arrow::Status(arrow::StatusCode::OutOfMemory, status.ToString());
+    }
+    return arrow::Status::OK();
+  }
+
+  std::unique_ptr<BlobWriter> sbuffer;
+  auto status = client_.CreateBlob(size, sbuffer);
+  if (!status.ok()) {
+    return arrow::Status(arrow::StatusCode::OutOfMemory, status.ToString());
+  }
+
+  *out = reinterpret_cast<uint8_t*>(sbuffer->Buffer()->mutable_data());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_allocated_.fetch_add(size);
+    total_bytes_allocated_.fetch_add(size);
+    num_allocations_.fetch_add(1);
+    buffers_.emplace(reinterpret_cast<uintptr_t>(*out), std::move(sbuffer));
+  }
+  return arrow::Status::OK();
 }
 
-arrow::Status VineyardMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
-                                             uint8_t** ptr) {
+arrow::Status VineyardMemoryPool::reallocate(int64_t old_size, int64_t new_size,
+                                             int64_t alignment, uint8_t** ptr) {
   if (old_size >= new_size) {
     return arrow::Status::OK();
   }
+  if (slab_size_ > 0) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = slices_.find(reinterpret_cast<uintptr_t>(*ptr));
+    if (it != slices_.end()) {
+      Slab& slab = *it->second;
+      size_t offset = reinterpret_cast<uintptr_t>(*ptr) - slab.space;
+      // grow in place if the slice is the last allocation of the slab
+      if (!slab.finalized && slab.slices.rbegin()->first == offset &&
+          static_cast<size_t>(new_size) <= slab_size_ / 4 &&
+          offset + new_size <= slab.size) {
+        slab.slices[offset] = new_size;
+        slab.offset = offset + new_size;
+        bytes_allocated_.fetch_add(new_size - old_size);
+        total_bytes_allocated_.fetch_add(new_size - old_size);
+        num_allocations_.fetch_add(1);
+        return arrow::Status::OK();
+      }
+      lock.unlock();
+
+      uint8_t* out = nullptr;
+      ARROW_RETURN_NOT_OK(allocate(new_size, alignment, &out));
+      inline_memcpy(out, *ptr, old_size);
+      this->Free(*ptr, old_size);
+      *ptr = out;
+      return arrow::Status::OK();
+    }
+  }
+
   std::unique_ptr<BlobWriter> sbuffer;
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -114,38 +224,71 @@ arrow::Status VineyardMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
   return arrow::Status::OK();
 }
 
-void VineyardMemoryPool::Free(uint8_t* buffer, int64_t size) {
-  std::unique_ptr<BlobWriter> sbuffer;
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = buffers_.find(reinterpret_cast<uintptr_t>(buffer));
-    if (it != buffers_.end()) {
-      sbuffer = std::move(it->second);
-      bytes_allocated_.fetch_sub(size);
-      buffers_.erase(it);
-    }
-  }
-  if (sbuffer) {
-    VINEYARD_CHECK_OK(sbuffer->Abort(client_));
+Status VineyardMemoryPool::allocateFromSlab(const size_t size,
+                                            const size_t alignment,
+                                            uint8_t** out) {
+  Slab* slab = slabs_.empty() ? nullptr : slabs_.back().get();
+  size_t offset =
+      slab ? detail::align_up(slab->offset, alignment) : slab_size_ + 1;
+  if (slab == nullptr || slab->finalized || offset + size > slab->size) {
+    std::unique_ptr<Slab> leased(new Slab());
+    RETURN_ON_ERROR(client_.CreateArena(slab_size_, leased->fd, leased->size,
+                                        leased->base, leased->space));
+    slabs_.emplace_back(std::move(leased));
+    slab = slabs_.back().get();
+    // the arena is page-aligned
+    offset = 0;
   }
+  slab->slices.emplace(offset, size);
+  slab->offset = offset + size;
+  *out = reinterpret_cast<uint8_t*>(slab->space + offset);
+  slices_.emplace(reinterpret_cast<uintptr_t>(*out), slab);
+  bytes_allocated_.fetch_add(size);
+  total_bytes_allocated_.fetch_add(size);
+  num_allocations_.fetch_add(1);
+  return Status::OK();
 }
 
-#if defined(ARROW_VERSION) && ARROW_VERSION >= 11000000
-arrow::Status VineyardMemoryPool::Allocate(int64_t size, int64_t alignment,
-                                           uint8_t** out) {
-  return this->Allocate(size, out);
-}
-
-arrow::Status VineyardMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
-                                             int64_t alignment, uint8_t** ptr) {
-  return this->Reallocate(old_size, new_size, ptr);
+Status VineyardMemoryPool::finalizeSlab(Slab& slab) {
+  std::vector<size_t> offsets, sizes;
+  std::vector<ObjectID> ids;
+  for (auto const& slice : slab.slices) {
+    offsets.emplace_back(slice.first);
+    sizes.emplace_back(slice.second);
+  }
+  RETURN_ON_ERROR(client_.ReleaseArena(slab.fd, offsets, sizes, ids));
+  RETURN_ON_ASSERT(ids.size() == offsets.size(),
+                   "the blobs of the slab mismatch with the slices");
+  for (size_t index = 0; index < offsets.size(); ++index) {
+    slab.blobs.emplace(offsets[index], ids[index]);
+  }
+  slab.finalized = true;
+  return Status::OK();
 }
 
-void VineyardMemoryPool::Free(uint8_t* buffer, int64_t size,
-                              int64_t alignment) {
-  return this->Free(buffer, size);
+bool VineyardMemoryPool::freeSlice(uint8_t* buffer) {
+  auto it = slices_.find(reinterpret_cast<uintptr_t>(buffer));
+  if (it == slices_.end()) {
+    return false;
+  }
+  Slab& slab = *it->second;
+  slices_.erase(it);
+  size_t offset = reinterpret_cast<uintptr_t>(buffer) - slab.space;
+  auto slice = slab.slices.find(offset);
+  bytes_allocated_.fetch_sub(slice->second);
+  slab.slices.erase(slice);
+  if (slab.finalized) {
+    auto blob = slab.blobs.find(offset);
+    VINEYARD_DISCARD(client_.DropBuffer(blob->second, slab.fd));
+    slab.blobs.erase(blob);
+  } else {
+    // roll back the bump pointer if the last allocation is freed
+    slab.offset = slab.slices.empty() ? 0
+                                      : slab.slices.rbegin()->first +
+                                            slab.slices.rbegin()->second;
+  }
+  return true;
 }
-#endif
 
 Status VineyardMemoryPool::Take(const uint8_t* buffer,
                                 std::unique_ptr<BlobWriter>& sbuffer) {
@@ -158,6 +301,11 @@ Status VineyardMemoryPool::Take(const uint8_t* buffer,
       buffers_.erase(it);
       return Status::OK();
     }
+    if (slices_.find(reinterpret_cast<uintptr_t>(buffer)) != slices_.end()) {
+      return Status::Invalid(
+          "the buffer is a slice of a slab and can only be taken as a sealed "
+          "blob");
+    }
   }
   return Status::ObjectNotExists(
       "cannot find the blob for pointer " +
@@ -169,6 +317,42 @@ Status VineyardMemoryPool::Take(const std::shared_ptr<arrow::Buffer>& buffer,
   return Take(buffer->data(), sbuffer);
 }
 
+Status VineyardMemoryPool::Take(const uint8_t* buffer,
+                                std::shared_ptr<Blob>& blob) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = slices_.find(reinterpret_cast<uintptr_t>(buffer));
+    if (it != slices_.end()) {
+      Slab& slab = *it->second;
+      if (!slab.finalized) {
+        RETURN_ON_ERROR(finalizeSlab(slab));
+      }
+      size_t offset = reinterpret_cast<uintptr_t>(buffer) - slab.space;
+      size_t size = slab.slices.at(offset);
+      ObjectID blob_id = slab.blobs.at(offset);
+      RETURN_ON_ERROR(client_.Seal(blob_id));
+      blob = Blob::FromAllocator(client_, blob_id,
+                                 reinterpret_cast<uintptr_t>(buffer), size);
+      bytes_allocated_.fetch_sub(size);
+      slab.slices.erase(offset);
+      slab.blobs.erase(offset);
+      slices_.erase(it);
+      return Status::OK();
+    }
+  }
+  std::unique_ptr<BlobWriter> sbuffer;
+  RETURN_ON_ERROR(Take(buffer, sbuffer));
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(sbuffer->Seal(client_, object));
+  blob = std::dynamic_pointer_cast<Blob>(object);
+  return Status::OK();
+}
+
+Status VineyardMemoryPool::Take(const std::shared_ptr<arrow::Buffer>& buffer,
+                                std::shared_ptr<Blob>& blob) {
+  return Take(buffer->data(), blob);
+}
+
 /// The number of bytes that were allocated and not yet free'd through
 /// this allocator.
 int64_t VineyardMemoryPool::bytes_allocated() const {
@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "arrow/memory_pool.h"
 #include "arrow/util/config.h"
@@ -30,10 +31,31 @@ namespace vineyard {
 
 namespace memory {
 
+/**
+ * @brief VineyardMemoryPool lets arrow kernels write their results directly
+ * into vineyard memory, the result buffers can then be taken as blobs without
+ * copying.
+ *
+ * By default, every allocation is a separate blob. In the pooled mode (when
+ * a `slab_size` is given), small allocations are sub-allocated from slabs,
+ * i.e., large arenas leased from vineyardd, which saves the IPC roundtrip per
+ * allocation, and the last allocation of a slab can be grown in place on
+ * `Reallocate`. Allocations that are larger than a quarter of the slab still
+ * go to separate blobs.
+ *
+ * Once a slice of a slab is taken, the slab is finalized: all slices that are
+ * still alive in the slab are registered as blobs by vineyardd, and no
+ * further allocations are served from it. Only the taken slice is sealed,
+ * other slices may still be being written and are sealed when they are taken
+ * themselves. The slices that are not taken are dropped when freed, or when
+ * the pool is destructed.
+ */
 class VineyardMemoryPool : public arrow::MemoryPool {
  public:
   explicit VineyardMemoryPool(Client& client);
 
+  VineyardMemoryPool(Client& client, const size_t slab_size);
+
   ~VineyardMemoryPool() override;
 
   arrow::Status Allocate(int64_t size, uint8_t** out)
@@ -65,6 +87,15 @@ class VineyardMemoryPool : public arrow::MemoryPool {
   Status Take(const std::shared_ptr<arrow::Buffer>& buffer,
               std::unique_ptr<BlobWriter>& sbuffer);
 
+  /**
+   * @brief Take the buffer as a sealed blob, works for both the separate
+   * blobs and the slices of slabs in the pooled mode.
+   */
+  Status Take(const uint8_t* buffer, std::shared_ptr<Blob>& blob);
+
+  Status Take(const std::shared_ptr<arrow::Buffer>& buffer,
+              std::shared_ptr<Blob>& blob);
+
   /// The number of bytes that were allocated and not yet free'd through
   /// this allocator.
   int64_t bytes_allocated() const override;
@@ -92,12 +123,46 @@ class VineyardMemoryPool : public arrow::MemoryPool {
   std::string backend_name() const override;
 
  private:
+  struct Slab {
+    int fd = -1;
+    size_t size = 0;
+    uintptr_t base = 0;
+    uintptr_t space = 0;
+    // the bump pointer
+    size_t offset = 0;
+    bool finalized = false;
+    // live slices: offset -> size
+    std::map<size_t, size_t> slices;
+    // blobs of the live slices after finalized: offset -> blob id
+    std::map<size_t, ObjectID> blobs;
+  };
+
+  arrow::Status allocate(int64_t size, int64_t alignment, uint8_t** out);
+
+  arrow::Status reallocate(int64_t old_size, int64_t new_size,
+                           int64_t alignment, uint8_t** ptr);
+
+  // requires the `mutex_` being held
+  Status allocateFromSlab(const size_t size, const size_t alignment,
+                          uint8_t** out);
+
+  // requires the `mutex_` being held, registers the live slices as unsealed
+  // blobs
+  Status finalizeSlab(Slab& slab);
+
+  // requires the `mutex_` being held, returns false if not found
+  bool freeSlice(uint8_t* buffer);
+
   Client& client_;
+  const size_t slab_size_ = 0;
   std::atomic_size_t bytes_allocated_;
   std::atomic_size_t total_bytes_allocated_;
   std::atomic_size_t num_allocations_;
   std::mutex mutex_;
   std::map<uintptr_t, std::unique_ptr<BlobWriter>> buffers_;
+  std::vector<std::unique_ptr<Slab>> slabs_;
+  // slices of slabs: pointer -> slab
+  std::map<uintptr_t, Slab*> slices_;
 };
 
 }  // namespace memory
@@ -15,8 +15,15 @@ limitations under the License.
 
 #include "basic/ds/arrow_utils.h"
 
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <map>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 
@@ -27,6 +34,7 @@ limitations under the License.
 #include "boost/algorithm/string/join.hpp"
 #include "boost/algorithm/string/split.hpp"
 
+#include "basic/utils.h"
 #include "client/ds/blob.h"
 #include "client/ds/remote_blob.h"
 #include "common/util/logging.h"  // IWYU pragma: keep
@@ -329,18 +337,12 @@ Status DeserializeSchema(const std::shared_ptr<arrow::Buffer>& buffer,
 
 Status SerializeRecordBatch(const std::shared_ptr<arrow::RecordBatch>& batch,
                             std::shared_ptr<arrow::Buffer>* buffer) {
-  std::shared_ptr<arrow::io::BufferOutputStream> out_stream;
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(out_stream,
-                                   arrow::io::BufferOutputStream::Create(1024));
-#if defined(ARROW_VERSION) && ARROW_VERSION < 9000000
-  RETURN_ON_ARROW_ERROR(arrow::ipc::WriteRecordBatchStream(
-      {batch}, arrow::ipc::IpcOptions::Defaults(), out_stream.get()));
-#else
-  RETURN_ON_ARROW_ERROR(arrow::ipc::WriteRecordBatchStream(
-      {batch}, arrow::ipc::IpcWriteOptions::Defaults(), out_stream.get()));
-#endif
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(*buffer, out_stream->Finish());
-  return Status::OK();
+  // allocates the buffer of the exact size up front, rather than growing (and
+  // copying) the buffer of a `BufferOutputStream` during writing
+  size_t size = 0;
+  RETURN_ON_ERROR(GetRecordBatchStreamSize(*batch, &size));
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(*buffer, arrow::AllocateBuffer(size));
+  return SerializeRecordBatchesToAllocatedBuffer({batch}, buffer);
 }
 
 Status DeserializeRecordBatch(const std::shared_ptr<arrow::Buffer>& buffer,
@@ -579,6 +581,198 @@ Status DeserializeTable(const std::shared_ptr<arrow::Buffer> buffer,
   return Status::OK();
 }
 
+namespace detail {
+
+/**
+ * @brief An output stream that writes large pieces (e.g., the body buffers of
+ * record batches) to the file descriptor directly from their memory, together
+ * with the staged small pieces (e.g., the metadata and paddings) in a single
+ * `writev`.
+ */
+class GatherOutputStream : public arrow::io::OutputStream {
+ public:
+  explicit GatherOutputStream(const int fd) : fd_(fd) {
+    staging_.reserve(kStagingCapacity);
+  }
+
+  ~GatherOutputStream() override = default;
+
+  arrow::Status Close() override {
+    if (!closed_) {
+      ARROW_RETURN_NOT_OK(Flush());
+      closed_ = true;
+    }
+    return arrow::Status::OK();
+  }
+
+  bool closed() const override { return closed_; }
+
+  arrow::Result<int64_t> Tell() const override { return position_; }
+
+  using arrow::io::OutputStream::Write;
+
+  arrow::Status Write(const void* data, int64_t nbytes) override {
+    if (nbytes < kGatherThreshold) {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      staging_.insert(staging_.end(), bytes, bytes + nbytes);
+      position_ += nbytes;
+      if (staging_.size() >= kStagingCapacity) {
+        return Flush();
+      }
+      return arrow::Status::OK();
+    }
+    struct iovec iov[2];
+    iov[0].iov_base = staging_.data();
+    iov[0].iov_len = staging_.size();
+    iov[1].iov_base = const_cast<void*>(data);
+    iov[1].iov_len = nbytes;
+    ARROW_RETURN_NOT_OK(writev_all(iov, 2));
+    staging_.clear();
+    position_ += nbytes;
+    return arrow::Status::OK();
+  }
+
+  arrow::Status Flush() override {
+    struct iovec iov[1];
+    iov[0].iov_base = staging_.data();
+    iov[0].iov_len = staging_.size();
+    ARROW_RETURN_NOT_OK(writev_all(iov, 1));
+    staging_.clear();
+    return arrow::Status::OK();
+  }
+
+ private:
+  arrow::Status writev_all(struct iovec* iov, int iovcnt) {
+    while (iovcnt > 0) {
+      if (iov->iov_len == 0) {
+        ++iov, --iovcnt;
+        continue;
+      }
+      ssize_t written = writev(fd_, iov, iovcnt);
+      if (written < 0) {
+        if (errno == EINTR || errno == EAGAIN) {
+          continue;
+        }
+        return arrow::Status::IOError("Failed to write to fd ", fd_, ": ",
+                                      strerror(errno));
+      }
+      // skip the written pieces
+      while (iovcnt > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+        written -= iov->iov_len;
+        ++iov, --iovcnt;
+      }
+      if (iovcnt > 0) {
+        iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + written;
+        iov->iov_len -= written;
+      }
+    }
+    return arrow::Status::OK();
+  }
+
+  // pieces that smaller than this will be copied to the staging buffer
+  static constexpr int64_t kGatherThreshold = 64 * 1024;
+  static constexpr size_t kStagingCapacity = 1024 * 1024;
+
+  const int fd_;
+  bool closed_ = false;
+  int64_t position_ = 0;
+  std::vector<uint8_t> staging_;
+};
+
+}  // namespace detail
+
+Status WriteTableToFd(const std::shared_ptr<arrow::Table> table, const int fd,
+                      const bool file_format) {
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  RETURN_ON_ERROR(TableToRecordBatches(table, &batches));
+  return WriteRecordBatchesToFd(table->schema(), batches, fd, file_format);
+}
+
+Status WriteRecordBatchesToFd(
+    const std::shared_ptr<arrow::Schema> schema,
+    const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
+    const int fd, const bool file_format) {
+  detail::GatherOutputStream stream(fd);
+  std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+#if defined(ARROW_VERSION) && ARROW_VERSION < 2000000
+  if (file_format) {
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        writer, arrow::ipc::NewFileWriter(&stream, schema));
+  } else {
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        writer, arrow::ipc::NewStreamWriter(&stream, schema));
+  }
+#else
+  if (file_format) {
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        writer, arrow::ipc::MakeFileWriter(&stream, schema));
+  } else {
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        writer, arrow::ipc::MakeStreamWriter(&stream, schema));
+  }
+#endif
+  for (auto const& batch : batches) {
+    RETURN_ON_ARROW_ERROR(writer->WriteRecordBatch(*batch));
+  }
+  RETURN_ON_ARROW_ERROR(writer->Close());
+  RETURN_ON_ARROW_ERROR(stream.Close());
+  return Status::OK();
+}
+
+Status WriteTableToFile(const std::shared_ptr<arrow::Table> table,
+                        const std::string& path, const bool file_format) {
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd == -1) {
+    return Status::IOError("Failed to open '" + path +
+                           "': " + strerror(errno));
+  }
+  auto status = WriteTableToFd(table, fd, file_format);
+  if (close(fd) != 0 && status.ok()) {
+    status = Status::IOError("Failed to close '" + path +
+                             "': " + strerror(errno));
+  }
+  return status;
+}
+
+Status ReadTableFromFile(const std::string& path,
+                         std::shared_ptr<arrow::Table>* table) {
+  std::shared_ptr<arrow::io::MemoryMappedFile> file;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      file, arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ));
+  int64_t size = 0;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(size, file->GetSize());
+
+  // the IPC file format starts with the magic "ARROW1"
+  static const std::string magic = "ARROW1";
+  std::shared_ptr<arrow::Buffer> header;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      header, file->ReadAt(0, std::min<int64_t>(size, magic.size())));
+  if (header->ToString() == magic) {
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> reader;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        reader, arrow::ipc::RecordBatchFileReader::Open(file));
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    for (int index = 0; index < reader->num_record_batches(); ++index) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      RETURN_ON_ARROW_ERROR_AND_ASSIGN(batch, reader->ReadRecordBatch(index));
+      batches.emplace_back(batch);
+    }
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+        *table, arrow::Table::FromRecordBatches(reader->schema(), batches));
+    return Status::OK();
+  }
+
+  std::shared_ptr<arrow::RecordBatchReader> batch_reader;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      batch_reader, arrow::ipc::RecordBatchStreamReader::Open(file));
+#if defined(ARROW_VERSION) && ARROW_VERSION < 9000000
+  RETURN_ON_ARROW_ERROR(batch_reader->ReadAll(table));
+#else
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(*table, batch_reader->ToTable());
+#endif
+  return Status::OK();
+}
+
 Status ConcatenateTables(
     const std::vector<std::shared_ptr<arrow::Table>>& tables,
     std::shared_ptr<arrow::Table>& table) {
@@ -981,6 +1175,35 @@ Status GeneralCast(const std::shared_ptr<arrow::Array>& in,
   return Status::OK();
 }
 
+Status GeneralTake(const std::shared_ptr<arrow::Array>& in,
+                   const std::shared_ptr<arrow::Array>& indices,
+                   std::shared_ptr<arrow::Array>& out) {
+#if defined(ARROW_VERSION) && ARROW_VERSION < 1000000
+  arrow::compute::FunctionContext ctx;
+  RETURN_ON_ARROW_ERROR(arrow::compute::Take(
+      &ctx, *in, *indices, arrow::compute::TakeOptions(), &out));
+#else
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(out, arrow::compute::Take(*in, *indices));
+#endif
+  return Status::OK();
+}
+
+Status GeneralTake(const std::shared_ptr<arrow::Table>& in,
+                   const std::shared_ptr<arrow::Array>& indices,
+                   std::shared_ptr<arrow::Table>& out) {
+#if defined(ARROW_VERSION) && ARROW_VERSION < 1000000
+  arrow::compute::FunctionContext ctx;
+  RETURN_ON_ARROW_ERROR(arrow::compute::Take(
+      &ctx, *in, *indices, arrow::compute::TakeOptions(), &out));
+#else
+  arrow::Datum taken;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      taken, arrow::compute::Take(arrow::Datum(in), arrow::Datum(indices)));
+  out = taken.table();
+#endif
+  return Status::OK();
+}
+
 Status CastBatchToSchema(const std::shared_ptr<arrow::RecordBatch>& batch,
                          const std::shared_ptr<arrow::Schema>& schema,
                          std::shared_ptr<arrow::RecordBatch>& out) {
@@ -1091,74 +1314,63 @@ inline bool IsDataTypeConsolidatable(std::shared_ptr<arrow::DataType> type) {
   }
 }
 
+// assign the rows [begin, end) of the array to the target with stride
 template <typename T>
-inline void AssignArrayWithStride(std::shared_ptr<arrow::Buffer> array,
-                                  std::shared_ptr<arrow::Buffer> target,
-                                  int64_t length, int64_t stride,
-                                  int64_t offset) {
-  auto array_data = reinterpret_cast<const T*>(array->data());
-  auto target_data = reinterpret_cast<T*>(target->mutable_data());
-  for (int64_t i = 0; i < length; ++i) {
+inline void AssignArrayWithStride(std::shared_ptr<arrow::Array> const& array,
+                                  uint8_t* target, int64_t begin, int64_t end,
+                                  int64_t stride, int64_t offset) {
+  auto array_data = array->data()->GetValues<T>(1);
+  auto target_data = reinterpret_cast<T*>(target);
+  for (int64_t i = begin; i < end; ++i) {
     target_data[i * stride + offset] = array_data[i];
   }
 }
 
-inline void AssignArrayWithStrideUntyped(std::shared_ptr<arrow::Array> array,
-                                         std::shared_ptr<arrow::Buffer> target,
-                                         int64_t length, int64_t stride,
-                                         int64_t offset) {
+inline void AssignArrayWithStrideUntyped(
+    std::shared_ptr<arrow::Array> const& array, uint8_t* target,
+    int64_t begin, int64_t end, int64_t stride, int64_t offset) {
   if (array->length() == 0) {
     return;
   }
   switch (array->type()->id()) {
   case arrow::Type::INT8: {
-    AssignArrayWithStride<int8_t>(array->data()->buffers[1], target, length,
-                                  stride, offset);
+    AssignArrayWithStride<int8_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::INT16: {
-    AssignArrayWithStride<int16_t>(array->data()->buffers[1], target, length,
-                                   stride, offset);
+    AssignArrayWithStride<int16_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::INT32: {
-    AssignArrayWithStride<int32_t>(array->data()->buffers[1], target, length,
-                                   stride, offset);
+    AssignArrayWithStride<int32_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::INT64: {
-    AssignArrayWithStride<int64_t>(array->data()->buffers[1], target, length,
-                                   stride, offset);
+    AssignArrayWithStride<int64_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::UINT8: {
-    AssignArrayWithStride<uint8_t>(array->data()->buffers[1], target, length,
-                                   stride, offset);
+    AssignArrayWithStride<uint8_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::UINT16: {
-    AssignArrayWithStride<uint16_t>(array->data()->buffers[1], target, length,
-                                    stride, offset);
+    AssignArrayWithStride<uint16_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::UINT32: {
-    AssignArrayWithStride<uint32_t>(array->data()->buffers[1], target, length,
-                                    stride, offset);
+    AssignArrayWithStride<uint32_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::UINT64: {
-    AssignArrayWithStride<uint64_t>(array->data()->buffers[1], target, length,
-                                    stride, offset);
+    AssignArrayWithStride<uint64_t>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::FLOAT: {
-    AssignArrayWithStride<float>(array->data()->buffers[1], target, length,
-                                 stride, offset);
+    AssignArrayWithStride<float>(array, target, begin, end, stride, offset);
     return;
   }
   case arrow::Type::DOUBLE: {
-    AssignArrayWithStride<double>(array->data()->buffers[1], target, length,
-                                  stride, offset);
+    AssignArrayWithStride<double>(array, target, begin, end, stride, offset);
     return;
   }
   default: {
@@ -1168,7 +1380,7 @@ inline void AssignArrayWithStrideUntyped(std::shared_ptr<arrow::Array> array,
 
 Status ConsolidateColumns(
     const std::vector<std::shared_ptr<arrow::Array>>& columns,
-    std::shared_ptr<arrow::Array>& out) {
+    std::shared_ptr<arrow::Array>& out, arrow::MemoryPool* pool) {
   if (columns.size() == 0) {
     return Status::Invalid("No columns to consolidate");
   }
@@ -1197,17 +1409,36 @@ Status ConsolidateColumns(
   std::shared_ptr<arrow::DataType> list_array_dtype =
       arrow::fixed_size_list(dtype, columns.size());
 
+  const int64_t length = columns[0]->length();
   std::shared_ptr<arrow::Buffer> data_buffer;
-  CHECK_ARROW_ERROR_AND_ASSIGN(
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
       data_buffer,
       arrow::AllocateBuffer(
-          columns[0]->length() * columns.size() *
-          static_cast<arrow::FixedWidthType*>(dtype.get())->bit_width() / 8));
-
-  for (size_t index = 0; index < columns.size(); ++index) {
-    auto array = columns[index];
-    AssignArrayWithStrideUntyped(array, data_buffer, array->length(),
-                                 columns.size(), index);
+          length * columns.size() *
+              static_cast<arrow::FixedWidthType*>(dtype.get())->bit_width() /
+              8,
+          pool));
+
+  // fill blocks of rows in parallel, to avoid threads writing to the same
+  // cache lines
+  static constexpr int64_t kRowsPerBlock = 64 * 1024;
+  uint8_t* target = data_buffer->mutable_data();
+  auto fill = [&](const int64_t block) {
+    int64_t begin = block * kRowsPerBlock;
+    int64_t end = std::min(begin + kRowsPerBlock, length);
+    for (size_t index = 0; index < columns.size(); ++index) {
+      AssignArrayWithStrideUntyped(columns[index], target, begin, end,
+                                   columns.size(), index);
+    }
+  };
+  const int64_t blocks = (length + kRowsPerBlock - 1) / kRowsPerBlock;
+  const size_t concurrency = nested_parallelism(blocks);
+  if (concurrency > 1) {
+    parallel_for(static_cast<int64_t>(0), blocks, fill, concurrency, 1);
+  } else {
+    for (int64_t block = 0; block < blocks; ++block) {
+      fill(block);
+    }
   }
 
   // build the list array
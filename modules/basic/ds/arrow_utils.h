@@ -309,6 +309,40 @@ Status SerializeTable(const std::shared_ptr<arrow::Table> table,
 Status DeserializeTable(const std::shared_ptr<arrow::Buffer> buffer,
                         std::shared_ptr<arrow::Table>* table);
 
+/**
+ * @brief Write the table to the file descriptor (a file, or a socket) in the
+ * arrow IPC stream format, or the IPC file format (i.e., feather v2) if
+ * `file_format` is true.
+ *
+ * Unlike `SerializeTable`, the table is not serialized into an intermediate
+ * buffer: the body buffers of record batches are written directly from their
+ * memory (e.g., the mapped blobs) using `writev`, and only the small metadata
+ * pieces are copied.
+ */
+Status WriteTableToFd(const std::shared_ptr<arrow::Table> table, const int fd,
+                      const bool file_format = false);
+
+Status WriteRecordBatchesToFd(
+    const std::shared_ptr<arrow::Schema> schema,
+    const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches,
+    const int fd, const bool file_format = false);
+
+/**
+ * @brief Write the table to the file in the arrow IPC file format (i.e.,
+ * feather v2) by default, see also `WriteTableToFd`.
+ */
+Status WriteTableToFile(const std::shared_ptr<arrow::Table> table,
+                        const std::string& path,
+                        const bool file_format = true);
+
+/**
+ * @brief Read the table from an arrow IPC stream or file (i.e., feather v2),
+ * the format is detected from the magic number. The file is memory-mapped,
+ * and the result table refers to the mapped memory without copying.
+ */
+Status ReadTableFromFile(const std::string& path,
+                         std::shared_ptr<arrow::Table>* table);
+
 /**
  * @brief Concatenate multiple arrow tables into one.
  *
@@ -374,6 +408,22 @@ Status GeneralCast(const std::shared_ptr<arrow::Array>& in,
                    const std::shared_ptr<arrow::DataType>& to_type,
                    std::shared_ptr<arrow::Array>& out);
 
+/**
+ * @brief Gather the items of `in` at the given `indices`, i.e., `out[i]` is
+ * `in[indices[i]]`.
+ */
+Status GeneralTake(const std::shared_ptr<arrow::Array>& in,
+                   const std::shared_ptr<arrow::Array>& indices,
+                   std::shared_ptr<arrow::Array>& out);
+
+/**
+ * @brief Gather the rows of `in` at the given `indices`, i.e., the i-th row
+ * of `out` is the `indices[i]`-th row of `in`.
+ */
+Status GeneralTake(const std::shared_ptr<arrow::Table>& in,
+                   const std::shared_ptr<arrow::Array>& indices,
+                   std::shared_ptr<arrow::Table>& out);
+
 Status CastBatchToSchema(const std::shared_ptr<arrow::RecordBatch>& batch,
                          const std::shared_ptr<arrow::Schema>& schema,
                          std::shared_ptr<arrow::RecordBatch>& out);
@@ -382,9 +432,15 @@ Status CastTableToSchema(const std::shared_ptr<arrow::Table>& table,
                          const std::shared_ptr<arrow::Schema>& schema,
                          std::shared_ptr<arrow::Table>& out);
 
+/**
+ * @brief Consolidate numeric columns into one column (FixedSizeListArray),
+ * the result buffer is allocated from the given memory pool and filled by
+ * multiple threads.
+ */
 Status ConsolidateColumns(
     const std::vector<std::shared_ptr<arrow::Array>>& columns,
-    std::shared_ptr<arrow::Array>& out);
+    std::shared_ptr<arrow::Array>& out,
+    arrow::MemoryPool* pool = arrow::default_memory_pool());
 
 Status ConsolidateColumns(
     const std::vector<std::shared_ptr<arrow::ChunkedArray>>& columns,
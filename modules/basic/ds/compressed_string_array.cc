@@ -0,0 +1,449 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "basic/ds/compressed_string_array.h"  // NOLINT(build/include)
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "wyhash/wyhash.hpp"
+
+#include "basic/utils.h"
+#include "common/util/logging.h"  // IWYU pragma: keep
+
+namespace vineyard {
+
+namespace {
+
+// the number of tokens: the symbols and the escaped bytes
+constexpr size_t token_num = 512;
+
+// the rounds of refining the symbol table over the sample
+constexpr int training_rounds = 5;
+
+// at most so many bytes of strings are sampled to train the symbol table
+constexpr size_t training_sample_bytes = 256 * 1024;
+
+// the number of strings compressed by a task
+constexpr int64_t compress_chunk_size = 64 * 1024;
+
+// the slots of the index keep `index + 1` in the lower bits and the high
+// bits of the hash as a fingerprint, while 0 is an empty slot
+constexpr int slot_index_bits = 40;
+constexpr uint64_t slot_index_mask = (1ULL << slot_index_bits) - 1;
+
+inline uint64_t load_word(const char* data, const size_t size) {
+  uint64_t word = 0;
+  memcpy(&word, data, std::min(size, sizeof(uint64_t)));
+  return word;
+}
+
+inline uint64_t symbol_mask(const size_t length) {
+  return length >= sizeof(uint64_t) ? ~0ULL : (1ULL << (length * 8)) - 1;
+}
+
+inline uint64_t hash_bytes(const char* data, const size_t size) {
+  return wy::hash<std::string>()(data, size);
+}
+
+inline uint64_t make_slot(const uint64_t hash, const size_t index) {
+  return (hash & ~slot_index_mask) | (index + 1);
+}
+
+inline bool slot_matches(const uint64_t slot, const uint64_t hash) {
+  return (slot & ~slot_index_mask) == (hash & ~slot_index_mask);
+}
+
+inline size_t slot_index(const uint64_t slot) {
+  return (slot & slot_index_mask) - 1;
+}
+
+}  // namespace
+
+StringSymbolTable::StringSymbolTable() {
+  memset(symbols_, 0, sizeof(symbols_));
+  memset(lengths_, 0, sizeof(lengths_));
+}
+
+template <typename FUNC_T>
+void StringSymbolTable::tokenize(const char* data, const size_t size,
+                                 FUNC_T&& emit) const {
+  size_t position = 0;
+  while (position < size) {
+    const size_t remaining = size - position;
+    const uint64_t word = load_word(data + position, remaining);
+    int token = 256 + static_cast<uint8_t>(data[position]);
+    for (uint8_t code : candidates_[static_cast<uint8_t>(data[position])]) {
+      const size_t length = lengths_[code];
+      if (length <= remaining &&
+          (word & symbol_mask(length)) == symbols_[code]) {
+        token = code;
+        break;
+      }
+    }
+    emit(token);
+    position += token < 256 ? lengths_[token] : 1;
+  }
+}
+
+StringSymbolTable StringSymbolTable::Train(
+    const std::vector<arrow_string_view>& samples) {
+  struct candidate_t {
+    uint64_t symbol;
+    size_t length;
+    size_t gain;
+  };
+
+  StringSymbolTable table;
+  std::vector<size_t> counts(token_num);
+  std::unordered_map<uint32_t, size_t> pair_counts;
+  std::vector<candidate_t> candidates;
+  for (int round = 0; round < training_rounds; ++round) {
+    // count the tokens and the pairs of adjacent tokens
+    std::fill(counts.begin(), counts.end(), 0);
+    pair_counts.clear();
+    for (auto const& sample : samples) {
+      int previous = -1;
+      table.tokenize(sample.data(), sample.size(), [&](const int token) {
+        counts[token] += 1;
+        if (previous != -1) {
+          pair_counts[(previous << 9) | token] += 1;
+        }
+        previous = token;
+      });
+    }
+
+    // the candidates are the tokens and the concatenations of pairs, which
+    // are ranked by the number of bytes they cover
+    auto token_symbol = [&](const int token, uint64_t& symbol,
+                            size_t& length) {
+      if (token >= 256) {
+        symbol = token - 256;
+        length = 1;
+      } else {
+        symbol = table.symbols_[token];
+        length = table.lengths_[token];
+      }
+    };
+    candidates.clear();
+    for (size_t token = 0; token < token_num; ++token) {
+      if (counts[token] > 0) {
+        candidate_t candidate;
+        token_symbol(token, candidate.symbol, candidate.length);
+        candidate.gain = counts[token] * candidate.length;
+        candidates.emplace_back(candidate);
+      }
+    }
+    for (auto const& pair : pair_counts) {
+      uint64_t first, second;
+      size_t first_length, second_length;
+      token_symbol(pair.first >> 9, first, first_length);
+      token_symbol(pair.first & 511, second, second_length);
+      if (first_length + second_length <= max_symbol_length) {
+        candidates.emplace_back(
+            candidate_t{first | (second << (first_length * 8)),
+                        first_length + second_length,
+                        pair.second * (first_length + second_length)});
+      }
+    }
+
+    // merge the duplicated candidates, and pick the best ones
+    std::sort(candidates.begin(), candidates.end(),
+              [](const candidate_t& lhs, const candidate_t& rhs) {
+                return std::make_pair(lhs.length, lhs.symbol) <
+                       std::make_pair(rhs.length, rhs.symbol);
+              });
+    size_t merged = 0;
+    for (size_t index = 0; index < candidates.size(); ++index) {
+      if (merged > 0 &&
+          candidates[merged - 1].length == candidates[index].length &&
+          candidates[merged - 1].symbol == candidates[index].symbol) {
+        candidates[merged - 1].gain += candidates[index].gain;
+      } else {
+        candidates[merged++] = candidates[index];
+      }
+    }
+    candidates.resize(merged);
+    const size_t selected = std::min(candidates.size(), max_symbol_num);
+    std::partial_sort(candidates.begin(), candidates.begin() + selected,
+                      candidates.end(),
+                      [](const candidate_t& lhs, const candidate_t& rhs) {
+                        if (lhs.gain != rhs.gain) {
+                          return lhs.gain > rhs.gain;
+                        }
+                        return std::make_pair(lhs.length, lhs.symbol) <
+                               std::make_pair(rhs.length, rhs.symbol);
+                      });
+
+    table = StringSymbolTable();
+    for (size_t code = 0; code < selected; ++code) {
+      table.symbols_[code] = candidates[code].symbol;
+      table.lengths_[code] = static_cast<uint8_t>(candidates[code].length);
+    }
+    table.symbol_num_ = selected;
+    table.index();
+  }
+  return table;
+}
+
+void StringSymbolTable::Encode(const char* data, const size_t size,
+                               std::string& out) const {
+  tokenize(data, size, [&](const int token) {
+    if (token < 256) {
+      out.push_back(static_cast<char>(token));
+    } else {
+      out.push_back(static_cast<char>(escape_code));
+      out.push_back(static_cast<char>(token - 256));
+    }
+  });
+}
+
+size_t StringSymbolTable::Decode(const uint8_t* data, const size_t size,
+                                 char* out) const {
+  char* cursor = out;
+  for (size_t position = 0; position < size; ++position) {
+    const uint8_t code = data[position];
+    if (code == escape_code) {
+      *cursor++ = static_cast<char>(data[++position]);
+    } else {
+      // symbols are padded to words, thus copied as a whole
+      memcpy(cursor, &symbols_[code], sizeof(uint64_t));
+      cursor += lengths_[code];
+    }
+  }
+  return cursor - out;
+}
+
+void StringSymbolTable::Serialize(char* out) const {
+  memcpy(out, symbols_, sizeof(symbols_));
+  memcpy(out + sizeof(symbols_), lengths_, sizeof(lengths_));
+}
+
+void StringSymbolTable::Deserialize(const char* in) {
+  memcpy(symbols_, in, sizeof(symbols_));
+  memcpy(lengths_, in + sizeof(symbols_), sizeof(lengths_));
+  symbol_num_ = 0;
+  while (symbol_num_ < max_symbol_num && lengths_[symbol_num_] != 0) {
+    symbol_num_ += 1;
+  }
+  index();
+}
+
+void StringSymbolTable::index() {
+  for (auto& candidates : candidates_) {
+    candidates.clear();
+  }
+  for (size_t code = 0; code < symbol_num_; ++code) {
+    candidates_[symbols_[code] & 0xff].emplace_back(code);
+  }
+  for (auto& candidates : candidates_) {
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [this](const uint8_t lhs, const uint8_t rhs) {
+                       return lengths_[lhs] > lengths_[rhs];
+                     });
+  }
+}
+
+void CompressedStringArray::PostConstruct(const ObjectMeta& meta) {
+  table_.Deserialize(reinterpret_cast<const char*>(symbol_table_->data()));
+  offsets_ptr_ = reinterpret_cast<const int64_t*>(offsets_->data());
+  data_ptr_ = reinterpret_cast<const uint8_t*>(data_->data());
+  index_ptr_ = reinterpret_cast<const uint64_t*>(index_->data());
+}
+
+std::string CompressedStringArray::GetString(const size_t index) const {
+  std::string out;
+  GetString(index, out);
+  return out;
+}
+
+void CompressedStringArray::GetString(const size_t index,
+                                      std::string& out) const {
+  auto compressed = GetCompressedView(index);
+  out.resize(compressed.size() * StringSymbolTable::max_symbol_length);
+  out.resize(table_.Decode(
+      reinterpret_cast<const uint8_t*>(compressed.data()), compressed.size(),
+      &out[0]));
+}
+
+int64_t CompressedStringArray::Find(const arrow_string_view& key) const {
+  if (length_ == 0) {
+    return -1;
+  }
+  thread_local std::string compressed;
+  compressed.clear();
+  table_.Encode(key.data(), key.size(), compressed);
+  const uint64_t hash = hash_bytes(compressed.data(), compressed.size());
+  for (size_t position = hash & index_mask_;;
+       position = (position + 1) & index_mask_) {
+    const uint64_t slot = index_ptr_[position];
+    if (slot == 0) {
+      return -1;
+    }
+    if (slot_matches(slot, hash)) {
+      const size_t index = slot_index(slot);
+      auto candidate = GetCompressedView(index);
+      if (candidate.size() == compressed.size() &&
+          memcmp(candidate.data(), compressed.data(), compressed.size()) ==
+              0) {
+        return index;
+      }
+    }
+  }
+}
+
+CompressedStringArrayBuilder::CompressedStringArrayBuilder(
+    Client& client, const std::shared_ptr<arrow::LargeStringArray>& array,
+    const int concurrency)
+    : CompressedStringArrayBaseBuilder(client),
+      arrays_{array},
+      concurrency_(concurrency) {}
+
+CompressedStringArrayBuilder::CompressedStringArrayBuilder(
+    Client& client,
+    const std::vector<std::shared_ptr<arrow::LargeStringArray>>& arrays,
+    const int concurrency)
+    : CompressedStringArrayBaseBuilder(client),
+      arrays_(arrays),
+      concurrency_(concurrency) {}
+
+CompressedStringArrayBuilder::CompressedStringArrayBuilder(
+    Client& client, const std::shared_ptr<arrow::ChunkedArray>& array,
+    const int concurrency)
+    : CompressedStringArrayBaseBuilder(client), concurrency_(concurrency) {
+  for (auto const& chunk : array->chunks()) {
+    arrays_.emplace_back(
+        std::dynamic_pointer_cast<arrow::LargeStringArray>(chunk));
+  }
+}
+
+Status CompressedStringArrayBuilder::Build(Client& client) {
+  const size_t concurrency = std::max(concurrency_, 1);
+  std::vector<arrow_string_view> strings;
+  size_t raw_bytes = 0;
+  for (auto const& array : arrays_) {
+    RETURN_ON_ASSERT(array != nullptr, "Expect large string arrays");
+    RETURN_ON_ASSERT(array->null_count() == 0,
+                     "Null strings cannot be compressed");
+    for (int64_t index = 0; index < array->length(); ++index) {
+      strings.emplace_back(array->GetView(index));
+      raw_bytes += strings.back().size();
+    }
+  }
+  const int64_t length = strings.size();
+
+  // train the symbol table on evenly spaced samples
+  std::vector<arrow_string_view> samples;
+  const size_t stride = std::max<size_t>(
+      (raw_bytes + training_sample_bytes - 1) / training_sample_bytes, 1);
+  for (int64_t index = 0; index < length; index += stride) {
+    samples.emplace_back(strings[index]);
+  }
+  StringSymbolTable table = StringSymbolTable::Train(samples);
+  std::unique_ptr<BlobWriter> symbol_table_writer;
+  RETURN_ON_ERROR(client.CreateBlob(StringSymbolTable::serialized_size(),
+                                    symbol_table_writer));
+  table.Serialize(symbol_table_writer->data());
+
+  // compress the strings by chunks, then concatenate the chunks
+  std::unique_ptr<BlobWriter> offsets_writer;
+  RETURN_ON_ERROR(
+      client.CreateBlob((length + 1) * sizeof(int64_t), offsets_writer));
+  int64_t* offsets = reinterpret_cast<int64_t*>(offsets_writer->data());
+  const int64_t chunk_num =
+      (length + compress_chunk_size - 1) / compress_chunk_size;
+  std::vector<std::string> chunks(chunk_num);
+  parallel_for(
+      static_cast<int64_t>(0), chunk_num,
+      [&](const int64_t chunk) {
+        const int64_t begin = chunk * compress_chunk_size;
+        const int64_t end = std::min(begin + compress_chunk_size, length);
+        for (int64_t index = begin; index < end; ++index) {
+          offsets[index] = chunks[chunk].size();
+          table.Encode(strings[index].data(), strings[index].size(),
+                       chunks[chunk]);
+        }
+      },
+      concurrency, 1);
+  std::vector<int64_t> chunk_offsets(chunk_num + 1, 0);
+  for (int64_t chunk = 0; chunk < chunk_num; ++chunk) {
+    chunk_offsets[chunk + 1] = chunk_offsets[chunk] + chunks[chunk].size();
+  }
+  std::unique_ptr<BlobWriter> data_writer;
+  if (chunk_offsets[chunk_num] > 0) {
+    RETURN_ON_ERROR(client.CreateBlob(chunk_offsets[chunk_num], data_writer));
+    parallel_for(
+        static_cast<int64_t>(0), chunk_num,
+        [&](const int64_t chunk) {
+          memcpy(data_writer->data() + chunk_offsets[chunk],
+                 chunks[chunk].data(), chunks[chunk].size());
+          const int64_t begin = chunk * compress_chunk_size;
+          const int64_t end = std::min(begin + compress_chunk_size, length);
+          for (int64_t index = begin; index < end; ++index) {
+            offsets[index] += chunk_offsets[chunk];
+          }
+          std::string().swap(chunks[chunk]);
+        },
+        concurrency, 1);
+  }
+  offsets[length] = chunk_offsets[chunk_num];
+
+  // build the index over the compressed strings, with a load factor of at
+  // most 0.75
+  size_t capacity = 1;
+  while (capacity < static_cast<size_t>(length + length / 3 + 1)) {
+    capacity <<= 1;
+  }
+  std::vector<uint64_t> hashes(length);
+  const char* data = data_writer ? data_writer->data() : nullptr;
+  parallel_for(
+      static_cast<int64_t>(0), length,
+      [&](const int64_t index) {
+        hashes[index] = hash_bytes(data + offsets[index],
+                                   offsets[index + 1] - offsets[index]);
+      },
+      concurrency, compress_chunk_size);
+  std::unique_ptr<BlobWriter> index_writer;
+  RETURN_ON_ERROR(client.CreateBlob(capacity * sizeof(uint64_t), index_writer));
+  uint64_t* slots = reinterpret_cast<uint64_t*>(index_writer->data());
+  memset(slots, 0, capacity * sizeof(uint64_t));
+  for (int64_t index = 0; index < length; ++index) {
+    size_t position = hashes[index] & (capacity - 1);
+    while (slots[position] != 0) {
+      position = (position + 1) & (capacity - 1);
+    }
+    slots[position] = make_slot(hashes[index], index);
+  }
+
+  this->set_length_(length);
+  this->set_raw_bytes_(raw_bytes);
+  this->set_index_mask_(capacity - 1);
+  this->set_symbol_table_(
+      std::shared_ptr<BlobWriter>(std::move(symbol_table_writer)));
+  this->set_offsets_(std::shared_ptr<BlobWriter>(std::move(offsets_writer)));
+  if (data_writer) {
+    this->set_data_(std::shared_ptr<BlobWriter>(std::move(data_writer)));
+  } else {
+    this->set_data_(Blob::MakeEmpty(client));
+  }
+  this->set_index_(std::shared_ptr<BlobWriter>(std::move(index_writer)));
+  return Status::OK();
+}
+
+}  // namespace vineyard
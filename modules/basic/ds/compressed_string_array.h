@@ -0,0 +1,65 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_BASIC_DS_COMPRESSED_STRING_ARRAY_H_
+#define MODULES_BASIC_DS_COMPRESSED_STRING_ARRAY_H_
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/compressed_string_array.vineyard.h"
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "client/ds/i_object.h"
+
+namespace vineyard {
+
+/**
+ * @brief CompressedStringArrayBuilder is designed for compressing arrow
+ * (large) string arrays into vineyard, see also `CompressedStringArray`.
+ *
+ * The symbol table is trained on a sample of the strings, then the strings
+ * are compressed, and the index is built, with `concurrency` threads. Null
+ * strings are rejected, as they cannot be told apart from empty strings
+ * once compressed.
+ */
+class CompressedStringArrayBuilder : public CompressedStringArrayBaseBuilder {
+ public:
+  CompressedStringArrayBuilder(
+      Client& client, const std::shared_ptr<arrow::LargeStringArray>& array,
+      const int concurrency = std::thread::hardware_concurrency());
+
+  CompressedStringArrayBuilder(
+      Client& client,
+      const std::vector<std::shared_ptr<arrow::LargeStringArray>>& arrays,
+      const int concurrency = std::thread::hardware_concurrency());
+
+  CompressedStringArrayBuilder(
+      Client& client, const std::shared_ptr<arrow::ChunkedArray>& array,
+      const int concurrency = std::thread::hardware_concurrency());
+
+  Status Build(Client& client) override;
+
+ private:
+  std::vector<std::shared_ptr<arrow::LargeStringArray>> arrays_;
+  int concurrency_;
+};
+
+}  // namespace vineyard
+
+#endif  // MODULES_BASIC_DS_COMPRESSED_STRING_ARRAY_H_
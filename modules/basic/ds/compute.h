@@ -0,0 +1,588 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_BASIC_DS_COMPUTE_H_
+#define MODULES_BASIC_DS_COMPUTE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "basic/ds/arrow.h"
+#include "basic/ds/tensor.h"
+#include "basic/utils.h"
+#include "client/client.h"
+#include "common/util/status.h"
+
+namespace vineyard {
+
+/**
+ * Note [Compute kernels on vineyard arrays]
+ *
+ * The kernels in `vineyard::compute` read the blobs of `NumericArray` and
+ * `Tensor` in place, and write the results (if any) directly into new blobs
+ * through `FixedNumericArrayBuilder` and `TensorBuilder`, without going
+ * through `arrow::compute` and the heap allocations there.
+ *
+ * The inner loops are written to be vectorized by the compiler: reductions
+ * keep several independent accumulators, and the validity (and mask) bitmaps
+ * are consumed 64 bits at a time, where a fully-set word falls back to the
+ * dense loop and an empty word is skipped.
+ *
+ * When `ComputeOptions::concurrency` is larger than 1, the input is split into
+ * chunks of `ComputeOptions::chunk_size` elements that are processed by
+ * multiple threads, and the partial results are merged at the end.
+ *
+ * Kernels that produce arrays (`Filter`, `Take` and `Cast`) require the input
+ * arrays to have no nulls, as `FixedNumericArrayBuilder` produces arrays
+ * without validity bitmaps.
+ */
+
+namespace compute {
+
+struct ComputeOptions {
+  // the number of threads, kernels are single-threaded by default
+  size_t concurrency = 1;
+  // the number of elements in each chunk for multithreaded computation
+  size_t chunk_size = 1024 * 1024;
+};
+
+/**
+ * @brief The accumulator type of `Sum`: int64_t for signed integers, uint64_t
+ * for unsigned integers and double for floating-point numbers.
+ */
+template <typename T>
+struct SumType {
+  using type = typename std::conditional<
+      std::is_floating_point<T>::value, double,
+      typename std::conditional<std::is_signed<T>::value, int64_t,
+                                uint64_t>::type>::type;
+};
+
+namespace detail {
+
+static constexpr size_t kAccumulators = 8;
+
+// loads 64 bits from the bitmap, starting at the given bit offset
+inline uint64_t load_bitmap_word(const uint8_t* bitmap, const int64_t offset) {
+  const uint8_t* bytes = bitmap + (offset >> 3);
+  const int shift = offset & 7;
+  uint64_t word = 0;
+  memcpy(&word, bytes, sizeof(uint64_t));
+  if (shift != 0) {
+    word = (word >> shift) |
+           (static_cast<uint64_t>(bytes[sizeof(uint64_t)]) << (64 - shift));
+  }
+  return word;
+}
+
+inline bool get_bit(const uint8_t* bitmap, const int64_t offset) {
+  return (bitmap[offset >> 3] >> (offset & 7)) & 1;
+}
+
+/**
+ * @brief Visit the positions in [begin, end) whose bits are set in the
+ * bitmap (or all positions if the bitmap is null): `dense(i, n)` for n
+ * consecutive positions from i, and `sparse(i)` for a single position.
+ */
+template <typename DenseFn, typename SparseFn>
+inline void visit_set_bits(const uint8_t* bitmap, const int64_t offset,
+                           const size_t begin, const size_t end,
+                           DenseFn&& dense, SparseFn&& sparse) {
+  if (bitmap == nullptr) {
+    dense(begin, end - begin);
+    return;
+  }
+  size_t i = begin;
+  for (; i + 64 <= end; i += 64) {
+    uint64_t word = load_bitmap_word(bitmap, offset + i);
+    if (word == ~static_cast<uint64_t>(0)) {
+      dense(i, 64);
+    } else {
+      while (word != 0) {
+        sparse(i + __builtin_ctzll(word));
+        word &= word - 1;
+      }
+    }
+  }
+  for (; i < end; ++i) {
+    if (get_bit(bitmap, offset + i)) {
+      sparse(i);
+    }
+  }
+}
+
+inline size_t count_set_bits(const uint8_t* bitmap, const int64_t offset,
+                             const size_t begin, const size_t end) {
+  if (bitmap == nullptr) {
+    return end - begin;
+  }
+  size_t count = 0, i = begin;
+  for (; i + 64 <= end; i += 64) {
+    count += __builtin_popcountll(load_bitmap_word(bitmap, offset + i));
+  }
+  for (; i < end; ++i) {
+    count += get_bit(bitmap, offset + i);
+  }
+  return count;
+}
+
+template <typename T>
+inline typename SumType<T>::type sum_dense(const T* values, const size_t n) {
+  using S = typename SumType<T>::type;
+  S acc[kAccumulators] = {};
+  size_t i = 0;
+  for (; i + kAccumulators <= n; i += kAccumulators) {
+    for (size_t k = 0; k < kAccumulators; ++k) {
+      acc[k] += static_cast<S>(values[i + k]);
+    }
+  }
+  for (; i < n; ++i) {
+    acc[0] += static_cast<S>(values[i]);
+  }
+  S result = 0;
+  for (size_t k = 0; k < kAccumulators; ++k) {
+    result += acc[k];
+  }
+  return result;
+}
+
+template <typename T, typename Compare>
+inline T extremum_dense(const T* values, const size_t n, T init,
+                        Compare&& compare) {
+  T acc[kAccumulators];
+  std::fill(acc, acc + kAccumulators, init);
+  size_t i = 0;
+  for (; i + kAccumulators <= n; i += kAccumulators) {
+    for (size_t k = 0; k < kAccumulators; ++k) {
+      acc[k] = compare(values[i + k], acc[k]) ? values[i + k] : acc[k];
+    }
+  }
+  for (; i < n; ++i) {
+    acc[0] = compare(values[i], acc[0]) ? values[i] : acc[0];
+  }
+  T result = init;
+  for (size_t k = 0; k < kAccumulators; ++k) {
+    result = compare(acc[k], result) ? acc[k] : result;
+  }
+  return result;
+}
+
+/**
+ * @brief Run `fn(chunk_begin, chunk_end, chunk_index)` over the chunks of
+ * [0, n), in parallel if required.
+ */
+inline size_t chunk_size_of(ComputeOptions const& options) {
+  // keep chunks aligned with bitmap words
+  return (std::max<size_t>(options.chunk_size, 64) + 63) / 64 * 64;
+}
+
+inline size_t chunk_count(const size_t n, ComputeOptions const& options) {
+  const size_t chunk_size = chunk_size_of(options);
+  return std::max<size_t>((n + chunk_size - 1) / chunk_size, 1);
+}
+
+template <typename Fn>
+inline void for_each_chunk(const size_t n, ComputeOptions const& options,
+                           Fn&& fn) {
+  const size_t chunk_size = chunk_size_of(options);
+  const size_t chunks = chunk_count(n, options);
+  if (options.concurrency <= 1 || chunks == 1) {
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+      fn(chunk * chunk_size, std::min(n, (chunk + 1) * chunk_size), chunk);
+    }
+  } else {
+    parallel_for(
+        static_cast<size_t>(0), chunks,
+        [&](const size_t chunk) {
+          fn(chunk * chunk_size, std::min(n, (chunk + 1) * chunk_size), chunk);
+        },
+        std::min(options.concurrency, chunks), 1);
+  }
+}
+
+template <typename T>
+typename SumType<T>::type sum(const T* values, const uint8_t* validity,
+                              const int64_t offset, const size_t n,
+                              ComputeOptions const& options) {
+  using S = typename SumType<T>::type;
+  std::vector<S> partials(chunk_count(n, options));
+  for_each_chunk(
+      n, options, [&](const size_t begin, const size_t end, const size_t idx) {
+        S partial = 0;
+        visit_set_bits(
+            validity, offset, begin, end,
+            [&](const size_t i, const size_t len) {
+              partial += sum_dense(values + i, len);
+            },
+            [&](const size_t i) { partial += static_cast<S>(values[i]); });
+        partials[idx] = partial;
+      });
+  return sum_dense(partials.data(), partials.size());
+}
+
+template <typename T, typename Compare>
+bool extremum(const T* values, const uint8_t* validity, const int64_t offset,
+              const size_t n, ComputeOptions const& options, T init,
+              Compare&& compare, T& result) {
+  if (count_set_bits(validity, offset, 0, n) == 0) {
+    return false;
+  }
+  std::vector<T> partials(chunk_count(n, options), init);
+  for_each_chunk(
+      n, options, [&](const size_t begin, const size_t end, const size_t idx) {
+        T partial = init;
+        visit_set_bits(
+            validity, offset, begin, end,
+            [&](const size_t i, const size_t len) {
+              T value = extremum_dense(values + i, len, init, compare);
+              partial = compare(value, partial) ? value : partial;
+            },
+            [&](const size_t i) {
+              partial = compare(values[i], partial) ? values[i] : partial;
+            });
+        partials[idx] = partial;
+      });
+  result = extremum_dense(partials.data(), partials.size(), init, compare);
+  return true;
+}
+
+template <typename T>
+bool min(const T* values, const uint8_t* validity, const int64_t offset,
+         const size_t n, ComputeOptions const& options, T& result) {
+  return extremum(
+      values, validity, offset, n, options,
+      std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                           : std::numeric_limits<T>::max(),
+      [](const T a, const T b) { return a < b; }, result);
+}
+
+template <typename T>
+bool max(const T* values, const uint8_t* validity, const int64_t offset,
+         const size_t n, ComputeOptions const& options, T& result) {
+  return extremum(
+      values, validity, offset, n, options,
+      std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                           : std::numeric_limits<T>::lowest(),
+      [](const T a, const T b) { return a > b; }, result);
+}
+
+inline size_t count(const uint8_t* validity, const int64_t offset,
+                    const size_t n, ComputeOptions const& options) {
+  std::vector<size_t> partials(chunk_count(n, options));
+  for_each_chunk(
+      n, options, [&](const size_t begin, const size_t end, const size_t idx) {
+        partials[idx] = count_set_bits(validity, offset, begin, end);
+      });
+  return sum_dense(partials.data(), partials.size());
+}
+
+/**
+ * @brief Copy the values whose bits are set in the mask to `out`, which must
+ * have the room of `count(mask, mask_offset, n)` elements.
+ */
+template <typename T>
+void filter(const T* values, const uint8_t* mask, const int64_t mask_offset,
+            const size_t n, T* out, ComputeOptions const& options) {
+  const size_t chunks = chunk_count(n, options);
+  std::vector<size_t> offsets(chunks + 1);
+  // pass 1: count the selected values in each chunk
+  for_each_chunk(
+      n, options, [&](const size_t begin, const size_t end, const size_t idx) {
+        offsets[idx + 1] = count_set_bits(mask, mask_offset, begin, end);
+      });
+  for (size_t idx = 0; idx < chunks; ++idx) {
+    offsets[idx + 1] += offsets[idx];
+  }
+  // pass 2: copy the selected values to the output
+  for_each_chunk(
+      n, options, [&](const size_t begin, const size_t end, const size_t idx) {
+        T* target = out + offsets[idx];
+        visit_set_bits(
+            mask, mask_offset, begin, end,
+            [&](const size_t i, const size_t len) {
+              memcpy(target, values + i, len * sizeof(T));
+              target += len;
+            },
+            [&](const size_t i) { *target++ = values[i]; });
+      });
+}
+
+template <typename T, typename I>
+void take(const T* values, const I* indices, const size_t n, T* out,
+          ComputeOptions const& options) {
+  for_each_chunk(
+      n, options, [&](const size_t begin, const size_t end, const size_t) {
+        for (size_t i = begin; i < end; ++i) {
+          out[i] = values[indices[i]];
+        }
+      });
+}
+
+template <typename T, typename U>
+void cast(const T* values, const size_t n, U* out,
+          ComputeOptions const& options) {
+  for_each_chunk(
+      n, options, [&](const size_t begin, const size_t end, const size_t) {
+        for (size_t i = begin; i < end; ++i) {
+          out[i] = static_cast<U>(values[i]);
+        }
+      });
+}
+
+template <typename T>
+inline const uint8_t* validity_of(const NumericArray<T>& array) {
+  auto const& arrow_array = array.GetArray();
+  return arrow_array->null_count() == 0 ? nullptr
+                                        : arrow_array->null_bitmap_data();
+}
+
+template <typename T>
+inline size_t size_of(const Tensor<T>& tensor) {
+  size_t size = 1;
+  for (auto const dim : tensor.shape()) {
+    size *= dim;
+  }
+  return size;
+}
+
+template <typename T>
+inline Status seal_array(Client& client,
+                         std::shared_ptr<FixedNumericArrayBuilder<T>>& builder,
+                         std::shared_ptr<NumericArray<T>>& out) {
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(builder->Seal(client, object));
+  out = std::dynamic_pointer_cast<NumericArray<T>>(object);
+  return Status::OK();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Sum of the non-null values in the array.
+ */
+template <typename T>
+Status Sum(const NumericArray<T>& array, typename SumType<T>::type& result,
+           ComputeOptions const& options = {}) {
+  result = detail::sum(array.raw_values(), detail::validity_of(array),
+                       array.GetArray()->offset(), array.length(), options);
+  return Status::OK();
+}
+
+template <typename T>
+Status Sum(const Tensor<T>& tensor, typename SumType<T>::type& result,
+           ComputeOptions const& options = {}) {
+  result = detail::sum(tensor.data(), nullptr, 0, detail::size_of(tensor),
+                       options);
+  return Status::OK();
+}
+
+/**
+ * @brief Minimum of the non-null values in the array, or `Invalid` if there
+ * is no such value.
+ */
+template <typename T>
+Status Min(const NumericArray<T>& array, T& result,
+           ComputeOptions const& options = {}) {
+  if (!detail::min(array.raw_values(), detail::validity_of(array),
+                   array.GetArray()->offset(), array.length(), options,
+                   result)) {
+    return Status::Invalid("min of an array without non-null values");
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Min(const Tensor<T>& tensor, T& result,
+           ComputeOptions const& options = {}) {
+  if (!detail::min(tensor.data(), nullptr, 0, detail::size_of(tensor),
+                   options, result)) {
+    return Status::Invalid("min of an empty tensor");
+  }
+  return Status::OK();
+}
+
+/**
+ * @brief Maximum of the non-null values in the array, or `Invalid` if there
+ * is no such value.
+ */
+template <typename T>
+Status Max(const NumericArray<T>& array, T& result,
+           ComputeOptions const& options = {}) {
+  if (!detail::max(array.raw_values(), detail::validity_of(array),
+                   array.GetArray()->offset(), array.length(), options,
+                   result)) {
+    return Status::Invalid("max of an array without non-null values");
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Max(const Tensor<T>& tensor, T& result,
+           ComputeOptions const& options = {}) {
+  if (!detail::max(tensor.data(), nullptr, 0, detail::size_of(tensor),
+                   options, result)) {
+    return Status::Invalid("max of an empty tensor");
+  }
+  return Status::OK();
+}
+
+/**
+ * @brief Number of the non-null values in the array.
+ */
+template <typename T>
+Status Count(const NumericArray<T>& array, size_t& result,
+             ComputeOptions const& options = {}) {
+  result = detail::count(detail::validity_of(array),
+                         array.GetArray()->offset(), array.length(), options);
+  return Status::OK();
+}
+
+template <typename T>
+Status Count(const Tensor<T>& tensor, size_t& result,
+             ComputeOptions const& options = {}) {
+  result = detail::size_of(tensor);
+  return Status::OK();
+}
+
+/**
+ * @brief Select the values where the mask is true (and not null) into a new
+ * array.
+ */
+template <typename T>
+Status Filter(Client& client, const NumericArray<T>& array,
+              const BooleanArray& mask, std::shared_ptr<NumericArray<T>>& out,
+              ComputeOptions const& options = {}) {
+  auto const& arrow_mask = mask.GetArray();
+  if (array.GetArray()->null_count() != 0) {
+    return Status::NotImplemented("filter on arrays with nulls");
+  }
+  if (static_cast<size_t>(arrow_mask->length()) != array.length()) {
+    return Status::Invalid("the length of mask doesn't match the array");
+  }
+  const uint8_t* bitmap = arrow_mask->values()->data();
+  std::unique_ptr<uint8_t[]> selection;
+  if (arrow_mask->null_count() != 0) {
+    // nulls in the mask are treated as false
+    size_t nbytes = (array.length() + 7) / 8 + sizeof(uint64_t);
+    selection.reset(new uint8_t[nbytes]());
+    detail::visit_set_bits(
+        arrow_mask->null_bitmap_data(), arrow_mask->offset(), 0,
+        array.length(),
+        [&](const size_t i, const size_t len) {
+          for (size_t k = i; k < i + len; ++k) {
+            if (detail::get_bit(bitmap, arrow_mask->offset() + k)) {
+              selection[k >> 3] |= static_cast<uint8_t>(1u << (k & 7));
+            }
+          }
+        },
+        [&](const size_t k) {
+          if (detail::get_bit(bitmap, arrow_mask->offset() + k)) {
+            selection[k >> 3] |= static_cast<uint8_t>(1u << (k & 7));
+          }
+        });
+  }
+  const uint8_t* selected = selection ? selection.get() : bitmap;
+  const int64_t selected_offset = selection ? 0 : arrow_mask->offset();
+
+  size_t size = detail::count(selected, selected_offset, array.length(),
+                              options);
+  std::shared_ptr<FixedNumericArrayBuilder<T>> builder;
+  RETURN_ON_ERROR(FixedNumericArrayBuilder<T>::Make(client, size, builder));
+  if (size > 0) {
+    detail::filter(array.raw_values(), selected, selected_offset,
+                   array.length(), builder->data(), options);
+  }
+  return detail::seal_array(client, builder, out);
+}
+
+/**
+ * @brief Gather the values at the given indices into a new array.
+ */
+template <typename T>
+Status Take(Client& client, const NumericArray<T>& array,
+            const NumericArray<int64_t>& indices,
+            std::shared_ptr<NumericArray<T>>& out,
+            ComputeOptions const& options = {}) {
+  if (array.GetArray()->null_count() != 0 ||
+      indices.GetArray()->null_count() != 0) {
+    return Status::NotImplemented("take on arrays with nulls");
+  }
+  int64_t min_index = 0, max_index = -1;
+  if (indices.length() > 0) {
+    detail::min(indices.raw_values(), nullptr, 0, indices.length(), options,
+                min_index);
+    detail::max(indices.raw_values(), nullptr, 0, indices.length(), options,
+                max_index);
+  }
+  if (min_index < 0 || max_index >= static_cast<int64_t>(array.length())) {
+    return Status::Invalid("take indices out of bound: [" +
+                           std::to_string(min_index) + ", " +
+                           std::to_string(max_index) + "]");
+  }
+  std::shared_ptr<FixedNumericArrayBuilder<T>> builder;
+  RETURN_ON_ERROR(
+      FixedNumericArrayBuilder<T>::Make(client, indices.length(), builder));
+  if (indices.length() > 0) {
+    detail::take(array.raw_values(), indices.raw_values(), indices.length(),
+                 builder->data(), options);
+  }
+  return detail::seal_array(client, builder, out);
+}
+
+/**
+ * @brief Cast the values to another numeric type into a new array, using the
+ * C++ `static_cast` semantics.
+ */
+template <typename T, typename U>
+Status Cast(Client& client, const NumericArray<T>& array,
+            std::shared_ptr<NumericArray<U>>& out,
+            ComputeOptions const& options = {}) {
+  if (array.GetArray()->null_count() != 0) {
+    return Status::NotImplemented("cast on arrays with nulls");
+  }
+  std::shared_ptr<FixedNumericArrayBuilder<U>> builder;
+  RETURN_ON_ERROR(
+      FixedNumericArrayBuilder<U>::Make(client, array.length(), builder));
+  if (array.length() > 0) {
+    detail::cast(array.raw_values(), array.length(), builder->data(),
+                 options);
+  }
+  return detail::seal_array(client, builder, out);
+}
+
+template <typename T, typename U>
+Status Cast(Client& client, const Tensor<T>& tensor,
+            std::shared_ptr<Tensor<U>>& out,
+            ComputeOptions const& options = {}) {
+  TensorBuilder<U> builder(client, tensor.shape(), tensor.partition_index());
+  detail::cast(tensor.data(), detail::size_of(tensor), builder.data(),
+               options);
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(builder.Seal(client, object));
+  out = std::dynamic_pointer_cast<Tensor<U>>(object);
+  return Status::OK();
+}
+
+}  // namespace compute
+
+}  // namespace vineyard
+
+#endif  // MODULES_BASIC_DS_COMPUTE_H_
@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "basic/ds/dataframe.h"  // NOLINT(build/include)
 
+#include <algorithm>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "common/util/logging.h"  // IWYU pragma: keep
 
@@ -49,6 +52,54 @@ const std::pair<size_t, size_t> DataFrame::shape() const {
   }
 }
 
+Status DataFrame::Project(json& tree,
+                          std::vector<std::string> const& columns) const {
+  json all_columns =
+      json::parse(tree["columns_"].get_ref<std::string const&>());
+  std::map<std::string, json> values;
+  size_t value_size = tree["__values_-size"].get<size_t>();
+  for (size_t idx = 0; idx < value_size; ++idx) {
+    std::string key = "__values_-key-" + std::to_string(idx);
+    std::string value = "__values_-value-" + std::to_string(idx);
+    values.emplace(tree[key].get<std::string>(), std::move(tree[value]));
+    tree.erase(key);
+    tree.erase(value);
+  }
+
+  // the column names are matched in the same way as `AsBatch()`
+  json projected = json::array();
+  for (auto const& column : columns) {
+    auto iter = std::find_if(
+        all_columns.begin(), all_columns.end(), [&column](json const& cname) {
+          return cname.is_string()
+                     ? cname.get_ref<std::string const&>() == column
+                     : json_to_string(cname) == column;
+        });
+    if (iter == all_columns.end()) {
+      return Status::KeyError("column '" + column + "' not found");
+    }
+    projected.push_back(*iter);
+  }
+  std::vector<std::string> keys;
+  for (auto const& cname : projected) {
+    keys.emplace_back(json_to_string(cname));
+  }
+  keys.emplace_back(json_to_string(json("index_")));
+
+  size_t idx = 0;
+  for (auto const& key : keys) {
+    auto value = values.find(key);
+    if (value != values.end()) {
+      tree["__values_-key-" + std::to_string(idx)] = key;
+      tree["__values_-value-" + std::to_string(idx)] = std::move(value->second);
+      idx += 1;
+    }
+  }
+  tree["__values_-size"] = idx;
+  tree["columns_"] = json_to_string(projected);
+  return Status::OK();
+}
+
 const std::shared_ptr<arrow::RecordBatch> DataFrame::AsBatch(bool copy) const {
   size_t num_columns = this->Columns().size();
   int64_t num_rows = 0;
@@ -167,12 +218,23 @@ void DataFrameBuilder::DropColumn(json const& column) {
   // FIXME: how to ensure the removed builder got destroyed/aborted.
 }
 
+void DataFrameBuilder::set_concurrency(const size_t concurrency) {
+  this->concurrency_ = concurrency;
+}
+
 Status DataFrameBuilder::Build(Client& client) {
   this->set_columns_(columns_);
+  std::vector<json> keys;
+  std::vector<std::shared_ptr<ObjectBuilder>> builders;
   for (auto const& kv : values_) {
-    this->set_values_(
-        kv.first,
-        std::dynamic_pointer_cast<ObjectBuilder>(kv.second)->Seal(client));
+    keys.emplace_back(kv.first);
+    builders.emplace_back(std::dynamic_pointer_cast<ObjectBuilder>(kv.second));
+  }
+  std::vector<std::shared_ptr<Object>> values;
+  RETURN_ON_ERROR(
+      detail::SealBuilders(client, builders, values, concurrency_));
+  for (size_t idx = 0; idx < keys.size(); ++idx) {
+    this->set_values_(keys[idx], values[idx]);
   }
   return Status::OK();
 }
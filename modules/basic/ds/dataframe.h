@@ -98,6 +98,14 @@ class DataFrameBuilder : public DataFrameBaseBuilder {
    */
   void DropColumn(json const& column);
 
+  /**
+   * @brief Seal the columns using at most `concurrency` threads, the columns
+   * are sealed one after another by default.
+   *
+   * @param concurrency The number of threads.
+   */
+  void set_concurrency(const size_t concurrency);
+
   /**
    * @brief Build the dataframe object.
    * @param client The client connected to the vineyard server.
@@ -107,6 +115,7 @@ class DataFrameBuilder : public DataFrameBaseBuilder {
  private:
   std::vector<json> columns_;
   std::unordered_map<json, std::shared_ptr<ITensorBuilder>> values_;
+  size_t concurrency_ = 1;
 };
 
 class GlobalDataFrameBaseBuilder;
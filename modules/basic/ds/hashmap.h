@@ -19,6 +19,7 @@ limitations under the License.
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include "flat_hash_map/flat_hash_map.hpp"
@@ -234,6 +235,30 @@ class PerfectHashmapBuilder : public PerfectHashmapBaseBuilder<K, V> {
   explicit PerfectHashmapBuilder(Client& client)
       : PerfectHashmapBaseBuilder<K, V>(client) {}
 
+  /**
+   * @brief Set the number of threads for building the hash function, which
+   * defaults to the hardware concurrency.
+   */
+  void set_concurrency(const int concurrency) {
+    concurrency_ = std::max(concurrency, 1);
+  }
+
+  /**
+   * @brief Set the gamma of BBHash, i.e., the ratio of the bits of each level
+   * to the keys of the level, which trades the memory (about `e^(1/gamma) *
+   * gamma` bits per key) for the time of building and looking up.
+   */
+  void set_gamma(const double gamma) { gamma_ = std::max(gamma, 1.0); }
+
+  /**
+   * @brief Set the fraction of keys that can be kept in memory during the
+   * building, which avoids re-scanning all keys in the later levels, 0 for
+   * re-scanning.
+   */
+  void set_fastmode_ratio(const float ratio) {
+    fastmode_ratio_ = std::max(ratio, 0.0f);
+  }
+
   Status ComputeHash(Client& client, const K* keys, const V* values,
                      const size_t n_elements) {
     std::shared_ptr<Blob> blob;
@@ -249,12 +274,13 @@ class PerfectHashmapBuilder : public PerfectHashmapBaseBuilder<K, V> {
     this->set_num_elements_(n_elements);
     this->set_ph_keys_(keys);
     RETURN_ON_ERROR(detail::boomphf::build_keys(
-        bphf_, reinterpret_cast<const K*>(keys->data()), n_elements));
+        bphf_, reinterpret_cast<const K*>(keys->data()), n_elements,
+        concurrency_, gamma_, fastmode_ratio_));
     return this->allocateValues(
         client, n_elements, [&](V* shuffled_values) -> Status {
           return detail::boomphf::build_values(
               bphf_, reinterpret_cast<const K*>(keys->data()), n_elements,
-              values, shuffled_values);
+              values, shuffled_values, concurrency_);
         });
   }
 
@@ -266,11 +292,12 @@ class PerfectHashmapBuilder : public PerfectHashmapBaseBuilder<K, V> {
                      const V* values, const size_t n_elements) {
     this->set_num_elements_(n_elements);
     this->set_ph_keys_(keys);
-    RETURN_ON_ERROR(detail::boomphf::build_keys(bphf_, keys->GetArray()));
+    RETURN_ON_ERROR(detail::boomphf::build_keys(
+        bphf_, keys->GetArray(), concurrency_, gamma_, fastmode_ratio_));
     return this->allocateValues(
         client, n_elements, [&](V* shuffled_values) -> Status {
-          return detail::boomphf::build_values(bphf_, keys->GetArray(), values,
-                                               shuffled_values);
+          return detail::boomphf::build_values(
+              bphf_, keys->GetArray(), values, shuffled_values, concurrency_);
         });
     return Status::OK();
   }
@@ -290,12 +317,13 @@ class PerfectHashmapBuilder : public PerfectHashmapBaseBuilder<K, V> {
     this->set_num_elements_(n_elements);
     this->set_ph_keys_(keys);
     RETURN_ON_ERROR(detail::boomphf::build_keys(
-        bphf_, reinterpret_cast<const K*>(keys->data()), n_elements));
+        bphf_, reinterpret_cast<const K*>(keys->data()), n_elements,
+        concurrency_, gamma_, fastmode_ratio_));
     return this->allocateValues(
         client, n_elements, [&](V* shuffled_values) -> Status {
           return detail::boomphf::build_values(
               bphf_, reinterpret_cast<const K*>(keys->data()), n_elements,
-              begin_value, shuffled_values);
+              begin_value, shuffled_values, concurrency_);
         });
   }
 
@@ -307,11 +335,13 @@ class PerfectHashmapBuilder : public PerfectHashmapBaseBuilder<K, V> {
                      const V begin_value, const size_t n_elements) {
     this->set_num_elements_(n_elements);
     this->set_ph_keys_(keys);
-    RETURN_ON_ERROR(detail::boomphf::build_keys(bphf_, keys->GetArray()));
+    RETURN_ON_ERROR(detail::boomphf::build_keys(
+        bphf_, keys->GetArray(), concurrency_, gamma_, fastmode_ratio_));
     return this->allocateValues(
         client, n_elements, [&](V* shuffled_values) -> Status {
           return detail::boomphf::build_values(bphf_, keys->GetArray(),
-                                               begin_value, shuffled_values);
+                                               begin_value, shuffled_values,
+                                               concurrency_);
         });
     return Status::OK();
   }
@@ -361,8 +391,9 @@ class PerfectHashmapBuilder : public PerfectHashmapBaseBuilder<K, V> {
 
   boomphf::mphf<K, hasher_t> bphf_;
 
-  const int concurrency_ = std::thread::hardware_concurrency();
-  const double gamma_ = 2.5f;
+  int concurrency_ = std::max<int>(std::thread::hardware_concurrency(), 1);
+  double gamma_ = 2.5f;
+  float fastmode_ratio_ = 0.03f;
 };
 
 }  // namespace vineyard
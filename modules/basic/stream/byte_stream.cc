@@ -27,6 +27,7 @@ limitations under the License.
 #include "client/client.h"
 #include "client/ds/blob.h"
 #include "client/ds/i_object.h"
+#include "common/memory/memchr.h"
 #include "common/util/uuid.h"
 
 namespace vineyard {
@@ -55,24 +56,117 @@ Status ByteStream::FlushBuffer() {
     std::unique_ptr<BlobWriter> buffer;
     RETURN_ON_ERROR(this->client_->CreateBlob(buf->size(), buffer));
     memcpy(buffer->data(), buf->data(), buf->size());
+    std::shared_ptr<Object> chunk;
+    RETURN_ON_ERROR(buffer->Seal(*this->client_, chunk));
+    RETURN_ON_ERROR(this->Push(chunk));
   }
   return Status::OK();
 }
 
 Status ByteStream::ReadLine(std::string& line) {
-  if (std::getline(ss_, line)) {
+  arrow_string_view view;
+  RETURN_ON_ERROR(ReadLine(view));
+  line.assign(view.data(), view.size());
+  return Status::OK();
+}
+
+Status ByteStream::ReadLine(arrow_string_view& line) {
+  if (partial_consumed_) {
+    partial_.clear();
+    partial_consumed_ = false;
+  }
+  while (true) {
+    if (cursor_ < end_) {
+      const char* p = memory::inline_memchr(cursor_, '\n', end_ - cursor_);
+      if (p != nullptr) {
+        if (partial_.empty()) {
+          line = arrow_string_view(cursor_, p - cursor_);
+        } else {
+          partial_.append(cursor_, p - cursor_);
+          line = arrow_string_view(partial_.data(), partial_.size());
+          partial_consumed_ = true;
+        }
+        cursor_ = p + 1;
+        return Status::OK();
+      }
+      partial_.append(cursor_, end_ - cursor_);
+      cursor_ = end_;
+    }
+    auto status = nextChunk();
+    if (status.IsEndOfFile() && !partial_.empty()) {
+      // the last line without a trailing '\n'
+      line = arrow_string_view(partial_.data(), partial_.size());
+      partial_consumed_ = true;
+      return Status::OK();
+    }
+    RETURN_ON_ERROR(status);
+  }
+}
+
+Status ByteStream::ReadRecords(std::shared_ptr<arrow::Buffer>& records) {
+  auto take_partial = [&]() -> Status {
+    std::shared_ptr<arrow::Buffer> buffer;
+    RETURN_ON_ARROW_ERROR_AND_ASSIGN(buffer,
+                                     arrow::AllocateBuffer(partial_.size()));
+    memcpy(buffer->mutable_data(), partial_.data(), partial_.size());
+    partial_.clear();
+    records = buffer;
     return Status::OK();
+  };
+
+  if (partial_consumed_) {
+    partial_.clear();
+    partial_consumed_ = false;
+  }
+  while (true) {
+    if (cursor_ < end_) {
+      if (!partial_.empty()) {
+        // stitch the record that crosses the chunk boundary
+        const char* p = memory::inline_memchr(cursor_, '\n', end_ - cursor_);
+        if (p != nullptr) {
+          partial_.append(cursor_, p + 1 - cursor_);
+          cursor_ = p + 1;
+          return take_partial();
+        }
+      } else {
+        const char* p = memory::inline_memrchr(cursor_, '\n', end_ - cursor_);
+        if (p != nullptr) {
+          records = arrow::SliceBuffer(chunk_->ArrowBufferOrEmpty(),
+                                       cursor_ - chunk_->data(),
+                                       p + 1 - cursor_);
+          cursor_ = p + 1;
+          return Status::OK();
+        }
+      }
+      partial_.append(cursor_, end_ - cursor_);
+      cursor_ = end_;
+    }
+    auto status = nextChunk();
+    if (status.IsEndOfFile() && !partial_.empty()) {
+      return take_partial();
+    }
+    RETURN_ON_ERROR(status);
   }
+}
 
-  std::shared_ptr<Blob> buffer;
-  if (!this->Next(buffer).ok()) {
+Status ByteStream::nextChunk() {
+  chunk_ = nullptr;
+  cursor_ = end_ = nullptr;
+  if (drained_) {
     return Status::EndOfFile();
   }
-  std::string buf_str = std::string(
-      reinterpret_cast<const char*>(buffer->data()), buffer->size());
-  ss_.str(buf_str);
-  std::getline(ss_, line);
-
+  std::shared_ptr<Blob> chunk;
+  auto status = this->Next(chunk);
+  if (status.IsStreamDrained()) {
+    drained_ = true;
+    return Status::EndOfFile();
+  }
+  RETURN_ON_ERROR(status);
+  chunk_ = chunk;
+  if (chunk_->allocated_size() > 0) {
+    cursor_ = chunk_->data();
+    end_ = cursor_ + chunk_->allocated_size();
+  }
   return Status::OK();
 }
 
@@ -28,6 +28,7 @@ limitations under the License.
 #include "client/ds/blob.h"
 #include "client/ds/i_object.h"
 #include "client/ds/stream.h"
+#include "common/util/arrow.h"
 #include "common/util/uuid.h"
 
 namespace vineyard {
@@ -49,11 +50,41 @@ class ByteStream : public BareRegistered<ByteStream>, public Stream<Blob> {
 
   Status ReadLine(std::string& line);
 
+  /**
+   * @brief Read the next line (without the trailing '\n') without copying.
+   *
+   * The returned view points into the mapped memory of the current chunk,
+   * except for lines that cross chunk boundaries, which are stitched into
+   * an internal buffer. The view is valid until the next read call.
+   */
+  Status ReadLine(arrow_string_view& line);
+
+  /**
+   * @brief Read a batch of complete records, i.e., the returned buffer
+   * always ends with '\n' unless it is the last record in the stream.
+   *
+   * The returned buffer is a zero-copy slice of the chunk blob, except for
+   * the record that crosses chunk boundaries, which is returned as a
+   * standalone (copied) buffer by its own. The buffer keeps the underlying
+   * chunk alive and can be fed into arrow's CSV reader directly.
+   */
+  Status ReadRecords(std::shared_ptr<arrow::Buffer>& records);
+
  protected:
   size_t buffer_size_limit_ = 1024 * 1024 * 256;  // 256Mi
 
   arrow::BufferBuilder builder_;  // for write
-  std::stringstream ss_;          // for read
+
+ private:
+  Status nextChunk();
+
+  // for read
+  std::shared_ptr<Blob> chunk_;
+  const char* cursor_ = nullptr;
+  const char* end_ = nullptr;
+  std::string partial_;  // the partial record that crosses chunk boundaries
+  bool partial_consumed_ = false;
+  bool drained_ = false;
 };
 
 template <>
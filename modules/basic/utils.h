@@ -23,6 +23,29 @@ limitations under the License.
 
 namespace vineyard {
 
+namespace detail {
+
+// whether the current thread is a worker of `parallel_for`
+inline bool& in_parallel_for() {
+  static thread_local bool flag = false;
+  return flag;
+}
+
+}  // namespace detail
+
+/**
+ * @brief The parallelism for a parallel loop of at most `tasks` tasks, loops
+ * that are nested inside the workers of `parallel_for` run sequentially to
+ * avoid oversubscribing the cores.
+ */
+inline size_t nested_parallelism(const size_t tasks) {
+  if (detail::in_parallel_for()) {
+    return 1;
+  }
+  return std::max<size_t>(
+      1, std::min<size_t>(tasks, std::thread::hardware_concurrency()));
+}
+
 template <typename ITER_T, typename FUNC_T>
 void parallel_for(
     const ITER_T& begin, const ITER_T& end, const FUNC_T& func,
@@ -36,6 +59,7 @@ void parallel_for(
   std::atomic<size_t> cur(0);
   for (size_t thread_index = 0; thread_index < parallelism; ++thread_index) {
     threads[thread_index] = std::thread([&]() {
+      detail::in_parallel_for() = true;
       while (true) {
         size_t x = cur.fetch_add(chunk);
         if (x >= num) {
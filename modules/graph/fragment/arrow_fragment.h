@@ -31,6 +31,7 @@ limitations under the License.
 #include "grape/fragment/fragment_base.h"
 #include "grape/graph/adj_list.h"
 #include "grape/utils/vertex_array.h"
+#include "grape/worker/comm_spec.h"
 
 #include "basic/ds/arrow.h"
 #include "basic/ds/arrow_utils.h"
@@ -75,7 +76,9 @@ class BasicArrowFragmentBuilder
                                      std::shared_ptr<vertex_map_t> vm_ptr)
       : ArrowFragmentBaseBuilder<oid_t, vid_t, vertex_map_t, COMPACT>(client),
         client_(client),
-        vm_ptr_(vm_ptr) {}
+        vm_ptr_(vm_ptr) {
+    this->set_compact_edges_codec(CompactEdgesCodec::kStreamVByte);
+  }
 
   vineyard::Status Build(vineyard::Client& client) override;
 
@@ -86,13 +89,71 @@ class BasicArrowFragmentBuilder
       bool directed = true,
       const int concurrency = std::thread::hardware_concurrency());
 
+  /**
+   * @brief The vertex map of the fragment, which is not the one given to the
+   * builder once the vertices are reordered during `Init`.
+   */
+  std::shared_ptr<vertex_map_t> vertex_map() const { return vm_ptr_; }
+
   boost::leaf::result<void> SetPropertyGraphSchema(
       PropertyGraphSchema&& schema) {
     this->set_schema_json_(schema.ToJSON());
     return {};
   }
 
+  /**
+   * @brief Renumber the inner vertices by their degrees (in descending order)
+   * during `Init`, for better locality when accessing the neighbors and their
+   * properties.
+   *
+   * The vertex tables, the edges and the vertex map are permuted consistently,
+   * thus the oid to gid mapping is still correct. The vertex map given to the
+   * builder is replaced by the permuted one (see `vertex_map()`) but is not
+   * deleted, and the caller is responsible for releasing it. It requires the
+   * global vertex map, otherwise it is a no-op.
+   */
+  void set_reorder_vertices(const bool reorder_vertices) {
+    reorder_vertices_ = reorder_vertices;
+  }
+
+  /**
+   * @brief Renumber the inner vertices of multiple fragments, every fragment
+   * permutes its own inner vertices, and the permutations are exchanged
+   * through `comm_spec` to rewrite the gids of outer vertices. All fragments
+   * must be built with reordering collectively.
+   */
+  void set_reorder_vertices(const bool reorder_vertices,
+                            const grape::CommSpec& comm_spec) {
+    reorder_vertices_ = reorder_vertices;
+    comm_spec_ = std::make_shared<grape::CommSpec>(comm_spec);
+  }
+
+  /**
+   * @brief The codec of compact edges, which is recorded in the metadata
+   * of the fragment. The StreamVByte codec is used by default, as it can
+   * be decoded by SIMD shuffles.
+   */
+  void set_compact_edges_codec(const CompactEdgesCodec codec) {
+    this->set_compact_edges_codec_(static_cast<int>(codec));
+  }
+
  private:
+  // permutes inner vertices in vertex tables, edge tables and vertex map
+  boost::leaf::result<void> reorderVertices(
+      std::vector<std::shared_ptr<arrow::Table>>& vertex_tables,
+      std::vector<std::shared_ptr<arrow::Table>>& edge_tables,
+      int concurrency);
+
+  // replaces the vertex map with the one permuted by the inverse orders of
+  // all fragments, indexed by [fid][label]
+  boost::leaf::result<void> reorderVertexMap(
+      const std::vector<std::vector<std::vector<vid_t>>>& inverse_orders,
+      int concurrency, std::false_type /* is local vertex map */);
+
+  boost::leaf::result<void> reorderVertexMap(
+      const std::vector<std::vector<std::vector<vid_t>>>& inverse_orders,
+      int concurrency, std::true_type /* is local vertex map */);
+
   // | prop_0 | prop_1 | ... |
   boost::leaf::result<void> initVertices(
       std::vector<std::shared_ptr<arrow::Table>>&& vertex_tables);
@@ -124,6 +185,9 @@ class BasicArrowFragmentBuilder
 
   std::shared_ptr<vertex_map_t> vm_ptr_;
   IdParser<vid_t> vid_parser_;
+
+  bool reorder_vertices_ = false;
+  std::shared_ptr<grape::CommSpec> comm_spec_;
 };
 
 }  // namespace vineyard
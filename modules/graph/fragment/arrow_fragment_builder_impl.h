@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstddef>
+#include <future>
 #include <map>
 #include <memory>
 #include <set>
@@ -42,6 +43,7 @@ limitations under the License.
 
 #include "basic/ds/arrow.h"
 #include "basic/ds/arrow_utils.h"
+#include "basic/utils.h"
 #include "common/util/functions.h"
 #include "common/util/typename.h"
 
@@ -914,21 +916,26 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::AddEdgesToExistedLabel(
     extra_ovgid_lists[i].reset();  // release the reference
   }
 
+  if (this->compact_edges_) {
+    RETURN_GS_ERROR(
+        ErrorCode::kUnimplementedMethod,
+        "Varint encoding is not implemented for adding vertices/edges");
+  }
+
+  // the offsets of the base CSR are expanded only for the vertex labels that
+  // get new outer vertices, the base lists are kept as they are
   std::vector<std::vector<std::shared_ptr<FixedInt64Builder>>>
       ie_offsets_lists_expanded(vertex_label_num_);
   std::vector<std::vector<std::shared_ptr<FixedInt64Builder>>>
       oe_offsets_lists_expanded(vertex_label_num_);
-
-  // edge_label_num_ is previous edge_label_num
-  // below code is to generate ie_offset_lists_expanded and
-  // oe_offset_lists_expanded
   for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
     if (directed_) {
       ie_offsets_lists_expanded[v_label].resize(edge_label_num_);
     }
     oe_offsets_lists_expanded[v_label].resize(edge_label_num_);
-  }
-  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    if (tvnums[v_label] == tvnums_[v_label]) {
+      continue;
+    }
     for (label_id_t e_label = 0; e_label < edge_label_num_; ++e_label) {
       vid_t prev_offset_size = tvnums_[v_label] + 1;
       vid_t current_offset_size = tvnums[v_label] + 1;
@@ -976,147 +983,39 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::AddEdgesToExistedLabel(
       << "] Add new edges to existed label: after generate_local_id_list: "
       << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
 
-  // Regenerate CSR vector of the existed label
-  std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>> ie_list(
-      vertex_label_num_);
-  std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>> oe_list(
-      vertex_label_num_);
-  std::vector<std::shared_ptr<FixedInt64Builder>> ie_offsets_list(
-      vertex_label_num_);
-  std::vector<std::shared_ptr<FixedInt64Builder>> oe_offsets_list(
-      vertex_label_num_);
-
-  // get previous src_id, dst_id.
-  std::vector<vid_t> prev_src_ids, prev_dst_ids;
-  // we get sorted lids, we need to recover the original order
-  // one way is to rearrange table, the other is rearragne lids
-  // we choose rearrange lids
-  std::vector<eid_t> eids;
-  std::shared_ptr<vid_array_t> prev_src_id_list, prev_dst_id_list;
-  std::unordered_map<std::string, int> vis;
-  for (label_id_t v_label = 0; v_label < vertex_label_num_; v_label++) {
-    // get the entry of specific label
-    auto iv = this->InnerVertices(v_label);
-    for (auto v : iv) {
-      auto offset = vertex_offset(v);
-      vid_t src_id = vid_parser_.GenerateId(v_label, offset);
-      auto oe = this->GetOutgoingAdjList(v, label_id);
-      for (auto& e : oe) {
-        auto dst_label = vertex_label(e.neighbor());
-        auto dst_offset = vertex_offset(e.neighbor());
-        vid_t dst_id = vid_parser_.GenerateId(dst_label, dst_offset);
-        std::string key1 =
-            std::to_string(src_id) + "_" + std::to_string(dst_id);
-        std::string key2 =
-            std::to_string(dst_id) + "_" + std::to_string(src_id);
-        if (!directed_) {
-          if (vis.count(key1) || vis.count(key2)) {
-            continue;
-          }
-
-          vis[key1] = 1;
-          vis[key2] = 1;
-          eids.push_back(e.edge_id());
-          prev_src_ids.push_back(src_id);
-          prev_dst_ids.push_back(dst_id);
-        } else {
-          if (vis.count(key1)) {
-            continue;
-          }
-          vis[key1] = 1;
-          eids.push_back(e.edge_id());
-          prev_src_ids.push_back(src_id);
-          prev_dst_ids.push_back(dst_id);
-        }
-      }
-      if (directed_) {
-        auto ie = this->GetIncomingAdjList(v, label_id);
-        for (auto& e : ie) {
-          auto dst_label = vertex_label(e.neighbor());
-          auto dst_offset = vertex_offset(e.neighbor());
-          vid_t dst_id = vid_parser_.GenerateId(dst_label, dst_offset);
-          std::string key =
-              std::to_string(dst_id) + "_" + std::to_string(src_id);
-          if (vis.count(key)) {
-            continue;
-          }
-          vis[key] = 1;
-          eids.push_back(e.edge_id());
-          prev_src_ids.push_back(dst_id);
-          prev_dst_ids.push_back(src_id);
-        }
-      }
-    }
-  }
-
-  std::vector<vid_t> sorted_src_ids(prev_src_ids.size());
-  std::vector<vid_t> sorted_dst_ids(prev_dst_ids.size());
-
-  for (size_t i = 0; i < eids.size(); ++i) {
-    sorted_src_ids[eids[i]] = prev_src_ids[i];
-    sorted_dst_ids[eids[i]] = prev_dst_ids[i];
-  }
-  prev_src_ids.clear();
-  prev_dst_ids.clear();
+  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
+  builder.set_edge_label_num_(edge_label_num_);
 
-  auto gen_prev_fn =
-      [](const std::vector<VID_T>& vids, arrow::MemoryPool* pool,
-         std::shared_ptr<vid_array_t>& lid_list) -> boost::leaf::result<void> {
-    ArrowBuilderType<VID_T> builder(pool);
-    ARROW_OK_OR_RAISE(builder.AppendValues(vids.data(), vids.size()));
-    ARROW_OK_OR_RAISE(builder.Finish(&lid_list));
-    return {};
-  };
-  gen_prev_fn(sorted_src_ids, pool, prev_src_id_list);
-  sorted_src_ids.clear();
-  gen_prev_fn(sorted_dst_ids, pool, prev_dst_id_list);
-  sorted_dst_ids.clear();
-  // check duplicates
-  auto src_id_array = edge_src[0];
-  auto dst_id_array = edge_dst[0];
-  edge_src.push_back(prev_src_id_list);
-  edge_dst.push_back(prev_dst_id_list);
+  // the new edges go to the delta CSR, and get the edge ids following the
+  // existing edges, until the delta CSR grows beyond a quarter of the base
+  // CSR, when the delta edges and the new edges are compacted into the base
+  const int64_t base_num = edge_tables_[label_id]->num_rows();
+  const int64_t delta_num = edge_data_num(label_id) - base_num;
+  const bool compaction = (delta_num + edge_table->num_rows()) * 4 > base_num;
 
   bool is_multigraph = is_multigraph_;
-  if (directed_) {
-    generate_directed_csr<vid_t, eid_t>(
-        client, vid_parser_, std::move(edge_src), std::move(edge_dst), tvnums,
-        vertex_label_num_, concurrency, oe_list, oe_offsets_list,
-        is_multigraph_);
-    generate_directed_csc<vid_t, eid_t>(
-        client, vid_parser_, tvnums, vertex_label_num_, concurrency, oe_list,
-        oe_offsets_list, ie_list, ie_offsets_list, is_multigraph_);
+  if (compaction) {
+    BOOST_LEAF_CHECK(compactDeltaEdges(client, label_id, edge_src, edge_dst,
+                                       std::move(edge_table), tvnums,
+                                       concurrency, builder, is_multigraph));
+    BOOST_LEAF_CHECK(dropDeltaEdges(client, label_id, builder));
   } else {
-    generate_undirected_csr_memopt<vid_t, eid_t>(
-        client, vid_parser_, std::move(edge_src), std::move(edge_dst), tvnums,
-        vertex_label_num_, concurrency, oe_list, oe_offsets_list,
-        is_multigraph_);
+    BOOST_LEAF_CHECK(appendDeltaEdges(client, label_id, edge_src, edge_dst,
+                                      std::move(edge_table), tvnums,
+                                      concurrency, builder, is_multigraph));
   }
+  edge_src.clear();
+  edge_dst.clear();
 
-  LOG_IF(WARNING, is_multigraph == false && is_multigraph_ == true)
+  LOG_IF(WARNING, is_multigraph == true && is_multigraph_ == false)
       << "There maybe duplicated edges in your data, and we change the graph "
          "type to multigraph";
-
-  if (this->compact_edges_) {
-    RETURN_GS_ERROR(
-        ErrorCode::kUnimplementedMethod,
-        "Varint encoding is not implemented for adding vertices/edges");
-  }
+  builder.set_is_multigraph_(is_multigraph);
 
   VLOG(100) << "[frag-" << this->fid_
             << "] Add new edges to existed label: after generate CSR: "
             << get_rss_pretty() << ", peak: " << get_peak_rss_pretty();
 
-  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
-  builder.set_edge_label_num_(edge_label_num_);
-  std::vector<std::shared_ptr<arrow::Table>> edge_tables;
-  edge_tables.push_back(std::move(edge_table));      // current one
-  edge_tables.push_back(edge_data_table(label_id));  // previous one
-
-  builder.set_edge_tables_(label_id, std::make_shared<TableBuilder>(
-                                         client, std::move(edge_tables), true));
-  edge_tables.clear();
-
   ThreadGroup tg;
   {
     auto fn = [&builder, &ovnums, &tvnums](Client* client) -> Status {
@@ -1157,48 +1056,22 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::AddEdgesToExistedLabel(
     };
     tg.AddTask(fn, &client);
   }
-  // for the newly added edges to existed edge label,
-  // we need to update the ie_lists_, oe_lists_, ie_offsets_lists_,
-  // oe_offsets_lists_
-  if (directed_) {
-    builder.ie_lists_.resize(vertex_label_num_);
-    builder.ie_offsets_lists_.resize(vertex_label_num_);
-  }
-  builder.oe_lists_.resize(vertex_label_num_);
-  builder.oe_offsets_lists_.resize(vertex_label_num_);
+  tg.TakeResults();
 
+  // the offsets of the compacted label have been set above
   for (label_id_t i = 0; i < vertex_label_num_; ++i) {
-    if (directed_) {
-      builder.ie_lists_[i].resize(edge_label_num_);
-      builder.ie_offsets_lists_[i].resize(edge_label_num_);
-    }
-    builder.oe_lists_[i].resize(edge_label_num_);
-    builder.oe_offsets_lists_[i].resize(edge_label_num_);
     for (label_id_t j = 0; j < edge_label_num_; ++j) {
-      auto fn = [this, &builder, &label_id, &ie_list, &oe_list,
-                 &ie_offsets_list, &oe_offsets_list, &ie_offsets_lists_expanded,
-                 &oe_offsets_lists_expanded](Client* client, const label_id_t i,
-                                             const label_id_t j) -> Status {
-        if (j == label_id) {
-          if (directed_) {
-            builder.set_ie_lists_(i, j, ie_list[i]);
-            builder.set_ie_offsets_lists_(i, j, ie_offsets_list[i]);
-          }
-          builder.set_oe_lists_(i, j, oe_list[i]);
-          builder.set_oe_offsets_lists_(i, j, oe_offsets_list[i]);
-        } else {
-          if (directed_) {
-            builder.set_ie_offsets_lists_(i, j,
-                                          ie_offsets_lists_expanded[i][j]);
-          }
-          builder.set_oe_offsets_lists_(i, j, oe_offsets_lists_expanded[i][j]);
-        }
-        return Status::OK();
-      };
-      tg.AddTask(fn, &client, i, j);
+      if (compaction && j == label_id) {
+        continue;
+      }
+      if (directed_ && ie_offsets_lists_expanded[i][j] != nullptr) {
+        builder.set_ie_offsets_lists_(i, j, ie_offsets_lists_expanded[i][j]);
+      }
+      if (oe_offsets_lists_expanded[i][j] != nullptr) {
+        builder.set_oe_offsets_lists_(i, j, oe_offsets_lists_expanded[i][j]);
+      }
     }
   }
-  tg.TakeResults();
 
   VLOG(100)
       << "[frag-" << this->fid_
@@ -1209,6 +1082,345 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::AddEdgesToExistedLabel(
   return fragment_object->id();
 }
 
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::CompactEdges(
+    Client& client, const int concurrency) {
+  if (!has_delta_edges()) {
+    return this->id();
+  }
+  ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
+  std::vector<vid_t> tvnums(tvnums_.begin(), tvnums_.end());
+  bool is_multigraph = is_multigraph_;
+  for (label_id_t e_label = 0; e_label < edge_label_num_; ++e_label) {
+    if (edge_data_num(e_label) == edge_tables_[e_label]->num_rows()) {
+      continue;
+    }
+    BOOST_LEAF_CHECK(compactDeltaEdges(client, e_label, {}, {}, nullptr,
+                                       tvnums, concurrency, builder,
+                                       is_multigraph));
+  }
+  builder.set_is_multigraph_(is_multigraph);
+  builder.ie_delta_lists_.clear();
+  builder.oe_delta_lists_.clear();
+  builder.ie_delta_offsets_lists_.clear();
+  builder.oe_delta_offsets_lists_.clear();
+  builder.edge_delta_tables_.clear();
+
+  std::shared_ptr<Object> fragment_object;
+  VY_OK_OR_RAISE(builder.Seal(client, fragment_object));
+  return fragment_object->id();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+std::future<ObjectID>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::CompactEdgesAsync(
+    Client& client, const int concurrency) {
+  // keeps the fragment alive until the compaction finishes
+  auto self = std::dynamic_pointer_cast<ArrowFragment>(shared_from_this());
+  return std::async(std::launch::async, [self, &client, concurrency]() {
+    return boost::leaf::try_handle_all(
+        [&]() { return self->CompactEdges(client, concurrency); },
+        [](const GSError& e) {
+          LOG(ERROR) << e.error_msg;
+          return InvalidObjectID();
+        },
+        [](const boost::leaf::error_info& unmatched) {
+          LOG(ERROR) << "Unmatched error " << unmatched;
+          return InvalidObjectID();
+        });
+  });
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<
+    std::shared_ptr<ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>>>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::compactedFragment(
+    Client& client, const int concurrency) {
+  BOOST_LEAF_AUTO(frag_id, CompactEdges(client, concurrency));
+  return std::dynamic_pointer_cast<ArrowFragment>(client.GetObject(frag_id));
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::collectDeltaEdges(
+    const label_id_t e_label, std::vector<std::shared_ptr<vid_array_t>>& srcs,
+    std::vector<std::shared_ptr<vid_array_t>>& dsts) const {
+  const eid_t eid_base = delta_eid_bases_[e_label];
+  const int64_t num = edge_data_num(e_label) - eid_base;
+  if (num == 0) {
+    return {};
+  }
+  // every edge is in the list of its source, and, when undirected, in the
+  // list of its destination as well, where either direction will do
+  std::vector<vid_t> src_list(num), dst_list(num);
+  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    const int64_t* offsets = oe_delta_offsets_ptr_lists_[v_label][e_label];
+    const nbr_unit_t* edges = oe_delta_ptr_lists_[v_label][e_label];
+    for (int64_t v = 0; v < oe_delta_vnums_[v_label][e_label]; ++v) {
+      vid_t src = vid_parser_.GenerateId(0, v_label, v);
+      for (int64_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+        src_list[edges[k].eid - eid_base] = src;
+        dst_list[edges[k].eid - eid_base] = edges[k].vid;
+      }
+    }
+  }
+  std::shared_ptr<vid_array_t> src_array, dst_array;
+  vid_builder_t src_builder, dst_builder;
+  ARROW_OK_OR_RAISE(src_builder.AppendValues(src_list));
+  ARROW_OK_OR_RAISE(src_builder.Finish(&src_array));
+  ARROW_OK_OR_RAISE(dst_builder.AppendValues(dst_list));
+  ARROW_OK_OR_RAISE(dst_builder.Finish(&dst_array));
+  srcs.push_back(src_array);
+  dsts.push_back(dst_array);
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::compactDeltaEdges(
+    Client& client, const label_id_t e_label,
+    const std::vector<std::shared_ptr<vid_array_t>>& edge_src,
+    const std::vector<std::shared_ptr<vid_array_t>>& edge_dst,
+    std::shared_ptr<arrow::Table>&& edge_table,
+    const std::vector<vid_t>& tvnums, const int concurrency,
+    ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>& builder,
+    bool& is_multigraph) {
+  // the delta edges, followed by the new edges
+  std::vector<std::shared_ptr<vid_array_t>> srcs, dsts;
+  BOOST_LEAF_CHECK(collectDeltaEdges(e_label, srcs, dsts));
+  srcs.insert(srcs.end(), edge_src.begin(), edge_src.end());
+  dsts.insert(dsts.end(), edge_dst.begin(), edge_dst.end());
+
+  std::vector<const nbr_unit_t*> base_ie(vertex_label_num_),
+      base_oe(vertex_label_num_);
+  std::vector<const int64_t*> base_ie_offsets(vertex_label_num_),
+      base_oe_offsets(vertex_label_num_);
+  std::vector<vid_t> base_tvnums(vertex_label_num_);
+  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    if (directed_) {
+      base_ie[v_label] = ie_ptr_lists_[v_label][e_label];
+      base_ie_offsets[v_label] = ie_offsets_ptr_lists_[v_label][e_label];
+    }
+    base_oe[v_label] = oe_ptr_lists_[v_label][e_label];
+    base_oe_offsets[v_label] = oe_offsets_ptr_lists_[v_label][e_label];
+    base_tvnums[v_label] = tvnums_[v_label];
+  }
+  const eid_t eid_base = edge_tables_[e_label]->num_rows();
+
+  std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>> ie_list(
+      vertex_label_num_);
+  std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>> oe_list(
+      vertex_label_num_);
+  std::vector<std::shared_ptr<FixedInt64Builder>> ie_offsets_list(
+      vertex_label_num_);
+  std::vector<std::shared_ptr<FixedInt64Builder>> oe_offsets_list(
+      vertex_label_num_);
+  BOOST_LEAF_CHECK(append_edges_to_csr<vid_t, eid_t>(
+      client, vid_parser_, srcs, dsts, eid_base, !directed_, base_oe,
+      base_oe_offsets, base_tvnums, tvnums, vertex_label_num_, concurrency,
+      oe_list, oe_offsets_list, is_multigraph));
+  if (directed_) {
+    BOOST_LEAF_CHECK(append_edges_to_csr<vid_t, eid_t>(
+        client, vid_parser_, dsts, srcs, eid_base, false, base_ie,
+        base_ie_offsets, base_tvnums, tvnums, vertex_label_num_, concurrency,
+        ie_list, ie_offsets_list, is_multigraph));
+  }
+  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    if (directed_) {
+      builder.set_ie_lists_(v_label, e_label, ie_list[v_label]);
+      builder.set_ie_offsets_lists_(v_label, e_label, ie_offsets_list[v_label]);
+    }
+    builder.set_oe_lists_(v_label, e_label, oe_list[v_label]);
+    builder.set_oe_offsets_lists_(v_label, e_label, oe_offsets_list[v_label]);
+  }
+
+  // the edge ids follow the order of rows
+  std::vector<std::shared_ptr<arrow::Table>> edge_tables;
+  edge_tables.push_back(edge_data_table(e_label));
+  if (static_cast<size_t>(e_label) < edge_delta_tables_.size() &&
+      edge_delta_tables_[e_label]->num_rows() > 0) {
+    edge_tables.push_back(edge_delta_tables_[e_label]->GetTable());
+  }
+  if (edge_table != nullptr) {
+    edge_tables.push_back(std::move(edge_table));
+  }
+  builder.set_edge_tables_(
+      e_label, std::make_shared<TableBuilder>(client, std::move(edge_tables),
+                                              true /* merge chunks */));
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::appendDeltaEdges(
+    Client& client, const label_id_t e_label,
+    const std::vector<std::shared_ptr<vid_array_t>>& edge_src,
+    const std::vector<std::shared_ptr<vid_array_t>>& edge_dst,
+    std::shared_ptr<arrow::Table>&& edge_table,
+    const std::vector<vid_t>& tvnums, const int concurrency,
+    ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>& builder,
+    bool& is_multigraph) {
+  BOOST_LEAF_CHECK(initDeltaEdges(client, builder));
+
+  // merges the new edges into the delta CSR, which starts empty
+  const int64_t empty_offsets = 0;
+  std::vector<const nbr_unit_t*> delta_ie(vertex_label_num_, nullptr),
+      delta_oe(vertex_label_num_, nullptr);
+  std::vector<const int64_t*> delta_ie_offsets(vertex_label_num_,
+                                               &empty_offsets),
+      delta_oe_offsets(vertex_label_num_, &empty_offsets);
+  std::vector<vid_t> delta_tvnums(vertex_label_num_, 0);
+  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    if (oe_delta_vnums_[v_label][e_label] == 0) {
+      continue;
+    }
+    if (directed_) {
+      delta_ie[v_label] = ie_delta_ptr_lists_[v_label][e_label];
+      delta_ie_offsets[v_label] = ie_delta_offsets_ptr_lists_[v_label][e_label];
+    }
+    delta_oe[v_label] = oe_delta_ptr_lists_[v_label][e_label];
+    delta_oe_offsets[v_label] = oe_delta_offsets_ptr_lists_[v_label][e_label];
+    delta_tvnums[v_label] = oe_delta_vnums_[v_label][e_label];
+  }
+  const eid_t eid_base = edge_data_num(e_label);
+
+  std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>> ie_list(
+      vertex_label_num_);
+  std::vector<std::shared_ptr<PodArrayBuilder<nbr_unit_t>>> oe_list(
+      vertex_label_num_);
+  std::vector<std::shared_ptr<FixedInt64Builder>> ie_offsets_list(
+      vertex_label_num_);
+  std::vector<std::shared_ptr<FixedInt64Builder>> oe_offsets_list(
+      vertex_label_num_);
+  BOOST_LEAF_CHECK(append_edges_to_csr<vid_t, eid_t>(
+      client, vid_parser_, edge_src, edge_dst, eid_base, !directed_, delta_oe,
+      delta_oe_offsets, delta_tvnums, tvnums, vertex_label_num_, concurrency,
+      oe_list, oe_offsets_list, is_multigraph));
+  if (directed_) {
+    BOOST_LEAF_CHECK(append_edges_to_csr<vid_t, eid_t>(
+        client, vid_parser_, edge_dst, edge_src, eid_base, false, delta_ie,
+        delta_ie_offsets, delta_tvnums, tvnums, vertex_label_num_, concurrency,
+        ie_list, ie_offsets_list, is_multigraph));
+  }
+
+  // the base lists and the delta lists are sorted respectively, an edge may
+  // duplicate an edge of the base CSR as well
+  if (!is_multigraph) {
+    for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+      const int64_t* base_offsets = oe_offsets_ptr_lists_[v_label][e_label];
+      const nbr_unit_t* base = oe_ptr_lists_[v_label][e_label];
+      const int64_t* offsets = oe_offsets_list[v_label]->data();
+      const nbr_unit_t* delta = oe_list[v_label]->data();
+      auto comparator = [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+        return lhs.vid < rhs.vid;
+      };
+      parallel_for(
+          static_cast<vid_t>(0), tvnums_[v_label],
+          [&](const vid_t v) {
+            for (int64_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+              if (std::binary_search(base + base_offsets[v],
+                                     base + base_offsets[v + 1], delta[k],
+                                     comparator)) {
+                __sync_or_and_fetch(
+                    reinterpret_cast<unsigned char*>(&is_multigraph), 1);
+                return;
+              }
+            }
+          },
+          concurrency, 1024);
+    }
+  }
+
+  for (label_id_t v_label = 0; v_label < vertex_label_num_; ++v_label) {
+    if (directed_) {
+      builder.set_ie_delta_lists_(v_label, e_label, ie_list[v_label]);
+      builder.set_ie_delta_offsets_lists_(v_label, e_label,
+                                          ie_offsets_list[v_label]);
+    }
+    builder.set_oe_delta_lists_(v_label, e_label, oe_list[v_label]);
+    builder.set_oe_delta_offsets_lists_(v_label, e_label,
+                                        oe_offsets_list[v_label]);
+  }
+
+  std::vector<std::shared_ptr<arrow::Table>> edge_tables;
+  if (static_cast<size_t>(e_label) < edge_delta_tables_.size() &&
+      edge_delta_tables_[e_label]->num_rows() > 0) {
+    edge_tables.push_back(edge_delta_tables_[e_label]->GetTable());
+  }
+  edge_tables.push_back(std::move(edge_table));
+  builder.set_edge_delta_tables_(
+      e_label, std::make_shared<TableBuilder>(client, std::move(edge_tables),
+                                              true /* merge chunks */));
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initDeltaEdges(
+    Client& client,
+    ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>& builder,
+    const label_id_t reset_label) {
+  // the labels without delta edges share the empty placeholders
+  std::shared_ptr<Object> empty_list, empty_offsets, empty_table;
+  {
+    PodArrayBuilder<nbr_unit_t> list_builder(client, 0);
+    VY_OK_OR_RAISE(list_builder.Seal(client, empty_list));
+    FixedInt64Builder offsets_builder(client, 0);
+    VY_OK_OR_RAISE(offsets_builder.Seal(client, empty_offsets));
+    std::shared_ptr<arrow::Table> table;
+    VY_OK_OR_RAISE(EmptyTableBuilder::Build(EmptyTableBuilder::EmptySchema(),
+                                            table));
+    TableBuilder table_builder(client, table);
+    VY_OK_OR_RAISE(table_builder.Seal(client, empty_table));
+  }
+  auto fill = [this, reset_label](
+                  std::vector<std::vector<std::shared_ptr<ObjectBase>>>& lists,
+                  const std::shared_ptr<Object>& placeholder) {
+    lists.resize(vertex_label_num_);
+    for (auto& list : lists) {
+      list.resize(edge_label_num_, placeholder);
+      if (reset_label >= 0) {
+        list[reset_label] = placeholder;
+      }
+    }
+  };
+  if (directed_) {
+    fill(builder.ie_delta_lists_, empty_list);
+    fill(builder.ie_delta_offsets_lists_, empty_offsets);
+  }
+  fill(builder.oe_delta_lists_, empty_list);
+  fill(builder.oe_delta_offsets_lists_, empty_offsets);
+  builder.edge_delta_tables_.resize(edge_label_num_, empty_table);
+  if (reset_label >= 0) {
+    builder.edge_delta_tables_[reset_label] = empty_table;
+  }
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::dropDeltaEdges(
+    Client& client, const label_id_t e_label,
+    ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>& builder) {
+  bool others = false;
+  for (label_id_t i = 0; i < edge_label_num_; ++i) {
+    if (i != e_label && edge_data_num(i) != edge_tables_[i]->num_rows()) {
+      others = true;
+    }
+  }
+  if (!others) {
+    // back to a fragment without the delta CSR
+    builder.ie_delta_lists_.clear();
+    builder.oe_delta_lists_.clear();
+    builder.ie_delta_offsets_lists_.clear();
+    builder.oe_delta_offsets_lists_.clear();
+    builder.edge_delta_tables_.clear();
+    return {};
+  }
+  return initDeltaEdges(client, builder, e_label);
+}
+
 /// Add a set of new edge labels to graph. Edge label id started from
 /// edge_label_num_.
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
@@ -1712,6 +1924,10 @@ BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::Init(
 
   vid_parser_.Init(this->fnum_, this->vertex_label_num_);
 
+  if (reorder_vertices_) {
+    BOOST_LEAF_CHECK(reorderVertices(vertex_tables, edge_tables, concurrency));
+  }
+
   VLOG(100) << "[frag-" << this->fid_
             << "] Init: start init vertices: " << get_rss_pretty()
             << ", peak: " << get_peak_rss_pretty();
@@ -1726,6 +1942,147 @@ BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::Init(
   return {};
 }
 
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::
+    reorderVertices(std::vector<std::shared_ptr<arrow::Table>>& vertex_tables,
+                    std::vector<std::shared_ptr<arrow::Table>>& edge_tables,
+                    int concurrency) {
+  if (this->local_vertex_map_) {
+    LOG(WARNING) << "[frag-" << this->fid_
+                 << "] Reordering vertices requires the global vertex map, "
+                    "skipped";
+    return {};
+  }
+  if (this->fnum_ > 1 && comm_spec_ == nullptr) {
+    // the gids of inner vertices are referred by other fragments as well
+    LOG(WARNING) << "[frag-" << this->fid_
+                 << "] Reordering vertices of multiple fragments requires the "
+                    "comm spec, skipped";
+    return {};
+  }
+  auto reorder_start_time = vineyard::GetCurrentTime();
+
+  std::vector<vid_t> ivnums(this->vertex_label_num_);
+  for (label_id_t i = 0; i < this->vertex_label_num_; ++i) {
+    ivnums[i] = vm_ptr_->GetInnerVertexSize(this->fid_, i);
+  }
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> srcs(this->edge_label_num_),
+      dsts(this->edge_label_num_);
+  for (label_id_t label = 0; label < this->edge_label_num_; ++label) {
+    srcs[label] = edge_tables[label]->column(0);
+    dsts[label] = edge_tables[label]->column(1);
+  }
+
+  // every fragment knows all edges of its inner vertices, thus the degrees
+  std::vector<std::shared_ptr<arrow::Int64Array>> orders;
+  std::vector<std::vector<vid_t>> inverse_orders;
+  generate_degree_order<vid_t>(vid_parser_, this->fid_,
+                               this->vertex_label_num_, ivnums, srcs, dsts,
+                               concurrency, orders, inverse_orders);
+
+  // the permutations of all fragments, indexed by [fid][label]
+  std::vector<std::vector<std::vector<vid_t>>> all_inverse_orders(
+      this->fnum_);
+  if (this->fnum_ == 1) {
+    all_inverse_orders[this->fid_] = std::move(inverse_orders);
+  } else {
+    std::vector<std::vector<std::vector<vid_t>>> gathered_inverse_orders;
+    GlobalAllGatherv(inverse_orders, gathered_inverse_orders, *comm_spec_);
+    inverse_orders.clear();
+    for (int worker_id = 0; worker_id < comm_spec_->worker_num();
+         ++worker_id) {
+      all_inverse_orders[comm_spec_->WorkerToFrag(worker_id)] =
+          std::move(gathered_inverse_orders[worker_id]);
+    }
+  }
+
+  for (label_id_t label = 0; label < this->edge_label_num_; ++label) {
+    auto& table = edge_tables[label];
+    BOOST_LEAF_CHECK(reorder_inner_vertex_ids<vid_t>(
+        vid_parser_, all_inverse_orders, concurrency, srcs[label]));
+    BOOST_LEAF_CHECK(reorder_inner_vertex_ids<vid_t>(
+        vid_parser_, all_inverse_orders, concurrency, dsts[label]));
+    ARROW_OK_ASSIGN_OR_RAISE(
+        table, table->SetColumn(0, table->field(0), std::move(srcs[label])));
+    ARROW_OK_ASSIGN_OR_RAISE(
+        table, table->SetColumn(1, table->field(1), std::move(dsts[label])));
+  }
+
+  for (label_id_t label = 0; label < this->vertex_label_num_; ++label) {
+    std::shared_ptr<arrow::Table> table;
+    VY_OK_OR_RAISE(GeneralTake(vertex_tables[label], orders[label], table));
+    vertex_tables[label] = table;
+  }
+  BOOST_LEAF_CHECK(
+      reorderVertexMap(all_inverse_orders, concurrency,
+                       typename is_local_vertex_map<vertex_map_t>::type{}));
+
+  VLOG(100) << "[frag-" << this->fid_ << "] Reorder vertices time usage: "
+            << (vineyard::GetCurrentTime() - reorder_start_time)
+            << " seconds, " << get_rss_pretty()
+            << ", peak: " << get_peak_rss_pretty();
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::
+    reorderVertexMap(
+        const std::vector<std::vector<std::vector<vid_t>>>& inverse_orders,
+        int concurrency, std::false_type) {
+  using oid_array_t = ArrowArrayType<internal_oid_t>;
+  std::vector<std::vector<std::shared_ptr<oid_array_t>>> oid_arrays(
+      this->vertex_label_num_);
+  for (label_id_t label = 0; label < this->vertex_label_num_; ++label) {
+    oid_arrays[label].resize(this->fnum_);
+    for (fid_t fid = 0; fid < this->fnum_; ++fid) {
+      std::shared_ptr<arrow::Array> oid_array =
+          vm_ptr_->GetOidArray(fid, label);
+      if (!inverse_orders[fid].empty()) {
+        auto const& inverse_order = inverse_orders[fid][label];
+        const int64_t ivnum = inverse_order.size();
+        std::vector<int64_t> order(ivnum);
+        parallel_for(
+            static_cast<int64_t>(0), ivnum,
+            [&order, &inverse_order](int64_t offset) {
+              order[inverse_order[offset]] = offset;
+            },
+            concurrency);
+        arrow::Int64Builder order_builder;
+        std::shared_ptr<arrow::Array> order_array;
+        ARROW_OK_OR_RAISE(order_builder.AppendValues(order));
+        ARROW_OK_OR_RAISE(order_builder.Finish(&order_array));
+        VY_OK_OR_RAISE(GeneralTake(oid_array, order_array, oid_array));
+      }
+      oid_arrays[label][fid] =
+          std::dynamic_pointer_cast<oid_array_t>(oid_array);
+    }
+  }
+  BasicArrowVertexMapBuilder<internal_oid_t, vid_t> vm_builder(
+      client_, this->fnum_, this->vertex_label_num_, std::move(oid_arrays),
+      vm_ptr_->use_perfect_hash());
+  vm_builder.set_compress_oids(vm_ptr_->compress_oids());
+  std::shared_ptr<Object> vm_object;
+  VY_OK_OR_RAISE(vm_builder.Seal(client_, vm_object));
+
+  // the permuted vertex map replaces the given one, which maps the oids to
+  // the gids before reordering and must not be used any more, but is left to
+  // the caller to release
+  vm_ptr_ = std::dynamic_pointer_cast<vertex_map_t>(vm_object);
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+boost::leaf::result<void>
+BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::
+    reorderVertexMap(
+        const std::vector<std::vector<std::vector<vid_t>>>& inverse_orders,
+        int concurrency, std::true_type) {
+  RETURN_GS_ERROR(ErrorCode::kUnsupportedOperationError,
+                  "Reordering vertices with local vertex map is not supported");
+}
+
 // | prop_0 | prop_1 | ... |
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
 boost::leaf::result<void>
@@ -1865,7 +2222,9 @@ BasicArrowFragmentBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initEdges(
         client_, this->directed_, this->vertex_label_num_,
         this->edge_label_num_, ie_lists_, oe_lists_, compact_ie_lists_,
         compact_oe_lists_, ie_offsets_lists_, oe_offsets_lists_,
-        ie_boffsets_lists_, oe_boffsets_lists_, concurrency));
+        ie_boffsets_lists_, oe_boffsets_lists_,
+        static_cast<CompactEdgesCodec>(this->compact_edges_codec_),
+        concurrency));
   }
   return {};
 }
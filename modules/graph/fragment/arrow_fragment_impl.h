@@ -189,6 +189,12 @@ ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::AddEdgeColumnsImpl(
         std::vector<std::pair<std::string, std::shared_ptr<ArrayType>>>>
         columns,
     bool replace) {
+  if (has_delta_edges()) {
+    // the columns are aligned with the base edge tables
+    BOOST_LEAF_AUTO(frag, compactedFragment(client));
+    return frag->template AddEdgeColumnsImpl<ArrayType>(client, columns,
+                                                        replace);
+  }
   vineyard::ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT>
       builder(*this);
   auto schema = schema_;
@@ -337,6 +343,10 @@ template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
 boost::leaf::result<vineyard::ObjectID>
 ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::TransformDirection(
     vineyard::Client& client, int concurrency) {
+  if (has_delta_edges()) {
+    BOOST_LEAF_AUTO(frag, compactedFragment(client, concurrency));
+    return frag->TransformDirection(client, concurrency);
+  }
   ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
   builder.set_directed_(!directed_);
 
@@ -449,6 +459,11 @@ boost::leaf::result<vineyard::ObjectID>
 ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::ConsolidateEdgeColumns(
     vineyard::Client& client, const label_id_t elabel,
     std::vector<prop_id_t> const& props, std::string const& consolidate_name) {
+  if (has_delta_edges()) {
+    BOOST_LEAF_AUTO(frag, compactedFragment(client));
+    return frag->ConsolidateEdgeColumns(client, elabel, props,
+                                        consolidate_name);
+  }
   ArrowFragmentBaseBuilder<OID_T, VID_T, VERTEX_MAP_T, COMPACT> builder(*this);
   auto schema = schema_;
 
@@ -609,6 +624,73 @@ void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initPointers() {
     }
     ie_offsets_ptr_lists_ = oe_offsets_ptr_lists_;
   }
+
+  initDeltaPointers();
+}
+
+template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
+void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initDeltaPointers() {
+  // the delta CSR may be shorter than the base CSR, as it is carried over
+  // when new vertices or labels are added
+  auto has_delta = [this](const size_t e_label) {
+    return e_label < edge_delta_tables_.size() &&
+           edge_delta_tables_[e_label]->num_rows() > 0;
+  };
+
+  delta_eid_bases_.resize(edge_label_num_);
+  edge_delta_tables_columns_.resize(edge_label_num_);
+  flatten_edge_delta_tables_columns_.assign(edge_label_num_, nullptr);
+  for (label_id_t i = 0; i < edge_label_num_; ++i) {
+    delta_eid_bases_[i] = edge_tables_[i]->num_rows();
+    if (!has_delta(i)) {
+      continue;
+    }
+    prop_id_t prop_num =
+        static_cast<prop_id_t>(edge_delta_tables_[i]->num_columns());
+    edge_delta_tables_columns_[i].resize(prop_num);
+    for (prop_id_t j = 0; j < prop_num; ++j) {
+      edge_delta_tables_columns_[i][j] =
+          get_arrow_array_data(edge_delta_tables_[i]->column(j)->chunk(0));
+    }
+    flatten_edge_delta_tables_columns_[i] =
+        edge_delta_tables_columns_[i].data();
+  }
+
+  auto init = [this, &has_delta](
+                  const List<List<std::shared_ptr<FixedSizeBinaryArray>>>&
+                      lists,
+                  const List<List<std::shared_ptr<Int64Array>>>& offsets_lists,
+                  std::vector<std::vector<const nbr_unit_t*>>& ptr_lists,
+                  std::vector<std::vector<const int64_t*>>& offsets_ptr_lists,
+                  std::vector<std::vector<int64_t>>& vnums) {
+    ptr_lists.assign(vertex_label_num_, std::vector<const nbr_unit_t*>(
+                                            edge_label_num_, nullptr));
+    offsets_ptr_lists.assign(vertex_label_num_, std::vector<const int64_t*>(
+                                                    edge_label_num_, nullptr));
+    vnums.assign(vertex_label_num_, std::vector<int64_t>(edge_label_num_, 0));
+    for (size_t i = 0; i < offsets_lists.size(); ++i) {
+      for (size_t j = 0; j < offsets_lists[i].size(); ++j) {
+        if (!has_delta(j) || offsets_lists[i][j]->length() == 0) {
+          continue;
+        }
+        ptr_lists[i][j] = reinterpret_cast<const nbr_unit_t*>(
+            lists[i][j]->GetArray()->raw_values());
+        offsets_ptr_lists[i][j] =
+            offsets_lists[i][j]->GetArray()->raw_values();
+        vnums[i][j] = offsets_lists[i][j]->length() - 1;
+      }
+    }
+  };
+  init(oe_delta_lists_, oe_delta_offsets_lists_, oe_delta_ptr_lists_,
+       oe_delta_offsets_ptr_lists_, oe_delta_vnums_);
+  if (directed_) {
+    init(ie_delta_lists_, ie_delta_offsets_lists_, ie_delta_ptr_lists_,
+         ie_delta_offsets_ptr_lists_, ie_delta_vnums_);
+  } else {
+    ie_delta_ptr_lists_ = oe_delta_ptr_lists_;
+    ie_delta_offsets_ptr_lists_ = oe_delta_offsets_ptr_lists_;
+    ie_delta_vnums_ = oe_delta_vnums_;
+  }
 }
 
 template <typename OID_T, typename VID_T, typename VERTEX_MAP_T, bool COMPACT>
@@ -646,7 +728,7 @@ void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initDestFidList(
             vertex_t v = *(inner_vertices.begin() + offset);
 
             if (in_edge) {
-              auto es = GetIncomingAdjList(v, e_label_id);
+              auto es = GetIncomingAdjListWithDelta(v, e_label_id);
               fid_t last_fid = -1;
               for (auto& e : es) {
                 fid_t f = GetFragId(e.neighbor());
@@ -659,7 +741,7 @@ void ArrowFragment<OID_T, VID_T, VERTEX_MAP_T, COMPACT>::initDestFidList(
               }
             }
             if (out_edge) {
-              auto es = GetOutgoingAdjList(v, e_label_id);
+              auto es = GetOutgoingAdjListWithDelta(v, e_label_id);
               fid_t last_fid = -1;
               for (auto& e : es) {
                 fid_t f = GetFragId(e.neighbor());
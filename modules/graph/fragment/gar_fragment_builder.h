@@ -55,6 +55,8 @@ class GARFragmentBuilder
         client_(client),
         vm_ptr_(vm_ptr) {
     Base::set_compact_edges_(false);
+    Base::set_compact_edges_codec_(
+        static_cast<int>(CompactEdgesCodec::kVarint8));
     VINEYARD_ASSERT(
         !Base::compact_edges_,
         "Compacting edges is not supported when loading from GraphAr.");
@@ -30,6 +30,7 @@ limitations under the License.
 #include "basic/ds/arrow.h"
 #include "basic/ds/hashmap.h"
 #include "common/util/arrow.h"
+#include "graph/utils/stream_vbyte.h"
 
 // batching varint decoding for edge list
 #ifndef VARINT_ENCODING_BATCH_SIZE
@@ -38,6 +39,16 @@ limitations under the License.
 
 namespace vineyard {
 
+/**
+ * @brief The codecs of compact edges, recorded as `compact_edges_codec_` in
+ * the metadata of fragments. Fragments that are sealed without the field
+ * are encoded by `kVarint8`.
+ */
+enum class CompactEdgesCodec : int {
+  kVarint8 = 0,      // powturbo's v8, i.e., v8enc32/v8dec32
+  kStreamVByte = 1,  // see also `stream_vbyte_decode32`
+};
+
 template <typename Key, typename Value>
 using concurrent_map_t =
     libcuckoo::cuckoohash_map<Key, Value, prime_number_hash_wy<Key>>;
@@ -395,6 +406,152 @@ struct Nbr {
   const void** edata_arrays_;
 };
 
+/**
+ * @brief The neighbor iterator of `DeltaAdjList`.
+ *
+ * The adjacency list of a vertex may consist of two segments: the edges in
+ * the base CSR, followed by the edges appended to the delta CSR later (see
+ * `ArrowFragment::AddEdgesToExistedLabel`). The iterator steps from the end
+ * of the base segment to the beginning of the delta segment, whose edge
+ * properties live in a separate table, indexed by `eid - delta_eid_base`.
+ *
+ * The segment check is kept out of `Nbr`, which walks a single segment.
+ */
+template <typename VID_T, typename EID_T>
+struct DeltaNbr {
+ private:
+  using prop_id_t = property_graph_types::PROP_ID_TYPE;
+
+ public:
+  DeltaNbr()
+      : nbr_(NULL),
+        edata_arrays_(nullptr),
+        eid_base_(0),
+        in_delta_(false),
+        base_end_(NULL),
+        delta_begin_(NULL),
+        base_edata_arrays_(nullptr),
+        delta_edata_arrays_(nullptr),
+        delta_eid_base_(0) {}
+  DeltaNbr(const NbrUnit<VID_T, EID_T>* nbr, const bool in_delta,
+           const NbrUnit<VID_T, EID_T>* base_end,
+           const NbrUnit<VID_T, EID_T>* delta_begin,
+           const void** base_edata_arrays, const void** delta_edata_arrays,
+           EID_T delta_eid_base)
+      : nbr_(nbr),
+        edata_arrays_(in_delta ? delta_edata_arrays : base_edata_arrays),
+        eid_base_(in_delta ? delta_eid_base : 0),
+        in_delta_(in_delta),
+        base_end_(base_end),
+        delta_begin_(delta_begin),
+        base_edata_arrays_(base_edata_arrays),
+        delta_edata_arrays_(delta_edata_arrays),
+        delta_eid_base_(delta_eid_base) {}
+  DeltaNbr(const DeltaNbr& rhs) = default;
+  DeltaNbr(DeltaNbr&& rhs) = default;
+
+  DeltaNbr& operator=(const DeltaNbr& rhs) = default;
+  DeltaNbr& operator=(DeltaNbr&& rhs) = default;
+
+  grape::Vertex<VID_T> neighbor() const {
+    return grape::Vertex<VID_T>(nbr_->vid);
+  }
+
+  grape::Vertex<VID_T> get_neighbor() const {
+    return grape::Vertex<VID_T>(nbr_->vid);
+  }
+
+  EID_T edge_id() const { return nbr_->eid; }
+
+  // whether the neighbor is in the delta segment
+  bool is_delta() const { return in_delta_; }
+
+  template <typename T>
+  T get_data(prop_id_t prop_id) const {
+    return ValueGetter<T>::Value(edata_arrays_[prop_id],
+                                 nbr_->eid - eid_base_);
+  }
+
+  std::string get_str(prop_id_t prop_id) const {
+    return ValueGetter<std::string>::Value(edata_arrays_[prop_id],
+                                           nbr_->eid - eid_base_);
+  }
+
+  double get_double(prop_id_t prop_id) const {
+    return ValueGetter<double>::Value(edata_arrays_[prop_id],
+                                      nbr_->eid - eid_base_);
+  }
+
+  int64_t get_int(prop_id_t prop_id) const {
+    return ValueGetter<int64_t>::Value(edata_arrays_[prop_id],
+                                       nbr_->eid - eid_base_);
+  }
+
+  inline const DeltaNbr& operator++() const {
+    ++nbr_;
+    if (nbr_ == base_end_ && !in_delta_) {
+      // steps into the delta segment
+      nbr_ = delta_begin_;
+      edata_arrays_ = delta_edata_arrays_;
+      eid_base_ = delta_eid_base_;
+      in_delta_ = true;
+    }
+    return *this;
+  }
+
+  inline DeltaNbr operator++(int) const {
+    DeltaNbr ret(*this);
+    ++(*this);
+    return ret;
+  }
+
+  inline const DeltaNbr& operator--() const {
+    if (nbr_ == delta_begin_ && in_delta_) {
+      // steps back into the base segment
+      nbr_ = base_end_;
+      edata_arrays_ = base_edata_arrays_;
+      eid_base_ = 0;
+      in_delta_ = false;
+    }
+    --nbr_;
+    return *this;
+  }
+
+  inline DeltaNbr operator--(int) const {
+    DeltaNbr ret(*this);
+    --(*this);
+    return ret;
+  }
+
+  inline bool operator==(const DeltaNbr& rhs) const {
+    return nbr_ == rhs.nbr_ && in_delta_ == rhs.in_delta_;
+  }
+  inline bool operator!=(const DeltaNbr& rhs) const { return !(*this == rhs); }
+
+  // the base segment goes before the delta segment
+  inline bool operator<(const DeltaNbr& rhs) const {
+    if (in_delta_ != rhs.in_delta_) {
+      return rhs.in_delta_;
+    }
+    return nbr_ < rhs.nbr_;
+  }
+
+  inline const DeltaNbr& operator*() const { return *this; }
+
+ private:
+  const mutable NbrUnit<VID_T, EID_T>* nbr_;
+  mutable const void** edata_arrays_;
+  mutable EID_T eid_base_;
+  mutable bool in_delta_;
+
+  // the end of the base segment, and the delta segment that follows it
+  const NbrUnit<VID_T, EID_T>* base_end_;
+  const NbrUnit<VID_T, EID_T>* delta_begin_;
+  const void** base_edata_arrays_;
+  const void** delta_edata_arrays_;
+  EID_T delta_eid_base_;
+};
+
 template <typename VID_T, typename EID_T>
 struct CompactNbr {
  private:
@@ -410,6 +567,7 @@ struct CompactNbr {
         next_(rhs.next_),
         size_(rhs.size_),
         edata_arrays_(rhs.edata_arrays_),
+        codec_(rhs.codec_),
         data_(rhs.data_),
         current_(rhs.current_) {}
   CompactNbr(CompactNbr&& rhs)
@@ -417,10 +575,16 @@ struct CompactNbr {
         next_(rhs.next_),
         size_(rhs.size_),
         edata_arrays_(rhs.edata_arrays_),
+        codec_(rhs.codec_),
         data_(rhs.data_),
         current_(rhs.current_) {}
-  CompactNbr(const uint8_t* ptr, const size_t size, const void** edata_arrays)
-      : ptr_(ptr), next_(ptr), size_(size), edata_arrays_(edata_arrays) {
+  CompactNbr(const uint8_t* ptr, const size_t size, const void** edata_arrays,
+             const CompactEdgesCodec codec)
+      : ptr_(ptr),
+        next_(ptr),
+        size_(size),
+        edata_arrays_(edata_arrays),
+        codec_(codec) {
     decode();
   }
 
@@ -429,6 +593,7 @@ struct CompactNbr {
     next_ = rhs.next_;
     size_ = rhs.size_;
     edata_arrays_ = rhs.edata_arrays_;
+    codec_ = rhs.codec_;
     data_ = rhs.data_;
     current_ = rhs.current_;
     return *this;
@@ -439,6 +604,7 @@ struct CompactNbr {
     next_ = rhs.next_;
     size_ = rhs.size_;
     edata_arrays_ = std::move(rhs.edata_arrays_);
+    codec_ = rhs.codec_;
     data_ = rhs.data_;
     current_ = rhs.current_;
     return *this;
@@ -507,9 +673,14 @@ struct CompactNbr {
     ptr_ = next_;
     size_t n =
         (current_ + batch_size) < size_ ? batch_size : (size_ - current_);
-    next_ = v8dec32(const_cast<unsigned char*>(
-                        reinterpret_cast<const unsigned char*>(next_)),
-                    n * element_size, reinterpret_cast<uint32_t*>(data_));
+    if (likely(codec_ == CompactEdgesCodec::kStreamVByte)) {
+      next_ = stream_vbyte_decode32(next_, n * element_size,
+                                    reinterpret_cast<uint32_t*>(data_));
+    } else {
+      next_ = v8dec32(const_cast<unsigned char*>(
+                          reinterpret_cast<const unsigned char*>(next_)),
+                      n * element_size, reinterpret_cast<uint32_t*>(data_));
+    }
   }
 
   static constexpr size_t element_size =
@@ -519,6 +690,7 @@ struct CompactNbr {
   mutable const uint8_t *ptr_, *next_ = nullptr;
   mutable size_t size_ = 0;
   const void** edata_arrays_;
+  CompactEdgesCodec codec_ = CompactEdgesCodec::kVarint8;
 
   mutable NbrUnit<VID_T, EID_T> data_[batch_size];
   mutable size_t current_ = 0;
@@ -694,6 +866,83 @@ class AdjList {
   const void** edata_arrays_;
 };
 
+/**
+ * @brief The adjacency list of a vertex, i.e., the edges in the base CSR,
+ * followed by the edges in the delta CSR if there are any.
+ *
+ * `begin_unit()` and `end_unit()` cover the base segment only, the delta
+ * segment is available from `delta_begin_unit()` and `delta_end_unit()`.
+ */
+template <typename VID_T, typename EID_T>
+class DeltaAdjList {
+ public:
+  DeltaAdjList()
+      : begin_(NULL),
+        end_(NULL),
+        edata_arrays_(nullptr),
+        delta_begin_(NULL),
+        delta_end_(NULL),
+        delta_edata_arrays_(nullptr),
+        delta_eid_base_(0) {}
+  DeltaAdjList(const NbrUnit<VID_T, EID_T>* begin,
+               const NbrUnit<VID_T, EID_T>* end, const void** edata_arrays,
+               const NbrUnit<VID_T, EID_T>* delta_begin,
+               const NbrUnit<VID_T, EID_T>* delta_end,
+               const void** delta_edata_arrays, EID_T delta_eid_base)
+      : begin_(begin),
+        end_(end),
+        edata_arrays_(edata_arrays),
+        delta_begin_(delta_begin),
+        delta_end_(delta_end),
+        delta_edata_arrays_(delta_edata_arrays),
+        delta_eid_base_(delta_eid_base) {}
+
+  inline DeltaNbr<VID_T, EID_T> begin() const {
+    // starts from the delta segment directly if the base one is empty
+    return DeltaNbr<VID_T, EID_T>(begin_ == end_ ? delta_begin_ : begin_,
+                                  begin_ == end_, end_, delta_begin_,
+                                  edata_arrays_, delta_edata_arrays_,
+                                  delta_eid_base_);
+  }
+
+  inline DeltaNbr<VID_T, EID_T> end() const {
+    return DeltaNbr<VID_T, EID_T>(delta_end_, true, end_, delta_begin_,
+                                  edata_arrays_, delta_edata_arrays_,
+                                  delta_eid_base_);
+  }
+
+  inline size_t Size() const {
+    return (end_ - begin_) + (delta_end_ - delta_begin_);
+  }
+
+  inline bool Empty() const { return Size() == 0; }
+
+  inline bool NotEmpty() const { return Size() != 0; }
+
+  size_t size() const { return Size(); }
+
+  inline const NbrUnit<VID_T, EID_T>* begin_unit() const { return begin_; }
+
+  inline const NbrUnit<VID_T, EID_T>* end_unit() const { return end_; }
+
+  inline const NbrUnit<VID_T, EID_T>* delta_begin_unit() const {
+    return delta_begin_;
+  }
+
+  inline const NbrUnit<VID_T, EID_T>* delta_end_unit() const {
+    return delta_end_;
+  }
+
+ private:
+  const NbrUnit<VID_T, EID_T>* begin_;
+  const NbrUnit<VID_T, EID_T>* end_;
+  const void** edata_arrays_;
+  const NbrUnit<VID_T, EID_T>* delta_begin_;
+  const NbrUnit<VID_T, EID_T>* delta_end_;
+  const void** delta_edata_arrays_;
+  EID_T delta_eid_base_;
+};
+
 template <typename VID_T, typename EID_T>
 class CompactAdjList {
  public:
@@ -708,6 +957,7 @@ class CompactAdjList {
     end_ptr_ = nbrs.end_ptr_;
     size_ = nbrs.size_;
     edata_arrays_ = nbrs.edata_arrays_;
+    codec_ = nbrs.codec_;
   }
 
   CompactAdjList(CompactAdjList&& nbrs) {
@@ -715,6 +965,7 @@ class CompactAdjList {
     end_ptr_ = nbrs.end_ptr_;
     size_ = nbrs.size_;
     edata_arrays_ = nbrs.edata_arrays_;
+    codec_ = nbrs.codec_;
   }
 
   CompactAdjList& operator=(const CompactAdjList& rhs) {
@@ -722,6 +973,7 @@ class CompactAdjList {
     end_ptr_ = rhs.end_ptr_;
     size_ = rhs.size_;
     edata_arrays_ = rhs.edata_arrays_;
+    codec_ = rhs.codec_;
     return *this;
   }
 
@@ -730,22 +982,25 @@ class CompactAdjList {
     end_ptr_ = rhs.end_ptr_;
     size_ = rhs.size_;
     edata_arrays_ = rhs.edata_arrays_;
+    codec_ = rhs.codec_;
     return *this;
   }
 
   CompactAdjList(const uint8_t* begin_ptr, const uint8_t* end_ptr,
-                 const size_t size, const void** edata_arrays)
+                 const size_t size, const void** edata_arrays,
+                 const CompactEdgesCodec codec)
       : begin_ptr_(begin_ptr),
         end_ptr_(end_ptr),
         size_(size),
-        edata_arrays_(edata_arrays) {}
+        edata_arrays_(edata_arrays),
+        codec_(codec) {}
 
   inline CompactNbr<VID_T, EID_T> begin() const {
-    return CompactNbr<VID_T, EID_T>(begin_ptr_, size_, edata_arrays_);
+    return CompactNbr<VID_T, EID_T>(begin_ptr_, size_, edata_arrays_, codec_);
   }
 
   inline CompactNbr<VID_T, EID_T> end() const {
-    return CompactNbr<VID_T, EID_T>(end_ptr_, 0, edata_arrays_);
+    return CompactNbr<VID_T, EID_T>(end_ptr_, 0, edata_arrays_, codec_);
   }
 
   inline size_t Size() const { return size_; }
@@ -762,6 +1017,7 @@ class CompactAdjList {
   size_t size_ = 0;
 
   const void** edata_arrays_;
+  CompactEdgesCodec codec_ = CompactEdgesCodec::kVarint8;
 };
 
 template <typename VID_T>
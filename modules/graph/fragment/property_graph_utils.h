@@ -65,6 +65,38 @@ boost::leaf::result<void> generate_local_id_list(
     std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& lid_list,
     arrow::MemoryPool* pool = arrow::default_memory_pool());
 
+/**
+ * @brief Generate a locality-aware order of the inner vertices of fragment
+ * `fid` from the edges (in gids), where the vertices are sorted by their
+ * degrees in descending order, and ties keep the original order. Hubs, which
+ * are the targets of most neighbor accesses, are thus packed together.
+ *
+ * `orders[label][i]` is the original offset of the vertex that is placed at
+ * offset `i`, and `inverse_orders[label]` is the reverse mapping.
+ */
+template <typename VID_T>
+void generate_degree_order(
+    const IdParser<VID_T>& parser, fid_t fid,
+    property_graph_types::LABEL_ID_TYPE vertex_label_num,
+    const std::vector<VID_T>& ivnums,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& srcs,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& dsts,
+    int concurrency, std::vector<std::shared_ptr<arrow::Int64Array>>& orders,
+    std::vector<std::vector<VID_T>>& inverse_orders);
+
+/**
+ * @brief Rewrite the gids in `gid_list` to their new offsets given by
+ * `inverse_orders[fid][label]`, see also `generate_degree_order`. The gids
+ * of the fragments without an order are kept.
+ */
+template <typename VID_T>
+boost::leaf::result<void> reorder_inner_vertex_ids(
+    const IdParser<VID_T>& parser,
+    const std::vector<std::vector<std::vector<VID_T>>>& inverse_orders,
+    int concurrency,
+    std::shared_ptr<arrow::ChunkedArray>& gid_list,
+    arrow::MemoryPool* pool = arrow::default_memory_pool());
+
 template <typename VID_T, typename EID_T>
 void sort_edges_with_respect_to_vertex(
     vineyard::PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>&
@@ -136,6 +168,31 @@ boost::leaf::result<void> generate_undirected_csr_memopt(
     std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
     bool& is_multigraph);
 
+/**
+ * @brief Merge a batch of new edges into an existing CSR, without
+ * regenerating it from all the edges.
+ *
+ * The adjacency lists of the base CSR are copied as a whole, and only the
+ * lists that receive new edges are sorted again. The new edges get edge ids
+ * starting from `eid_base`. If `undirected` is true, every new edge is added
+ * to the lists of both of its endpoints.
+ */
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> append_edges_to_csr(
+    Client& client, IdParser<VID_T>& parser,
+    const std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& src_chunks,
+    const std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& dst_chunks,
+    const EID_T eid_base, const bool undirected,
+    const std::vector<const property_graph_utils::NbrUnit<VID_T, EID_T>*>&
+        base_edges,
+    const std::vector<const int64_t*>& base_edge_offsets,
+    const std::vector<VID_T>& base_tvnums, const std::vector<VID_T>& tvnums,
+    int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph);
+
 template <typename VID_T, typename EID_T>
 boost::leaf::result<void> varint_encoding_edges(
     Client& client, const bool directed,
@@ -159,6 +216,7 @@ boost::leaf::result<void> varint_encoding_edges(
         ie_boffsets_lists,
     std::vector<std::vector<std::shared_ptr<FixedInt64Builder>>>&
         oe_boffsets_lists,
+    const CompactEdgesCodec codec,
     const int concurrency = std::thread::hardware_concurrency());
 }  // namespace vineyard
 
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -183,22 +184,250 @@ boost::leaf::result<void> generate_local_id_list(
   return {};
 }
 
+template <typename VID_T>
+void generate_degree_order(
+    const IdParser<VID_T>& parser, fid_t fid,
+    property_graph_types::LABEL_ID_TYPE vertex_label_num,
+    const std::vector<VID_T>& ivnums,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& srcs,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& dsts,
+    int concurrency, std::vector<std::shared_ptr<arrow::Int64Array>>& orders,
+    std::vector<std::vector<VID_T>>& inverse_orders) {
+  std::vector<std::vector<int64_t>> degrees(vertex_label_num);
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    degrees[v_label].resize(ivnums[v_label], 0);
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> chunks;
+  for (auto const* gid_lists : {&srcs, &dsts}) {
+    for (auto const& gid_list : *gid_lists) {
+      chunks.insert(chunks.end(), gid_list->chunks().begin(),
+                    gid_list->chunks().end());
+    }
+  }
+  parallel_for(
+      static_cast<size_t>(0), chunks.size(),
+      [fid, &parser, &chunks, &degrees](size_t chunk_index) {
+        auto chunk = std::dynamic_pointer_cast<ArrowArrayType<VID_T>>(
+            chunks[chunk_index]);
+        const VID_T* gids = chunk->raw_values();
+        for (int64_t i = 0; i < chunk->length(); ++i) {
+          if (parser.GetFid(gids[i]) == fid) {
+            grape::atomic_add(degrees[parser.GetLabelId(gids[i])]
+                                     [parser.GetOffset(gids[i])],
+                              static_cast<int64_t>(1));
+          }
+        }
+      },
+      concurrency, 1);
+
+  orders.resize(vertex_label_num);
+  inverse_orders.resize(vertex_label_num);
+  for (int v_label = 0; v_label < vertex_label_num; ++v_label) {
+    const int64_t ivnum = ivnums[v_label];
+    const auto& degree = degrees[v_label];
+    arrow::BufferBuilder builder;
+    CHECK_ARROW_ERROR(builder.Resize(ivnum * sizeof(int64_t)));
+    builder.UnsafeAdvance(ivnum * sizeof(int64_t));
+    int64_t* order = reinterpret_cast<int64_t*>(builder.mutable_data());
+    std::iota(order, order + ivnum, 0);
+    std::stable_sort(order, order + ivnum,
+                     [&degree](const int64_t lhs, const int64_t rhs) {
+                       return degree[lhs] > degree[rhs];
+                     });
+
+    auto& inverse_order = inverse_orders[v_label];
+    inverse_order.resize(ivnum);
+    parallel_for(
+        static_cast<int64_t>(0), ivnum,
+        [order, &inverse_order](int64_t offset) {
+          inverse_order[order[offset]] = static_cast<VID_T>(offset);
+        },
+        concurrency);
+
+    std::shared_ptr<arrow::Buffer> buffer;
+    CHECK_ARROW_ERROR(builder.Finish(&buffer));
+    orders[v_label] = std::make_shared<arrow::Int64Array>(ivnum, buffer);
+  }
+}
+
+template <typename VID_T>
+boost::leaf::result<void> reorder_inner_vertex_ids(
+    const IdParser<VID_T>& parser,
+    const std::vector<std::vector<std::vector<VID_T>>>& inverse_orders,
+    int concurrency,
+    std::shared_ptr<arrow::ChunkedArray>& gid_list, arrow::MemoryPool* pool) {
+  std::vector<std::shared_ptr<arrow::Array>> chunks = gid_list->chunks();
+  std::vector<std::shared_ptr<arrow::Array>> reordered_chunks(chunks.size());
+  auto type = gid_list->type();
+  gid_list.reset();  // release the reference of chunked arrays
+
+  parallel_for(
+      static_cast<size_t>(0), chunks.size(),
+      [pool, &parser, &inverse_orders, &chunks,
+       &reordered_chunks](size_t chunk_index) -> boost::leaf::result<void> {
+        arrow::BufferBuilder builder(pool);
+        auto chunk = std::dynamic_pointer_cast<ArrowArrayType<VID_T>>(
+            chunks[chunk_index]);
+        chunks[chunk_index].reset();  // release the used chunks
+        ARROW_OK_OR_RAISE(builder.Resize(chunk->length() * sizeof(VID_T)));
+        builder.UnsafeAdvance(chunk->length() * sizeof(VID_T));
+
+        const VID_T* vec = chunk->raw_values();
+        VID_T* builder_data = reinterpret_cast<VID_T*>(builder.mutable_data());
+        for (int64_t i = 0; i < chunk->length(); ++i) {
+          VID_T gid = vec[i];
+          fid_t fid = parser.GetFid(gid);
+          if (!inverse_orders[fid].empty()) {
+            auto label = parser.GetLabelId(gid);
+            builder_data[i] = parser.GenerateId(
+                fid, label, inverse_orders[fid][label][parser.GetOffset(gid)]);
+          } else {
+            builder_data[i] = gid;
+          }
+        }
+        std::shared_ptr<arrow::Buffer> buffer;
+        ARROW_OK_OR_RAISE(builder.Finish(&buffer));
+        reordered_chunks[chunk_index] =
+            std::make_shared<ArrowArrayType<VID_T>>(chunk->length(), buffer);
+        return {};
+      },
+      concurrency);
+  gid_list = std::make_shared<arrow::ChunkedArray>(reordered_chunks, type);
+  return {};
+}
+
+/**
+ * LSD radix sort of the neighbors by the `vid`, the range is split into
+ * `concurrency` blocks that are counted and scattered in parallel. Digits
+ * that are the same in all the keys are skipped.
+ */
+template <typename VID_T, typename EID_T>
+void radix_sort_nbr_units(property_graph_utils::NbrUnit<VID_T, EID_T>* nbrs,
+                          property_graph_utils::NbrUnit<VID_T, EID_T>* scratch,
+                          const int64_t size, const int concurrency) {
+  using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+  constexpr int radix_bits = 8;
+  constexpr size_t radix_size = 1 << radix_bits;
+  const size_t block_num = std::max(
+      std::min(static_cast<int64_t>(concurrency), size / 4096),
+      static_cast<int64_t>(1));
+  auto block_begin = [&](size_t block) {
+    return static_cast<int64_t>(size * block / block_num);
+  };
+
+  std::vector<VID_T> key_or(block_num, 0), key_and(block_num, ~VID_T(0));
+  std::vector<std::vector<int64_t>> histograms(
+      block_num, std::vector<int64_t>(radix_size));
+  auto for_each_block = [&](auto&& fn) {
+    if (block_num == 1) {
+      fn(0);
+    } else {
+      parallel_for(static_cast<size_t>(0), block_num, fn, block_num, 1);
+    }
+  };
+
+  for_each_block([&](size_t block) {
+    for (int64_t i = block_begin(block); i < block_begin(block + 1); ++i) {
+      key_or[block] |= nbrs[i].vid;
+      key_and[block] &= nbrs[i].vid;
+    }
+  });
+  VID_T varying = 0;
+  for (size_t block = 0; block < block_num; ++block) {
+    varying |= key_or[block] ^ key_and[block];
+  }
+
+  nbr_unit_t *src = nbrs, *dst = scratch;
+  for (size_t shift = 0; shift < sizeof(VID_T) * 8; shift += radix_bits) {
+    if (((varying >> shift) & (radix_size - 1)) == 0) {
+      continue;
+    }
+    for_each_block([&](size_t block) {
+      auto& histogram = histograms[block];
+      std::fill(histogram.begin(), histogram.end(), 0);
+      for (int64_t i = block_begin(block); i < block_begin(block + 1); ++i) {
+        histogram[(src[i].vid >> shift) & (radix_size - 1)] += 1;
+      }
+    });
+    // digit-major, block-minor, to keep the sort stable
+    int64_t offset = 0;
+    for (size_t digit = 0; digit < radix_size; ++digit) {
+      for (size_t block = 0; block < block_num; ++block) {
+        int64_t count = histograms[block][digit];
+        histograms[block][digit] = offset;
+        offset += count;
+      }
+    }
+    for_each_block([&](size_t block) {
+      auto& histogram = histograms[block];
+      for (int64_t i = block_begin(block); i < block_begin(block + 1); ++i) {
+        dst[histogram[(src[i].vid >> shift) & (radix_size - 1)]++] = src[i];
+      }
+    });
+    std::swap(src, dst);
+  }
+  if (src != nbrs) {
+    for_each_block([&](size_t block) {
+      memcpy(nbrs + block_begin(block), src + block_begin(block),
+             (block_begin(block + 1) - block_begin(block)) *
+                 sizeof(nbr_unit_t));
+    });
+  }
+}
+
 template <typename VID_T, typename EID_T>
 void sort_edges_with_respect_to_vertex(
     vineyard::PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>&
         builder,
     const int64_t* offsets, VID_T tvnum, int concurrency) {
   using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+  // short lists are sorted by std::sort, longer ones by the radix sort, and
+  // the few very long lists of power-law graphs are sorted one by one with
+  // all threads, rather than blocking a single thread
+  constexpr int64_t radix_sort_threshold = 256;
+  const int64_t parallel_sort_threshold =
+      std::max(static_cast<int64_t>(1 << 16),
+               offsets[tvnum] / (std::max(concurrency, 1) * 8));
+
+  std::vector<VID_T> large_vertices;
+  for (VID_T i = 0; i < tvnum; ++i) {
+    if (offsets[i + 1] - offsets[i] >= parallel_sort_threshold) {
+      large_vertices.push_back(i);
+    }
+  }
+
   parallel_for(
       static_cast<VID_T>(0), tvnum,
-      [offsets, &builder](VID_T i) {
+      [offsets, &builder, parallel_sort_threshold](VID_T i) {
+        int64_t degree = offsets[i + 1] - offsets[i];
         nbr_unit_t* begin = builder.MutablePointer(offsets[i]);
-        nbr_unit_t* end = builder.MutablePointer(offsets[i + 1]);
-        std::sort(begin, end, [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
-          return lhs.vid < rhs.vid;
-        });
+        if (degree < radix_sort_threshold) {
+          std::sort(begin, begin + degree,
+                    [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+                      return lhs.vid < rhs.vid;
+                    });
+        } else if (degree < parallel_sort_threshold) {
+          thread_local std::vector<nbr_unit_t> scratch;
+          if (scratch.size() < static_cast<size_t>(degree)) {
+            scratch.resize(degree);
+          }
+          radix_sort_nbr_units(begin, scratch.data(), degree, 1);
+        }
       },
       concurrency, 16);
+
+  if (!large_vertices.empty()) {
+    int64_t max_degree = 0;
+    for (VID_T i : large_vertices) {
+      max_degree = std::max(max_degree, offsets[i + 1] - offsets[i]);
+    }
+    std::vector<nbr_unit_t> scratch(max_degree);
+    for (VID_T i : large_vertices) {
+      radix_sort_nbr_units(builder.MutablePointer(offsets[i]), scratch.data(),
+                           offsets[i + 1] - offsets[i], concurrency);
+    }
+  }
 }
 
 template <typename VID_T, typename EID_T>
@@ -226,113 +455,217 @@ void check_is_multigraph(
       concurrency, 1024);
 }
 
+/**
+ * Scatter the edges into the adjacency lists of their sources (and of their
+ * destinations as well if `undirected`) with a parallel counting sort,
+ * rather than with atomic cursors on the offsets.
+ *
+ * The edges are split into blocks, and the vertices of each label into
+ * ranges. Each block counts its edges per range, and then scatters them,
+ * grouped by range, into a buffer. Each range is then owned by a single
+ * thread, which counts the degrees of its vertices and places the edges into
+ * their lists, thus the lists are in the order of edge ids, and are sorted by
+ * the neighbors later.
+ *
+ * The buffer holds all the edges along with their sources, see also
+ * `generate_undirected_csr_memopt` when the memory is tight.
+ */
 template <typename VID_T, typename EID_T>
-boost::leaf::result<void> generate_directed_csr(
+void scatter_edges_by_source(
     Client& client, IdParser<VID_T>& parser,
-    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
-    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
-    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& dst_chunks,
+    const std::vector<VID_T>& tvnums, const int vertex_label_num,
+    const bool undirected, const int concurrency,
     std::vector<std::shared_ptr<
         PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
-    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
-    bool& is_multigraph) {
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets) {
   using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+  struct entry_t {
+    VID_T src;
+    nbr_unit_t nbr;
+  };
 
-  int64_t num_chunks = src_chunks.size();
-  // compute the outgoing degrees of src vertices
-  // degree row: vertex_label_num  col: all other vertex this vertex points to
-  std::vector<std::vector<int>> degree(vertex_label_num);
-  std::vector<int64_t> actual_edge_num(vertex_label_num, 0);
+  const int64_t num_chunks = src_chunks.size();
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    chunk_offsets[i + 1] = chunk_offsets[i] + src_chunks[i]->length();
+  }
+  const int64_t edge_num = chunk_offsets[num_chunks];
+
+  int64_t total_vnum = 0;
   for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
-    degree[v_label].resize(tvnums[v_label], 0);
+    total_vnum += tvnums[v_label];
   }
+  const int64_t range_size = std::max(
+      static_cast<int64_t>(1024),
+      total_vnum / (static_cast<int64_t>(std::max(concurrency, 1)) * 16) + 1);
+  std::vector<size_t> range_base(vertex_label_num + 1, 0);
+  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
+    range_base[v_label + 1] =
+        range_base[v_label] + (tvnums[v_label] + range_size - 1) / range_size;
+  }
+  const size_t range_num = range_base[vertex_label_num];
+  auto range_of = [&](const VID_T id) {
+    return range_base[parser.GetLabelId(id)] +
+           parser.GetOffset(id) / range_size;
+  };
 
+  const size_t block_num = std::max(
+      std::min(static_cast<int64_t>(concurrency), edge_num / 4096),
+      static_cast<int64_t>(1));
+  auto block_begin = [&](size_t block) {
+    return static_cast<int64_t>(edge_num * block / block_num);
+  };
+  auto for_each_edge = [&](size_t block, auto&& fn) {
+    int64_t begin = block_begin(block), end = block_begin(block + 1);
+    int64_t chunk_index = std::upper_bound(chunk_offsets.begin(),
+                                           chunk_offsets.end(), begin) -
+                          chunk_offsets.begin() - 1;
+    for (int64_t eid = begin; eid < end; ++chunk_index) {
+      const VID_T* srcs = src_chunks[chunk_index]->raw_values();
+      const VID_T* dsts = dst_chunks[chunk_index]->raw_values();
+      int64_t chunk_end = std::min(end, chunk_offsets[chunk_index + 1]);
+      for (; eid < chunk_end; ++eid) {
+        int64_t i = eid - chunk_offsets[chunk_index];
+        fn(srcs[i], dsts[i], eid);
+      }
+    }
+  };
+
+  // range-major, block-minor cursors, to keep the order of edge ids
+  std::vector<std::vector<int64_t>> cursors(block_num,
+                                            std::vector<int64_t>(range_num));
   parallel_for(
-      static_cast<int64_t>(0), num_chunks,
-      [&degree, &parser, &src_chunks](int64_t chunk_index) {
-        auto src_array = src_chunks[chunk_index];
-        const VID_T* src_list_ptr = src_array->raw_values();
+      static_cast<size_t>(0), block_num,
+      [&](size_t block) {
+        auto& cursor = cursors[block];
+        for_each_edge(block, [&](VID_T src, VID_T dst, int64_t) {
+          cursor[range_of(src)] += 1;
+          if (undirected) {
+            cursor[range_of(dst)] += 1;
+          }
+        });
+      },
+      block_num, 1);
+  std::vector<int64_t> range_offsets(range_num + 1, 0);
+  int64_t offset = 0;
+  for (size_t range = 0; range < range_num; ++range) {
+    range_offsets[range] = offset;
+    for (size_t block = 0; block < block_num; ++block) {
+      int64_t count = cursors[block][range];
+      cursors[block][range] = offset;
+      offset += count;
+    }
+  }
+  range_offsets[range_num] = offset;
 
-        for (int64_t i = 0; i < src_array->length(); ++i) {
-          VID_T src_id = src_list_ptr[i];
-          // if src_id in the src_array, means it must have a dst
-          // so we need to add the out_degree of src_id
-          grape::atomic_add(
-              degree[parser.GetLabelId(src_id)][parser.GetOffset(src_id)], 1);
-        }
+  std::vector<entry_t> buffer(offset);
+  parallel_for(
+      static_cast<size_t>(0), block_num,
+      [&](size_t block) {
+        auto& cursor = cursors[block];
+        for_each_edge(block, [&](VID_T src, VID_T dst, int64_t eid) {
+          buffer[cursor[range_of(src)]++] =
+              entry_t{src, nbr_unit_t(dst, static_cast<EID_T>(eid))};
+          if (undirected) {
+            buffer[cursor[range_of(dst)]++] =
+                entry_t{dst, nbr_unit_t(src, static_cast<EID_T>(eid))};
+          }
+        });
       },
-      concurrency);
+      block_num, 1);
+  cursors.clear();
+  src_chunks.clear();
+  dst_chunks.clear();
 
-  std::vector<std::vector<int64_t>> offsets(vertex_label_num);
   for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
-    auto tvnum = tvnums[v_label];
-    auto& offset_vec = offsets[v_label];
-    auto& degree_vec = degree[v_label];
-
-    offset_vec.resize(tvnum + 1);
-    offset_vec[0] = 0;
-
-    if (tvnum > 0) {
-      parallel_prefix_sum(degree_vec.data(), &offset_vec[1], tvnum,
-                          concurrency);
-    }
-    // build the arrow's offset array
     edge_offsets[v_label] =
-        std::make_shared<FixedInt64Builder>(client, tvnum + 1);
-    memcpy(edge_offsets[v_label]->data(), offset_vec.data(),
-           (tvnum + 1) * sizeof(int64_t));
-    // due to prefix sum, offset_vec[tvnum] sums up all the offsets
-    // and finally got the real edge number
-    actual_edge_num[v_label] = offset_vec[tvnum];
-  }
-  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
+        std::make_shared<FixedInt64Builder>(client, tvnums[v_label] + 1);
+    edge_offsets[v_label]->data()[0] = 0;
     edges[v_label] = std::make_shared<PodArrayBuilder<nbr_unit_t>>(
-        client, actual_edge_num[v_label]);
+        client, range_offsets[range_base[v_label + 1]] -
+                    range_offsets[range_base[v_label]]);
   }
 
-  VLOG(100) << "Start building the CSR ..." << get_rss_pretty()
-            << ", peak = " << get_peak_rss_pretty();
-
-  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
-  for (int64_t i = 0; i < num_chunks; ++i) {
-    chunk_offsets[i + 1] = chunk_offsets[i] + src_chunks[i]->length();
-  }
   parallel_for(
-      static_cast<int64_t>(0), num_chunks,
-      [&src_chunks, &dst_chunks, &parser, &edges, &offsets,
-       &chunk_offsets](int64_t chunk_index) {
-        auto src_array = src_chunks[chunk_index];
-        auto dst_array = dst_chunks[chunk_index];
-        const VID_T* src_list_ptr = src_array->raw_values();
-        const VID_T* dst_list_ptr = dst_array->raw_values();
-        for (int64_t i = 0; i < src_array->length(); ++i) {
-          VID_T src_id = src_list_ptr[i];
-          int v_label = parser.GetLabelId(src_id);
-          int64_t v_offset = parser.GetOffset(src_id);
-          int64_t adj_offset =
-              __sync_fetch_and_add(&offsets[v_label][v_offset], 1);
-          nbr_unit_t* ptr = edges[v_label]->MutablePointer(adj_offset);
-          ptr->vid = dst_list_ptr[i];
-          ptr->eid = static_cast<EID_T>(chunk_offsets[chunk_index] + i);
+      static_cast<size_t>(0), range_num,
+      [&](size_t range) {
+        int v_label = std::upper_bound(range_base.begin(), range_base.end(),
+                                       range) -
+                      range_base.begin() - 1;
+        int64_t begin = (range - range_base[v_label]) * range_size;
+        int64_t end = std::min(begin + range_size,
+                               static_cast<int64_t>(tvnums[v_label]));
+        // the offsets[begin + 1, end] of the vertices in this range, the
+        // offsets[begin] is written by the previous range
+        int64_t* offsets = edge_offsets[v_label]->data();
+        std::fill(offsets + begin + 1, offsets + end + 1, 0);
+        for (int64_t i = range_offsets[range]; i < range_offsets[range + 1];
+             ++i) {
+          offsets[parser.GetOffset(buffer[i].src) + 1] += 1;
+        }
+        std::vector<int64_t> cursor(end - begin);
+        int64_t position =
+            range_offsets[range] - range_offsets[range_base[v_label]];
+        for (int64_t v = begin; v < end; ++v) {
+          cursor[v - begin] = position;
+          position += offsets[v + 1];
+          offsets[v + 1] = position;
+        }
+        for (int64_t i = range_offsets[range]; i < range_offsets[range + 1];
+             ++i) {
+          int64_t v = parser.GetOffset(buffer[i].src);
+          *edges[v_label]->MutablePointer(cursor[v - begin]++) = buffer[i].nbr;
         }
-        src_chunks[chunk_index].reset();
-        dst_chunks[chunk_index].reset();
       },
-      concurrency);
+      concurrency, 1);
+}
+
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> generate_directed_csr(
+    Client& client, IdParser<VID_T>& parser,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> src_chunks,
+    std::vector<std::shared_ptr<ArrowArrayType<VID_T>>> dst_chunks,
+    std::vector<VID_T> tvnums, int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph) {
+  auto start_timestamp = GetCurrentTime();
+  VLOG(100) << "Start building the CSR ..." << get_rss_pretty()
+            << ", peak = " << get_peak_rss_pretty();
+
+  scatter_edges_by_source<VID_T, EID_T>(client, parser, src_chunks, dst_chunks,
+                                        tvnums, vertex_label_num, false,
+                                        concurrency, edges, edge_offsets);
+
+  auto scatter_timestamp = GetCurrentTime();
 
   VLOG(100) << "Finish building the CSR ..." << get_rss_pretty()
             << ", peak = " << get_peak_rss_pretty();
+  double sort_time = 0, check_time = 0;
   for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
+    auto sort_timestamp = GetCurrentTime();
     sort_edges_with_respect_to_vertex(*edges[v_label],
                                       edge_offsets[v_label]->data(),
                                       tvnums[v_label], concurrency);
+    auto check_timestamp = GetCurrentTime();
+    sort_time += check_timestamp - sort_timestamp;
     if (!is_multigraph) {
       check_is_multigraph(*edges[v_label], edge_offsets[v_label]->data(),
                           tvnums[v_label], concurrency, is_multigraph);
     }
+    check_time += GetCurrentTime() - check_timestamp;
   }
   VLOG(100) << "Finish building the CSR (all) ..." << get_rss_pretty()
             << ", peak = " << get_peak_rss_pretty();
+  VLOG(100) << "Building the CSR use " << (GetCurrentTime() - start_timestamp)
+            << " seconds\n\tscattering edges use "
+            << (scatter_timestamp - start_timestamp)
+            << " seconds\n\tsorting edges use " << sort_time
+            << " seconds\n\tchecking multigraph use " << check_time
+            << " seconds";
   return {};
 }
 
@@ -448,101 +781,12 @@ boost::leaf::result<void> generate_undirected_csr(
         PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
     std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
     bool& is_multigraph) {
-  using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
-
-  int64_t num_chunks = src_chunks.size();
-  std::vector<std::vector<int>> degree(vertex_label_num);
-  std::vector<int64_t> actual_edge_num(vertex_label_num, 0);
-  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
-    degree[v_label].resize(tvnums[v_label], 0);
-  }
-
-  // compute the degrees
-  parallel_for(
-      static_cast<int64_t>(0), num_chunks,
-      [&degree, &parser, &src_chunks, &dst_chunks](int64_t chunk_index) {
-        auto src_array = src_chunks[chunk_index];
-        auto dst_array = dst_chunks[chunk_index];
-        const VID_T* src_list_ptr = src_array->raw_values();
-        const VID_T* dst_list_ptr = dst_array->raw_values();
-
-        for (int64_t i = 0; i < src_array->length(); ++i) {
-          VID_T src_id = src_list_ptr[i];
-          VID_T dst_id = dst_list_ptr[i];
-          grape::atomic_add(
-              degree[parser.GetLabelId(src_id)][parser.GetOffset(src_id)], 1);
-          grape::atomic_add(
-              degree[parser.GetLabelId(dst_id)][parser.GetOffset(dst_id)], 1);
-        }
-      },
-      concurrency);
-
-  // building the offsets array
-  std::vector<std::vector<int64_t>> offsets(vertex_label_num);
-  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
-    auto tvnum = tvnums[v_label];
-    auto& offset_vec = offsets[v_label];
-    auto& degree_vec = degree[v_label];
-
-    offset_vec.resize(tvnum + 1);
-    offset_vec[0] = 0;
-
-    if (tvnum > 0) {
-      parallel_prefix_sum(degree_vec.data(), &offset_vec[1], tvnum,
-                          concurrency);
-    }
-    // build the arrow's offset array
-    edge_offsets[v_label] =
-        std::make_shared<FixedInt64Builder>(client, tvnum + 1);
-    memcpy(edge_offsets[v_label]->data(), offset_vec.data(),
-           (tvnum + 1) * sizeof(int64_t));
-    actual_edge_num[v_label] = offset_vec[tvnum];
-  }
-
-  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
-    edges[v_label] = std::make_shared<PodArrayBuilder<nbr_unit_t>>(
-        client, actual_edge_num[v_label]);
-  }
-
   VLOG(100) << "Start building the CSR ..." << get_rss_pretty()
             << ", peak = " << get_peak_rss_pretty();
 
-  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
-  for (int64_t i = 0; i < num_chunks; ++i) {
-    chunk_offsets[i + 1] = chunk_offsets[i] + src_chunks[i]->length();
-  }
-  parallel_for(
-      static_cast<int64_t>(0), num_chunks,
-      [&src_chunks, &dst_chunks, &parser, &edges, &offsets,
-       &chunk_offsets](int64_t chunk_index) {
-        auto& src_array = src_chunks[chunk_index];
-        auto& dst_array = dst_chunks[chunk_index];
-        const VID_T* src_list_ptr = src_array->raw_values();
-        const VID_T* dst_list_ptr = dst_array->raw_values();
-        for (int64_t i = 0; i < src_array->length(); ++i) {
-          VID_T src_id = src_list_ptr[i];
-          VID_T dst_id = dst_list_ptr[i];
-          auto src_label = parser.GetLabelId(src_id);
-          int64_t src_offset = parser.GetOffset(src_id);
-          auto dst_label = parser.GetLabelId(dst_id);
-          int64_t dst_offset = parser.GetOffset(dst_id);
-
-          int64_t oe_offset =
-              __sync_fetch_and_add(&offsets[src_label][src_offset], 1);
-          nbr_unit_t* src_ptr = edges[src_label]->MutablePointer(oe_offset);
-          src_ptr->vid = dst_id;
-          src_ptr->eid = static_cast<EID_T>(chunk_offsets[chunk_index] + i);
-
-          int64_t ie_offset =
-              __sync_fetch_and_add(&offsets[dst_label][dst_offset], 1);
-          nbr_unit_t* dst_ptr = edges[dst_label]->MutablePointer(ie_offset);
-          dst_ptr->vid = src_id;
-          dst_ptr->eid = static_cast<EID_T>(chunk_offsets[chunk_index] + i);
-        }
-        src_chunks[chunk_index].reset();
-        dst_chunks[chunk_index].reset();
-      },
-      concurrency);
+  scatter_edges_by_source<VID_T, EID_T>(client, parser, src_chunks, dst_chunks,
+                                        tvnums, vertex_label_num, true,
+                                        concurrency, edges, edge_offsets);
 
   VLOG(100) << "Finish building the CSR ..." << get_rss_pretty()
             << ", peak = " << get_peak_rss_pretty();
@@ -699,6 +943,151 @@ boost::leaf::result<void> generate_undirected_csr_memopt(
   return {};
 }
 
+template <typename VID_T, typename EID_T>
+boost::leaf::result<void> append_edges_to_csr(
+    Client& client, IdParser<VID_T>& parser,
+    const std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& src_chunks,
+    const std::vector<std::shared_ptr<ArrowArrayType<VID_T>>>& dst_chunks,
+    const EID_T eid_base, const bool undirected,
+    const std::vector<const property_graph_utils::NbrUnit<VID_T, EID_T>*>&
+        base_edges,
+    const std::vector<const int64_t*>& base_edge_offsets,
+    const std::vector<VID_T>& base_tvnums, const std::vector<VID_T>& tvnums,
+    int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<VID_T, EID_T>>>>& edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph) {
+  using nbr_unit_t = property_graph_utils::NbrUnit<VID_T, EID_T>;
+
+  int64_t num_chunks = src_chunks.size();
+  std::vector<int64_t> chunk_offsets(num_chunks + 1, 0);
+  for (int64_t i = 0; i < num_chunks; ++i) {
+    chunk_offsets[i + 1] = chunk_offsets[i] + src_chunks[i]->length();
+  }
+  auto for_each_edge = [&](auto&& fn) {
+    parallel_for(
+        static_cast<int64_t>(0), num_chunks,
+        [&](int64_t chunk_index) {
+          const VID_T* src_list_ptr = src_chunks[chunk_index]->raw_values();
+          const VID_T* dst_list_ptr = dst_chunks[chunk_index]->raw_values();
+          EID_T eid = eid_base + chunk_offsets[chunk_index];
+          for (int64_t i = 0; i < src_chunks[chunk_index]->length(); ++i) {
+            fn(src_list_ptr[i], dst_list_ptr[i], eid + i);
+            if (undirected) {
+              fn(dst_list_ptr[i], src_list_ptr[i], eid + i);
+            }
+          }
+        },
+        concurrency);
+  };
+
+  // compute the degrees of the new edges
+  std::vector<std::vector<int>> degree(vertex_label_num);
+  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
+    degree[v_label].resize(tvnums[v_label], 0);
+  }
+  for_each_edge([&](VID_T src_id, VID_T, EID_T) {
+    grape::atomic_add(
+        degree[parser.GetLabelId(src_id)][parser.GetOffset(src_id)], 1);
+  });
+
+  // the offsets of the merged lists, and the position for the next new edge
+  // of each vertex, which follows the edges copied from the base CSR
+  std::vector<std::vector<int64_t>> offsets(vertex_label_num);
+  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
+    auto tvnum = tvnums[v_label];
+    auto base_tvnum = base_tvnums[v_label];
+    const int64_t* base_offsets = base_edge_offsets[v_label];
+    auto& offset_vec = offsets[v_label];
+    offset_vec.resize(tvnum + 1);
+    offset_vec[0] = 0;
+    if (tvnum > 0) {
+      parallel_prefix_sum(degree[v_label].data(), &offset_vec[1], tvnum,
+                          concurrency);
+    }
+
+    edge_offsets[v_label] =
+        std::make_shared<FixedInt64Builder>(client, tvnum + 1);
+    int64_t* merged_offsets = edge_offsets[v_label]->data();
+    parallel_for(
+        static_cast<VID_T>(0), tvnum + 1,
+        [&](VID_T v) {
+          merged_offsets[v] =
+              offset_vec[v] + base_offsets[std::min(v, base_tvnum)];
+        },
+        concurrency, 4096);
+    edges[v_label] = std::make_shared<PodArrayBuilder<nbr_unit_t>>(
+        client, merged_offsets[tvnum]);
+
+    const nbr_unit_t* base = base_edges[v_label];
+    auto& builder = *edges[v_label];
+    parallel_for(
+        static_cast<VID_T>(0), tvnum,
+        [&](VID_T v) {
+          int64_t base_degree = 0;
+          if (v < base_tvnum) {
+            base_degree = base_offsets[v + 1] - base_offsets[v];
+          }
+          if (base_degree > 0) {
+            memcpy(builder.MutablePointer(merged_offsets[v]),
+                   base + base_offsets[v], base_degree * sizeof(nbr_unit_t));
+          }
+          offset_vec[v] = merged_offsets[v] + base_degree;
+        },
+        concurrency, 1024);
+  }
+
+  for_each_edge([&](VID_T src_id, VID_T dst_id, EID_T eid) {
+    auto src_label = parser.GetLabelId(src_id);
+    int64_t adj_offset = __sync_fetch_and_add(
+        &offsets[src_label][parser.GetOffset(src_id)], 1);
+    nbr_unit_t* ptr = edges[src_label]->MutablePointer(adj_offset);
+    ptr->vid = dst_id;
+    ptr->eid = eid;
+  });
+
+  // the base lists are sorted already, only the lists that receive new
+  // edges need to be merged
+  for (int v_label = 0; v_label != vertex_label_num; ++v_label) {
+    auto base_tvnum = base_tvnums[v_label];
+    const int64_t* base_offsets = base_edge_offsets[v_label];
+    const int64_t* merged_offsets = edge_offsets[v_label]->data();
+    auto& builder = *edges[v_label];
+    auto& degree_vec = degree[v_label];
+    parallel_for(
+        static_cast<VID_T>(0), tvnums[v_label],
+        [&](VID_T v) {
+          if (degree_vec[v] == 0) {
+            return;
+          }
+          auto comparator = [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+            return lhs.vid < rhs.vid;
+          };
+          nbr_unit_t* begin = builder.MutablePointer(merged_offsets[v]);
+          nbr_unit_t* end = builder.MutablePointer(merged_offsets[v + 1]);
+          nbr_unit_t* middle = end - degree_vec[v];
+          if (v < base_tvnum) {
+            middle = begin + (base_offsets[v + 1] - base_offsets[v]);
+          }
+          std::sort(middle, end, comparator);
+          std::inplace_merge(begin, middle, end, comparator);
+          if (!is_multigraph) {
+            nbr_unit_t* loc = std::adjacent_find(
+                begin, end, [](const nbr_unit_t& lhs, const nbr_unit_t& rhs) {
+                  return lhs.vid == rhs.vid;
+                });
+            if (loc != end) {
+              __sync_or_and_fetch(
+                  reinterpret_cast<unsigned char*>(&is_multigraph), 1);
+            }
+          }
+        },
+        concurrency, 64);
+  }
+  return {};
+}
+
 template <typename VID_T, typename EID_T>
 boost::leaf::result<void> varint_encoding_edges_impl(
     Client& client,
@@ -707,6 +1096,7 @@ boost::leaf::result<void> varint_encoding_edges_impl(
     std::shared_ptr<FixedUInt8Builder>& ce_lists,
     const std::shared_ptr<FixedInt64Builder>& e_offsets,
     std::shared_ptr<FixedInt64Builder>& e_boffsets,
+    const CompactEdgesCodec codec,
     const int concurrency = std::thread::hardware_concurrency()) {
   const int64_t* offsets = e_offsets->data();
   property_graph_utils::NbrUnit<VID_T, EID_T>* edges = e_lists->data();
@@ -740,50 +1130,131 @@ boost::leaf::result<void> varint_encoding_edges_impl(
   std::unique_ptr<BlobWriter> encoded;
   VY_OK_OR_RAISE(e_lists->Release(encoded));
 
-  // Leave the first 4kb buffer to avoid inplace override issue. In certain
-  // cases and values, the inplace encoding would cause value error.
-  static uint8_t inplace_buffer[VARINT_ENCODING_BATCH_SIZE * (2 * 8)];
-
-  // batch encoding
+  // batch encoding, in parallel
+  //
+  // The vertices are split into chunks of roughly `chunk_edges` edges, and
+  // each chunk is encoded into a scratch buffer of its own, then copied back
+  // into the reused edges buffer. Chunks are processed in rounds of
+  // `concurrency` chunks: the encoded output of a round never goes beyond
+  // the raw edges of that round, so it can be copied back without touching
+  // the edges of the following rounds.
   uint8_t* encoded_begin = reinterpret_cast<uint8_t*>(encoded->data());
   e_boffsets = std::make_shared<FixedInt64Builder>(client, vnum + 1);
   int64_t* boffsets = e_boffsets->data();
   boffsets[0] = 0;
 
+  constexpr size_t unit_size =
+      sizeof(property_graph_utils::NbrUnit<VID_T, EID_T>);
+  // the worst case of encoding a batch: 4 bytes for each value plus the
+  // control bytes
+  constexpr size_t batch_bound =
+      VARINT_ENCODING_BATCH_SIZE * element_size * 5 + 32;
+  const size_t parallelism = std::max(concurrency, 1);
+  const int64_t chunk_edges = std::min(
+      std::max(offsets[vnum] / static_cast<int64_t>(parallelism * 4),
+               static_cast<int64_t>(16 * 1024)),
+      static_cast<int64_t>(1024 * 1024));
+
+  std::vector<VID_T> chunks{0};
   for (VID_T v = 0; v < vnum; ++v) {
-    uint8_t* ptr = encoded_begin + boffsets[v];
-    size_t encoded_size = offsets[v], size_limit = offsets[v + 1];
-    while (encoded_size < size_limit) {
-      size_t batch_size =
-          std::min(static_cast<size_t>(VARINT_ENCODING_BATCH_SIZE),
-                   size_limit - encoded_size);
-      if (unlikely(ptr - encoded_begin < 4096)) {
-        uint8_t* dest =
-            v8enc32(reinterpret_cast<uint32_t*>(edges + encoded_size),
-                    batch_size * element_size, inplace_buffer);
-        memcpy(ptr, inplace_buffer, dest - inplace_buffer);
-        ptr += dest - inplace_buffer;
-      } else {
-        ptr = v8enc32(reinterpret_cast<uint32_t*>(edges + encoded_size),
-                      batch_size * element_size, ptr);
-      }
-      encoded_size += batch_size;
-      // should be no overflow
-      if (reinterpret_cast<uint32_t*>(ptr) >
-          reinterpret_cast<uint32_t*>(edges + encoded_size + batch_size)) {
-        VY_OK_OR_RAISE(
-            Status::Invalid("failed to compact the nbr list as it overflowed, "
-                            "try set the parameter `compact_edges` to false"));
-      }
+    if (offsets[v + 1] - offsets[chunks.back()] >= chunk_edges) {
+      chunks.push_back(v + 1);
+    }
+  }
+  if (chunks.back() != vnum) {
+    chunks.push_back(vnum);
+  }
+  const size_t chunk_num = chunks.size() - 1;
+
+  std::vector<std::vector<uint8_t>> buffers(parallelism);
+  std::vector<size_t> encoded_sizes(parallelism);
+  std::vector<int64_t> chunk_boffsets(parallelism);
+  int64_t total_encoded_size = 0;
+
+  for (size_t round = 0; round < chunk_num; round += parallelism) {
+    const size_t round_size = std::min(parallelism, chunk_num - round);
+    // boffsets of the chunk are relative to the scratch buffer until being
+    // copied back
+    parallel_for(
+        static_cast<size_t>(0), round_size,
+        [&](const size_t index) {
+          std::vector<uint8_t>& buffer = buffers[index];
+          size_t& encoded_size = encoded_sizes[index];
+          encoded_size = 0;
+          for (VID_T v = chunks[round + index]; v < chunks[round + index + 1];
+               ++v) {
+            size_t begin = offsets[v], end = offsets[v + 1];
+            while (begin < end) {
+              size_t batch_size =
+                  std::min(static_cast<size_t>(VARINT_ENCODING_BATCH_SIZE),
+                           end - begin);
+              if (buffer.size() < encoded_size + batch_bound) {
+                buffer.resize(
+                    std::max(buffer.size() * 2, encoded_size + batch_bound));
+              }
+              uint8_t* dest = buffer.data() + encoded_size;
+              uint32_t* values = reinterpret_cast<uint32_t*>(edges + begin);
+              if (codec == CompactEdgesCodec::kStreamVByte) {
+                encoded_size += stream_vbyte_encode32(
+                                    values, batch_size * element_size, dest) -
+                                dest;
+              } else {
+                encoded_size +=
+                    v8enc32(values, batch_size * element_size, dest) - dest;
+              }
+              begin += batch_size;
+            }
+            boffsets[v + 1] = encoded_size;
+          }
+        },
+        round_size, 1);
+
+    for (size_t index = 0; index < round_size; ++index) {
+      chunk_boffsets[index] = total_encoded_size;
+      total_encoded_size += encoded_sizes[index];
+    }
+    // should be no overflow
+    if (total_encoded_size >
+        static_cast<int64_t>(offsets[chunks[round + round_size]] * unit_size)) {
+      VY_OK_OR_RAISE(
+          Status::Invalid("failed to compact the nbr list as it overflowed, "
+                          "try set the parameter `compact_edges` to false"));
+    }
+
+    parallel_for(
+        static_cast<size_t>(0), round_size,
+        [&](const size_t index) {
+          memcpy(encoded_begin + chunk_boffsets[index], buffers[index].data(),
+                 encoded_sizes[index]);
+          for (VID_T v = chunks[round + index]; v < chunks[round + index + 1];
+               ++v) {
+            boffsets[v + 1] += chunk_boffsets[index];
+          }
+        },
+        round_size, 1);
+  }
+  // release the scratch buffers before sealing
+  buffers.clear();
+
+  // the SIMD decoder reads a few bytes beyond the last batch
+  int64_t encoded_size = boffsets[vnum];
+  if (codec == CompactEdgesCodec::kStreamVByte && encoded_size > 0) {
+    encoded_size += STREAM_VBYTE_PADDING;
+    if (encoded_size > static_cast<int64_t>(encoded->size())) {
+      std::unique_ptr<BlobWriter> padded;
+      VY_OK_OR_RAISE(client.CreateBlob(encoded_size, padded));
+      memcpy(padded->data(), encoded->data(), boffsets[vnum]);
+      VY_OK_OR_RAISE(encoded->Abort(client));
+      encoded = std::move(padded);
     }
-    boffsets[v + 1] = ptr - encoded_begin;
+    memset(encoded->data() + boffsets[vnum], 0, STREAM_VBYTE_PADDING);
   }
 
   // we may failed to shrink due the limitation of old version of
   // vineyardd, in such case, we shouldn't fail
-  VINEYARD_SUPPRESS(encoded->Shrink(client, boffsets[vnum]));
+  VINEYARD_SUPPRESS(encoded->Shrink(client, encoded_size));
   VY_OK_OR_RAISE(FixedUInt8Builder::Make(client, std::move(encoded),
-                                         boffsets[vnum], ce_lists));
+                                         encoded_size, ce_lists));
 
   // release the original id lists, note that the e_offsets is still needed
   e_lists.reset();
@@ -823,7 +1294,7 @@ boost::leaf::result<void> varint_encoding_edges(
         ie_boffsets_lists,
     std::vector<std::vector<std::shared_ptr<FixedInt64Builder>>>&
         oe_boffsets_lists,
-    const int concurrency) {
+    const CompactEdgesCodec codec, const int concurrency) {
   compact_oe_lists.resize(vertex_label_num);
   oe_boffsets_lists.resize(vertex_label_num);
   if (directed) {
@@ -844,13 +1315,13 @@ boost::leaf::result<void> varint_encoding_edges(
           client, oe_lists[v_label][e_label],
           compact_oe_lists[v_label][e_label],
           oe_offsets_lists[v_label][e_label],
-          oe_boffsets_lists[v_label][e_label], concurrency));
+          oe_boffsets_lists[v_label][e_label], codec, concurrency));
       if (directed) {
         BOOST_LEAF_CHECK(varint_encoding_edges_impl(
             client, ie_lists[v_label][e_label],
             compact_ie_lists[v_label][e_label],
             ie_offsets_lists[v_label][e_label],
-            ie_boffsets_lists[v_label][e_label], concurrency));
+            ie_boffsets_lists[v_label][e_label], codec, concurrency));
       }
     }
   }
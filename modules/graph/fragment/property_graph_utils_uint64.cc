@@ -39,6 +39,21 @@ template boost::leaf::result<void> generate_local_id_list<uint64_t>(
     std::vector<std::shared_ptr<ArrowArrayType<uint64_t>>>& lid_list,
     arrow::MemoryPool* pool);
 
+template void generate_degree_order<uint64_t>(
+    const IdParser<uint64_t>& parser, fid_t fid,
+    property_graph_types::LABEL_ID_TYPE vertex_label_num,
+    const std::vector<uint64_t>& ivnums,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& srcs,
+    const std::vector<std::shared_ptr<arrow::ChunkedArray>>& dsts,
+    int concurrency, std::vector<std::shared_ptr<arrow::Int64Array>>& orders,
+    std::vector<std::vector<uint64_t>>& inverse_orders);
+
+template boost::leaf::result<void> reorder_inner_vertex_ids<uint64_t>(
+    const IdParser<uint64_t>& parser,
+    const std::vector<std::vector<std::vector<uint64_t>>>& inverse_orders,
+    int concurrency,
+    std::shared_ptr<arrow::ChunkedArray>& gid_list, arrow::MemoryPool* pool);
+
 template void sort_edges_with_respect_to_vertex<uint64_t, uint64_t>(
     vineyard::PodArrayBuilder<
         property_graph_utils::NbrUnit<uint64_t, uint64_t>>& builder,
@@ -97,6 +112,23 @@ generate_undirected_csr_memopt<uint64_t, uint64_t>(
     std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
     bool& is_multigraph);
 
+template boost::leaf::result<void> append_edges_to_csr<uint64_t, uint64_t>(
+    Client& client, IdParser<uint64_t>& parser,
+    const std::vector<std::shared_ptr<ArrowArrayType<uint64_t>>>& src_chunks,
+    const std::vector<std::shared_ptr<ArrowArrayType<uint64_t>>>& dst_chunks,
+    const uint64_t eid_base, const bool undirected,
+    const std::vector<
+        const property_graph_utils::NbrUnit<uint64_t, uint64_t>*>& base_edges,
+    const std::vector<const int64_t*>& base_edge_offsets,
+    const std::vector<uint64_t>& base_tvnums,
+    const std::vector<uint64_t>& tvnums,
+    int vertex_label_num, int concurrency,
+    std::vector<std::shared_ptr<
+        PodArrayBuilder<property_graph_utils::NbrUnit<uint64_t, uint64_t>>>>&
+        edges,
+    std::vector<std::shared_ptr<FixedInt64Builder>>& edge_offsets,
+    bool& is_multigraph);
+
 template boost::leaf::result<void> varint_encoding_edges<uint64_t, uint64_t>(
     Client& client, const bool directed,
     const property_graph_types::LABEL_ID_TYPE vertex_label_num,
@@ -119,6 +151,6 @@ template boost::leaf::result<void> varint_encoding_edges<uint64_t, uint64_t>(
         ie_boffsets_lists,
     std::vector<std::vector<std::shared_ptr<FixedInt64Builder>>>&
         oe_boffsets_lists,
-    const int concurrency);
+    const CompactEdgesCodec codec, const int concurrency);
 
 }  // namespace vineyard
@@ -496,6 +496,27 @@ Status ReadTableFromLocation(const std::string& location,
   return Status::OK();
 }
 
+Status ReadTableStreamFromLocation(
+    const std::string& location,
+    std::shared_ptr<arrow::RecordBatchReader>& reader,
+    std::shared_ptr<IIOAdaptor>& adaptor, int index, int total_parts,
+    size_t block_size) {
+  std::string expanded = vineyard::ExpandEnvironmentVariables(location);
+  std::shared_ptr<IIOAdaptor> io_adaptor =
+      vineyard::IOFactory::CreateIOAdaptor(expanded);
+  VINEYARD_ASSERT(io_adaptor != nullptr,
+                  "Cannot find a supported adaptor for " + location);
+  if (block_size > 0) {
+    RETURN_ON_ERROR(
+        io_adaptor->Configure("block_size", std::to_string(block_size)));
+  }
+  RETURN_ON_ERROR(io_adaptor->SetPartialRead(index, total_parts));
+  RETURN_ON_ERROR(io_adaptor->Open());
+  RETURN_ON_ERROR(io_adaptor->ReadTableStream(&reader));
+  adaptor = io_adaptor;
+  return Status::OK();
+}
+
 boost::leaf::result<std::pair<table_vec_t, std::vector<table_vec_t>>>
 DataLoader::LoadVertexEdgeTables() {
   BOOST_LEAF_AUTO(v_tables, LoadVertexTables());
@@ -689,6 +710,129 @@ DataLoader::loadEdgeTables(const std::vector<std::string>& files, int index,
   return tables;
 }
 
+boost::leaf::result<std::vector<std::vector<std::shared_ptr<ITablePipeline>>>>
+DataLoader::loadVertexTablePipelines(const std::vector<std::string>& files,
+                                     int index, int total_parts,
+                                     size_t block_size) {
+  return loadTablePipelines(files, index, total_parts, block_size, false);
+}
+
+boost::leaf::result<std::vector<std::vector<std::shared_ptr<ITablePipeline>>>>
+DataLoader::loadEdgeTablePipelines(const std::vector<std::string>& files,
+                                   int index, int total_parts,
+                                   size_t block_size) {
+  return loadTablePipelines(files, index, total_parts, block_size, true);
+}
+
+boost::leaf::result<std::vector<std::vector<std::shared_ptr<ITablePipeline>>>>
+DataLoader::loadTablePipelines(const std::vector<std::string>& files,
+                               int index, int total_parts, size_t block_size,
+                               const bool is_edge) {
+  auto label_num = static_cast<label_id_t>(files.size());
+  std::vector<std::vector<std::shared_ptr<ITablePipeline>>> pipelines(
+      label_num);
+
+  // the stream, or the whole table if the source cannot be streamed
+  struct source_t {
+    std::shared_ptr<arrow::RecordBatchReader> reader;
+    std::shared_ptr<IIOAdaptor> adaptor;
+    std::shared_ptr<arrow::Table> table;
+    std::shared_ptr<arrow::Schema> schema;
+  };
+
+  try {
+    auto open_procedure = [&](label_id_t label_id,
+                              std::string sub_label_file_name)
+        -> boost::leaf::result<source_t> {
+      source_t source;
+      if (files[label_id].rfind("vineyard://", 0) == 0) {
+        BOOST_LEAF_AUTO(sourceId,
+                        resolveVineyardObject(files[label_id].substr(11)));
+        VY_OK_OR_RAISE(ReadTableFromVineyard(client_, sourceId, source.table,
+                                             index, total_parts));
+      } else {
+        auto status = ReadTableStreamFromLocation(
+            sub_label_file_name, source.reader, source.adaptor, index,
+            total_parts, block_size);
+        if (status.IsNotImplemented()) {
+          source.adaptor = nullptr;
+          VY_OK_OR_RAISE(ReadTableFromLocation(sub_label_file_name,
+                                               source.table, index,
+                                               total_parts));
+        } else {
+          VY_OK_OR_RAISE(status);
+        }
+      }
+      if (source.table != nullptr && source.table->num_rows() != 0) {
+        source.schema = source.table->schema();
+      } else if (source.reader != nullptr) {
+        // merge the metadata of the io adaptor, as `ReadTableFromLocation`
+        auto meta = std::make_shared<arrow::KeyValueMetadata>();
+        for (auto const& item : source.adaptor->GetMeta()) {
+          VINEYARD_DISCARD(meta->Set(item.first, item.second));
+        }
+        source.schema = source.reader->schema()->WithMetadata(meta);
+      }
+      return source;
+    };
+
+    for (label_id_t label_id = 0; label_id < label_num; ++label_id) {
+      std::vector<std::string> sub_label_files;
+      boost::split(sub_label_files, files[label_id], boost::is_any_of(";"));
+      for (size_t j = 0; j < sub_label_files.size(); ++j) {
+        BOOST_LEAF_AUTO(source, sync_gs_error(comm_spec_, open_procedure,
+                                              label_id, sub_label_files[j]));
+        // normailize the schema of this distributed stream
+        auto sync_schema_procedure =
+            [&]() -> boost::leaf::result<std::shared_ptr<arrow::Schema>> {
+          return SyncSchema(source.schema, comm_spec_);
+        };
+        BOOST_LEAF_AUTO(schema,
+                        sync_gs_error(comm_spec_, sync_schema_procedure));
+        if (schema == nullptr) {
+          continue;  // empty on all workers
+        }
+
+        auto meta = schema->metadata();
+        if (meta == nullptr || meta->FindKey(LABEL_TAG) == -1) {
+          RETURN_GS_ERROR(ErrorCode::kIOError,
+                          std::string("Metadata of input ") +
+                              (is_edge ? "edge" : "vertex") +
+                              " files should contain label name");
+        }
+        if (is_edge && meta->FindKey(SRC_LABEL_TAG) == -1) {
+          RETURN_GS_ERROR(
+              ErrorCode::kIOError,
+              "Metadata of input edge files should contain src label name");
+        }
+        if (is_edge && meta->FindKey(DST_LABEL_TAG) == -1) {
+          RETURN_GS_ERROR(
+              ErrorCode::kIOError,
+              "Metadata of input edge files should contain dst label name");
+        }
+
+        std::shared_ptr<ITablePipeline> pipeline;
+        if (source.reader != nullptr) {
+          pipeline = std::make_shared<RecordBatchReaderPipeline>(
+              source.reader, schema, source.adaptor);
+        } else {
+          std::shared_ptr<arrow::Table> table;
+          if (source.schema == nullptr) {
+            VY_OK_OR_RAISE(EmptyTableBuilder::Build(schema, table));
+          } else {
+            VY_OK_OR_RAISE(CastTableToSchema(source.table, schema, table));
+          }
+          pipeline = std::make_shared<TablePipeline>(table);
+        }
+        pipelines[label_id].emplace_back(pipeline);
+      }
+    }
+  } catch (std::exception& e) {
+    RETURN_GS_ERROR(ErrorCode::kIOError, std::string(e.what()));
+  }
+  return pipelines;
+}
+
 boost::leaf::result<void> DataLoader::sanityChecks(
     std::shared_ptr<arrow::Table> table) {
   // We require that there are no identical column names
@@ -42,6 +42,7 @@ limitations under the License.
 #include "graph/fragment/property_graph_types.h"
 #include "graph/loader/basic_ev_fragment_loader.h"
 #include "graph/utils/partitioner.h"
+#include "graph/utils/table_pipeline.h"
 #include "graph/vertex_map/arrow_vertex_map.h"
 
 #define HASH_PARTITION
@@ -97,6 +98,19 @@ Status ReadTableFromLocation(const std::string& location,
                              std::shared_ptr<arrow::Table>& table, int index,
                              int total_parts);
 
+/**
+ * @brief Open the part of the location as a stream of record batches, which
+ * are read with `block_size` (if not zero) bytes each. The `adaptor` must be
+ * kept alive until the stream is drained.
+ *
+ * When the part is empty, the result `reader` will be set as nullptr.
+ */
+Status ReadTableStreamFromLocation(
+    const std::string& location,
+    std::shared_ptr<arrow::RecordBatchReader>& reader,
+    std::shared_ptr<IIOAdaptor>& adaptor, int index, int total_parts,
+    size_t block_size = 0);
+
 /** Note [GatherETables and GatherVTables]
  *
  * GatherETables and GatherVTables gathers all edges and vertices as table from
@@ -197,6 +211,21 @@ class DataLoader {
   loadEdgeTables(const std::vector<std::string>& files, int index,
                  int total_parts);
 
+  /// Like `loadVertexTables`, but the vertices are parsed when the pipelines
+  /// are pulled, `block_size` bytes at a time, and the files of a label are
+  /// not concatenated.
+  boost::leaf::result<
+      std::vector<std::vector<std::shared_ptr<ITablePipeline>>>>
+  loadVertexTablePipelines(const std::vector<std::string>& files, int index,
+                           int total_parts, size_t block_size);
+
+  /// Like `loadEdgeTables`, but the edges are parsed when the pipelines are
+  /// pulled, `block_size` bytes at a time.
+  boost::leaf::result<
+      std::vector<std::vector<std::shared_ptr<ITablePipeline>>>>
+  loadEdgeTablePipelines(const std::vector<std::string>& files, int index,
+                         int total_parts, size_t block_size);
+
   /// Do some necessary sanity checks.
   boost::leaf::result<void> sanityChecks(std::shared_ptr<arrow::Table> table);
 
@@ -214,10 +243,34 @@ class DataLoader {
     VINEYARD_DISCARD(adaptor->Close());
     delete adaptor;
   };
+
+ private:
+  boost::leaf::result<
+      std::vector<std::vector<std::shared_ptr<ITablePipeline>>>>
+  loadTablePipelines(const std::vector<std::string>& files, int index,
+                     int total_parts, size_t block_size, const bool is_edge);
 };
 
+#ifdef HASH_PARTITION
+template <typename OID_T>
+using DefaultPartitioner = HashPartitioner<OID_T>;
+#else
+template <typename OID_T>
+using DefaultPartitioner = SegmentedPartitioner<OID_T>;
+#endif
+
+/**
+ * @brief The partitioner can be one of `HashPartitioner`,
+ * `SegmentedPartitioner` and `FennelPartitioner`. The latter two read the
+ * whole vertex (and edge, for fennel) files to decide the partitions before
+ * loading. The segmented partitioner reads the vertex files on every worker,
+ * while the fennel partitioner streams the files block by block on the first
+ * worker, which keeps an index of the whole graph in memory, and broadcasts
+ * the assignment of the vertices to other workers.
+ */
 template <typename OID_T = property_graph_types::OID_TYPE,
-          typename VID_T = property_graph_types::VID_TYPE>
+          typename VID_T = property_graph_types::VID_TYPE,
+          typename PARTITIONER_T = DefaultPartitioner<OID_T>>
 class ArrowFragmentLoader : public DataLoader {
  public:
   using oid_t = OID_T;
@@ -233,11 +286,7 @@ class ArrowFragmentLoader : public DataLoader {
   using oid_array_vec_t = std::vector<std::shared_ptr<oid_array_t>>;
   using vid_array_vec_t = std::vector<std::shared_ptr<vid_array_t>>;
 
-#ifdef HASH_PARTITION
-  using partitioner_t = HashPartitioner<oid_t>;
-#else
-  using partitioner_t = SegmentedPartitioner<oid_t>;
-#endif
+  using partitioner_t = PARTITIONER_T;
 
   using basic_fragment_loader_t =
       BasicEVFragmentLoader<OID_T, VID_T, partitioner_t>;
@@ -252,6 +301,11 @@ class ArrowFragmentLoader : public DataLoader {
 
   static constexpr int id_column = 0;
 
+  // the raw blocks queued by the background reader of arrow's CSV streaming
+  // reader (`arrow::MakeBackgroundGenerator`), which cannot be configured
+  static constexpr size_t csv_io_readahead_blocks = 32;
+  static constexpr size_t minimum_block_size = 64 * 1024;
+
   using vertex_table_info_t =
       std::map<std::string, std::shared_ptr<arrow::Table>>;
   using edge_table_info_t = std::vector<InputTable>;
@@ -373,9 +427,82 @@ class ArrowFragmentLoader : public DataLoader {
   using DataLoader::LoadVertexEdgeTables;
   using DataLoader::LoadVertexTables;
 
+  /**
+   * @brief Load the edge files in the streaming mode: edges are parsed,
+   * shuffled, and resolved to gids block by block rather than as whole
+   * tables, and the received edges are spilled to files under `spill_dir`
+   * once exceeding `memory_budget` bytes.
+   *
+   * Vertices are still loaded as tables, and edges whose vertex labels are
+   * not given by vertex files are not supported in this mode. The index kept
+   * by the `FennelPartitioner` is not bounded by the budget either.
+   *
+   * 0 means unlimited, which is the default, and disables the streaming mode.
+   */
+  void set_memory_budget(size_t memory_budget,
+                         const std::string& spill_dir = "") {
+    memory_budget_ = memory_budget;
+    spill_dir_ = spill_dir;
+  }
+
+  /**
+   * @brief The number of files the received edges of this worker have been
+   * spilled to by the last load in the streaming mode.
+   */
+  size_t spilled_files() const { return spilled_files_; }
+
+  /**
+   * @brief Renumber the inner vertices of every fragment by their degrees,
+   * see also `BasicArrowFragmentBuilder::set_reorder_vertices()`.
+   */
+  void set_reorder_vertices(const bool reorder_vertices) {
+    reorder_vertices_ = reorder_vertices;
+  }
+
+  /**
+   * @brief Keep the string oids of the vertex map compressed, see also
+   * `BasicArrowVertexMapBuilder::set_compress_oids()`.
+   */
+  void set_compress_oids(const bool compress_oids) {
+    compress_oids_ = compress_oids;
+  }
+
+  /**
+   * @brief The partitioner, e.g., to set the options of a `FennelPartitioner`
+   * before loading.
+   *
+   * Note that the partitioner is initialized from the input files of each
+   * load, thus a fragment partitioned by the `FennelPartitioner` cannot be
+   * extended consistently, and `AddLabelsToFragment()` and the alike return
+   * an error with the `FennelPartitioner`.
+   */
+  partitioner_t& partitioner() { return partitioner_; }
+
  protected:  // for subclasses
   boost::leaf::result<void> initPartitioner();
 
+  template <typename T>
+  boost::leaf::result<void> initPartitioner(HashPartitioner<T>& partitioner);
+
+  template <typename T>
+  boost::leaf::result<void> initPartitioner(
+      SegmentedPartitioner<T>& partitioner);
+
+  template <typename T>
+  boost::leaf::result<void> initPartitioner(FennelPartitioner<T>& partitioner);
+
+  // initialize the partitioner for extending an existing fragment
+  boost::leaf::result<void> initPartitionerForExtension();
+
+  template <typename T>
+  boost::leaf::result<void> initPartitionerForExtension(T& partitioner);
+
+  template <typename T>
+  boost::leaf::result<void> initPartitionerForExtension(
+      FennelPartitioner<T>& partitioner);
+
+  boost::leaf::result<ObjectID> loadFragmentStreaming();
+
   boost::leaf::result<std::pair<vertex_table_info_t, edge_table_info_t>>
   preprocessInputs(
       const std::vector<std::shared_ptr<arrow::Table>>& v_tables,
@@ -387,7 +514,9 @@ class ArrowFragmentLoader : public DataLoader {
       vineyard::ObjectID frag_id,
       std::pair<table_vec_t, std::vector<table_vec_t>> raw_v_e_tables);
 
+  using DataLoader::loadEdgeTablePipelines;
   using DataLoader::loadEdgeTables;
+  using DataLoader::loadVertexTablePipelines;
   using DataLoader::loadVertexTables;
   using DataLoader::resolveVineyardObject;
   using DataLoader::sanityChecks;
@@ -403,6 +532,11 @@ class ArrowFragmentLoader : public DataLoader {
   bool local_vertex_map_ = false;
   bool compact_edges_ = false;
   bool use_perfect_hash_ = false;
+  size_t memory_budget_ = 0;
+  std::string spill_dir_;
+  size_t spilled_files_ = 0;
+  bool reorder_vertices_ = false;
+  bool compress_oids_ = false;
 
   std::function<void(IIOAdaptor*)> io_deleter_ = [](IIOAdaptor* adaptor) {
     VINEYARD_DISCARD(adaptor->Close());
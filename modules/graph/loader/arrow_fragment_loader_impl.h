@@ -22,12 +22,14 @@ limitations under the License.
 #include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
+#include "arrow/util/thread_pool.h"
 
 #include "common/util/uuid.h"
 #include "grape/worker/comm_spec.h"
@@ -46,9 +48,12 @@ limitations under the License.
 
 namespace vineyard {
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::LoadFragment() {
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::LoadFragment() {
+  if (memory_budget_ > 0 && !efiles_.empty()) {
+    return loadFragmentStreaming();
+  }
   BOOST_LEAF_CHECK(initPartitioner());
   BOOST_LEAF_AUTO(raw_v_e_tables, LoadVertexEdgeTables());
   VLOG(100) << "[worker-" << comm_spec_.worker_id()
@@ -57,8 +62,9 @@ ArrowFragmentLoader<OID_T, VID_T>::LoadFragment() {
   return LoadFragment(std::move(raw_v_e_tables));
 }
 
-template <typename OID_T, typename VID_T>
-boost::leaf::result<ObjectID> ArrowFragmentLoader<OID_T, VID_T>::LoadFragment(
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+boost::leaf::result<ObjectID>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::LoadFragment(
     const std::vector<std::string>& efiles,
     const std::vector<std::string>& vfiles) {
   this->efiles_ = efiles;
@@ -66,8 +72,9 @@ boost::leaf::result<ObjectID> ArrowFragmentLoader<OID_T, VID_T>::LoadFragment(
   return this->LoadFragment();
 }
 
-template <typename OID_T, typename VID_T>
-boost::leaf::result<ObjectID> ArrowFragmentLoader<OID_T, VID_T>::LoadFragment(
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+boost::leaf::result<ObjectID>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::LoadFragment(
     std::pair<table_vec_t, std::vector<table_vec_t>> raw_v_e_tables) {
   auto& partial_v_tables = raw_v_e_tables.first;
   auto& partial_e_tables = raw_v_e_tables.second;
@@ -89,6 +96,8 @@ boost::leaf::result<ObjectID> ArrowFragmentLoader<OID_T, VID_T>::LoadFragment(
   auto basic_fragment_loader = std::make_shared<basic_fragment_loader_t>(
       client_, comm_spec_, partitioner_, directed_, generate_eid_, retain_oid_,
       local_vertex_map_, compact_edges_, use_perfect_hash_);
+  basic_fragment_loader->set_reorder_vertices(reorder_vertices_);
+  basic_fragment_loader->set_compress_oids(compress_oids_);
 
   LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "CONSTRUCT-VERTEX-0";
   for (auto const& pair : vertex_tables_with_label) {
@@ -130,9 +139,113 @@ boost::leaf::result<ObjectID> ArrowFragmentLoader<OID_T, VID_T>::LoadFragment(
   return basic_fragment_loader->ConstructFragment();
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::LoadFragmentAsFragmentGroup() {
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::loadFragmentStreaming() {
+  BOOST_LEAF_CHECK(initPartitioner());
+  BOOST_LEAF_AUTO(partial_v_tables, LoadVertexTables());
+
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "PROCESS-INPUTS-0";
+  BOOST_LEAF_AUTO(v_e_tables, preprocessInputs(partial_v_tables, {}));
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "PROCESS-INPUTS-100";
+  partial_v_tables.clear();
+
+  auto& vertex_tables_with_label = v_e_tables.first;
+
+  auto basic_fragment_loader = std::make_shared<basic_fragment_loader_t>(
+      client_, comm_spec_, partitioner_, directed_, generate_eid_, retain_oid_,
+      local_vertex_map_, compact_edges_, use_perfect_hash_);
+  basic_fragment_loader->set_memory_budget(memory_budget_, spill_dir_);
+  basic_fragment_loader->set_reorder_vertices(reorder_vertices_);
+  basic_fragment_loader->set_compress_oids(compress_oids_);
+
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "CONSTRUCT-VERTEX-0";
+  for (auto const& pair : vertex_tables_with_label) {
+    BOOST_LEAF_CHECK(
+        basic_fragment_loader->AddVertexTable(pair.first, pair.second));
+  }
+  vertex_tables_with_label.clear();
+
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "CONSTRUCT-VERTEX-50";
+  BOOST_LEAF_CHECK(basic_fragment_loader->ConstructVertices());
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "CONSTRUCT-VERTEX-100";
+  VLOG(100) << "[worker-" << comm_spec_.worker_id()
+            << "] RSS after constructing vertices: " << get_rss_pretty()
+            << ", peak = " << get_peak_rss_pretty();
+
+  // each of the parsing threads holds a block (and the parsed batch), and
+  // arrow's CSV reader reads ahead on its own: every opened file queues up
+  // to `csv_io_readahead_blocks` raw blocks on the IO pool, and up to one
+  // block per thread of the CPU pool is parsed ahead. The blocks in flight
+  // use a half of the budget.
+  size_t concurrency = std::max<size_t>(
+      1, std::thread::hardware_concurrency() / comm_spec_.local_num());
+  size_t inflight_blocks = concurrency +
+                           efiles_.size() * csv_io_readahead_blocks +
+                           arrow::GetCpuThreadPoolCapacity();
+  size_t block_size = std::min<size_t>(
+      128 * 1024 * 1024, memory_budget_ / (2 * inflight_blocks));
+  if (block_size < minimum_block_size) {
+    block_size = minimum_block_size;
+    LOG_IF(WARNING, !comm_spec_.worker_id())
+        << "The memory budget is too small for the readahead of "
+        << inflight_blocks << " blocks of the CSV reader, the blocks in "
+        << "flight may take "
+        << prettyprint_memory_size(block_size * inflight_blocks);
+  }
+
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "READ-EDGE-0";
+  auto load_e_procedure = [&]() {
+    return loadEdgeTablePipelines(efiles_, comm_spec_.local_id(),
+                                  comm_spec_.local_num(), block_size);
+  };
+  BOOST_LEAF_AUTO(e_pipelines, sync_gs_error(comm_spec_, load_e_procedure));
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "READ-EDGE-100";
+
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "CONSTRUCT-EDGE-0";
+  auto vertex_label_to_index =
+      basic_fragment_loader->get_vertex_label_to_index();
+  for (auto const& pipelines : e_pipelines) {
+    for (auto const& pipeline : pipelines) {
+      std::shared_ptr<arrow::Table> empty_table;
+      VY_OK_OR_RAISE(EmptyTableBuilder::Build(pipeline->schema(), empty_table));
+      BOOST_LEAF_CHECK(sanityChecks(empty_table));
+
+      auto meta = pipeline->schema()->metadata();
+      std::string label_name = meta->value(meta->FindKey(LABEL_TAG));
+      std::string src_label_name = meta->value(meta->FindKey(SRC_LABEL_TAG));
+      std::string dst_label_name = meta->value(meta->FindKey(DST_LABEL_TAG));
+      for (auto const& name : {src_label_name, dst_label_name}) {
+        if (vertex_label_to_index.find(name) == vertex_label_to_index.end()) {
+          RETURN_GS_ERROR(ErrorCode::kInvalidValueError,
+                          "Vertex label '" + name +
+                              "' cannot be deduced from edges when loading "
+                              "with a memory budget, please specify the "
+                              "vertex file");
+        }
+      }
+      BOOST_LEAF_CHECK(basic_fragment_loader->AddEdgeTable(
+          src_label_name, dst_label_name, label_name, pipeline));
+    }
+  }
+  e_pipelines.clear();
+
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "CONSTRUCT-EDGE-50";
+  BOOST_LEAF_CHECK(basic_fragment_loader->ConstructEdges());
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "CONSTRUCT-EDGE-100";
+  VLOG(100) << "[worker-" << comm_spec_.worker_id()
+            << "] RSS after constructing edges: " << get_rss_pretty()
+            << ", peak = " << get_peak_rss_pretty();
+  spilled_files_ = basic_fragment_loader->spilled_files();
+
+  LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "SEAL-0";
+  return basic_fragment_loader->ConstructFragment();
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+boost::leaf::result<ObjectID>
+ArrowFragmentLoader<OID_T, VID_T,
+                    PARTITIONER_T>::LoadFragmentAsFragmentGroup() {
   BOOST_LEAF_AUTO(frag_id, LoadFragment());
 
   // ensure the fragment exists and is an arrow fragment.
@@ -148,11 +261,26 @@ ArrowFragmentLoader<OID_T, VID_T>::LoadFragmentAsFragmentGroup() {
   return group_id;
 }
 
-template <typename OID_T, typename VID_T>
-boost::leaf::result<void> ArrowFragmentLoader<OID_T, VID_T>::initPartitioner() {
-#ifdef HASH_PARTITION
-  partitioner_.Init(comm_spec_.fnum());
-#else
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+boost::leaf::result<void>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::initPartitioner() {
+  return initPartitioner(partitioner_);
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+template <typename T>
+boost::leaf::result<void>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::initPartitioner(
+    HashPartitioner<T>& partitioner) {
+  partitioner.Init(comm_spec_.fnum());
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+template <typename T>
+boost::leaf::result<void>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::initPartitioner(
+    SegmentedPartitioner<T>& partitioner) {
   if (vfiles_.empty()) {
     RETURN_GS_ERROR(ErrorCode::kInvalidOperationError,
                     "Segmented partitioner is not supported when the v-file is "
@@ -181,14 +309,166 @@ boost::leaf::result<void> ArrowFragmentLoader<OID_T, VID_T>::initPartitioner() {
     }
   }
 
-  partitioner_.Init(comm_spec_.fnum(), oid_list);
-#endif
+  partitioner.Init(comm_spec_.fnum(), oid_list);
+  return {};
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+template <typename T>
+boost::leaf::result<void>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::initPartitioner(
+    FennelPartitioner<T>& partitioner) {
+  if (efiles_.empty()) {
+    RETURN_GS_ERROR(ErrorCode::kInvalidOperationError,
+                    "Fennel partitioner is not supported when the e-file is "
+                    "not provided");
+  }
+  if (memory_budget_ > 0) {
+    LOG_IF(WARNING, !comm_spec_.worker_id())
+        << "The Fennel partitioner keeps an index of all vertices and edges "
+           "in memory on the first worker, and the assignment of all "
+           "vertices on every worker, which are not bounded by the memory "
+           "budget";
+  }
+  partitioner.Init(comm_spec_.fnum());
+
+  // the pre-pass streams the whole graph on the first worker only, and only
+  // one block of the inputs is parsed at a time, then the assignment of the
+  // vertices is broadcast, thus the edges are not replicated on every worker.
+  //
+  // n.b.: the pipelines are opened on every worker, as opening them syncs the
+  // schemas among workers, but are only drained on the first worker.
+  const bool is_root = comm_spec_.worker_id() == 0;
+  size_t block_size = 64 * 1024 * 1024;
+  if (memory_budget_ > 0) {
+    block_size = std::min<size_t>(
+        block_size, std::max<size_t>(1024 * 1024, memory_budget_ / 2));
+  }
+  auto as_oid_array =
+      [](const std::shared_ptr<arrow::Array>& column,
+         std::shared_ptr<oid_array_t>& array) -> boost::leaf::result<void> {
+    array = std::dynamic_pointer_cast<oid_array_t>(column);
+    if (array == nullptr) {
+      RETURN_GS_ERROR(ErrorCode::kDataTypeError,
+                      "Unexpected type of the vertex id column: " +
+                          column->type()->ToString());
+    }
+    return {};
+  };
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  std::shared_ptr<oid_array_t> oids, srcs, dsts;
+  {
+    auto load_v_procedure = [&]() {
+      return loadVertexTablePipelines(vfiles_, 0, 1, block_size);
+    };
+    BOOST_LEAF_AUTO(v_pipelines, sync_gs_error(comm_spec_, load_v_procedure));
+    auto add_v_procedure = [&]() -> boost::leaf::result<std::nullptr_t> {
+      for (auto const& pipelines : v_pipelines) {
+        for (auto const& pipeline : pipelines) {
+          while (is_root) {
+            auto status = pipeline->Next(batch);
+            if (status.IsStreamDrained()) {
+              break;
+            }
+            VY_OK_OR_RAISE(status);
+            BOOST_LEAF_CHECK(as_oid_array(batch->column(id_column), oids));
+            for (int64_t i = 0; i < oids->length(); ++i) {
+              partitioner.AddVertex(oids->GetView(i));
+            }
+          }
+        }
+      }
+      return nullptr;
+    };
+    BOOST_LEAF_CHECK(sync_gs_error(comm_spec_, add_v_procedure));
+  }
+  {
+    auto load_e_procedure = [&]() {
+      return loadEdgeTablePipelines(efiles_, 0, 1, block_size);
+    };
+    BOOST_LEAF_AUTO(e_pipelines, sync_gs_error(comm_spec_, load_e_procedure));
+    auto add_e_procedure = [&]() -> boost::leaf::result<std::nullptr_t> {
+      for (auto const& pipelines : e_pipelines) {
+        for (auto const& pipeline : pipelines) {
+          while (is_root) {
+            auto status = pipeline->Next(batch);
+            if (status.IsStreamDrained()) {
+              break;
+            }
+            VY_OK_OR_RAISE(status);
+            BOOST_LEAF_CHECK(as_oid_array(batch->column(0), srcs));
+            BOOST_LEAF_CHECK(as_oid_array(batch->column(1), dsts));
+            for (int64_t i = 0; i < srcs->length(); ++i) {
+              partitioner.AddEdge(srcs->GetView(i), dsts->GetView(i));
+            }
+          }
+        }
+      }
+      return nullptr;
+    };
+    BOOST_LEAF_CHECK(sync_gs_error(comm_spec_, add_e_procedure));
+  }
+  batch = nullptr;
+  oids = srcs = dsts = nullptr;
+
+  // broadcast the assignment, in pieces, as the size may exceed `int`
+  {
+    grape::InArchive ia;
+    if (is_root) {
+      partitioner.Finalize();
+      partitioner.SerializeAssignment(ia);
+    }
+    size_t size = ia.GetSize();
+    MPI_Bcast(&size, sizeof(size_t), MPI_CHAR, 0, comm_spec_.comm());
+    grape::OutArchive oa(is_root ? 0 : size);
+    char* buffer = is_root ? ia.GetBuffer() : oa.GetBuffer();
+    const size_t piece = static_cast<size_t>(1) << 30;
+    for (size_t offset = 0; offset < size; offset += piece) {
+      size_t count = std::min(piece, size - offset);
+      MPI_Bcast(buffer + offset, static_cast<int>(count), MPI_CHAR, 0,
+                comm_spec_.comm());
+    }
+    if (!is_root) {
+      partitioner.DeserializeAssignment(oa);
+    }
+  }
+  VLOG(10) << "[worker-" << comm_spec_.worker_id()
+           << "] Fennel partitioner placed " << partitioner.hub_num()
+           << " hub vertices, RSS: " << get_rss_pretty();
   return {};
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+boost::leaf::result<void>
+ArrowFragmentLoader<OID_T, VID_T,
+                    PARTITIONER_T>::initPartitionerForExtension() {
+  return initPartitionerForExtension(partitioner_);
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+template <typename T>
+boost::leaf::result<void>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::initPartitionerForExtension(
+    T& partitioner) {
+  return initPartitioner(partitioner);
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+template <typename T>
+boost::leaf::result<void>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::initPartitionerForExtension(
+    FennelPartitioner<T>& partitioner) {
+  // the assignment would be computed from the new files only, and disagree
+  // with the one that the existing fragment is partitioned by
+  RETURN_GS_ERROR(ErrorCode::kUnsupportedOperationError,
+                  "Fennel partitioner is not supported when extending an "
+                  "existing fragment");
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::LoadFragmentAsFragmentGroup(
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::LoadFragmentAsFragmentGroup(
     const std::vector<std::string>& efiles,
     const std::vector<std::string>& vfiles) {
   this->efiles_ = efiles;
@@ -196,29 +476,29 @@ ArrowFragmentLoader<OID_T, VID_T>::LoadFragmentAsFragmentGroup(
   return this->LoadFragmentAsFragmentGroup();
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<vineyard::ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::AddLabelsToFragment(
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::AddLabelsToFragment(
     vineyard::ObjectID frag_id) {
-  BOOST_LEAF_CHECK(initPartitioner());
+  BOOST_LEAF_CHECK(initPartitionerForExtension());
   BOOST_LEAF_AUTO(raw_v_e_tables, LoadVertexEdgeTables());
   return addVerticesAndEdges(frag_id, raw_v_e_tables);
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<vineyard::ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::AddLabelsToFragmentAsFragmentGroup(
-    vineyard::ObjectID frag_id) {
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::
+    AddLabelsToFragmentAsFragmentGroup(vineyard::ObjectID frag_id) {
   BOOST_LEAF_AUTO(new_frag_id, AddLabelsToFragment(frag_id));
   return vineyard::ConstructFragmentGroup(client_, new_frag_id, comm_spec_);
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<vineyard::ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::AddDataToExistedVLabel(
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::AddDataToExistedVLabel(
     vineyard::ObjectID frag_id, PropertyGraphSchema::LabelId label_id) {
   // first load the vertex table
-  BOOST_LEAF_CHECK(initPartitioner());
+  BOOST_LEAF_CHECK(initPartitionerForExtension());
   std::pair<table_vec_t, std::vector<table_vec_t>> raw_v_e_tables;
   if (vfiles_.empty()) {
     raw_v_e_tables.first = partial_v_tables_;
@@ -228,11 +508,11 @@ ArrowFragmentLoader<OID_T, VID_T>::AddDataToExistedVLabel(
   return addDataToExistedVLabel(frag_id, label_id, raw_v_e_tables);
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<vineyard::ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::AddDataToExistedELabel(
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::AddDataToExistedELabel(
     vineyard::ObjectID frag_id, PropertyGraphSchema::LabelId label_id) {
-  BOOST_LEAF_CHECK(initPartitioner());
+  BOOST_LEAF_CHECK(initPartitionerForExtension());
   std::pair<table_vec_t, std::vector<table_vec_t>> raw_v_e_tables;
   if (efiles_.empty()) {
     raw_v_e_tables.second = partial_e_tables_;
@@ -242,9 +522,9 @@ ArrowFragmentLoader<OID_T, VID_T>::AddDataToExistedELabel(
   return addDataToExistedELabel(frag_id, label_id, raw_v_e_tables);
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<vineyard::ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::addDataToExistedVLabel(
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::addDataToExistedVLabel(
     vineyard::ObjectID frag_id, PropertyGraphSchema::LabelId label_id,
     std::pair<table_vec_t, std::vector<table_vec_t>> raw_v_e_tables) {
   auto& partial_v_tables = raw_v_e_tables.first;
@@ -254,7 +534,7 @@ ArrowFragmentLoader<OID_T, VID_T>::addDataToExistedVLabel(
 
   LOG_IF(INFO, !comm_spec_.worker_id()) << MARKER << "PROCESS-INPUTS-0";
 
-  ArrowFragmentLoader<OID_T, VID_T>::vertex_table_info_t
+  ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::vertex_table_info_t
       vertex_tables_with_label;
   // get vertex_tables_with_label
   for (auto table : partial_v_tables) {
@@ -310,9 +590,9 @@ ArrowFragmentLoader<OID_T, VID_T>::addDataToExistedVLabel(
                                                                  label_id);
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<vineyard::ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::addDataToExistedELabel(
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::addDataToExistedELabel(
     vineyard::ObjectID frag_id, PropertyGraphSchema::LabelId label_id,
     std::pair<table_vec_t, std::vector<table_vec_t>> raw_v_e_tables) {
   auto& partial_v_tables = raw_v_e_tables.first;
@@ -378,10 +658,10 @@ ArrowFragmentLoader<OID_T, VID_T>::addDataToExistedELabel(
   } else {
     basic_fragment_loader->set_vm_ptr(vm_id);
   }
+  // the generated edge ids follow the edges in the delta CSR as well
   int edges_num =
       std::dynamic_pointer_cast<vineyard::ArrowFragment<OID_T, VID_T>>(frag)
-          ->edge_data_table(label_id)
-          ->num_rows();
+          ->edge_data_num(label_id);
   BOOST_LEAF_CHECK(basic_fragment_loader->ConstructEdges(
       schema.all_edge_label_num(), schema.all_vertex_label_num(), label_id,
       edges_num));
@@ -394,11 +674,13 @@ ArrowFragmentLoader<OID_T, VID_T>::addDataToExistedELabel(
   return basic_fragment_loader->AddIncrementalEdgesToFragment(frag, label_id);
 }
 
-template <typename OID_T, typename VID_T>
-boost::leaf::result<
-    std::pair<typename ArrowFragmentLoader<OID_T, VID_T>::vertex_table_info_t,
-              typename ArrowFragmentLoader<OID_T, VID_T>::edge_table_info_t>>
-ArrowFragmentLoader<OID_T, VID_T>::preprocessInputs(
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+boost::leaf::result<std::pair<
+    typename ArrowFragmentLoader<OID_T, VID_T,
+                                 PARTITIONER_T>::vertex_table_info_t,
+    typename ArrowFragmentLoader<OID_T, VID_T,
+                                 PARTITIONER_T>::edge_table_info_t>>
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::preprocessInputs(
     const std::vector<std::shared_ptr<arrow::Table>>& v_tables,
     const std::vector<std::vector<std::shared_ptr<arrow::Table>>>& e_tables,
     const std::set<std::string>& previous_vertex_labels) {
@@ -467,9 +749,9 @@ ArrowFragmentLoader<OID_T, VID_T>::preprocessInputs(
   return std::make_pair(vertex_tables_with_label, edge_tables_with_label);
 }
 
-template <typename OID_T, typename VID_T>
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
 boost::leaf::result<vineyard::ObjectID>
-ArrowFragmentLoader<OID_T, VID_T>::addVerticesAndEdges(
+ArrowFragmentLoader<OID_T, VID_T, PARTITIONER_T>::addVerticesAndEdges(
     vineyard::ObjectID frag_id,
     std::pair<table_vec_t, std::vector<table_vec_t>> raw_v_e_tables) {
   // newly added vertex and edge tables
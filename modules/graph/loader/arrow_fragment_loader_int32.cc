@@ -21,4 +21,10 @@ template class ArrowFragmentLoader<int32_t, uint32_t>;
 
 template class ArrowFragmentLoader<int32_t, uint64_t>;
 
+template class ArrowFragmentLoader<int32_t, uint32_t,
+                                   FennelPartitioner<int32_t>>;
+
+template class ArrowFragmentLoader<int32_t, uint64_t,
+                                   FennelPartitioner<int32_t>>;
+
 }  // namespace vineyard
@@ -21,4 +21,10 @@ template class ArrowFragmentLoader<int64_t, uint64_t>;
 
 template class ArrowFragmentLoader<int64_t, uint32_t>;
 
+template class ArrowFragmentLoader<int64_t, uint64_t,
+                                   FennelPartitioner<int64_t>>;
+
+template class ArrowFragmentLoader<int64_t, uint32_t,
+                                   FennelPartitioner<int64_t>>;
+
 }  // namespace vineyard
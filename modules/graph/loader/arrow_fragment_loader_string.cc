@@ -21,4 +21,10 @@ template class ArrowFragmentLoader<std::string, uint64_t>;
 
 template class ArrowFragmentLoader<std::string, uint32_t>;
 
+template class ArrowFragmentLoader<std::string, uint64_t,
+                                   FennelPartitioner<std::string>>;
+
+template class ArrowFragmentLoader<std::string, uint32_t,
+                                   FennelPartitioner<std::string>>;
+
 }  // namespace vineyard
@@ -158,6 +158,50 @@ class BasicEVFragmentLoader {
       const std::string& src_label, const std::string& dst_label,
       const std::string& edge_label, std::shared_ptr<arrow::Table> edge_table);
 
+  /**
+   * @brief Add a stream of edges, whose batches are pulled (e.g., parsed
+   * from files) on demand when constructing edges, with the same schema as
+   * the edge table.
+   */
+  boost::leaf::result<void> AddEdgeTable(
+      const std::string& src_label, const std::string& dst_label,
+      const std::string& edge_label,
+      std::shared_ptr<ITablePipeline> edge_table);
+
+  /**
+   * @brief Bound the memory of the shuffled edges: once the received edges
+   * exceed `memory_budget` bytes, they are spilled to files under
+   * `spill_dir` and memory-mapped back when constructing the fragment.
+   *
+   * 0 means unlimited, which is the default.
+   */
+  void set_memory_budget(size_t memory_budget,
+                         const std::string& spill_dir = "") {
+    memory_budget_ = memory_budget;
+    spill_dir_ = spill_dir;
+  }
+
+  /**
+   * @brief The number of files the received edges have been spilled to.
+   */
+  size_t spilled_files() const { return spilled_files_; }
+
+  /**
+   * @brief Renumber the inner vertices by their degrees when constructing
+   * the fragment, see also `BasicArrowFragmentBuilder::set_reorder_vertices()`.
+   */
+  void set_reorder_vertices(const bool reorder_vertices) {
+    reorder_vertices_ = reorder_vertices;
+  }
+
+  /**
+   * @brief Keep the string oids of the vertex map compressed, see also
+   * `BasicArrowVertexMapBuilder::set_compress_oids()`.
+   */
+  void set_compress_oids(const bool compress_oids) {
+    compress_oids_ = compress_oids;
+  }
+
   boost::leaf::result<void> ConstructEdges(
       int label_offset = 0, int vertex_label_num = 0,
       PropertyGraphSchema::LabelId existed_elabel_id = -1, int eid_offset = 0);
@@ -255,14 +299,20 @@ class BasicEVFragmentLoader {
   bool local_vertex_map_ = false;
   bool compact_edges_ = false;
   bool use_perfect_hash_ = false;
+  size_t memory_budget_ = 0;
+  std::string spill_dir_;
+  size_t spilled_files_ = 0;
+  bool reorder_vertices_ = false;
+  bool compress_oids_ = false;
 
   std::map<std::string, label_id_t> vertex_label_to_index_;
   std::vector<std::string> vertex_labels_;
   std::map<std::string, label_id_t> edge_label_to_index_;
   std::vector<std::string> edge_labels_;
   std::map<std::string, std::shared_ptr<arrow::Table>> input_vertex_tables_;
-  std::map<std::string, std::vector<std::pair<std::pair<label_id_t, label_id_t>,
-                                              std::shared_ptr<arrow::Table>>>>
+  std::map<std::string,
+           std::vector<std::pair<std::pair<label_id_t, label_id_t>,
+                                 std::shared_ptr<ITablePipeline>>>>
       input_edge_tables_;
 
   std::vector<std::shared_ptr<ITablePipeline>> ordered_vertex_tables_;
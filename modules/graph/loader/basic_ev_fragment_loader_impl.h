@@ -179,6 +179,16 @@ boost::leaf::result<void>
 BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::AddEdgeTable(
     const std::string& src_label, const std::string& dst_label,
     const std::string& edge_label, std::shared_ptr<arrow::Table> edge_table) {
+  return AddEdgeTable(src_label, dst_label, edge_label,
+                      std::make_shared<TablePipeline>(edge_table));
+}
+
+template <typename OID_T, typename VID_T, typename PARTITIONER_T>
+boost::leaf::result<void>
+BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::AddEdgeTable(
+    const std::string& src_label, const std::string& dst_label,
+    const std::string& edge_label,
+    std::shared_ptr<ITablePipeline> edge_table) {
   label_id_t src_label_id, dst_label_id;
   // find if src_label exists
   auto iter = vertex_label_to_index_.find(src_label);
@@ -195,8 +205,8 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::AddEdgeTable(
   }
   dst_label_id = iter->second;
 
-  auto src_column_type = edge_table->column(src_column)->type();
-  auto dst_column_type = edge_table->column(dst_column)->type();
+  auto src_column_type = edge_table->schema()->field(src_column)->type();
+  auto dst_column_type = edge_table->schema()->field(dst_column)->type();
 
   if (!src_column_type->Equals(
           vineyard::ConvertToArrowType<oid_t>::TypeValue())) {
@@ -247,10 +257,8 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::ConstructEdges(
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] un-shuffled edge table size for label "
                 << edge_label_to_index_[pair.first] << ": "
-                << item.second->num_rows();
-      ordered_edge_tables_[edge_label_to_index_[pair.first]].push_back(
-          std::make_pair(item.first,
-                         std::make_shared<TablePipeline>(item.second)));
+                << item.second->length();
+      ordered_edge_tables_[edge_label_to_index_[pair.first]].push_back(item);
     }
   }
   input_edge_tables_.clear();
@@ -495,8 +503,9 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::ConstructFragment() {
 
   VLOG(100) << "Start constructing fragment: " << get_rss_pretty()
             << ", peak: " << get_peak_rss_pretty();
-#define CONSTRUCT_FRAGMENT_BODY                                               \
+#define CONSTRUCT_FRAGMENT_BODY(vm)                                           \
   frag_builder.SetPropertyGraphSchema(std::move(schema));                     \
+  frag_builder.set_reorder_vertices(reorder_vertices_, comm_spec_);           \
   BOOST_LEAF_CHECK(frag_builder.Init(                                         \
       comm_spec_.fid(), comm_spec_.fnum(), std::move(output_vertex_tables_),  \
       std::move(output_edge_tables_), directed_, concurrency));               \
@@ -509,24 +518,33 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::ConstructFragment() {
             << ", peak: " << get_peak_rss_pretty();                           \
                                                                               \
   VY_OK_OR_RAISE(client_.Persist(fragment_object->id()));                     \
+  /* reordering vertices replaces the vertex map built by the loader */       \
+  if (frag_builder.vertex_map() != vm) {                                      \
+    auto status = client_.DelData(vm->id(), false, true);                     \
+    LOG_IF(WARNING, !status.ok())                                             \
+        << "[frag-" << comm_spec_.fid()                                       \
+        << "] Failed to delete the replaced vertex map: "                     \
+        << status.ToString();                                                 \
+    vm = frag_builder.vertex_map();                                           \
+  }                                                                           \
   return fragment_object->id()
 
   if (!local_vertex_map_ && !compact_edges_) {
     BasicArrowFragmentBuilder<oid_t, vid_t, vertex_map_t, false> frag_builder(
         client_, vm_ptr_);
-    CONSTRUCT_FRAGMENT_BODY;
+    CONSTRUCT_FRAGMENT_BODY(vm_ptr_);
   } else if (!local_vertex_map_ && compact_edges_) {
     BasicArrowFragmentBuilder<oid_t, vid_t, vertex_map_t, true> frag_builder(
         client_, vm_ptr_);
-    CONSTRUCT_FRAGMENT_BODY;
+    CONSTRUCT_FRAGMENT_BODY(vm_ptr_);
   } else if (local_vertex_map_ && !compact_edges_) {
     BasicArrowFragmentBuilder<oid_t, vid_t, local_vertex_map_t, false>
         frag_builder(client_, local_vm_ptr_);
-    CONSTRUCT_FRAGMENT_BODY;
+    CONSTRUCT_FRAGMENT_BODY(local_vm_ptr_);
   } else {
     BasicArrowFragmentBuilder<oid_t, vid_t, local_vertex_map_t, true>
         frag_builder(client_, local_vm_ptr_);
-    CONSTRUCT_FRAGMENT_BODY;
+    CONSTRUCT_FRAGMENT_BODY(local_vm_ptr_);
   }
 #undef CONSTRUCT_FRAGMENT_BODY
 }
@@ -608,6 +626,28 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::parseOidChunkedArrayChunk(
   vertex_map_t* vm = vm_ptr_.get();
   local_vertex_map_t* local_vm = local_vm_ptr_.get();
 
+  if (vm != nullptr) {
+    // resolved in batch, as this chunk is already processed in parallel
+    // with others, no further concurrency is used
+    std::vector<fid_t> fids(oid_array->length());
+    for (int64_t k = 0; k != oid_array->length(); ++k) {
+      internal_oid_t oid = oid_array->GetView(k);
+      fids[k] = partitioner_.GetPartitionId(oid);
+    }
+    std::shared_ptr<ArrowArrayType<VID_T>> gid_array;
+    auto status = vm->GetGids(label_id, oid_array, fids, gid_array);
+    if (!status.ok()) {
+      std::string error_message =
+          "Mapping vertices failed, all src/dst in edges must present in "
+          "corresponding vertices first: " +
+          status.message();
+      LOG(ERROR) << error_message;
+      return Status::Invalid(error_message);
+    }
+    out = gid_array;
+    return Status::OK();
+  }
+
   // prepare buffer
   std::unique_ptr<arrow::Buffer> buffer;
   {
@@ -619,13 +659,7 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::parseOidChunkedArrayChunk(
   for (int64_t k = 0; k != oid_array->length(); ++k) {
     internal_oid_t oid = oid_array->GetView(k);
     fid_t fid = partitioner_.GetPartitionId(oid);
-    bool found = false;
-    if (vm != nullptr) {
-      found = vm->GetGid(fid, label_id, oid, builder[k]);
-    } else {
-      found = local_vm->GetGid(fid, label_id, oid, builder[k]);
-    }
-    if (!found) {
+    if (!local_vm->GetGid(fid, label_id, oid, builder[k])) {
       std::stringstream buffer;
       buffer << "Mapping vertex '" << oid << "' failed. All src/dst in edges "
              << "must present in corresponding vertices first";
@@ -820,6 +854,7 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructVerticesImpl(
     BasicArrowVertexMapBuilder<internal_oid_t, vid_t> vm_builder(
         client_, comm_spec_.fnum(), vertex_label_num_, std::move(oid_lists),
         use_perfect_hash_);
+    vm_builder.set_compress_oids(compress_oids_);
     // oid_lists.clear();
 
     // vm_object -> vertex map
@@ -953,6 +988,7 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructVerticesImplLocal(
   local_vm_builder_ =
       std::make_shared<ArrowLocalVertexMapBuilder<internal_oid_t, vid_t>>(
           client_, comm_spec_.fnum(), comm_spec_.fid(), vertex_label_num_);
+  local_vm_builder_->set_compress_oids(compress_oids_);
 
   std::vector<std::shared_ptr<arrow::ChunkedArray>> local_oid_array(
       vertex_label_num_);
@@ -1019,10 +1055,17 @@ BasicEVFragmentLoader<OID_T, VID_T, PARTITIONER_T>::constructEdgesImpl(
 
       std::shared_ptr<ITablePipeline> table =
           std::make_shared<ConcatTablePipeline>(processed_table_list);
-      // Shuffle the edge table with gid
-      BOOST_LEAF_AUTO(
-          table_out, ShufflePropertyEdgeTable<vid_t>(
-                         comm_spec_, id_parser, src_column, dst_column, table));
+      // Shuffle the edge table with gid, and spill the received edges when
+      // exceeding the memory budget
+      TableSpillBuffer buffer(table->schema(), memory_budget_, spill_dir_);
+      BOOST_LEAF_AUTO(table_out, ShufflePropertyEdgeTable<vid_t>(
+                                     comm_spec_, id_parser, src_column,
+                                     dst_column, table, buffer));
+      spilled_files_ += buffer.spilled_files();
+      VLOG_IF(100, buffer.spilled_files() > 0)
+          << "[worker-" << comm_spec_.worker_id() << "] spilled "
+          << prettyprint_memory_size(buffer.spilled_bytes()) << " in "
+          << buffer.spilled_files() << " files for edge label " << e_label;
       VLOG(100) << "[worker-" << comm_spec_.worker_id()
                 << "] shuffled edge table size for label " << e_label << ": "
                 << table_out->num_rows();
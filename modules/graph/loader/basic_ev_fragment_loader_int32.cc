@@ -24,4 +24,10 @@ template class BasicEVFragmentLoader<int32_t, uint64_t,
 template class BasicEVFragmentLoader<int32_t, uint32_t,
                                      HashPartitioner<int32_t>>;
 
+template class BasicEVFragmentLoader<int32_t, uint64_t,
+                                     FennelPartitioner<int32_t>>;
+
+template class BasicEVFragmentLoader<int32_t, uint32_t,
+                                     FennelPartitioner<int32_t>>;
+
 }  // namespace vineyard
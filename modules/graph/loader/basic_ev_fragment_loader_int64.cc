@@ -24,4 +24,10 @@ template class BasicEVFragmentLoader<int64_t, uint64_t,
 template class BasicEVFragmentLoader<int64_t, uint32_t,
                                      HashPartitioner<int64_t>>;
 
+template class BasicEVFragmentLoader<int64_t, uint64_t,
+                                     FennelPartitioner<int64_t>>;
+
+template class BasicEVFragmentLoader<int64_t, uint32_t,
+                                     FennelPartitioner<int64_t>>;
+
 }  // namespace vineyard
@@ -24,4 +24,10 @@ template class BasicEVFragmentLoader<std::string, uint64_t,
 template class BasicEVFragmentLoader<std::string, uint32_t,
                                      HashPartitioner<std::string>>;
 
+template class BasicEVFragmentLoader<std::string, uint64_t,
+                                     FennelPartitioner<std::string>>;
+
+template class BasicEVFragmentLoader<std::string, uint32_t,
+                                     FennelPartitioner<std::string>>;
+
 }  // namespace vineyard
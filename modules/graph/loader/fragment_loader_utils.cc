@@ -206,6 +206,36 @@ BuildVertexTableFromEdges<HashPartitioner<std::string>>(
         vertex_label_to_index,
     const std::set<std::string>& deduced_labels);
 
+template boost::leaf::result<
+    std::map<std::string, std::shared_ptr<arrow::Table>>>
+BuildVertexTableFromEdges<FennelPartitioner<int32_t>>(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<int32_t>& partitioner,
+    const std::vector<InputTable>& edge_tables,
+    const std::map<std::string, property_graph_types::LABEL_ID_TYPE>&
+        vertex_label_to_index,
+    const std::set<std::string>& deduced_labels);
+
+template boost::leaf::result<
+    std::map<std::string, std::shared_ptr<arrow::Table>>>
+BuildVertexTableFromEdges<FennelPartitioner<int64_t>>(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<int64_t>& partitioner,
+    const std::vector<InputTable>& edge_tables,
+    const std::map<std::string, property_graph_types::LABEL_ID_TYPE>&
+        vertex_label_to_index,
+    const std::set<std::string>& deduced_labels);
+
+template boost::leaf::result<
+    std::map<std::string, std::shared_ptr<arrow::Table>>>
+BuildVertexTableFromEdges<FennelPartitioner<std::string>>(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<std::string>& partitioner,
+    const std::vector<InputTable>& edge_tables,
+    const std::map<std::string, property_graph_types::LABEL_ID_TYPE>&
+        vertex_label_to_index,
+    const std::set<std::string>& deduced_labels);
+
 boost::leaf::result<std::shared_ptr<arrow::Table>> SyncSchema(
     const std::shared_ptr<arrow::Table>& table,
     const grape::CommSpec& comm_spec) {
@@ -227,6 +257,24 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> SyncSchema(
   return table_out;
 }
 
+boost::leaf::result<std::shared_ptr<arrow::Schema>> SyncSchema(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const grape::CommSpec& comm_spec) {
+  std::shared_ptr<arrow::Schema> local_schema = schema;
+  std::vector<std::shared_ptr<arrow::Schema>> schemas;
+
+  GlobalAllGatherv(local_schema, schemas, comm_spec);
+  if (std::all_of(schemas.begin(), schemas.end(),
+                  [](const std::shared_ptr<arrow::Schema>& schema) {
+                    return schema == nullptr;
+                  })) {
+    return std::shared_ptr<arrow::Schema>(nullptr);
+  }
+  std::shared_ptr<arrow::Schema> normalized_schema;
+  VY_OK_OR_RAISE(TypeLoosen(schemas, normalized_schema));
+  return normalized_schema;
+}
+
 boost::leaf::result<ObjectID> ConstructFragmentGroup(
     Client& client, ObjectID frag_id, const grape::CommSpec& comm_spec) {
   ObjectID group_object_id;
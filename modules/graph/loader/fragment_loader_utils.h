@@ -140,6 +140,16 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> SyncSchema(
     const std::shared_ptr<arrow::Table>& table,
     const grape::CommSpec& comm_spec);
 
+/**
+ * @brief Like `SyncSchema` for tables, but for the schema of a stream (which
+ * might be nullptr if the stream is empty on this worker), and returns the
+ * normalized schema that the batches are casted to, or nullptr if the stream
+ * is empty on all workers.
+ */
+boost::leaf::result<std::shared_ptr<arrow::Schema>> SyncSchema(
+    const std::shared_ptr<arrow::Schema>& schema,
+    const grape::CommSpec& comm_spec);
+
 boost::leaf::result<ObjectID> ConstructFragmentGroup(
     Client& client, ObjectID frag_id, const grape::CommSpec& comm_spec);
 
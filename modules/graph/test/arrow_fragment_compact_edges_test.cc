@@ -0,0 +1,142 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "client/client.h"
+
+#include "common/util/env.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/loader/fragment_loader_utils.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = property_graph_types::OID_TYPE;
+using vid_t = property_graph_types::VID_TYPE;
+using GraphType = ArrowFragment<oid_t, vid_t>;
+using CompactGraphType =
+    ArrowFragment<oid_t, vid_t,
+                  ArrowVertexMap<typename InternalType<oid_t>::type, vid_t>,
+                  true>;
+using LabelType = typename GraphType::label_id_t;
+using edge_t = std::tuple<int64_t, int64_t, int64_t>;
+
+/**
+ * Collects both the outgoing and the incoming edges of local fragments.
+ */
+template <typename FRAG_T>
+std::vector<edge_t> CollectEdges(vineyard::Client& client,
+                                 vineyard::ObjectID frag_group_id,
+                                 const bool compact) {
+  std::shared_ptr<vineyard::ArrowFragmentGroup> fg =
+      std::dynamic_pointer_cast<vineyard::ArrowFragmentGroup>(
+          client.GetObject(frag_group_id));
+  std::vector<edge_t> edges;
+  auto locations = fg->FragmentLocations();
+  for (const auto& pair : fg->Fragments()) {
+    if (locations.at(pair.first) != client.instance_id()) {
+      continue;
+    }
+    auto frag =
+        std::dynamic_pointer_cast<FRAG_T>(client.GetObject(pair.second));
+    CHECK(frag != nullptr);
+    CHECK_EQ(frag->compact_edges(), compact);
+    if (compact) {
+      CHECK(frag->compact_edges_codec() == CompactEdgesCodec::kStreamVByte);
+    }
+    for (LabelType elabel = 0; elabel < frag->edge_label_num(); ++elabel) {
+      for (LabelType vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+        for (auto v : frag->InnerVertices(vlabel)) {
+          for (auto e : frag->GetOutgoingAdjList(v, elabel)) {
+            edges.emplace_back(frag->GetId(v), frag->GetId(e.neighbor()),
+                               e.template get_data<int64_t>(0));
+          }
+          for (auto e : frag->GetIncomingAdjList(v, elabel)) {
+            edges.emplace_back(frag->GetId(e.neighbor()), frag->GetId(v),
+                               e.template get_data<int64_t>(0));
+          }
+        }
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_compact_edges_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + "#header_row=true&label=person";
+  std::string efile = e_file_path +
+                      "#header_row=true&label=knows&src_label=person&"
+                      "dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  using loader_t = ArrowFragmentLoader<oid_t, vid_t>;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    vineyard::ObjectID true_frag_group, test_frag_group;
+    {
+      auto loader = std::make_unique<loader_t>(
+          client, comm_spec, std::vector<std::string>{efile},
+          std::vector<std::string>{vfile}, /* directed */ 1);
+      true_frag_group = loader->LoadFragmentAsFragmentGroup().value();
+    }
+    {
+      auto loader = std::make_unique<loader_t>(
+          client, comm_spec, std::vector<std::string>{efile},
+          std::vector<std::string>{vfile}, /* directed */ 1,
+          /* generate_eid */ false, /* retain_oid */ false,
+          /* local_vertex_map */ false, /* compact_edges */ true);
+      test_frag_group = loader->LoadFragmentAsFragmentGroup().value();
+    }
+
+    auto true_edges = CollectEdges<GraphType>(client, true_frag_group, false);
+    auto test_edges =
+        CollectEdges<CompactGraphType>(client, test_frag_group, true);
+    CHECK_EQ(true_edges.size(), test_edges.size());
+    CHECK(true_edges == test_edges);
+    LOG(INFO) << "[worker-" << comm_spec.worker_id() << "] loaded "
+              << test_edges.size() << " compact edges";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment compact edges test...";
+
+  return 0;
+}
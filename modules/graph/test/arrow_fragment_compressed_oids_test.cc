@@ -0,0 +1,144 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "client/client.h"
+
+#include "common/util/env.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/loader/fragment_loader_utils.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = std::string;
+using vid_t = property_graph_types::VID_TYPE;
+using internal_oid_t = typename InternalType<oid_t>::type;
+using edge_t = std::tuple<oid_t, oid_t, int64_t>;
+
+/**
+ * Collects the outgoing edges (in oids) of the inner vertices, and checks
+ * that the oids of both ends can be resolved back to the vertices, and agree
+ * with the internal ids.
+ */
+template <typename FRAG_T>
+std::vector<edge_t> CollectEdges(const std::shared_ptr<FRAG_T>& frag) {
+  using label_id_t = typename FRAG_T::label_id_t;
+  using vertex_t = typename FRAG_T::vertex_t;
+  std::vector<edge_t> edges;
+  for (label_id_t vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+    for (auto v : frag->InnerVertices(vlabel)) {
+      oid_t src = frag->GetId(v);
+      CHECK_EQ(oid_t(frag->GetInnerVertexInternalId(v)), src);
+      vertex_t u;
+      CHECK(frag->GetInnerVertex(vlabel, src, u));
+      CHECK(u == v);
+      for (label_id_t elabel = 0; elabel < frag->edge_label_num(); ++elabel) {
+        for (auto e : frag->GetOutgoingAdjList(v, elabel)) {
+          oid_t dst = frag->GetId(e.neighbor());
+          if (frag->IsOuterVertex(e.neighbor())) {
+            CHECK_EQ(oid_t(frag->GetOuterVertexInternalId(e.neighbor())),
+                     dst);
+          } else {
+            CHECK_EQ(oid_t(frag->GetInnerVertexInternalId(e.neighbor())),
+                     dst);
+          }
+          vid_t gid;
+          CHECK(frag->Oid2Gid(frag->vertex_label(e.neighbor()), dst, gid));
+          CHECK_EQ(gid, frag->Vertex2Gid(e.neighbor()));
+          edges.emplace_back(src, dst, e.template get_data<int64_t>(0));
+        }
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+template <typename VERTEX_MAP_T>
+std::vector<edge_t> LoadEdges(vineyard::Client& client,
+                              const grape::CommSpec& comm_spec,
+                              const std::string& efile,
+                              const std::string& vfile,
+                              const bool local_vertex_map,
+                              const bool compress_oids) {
+  using fragment_t = ArrowFragment<oid_t, vid_t, VERTEX_MAP_T>;
+  auto loader = std::make_unique<ArrowFragmentLoader<oid_t, vid_t>>(
+      client, comm_spec, std::vector<std::string>{efile},
+      std::vector<std::string>{vfile}, /* directed */ 1,
+      /* generate_eid */ false, /* retain_oid */ false, local_vertex_map);
+  loader->set_compress_oids(compress_oids);
+  auto frag = std::dynamic_pointer_cast<fragment_t>(
+      client.GetObject(loader->LoadFragment().value()));
+  CHECK_EQ(frag->GetVertexMap()->compress_oids(), compress_oids);
+  return CollectEdges(frag);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_compressed_oids_test <ipc_socket> "
+        "<vdata_path> <edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + "#header_row=true&label=person";
+  std::string efile = e_file_path +
+                      "#header_row=true&label=knows&src_label=person&"
+                      "dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  using vertex_map_t = ArrowVertexMap<internal_oid_t, vid_t>;
+  using local_vertex_map_t = ArrowLocalVertexMap<internal_oid_t, vid_t>;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    auto true_edges = LoadEdges<vertex_map_t>(client, comm_spec, efile, vfile,
+                                              false, false);
+    auto compressed_edges = LoadEdges<vertex_map_t>(client, comm_spec, efile,
+                                                    vfile, false, true);
+    CHECK(true_edges == compressed_edges);
+
+    auto local_edges = LoadEdges<local_vertex_map_t>(client, comm_spec, efile,
+                                                     vfile, true, false);
+    auto local_compressed_edges = LoadEdges<local_vertex_map_t>(
+        client, comm_spec, efile, vfile, true, true);
+    CHECK(local_edges == local_compressed_edges);
+    LOG(INFO) << "[worker-" << comm_spec.worker_id() << "] loaded "
+              << compressed_edges.size() << " edges";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment compressed oids test...";
+
+  return 0;
+}
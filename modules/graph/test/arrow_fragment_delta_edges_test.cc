@@ -0,0 +1,217 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "client/client.h"
+
+#include "common/util/env.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/loader/fragment_loader_utils.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = property_graph_types::OID_TYPE;
+using vid_t = property_graph_types::VID_TYPE;
+using eid_t = property_graph_types::EID_TYPE;
+using GraphType = ArrowFragment<oid_t, vid_t>;
+using LabelType = typename GraphType::label_id_t;
+
+// (src gid, dst gid, data) of edges, by edge id
+using edges_t = std::map<eid_t, std::tuple<vid_t, vid_t, int64_t>>;
+
+edges_t CollectEdges(const std::shared_ptr<GraphType>& frag,
+                     const LabelType elabel) {
+  edges_t oes, ies;
+  for (LabelType vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+    for (auto v : frag->InnerVertices(vlabel)) {
+      vid_t gid = frag->Vertex2Gid(v);
+      for (auto e : frag->GetOutgoingAdjListWithDelta(v, elabel)) {
+        auto edge = std::make_tuple(gid, frag->Vertex2Gid(e.neighbor()),
+                                    e.get_data<int64_t>(0));
+        CHECK(oes.emplace(e.edge_id(), edge).second);
+      }
+      for (auto e : frag->GetIncomingAdjListWithDelta(v, elabel)) {
+        auto edge = std::make_tuple(frag->Vertex2Gid(e.neighbor()), gid,
+                                    e.get_data<int64_t>(0));
+        CHECK(ies.emplace(e.edge_id(), edge).second);
+      }
+    }
+  }
+  // a single fragment holds both ends of every edge
+  CHECK(oes == ies);
+  CHECK_EQ(static_cast<int64_t>(oes.size()), frag->edge_data_num(elabel));
+  return oes;
+}
+
+// the edges walked by the accessors of the base CSR
+int64_t CountBaseEdges(const std::shared_ptr<GraphType>& frag,
+                       const LabelType elabel) {
+  int64_t num = 0;
+  for (LabelType vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+    for (auto v : frag->InnerVertices(vlabel)) {
+      for (auto e : frag->GetOutgoingAdjList(v, elabel)) {
+        CHECK_LT(static_cast<int64_t>(e.edge_id()),
+                 frag->edge_data_num(elabel));
+        ++num;
+      }
+    }
+  }
+  return num;
+}
+
+/**
+ * The edges of the rows [offset, offset + length) of the base edge table,
+ * with the src and dst gids in front of the properties.
+ */
+std::shared_ptr<arrow::Table> MakeEdgeTable(
+    const std::shared_ptr<GraphType>& frag, const LabelType elabel,
+    const edges_t& edges, const int64_t offset, const int64_t length) {
+  arrow::UInt64Builder src_builder, dst_builder;
+  for (int64_t row = offset; row < offset + length; ++row) {
+    auto const& edge = edges.at(row);
+    CHECK_ARROW_ERROR(src_builder.Append(std::get<0>(edge)));
+    CHECK_ARROW_ERROR(dst_builder.Append(std::get<1>(edge)));
+  }
+  std::shared_ptr<arrow::Array> srcs, dsts;
+  CHECK_ARROW_ERROR(src_builder.Finish(&srcs));
+  CHECK_ARROW_ERROR(dst_builder.Finish(&dsts));
+
+  auto table = frag->edge_data_table(elabel)->Slice(offset, length);
+  CHECK_ARROW_ERROR_AND_ASSIGN(
+      table, table->AddColumn(0, arrow::field("src", arrow::uint64()),
+                              std::make_shared<arrow::ChunkedArray>(srcs)));
+  CHECK_ARROW_ERROR_AND_ASSIGN(
+      table, table->AddColumn(1, arrow::field("dst", arrow::uint64()),
+                              std::make_shared<arrow::ChunkedArray>(dsts)));
+  return table;
+}
+
+std::shared_ptr<GraphType> AddEdges(vineyard::Client& client,
+                                    const std::shared_ptr<GraphType>& frag,
+                                    const LabelType elabel,
+                                    const edges_t& base_edges,
+                                    const int64_t offset,
+                                    const int64_t length) {
+  auto table = MakeEdgeTable(frag, elabel, base_edges, offset, length);
+  auto frag_id = frag->AddEdgesToExistedLabel(client, elabel, std::move(table),
+                                              {})
+                     .value();
+  return std::dynamic_pointer_cast<GraphType>(client.GetObject(frag_id));
+}
+
+/**
+ * Checks that the edges of `prev` keep their edge ids and data, and that
+ * the new edges, i.e., the copies of the base rows [offset, offset +
+ * length), follow the existing edge ids.
+ */
+void CheckEdges(const edges_t& prev, const edges_t& base_edges,
+                const edges_t& edges, const int64_t offset,
+                const int64_t length) {
+  CHECK_EQ(static_cast<int64_t>(edges.size()),
+           static_cast<int64_t>(prev.size()) + length);
+  for (auto const& pair : prev) {
+    CHECK(edges.at(pair.first) == pair.second);
+  }
+  for (int64_t i = 0; i < length; ++i) {
+    CHECK(edges.at(prev.size() + i) == base_edges.at(offset + i));
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_delta_edges_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + "#header_row=true&label=person";
+  std::string efile = e_file_path +
+                      "#header_row=true&label=knows&src_label=person&"
+                      "dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+    CHECK_EQ(comm_spec.fnum(), 1);
+
+    auto loader = std::make_unique<ArrowFragmentLoader<oid_t, vid_t>>(
+        client, comm_spec, std::vector<std::string>{efile},
+        std::vector<std::string>{vfile}, /* directed */ 1);
+    auto frag = std::dynamic_pointer_cast<GraphType>(
+        client.GetObject(loader->LoadFragment().value()));
+    const LabelType elabel = 0;
+    const edges_t base_edges = CollectEdges(frag, elabel);
+    const int64_t base_num = base_edges.size();
+    CHECK_GE(base_num, 32);
+    CHECK(!frag->has_delta_edges());
+
+    // small batches go to the delta CSR
+    edges_t edges = base_edges;
+    const int64_t batch = base_num / 16;
+    for (int round = 0; round < 3; ++round) {
+      frag = AddEdges(client, frag, elabel, base_edges, round * batch, batch);
+      CHECK(frag->has_delta_edges());
+      CHECK_EQ(frag->edge_data_table(elabel)->num_rows(), base_num);
+      auto current = CollectEdges(frag, elabel);
+      CheckEdges(edges, base_edges, current, round * batch, batch);
+      edges = std::move(current);
+    }
+
+    // compaction keeps the edge ids
+    {
+      auto compacted = std::dynamic_pointer_cast<GraphType>(
+          client.GetObject(frag->CompactEdgesAsync(client).get()));
+      CHECK(!compacted->has_delta_edges());
+      CHECK_EQ(compacted->edge_data_table(elabel)->num_rows(),
+               static_cast<int64_t>(edges.size()));
+      CHECK(CollectEdges(compacted, elabel) == edges);
+      CHECK_EQ(CountBaseEdges(compacted, elabel),
+               static_cast<int64_t>(edges.size()));
+    }
+
+    // a large batch folds the delta CSR into the base CSR
+    frag = AddEdges(client, frag, elabel, base_edges, 0, base_num / 2);
+    CHECK(!frag->has_delta_edges());
+    auto current = CollectEdges(frag, elabel);
+    CheckEdges(edges, base_edges, current, 0, base_num / 2);
+    CHECK_EQ(CountBaseEdges(frag, elabel),
+             static_cast<int64_t>(current.size()));
+    LOG(INFO) << "[worker-" << comm_spec.worker_id() << "] "
+              << current.size() << " edges after appending";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment delta edges test...";
+
+  return 0;
+}
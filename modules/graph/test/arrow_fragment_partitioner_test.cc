@@ -0,0 +1,154 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "client/client.h"
+
+#include "common/util/env.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/loader/fragment_loader_utils.h"
+#include "graph/utils/partitioner.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = property_graph_types::OID_TYPE;
+using vid_t = property_graph_types::VID_TYPE;
+using GraphType = ArrowFragment<oid_t, vid_t>;
+using LabelType = typename GraphType::label_id_t;
+using edge_t = std::tuple<int64_t, int64_t, int64_t>;
+
+/**
+ * Collects the edges of all fragments, and checks that every inner vertex
+ * lives in the fragment that the partitioner decides.
+ */
+template <typename PARTITIONER_T>
+std::vector<edge_t> CollectEdges(vineyard::Client& client,
+                                 vineyard::ObjectID frag_group_id,
+                                 const PARTITIONER_T& partitioner) {
+  std::shared_ptr<vineyard::ArrowFragmentGroup> fg =
+      std::dynamic_pointer_cast<vineyard::ArrowFragmentGroup>(
+          client.GetObject(frag_group_id));
+  std::vector<edge_t> edges;
+  for (const auto& pair : fg->Fragments()) {
+    auto frag =
+        std::dynamic_pointer_cast<GraphType>(client.GetObject(pair.second));
+    for (LabelType vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+      for (auto v : frag->InnerVertices(vlabel)) {
+        CHECK_EQ(partitioner.GetPartitionId(frag->GetId(v)), frag->fid());
+      }
+    }
+    for (LabelType elabel = 0; elabel < frag->edge_label_num(); ++elabel) {
+      for (LabelType vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+        for (auto v : frag->InnerVertices(vlabel)) {
+          for (auto e : frag->GetOutgoingAdjList(v, elabel)) {
+            edges.emplace_back(frag->GetId(v), frag->GetId(e.neighbor()),
+                               e.get_data<int64_t>(0));
+          }
+        }
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+template <typename PARTITIONER_T>
+std::vector<edge_t> LoadEdges(
+    vineyard::Client& client, const grape::CommSpec& comm_spec,
+    const std::string& efile, const std::string& vfile,
+    std::function<void(PARTITIONER_T&)> configure = [](PARTITIONER_T&) {},
+    const size_t memory_budget = 0) {
+  using loader_t = ArrowFragmentLoader<oid_t, vid_t, PARTITIONER_T>;
+  auto loader = std::make_unique<loader_t>(
+      client, comm_spec, std::vector<std::string>{efile},
+      std::vector<std::string>{vfile}, /* directed */ 1);
+  configure(loader->partitioner());
+  loader->set_memory_budget(memory_budget);
+  auto frag_group = loader->LoadFragmentAsFragmentGroup().value();
+  MPI_Barrier(comm_spec.comm());
+  // every worker checks the fragments against its own partitioner, e.g., the
+  // assignment broadcast from the first worker for the `FennelPartitioner`
+  std::vector<edge_t> edges =
+      CollectEdges(client, frag_group, loader->partitioner());
+  if (comm_spec.worker_id() != 0) {
+    edges.clear();
+  }
+  MPI_Barrier(comm_spec.comm());
+  return edges;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_partitioner_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + "#header_row=true&label=person";
+  std::string efile = e_file_path +
+                      "#header_row=true&label=knows&src_label=person&"
+                      "dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    auto true_edges =
+        LoadEdges<HashPartitioner<oid_t>>(client, comm_spec, efile, vfile);
+    auto fennel_edges =
+        LoadEdges<FennelPartitioner<oid_t>>(client, comm_spec, efile, vfile);
+    auto ldg_edges = LoadEdges<FennelPartitioner<oid_t>>(
+        client, comm_spec, efile, vfile,
+        [](FennelPartitioner<oid_t>& partitioner) {
+          partitioner.set_mode(FennelPartitionerBase::Mode::kLDG);
+          partitioner.set_hub_degree_threshold(32);
+        });
+
+    // the pre-pass streams the files in the blocks of the memory budget
+    auto streaming_edges = LoadEdges<FennelPartitioner<oid_t>>(
+        client, comm_spec, efile, vfile, [](FennelPartitioner<oid_t>&) {},
+        1024 * 1024);
+
+    CHECK(true_edges == fennel_edges);
+    CHECK(true_edges == ldg_edges);
+    CHECK(true_edges == streaming_edges);
+    LOG(INFO) << "[worker-" << comm_spec.worker_id() << "] loaded "
+              << fennel_edges.size() << " edges";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment partitioner test...";
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "client/client.h"
+
+#include "common/util/env.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/loader/fragment_loader_utils.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using oid_t = property_graph_types::OID_TYPE;
+using vid_t = property_graph_types::VID_TYPE;
+using GraphType = ArrowFragment<oid_t, vid_t>;
+using LabelType = typename GraphType::label_id_t;
+using edge_t = std::tuple<int64_t, int64_t, int64_t>;
+
+/**
+ * Collects the outgoing and incoming edges (in oids) of the inner vertices,
+ * and checks that the inner vertices are in the descending order of degrees
+ * if reordered.
+ */
+std::vector<edge_t> CollectEdges(const std::shared_ptr<GraphType>& frag,
+                                 const bool reordered) {
+  std::vector<edge_t> edges;
+  for (LabelType vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+    int64_t prev_degree = -1;
+    for (auto v : frag->InnerVertices(vlabel)) {
+      int64_t degree = 0;
+      for (LabelType elabel = 0; elabel < frag->edge_label_num(); ++elabel) {
+        for (auto e : frag->GetOutgoingAdjList(v, elabel)) {
+          edges.emplace_back(frag->GetId(v), frag->GetId(e.neighbor()),
+                             e.get_data<int64_t>(0));
+          degree += 1;
+        }
+        for (auto e : frag->GetIncomingAdjList(v, elabel)) {
+          edges.emplace_back(frag->GetId(e.neighbor()), frag->GetId(v),
+                             e.get_data<int64_t>(0));
+          degree += 1;
+        }
+      }
+      if (reordered && prev_degree != -1) {
+        CHECK_LE(degree, prev_degree);
+      }
+      prev_degree = degree;
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+std::vector<edge_t> LoadEdges(vineyard::Client& client,
+                              const grape::CommSpec& comm_spec,
+                              const std::string& efile,
+                              const std::string& vfile, const bool reorder) {
+  auto loader = std::make_unique<ArrowFragmentLoader<oid_t, vid_t>>(
+      client, comm_spec, std::vector<std::string>{efile},
+      std::vector<std::string>{vfile}, /* directed */ 1);
+  loader->set_reorder_vertices(reorder);
+  auto frag = std::dynamic_pointer_cast<GraphType>(
+      client.GetObject(loader->LoadFragment().value()));
+  return CollectEdges(frag, reorder);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_reorder_test <ipc_socket> <vdata_path> "
+        "<edata_path>\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+
+  std::string vfile = v_file_path + "#header_row=true&label=person";
+  std::string efile = e_file_path +
+                      "#header_row=true&label=knows&src_label=person&"
+                      "dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    // the outer vertices are resolved by the permutations of other fragments
+    auto true_edges = LoadEdges(client, comm_spec, efile, vfile, false);
+    auto reordered_edges = LoadEdges(client, comm_spec, efile, vfile, true);
+    CHECK(true_edges == reordered_edges);
+    LOG(INFO) << "[worker-" << comm_spec.worker_id() << "] loaded "
+              << reordered_edges.size() << " edges";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment reorder test...";
+
+  return 0;
+}
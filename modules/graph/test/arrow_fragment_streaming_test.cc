@@ -0,0 +1,142 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "client/client.h"
+
+#include "common/util/env.h"
+#include "common/util/functions.h"
+#include "graph/loader/arrow_fragment_loader.h"
+#include "graph/loader/fragment_loader_utils.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+using GraphType = ArrowFragment<property_graph_types::OID_TYPE,
+                                property_graph_types::VID_TYPE>;
+using LabelType = typename GraphType::label_id_t;
+using edge_t = std::tuple<int64_t, int64_t, int64_t>;
+
+std::vector<edge_t> CollectEdges(vineyard::Client& client,
+                                 vineyard::ObjectID frag_group_id) {
+  std::shared_ptr<vineyard::ArrowFragmentGroup> fg =
+      std::dynamic_pointer_cast<vineyard::ArrowFragmentGroup>(
+          client.GetObject(frag_group_id));
+  std::vector<edge_t> edges;
+  auto locations = fg->FragmentLocations();
+  for (const auto& pair : fg->Fragments()) {
+    if (locations.at(pair.first) != client.instance_id()) {
+      continue;
+    }
+    auto frag =
+        std::dynamic_pointer_cast<GraphType>(client.GetObject(pair.second));
+    for (LabelType elabel = 0; elabel < frag->edge_label_num(); ++elabel) {
+      for (LabelType vlabel = 0; vlabel < frag->vertex_label_num(); ++vlabel) {
+        for (auto v : frag->InnerVertices(vlabel)) {
+          for (auto e : frag->GetOutgoingAdjList(v, elabel)) {
+            edges.emplace_back(frag->GetId(v), frag->GetId(e.neighbor()),
+                               e.get_data<int64_t>(0));
+          }
+        }
+      }
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 4) {
+    printf(
+        "usage: ./arrow_fragment_streaming_test <ipc_socket> <vdata_path> "
+        "<edata_path> [memory_budget]\n");
+    return 1;
+  }
+  int index = 1;
+  std::string ipc_socket = std::string(argv[index++]);
+  std::string v_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  std::string e_file_path = vineyard::ExpandEnvironmentVariables(argv[index++]);
+  size_t memory_budget = 1024 * 1024;
+  if (argc > index) {
+    memory_budget = parse_memory_size(argv[index++]);
+  }
+
+  std::string vfile = v_file_path + "#header_row=true&label=person";
+  std::string efile = e_file_path +
+                      "#header_row=true&label=knows&src_label=person&"
+                      "dst_label=person";
+
+  vineyard::Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  using loader_t = ArrowFragmentLoader<property_graph_types::OID_TYPE,
+                                       property_graph_types::VID_TYPE>;
+
+  grape::InitMPIComm();
+  {
+    grape::CommSpec comm_spec;
+    comm_spec.Init(MPI_COMM_WORLD);
+
+    vineyard::ObjectID true_frag_group, test_frag_group;
+    size_t spilled_files = 0;
+    {
+      auto loader = std::make_unique<loader_t>(
+          client, comm_spec, std::vector<std::string>{efile},
+          std::vector<std::string>{vfile}, /* directed */ 1);
+      true_frag_group = loader->LoadFragmentAsFragmentGroup().value();
+    }
+    {
+      auto loader = std::make_unique<loader_t>(
+          client, comm_spec, std::vector<std::string>{efile},
+          std::vector<std::string>{vfile}, /* directed */ 1);
+      loader->set_memory_budget(memory_budget);
+      test_frag_group = loader->LoadFragmentAsFragmentGroup().value();
+      spilled_files = loader->spilled_files();
+    }
+
+    auto true_edges = CollectEdges(client, true_frag_group);
+    auto test_edges = CollectEdges(client, test_frag_group);
+    CHECK_EQ(true_edges.size(), test_edges.size());
+    CHECK(true_edges == test_edges);
+
+    // each received edge takes at least 24 bytes (src, dst and the int64
+    // property), thus some worker must have spilled if the edges exceed the
+    // budgets of all workers
+    uint64_t total_spilled_files = 0, local_spilled_files = spilled_files;
+    MPI_Allreduce(&local_spilled_files, &total_spilled_files, 1,
+                  MPI_UINT64_T, MPI_SUM, comm_spec.comm());
+    if (true_edges.size() * 3 * sizeof(int64_t) >
+        memory_budget * comm_spec.local_num()) {
+      CHECK_GT(total_spilled_files, 0);
+    }
+    LOG(INFO) << "[worker-" << comm_spec.worker_id() << "] loaded "
+              << test_edges.size() << " edges with memory budget "
+              << prettyprint_memory_size(memory_budget) << ", spilled to "
+              << spilled_files << " files";
+  }
+  grape::FinalizeMPIComm();
+
+  LOG(INFO) << "Passed arrow fragment streaming test...";
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "graph/utils/partitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace vineyard {
+
+void FennelPartitionerBase::partition(const fid_t fnum, const size_t vnum) {
+  // `fnum` marks the vertices that haven't been assigned yet
+  assignment_.assign(vnum, fnum);
+  hub_num_ = 0;
+  if (fnum <= 1) {
+    std::fill(assignment_.begin(), assignment_.end(), 0);
+    std::vector<std::pair<uint64_t, uint64_t>>().swap(edges_);
+    return;
+  }
+
+  // the undirected adjacency lists, in CSR
+  std::vector<uint64_t> offsets(vnum + 1, 0);
+  for (auto const& edge : edges_) {
+    ++offsets[edge.first + 1];
+    ++offsets[edge.second + 1];
+  }
+  for (size_t v = 0; v < vnum; ++v) {
+    offsets[v + 1] += offsets[v];
+  }
+  std::vector<uint64_t> neighbors(offsets[vnum]);
+  {
+    std::vector<uint64_t> cursors(offsets.begin(), offsets.end() - 1);
+    for (auto const& edge : edges_) {
+      neighbors[cursors[edge.first]++] = edge.second;
+      neighbors[cursors[edge.second]++] = edge.first;
+    }
+  }
+  const double edge_num = static_cast<double>(edges_.size());
+  std::vector<std::pair<uint64_t, uint64_t>>().swap(edges_);
+
+  auto is_hub = [&](const uint64_t v) -> bool {
+    return hub_degree_threshold_ > 0 &&
+           offsets[v + 1] - offsets[v] > hub_degree_threshold_;
+  };
+
+  // a slack less than 1 would leave some vertices with no room
+  const double k = static_cast<double>(fnum), n = static_cast<double>(vnum);
+  const double capacity = std::ceil(std::max(slack_, 1.0) * n / k);
+  const double alpha = edge_num * std::pow(k, gamma_ - 1) / std::pow(n, gamma_);
+
+  std::vector<uint64_t> vertex_load(fnum, 0), edge_load(fnum, 0);
+  std::vector<uint64_t> counts(fnum, 0);
+  std::vector<double> penalties(fnum, 0.0);
+
+  for (uint64_t v = 0; v < vnum; ++v) {
+    fid_t target = fnum;
+    if (is_hub(v)) {
+      ++hub_num_;
+      for (fid_t i = 0; i < fnum; ++i) {
+        if (vertex_load[i] >= capacity) {
+          continue;
+        }
+        if (target == fnum || edge_load[i] < edge_load[target] ||
+            (edge_load[i] == edge_load[target] &&
+             vertex_load[i] < vertex_load[target])) {
+          target = i;
+        }
+      }
+    } else {
+      std::fill(counts.begin(), counts.end(), 0);
+      for (uint64_t j = offsets[v]; j < offsets[v + 1]; ++j) {
+        uint64_t u = neighbors[j];
+        if (assignment_[u] != fnum && !is_hub(u)) {
+          ++counts[assignment_[u]];
+        }
+      }
+      double best = std::numeric_limits<double>::lowest();
+      for (fid_t i = 0; i < fnum; ++i) {
+        if (vertex_load[i] >= capacity) {
+          continue;
+        }
+        double score;
+        if (mode_ == Mode::kLDG) {
+          score = counts[i] * (1.0 - vertex_load[i] / capacity);
+        } else {
+          score = counts[i] - penalties[i];
+        }
+        // ties go to the smaller partition
+        if (target == fnum || score > best ||
+            (score == best && vertex_load[i] < vertex_load[target])) {
+          best = score;
+          target = i;
+        }
+      }
+    }
+    assignment_[v] = target;
+    vertex_load[target] += 1;
+    edge_load[target] += offsets[v + 1] - offsets[v];
+    penalties[target] =
+        alpha * gamma_ *
+        std::pow(static_cast<double>(vertex_load[target]), gamma_ - 1);
+  }
+}
+
+}  // namespace vineyard
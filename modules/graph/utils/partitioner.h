@@ -17,14 +17,19 @@ limitations under the License.
 #define MODULES_GRAPH_UTILS_PARTITIONER_H_
 
 #include <cstdint>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "flat_hash_map/flat_hash_map.hpp"
+#include "grape/serialization/in_archive.h"
+#include "grape/serialization/out_archive.h"
 #include "wyhash/wyhash.hpp"
 
 #include "graph/fragment/property_graph_types.h"
+#include "graph/utils/mpi_utils.h"
 
 namespace vineyard {
 
@@ -200,6 +205,249 @@ class SegmentedPartitioner<std::string> {
   ska::flat_hash_map<oid_t, fid_t> o2f_;
 };
 
+/**
+ * @brief The streaming partitioning shared by the `FennelPartitioner`s, where
+ * vertices are indexed as [0, vnum) in the order they are streamed.
+ *
+ * Each vertex is greedily assigned to the partition that holds most of its
+ * already-assigned neighbors (d_i), minus a penalty on the partition size:
+ *
+ *  - Fennel: d_i - alpha * gamma * |P_i|^(gamma - 1), where
+ *    alpha = m * k^(gamma - 1) / n^gamma, and
+ *  - LDG: d_i * (1 - |P_i| / C),
+ *
+ * and no partition exceeds the capacity C = slack * n / k.
+ *
+ * When `hub_degree_threshold` is set, vertices whose degree exceeds it are
+ * treated as hubs: a hub is placed on the partition with the least edges so
+ * far, and hubs are not counted as neighbors when scoring other vertices, as
+ * a hub's edges would be cut anyway and following them just piles its
+ * neighborhood into a single partition.
+ */
+class FennelPartitionerBase {
+ public:
+  enum class Mode {
+    kFennel = 0,
+    kLDG = 1,
+  };
+
+  void set_mode(const Mode mode) { mode_ = mode; }
+
+  void set_gamma(const double gamma) { gamma_ = gamma; }
+
+  void set_balance_slack(const double slack) { slack_ = slack; }
+
+  void set_hub_degree_threshold(const size_t threshold) {
+    hub_degree_threshold_ = threshold;
+  }
+
+  /// The number of vertices that have been placed as hubs.
+  size_t hub_num() const { return hub_num_; }
+
+ protected:
+  void addEdge(const uint64_t src, const uint64_t dst) {
+    if (src != dst) {
+      edges_.emplace_back(src, dst);
+    }
+  }
+
+  /// Assign the vertices in [0, vnum) to `fnum` partitions, and release the
+  /// collected edges.
+  void partition(const fid_t fnum, const size_t vnum);
+
+  Mode mode_ = Mode::kFennel;
+  double gamma_ = 1.5;
+  double slack_ = 1.1;
+  size_t hub_degree_threshold_ = 0;
+  size_t hub_num_ = 0;
+
+  std::vector<std::pair<uint64_t, uint64_t>> edges_;
+  std::vector<fid_t> assignment_;
+};
+
+/**
+ * @brief A streaming edge-cut partitioner (Fennel, or LDG) that runs as a
+ * pre-pass over the vertices and edges on a single worker, and the resulted
+ * assignment of the vertices is serialized and broadcast to other workers.
+ *
+ * Vertices that are not seen in the pre-pass fall back to hash partitioning.
+ */
+template <typename OID_T>
+class FennelPartitioner : public FennelPartitionerBase {
+ public:
+  using oid_t = OID_T;
+
+  FennelPartitioner() : fnum_(1) {}
+
+  void Init(fid_t fnum) {
+    fnum_ = fnum;
+    fallback_.Init(fnum);
+    o2i_.clear();
+    edges_.clear();
+    assignment_.clear();
+  }
+
+  void AddVertex(const oid_t& oid) { getIndex(oid); }
+
+  void AddEdge(const oid_t& src, const oid_t& dst) {
+    addEdge(getIndex(src), getIndex(dst));
+  }
+
+  void Finalize() { partition(fnum_, o2i_.size()); }
+
+  /// Serialize the assignment after `Finalize()`, i.e., the oids and the
+  /// partitions of them, without the edges.
+  void SerializeAssignment(grape::InArchive& arc) const {
+    arc << static_cast<size_t>(o2i_.size()) << hub_num_;
+    for (auto const& item : o2i_) {
+      arc << item.first << assignment_[item.second];
+    }
+  }
+
+  /// Replace the state of the partitioner with a serialized assignment.
+  void DeserializeAssignment(grape::OutArchive& arc) {
+    size_t vnum = 0;
+    arc >> vnum >> hub_num_;
+    o2i_.clear();
+    o2i_.reserve(vnum);
+    assignment_.resize(vnum);
+    oid_t oid;
+    for (size_t index = 0; index < vnum; ++index) {
+      arc >> oid >> assignment_[index];
+      o2i_.emplace(oid, index);
+    }
+  }
+
+  inline fid_t GetPartitionId(const oid_t& oid) const {
+    auto iter = o2i_.find(oid);
+    if (iter == o2i_.end() || iter->second >= assignment_.size()) {
+      return fallback_.GetPartitionId(oid);
+    }
+    return assignment_[iter->second];
+  }
+
+ private:
+  inline uint64_t getIndex(const oid_t& oid) {
+    return o2i_.emplace(oid, o2i_.size()).first->second;
+  }
+
+  fid_t fnum_;
+  HashPartitioner<oid_t> fallback_;
+  ska::flat_hash_map<oid_t, uint64_t> o2i_;
+};
+
+/**
+ * @brief The `FennelPartitioner` for string oids, which are indexed by views
+ * into blocks owned by the partitioner, thus the lookups of the views during
+ * shuffling don't materialize a `std::string` for each oid.
+ */
+template <>
+class FennelPartitioner<std::string> : public FennelPartitionerBase {
+ public:
+  using oid_t = std::string;
+  using internal_oid_t = InternalType<oid_t>::type;
+
+  FennelPartitioner() : fnum_(1) {}
+
+  void Init(fid_t fnum) {
+    fnum_ = fnum;
+    fallback_.Init(fnum);
+    o2i_.clear();
+    blocks_.clear();
+    block_offset_ = block_capacity_ = 0;
+    edges_.clear();
+    assignment_.clear();
+  }
+
+  void AddVertex(const internal_oid_t& oid) { getIndex(oid); }
+
+  void AddEdge(const internal_oid_t& src, const internal_oid_t& dst) {
+    addEdge(getIndex(src), getIndex(dst));
+  }
+
+  void Finalize() { partition(fnum_, o2i_.size()); }
+
+  /// Serialize the assignment after `Finalize()`, i.e., the oids and the
+  /// partitions of them, without the edges.
+  void SerializeAssignment(grape::InArchive& arc) const {
+    arc << static_cast<size_t>(o2i_.size()) << hub_num_;
+    for (auto const& item : o2i_) {
+      arc << item.first << assignment_[item.second];
+    }
+  }
+
+  /// Replace the state of the partitioner with a serialized assignment, the
+  /// oids are copied into the blocks owned by the partitioner.
+  void DeserializeAssignment(grape::OutArchive& arc) {
+    size_t vnum = 0;
+    arc >> vnum >> hub_num_;
+    o2i_.clear();
+    o2i_.reserve(vnum);
+    blocks_.clear();
+    block_offset_ = block_capacity_ = 0;
+    assignment_.resize(vnum);
+    internal_oid_t oid;
+    for (size_t index = 0; index < vnum; ++index) {
+      arc >> oid >> assignment_[index];
+      o2i_.emplace(store(oid), index);
+    }
+  }
+
+  inline fid_t GetPartitionId(const oid_t& oid) const {
+    return GetPartitionId(internal_oid_t(oid.data(), oid.size()));
+  }
+
+  inline fid_t GetPartitionId(const internal_oid_t& oid) const {
+    auto iter = o2i_.find(oid);
+    if (iter == o2i_.end() || iter->second >= assignment_.size()) {
+      return fallback_.GetPartitionId(oid);
+    }
+    return assignment_[iter->second];
+  }
+
+ private:
+  struct oid_hash_t {
+    inline size_t operator()(const internal_oid_t& oid) const noexcept {
+      return wy::hash<oid_t>()(oid.data(), oid.size());
+    }
+  };
+
+  inline uint64_t getIndex(const internal_oid_t& oid) {
+    auto iter = o2i_.find(oid);
+    if (iter != o2i_.end()) {
+      return iter->second;
+    }
+    uint64_t index = o2i_.size();
+    o2i_.emplace(store(oid), index);
+    return index;
+  }
+
+  /// Copy the oid into the blocks, which are never reallocated, thus the
+  /// views in `o2i_` stay valid.
+  internal_oid_t store(const internal_oid_t& oid) {
+    if (blocks_.empty() || oid.size() > block_capacity_ - block_offset_) {
+      block_capacity_ =
+          oid.size() > default_block_size ? oid.size() : default_block_size;
+      block_offset_ = 0;
+      blocks_.emplace_back(new char[block_capacity_]);
+    }
+    char* data = blocks_.back().get() + block_offset_;
+    if (oid.size() != 0) {
+      memcpy(data, oid.data(), oid.size());
+    }
+    block_offset_ += oid.size();
+    return internal_oid_t(data, oid.size());
+  }
+
+  static constexpr size_t default_block_size = 4 * 1024 * 1024;
+
+  fid_t fnum_;
+  HashPartitioner<oid_t> fallback_;
+  ska::flat_hash_map<internal_oid_t, uint64_t, oid_hash_t> o2i_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  size_t block_offset_ = 0, block_capacity_ = 0;
+};
+
 }  // namespace vineyard
 
 #endif  // MODULES_GRAPH_UTILS_PARTITIONER_H_
@@ -0,0 +1,169 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_UTILS_STREAM_VBYTE_H_
+#define MODULES_GRAPH_UTILS_STREAM_VBYTE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// the SSSE3 decoder is compiled with the target attribute, and chosen at
+// runtime, as SSSE3 is not enabled by the default compiler flags on x86-64
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VINEYARD_STREAM_VBYTE_SSSE3 1
+#include <tmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace vineyard {
+
+/**
+ * @brief StreamVByte encoding of 32-bit integers: the 2-bit lengths of the
+ * values (1 to 4 bytes) are packed into control bytes, which go before the
+ * (little-endian) bytes of the values, thus a group of 4 values can be
+ * decoded by a single shuffle.
+ *
+ * The decoder may read up to `STREAM_VBYTE_PADDING` bytes beyond the end
+ * of the encoded values, the buffer must be padded accordingly.
+ */
+static constexpr size_t STREAM_VBYTE_PADDING = 16;
+
+namespace detail {
+
+struct StreamVByteTables {
+  // the shuffle masks and the data length of each control byte
+  uint8_t shuffles[256][16];
+  uint8_t lengths[256];
+
+  constexpr StreamVByteTables() : shuffles(), lengths() {
+    for (int control = 0; control < 256; ++control) {
+      int offset = 0;
+      for (int i = 0; i < 4; ++i) {
+        int length = ((control >> (2 * i)) & 0x3) + 1;
+        for (int j = 0; j < 4; ++j) {
+          shuffles[control][4 * i + j] =
+              static_cast<uint8_t>(j < length ? offset + j : 0xFF);
+        }
+        offset += length;
+      }
+      lengths[control] = static_cast<uint8_t>(offset);
+    }
+  }
+};
+
+static constexpr StreamVByteTables stream_vbyte_tables{};
+
+#if defined(VINEYARD_STREAM_VBYTE_SSSE3)
+static inline bool stream_vbyte_has_ssse3() {
+#if defined(__SSSE3__)
+  return true;
+#else
+  static const bool has_ssse3 = __builtin_cpu_supports("ssse3");
+  return has_ssse3;
+#endif
+}
+
+// decodes the full groups of 4 values, and returns the number of decoded
+// values
+__attribute__((target("ssse3"))) static inline size_t
+stream_vbyte_decode32_ssse3(const uint8_t* control, const uint8_t*& data,
+                            const size_t n, uint32_t* out) {
+  size_t index = 0;
+  for (; index + 4 <= n; index += 4) {
+    const uint8_t code = control[index / 4];
+    __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i mask = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(stream_vbyte_tables.shuffles[code]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + index),
+                     _mm_shuffle_epi8(values, mask));
+    data += stream_vbyte_tables.lengths[code];
+  }
+  return index;
+}
+#endif
+
+}  // namespace detail
+
+/**
+ * @brief The maximum size of encoding `n` values, excluding the padding.
+ */
+static inline size_t stream_vbyte_bound32(const size_t n) {
+  return (n + 3) / 4 + n * sizeof(uint32_t);
+}
+
+/**
+ * @brief Encode `n` values into `out`, and returns the end of the encoded
+ * bytes.
+ */
+static inline uint8_t* stream_vbyte_encode32(const uint32_t* in,
+                                             const size_t n, uint8_t* out) {
+  uint8_t* control = out;
+  uint8_t* data = out + (n + 3) / 4;
+  memset(control, 0, (n + 3) / 4);
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t value = in[i];
+    const int code = value < (1U << 8)    ? 0
+                     : value < (1U << 16) ? 1
+                     : value < (1U << 24) ? 2
+                                          : 3;
+    control[i / 4] |= static_cast<uint8_t>(code << (2 * (i % 4)));
+    memcpy(data, &value, code + 1);
+    data += code + 1;
+  }
+  return data;
+}
+
+/**
+ * @brief Decode `n` values from `in` into `out`, and returns the end of the
+ * encoded bytes.
+ *
+ * Full groups of 4 values are decoded with SSSE3 (if the CPU supports it)
+ * or NEON shuffles, and the remaining values by the scalar loop.
+ */
+static inline const uint8_t* stream_vbyte_decode32(const uint8_t* in,
+                                                   const size_t n,
+                                                   uint32_t* out) {
+  const uint8_t* control = in;
+  const uint8_t* data = in + (n + 3) / 4;
+  size_t index = 0;
+#if defined(VINEYARD_STREAM_VBYTE_SSSE3)
+  if (detail::stream_vbyte_has_ssse3()) {
+    index = detail::stream_vbyte_decode32_ssse3(control, data, n, out);
+  }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+  for (; index + 4 <= n; index += 4) {
+    const uint8_t code = control[index / 4];
+    uint8x16_t values = vld1q_u8(data);
+    uint8x16_t mask = vld1q_u8(detail::stream_vbyte_tables.shuffles[code]);
+    vst1q_u8(reinterpret_cast<uint8_t*>(out + index),
+             vqtbl1q_u8(values, mask));
+    data += detail::stream_vbyte_tables.lengths[code];
+  }
+#endif
+  for (; index < n; ++index) {
+    const int length = ((control[index / 4] >> (2 * (index % 4))) & 0x3) + 1;
+    uint32_t value = 0;
+    memcpy(&value, data, length);
+    out[index] = value;
+    data += length;
+  }
+  return data;
+}
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_UTILS_STREAM_VBYTE_H_
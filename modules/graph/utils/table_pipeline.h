@@ -19,6 +19,7 @@ limitations under the License.
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <utility>
@@ -95,6 +96,59 @@ class TablePipeline : public ITablePipeline {
   grape::BlockingQueue<std::shared_ptr<arrow::RecordBatch>> batches_;
 };
 
+/**
+ * @brief A pipeline over a stream of record batches, e.g., the blocks of a
+ *        CSV file that are parsed when pulled, thus only one block is in
+ *        memory at a time.
+ *
+ * The length and the number of batches are unknown (-1). If `schema` is
+ * given, the batches are casted to the schema. The `owner` (e.g., the io
+ * adaptor) is kept alive until the pipeline is destroyed.
+ */
+class RecordBatchReaderPipeline : public ITablePipeline {
+ public:
+  explicit RecordBatchReaderPipeline(
+      std::shared_ptr<arrow::RecordBatchReader> reader,
+      const std::shared_ptr<arrow::Schema> schema = nullptr,
+      std::shared_ptr<void> owner = nullptr)
+      : reader_(reader), owner_(owner) {
+    if (schema == nullptr) {
+      schema_ = reader->schema();
+    } else {
+      schema_ = schema;
+      cast_ = !schema->Equals(*reader->schema());
+    }
+  }
+
+  Status Next(std::shared_ptr<arrow::RecordBatch>& batch) override {
+    {
+      // the underlying reader is not thread-safe
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (reader_ == nullptr) {
+        return Status::StreamDrained();
+      }
+      RETURN_ON_ARROW_ERROR(reader_->ReadNext(&batch));
+      if (batch == nullptr) {
+        reader_ = nullptr;
+        owner_ = nullptr;
+        return Status::StreamDrained();
+      }
+    }
+    if (cast_) {
+      std::shared_ptr<arrow::RecordBatch> casted;
+      RETURN_ON_ERROR(CastBatchToSchema(batch, schema_, casted));
+      batch = casted;
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::shared_ptr<arrow::RecordBatchReader> reader_;
+  std::shared_ptr<void> owner_;
+  bool cast_ = false;
+};
+
 class ConcatTablePipeline : public ITablePipeline {
  public:
   explicit ConcatTablePipeline(
@@ -112,8 +166,15 @@ class ConcatTablePipeline : public ITablePipeline {
         continue;
       }
       sources_.push_back(pipe);
-      length_ += pipe->length();
-      num_batches_ += pipe->num_batches();
+      // unknown if any of the sources is a stream
+      if (length_ != -1) {
+        length_ = pipe->length() == -1 ? -1 : length_ + pipe->length();
+      }
+      if (num_batches_ != -1) {
+        num_batches_ = pipe->num_batches() == -1
+                           ? -1
+                           : num_batches_ + pipe->num_batches();
+      }
     }
   }
 
@@ -18,9 +18,14 @@ limitations under the License.
 #include <mpi.h>
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <future>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -727,257 +732,446 @@ void SelectRows(std::shared_ptr<arrow::RecordBatch> record_batch_in,
 #endif
 }
 
-boost::leaf::result<void> ShuffleTableByOffsetLists(
-    const grape::CommSpec& comm_spec,
-    const std::shared_ptr<arrow::Schema> schema,
-    const std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_send,
-    const std::vector<std::vector<std::vector<int64_t>>>& offset_lists,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv) {
-  int worker_id = comm_spec.worker_id();
-  int worker_num = comm_spec.worker_num();
-  size_t record_batches_out_num = record_batches_send.size();
+namespace detail {
 
-  int thread_num =
-      (std::thread::hardware_concurrency() + comm_spec.local_num() - 1) /
-      comm_spec.local_num();
-  int deserialize_thread_num = std::max(1, (thread_num - 2) / 2);
-  int serialize_thread_num =
-      std::max(1, thread_num - 2 - deserialize_thread_num);
-  std::vector<std::thread> serialize_threads(serialize_thread_num);
-  std::vector<std::thread> deserialize_threads(deserialize_thread_num);
+// a shuffled chunk is a header (the size of the payload, or -1 when the
+// sender has finished) followed by the payload
+static constexpr int shuffle_header_tag = 0x5348;
+static constexpr int shuffle_payload_tag = 0x5350;
+// the count of MPI calls is an int, large payloads are sent in pieces
+static constexpr int64_t shuffle_piece_size = 1LL << 30;
+// batches are partitioned into chunks of at most such rows, thus the
+// transfer of the first chunks overlaps with the partitioning of the rest
+static constexpr size_t shuffle_chunk_rows = 64 * 1024;
+// sending blocks when there are more bytes in flight
+static constexpr int64_t shuffle_inflight_bytes = 256LL << 20;
+// the number of partitioned chunks waiting to be sent
+static constexpr size_t shuffle_pending_chunks = 64;
+
+/**
+ * Sends buffers with non-blocking `MPI_Isend`, the buffers are kept alive
+ * until the requests complete.
+ */
+class AsyncBufferSender {
+ public:
+  explicit AsyncBufferSender(MPI_Comm comm) : comm_(comm) {}
+
+  ~AsyncBufferSender() { Flush(); }
+
+  // sends a `nullptr` to tell the receiver that this sender has finished
+  void Send(int dst_worker_id, std::shared_ptr<arrow::Buffer> payload) {
+    std::unique_ptr<message_t> message(new message_t());
+    message->size = payload == nullptr ? -1 : payload->size();
+    message->payload = std::move(payload);
+    message->requests.reserve(
+        1 + (std::max(message->size, static_cast<int64_t>(0)) +
+             shuffle_piece_size - 1) /
+                shuffle_piece_size);
+
+    message->requests.emplace_back();
+    MPI_Isend(&message->size, 1, MPI_INT64_T, dst_worker_id,
+              shuffle_header_tag, comm_, &message->requests.back());
+    for (int64_t offset = 0; offset < message->size;
+         offset += shuffle_piece_size) {
+      int count = static_cast<int>(
+          std::min(shuffle_piece_size, message->size - offset));
+      message->requests.emplace_back();
+      MPI_Isend(message->payload->data() + offset, count, MPI_BYTE,
+                dst_worker_id, shuffle_payload_tag, comm_,
+                &message->requests.back());
+    }
+    inflight_bytes_ += std::max(message->size, static_cast<int64_t>(0));
+    inflight_.emplace_back(std::move(message));
 
-  grape::BlockingQueue<std::pair<grape::fid_t, grape::InArchive>> msg_out;
-  grape::BlockingQueue<grape::OutArchive> msg_in;
+    progress(false);
+    while (inflight_bytes_ > shuffle_inflight_bytes) {
+      progress(true);
+    }
+  }
 
-  msg_out.SetProducerNum(serialize_thread_num);
-  msg_in.SetProducerNum(1);
+  void Flush() {
+    while (!inflight_.empty()) {
+      progress(true);
+    }
+  }
 
-  int64_t record_batches_to_send = static_cast<int64_t>(record_batches_out_num);
-  int64_t total_record_batches;
-  MPI_Allreduce(&record_batches_to_send, &total_record_batches, 1, MPI_INT64_T,
-                MPI_SUM, comm_spec.comm());
-  int64_t record_batches_to_recv =
-      total_record_batches - record_batches_to_send;
+ private:
+  struct message_t {
+    int64_t size;
+    std::shared_ptr<arrow::Buffer> payload;
+    std::vector<MPI_Request> requests;
+  };
 
-  std::thread send_thread([&]() {
-    std::pair<grape::fid_t, grape::InArchive> item;
-    while (msg_out.Get(item)) {
-      int dst_worker_id = comm_spec.FragToWorker(item.first);
-      auto& arc = item.second;
-      grape::sync_comm::Send(arc, dst_worker_id, 0, comm_spec.comm());
+  // reclaims the completed messages, and waits for the oldest one if `wait`
+  void progress(const bool wait) {
+    if (wait && !inflight_.empty()) {
+      auto& requests = inflight_.front()->requests;
+      MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+                  MPI_STATUSES_IGNORE);
     }
-  });
-
-  std::thread recv_thread([&]() {
-    int64_t remaining_msg_num = record_batches_to_recv;
-    while (remaining_msg_num != 0) {
-      MPI_Status status;
-      MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_spec.comm(), &status);
-      grape::OutArchive arc;
-      grape::sync_comm::Recv(arc, status.MPI_SOURCE, 0, comm_spec.comm());
-      msg_in.Put(std::move(arc));
-      --remaining_msg_num;
+    for (auto iter = inflight_.begin(); iter != inflight_.end();) {
+      auto& requests = (*iter)->requests;
+      int completed = 0;
+      MPI_Testall(static_cast<int>(requests.size()), requests.data(),
+                  &completed, MPI_STATUSES_IGNORE);
+      if (completed) {
+        inflight_bytes_ -= std::max((*iter)->size, static_cast<int64_t>(0));
+        iter = inflight_.erase(iter);
+      } else {
+        ++iter;
+      }
     }
-    msg_in.DecProducerNum();
-  });
+  }
 
-  std::atomic<size_t> cur_batch_out(0);
-  for (int i = 0; i != serialize_thread_num; ++i) {
-    serialize_threads[i] = std::thread([&]() {
-      while (true) {
-        size_t got_batch = cur_batch_out.fetch_add(1);
-        if (got_batch >= record_batches_out_num) {
-          break;
+  MPI_Comm comm_;
+  std::list<std::unique_ptr<message_t>> inflight_;
+  int64_t inflight_bytes_ = 0;
+};
+
+/**
+ * Receives the buffers sent by `AsyncBufferSender`s with non-blocking
+ * `MPI_Irecv`, until all the senders have finished.
+ */
+class AsyncBufferReceiver {
+ public:
+  AsyncBufferReceiver(MPI_Comm comm, int senders)
+      : comm_(comm), senders_(senders) {}
+
+  template <typename FUNC_T>
+  void Run(FUNC_T&& on_received) {
+    while (senders_ > 0 || !inflight_.empty()) {
+      bool progressed = false;
+      if (senders_ > 0) {
+        int arrived = 0;
+        MPI_Status status;
+        MPI_Iprobe(MPI_ANY_SOURCE, shuffle_header_tag, comm_, &arrived,
+                   &status);
+        if (arrived) {
+          progressed = true;
+          post(status.MPI_SOURCE);
         }
-        auto cur_rb = record_batches_send[got_batch];
-        auto& cur_offset_lists = offset_lists[got_batch];
-
-        for (int i = 1; i != worker_num; ++i) {
-          int dst_worker_id = (worker_id + i) % worker_num;
-          grape::fid_t dst_fid = comm_spec.WorkerToFrag(dst_worker_id);
-          std::pair<grape::fid_t, grape::InArchive> item;
-          item.first = dst_fid;
-          SerializeSelectedRows(item.second, cur_rb, cur_offset_lists[dst_fid]);
-          msg_out.Put(std::move(item));
+      }
+      for (auto iter = inflight_.begin(); iter != inflight_.end();) {
+        auto& requests = (*iter)->requests;
+        int completed = 0;
+        MPI_Testall(static_cast<int>(requests.size()), requests.data(),
+                    &completed, MPI_STATUSES_IGNORE);
+        if (completed) {
+          progressed = true;
+          on_received(std::move((*iter)->payload));
+          iter = inflight_.erase(iter);
+        } else {
+          ++iter;
         }
       }
-      msg_out.DecProducerNum();
-    });
-  }
-
-  std::atomic<int64_t> cur_batch_in(0);
-  record_batches_recv.resize(record_batches_to_recv);
-  for (int i = 0; i != deserialize_thread_num; ++i) {
-    deserialize_threads[i] = std::thread([&]() {
-      grape::OutArchive arc;
-      while (msg_in.Get(arc)) {
-        int64_t got_batch = cur_batch_in.fetch_add(1);
-        DeserializeSelectedRows(arc, schema, record_batches_recv[got_batch]);
+      if (!progressed) {
+        // blocks rather than spinning: waits for the oldest message, or for
+        // the next header when nothing is in flight
+        if (!inflight_.empty()) {
+          auto& requests = inflight_.front()->requests;
+          MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+                      MPI_STATUSES_IGNORE);
+        } else {
+          MPI_Status status;
+          MPI_Probe(MPI_ANY_SOURCE, shuffle_header_tag, comm_, &status);
+          post(status.MPI_SOURCE);
+        }
       }
-    });
+    }
   }
 
-  send_thread.join();
-  recv_thread.join();
-  for (auto& thrd : serialize_threads) {
-    thrd.join();
-  }
-  for (auto& thrd : deserialize_threads) {
-    thrd.join();
-  }
+ private:
+  struct message_t {
+    std::shared_ptr<arrow::Buffer> payload;
+    std::vector<MPI_Request> requests;
+  };
 
-  for (size_t rb_i = 0; rb_i != record_batches_out_num; ++rb_i) {
-    std::shared_ptr<arrow::RecordBatch> rb;
-    SelectRows(record_batches_send[rb_i], offset_lists[rb_i][comm_spec.fid()],
-               rb);
-    record_batches_recv.emplace_back(std::move(rb));
+  // receives the header and posts the receiving of the payload
+  void post(int src_worker_id) {
+    int64_t size = -1;
+    MPI_Recv(&size, 1, MPI_INT64_T, src_worker_id, shuffle_header_tag, comm_,
+             MPI_STATUS_IGNORE);
+    if (size == -1) {
+      --senders_;
+      return;
+    }
+    std::unique_ptr<message_t> message(new message_t());
+    ARROW_CHECK_OK_AND_ASSIGN(
+        message->payload,
+        arrow::AllocateBuffer(size, arrow::default_memory_pool()));
+    for (int64_t offset = 0; offset < size; offset += shuffle_piece_size) {
+      int count =
+          static_cast<int>(std::min(shuffle_piece_size, size - offset));
+      message->requests.emplace_back();
+      MPI_Irecv(message->payload->mutable_data() + offset, count, MPI_BYTE,
+                src_worker_id, shuffle_payload_tag, comm_,
+                &message->requests.back());
+    }
+    inflight_.emplace_back(std::move(message));
   }
-  MPI_Barrier(comm_spec.comm());
-  return {};
-}
 
-boost::leaf::result<void> ShuffleTableByOffsetLists(
+  MPI_Comm comm_;
+  int senders_;
+  std::list<std::unique_ptr<message_t>> inflight_;
+};
+
+using next_batch_func_t = std::function<Status(
+    std::shared_ptr<arrow::RecordBatch>& batch,
+    std::vector<std::vector<int64_t>>& offset_lists_buffer,
+    const std::vector<std::vector<int64_t>>*& offset_lists)>;
+
+using record_batch_sink_t =
+    std::function<Status(std::shared_ptr<arrow::RecordBatch>&& batch)>;
+
+/**
+ * The shuffle engine: `partition_thread_num` threads pull batches from
+ * `next_batch` and select the rows of each destination into arrow batches,
+ * chunk by chunk, which are serialized (in arrow's IPC format) and sent by
+ * non-blocking MPI calls, and the received chunks are deserialized by
+ * `deserialize_thread_num` threads. All of them run concurrently.
+ *
+ * The batches that belong to this worker are handed to `sink` (from
+ * multiple threads) as soon as they are available.
+ */
+boost::leaf::result<void> shuffle_record_batches(
     const grape::CommSpec& comm_spec,
-    const std::shared_ptr<arrow::Schema> schema,
-    const std::shared_ptr<ITablePipeline>& record_batches_send,
-    std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
-                       std::vector<std::vector<int64_t>>& offset_list)>
-        genoffset,
-    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv) {
+    const std::shared_ptr<arrow::Schema>& schema,
+    const int partition_thread_num, const int deserialize_thread_num,
+    const next_batch_func_t& next_batch, const record_batch_sink_t& sink) {
   int worker_id = comm_spec.worker_id();
   int worker_num = comm_spec.worker_num();
-  size_t record_batches_out_num = record_batches_send->num_batches();
-
-  int thread_num =
-      (std::thread::hardware_concurrency() + comm_spec.local_num() - 1) /
-      comm_spec.local_num();
-  // after pipelining, the serialize thread would be responsible for trigger
-  // the execution of whole pipeline, including things like generate eid,
-  // resolve oid -> gid mapping, etc., and become more computation intensive.
-  int deserialize_thread_num = std::max(1, (thread_num - 2) / 6);
-  int serialize_thread_num =
-      std::max(1, thread_num - 2 - deserialize_thread_num);
-  std::vector<std::thread> serialize_threads(serialize_thread_num);
-  std::vector<std::thread> deserialize_threads(deserialize_thread_num);
 
-  grape::BlockingQueue<std::pair<grape::fid_t, grape::InArchive>> msg_out;
-  grape::BlockingQueue<grape::OutArchive> msg_in;
-
-  msg_out.SetProducerNum(serialize_thread_num);
+  grape::BlockingQueue<std::pair<int, std::shared_ptr<arrow::Buffer>>> msg_out;
+  grape::BlockingQueue<std::shared_ptr<arrow::Buffer>> msg_in;
+  msg_out.SetLimit(shuffle_pending_chunks);
+  msg_out.SetProducerNum(partition_thread_num);
   msg_in.SetProducerNum(1);
 
-  int64_t record_batches_to_send = static_cast<int64_t>(record_batches_out_num);
-  int64_t total_record_batches;
-  MPI_Allreduce(&record_batches_to_send, &total_record_batches, 1, MPI_INT64_T,
-                MPI_SUM, comm_spec.comm());
-  int64_t record_batches_to_recv =
-      total_record_batches - record_batches_to_send;
-
-  // preserve spaces for recv and self-recv
-  record_batches_recv.resize(total_record_batches);
-  VLOG(100) << "[worker-" << comm_spec.worker_id()
-            << "] ShuffleTableByOffsetLists: batches: total = "
-            << total_record_batches << ", to send = " << record_batches_to_send
-            << ", to recv = " << record_batches_to_recv
-            << ", serialization thread: " << serialize_thread_num
-            << ", deserialization thread: " << deserialize_thread_num;
+  std::vector<Status> errors(partition_thread_num + deserialize_thread_num);
 
   std::thread send_thread([&]() {
-    std::pair<grape::fid_t, grape::InArchive> item;
+    AsyncBufferSender sender(comm_spec.comm());
+    std::pair<int, std::shared_ptr<arrow::Buffer>> item;
     while (msg_out.Get(item)) {
-      int dst_worker_id = comm_spec.FragToWorker(item.first);
-      auto& arc = item.second;
-      grape::sync_comm::Send(arc, dst_worker_id, 0, comm_spec.comm());
+      sender.Send(item.first, std::move(item.second));
     }
+    for (int i = 1; i != worker_num; ++i) {
+      sender.Send((worker_id + i) % worker_num, nullptr);
+    }
+    sender.Flush();
   });
 
   std::thread recv_thread([&]() {
-    int64_t remaining_msg_num = record_batches_to_recv;
-    while (remaining_msg_num != 0) {
-      MPI_Status status;
-      MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, comm_spec.comm(), &status);
-      grape::OutArchive arc;
-      grape::sync_comm::Recv(arc, status.MPI_SOURCE, 0, comm_spec.comm());
-      msg_in.Put(std::move(arc));
-      --remaining_msg_num;
-    }
+    AsyncBufferReceiver receiver(comm_spec.comm(), worker_num - 1);
+    receiver.Run([&](std::shared_ptr<arrow::Buffer>&& payload) {
+      msg_in.Put(std::move(payload));
+    });
     msg_in.DecProducerNum();
   });
 
-  // self: starts from `record_batches_to_recv`.
-  std::atomic<int64_t> cur_self_batch_in(record_batches_to_recv);
-  std::vector<vineyard::Status> processing_errors(serialize_thread_num);
-  for (int thread_idx = 0; thread_idx != serialize_thread_num; ++thread_idx) {
-    serialize_threads[thread_idx] = std::thread(
+  std::vector<std::thread> partition_threads(partition_thread_num);
+  for (int thread_idx = 0; thread_idx != partition_thread_num; ++thread_idx) {
+    partition_threads[thread_idx] = std::thread(
         [&](const int thread_index) {
-          std::vector<std::vector<int64_t>> offset_lists(comm_spec.fnum());
+          auto& error = errors[thread_index];
+          std::vector<std::vector<int64_t>> offset_lists_buffer(
+              comm_spec.fnum());
+          std::vector<int64_t> chunk_offsets;
           while (true) {
             std::shared_ptr<arrow::RecordBatch> batch;
-            auto status = record_batches_send->Next(batch);
+            const std::vector<std::vector<int64_t>>* offset_lists = nullptr;
+            auto status = next_batch(batch, offset_lists_buffer, offset_lists);
             if (status.IsStreamDrained()) {
               break;
             }
             if (!status.ok()) {
-              LOG(ERROR) << "Failed to fetch a batch from the table pipeline: "
+              LOG(ERROR) << "Failed to fetch a batch to shuffle: "
                          << status.ToString();
-              processing_errors[thread_index] = Status::Wrap(
-                  status, "Failed to fetch a batch from the table pipeline");
+              error += status;
             }
-            // NB: when error occurs, keep drain the input queue, and generate
-            // empty serialized outputs
-            if (!processing_errors[thread_index].ok()) {
-              batch = nullptr;
+            // NB: when error occurs, keep draining the input
+            if (!error.ok() || batch == nullptr) {
+              continue;
             }
 
-            // generate offset lists
-            genoffset(batch, offset_lists);
-
-            // send to other workers
             for (int i = 1; i != worker_num; ++i) {
               int dst_worker_id = (worker_id + i) % worker_num;
-              grape::fid_t dst_fid = comm_spec.WorkerToFrag(dst_worker_id);
-              std::pair<grape::fid_t, grape::InArchive> item;
-              item.first = dst_fid;
-              SerializeSelectedRows(item.second, batch, offset_lists[dst_fid]);
-              msg_out.Put(std::move(item));
+              auto& offsets =
+                  (*offset_lists)[comm_spec.WorkerToFrag(dst_worker_id)];
+              for (size_t begin = 0; begin < offsets.size();
+                   begin += shuffle_chunk_rows) {
+                size_t end =
+                    std::min(begin + shuffle_chunk_rows, offsets.size());
+                const bool whole = begin == 0 && end == offsets.size();
+                if (!whole) {
+                  chunk_offsets.assign(offsets.begin() + begin,
+                                       offsets.begin() + end);
+                }
+                std::shared_ptr<arrow::RecordBatch> chunk;
+                SelectRows(batch, whole ? offsets : chunk_offsets, chunk);
+                std::shared_ptr<arrow::Buffer> payload;
+                error += SerializeRecordBatch(chunk, &payload);
+                if (error.ok()) {
+                  msg_out.Put(std::make_pair(dst_worker_id, payload));
+                }
+              }
             }
 
-            // select to self and put to recv
-            int64_t got_batch = cur_self_batch_in.fetch_add(1);
-            SelectRows(batch, offset_lists[comm_spec.fid()],
-                       record_batches_recv[got_batch]);
+            std::shared_ptr<arrow::RecordBatch> self_batch;
+            SelectRows(batch, (*offset_lists)[comm_spec.fid()], self_batch);
+            error += sink(std::move(self_batch));
           }
           msg_out.DecProducerNum();
         },
         thread_idx);
   }
 
-  std::atomic<int64_t> cur_batch_in(0);
-  for (int i = 0; i != deserialize_thread_num; ++i) {
-    deserialize_threads[i] = std::thread([&]() {
-      grape::OutArchive arc;
-      while (msg_in.Get(arc)) {
-        int64_t got_batch = cur_batch_in.fetch_add(1);
-        DeserializeSelectedRows(arc, schema, record_batches_recv[got_batch]);
-      }
-    });
+  std::vector<std::thread> deserialize_threads(deserialize_thread_num);
+  for (int thread_idx = 0; thread_idx != deserialize_thread_num;
+       ++thread_idx) {
+    deserialize_threads[thread_idx] = std::thread(
+        [&](const int thread_index) {
+          auto& error = errors[partition_thread_num + thread_index];
+          std::shared_ptr<arrow::Buffer> payload;
+          while (msg_in.Get(payload)) {
+            std::shared_ptr<arrow::RecordBatch> batch;
+            error += DeserializeRecordBatch(payload, &batch);
+            if (batch == nullptr) {
+              continue;
+            }
+            // uses the same schema object for all batches
+            batch = arrow::RecordBatch::Make(schema, batch->num_rows(),
+                                             batch->columns());
+            error += sink(std::move(batch));
+          }
+        },
+        thread_idx);
   }
 
-  send_thread.join();
-  recv_thread.join();
-  for (auto& thrd : serialize_threads) {
+  for (auto& thrd : partition_threads) {
     thrd.join();
   }
+  send_thread.join();
+  recv_thread.join();
   for (auto& thrd : deserialize_threads) {
     thrd.join();
   }
-  vineyard::Status error;
   MPI_Barrier(comm_spec.comm());
-  for (auto& err : processing_errors) {
+
+  Status error;
+  for (auto& err : errors) {
     error += err;
   }
   VY_OK_OR_RAISE(error);
   return {};
 }
 
+}  // namespace detail
+
+boost::leaf::result<void> ShuffleTableByOffsetLists(
+    const grape::CommSpec& comm_spec,
+    const std::shared_ptr<arrow::Schema> schema,
+    const std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_send,
+    const std::vector<std::vector<std::vector<int64_t>>>& offset_lists,
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv) {
+  int thread_num =
+      (std::thread::hardware_concurrency() + comm_spec.local_num() - 1) /
+      comm_spec.local_num();
+  int deserialize_thread_num = std::max(1, (thread_num - 2) / 2);
+  int partition_thread_num =
+      std::max(1, thread_num - 2 - deserialize_thread_num);
+
+  std::atomic<size_t> cur_batch_out(0);
+  auto next_batch =
+      [&](std::shared_ptr<arrow::RecordBatch>& batch,
+          std::vector<std::vector<int64_t>>&,
+          const std::vector<std::vector<int64_t>>*& batch_offset_lists)
+      -> Status {
+    size_t got_batch = cur_batch_out.fetch_add(1);
+    if (got_batch >= record_batches_send.size()) {
+      return Status::StreamDrained();
+    }
+    batch = record_batches_send[got_batch];
+    batch_offset_lists = &offset_lists[got_batch];
+    return Status::OK();
+  };
+
+  record_batches_recv.clear();
+  std::mutex mutex;
+  return detail::shuffle_record_batches(
+      comm_spec, schema, partition_thread_num, deserialize_thread_num,
+      next_batch, [&](std::shared_ptr<arrow::RecordBatch>&& batch) -> Status {
+        std::lock_guard<std::mutex> lock(mutex);
+        record_batches_recv.emplace_back(std::move(batch));
+        return Status::OK();
+      });
+}
+
+boost::leaf::result<void> ShuffleTableByOffsetLists(
+    const grape::CommSpec& comm_spec,
+    const std::shared_ptr<arrow::Schema> schema,
+    const std::shared_ptr<ITablePipeline>& record_batches_send,
+    std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
+                       std::vector<std::vector<int64_t>>& offset_list)>
+        genoffset,
+    std::function<Status(std::shared_ptr<arrow::RecordBatch>&& batch)> sink) {
+  int thread_num =
+      (std::thread::hardware_concurrency() + comm_spec.local_num() - 1) /
+      comm_spec.local_num();
+  // after pipelining, the partition thread would be responsible for trigger
+  // the execution of whole pipeline, including things like generate eid,
+  // resolve oid -> gid mapping, etc., and become more computation intensive.
+  int deserialize_thread_num = std::max(1, (thread_num - 2) / 6);
+  int partition_thread_num =
+      std::max(1, thread_num - 2 - deserialize_thread_num);
+  VLOG(100) << "[worker-" << comm_spec.worker_id()
+            << "] ShuffleTableByOffsetLists: batches to send = "
+            << record_batches_send->num_batches()
+            << ", partition thread: " << partition_thread_num
+            << ", deserialization thread: " << deserialize_thread_num;
+
+  auto next_batch =
+      [&](std::shared_ptr<arrow::RecordBatch>& batch,
+          std::vector<std::vector<int64_t>>& offset_lists_buffer,
+          const std::vector<std::vector<int64_t>>*& batch_offset_lists)
+      -> Status {
+    auto status = record_batches_send->Next(batch);
+    if (status.IsStreamDrained()) {
+      return status;
+    }
+    if (!status.ok()) {
+      return Status::Wrap(status,
+                          "Failed to fetch a batch from the table pipeline");
+    }
+    // generate offset lists
+    genoffset(batch, offset_lists_buffer);
+    batch_offset_lists = &offset_lists_buffer;
+    return Status::OK();
+  };
+
+  return detail::shuffle_record_batches(comm_spec, schema,
+                                        partition_thread_num,
+                                        deserialize_thread_num, next_batch,
+                                        sink);
+}
+
+boost::leaf::result<void> ShuffleTableByOffsetLists(
+    const grape::CommSpec& comm_spec,
+    const std::shared_ptr<arrow::Schema> schema,
+    const std::shared_ptr<ITablePipeline>& record_batches_send,
+    std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
+                       std::vector<std::vector<int64_t>>& offset_list)>
+        genoffset,
+    std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv) {
+  record_batches_recv.clear();
+  std::mutex mutex;
+  return ShuffleTableByOffsetLists(
+      comm_spec, schema, record_batches_send, genoffset,
+      [&](std::shared_ptr<arrow::RecordBatch>&& batch) -> Status {
+        std::lock_guard<std::mutex> lock(mutex);
+        record_batches_recv.emplace_back(std::move(batch));
+        return Status::OK();
+      });
+}
+
 }  // namespace vineyard
@@ -31,6 +31,7 @@ limitations under the License.
 #include "common/util/status.h"
 #include "graph/fragment/property_graph_types.h"
 #include "graph/utils/table_pipeline.h"
+#include "graph/utils/table_spill_buffer.h"
 
 namespace grape {
 class CommSpec;
@@ -265,6 +266,20 @@ boost::leaf::result<void> ShuffleTableByOffsetLists(
         genoffset,
     std::vector<std::shared_ptr<arrow::RecordBatch>>& record_batches_recv);
 
+/**
+ * @brief Shuffle the batches from the pipeline, and hand the received
+ * batches to `sink` (which might be called from multiple threads) as soon as
+ * they arrive, rather than collecting them, e.g., to spill them to disk.
+ */
+boost::leaf::result<void> ShuffleTableByOffsetLists(
+    const grape::CommSpec& comm_spec,
+    const std::shared_ptr<arrow::Schema> schema,
+    const std::shared_ptr<ITablePipeline>& record_batches_send,
+    std::function<void(const std::shared_ptr<arrow::RecordBatch> batch,
+                       std::vector<std::vector<int64_t>>& offset_list)>
+        genoffset,
+    std::function<Status(std::shared_ptr<arrow::RecordBatch>&& batch)> sink);
+
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
@@ -291,6 +306,18 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     int src_col_id, int dst_col_id,
     const std::shared_ptr<ITablePipeline>& table_send);
 
+/**
+ * @brief Shuffle the edges from the pipeline, where the received edges are
+ * collected into `buffer`, which spills to disk once exceeding its memory
+ * budget.
+ */
+template <typename VID_TYPE>
+boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
+    const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
+    int src_col_id, int dst_col_id,
+    const std::shared_ptr<ITablePipeline>& table_send,
+    TableSpillBuffer& buffer);
+
 template <typename PARTITIONER_T>
 boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyVertexTable(
     const grape::CommSpec& comm_spec, const PARTITIONER_T& partitioner,
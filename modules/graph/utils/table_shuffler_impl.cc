@@ -160,6 +160,24 @@ ShufflePropertyEdgeTableByPartition(
     const SegmentedPartitioner<std::string>& partitioner, int src_col_id,
     int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
 
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTableByPartition(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<int32_t>& partitioner, int src_col_id,
+    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTableByPartition(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<int64_t>& partitioner, int src_col_id,
+    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTableByPartition(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<std::string>& partitioner, int src_col_id,
+    int dst_col_id, const std::shared_ptr<arrow::Table>& table_send);
+
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTableByPartition(
     const grape::CommSpec& comm_spec,
@@ -196,6 +214,24 @@ ShufflePropertyEdgeTableByPartition(
     const SegmentedPartitioner<std::string>& partitioner, int src_col_id,
     int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
 
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTableByPartition(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<int32_t>& partitioner, int src_col_id,
+    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTableByPartition(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<int64_t>& partitioner, int src_col_id,
+    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTableByPartition(
+    const grape::CommSpec& comm_spec,
+    const FennelPartitioner<std::string>& partitioner, int src_col_id,
+    int dst_col_id, const std::shared_ptr<ITablePipeline>& table_send);
+
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyEdgeTable<uint32_t>(
     const grape::CommSpec& comm_spec, IdParser<uint32_t>& id_parser,
@@ -220,6 +256,20 @@ ShufflePropertyEdgeTable<uint64_t>(
     int src_col_id, int dst_col_id,
     const std::shared_ptr<ITablePipeline>& table_send);
 
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTable<uint32_t>(
+    const grape::CommSpec& comm_spec, IdParser<uint32_t>& id_parser,
+    int src_col_id, int dst_col_id,
+    const std::shared_ptr<ITablePipeline>& table_send,
+    TableSpillBuffer& buffer);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyEdgeTable<uint64_t>(
+    const grape::CommSpec& comm_spec, IdParser<uint64_t>& id_parser,
+    int src_col_id, int dst_col_id,
+    const std::shared_ptr<ITablePipeline>& table_send,
+    TableSpillBuffer& buffer);
+
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<int32_t>& partitioner,
@@ -250,6 +300,21 @@ ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<std::string>& partitioner,
                            const std::shared_ptr<arrow::Table>& table_send);
 
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
+                           const FennelPartitioner<int32_t>& partitioner,
+                           const std::shared_ptr<arrow::Table>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
+                           const FennelPartitioner<int64_t>& partitioner,
+                           const std::shared_ptr<arrow::Table>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
+                           const FennelPartitioner<std::string>& partitioner,
+                           const std::shared_ptr<arrow::Table>& table_send);
+
 template boost::leaf::result<std::shared_ptr<arrow::Table>>
 ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const HashPartitioner<int32_t>& partitioner,
@@ -280,4 +345,19 @@ ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
                            const SegmentedPartitioner<std::string>& partitioner,
                            const std::shared_ptr<ITablePipeline>& table_send);
 
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
+                           const FennelPartitioner<int32_t>& partitioner,
+                           const std::shared_ptr<ITablePipeline>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
+                           const FennelPartitioner<int64_t>& partitioner,
+                           const std::shared_ptr<ITablePipeline>& table_send);
+
+template boost::leaf::result<std::shared_ptr<arrow::Table>>
+ShufflePropertyVertexTable(const grape::CommSpec& comm_spec,
+                           const FennelPartitioner<std::string>& partitioner,
+                           const std::shared_ptr<ITablePipeline>& table_send);
+
 }  // namespace vineyard
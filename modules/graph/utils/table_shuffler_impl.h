@@ -39,6 +39,7 @@ limitations under the License.
 #include "common/util/status.h"
 #include "graph/fragment/property_graph_types.h"
 #include "graph/utils/error.h"
+#include "graph/utils/table_spill_buffer.h"
 #include "graph/utils/thread_group.h"
 
 namespace vineyard {
@@ -403,6 +404,18 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
     int src_col_id, int dst_col_id,
     const std::shared_ptr<ITablePipeline>& table_send) {
+  // N.B.: we need an empty table for labels that doesn't have effective data.
+  TableSpillBuffer buffer(table_send->schema(), 0);
+  return ShufflePropertyEdgeTable<VID_TYPE>(comm_spec, id_parser, src_col_id,
+                                            dst_col_id, table_send, buffer);
+}
+
+template <typename VID_TYPE>
+boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
+    const grape::CommSpec& comm_spec, IdParser<VID_TYPE>& id_parser,
+    int src_col_id, int dst_col_id,
+    const std::shared_ptr<ITablePipeline>& table_send,
+    TableSpillBuffer& buffer) {
   VY_OK_OR_RAISE(CheckSchemaConsistency(*table_send->schema(), comm_spec));
 
   using vid_array_t = ArrowArrayType<VID_TYPE>;
@@ -443,26 +456,19 @@ boost::leaf::result<std::shared_ptr<arrow::Table>> ShufflePropertyEdgeTable(
     }
   };
 
-  std::vector<std::shared_ptr<arrow::RecordBatch>> batches_recv;
   BOOST_LEAF_CHECK(ShuffleTableByOffsetLists(
-      comm_spec, table_send->schema(), table_send, offsetfn, batches_recv));
-
-  batches_recv.erase(std::remove_if(batches_recv.begin(), batches_recv.end(),
-                                    [](std::shared_ptr<arrow::RecordBatch>& e) {
-                                      return e == nullptr || e->num_rows() == 0;
-                                    }),
-                     batches_recv.end());
+      comm_spec, table_send->schema(), table_send, offsetfn,
+      [&buffer](std::shared_ptr<arrow::RecordBatch>&& batch) -> Status {
+        return buffer.Append(batch);
+      }));
 
   VLOG(100) << "[worker-" << comm_spec.worker_id()
             << "] Edges: after shuffle by offset lists: " << get_rss_pretty()
-            << ", peak = " << get_peak_rss_pretty();
+            << ", peak = " << get_peak_rss_pretty() << ", spilled = "
+            << prettyprint_memory_size(buffer.spilled_bytes());
 
-  // N.B.: we need an empty table for labels that doesn't have effective data.
   std::shared_ptr<arrow::Table> table_out;
-  VY_OK_OR_RAISE(
-      RecordBatchesToTable(table_send->schema(), batches_recv, &table_out));
-  // ARROW_OK_ASSIGN_OR_RAISE(table_out,
-  // table_out->CombineChunks(arrow::default_memory_pool()));
+  VY_OK_OR_RAISE(buffer.Finish(table_out));
   VLOG(100) << "[worker-" << comm_spec.worker_id()
             << "] Edges: after combine chunks: " << get_rss_pretty()
             << ", peak = " << get_peak_rss_pretty();
@@ -0,0 +1,145 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "graph/utils/table_spill_buffer.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow_utils.h"
+#include "common/util/logging.h"
+
+namespace vineyard {
+
+namespace detail {
+
+static size_t array_data_size(const std::shared_ptr<arrow::ArrayData>& data) {
+  if (data == nullptr) {
+    return 0;
+  }
+  size_t size = 0;
+  for (auto const& buffer : data->buffers) {
+    if (buffer != nullptr) {
+      size += buffer->size();
+    }
+  }
+  for (auto const& child : data->child_data) {
+    size += array_data_size(child);
+  }
+  return size + array_data_size(data->dictionary);
+}
+
+static size_t record_batch_size(
+    const std::shared_ptr<arrow::RecordBatch>& batch) {
+  size_t size = 0;
+  for (int i = 0; i < batch->num_columns(); ++i) {
+    size += array_data_size(batch->column_data(i));
+  }
+  return size;
+}
+
+}  // namespace detail
+
+TableSpillBuffer::TableSpillBuffer(const std::shared_ptr<arrow::Schema>& schema,
+                                   const size_t memory_budget,
+                                   const std::string& spill_dir)
+    : schema_(schema), memory_budget_(memory_budget), spill_dir_(spill_dir) {
+  if (spill_dir_.empty()) {
+    const char* tmpdir = std::getenv("TMPDIR");
+    spill_dir_ = (tmpdir != nullptr && tmpdir[0] != '\0') ? tmpdir : "/tmp";
+  }
+}
+
+TableSpillBuffer::~TableSpillBuffer() {
+  for (auto const& path : spill_files_) {
+    unlink(path.c_str());
+  }
+}
+
+Status TableSpillBuffer::Append(
+    const std::shared_ptr<arrow::RecordBatch>& batch) {
+  if (batch == nullptr || batch->num_rows() == 0) {
+    return Status::OK();
+  }
+  size_t size = detail::record_batch_size(batch);
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches_to_spill;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batches_.emplace_back(batch);
+    buffered_bytes_ += size;
+    if (memory_budget_ == 0 || buffered_bytes_ <= memory_budget_) {
+      return Status::OK();
+    }
+    std::swap(batches_, batches_to_spill);
+    spilled_bytes_ += buffered_bytes_;
+    buffered_bytes_ = 0;
+  }
+  return spill(batches_to_spill);
+}
+
+Status TableSpillBuffer::Finish(std::shared_ptr<arrow::Table>& table) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (auto const& path : spill_files_) {
+    std::shared_ptr<arrow::Table> spilled;
+    RETURN_ON_ERROR(ReadTableFromFile(path, &spilled));
+    // the mapping stays valid after the file is unlinked
+    unlink(path.c_str());
+    std::vector<std::shared_ptr<arrow::RecordBatch>> spilled_batches;
+    RETURN_ON_ERROR(TableToRecordBatches(spilled, &spilled_batches));
+    for (auto const& batch : spilled_batches) {
+      // uses the same schema object for all batches
+      batches.emplace_back(arrow::RecordBatch::Make(
+          schema_, batch->num_rows(), batch->columns()));
+    }
+  }
+  spill_files_.clear();
+  batches.insert(batches.end(), batches_.begin(), batches_.end());
+  batches_.clear();
+  buffered_bytes_ = 0;
+  return RecordBatchesToTable(schema_, batches, &table);
+}
+
+Status TableSpillBuffer::spill(
+    const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches) {
+  std::string path = spill_dir_ + "/vineyard-spill-XXXXXX";
+  int fd = mkstemp(&path[0]);
+  if (fd == -1) {
+    return Status::IOError("Failed to create the spill file '" + path +
+                           "': " + strerror(errno));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    spill_files_.emplace_back(path);
+  }
+  auto status = WriteRecordBatchesToFd(schema_, batches, fd, true);
+  if (close(fd) != 0 && status.ok()) {
+    status = Status::IOError("Failed to close the spill file '" + path +
+                             "': " + strerror(errno));
+  }
+  VLOG(10) << "Spilled " << batches.size() << " batches to '" << path << "'";
+  return status;
+}
+
+}  // namespace vineyard
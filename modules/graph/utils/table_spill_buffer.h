@@ -0,0 +1,88 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_UTILS_TABLE_SPILL_BUFFER_H_
+#define MODULES_GRAPH_UTILS_TABLE_SPILL_BUFFER_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "common/util/status.h"
+
+namespace vineyard {
+
+/**
+ * @brief A buffer that collects record batches (e.g., the shuffled edges)
+ * within a memory budget: once the batches in memory exceed the budget, they
+ * are spilled to a temporary file in the arrow IPC file format.
+ *
+ * `Finish()` returns the table of all batches, where the spilled ones are
+ * memory-mapped rather than read back, thus the pages are backed by the
+ * files and can be evicted by the OS under memory pressure.
+ *
+ * `Append()` is thread-safe, and spilling happens outside the lock.
+ */
+class TableSpillBuffer {
+ public:
+  /**
+   * @param memory_budget The maximum bytes of batches kept in memory, 0 means
+   *                      unlimited.
+   * @param spill_dir The directory for the spill files, defaults to $TMPDIR,
+   *                  or "/tmp".
+   */
+  TableSpillBuffer(const std::shared_ptr<arrow::Schema>& schema,
+                   const size_t memory_budget,
+                   const std::string& spill_dir = "");
+
+  TableSpillBuffer(const TableSpillBuffer&) = delete;
+  TableSpillBuffer& operator=(const TableSpillBuffer&) = delete;
+
+  ~TableSpillBuffer();
+
+  Status Append(const std::shared_ptr<arrow::RecordBatch>& batch);
+
+  /**
+   * @brief Collect all batches (both in memory and spilled) as a table, the
+   * spill files are unlinked but stay mapped as long as the table is alive.
+   */
+  Status Finish(std::shared_ptr<arrow::Table>& table);
+
+  const std::shared_ptr<arrow::Schema>& schema() const { return schema_; }
+
+  size_t spilled_bytes() const { return spilled_bytes_; }
+
+  size_t spilled_files() const { return spill_files_.size(); }
+
+ private:
+  Status spill(const std::vector<std::shared_ptr<arrow::RecordBatch>>& batches);
+
+  std::shared_ptr<arrow::Schema> schema_;
+  size_t memory_budget_;
+  std::string spill_dir_;
+
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches_;
+  size_t buffered_bytes_ = 0;
+  size_t spilled_bytes_ = 0;
+  std::vector<std::string> spill_files_;
+};
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_UTILS_TABLE_SPILL_BUFFER_H_
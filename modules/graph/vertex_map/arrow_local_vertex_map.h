@@ -28,12 +28,14 @@ limitations under the License.
 
 #include "basic/ds/array.h"
 #include "basic/ds/arrow.h"
+#include "basic/ds/compressed_string_array.h"
 #include "basic/ds/hashmap.h"
 #include "client/client.h"
 #include "common/util/functions.h"
 #include "common/util/typename.h"
 
 #include "graph/fragment/property_graph_types.h"
+#include "graph/vertex_map/compressed_oids.h"
 
 namespace grape {
 class CommSpec;
@@ -67,14 +69,34 @@ class ArrowLocalVertexMap
 
   void Construct(const vineyard::ObjectMeta& meta);
 
+  /**
+   * @brief Get the oid of the given gid, as a view into the oid arrays.
+   *
+   * When the oids are compressed, the oids of the fragment and label are
+   * decompressed on the first request and kept for the views, prefer the
+   * `std::string` overload to keep the memory compressed.
+   */
   bool GetOid(vid_t gid, oid_t& oid) const;
 
+  /**
+   * @brief Get the string oid of the given gid, which is decompressed when
+   * the oids are compressed.
+   */
+  template <typename T = OID_T,
+            typename std::enable_if<
+                std::is_same<T, arrow_string_view>::value>::type* = nullptr>
+  bool GetOid(vid_t gid, std::string& oid) const;
+
   bool GetGid(fid_t fid, label_id_t label_id, oid_t oid, vid_t& gid) const;
 
   bool GetGid(label_id_t label_id, oid_t oid, vid_t& gid) const;
 
   std::vector<OID_T> GetOids(fid_t fid, label_id_t label_id) const;
 
+  /**
+   * @brief Get the oids of the current fragment, which are decompressed into
+   * a new array when the oids are compressed.
+   */
   std::shared_ptr<oid_array_t> GetOidArray(fid_t fid,
                                            label_id_t label_id) const;
 
@@ -82,6 +104,8 @@ class ArrowLocalVertexMap
 
   bool use_perfect_hash() const { return false; }
 
+  bool compress_oids() const { return compress_oids_; }
+
   size_t GetTotalNodesNum() const;
 
   size_t GetTotalNodesNum(label_id_t label) const;
@@ -134,6 +158,15 @@ class ArrowLocalVertexMap
 
   std::vector<std::vector<vid_t>> vertices_num_;
 
+  // frag->label->oid, replaces both the oid arrays and the o2i maps when
+  // the string oids are compressed
+  bool compress_oids_ = false;
+  std::vector<std::vector<std::shared_ptr<CompressedStringArray>>>
+      compressed_oids_;
+  // frag->label->index, of the compressed oids of other fragments
+  std::vector<std::vector<std::shared_ptr<Array<vid_t>>>> compressed_indices_;
+  mutable detail::DecodedOidArrays<oid_array_t> decoded_oids_;
+
   friend class ArrowLocalVertexMapBuilder<OID_T, VID_T>;
 };
 
@@ -159,6 +192,14 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
   Status _Seal(vineyard::Client& client,
                std::shared_ptr<vineyard::Object>& object) override;
 
+  /**
+   * @brief Keep the string oids in `CompressedStringArray`s, which serve as
+   * both the oid arrays and the oid to index maps, instead of arrow arrays
+   * and hashmaps. Ignored for other oid types, and must be set before adding
+   * any vertices.
+   */
+  void set_compress_oids(const bool compress_oids);
+
   vineyard::Status AddLocalVertices(
       grape::CommSpec& comm_spec,
       std::vector<std::shared_ptr<oid_array_t>> oid_arrays);
@@ -190,6 +231,10 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
       grape::CommSpec& comm_spec,
       std::vector<std::vector<std::shared_ptr<oid_array_t>>> oid_arrays);
 
+  vineyard::Status addCompressedOuterVerticesMapping(
+      fid_t fid, label_id_t label, std::shared_ptr<oid_array_t> oids,
+      std::vector<vid_t> index_list);
+
   vineyard::Client& client;
   fid_t fnum_, fid_;
   label_id_t label_num_;
@@ -211,6 +256,11 @@ class ArrowLocalVertexMapBuilder : public vineyard::ObjectBuilder {
       i2o_index_;
 
   std::vector<std::vector<vid_t>> vertices_num_;
+
+  bool compress_oids_ = false;
+  std::vector<std::vector<std::shared_ptr<CompressedStringArray>>>
+      compressed_oids_;
+  std::vector<std::vector<std::shared_ptr<Array<vid_t>>>> compressed_indices_;
 };
 
 template <typename T>
@@ -39,6 +39,7 @@ limitations under the License.
 #include "graph/fragment/property_graph_utils.h"
 #include "graph/utils/thread_group.h"
 #include "graph/vertex_map/arrow_local_vertex_map.h"
+#include "graph/vertex_map/compressed_oids.h"
 
 namespace vineyard {
 
@@ -51,6 +52,11 @@ void ArrowLocalVertexMap<OID_T, VID_T>::Construct(
   this->fnum_ = meta.GetKeyValue<fid_t>("fnum");
   this->fid_ = meta.GetKeyValue<fid_t>("fid");
   this->label_num_ = meta.GetKeyValue<label_id_t>("label_num");
+  if (meta.HasKey("compress_oids_")) {
+    meta.GetKeyValue<bool>("compress_oids_", this->compress_oids_);
+  } else {
+    this->compress_oids_ = false;
+  }
 
   id_parser_.Init(fnum_, label_num_);
 
@@ -63,14 +69,41 @@ void ArrowLocalVertexMap<OID_T, VID_T>::Construct(
   i2o_.resize(fnum_);
   i2o_index_.resize(fnum_);
   vertices_num_.resize(fnum_);
+  compressed_oids_.resize(fnum_);
+  compressed_indices_.resize(fnum_);
+  decoded_oids_.Init(fnum_, label_num_);
   for (fid_t fid = 0; fid < fnum_; ++fid) {
     oid_arrays_[fid].resize(label_num_);
     o2i_[fid].resize(label_num_);
     i2o_[fid].resize(label_num_);
     i2o_index_[fid].resize(label_num_);
     vertices_num_[fid].resize(label_num_);
+    compressed_oids_[fid].resize(label_num_);
+    compressed_indices_[fid].resize(label_num_);
     for (label_id_t label = 0; label < label_num_; ++label) {
       std::string suffix = std::to_string(fid) + "_" + std::to_string(label);
+      vertices_num_[fid][label] =
+          meta.GetKeyValue<vid_t>("vertices_num_" + suffix);
+
+      if (compress_oids_) {
+        compressed_oids_[fid][label] =
+            std::dynamic_pointer_cast<CompressedStringArray>(
+                meta.GetMember("compressed_oids_" + suffix));
+        local_oid_total += compressed_oids_[fid][label]->nbytes();
+        if (fid != fid_) {
+          compressed_indices_[fid][label] =
+              std::dynamic_pointer_cast<Array<vid_t>>(
+                  meta.GetMember("compressed_indices_" + suffix));
+          local_oid_total += compressed_indices_[fid][label]->nbytes();
+
+          i2o_index_[fid][label].Construct(
+              meta.GetMemberMeta("i2o_index_" + suffix));
+          i2o_size += i2o_index_[fid][label].size();
+          i2o_total_bytes += i2o_index_[fid][label].nbytes();
+          i2o_bucket_count += i2o_index_[fid][label].bucket_count();
+        }
+        continue;
+      }
 
       typename InternalType<oid_t>::vineyard_array_type array;
       array.Construct(meta.GetMemberMeta("oid_arrays_" + suffix));
@@ -94,9 +127,6 @@ void ArrowLocalVertexMap<OID_T, VID_T>::Construct(
       o2i_size += o2i_[fid][label].size();
       o2i_total_bytes += o2i_[fid][label].nbytes();
       o2i_bucket_count += o2i_[fid][label].bucket_count();
-
-      vertices_num_[fid][label] =
-          meta.GetKeyValue<vid_t>("vertices_num_" + suffix);
     }
   }
   nbytes = local_oid_total + o2i_total_bytes + i2o_total_bytes;
@@ -121,6 +151,24 @@ bool ArrowLocalVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
   fid_t fid = id_parser_.GetFid(gid);
   label_id_t label = id_parser_.GetLabelId(gid);
   int64_t offset = id_parser_.GetOffset(gid);
+  if (fid < fnum_ && label < label_num_ && label >= 0 && compress_oids_) {
+    // the position of the oid in the compressed oid array
+    int64_t position = offset;
+    if (fid == fid_) {
+      if (offset >= static_cast<int64_t>(vertices_num_[fid][label])) {
+        return false;
+      }
+    } else {
+      auto iter = i2o_index_[fid][label].find(offset);
+      if (iter == i2o_index_[fid][label].end()) {
+        return false;
+      }
+      position = iter->second;
+    }
+    oid = decoded_oids_.Get(fid, label, *compressed_oids_[fid][label])
+              ->GetView(position);
+    return true;
+  }
   if (fid < fnum_ && label < label_num_ && label >= 0) {
     if (fid == fid_) {
       if (offset < oid_arrays_[fid][label]->length()) {
@@ -148,9 +196,53 @@ bool ArrowLocalVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
   return false;
 }
 
+template <typename OID_T, typename VID_T>
+template <typename T, typename std::enable_if<
+                          std::is_same<T, arrow_string_view>::value>::type*>
+bool ArrowLocalVertexMap<OID_T, VID_T>::GetOid(vid_t gid,
+                                               std::string& oid) const {
+  fid_t fid = id_parser_.GetFid(gid);
+  label_id_t label = id_parser_.GetLabelId(gid);
+  int64_t offset = id_parser_.GetOffset(gid);
+  if (fid >= fnum_ || label >= label_num_ || label < 0) {
+    return false;
+  }
+  // the position of the oid in the (compressed) oid array
+  int64_t position = offset;
+  if (fid == fid_) {
+    if (offset >= static_cast<int64_t>(vertices_num_[fid][label])) {
+      return false;
+    }
+  } else {
+    auto iter = i2o_index_[fid][label].find(offset);
+    if (iter == i2o_index_[fid][label].end()) {
+      return false;
+    }
+    position = iter->second;
+  }
+  if (compress_oids_) {
+    compressed_oids_[fid][label]->GetString(position, oid);
+  } else {
+    auto view = oid_arrays_[fid][label]->GetView(position);
+    oid.assign(view.data(), view.size());
+  }
+  return true;
+}
+
 template <typename OID_T, typename VID_T>
 bool ArrowLocalVertexMap<OID_T, VID_T>::GetGid(fid_t fid, label_id_t label_id,
                                                oid_t oid, vid_t& gid) const {
+  if (compress_oids_) {
+    int64_t position =
+        detail::find_compressed_oid(*compressed_oids_[fid][label_id], oid);
+    if (position == -1) {
+      return false;
+    }
+    vid_t index = fid == fid_ ? static_cast<vid_t>(position)
+                              : (*compressed_indices_[fid][label_id])[position];
+    gid = id_parser_.GenerateId(fid, label_id, index);
+    return true;
+  }
   auto iter = o2i_[fid][label_id].find(oid);
   if (iter != o2i_[fid][label_id].end()) {
     gid = id_parser_.GenerateId(fid, label_id, iter->second);
@@ -174,8 +266,13 @@ template <typename OID_T, typename VID_T>
 std::vector<OID_T> ArrowLocalVertexMap<OID_T, VID_T>::GetOids(
     fid_t fid, label_id_t label_id) const {
   CHECK(fid == fid_);
-  auto array = oid_arrays_[fid][label_id];
   std::vector<oid_t> oids;
+  if (compress_oids_) {
+    LOG(ERROR) << "ArrowLocalVertexMap cannot return the views of compressed "
+               << "oids, use GetOidArray instead";
+    return oids;
+  }
+  auto array = oid_arrays_[fid][label_id];
 
   oids.resize(array->length());
   for (auto i = 0; i < array->length(); i++) {
@@ -190,6 +287,12 @@ std::shared_ptr<ArrowArrayType<OID_T>>
 ArrowLocalVertexMap<OID_T, VID_T>::GetOidArray(fid_t fid,
                                                label_id_t label_id) const {
   CHECK(fid == fid_);
+  if (compress_oids_) {
+    std::shared_ptr<oid_array_t> array;
+    VINEYARD_CHECK_OK(detail::decode_compressed_oids(
+        *compressed_oids_[fid][label_id], array));
+    return array;
+  }
   return oid_arrays_[fid][label_id];
 }
 
@@ -284,13 +387,28 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::ArrowLocalVertexMapBuilder(
     }
   }
   vertices_num_.resize(fnum_);
+  compressed_oids_.resize(fnum_);
+  compressed_indices_.resize(fnum_);
   for (fid_t fid = 0; fid < fnum_; ++fid) {
     vertices_num_[fid].resize(label_num_);
+    compressed_oids_[fid].resize(label_num_);
+    compressed_indices_[fid].resize(label_num_);
   }
 
   id_parser_.Init(fnum_, label_num_);
 }
 
+template <typename OID_T, typename VID_T>
+void ArrowLocalVertexMapBuilder<OID_T, VID_T>::set_compress_oids(
+    const bool compress_oids) {
+  if (compress_oids && !std::is_same<oid_t, arrow_string_view>::value) {
+    LOG(WARNING) << "Only string oids can be compressed, ignored for "
+                 << type_name<oid_t>();
+    return;
+  }
+  compress_oids_ = compress_oids;
+}
+
 template <typename OID_T, typename VID_T>
 vineyard::Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::Build(
     vineyard::Client& client) {
@@ -311,11 +429,12 @@ Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::_Seal(
   object = vertex_map;
 
   vertex_map->fnum_ = fnum_;
+  vertex_map->fid_ = fid_;
   vertex_map->label_num_ = label_num_;
   vertex_map->id_parser_.Init(fnum_, label_num_);
 
   vertex_map->oid_arrays_.resize(fnum_);
-  for (fid_t fid = 0; fid < fnum_; ++fid) {
+  for (fid_t fid = 0; fid < fnum_ && !compress_oids_; ++fid) {
     auto& arrays = vertex_map->oid_arrays_[fid];
     arrays.resize(label_num_);
     for (label_id_t label = 0; label < label_num_; ++label) {
@@ -327,17 +446,39 @@ Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::_Seal(
   vertex_map->i2o_ = i2o_;
   vertex_map->i2o_index_ = i2o_index_;
   vertex_map->vertices_num_ = vertices_num_;
+  vertex_map->compress_oids_ = compress_oids_;
+  vertex_map->compressed_oids_ = compressed_oids_;
+  vertex_map->compressed_indices_ = compressed_indices_;
+  vertex_map->decoded_oids_.Init(fnum_, label_num_);
 
   vertex_map->meta_.SetTypeName(type_name<ArrowLocalVertexMap<oid_t, vid_t>>());
 
   vertex_map->meta_.AddKeyValue("fnum", fnum_);
   vertex_map->meta_.AddKeyValue("fid", fid_);
   vertex_map->meta_.AddKeyValue("label_num", label_num_);
+  vertex_map->meta_.AddKeyValue("compress_oids_", compress_oids_);
 
   size_t nbytes = 0;
   for (fid_t fid = 0; fid < fnum_; ++fid) {
     for (label_id_t label = 0; label < label_num_; ++label) {
       std::string suffix = std::to_string(fid) + "_" + std::to_string(label);
+      vertex_map->meta_.AddKeyValue("vertices_num_" + suffix,
+                                    vertices_num_[fid][label]);
+
+      if (compress_oids_) {
+        vertex_map->meta_.AddMember("compressed_oids_" + suffix,
+                                    compressed_oids_[fid][label]->meta());
+        nbytes += compressed_oids_[fid][label]->nbytes();
+        if (fid != fid_) {
+          vertex_map->meta_.AddMember("compressed_indices_" + suffix,
+                                      compressed_indices_[fid][label]->meta());
+          nbytes += compressed_indices_[fid][label]->nbytes();
+          vertex_map->meta_.AddMember("i2o_index_" + suffix,
+                                      i2o_index_[fid][label].meta());
+          nbytes += i2o_index_[fid][label].nbytes();
+        }
+        continue;
+      }
 
       vertex_map->meta_.AddMember("oid_arrays_" + suffix,
                                   oid_arrays_[fid][label].meta());
@@ -352,8 +493,6 @@ Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::_Seal(
                                     i2o_index_[fid][label].meta());
         nbytes += i2o_index_[fid][label].nbytes();
       }
-      vertex_map->meta_.AddKeyValue("vertices_num_" + suffix,
-                                    vertices_num_[fid][label]);
     }
   }
 
@@ -395,8 +534,20 @@ template <typename OID_T, typename VID_T>
 vineyard::Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::addLocalVertices(
     grape::CommSpec& comm_spec,
     std::vector<std::vector<std::shared_ptr<oid_array_t>>> oid_arrays) {
+  // the threads are split among the labels to avoid oversubscription
+  const int concurrency = std::max<int>(
+      std::thread::hardware_concurrency() / std::max<int>(label_num_, 1), 1);
   auto fn = [&](label_id_t label) -> Status {
     auto& arrays = oid_arrays[label];
+    if (compress_oids_) {
+      // the index of an oid is its position in the compressed array
+      auto& compressed = compressed_oids_[fid_][label];
+      RETURN_ON_ERROR(detail::build_compressed_oids(client, arrays,
+                                                    concurrency, compressed));
+      arrays.clear();
+      vertices_num_[fid_][label] = compressed->length();
+      return Status::OK();
+    }
     typename InternalType<oid_t>::vineyard_builder_type array_builder(client,
                                                                       arrays);
     std::shared_ptr<Object> object;
@@ -462,6 +613,18 @@ vineyard::Status ArrowLocalVertexMapBuilder<OID_T, VID_T>::GetIndexOfOids(
     auto& current_index_list = index_list[label_id];
     current_index_list.resize(current_oids->length());
 
+    if (compress_oids_) {
+      auto& compressed = *compressed_oids_[fid_][label_id];
+      parallel_for(
+          static_cast<int64_t>(0), current_oids->length(),
+          [&](const size_t& i) {
+            current_index_list[i] = static_cast<vid_t>(
+                detail::find_compressed_oid(compressed,
+                                            current_oids->GetView(i)));
+          },
+          std::thread::hardware_concurrency());
+      continue;
+    }
     parallel_for(
         static_cast<int64_t>(0), current_oids->length(),
         [&](const size_t& i) {
@@ -547,6 +710,11 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
     std::vector<std::vector<std::shared_ptr<ArrowArrayType<OID_TYPE>>>> oids,
     std::vector<std::vector<std::vector<vid_t>>> index_list) {
   auto fn = [&](fid_t cur_fid, label_id_t cur_label) -> Status {
+    if (compress_oids_) {
+      return addCompressedOuterVerticesMapping(
+          cur_fid, cur_label, std::move(oids[cur_fid][cur_label]),
+          std::move(index_list[cur_fid][cur_label]));
+    }
     typename InternalType<oid_t>::vineyard_builder_type outer_oid_builder(
         client, oids[cur_fid][cur_label]);
     std::shared_ptr<Object> object;
@@ -607,6 +775,35 @@ ArrowLocalVertexMapBuilder<OID_T, VID_T>::AddOuterVerticesMapping(
   return status;
 }
 
+template <typename OID_T, typename VID_T>
+vineyard::Status
+ArrowLocalVertexMapBuilder<OID_T, VID_T>::addCompressedOuterVerticesMapping(
+    fid_t fid, label_id_t label, std::shared_ptr<oid_array_t> oids,
+    std::vector<vid_t> index_list) {
+  // the outer oids are compressed in the order of arrival, and the indices
+  // of the positions are kept aside
+  RETURN_ON_ERROR(detail::build_compressed_oids(
+      client, std::vector<std::shared_ptr<oid_array_t>>{oids}, 1,
+      compressed_oids_[fid][label]));
+  oids.reset();
+
+  std::shared_ptr<Object> object;
+  vineyard::HashmapBuilder<vid_t, vid_t> i2o_index_builder(client);
+  i2o_index_builder.reserve(index_list.size());
+  for (size_t i = 0; i < index_list.size(); ++i) {
+    i2o_index_builder.emplace(index_list[i], static_cast<vid_t>(i));
+  }
+  RETURN_ON_ERROR(i2o_index_builder.Seal(client, object));
+  i2o_index_[fid][label] =
+      *std::dynamic_pointer_cast<vineyard::Hashmap<vid_t, vid_t>>(object);
+
+  ArrayBuilder<vid_t> indices_builder(client, index_list);
+  RETURN_ON_ERROR(indices_builder.Seal(client, object));
+  compressed_indices_[fid][label] =
+      std::dynamic_pointer_cast<Array<vid_t>>(object);
+  return Status::OK();
+}
+
 }  // namespace vineyard
 
 #endif  // MODULES_GRAPH_VERTEX_MAP_ARROW_LOCAL_VERTEX_MAP_IMPL_H_
@@ -19,6 +19,10 @@ namespace vineyard {
 
 template class ArrowLocalVertexMap<arrow_string_view, uint64_t>;
 
+template bool
+ArrowLocalVertexMap<arrow_string_view, uint64_t>::GetOid<arrow_string_view>(
+    uint64_t gid, std::string& oid) const;
+
 template class ArrowLocalVertexMapBuilder<arrow_string_view, uint64_t>;
 
 template Status ArrowLocalVertexMapBuilder<arrow_string_view, uint64_t>::
@@ -30,6 +34,10 @@ template Status ArrowLocalVertexMapBuilder<arrow_string_view, uint64_t>::
 
 template class ArrowLocalVertexMap<arrow_string_view, uint32_t>;
 
+template bool
+ArrowLocalVertexMap<arrow_string_view, uint32_t>::GetOid<arrow_string_view>(
+    uint32_t gid, std::string& oid) const;
+
 template class ArrowLocalVertexMapBuilder<arrow_string_view, uint32_t>;
 
 template Status ArrowLocalVertexMapBuilder<arrow_string_view, uint32_t>::
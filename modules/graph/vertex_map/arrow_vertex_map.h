@@ -20,16 +20,19 @@ limitations under the License.
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "basic/ds/arrow.h"
+#include "basic/ds/compressed_string_array.h"
 #include "basic/ds/hashmap.h"
 #include "client/client.h"
 #include "common/util/typename.h"
 
 #include "graph/fragment/graph_schema.h"
 #include "graph/fragment/property_graph_types.h"
+#include "graph/vertex_map/compressed_oids.h"
 
 namespace vineyard {
 
@@ -63,20 +66,64 @@ class ArrowVertexMap
 
   void Construct(const vineyard::ObjectMeta& meta);
 
+  /**
+   * @brief Get the oid of the given gid, as a view into the oid arrays.
+   *
+   * When the oids are compressed, the oids of the fragment and label are
+   * decompressed on the first request and kept for the views, prefer the
+   * `std::string` overload to keep the memory compressed.
+   */
   bool GetOid(vid_t gid, oid_t& oid) const;
 
+  /**
+   * @brief Get the string oid of the given gid, which is decompressed when
+   * the oids are compressed.
+   */
+  template <typename T = OID_T,
+            typename std::enable_if<
+                std::is_same<T, arrow_string_view>::value>::type* = nullptr>
+  bool GetOid(vid_t gid, std::string& oid) const;
+
   bool GetGid(fid_t fid, label_id_t label_id, oid_t oid, vid_t& gid) const;
 
   bool GetGid(label_id_t label_id, oid_t oid, vid_t& gid) const;
 
+  /**
+   * @brief Resolve the gids of a batch of oids of the given label, where the
+   * i-th oid is looked up in the fragment `fids[i]`.
+   *
+   * The buckets of a group of oids are hashed and prefetched together before
+   * being probed, and the batch is split into chunks that are resolved by
+   * `concurrency` threads. An `ObjectNotExists` error is returned if any of
+   * the oids cannot be found.
+   */
+  Status GetGids(label_id_t label_id, const std::shared_ptr<oid_array_t>& oids,
+                 const std::vector<fid_t>& fids,
+                 std::shared_ptr<ArrowArrayType<vid_t>>& gids,
+                 const int concurrency = 1) const;
+
+  /**
+   * @brief Resolve the gids of a batch of oids of the given label, which are
+   * looked up in all fragments.
+   */
+  Status GetGids(label_id_t label_id, const std::shared_ptr<oid_array_t>& oids,
+                 std::shared_ptr<ArrowArrayType<vid_t>>& gids,
+                 const int concurrency = 1) const;
+
   std::vector<OID_T> GetOids(fid_t fid, label_id_t label_id) const;
 
+  /**
+   * @brief Get the oids of the given fragment and label, which are
+   * decompressed into a new array when the oids are compressed.
+   */
   std::shared_ptr<oid_array_t> GetOidArray(fid_t fid, label_id_t label_id);
 
   fid_t fnum() const { return fnum_; }
 
   bool use_perfect_hash() const { return use_perfect_hash_; }
 
+  bool compress_oids() const { return compress_oids_; }
+
   size_t GetTotalNodesNum() const;
 
   size_t GetTotalNodesNum(label_id_t label) const;
@@ -136,6 +183,27 @@ class ArrowVertexMap
           oid_arrays);
 
  private:
+  Status getGids(label_id_t label_id, const std::shared_ptr<oid_array_t>& oids,
+                 const fid_t* fids,
+                 std::shared_ptr<ArrowArrayType<vid_t>>& gids,
+                 const int concurrency) const;
+
+  template <typename MAP_T>
+  void getGidsInRange(const std::vector<std::vector<MAP_T>>& o2g,
+                      label_id_t label_id, const oid_array_t& oids,
+                      const fid_t* fids, const fid_t fid, const int64_t begin,
+                      const int64_t end, vid_t* gids, uint8_t* found) const;
+
+  void getCompressedGidsInRange(label_id_t label_id, const oid_array_t& oids,
+                                const fid_t* fids, const fid_t fid,
+                                const int64_t begin, const int64_t end,
+                                vid_t* gids, uint8_t* found) const;
+
+  int64_t oid_num(fid_t fid, label_id_t label_id) const {
+    return compress_oids_ ? compressed_oids_[fid][label_id]->length()
+                          : oid_arrays_[fid][label_id]->length();
+  }
+
   ObjectID addNewVertexLabels(
       Client& client,
       std::vector<std::vector<std::vector<std::shared_ptr<oid_array_t>>>>
@@ -148,6 +216,7 @@ class ArrowVertexMap
   fid_t fnum_;
   label_id_t label_num_;
   bool use_perfect_hash_;
+  bool compress_oids_ = false;
 
   vineyard::IdParser<vid_t> id_parser_;
 
@@ -156,6 +225,12 @@ class ArrowVertexMap
   std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2g_;
   std::vector<std::vector<vineyard::PerfectHashmap<oid_t, vid_t>>> o2g_p_;
 
+  // frag->label->oid, replaces both the oid arrays and the o2g maps when
+  // the oids are compressed, as the gid offset is the index of the oid
+  std::vector<std::vector<std::shared_ptr<CompressedStringArray>>>
+      compressed_oids_;
+  mutable detail::DecodedOidArrays<oid_array_t> decoded_oids_;
+
   friend class ArrowVertexMapBuilder<OID_T, VID_T>;
   friend class BasicArrowVertexMapBuilder<OID_T, VID_T>;
 };
@@ -196,8 +271,14 @@ class ArrowVertexMapBuilder : public vineyard::ObjectBuilder {
       fid_t fid, label_id_t label,
       const std::shared_ptr<vineyard::PerfectHashmap<oid_t, vid_t>>& rm);
 
+  void set_compressed_oids(
+      fid_t fid, label_id_t label,
+      const std::shared_ptr<CompressedStringArray>& compressed);
+
   void set_perfect_hash_(const bool use_perfect_hash = false);
 
+  void set_compress_oids_(const bool compress_oids = false);
+
   Status _Seal(vineyard::Client& client,
                std::shared_ptr<vineyard::Object>& object) override;
 
@@ -205,11 +286,14 @@ class ArrowVertexMapBuilder : public vineyard::ObjectBuilder {
   fid_t fnum_;
   label_id_t label_num_;
   bool use_perfect_hash_;
+  bool compress_oids_ = false;
 
   std::vector<std::vector<typename InternalType<oid_t>::vineyard_array_type>>
       oid_arrays_;
   std::vector<std::vector<vineyard::Hashmap<oid_t, vid_t>>> o2g_;
   std::vector<std::vector<vineyard::PerfectHashmap<oid_t, vid_t>>> o2g_p_;
+  std::vector<std::vector<std::shared_ptr<CompressedStringArray>>>
+      compressed_oids_;
 };
 
 template <typename OID_T, typename VID_T>
@@ -233,12 +317,22 @@ class BasicArrowVertexMapBuilder : public ArrowVertexMapBuilder<OID_T, VID_T> {
       std::vector<std::vector<std::shared_ptr<arrow::ChunkedArray>>> oid_arrays,
       const bool use_perfect_hash = false);
 
+  /**
+   * @brief Keep the string oids in `CompressedStringArray`s, which serve as
+   * both the oid arrays and the oid to gid maps, instead of arrow arrays and
+   * hashmaps. Ignored for other oid types.
+   */
+  void set_compress_oids(const bool compress_oids) {
+    compress_oids_ = compress_oids;
+  }
+
   vineyard::Status Build(vineyard::Client& client) override;
 
  private:
   fid_t fnum_;
   label_id_t label_num_;
   bool use_perfect_hash_;
+  bool compress_oids_ = false;
 
   vineyard::IdParser<vid_t> id_parser_;
 
@@ -19,7 +19,10 @@ limitations under the License.
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -28,6 +31,7 @@ limitations under the License.
 #include "basic/ds/arrow_utils.h"
 #include "basic/ds/hashmap.h"
 #include "basic/ds/hashmap.vineyard.h"
+#include "basic/utils.h"
 #include "client/client.h"
 #include "common/util/functions.h"
 #include "common/util/status.h"
@@ -39,6 +43,7 @@ limitations under the License.
 #include "graph/utils/error.h"
 #include "graph/utils/thread_group.h"
 #include "graph/vertex_map/arrow_vertex_map.h"
+#include "graph/vertex_map/compressed_oids.h"
 
 namespace vineyard {
 
@@ -54,8 +59,35 @@ void ArrowVertexMap<OID_T, VID_T>::Construct(const vineyard::ObjectMeta& meta) {
   } else {
     this->use_perfect_hash_ = false;
   }
+  if (meta.HasKey("compress_oids_")) {
+    meta.GetKeyValue<bool>("compress_oids_", this->compress_oids_);
+  } else {
+    this->compress_oids_ = false;
+  }
 
   id_parser_.Init(fnum_, label_num_);
+  if (compress_oids_) {
+    size_t raw_bytes = 0, nbytes = 0;
+    compressed_oids_.resize(fnum_);
+    for (fid_t i = 0; i < fnum_; ++i) {
+      compressed_oids_[i].resize(label_num_);
+      for (label_id_t j = 0; j < label_num_; ++j) {
+        auto& compressed = compressed_oids_[i][j];
+        compressed = std::dynamic_pointer_cast<CompressedStringArray>(
+            meta.GetMember("compressed_oids_" + std::to_string(i) + "_" +
+                           std::to_string(j)));
+        raw_bytes += compressed->raw_bytes();
+        nbytes += compressed->nbytes();
+      }
+    }
+    decoded_oids_.Init(fnum_, label_num_);
+    VLOG(100) << type_name<ArrowVertexMap<oid_t, vid_t>>()
+              << "\n\tmemory: " << prettyprint_memory_size(nbytes)
+              << "\n\tuncompressed oids: "
+              << prettyprint_memory_size(raw_bytes);
+    return;
+  }
+
   size_t nbytes = 0, local_oid_total = 0;
   size_t o2g_total_bytes = 0, o2g_size = 0, o2g_bucket_count = 0;
   if (!use_perfect_hash_) {
@@ -121,12 +153,35 @@ bool ArrowVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
   fid_t fid = id_parser_.GetFid(gid);
   label_id_t label = id_parser_.GetLabelId(gid);
   int64_t offset = id_parser_.GetOffset(gid);
-  if (fid < fnum_ && label < label_num_ && label >= 0) {
-    auto array = oid_arrays_[fid][label];
-    if (offset < array->length()) {
-      oid = array->GetView(offset);
-      return true;
+  if (fid < fnum_ && label < label_num_ && label >= 0 &&
+      offset < oid_num(fid, label)) {
+    if (compress_oids_) {
+      oid = decoded_oids_.Get(fid, label, *compressed_oids_[fid][label])
+                ->GetView(offset);
+    } else {
+      oid = oid_arrays_[fid][label]->GetView(offset);
+    }
+    return true;
+  }
+  return false;
+}
+
+template <typename OID_T, typename VID_T>
+template <typename T, typename std::enable_if<
+                          std::is_same<T, arrow_string_view>::value>::type*>
+bool ArrowVertexMap<OID_T, VID_T>::GetOid(vid_t gid, std::string& oid) const {
+  fid_t fid = id_parser_.GetFid(gid);
+  label_id_t label = id_parser_.GetLabelId(gid);
+  int64_t offset = id_parser_.GetOffset(gid);
+  if (fid < fnum_ && label < label_num_ && label >= 0 &&
+      offset < oid_num(fid, label)) {
+    if (compress_oids_) {
+      compressed_oids_[fid][label]->GetString(offset, oid);
+    } else {
+      auto view = oid_arrays_[fid][label]->GetView(offset);
+      oid.assign(view.data(), view.size());
     }
+    return true;
   }
   return false;
 }
@@ -134,7 +189,15 @@ bool ArrowVertexMap<OID_T, VID_T>::GetOid(vid_t gid, oid_t& oid) const {
 template <typename OID_T, typename VID_T>
 bool ArrowVertexMap<OID_T, VID_T>::GetGid(fid_t fid, label_id_t label_id,
                                           oid_t oid, vid_t& gid) const {
-  if (use_perfect_hash_) {
+  if (compress_oids_) {
+    int64_t index =
+        detail::find_compressed_oid(*compressed_oids_[fid][label_id], oid);
+    if (index != -1) {
+      gid = id_parser_.GenerateId(fid, label_id, index);
+      return true;
+    }
+    return false;
+  } else if (use_perfect_hash_) {
     auto found = o2g_p_[fid][label_id].find(oid);
     if (found) {
       gid = *found;
@@ -162,11 +225,170 @@ bool ArrowVertexMap<OID_T, VID_T>::GetGid(label_id_t label_id, oid_t oid,
   return false;
 }
 
+namespace detail {
+
+// the number of oids whose buckets are hashed and prefetched together
+constexpr int64_t batched_lookup_group_size = 16;
+
+// the number of oids resolved by a task of batched lookups
+constexpr int64_t batched_lookup_chunk_size = 64 * 1024;
+
+template <typename K, typename V, typename H, typename E>
+inline bool probe_bucket(const Hashmap<K, V, H, E>& map, const K& key,
+                         const size_t bucket, V& value) {
+  auto iter = map.find(key, bucket);
+  if (iter != map.end()) {
+    value = iter->second;
+    return true;
+  }
+  return false;
+}
+
+template <typename K, typename V>
+inline bool probe_bucket(const PerfectHashmap<K, V>& map, const K& key,
+                         const size_t bucket, V& value) {
+  auto found = map.find(key, bucket);
+  if (found) {
+    value = *found;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace detail
+
+template <typename OID_T, typename VID_T>
+Status ArrowVertexMap<OID_T, VID_T>::GetGids(
+    label_id_t label_id, const std::shared_ptr<oid_array_t>& oids,
+    const std::vector<fid_t>& fids,
+    std::shared_ptr<ArrowArrayType<vid_t>>& gids,
+    const int concurrency) const {
+  RETURN_ON_ASSERT(static_cast<int64_t>(fids.size()) == oids->length(),
+                   "The number of fids doesn't match the number of oids");
+  return getGids(label_id, oids, fids.data(), gids, concurrency);
+}
+
+template <typename OID_T, typename VID_T>
+Status ArrowVertexMap<OID_T, VID_T>::GetGids(
+    label_id_t label_id, const std::shared_ptr<oid_array_t>& oids,
+    std::shared_ptr<ArrowArrayType<vid_t>>& gids,
+    const int concurrency) const {
+  return getGids(label_id, oids, nullptr, gids, concurrency);
+}
+
+template <typename OID_T, typename VID_T>
+Status ArrowVertexMap<OID_T, VID_T>::getGids(
+    label_id_t label_id, const std::shared_ptr<oid_array_t>& oids,
+    const fid_t* fids, std::shared_ptr<ArrowArrayType<vid_t>>& gids,
+    const int concurrency) const {
+  const int64_t length = oids->length();
+  std::shared_ptr<arrow::Buffer> buffer;
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      buffer, arrow::AllocateBuffer(length * sizeof(vid_t)));
+  vid_t* data = reinterpret_cast<vid_t*>(buffer->mutable_data());
+  std::vector<uint8_t> found(length, 0);
+
+  // without fids, the oids are looked up in the fragments one by one
+  const fid_t rounds = fids == nullptr ? fnum_ : 1;
+  const int64_t chunk_size = detail::batched_lookup_chunk_size;
+  const int64_t chunk_num = (length + chunk_size - 1) / chunk_size;
+  auto fn = [&](const int64_t chunk) {
+    const int64_t begin = chunk * chunk_size;
+    const int64_t end = std::min(begin + chunk_size, length);
+    for (fid_t fid = 0; fid < rounds; ++fid) {
+      if (compress_oids_) {
+        getCompressedGidsInRange(label_id, *oids, fids, fid, begin, end, data,
+                                 found.data());
+      } else if (use_perfect_hash_) {
+        getGidsInRange(o2g_p_, label_id, *oids, fids, fid, begin, end, data,
+                       found.data());
+      } else {
+        getGidsInRange(o2g_, label_id, *oids, fids, fid, begin, end, data,
+                       found.data());
+      }
+    }
+  };
+  if (concurrency <= 1 || chunk_num <= 1) {
+    for (int64_t chunk = 0; chunk < chunk_num; ++chunk) {
+      fn(chunk);
+    }
+  } else {
+    parallel_for(static_cast<int64_t>(0), chunk_num, fn,
+                 std::min(static_cast<int64_t>(concurrency), chunk_num), 1);
+  }
+
+  auto missing = std::find(found.begin(), found.end(), 0);
+  if (missing != found.end()) {
+    std::stringstream ss;
+    ss << "Vertex '" << oids->GetView(missing - found.begin())
+       << "' of label " << label_id << " doesn't exist in the vertex map";
+    return Status::ObjectNotExists(ss.str());
+  }
+  gids = std::make_shared<ArrowArrayType<vid_t>>(length, buffer, nullptr, 0);
+  return Status::OK();
+}
+
+template <typename OID_T, typename VID_T>
+template <typename MAP_T>
+void ArrowVertexMap<OID_T, VID_T>::getGidsInRange(
+    const std::vector<std::vector<MAP_T>>& o2g, label_id_t label_id,
+    const oid_array_t& oids, const fid_t* fids, const fid_t fid,
+    const int64_t begin, const int64_t end, vid_t* gids,
+    uint8_t* found) const {
+  size_t buckets[detail::batched_lookup_group_size];
+  for (int64_t group = begin; group < end;
+       group += detail::batched_lookup_group_size) {
+    const int64_t group_end =
+        std::min(group + detail::batched_lookup_group_size, end);
+    // hash the whole group and issue the prefetches first, ...
+    for (int64_t i = group; i < group_end; ++i) {
+      if (!found[i]) {
+        auto const& map = o2g[fids == nullptr ? fid : fids[i]][label_id];
+        buckets[i - group] = map.bucket(oids.GetView(i));
+        map.prefetch(buckets[i - group]);
+      }
+    }
+    // ... then probe them, as the buckets of the group arrive in parallel
+    for (int64_t i = group; i < group_end; ++i) {
+      if (!found[i]) {
+        auto const& map = o2g[fids == nullptr ? fid : fids[i]][label_id];
+        found[i] = detail::probe_bucket(map, oids.GetView(i),
+                                        buckets[i - group], gids[i]);
+      }
+    }
+  }
+}
+
+template <typename OID_T, typename VID_T>
+void ArrowVertexMap<OID_T, VID_T>::getCompressedGidsInRange(
+    label_id_t label_id, const oid_array_t& oids, const fid_t* fids,
+    const fid_t fid, const int64_t begin, const int64_t end, vid_t* gids,
+    uint8_t* found) const {
+  // the keys are compressed before probing, which dominates the lookups,
+  // thus the buckets are not prefetched
+  for (int64_t i = begin; i < end; ++i) {
+    if (!found[i]) {
+      const fid_t target = fids == nullptr ? fid : fids[i];
+      int64_t index = detail::find_compressed_oid(
+          *compressed_oids_[target][label_id], oids.GetView(i));
+      if (index != -1) {
+        gids[i] = id_parser_.GenerateId(target, label_id, index);
+        found[i] = 1;
+      }
+    }
+  }
+}
+
 template <typename OID_T, typename VID_T>
 std::vector<OID_T> ArrowVertexMap<OID_T, VID_T>::GetOids(
     fid_t fid, label_id_t label_id) const {
-  auto array = oid_arrays_[fid][label_id];
   std::vector<oid_t> oids;
+  if (compress_oids_) {
+    LOG(ERROR) << "ArrowVertexMap cannot return the views of compressed oids, "
+               << "use GetOidArray instead";
+    return oids;
+  }
+  auto array = oid_arrays_[fid][label_id];
 
   oids.resize(array->length());
   for (auto i = 0; i < array->length(); i++) {
@@ -179,15 +401,21 @@ std::vector<OID_T> ArrowVertexMap<OID_T, VID_T>::GetOids(
 template <typename OID_T, typename VID_T>
 std::shared_ptr<ArrowArrayType<OID_T>>
 ArrowVertexMap<OID_T, VID_T>::GetOidArray(fid_t fid, label_id_t label_id) {
+  if (compress_oids_) {
+    std::shared_ptr<oid_array_t> array;
+    VINEYARD_CHECK_OK(detail::decode_compressed_oids(
+        *compressed_oids_[fid][label_id], array));
+    return array;
+  }
   return oid_arrays_[fid][label_id];
 }
 
 template <typename OID_T, typename VID_T>
 size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum() const {
   size_t num = 0;
-  for (auto& vec : oid_arrays_) {
-    for (auto& v : vec) {
-      num += v->length();
+  for (fid_t fid = 0; fid < fnum_; ++fid) {
+    for (label_id_t label = 0; label < label_num_; ++label) {
+      num += oid_num(fid, label);
     }
   }
   return num;
@@ -196,8 +424,8 @@ size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum() const {
 template <typename OID_T, typename VID_T>
 size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum(label_id_t label) const {
   size_t num = 0;
-  for (auto& vec : oid_arrays_) {
-    num += vec[label]->length();
+  for (fid_t fid = 0; fid < fnum_; ++fid) {
+    num += oid_num(fid, label);
   }
   return num;
 }
@@ -205,8 +433,8 @@ size_t ArrowVertexMap<OID_T, VID_T>::GetTotalNodesNum(label_id_t label) const {
 template <typename OID_T, typename VID_T>
 VID_T ArrowVertexMap<OID_T, VID_T>::GetInnerVertexSize(fid_t fid) const {
   size_t num = 0;
-  for (auto& v : oid_arrays_[fid]) {
-    num += v->length();
+  for (label_id_t label = 0; label < label_num_; ++label) {
+    num += oid_num(fid, label);
   }
   return static_cast<vid_t>(num);
 }
@@ -214,7 +442,7 @@ VID_T ArrowVertexMap<OID_T, VID_T>::GetInnerVertexSize(fid_t fid) const {
 template <typename OID_T, typename VID_T>
 VID_T ArrowVertexMap<OID_T, VID_T>::GetInnerVertexSize(
     fid_t fid, label_id_t label_id) const {
-  return static_cast<vid_t>(oid_arrays_[fid][label_id]->length());
+  return static_cast<vid_t>(oid_num(fid, label_id));
 }
 
 template <typename OID_T, typename VID_T>
@@ -317,6 +545,11 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::addNewVertexLabels(
         oid_arrays) {
   using vineyard_oid_array_t =
       typename InternalType<oid_t>::vineyard_array_type;
+  if (compress_oids_) {
+    LOG(ERROR) << "ArrowVertexMap with compressed oids not support "
+               << "AddNewVertexLabels operation yet";
+    return InvalidObjectID();
+  }
 
   label_id_t extra_label_num = oid_arrays.size();
   // vineyard every worker has its own oid_array
@@ -432,6 +665,11 @@ ObjectID ArrowVertexMap<OID_T, VID_T>::updateLabelVertexMap(
     std::vector<std::vector<std::shared_ptr<oid_array_t>>> oid_arrays) {
   using vineyard_oid_array_t =
       typename InternalType<oid_t>::vineyard_array_type;
+  if (compress_oids_) {
+    LOG(ERROR) << "ArrowVertexMap with compressed oids not support "
+               << "UpdateLabelVertexMap operation yet";
+    return InvalidObjectID();
+  }
   std::vector<vineyard_oid_array_t> vy_oid_array(fnum_);
   std::vector<vineyard::Hashmap<oid_t, vid_t>> vy_o2g(fnum_);
   int total_label_num = label_num_;
@@ -563,6 +801,10 @@ void ArrowVertexMapBuilder<OID_T, VID_T>::set_fnum_label_num(
   fnum_ = fnum;
   label_num_ = label_num;
   oid_arrays_.resize(fnum_);
+  compressed_oids_.resize(fnum_);
+  for (fid_t i = 0; i < fnum_; ++i) {
+    compressed_oids_[i].resize(label_num_);
+  }
   if (use_perfect_hash_) {
     o2g_p_.resize(fnum_);
     for (fid_t i = 0; i < fnum_; ++i) {
@@ -620,12 +862,25 @@ void ArrowVertexMapBuilder<OID_T, VID_T>::set_o2g_p(
   o2g_p_[fid][label] = *rm;
 }
 
+template <typename OID_T, typename VID_T>
+void ArrowVertexMapBuilder<OID_T, VID_T>::set_compressed_oids(
+    fid_t fid, label_id_t label,
+    const std::shared_ptr<CompressedStringArray>& compressed) {
+  compressed_oids_[fid][label] = compressed;
+}
+
 template <typename OID_T, typename VID_T>
 void ArrowVertexMapBuilder<OID_T, VID_T>::set_perfect_hash_(
     const bool use_perfect_hash) {
   use_perfect_hash_ = use_perfect_hash;
 }
 
+template <typename OID_T, typename VID_T>
+void ArrowVertexMapBuilder<OID_T, VID_T>::set_compress_oids_(
+    const bool compress_oids) {
+  compress_oids_ = compress_oids;
+}
+
 template <typename OID_T, typename VID_T>
 Status ArrowVertexMapBuilder<OID_T, VID_T>::_Seal(
     vineyard::Client& client, std::shared_ptr<vineyard::Object>& object) {
@@ -643,21 +898,27 @@ Status ArrowVertexMapBuilder<OID_T, VID_T>::_Seal(
 
   vertex_map->fnum_ = fnum_;
   vertex_map->label_num_ = label_num_;
+  vertex_map->compress_oids_ = compress_oids_;
   vertex_map->id_parser_.Init(fnum_, label_num_);
 
-  vertex_map->oid_arrays_.resize(fnum_);
-  for (fid_t i = 0; i < fnum_; ++i) {
-    auto& array = vertex_map->oid_arrays_[i];
-    array.resize(label_num_);
-    for (label_id_t j = 0; j < label_num_; ++j) {
-      array[j] = oid_arrays_[i][j].GetArray();
-    }
-  }
-
-  if (!use_perfect_hash_) {
-    vertex_map->o2g_ = o2g_;
+  if (compress_oids_) {
+    // the compressed oids serve as both the oid arrays and the o2g maps
+    vertex_map->compressed_oids_ = compressed_oids_;
+    vertex_map->decoded_oids_.Init(fnum_, label_num_);
   } else {
-    vertex_map->o2g_p_ = o2g_p_;
+    vertex_map->oid_arrays_.resize(fnum_);
+    for (fid_t i = 0; i < fnum_; ++i) {
+      auto& array = vertex_map->oid_arrays_[i];
+      array.resize(label_num_);
+      for (label_id_t j = 0; j < label_num_; ++j) {
+        array[j] = oid_arrays_[i][j].GetArray();
+      }
+    }
+    if (!use_perfect_hash_) {
+      vertex_map->o2g_ = o2g_;
+    } else {
+      vertex_map->o2g_p_ = o2g_p_;
+    }
   }
 
   vertex_map->meta_.SetTypeName(type_name<ArrowVertexMap<oid_t, vid_t>>());
@@ -665,9 +926,19 @@ Status ArrowVertexMapBuilder<OID_T, VID_T>::_Seal(
   vertex_map->meta_.AddKeyValue("fnum", fnum_);
   vertex_map->meta_.AddKeyValue("label_num", label_num_);
   vertex_map->meta_.AddKeyValue("use_perfect_hash_", use_perfect_hash_);
+  vertex_map->meta_.AddKeyValue("compress_oids_", compress_oids_);
 
   size_t nbytes = 0;
-  if (!use_perfect_hash_) {
+  if (compress_oids_) {
+    for (fid_t i = 0; i < fnum_; ++i) {
+      for (label_id_t j = 0; j < label_num_; ++j) {
+        vertex_map->meta_.AddMember(
+            "compressed_oids_" + std::to_string(i) + "_" + std::to_string(j),
+            compressed_oids_[i][j]->meta());
+        nbytes += compressed_oids_[i][j]->nbytes();
+      }
+    }
+  } else if (!use_perfect_hash_) {
     for (fid_t i = 0; i < fnum_; ++i) {
       for (label_id_t j = 0; j < label_num_; ++j) {
         vertex_map->meta_.AddMember(
@@ -707,6 +978,7 @@ Status ArrowVertexMapBuilder<OID_T, VID_T>::_Seal(
   VLOG(100) << "Vertex map construction time: "
             << (GetCurrentTime() - start_time) << " seconds"
             << "\n\tuse perfect hash: " << use_perfect_hash_
+            << "\n\tcompress oids: " << compress_oids_
             << "\n\tmemory usage (before construct vertex map): "
             << start_memory_usage
             << "\n\tpeak memory usage (before construct vertex map):"
@@ -767,10 +1039,41 @@ vineyard::Status BasicArrowVertexMapBuilder<OID_T, VID_T>::Build(
   using vineyard_oid_array_t =
       typename InternalType<oid_t>::vineyard_array_type;
 
+  if (compress_oids_ && !std::is_same<oid_t, arrow_string_view>::value) {
+    LOG(WARNING) << "Only string oids can be compressed, ignored for "
+                 << type_name<oid_t>();
+    compress_oids_ = false;
+  }
+  if (compress_oids_) {
+    // lookups go through the index of the compressed oids
+    use_perfect_hash_ = false;
+  }
   this->set_perfect_hash_(use_perfect_hash_);
+  this->set_compress_oids_(compress_oids_);
   this->set_fnum_label_num(fnum_, label_num_);
 
+  // the hash functions of fragments and labels are built concurrently, and
+  // the threads are split among them to avoid oversubscription
+  const int hardware_concurrency =
+      std::max<int>(std::thread::hardware_concurrency(), 1);
+  const int parallelism = std::max<int>(
+      std::min<int>((hardware_concurrency + (fnum_ - 1)) / fnum_,
+                    fnum_ * label_num_),
+      1);
+  const int build_concurrency =
+      std::max<int>(hardware_concurrency / parallelism, 1);
+
   auto fn = [&](const label_id_t label, const fid_t fid) -> Status {
+    if (compress_oids_) {
+      // the gid offset of an oid is its index in the compressed array
+      std::shared_ptr<CompressedStringArray> compressed;
+      RETURN_ON_ERROR(detail::build_compressed_oids(
+          client, oid_arrays_[label][fid], build_concurrency, compressed));
+      this->set_compressed_oids(fid, label, compressed);
+      // release the reference
+      oid_arrays_[label][fid].clear();
+      return Status::OK();
+    }
     std::shared_ptr<Object> object;
     std::shared_ptr<vineyard_oid_array_t> varray;
     {
@@ -809,7 +1112,8 @@ vineyard::Status BasicArrowVertexMapBuilder<OID_T, VID_T>::Build(
         auto array = varray->GetArray();
         vid_t cur_gid = id_parser_.GenerateId(fid, label, 0);
         int64_t vnum = array->length();
-        builder.ComputeHash(client, varray, cur_gid, vnum);
+        builder.set_concurrency(build_concurrency);
+        RETURN_ON_ERROR(builder.ComputeHash(client, varray, cur_gid, vnum));
         RETURN_ON_ERROR(builder.Seal(client, object));
         this->set_o2g_p(
             fid, label,
@@ -820,9 +1124,7 @@ vineyard::Status BasicArrowVertexMapBuilder<OID_T, VID_T>::Build(
     return Status::OK();
   };
 
-  ThreadGroup tg(
-      (static_cast<fid_t>(std::thread::hardware_concurrency()) + (fnum_ - 1)) /
-      fnum_);
+  ThreadGroup tg(parallelism);
   for (fid_t fid = 0; fid < fnum_; ++fid) {
     for (label_id_t label = 0; label < label_num_; ++label) {
       tg.AddTask(fn, label, fid);
@@ -19,12 +19,20 @@ namespace vineyard {
 
 template class ArrowVertexMap<arrow_string_view, uint32_t>;
 
+template bool
+ArrowVertexMap<arrow_string_view, uint32_t>::GetOid<arrow_string_view>(
+    uint32_t gid, std::string& oid) const;
+
 template class ArrowVertexMapBuilder<arrow_string_view, uint32_t>;
 
 template class BasicArrowVertexMapBuilder<arrow_string_view, uint32_t>;
 
 template class ArrowVertexMap<arrow_string_view, uint64_t>;
 
+template bool
+ArrowVertexMap<arrow_string_view, uint64_t>::GetOid<arrow_string_view>(
+    uint64_t gid, std::string& oid) const;
+
 template class ArrowVertexMapBuilder<arrow_string_view, uint64_t>;
 
 template class BasicArrowVertexMapBuilder<arrow_string_view, uint64_t>;
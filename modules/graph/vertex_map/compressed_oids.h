@@ -0,0 +1,134 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef MODULES_GRAPH_VERTEX_MAP_COMPRESSED_OIDS_H_
+#define MODULES_GRAPH_VERTEX_MAP_COMPRESSED_OIDS_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/compressed_string_array.h"
+#include "client/client.h"
+#include "common/util/arrow.h"
+#include "common/util/status.h"
+
+namespace vineyard {
+
+namespace detail {
+
+// The helpers of the vertex maps that keep the oids in a
+// `CompressedStringArray`, where only string oids can be compressed, thus
+// the overloads for other oid types are never reached at runtime.
+
+template <typename OID_ARRAY_T>
+inline Status build_compressed_oids(
+    Client& client, const std::vector<std::shared_ptr<OID_ARRAY_T>>& arrays,
+    const int concurrency, std::shared_ptr<CompressedStringArray>& compressed) {
+  return Status::Invalid("Only string oids can be compressed");
+}
+
+inline Status build_compressed_oids(
+    Client& client,
+    const std::vector<std::shared_ptr<arrow::LargeStringArray>>& arrays,
+    const int concurrency, std::shared_ptr<CompressedStringArray>& compressed) {
+  CompressedStringArrayBuilder builder(client, arrays, concurrency);
+  std::shared_ptr<Object> object;
+  RETURN_ON_ERROR(builder.Seal(client, object));
+  compressed = std::dynamic_pointer_cast<CompressedStringArray>(object);
+  return Status::OK();
+}
+
+template <typename OID_T>
+inline int64_t find_compressed_oid(const CompressedStringArray& compressed,
+                                   const OID_T& oid) {
+  return -1;
+}
+
+inline int64_t find_compressed_oid(const CompressedStringArray& compressed,
+                                   const arrow_string_view& oid) {
+  return compressed.Find(oid);
+}
+
+template <typename OID_ARRAY_T>
+inline Status decode_compressed_oids(const CompressedStringArray& compressed,
+                                     std::shared_ptr<OID_ARRAY_T>& array) {
+  return Status::Invalid("Only string oids can be compressed");
+}
+
+/**
+ * @brief Decompress all strings into an arrow array, e.g., for rebuilding the
+ * vertex map.
+ */
+inline Status decode_compressed_oids(
+    const CompressedStringArray& compressed,
+    std::shared_ptr<arrow::LargeStringArray>& array) {
+  arrow::LargeStringBuilder builder;
+  RETURN_ON_ARROW_ERROR(builder.Reserve(compressed.length()));
+  RETURN_ON_ARROW_ERROR(builder.ReserveData(compressed.raw_bytes()));
+  std::string oid;
+  for (size_t index = 0; index < compressed.length(); ++index) {
+    compressed.GetString(index, oid);
+    builder.UnsafeAppend(oid.data(), static_cast<int64_t>(oid.size()));
+  }
+  std::shared_ptr<arrow::Array> out;
+  RETURN_ON_ARROW_ERROR(builder.Finish(&out));
+  array = std::dynamic_pointer_cast<arrow::LargeStringArray>(out);
+  return Status::OK();
+}
+
+/**
+ * @brief The oids of each (fragment, label) that are decompressed on the
+ * first request of the views of them, e.g., the internal oids of the
+ * fragment, and kept afterwards, thus the views stay valid for the lifetime
+ * of the vertex map. The memory saved by compression is given up for the
+ * labels whose views are requested.
+ */
+template <typename OID_ARRAY_T>
+class DecodedOidArrays {
+ public:
+  void Init(const size_t fnum, const size_t label_num) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    arrays_.assign(fnum,
+                   std::vector<std::shared_ptr<OID_ARRAY_T>>(label_num));
+  }
+
+  std::shared_ptr<OID_ARRAY_T> Get(const size_t fid, const size_t label,
+                                   const CompressedStringArray& compressed) {
+    auto array = std::atomic_load(&arrays_[fid][label]);
+    if (array == nullptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      array = arrays_[fid][label];
+      if (array == nullptr) {
+        VINEYARD_CHECK_OK(decode_compressed_oids(compressed, array));
+        std::atomic_store(&arrays_[fid][label], array);
+      }
+    }
+    return array;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::vector<std::shared_ptr<OID_ARRAY_T>>> arrays_;
+};
+
+}  // namespace detail
+
+}  // namespace vineyard
+
+#endif  // MODULES_GRAPH_VERTEX_MAP_COMPRESSED_OIDS_H_
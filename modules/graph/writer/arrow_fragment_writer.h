@@ -80,8 +80,8 @@ class ArrowFragmentWriter {
   using vertex_map_t = typename FRAG_T::vertex_map_t;
   using oid_array_builder_t =
       typename vineyard::ConvertToArrowType<oid_t>::BuilderType;
-  using nbr_t = property_graph_utils::Nbr<vid_t, eid_t>;
-  using adj_list_t = typename FRAG_T::adj_list_t;
+  using nbr_t = property_graph_utils::DeltaNbr<vid_t, eid_t>;
+  using adj_list_t = typename FRAG_T::delta_adj_list_t;
 
   using fragment_t = FRAG_T;
 
@@ -319,9 +319,9 @@ boost::leaf::result<void> ArrowFragmentWriter<FRAG_T>::writeEdgeImpl(
       adj_list_t edges;
       if (adj_list_type == GraphArchive::AdjListType::ordered_by_source ||
           adj_list_type == GraphArchive::AdjListType::unordered_by_source) {
-        edges = frag_->GetOutgoingAdjList(vertex, edge_label_id);
+        edges = frag_->GetOutgoingAdjListWithDelta(vertex, edge_label_id);
       } else {
-        edges = frag_->GetIncomingAdjList(vertex, edge_label_id);
+        edges = frag_->GetIncomingAdjListWithDelta(vertex, edge_label_id);
       }
       int64_t edge_cnt = 0;
       for (auto& e : edges) {
@@ -80,6 +80,19 @@ class IIOAdaptor {
     return Status::OK();
   }
 
+  /**
+   * Read the table as a stream of record batches, where the batches are
+   * parsed on demand, and thus the table is never materialized in memory as
+   * a whole.
+   *
+   * The `reader` will be set as nullptr when there's nothing to read, and
+   * the adaptor must be kept open until the reader is drained.
+   */
+  virtual Status ReadTableStream(
+      std::shared_ptr<arrow::RecordBatchReader>* reader) {
+    return Status::NotImplemented("Reading table as stream is not supported");
+  }
+
   virtual Status WriteTable(std::shared_ptr<arrow::Table> table) {
     return Status::OK();
   }
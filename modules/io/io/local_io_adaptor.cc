@@ -180,6 +180,10 @@ Status LocalIOAdaptor::Open(const char* mode) {
 
 Status LocalIOAdaptor::Configure(const std::string& key,
                                  const std::string& value) {
+  // the block size in the location takes precedence
+  if (key == "block_size" && meta_.find("block_size") == meta_.end()) {
+    meta_.emplace("block_size", value);
+  }
   return Status::OK();
 }
 
@@ -306,27 +310,15 @@ Status LocalIOAdaptor::ReadTable(std::shared_ptr<arrow::Table>* table) {
 /// Means we deduce the type of the second and third column.
 Status LocalIOAdaptor::ReadPartialTable(std::shared_ptr<arrow::Table>* table,
                                         int index) {
-  if (ifp_ == nullptr) {
-    return Status::IOError("The file hasn't been opened in read mode: " +
-                           location_);
-  }
-  int64_t offset = partial_read_offset_[index];
-  int64_t nbytes =
-      partial_read_offset_[index + 1] - partial_read_offset_[index];
-#if defined(ARROW_VERSION) && ARROW_VERSION <= 9000000
-  std::shared_ptr<arrow::io::InputStream> input =
-      arrow::io::RandomAccessFile::GetStream(ifp_, offset, nbytes);
-#else
   std::shared_ptr<arrow::io::InputStream> input;
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      input, arrow::io::RandomAccessFile::GetStream(ifp_, offset, nbytes));
-#endif
+  RETURN_ON_ERROR(openPartialInput(index, input));
 
   arrow::MemoryPool* pool = arrow::default_memory_pool();
 
   auto read_options = arrow::csv::ReadOptions::Defaults();
   auto parse_options = arrow::csv::ParseOptions::Defaults();
   auto convert_options = arrow::csv::ConvertOptions::Defaults();
+  RETURN_ON_ERROR(makeCSVOptions(read_options, parse_options, convert_options));
 
   // enable parallelism
   read_options.use_threads = true;
@@ -341,6 +333,115 @@ Status LocalIOAdaptor::ReadPartialTable(std::shared_ptr<arrow::Table>* table,
       read_options.block_size = std::max(read_options.block_size, block_size);
     }
   }
+
+  std::shared_ptr<arrow::csv::TableReader> reader;
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 4000000
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      reader, arrow::csv::TableReader::Make(arrow::io::IOContext(pool), input,
+                                            read_options, parse_options,
+                                            convert_options));
+#else
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      reader, arrow::csv::TableReader::Make(pool, input, read_options,
+                                            parse_options, convert_options));
+#endif
+
+  auto result = reader->Read();
+  if (!result.status().ok()) {
+    if (result.status().message() == "Empty CSV file") {
+      *table = nullptr;
+      return Status::OK();
+    } else {
+      return ArrowError(result.status());
+    }
+  }
+  *table = result.ValueOrDie();
+
+  RETURN_ON_ARROW_ERROR((*table)->Validate());
+
+  VLOG(2) << "[file-" << location_ << "] contains: " << (*table)->num_rows()
+          << " rows, " << (*table)->num_columns() << " columns";
+  VLOG(2) << (*table)->schema()->ToString();
+  return Status::OK();
+}
+
+Status LocalIOAdaptor::ReadTableStream(
+    std::shared_ptr<arrow::RecordBatchReader>* reader) {
+  return ReadPartialTableStream(reader, index_);
+}
+
+Status LocalIOAdaptor::ReadPartialTableStream(
+    std::shared_ptr<arrow::RecordBatchReader>* reader, int index) {
+  std::shared_ptr<arrow::io::InputStream> input;
+  RETURN_ON_ERROR(openPartialInput(index, input));
+
+  arrow::MemoryPool* pool = arrow::default_memory_pool();
+
+  auto read_options = arrow::csv::ReadOptions::Defaults();
+  auto parse_options = arrow::csv::ParseOptions::Defaults();
+  auto convert_options = arrow::csv::ConvertOptions::Defaults();
+  RETURN_ON_ERROR(makeCSVOptions(read_options, parse_options, convert_options));
+
+  // the blocks are parsed (in parallel, with a bounded readahead) when the
+  // stream is pulled, and the types of columns are inferred from the first
+  // block, thus 'column_types' is recommended for columns whose types cannot
+  // be decided by the first block.
+  //
+  // default: 16MB
+  read_options.use_threads = true;
+  read_options.block_size = 16 * 1024 * 1024;
+  if (meta_.find("block_size") != meta_.end()) {
+    read_options.block_size = static_cast<int32_t>(
+        parse_memory_size(meta_.find("block_size")->second));
+  }
+
+  std::shared_ptr<arrow::csv::StreamingReader> stream;
+#if defined(ARROW_VERSION) && ARROW_VERSION >= 4000000
+  auto result = arrow::csv::StreamingReader::Make(
+      arrow::io::IOContext(pool), input, read_options, parse_options,
+      convert_options);
+#else
+  auto result = arrow::csv::StreamingReader::Make(
+      pool, input, read_options, parse_options, convert_options);
+#endif
+  if (!result.status().ok()) {
+    if (result.status().message() == "Empty CSV file") {
+      *reader = nullptr;
+      return Status::OK();
+    } else {
+      return ArrowError(result.status());
+    }
+  }
+  *reader = result.ValueOrDie();
+
+  VLOG(2) << "[file-" << location_ << "] is streamed with block size "
+          << read_options.block_size << ": "
+          << (*reader)->schema()->ToString();
+  return Status::OK();
+}
+
+Status LocalIOAdaptor::openPartialInput(
+    const int index, std::shared_ptr<arrow::io::InputStream>& input) {
+  if (ifp_ == nullptr) {
+    return Status::IOError("The file hasn't been opened in read mode: " +
+                           location_);
+  }
+  int64_t offset = partial_read_offset_[index];
+  int64_t nbytes =
+      partial_read_offset_[index + 1] - partial_read_offset_[index];
+#if defined(ARROW_VERSION) && ARROW_VERSION <= 9000000
+  input = arrow::io::RandomAccessFile::GetStream(ifp_, offset, nbytes);
+#else
+  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
+      input, arrow::io::RandomAccessFile::GetStream(ifp_, offset, nbytes));
+#endif
+  return Status::OK();
+}
+
+Status LocalIOAdaptor::makeCSVOptions(
+    arrow::csv::ReadOptions& read_options,
+    arrow::csv::ParseOptions& parse_options,
+    arrow::csv::ConvertOptions& convert_options) {
   read_options.column_names = original_columns_;
 
   auto is_number = [](const std::string& s) -> bool {
@@ -391,35 +492,6 @@ Status LocalIOAdaptor::ReadPartialTable(std::shared_ptr<arrow::Table>* table,
   convert_options.column_types = column_types;
 
   parse_options.delimiter = delimiter_;
-
-  std::shared_ptr<arrow::csv::TableReader> reader;
-#if defined(ARROW_VERSION) && ARROW_VERSION >= 4000000
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      reader, arrow::csv::TableReader::Make(arrow::io::IOContext(pool), input,
-                                            read_options, parse_options,
-                                            convert_options));
-#else
-  RETURN_ON_ARROW_ERROR_AND_ASSIGN(
-      reader, arrow::csv::TableReader::Make(pool, input, read_options,
-                                            parse_options, convert_options));
-#endif
-
-  auto result = reader->Read();
-  if (!result.status().ok()) {
-    if (result.status().message() == "Empty CSV file") {
-      *table = nullptr;
-      return Status::OK();
-    } else {
-      return ArrowError(result.status());
-    }
-  }
-  *table = result.ValueOrDie();
-
-  RETURN_ON_ARROW_ERROR((*table)->Validate());
-
-  VLOG(2) << "[file-" << location_ << "] contains: " << (*table)->num_rows()
-          << " rows, " << (*table)->num_columns() << " columns";
-  VLOG(2) << (*table)->schema()->ToString();
   return Status::OK();
 }
 
@@ -23,6 +23,7 @@ limitations under the License.
 #include <vector>
 
 #include "arrow/api.h"
+#include "arrow/csv/api.h"
 #include "arrow/filesystem/api.h"
 #include "arrow/io/api.h"
 
@@ -108,6 +109,17 @@ class LocalIOAdaptor : public IIOAdaptor {
 
   Status ReadPartialTable(std::shared_ptr<arrow::Table>* table, int index);
 
+  /**
+   * Read the part of file as a stream of record batches, which are parsed
+   * block by block, where the block size is `block_size` in the location
+   * (or set by `Configure("block_size", ...)`), 16MB by default.
+   */
+  Status ReadTableStream(
+      std::shared_ptr<arrow::RecordBatchReader>* reader) override;
+
+  Status ReadPartialTableStream(
+      std::shared_ptr<arrow::RecordBatchReader>* reader, int index);
+
   Status Seek(const int64_t offset);
 
   int64_t GetFullSize();
@@ -124,6 +136,13 @@ class LocalIOAdaptor : public IIOAdaptor {
 
   std::string trimBOM(const std::string& line);
 
+  Status openPartialInput(const int index,
+                          std::shared_ptr<arrow::io::InputStream>& input);
+
+  Status makeCSVOptions(arrow::csv::ReadOptions& read_options,
+                        arrow::csv::ParseOptions& parse_options,
+                        arrow::csv::ConvertOptions& convert_options);
+
   std::string location_;
   char buff[LINESIZE];
   std::shared_ptr<arrow::fs::FileSystem> fs_;
@@ -368,10 +368,11 @@ Shrink the blob builder to the given size if it is not sealed yet.
 )doc";
 
 const char* BlobBuilder_copy = R"doc(
-.. method:: copy(self, offset: int, ptr: int, size: int, concurrency: int = 6)
+.. method:: copy(self, offset: int, ptr: int, size: int, concurrency: int = 0)
     :noindex:
 
-Copy the given address to the given offset.
+Copy the given address to the given offset. The default concurrency :code:`0`
+means the concurrency is tuned automatically.
 )doc";
 
 const char* BlobBuilder_address = R"doc(
@@ -461,10 +462,11 @@ Abort the blob builder if it is not sealed yet.
 )doc";
 
 const char* RemoteBlobBuilder_copy = R"doc(
-.. method:: copy(self, offset: int, ptr: int, size: int, concurrency: int = 6)
+.. method:: copy(self, offset: int, ptr: int, size: int, concurrency: int = 0)
     :noindex:
 
-Copy the given address to the given offset.
+Copy the given address to the given offset. The default concurrency :code:`0`
+means the concurrency is tuned automatically.
 )doc";
 
 const char* RemoteBlobBuilder_address = R"doc(
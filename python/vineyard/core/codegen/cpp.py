@@ -25,6 +25,7 @@ from .parsing import find_distributed_field
 from .parsing import find_fields
 from .parsing import generate_template_header
 from .parsing import generate_template_type
+from .parsing import is_optional_member
 from .parsing import parse_codegen_spec_from_type
 from .parsing import split_members_and_methods
 
@@ -114,6 +115,10 @@ post_construct_meth_tpl = '''
 construct_meta_tpl = '''
     meta.GetKeyValue("{name}", this->{name});'''
 
+construct_optional_tpl = '''
+    if (meta.HasKey("{key}")) {{{body}
+    }}'''
+
 construct_plain_tpl = '''
     this->{name}.Construct(meta.GetMemberMeta("{name}"));'''
 
@@ -204,15 +209,23 @@ def codegen_construct(
             key_type = None
             value_type = None
 
-        body.append(
-            tpl.format(
-                name=name,
-                element_type=spec.element_type,
-                key_type=key_type,
-                value_type=value_type,
-                deref=spec.deref,
-            )
+        statement = tpl.format(
+            name=name,
+            element_type=spec.element_type,
+            key_type=key_type,
+            value_type=value_type,
+            deref=spec.deref,
         )
+        # fields annotated as optional may be absent in the metadata
+        if is_optional_member(field):
+            if spec.is_meta or spec.is_plain:
+                key = name
+            else:
+                key = '__%s-size' % name
+            statement = construct_optional_tpl.format(
+                key=key, body=textwrap.indent(statement, ' ' * 4)
+            )
+        body.append(statement)
 
     if meth:
         function_tpl = construct_meth_tpl
@@ -49,6 +49,8 @@ except ImportError:
 #
 #   __attribute__((annotate("vineyard"))): vineyard classes
 #   __attribute__((annotate("shared"))): shared member/method
+#   __attribute__((annotate("shared(optional)"))): shared member that may be
+#       absent in the metadata, e.g., added in a later version
 #   __attribute__((annotate("streamable"))): shared member/method
 #   __attribute__((annotate("distributed"))): shared member/method
 #
@@ -391,6 +393,7 @@ def check_serialize_attribute(node):
             for attr_kind in [
                 'vineyard',
                 'vineyard(streamable)',
+                'shared(optional)',
                 'shared',
                 'distributed',
             ]:
@@ -474,7 +477,7 @@ def find_fields(definition):
 
         if child.kind == CursorKind.FIELD_DECL:
             attribute = check_serialize_attribute(child)
-            if attribute in ['shared', 'distributed']:
+            if attribute in ['shared', 'shared(optional)', 'distributed']:
                 fields.append(child)
             continue
 
@@ -517,6 +520,12 @@ def find_distributed_field(definitions: List["CursorKind"]) -> "CursorKind":
     )
 
 
+def is_optional_member(node):
+    # fields annotated with "[[shared(optional)]]" may be absent in the
+    # metadata, and keep their in-class initializer in that case
+    return check_serialize_attribute(node) == 'shared(optional)'
+
+
 def split_members_and_methods(fields):
     members, methods = [], []
     for field in fields:
@@ -587,7 +596,13 @@ def validate_and_strip_input_file(source):
     content = '\n'.join(content)
 
     # pass: rewrite `[[...]]` with `__attribute__((annotate(...)))`
-    attributes = ['vineyard', 'vineyard(streamable)', 'shared', 'distributed']
+    attributes = [
+        'vineyard',
+        'vineyard(streamable)',
+        'shared',
+        'shared(optional)',
+        'distributed',
+    ]
     for attr in attributes:
         content = content.replace(
             '[[%s]]' % attr, '__attribute__((annotate("%s")))' % attr
@@ -19,6 +19,7 @@
 import itertools
 import json
 import logging
+import time
 
 import numpy as np
 import pandas as pd
@@ -267,3 +268,59 @@ def test_migration_large_object(
     assert o1 != o2
     np.testing.assert_allclose(client1.get(o1), client2.get(o2))
     logger.info('------- finish migrate remote large object --------')
+
+
+@pytest.mark.skip_without_migration()
+def test_migration_dedup(vineyard_ipc_sockets):
+    vineyard_ipc_sockets = list(
+        itertools.islice(itertools.cycle(vineyard_ipc_sockets), 2)
+    )
+
+    client1 = vineyard.connect(vineyard_ipc_sockets[0])
+    client2 = vineyard.connect(vineyard_ipc_sockets[1])
+
+    data = np.arange(1024 * 1024, dtype=np.int64)
+    o1 = client1.put(data)
+    client1.persist(o1)
+    client2.get_meta(o1, sync_remote=True)
+
+    # the same content already exists on h2
+    local = client2.put(data)
+    local_meta = client2.get_meta(local)
+
+    # the local blob is hashed in the background after sealing
+    time.sleep(1)
+
+    # migrate o1 to h2: the blob is not transferred but reused
+    o2 = client2.migrate(o1)
+    assert o1 != o2
+    meta2 = client2.get_meta(o2)
+    assert meta2['buffer_'].id == local_meta['buffer_'].id
+    np.testing.assert_allclose(client1.get(o1), client2.get(o2))
+    logger.info('------- finish migrate remote deduplicated object --------')
+
+
+@pytest.mark.skip_without_migration()
+def test_migration_remote_blob_cache(vineyard_ipc_sockets):
+    vineyard_ipc_sockets = list(
+        itertools.islice(itertools.cycle(vineyard_ipc_sockets), 2)
+    )
+
+    client1 = vineyard.connect(vineyard_ipc_sockets[0])
+    client2 = vineyard.connect(vineyard_ipc_sockets[1])
+
+    data = np.random.rand(1024, 128)
+    o1 = client1.put(data)
+    client1.persist(o1)
+    client2.get_meta(o1, sync_remote=True)
+
+    o2 = client2.migrate(o1)
+    blob = client2.get_meta(o2)['buffer_'].id
+
+    # the local copy is kept after the migrated object has been deleted
+    client2.delete(o2)
+    o3 = client2.migrate(o1)
+    assert o3 != o2
+    assert client2.get_meta(o3)['buffer_'].id == blob
+    np.testing.assert_allclose(client1.get(o1), client2.get(o3))
+    logger.info('------- finish migrate remote cached object --------')
@@ -403,6 +403,37 @@ Status Client::GetObject(const ObjectID id, std::shared_ptr<Object>& object) {
   return Status::OK();
 }
 
+Status Client::GetObject(const ObjectID id,
+                         std::vector<std::string> const& columns,
+                         std::shared_ptr<Object>& object) {
+  ENSURE_CONNECTED(this);
+  json tree;
+  RETURN_ON_ERROR(GetData(id, tree, true));
+  RETURN_ON_ASSERT(!tree.empty());
+  object = ObjectFactory::Create(tree.value("typename", std::string("")));
+  auto projectable = dynamic_cast<Projectable*>(object.get());
+  if (projectable == nullptr) {
+    return Status::NotImplemented("projection is not supported for type '" +
+                                  tree.value("typename", std::string("")) +
+                                  "'");
+  }
+  // prune the metadata tree before fetching blobs
+  RETURN_ON_ERROR(projectable->Project(tree, columns));
+
+  ObjectMeta meta;
+  meta.SetMetaData(this, tree);
+  std::map<ObjectID, std::shared_ptr<Buffer>> buffers;
+  RETURN_ON_ERROR(GetBuffers(meta.GetBufferSet()->AllBufferIds(), buffers));
+  for (auto const& id : meta.GetBufferSet()->AllBufferIds()) {
+    const auto& buffer = buffers.find(id);
+    if (buffer != buffers.end()) {
+      meta.SetBuffer(id, buffer->second);
+    }
+  }
+  object->Construct(meta);
+  return Status::OK();
+}
+
 Status Client::FetchAndGetObject(const ObjectID id,
                                  std::shared_ptr<Object>& object) {
   ObjectID local_object_id;
@@ -581,13 +612,20 @@ Status Client::CreateArena(const size_t size, int& fd, size_t& available_size,
 
 Status Client::ReleaseArena(const int fd, std::vector<size_t> const& offsets,
                             std::vector<size_t> const& sizes) {
+  std::vector<ObjectID> ids;
+  return ReleaseArena(fd, offsets, sizes, ids);
+}
+
+Status Client::ReleaseArena(const int fd, std::vector<size_t> const& offsets,
+                            std::vector<size_t> const& sizes,
+                            std::vector<ObjectID>& ids) {
   ENSURE_CONNECTED(this);
   std::string message_out;
   WriteFinalizeArenaRequest(fd, offsets, sizes, message_out);
   RETURN_ON_ERROR(doWrite(message_out));
   json message_in;
   RETURN_ON_ERROR(doRead(message_in));
-  RETURN_ON_ERROR(ReadFinalizeArenaReply(message_in));
+  RETURN_ON_ERROR(ReadFinalizeArenaReply(message_in, ids));
   return Status::OK();
 }
 
@@ -1084,6 +1122,19 @@ Status Client::IsSpilled(ObjectID const& id, bool& is_spilled) {
   return Status::OK();
 }
 
+Status Client::IsCompressed(ObjectID const& id, bool& is_compressed) {
+  ENSURE_CONNECTED(this);
+
+  std::string message_out;
+  WriteIsCompressedRequest(id, message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+
+  json message_in;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(ReadIsCompressedReply(message_in, is_compressed));
+  return Status::OK();
+}
+
 PlasmaClient::~PlasmaClient() {}
 
 // dummy implementation
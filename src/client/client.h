@@ -523,6 +523,29 @@ class Client final : public BasicIPCClient,
    */
   Status FetchAndGetObject(const ObjectID id, std::shared_ptr<Object>& object);
 
+  /**
+   * @brief Get an object from vineyard with only the given columns, e.g.,
+   *
+   * \code{.cpp}
+   *    std::shared_ptr<Object> object;
+   *    client.GetObject(id, {"col_a", "col_b"}, object);
+   * \endcode
+   *
+   * The projection is pushed down before the object is constructed (see also
+   * `Projectable`): only the metadata and blobs of the requested columns
+   * are fetched and mapped. The object type must support the projection,
+   * e.g., `RecordBatch`, `Table` and `DataFrame`.
+   *
+   * Note that the result object is a view of the original object, sharing the
+   * same object id, thus shouldn't be used to build new objects.
+   *
+   * @param id The object id to get.
+   * @param columns The names of columns to get, in the given order.
+   * @param object The result object will be set in parameter `object`.
+   */
+  Status GetObject(const ObjectID id, std::vector<std::string> const& columns,
+                   std::shared_ptr<Object>& object);
+
   /**
    * @brief Get an object from vineyard. The type parameter `T` will be used to
    * resolve the constructor of the object.
@@ -617,6 +640,24 @@ class Client final : public BasicIPCClient,
     }
   }
 
+  /**
+   * @brief Get an object from vineyard with only the given columns, see also
+   * `GetObject(id, columns, object)`.
+   */
+  template <typename T>
+  Status GetObject(const ObjectID id, std::vector<std::string> const& columns,
+                   std::shared_ptr<T>& object) {
+    std::shared_ptr<Object> _object;
+    RETURN_ON_ERROR(GetObject(id, columns, _object));
+    object = std::dynamic_pointer_cast<T>(_object);
+    if (object == nullptr) {
+      return Status::ObjectTypeError(type_name<T>(),
+                                     _object->meta().GetTypeName());
+    } else {
+      return Status::OK();
+    }
+  }
+
   /**
    * @brief Get multiple objects from vineyard.
    *
@@ -722,6 +763,14 @@ class Client final : public BasicIPCClient,
    */
   Status IsSpilled(ObjectID const& id, bool& is_spilled);
 
+  /**
+   * @brief Check if the blob is a cold blob that has been compressed in
+   * memory, see also the `--compress_cold_objects` option of vineyardd.
+   *
+   * Return true if the the blob is compressed.
+   */
+  Status IsCompressed(ObjectID const& id, bool& is_compressed);
+
   /**
    * Get the allocated size for the given object.
    */
@@ -733,6 +782,15 @@ class Client final : public BasicIPCClient,
   Status ReleaseArena(const int fd, std::vector<size_t> const& offsets,
                       std::vector<size_t> const& sizes);
 
+  /**
+   * @brief Release the arena and register the given slices of it as blobs,
+   * the ids of the blobs are returned in the same order of `offsets`. The
+   * blobs are unsealed until `Seal()` is called on them.
+   */
+  Status ReleaseArena(const int fd, std::vector<size_t> const& offsets,
+                      std::vector<size_t> const& sizes,
+                      std::vector<ObjectID>& ids);
+
   using BasicIPCClient::ShallowCopy;
   /**
    * @brief Move the selected objects from the source session to the target
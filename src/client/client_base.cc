@@ -320,6 +320,18 @@ Status ClientBase::PutName(const ObjectID id, std::string const& name) {
   return Status::OK();
 }
 
+Status ClientBase::PutName(const ObjectID id, std::string const& name,
+                           const ObjectID expected) {
+  ENSURE_CONNECTED(this);
+  std::string message_out;
+  WritePutNameRequest(id, name, expected, message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+  json message_in;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(ReadPutNameReply(message_in));
+  return Status::OK();
+}
+
 Status ClientBase::GetName(const std::string& name, ObjectID& id,
                            const bool wait) {
   ENSURE_CONNECTED(this);
@@ -561,6 +573,12 @@ InstanceStatus::InstanceStatus(const json& tree)
       memory_limit(tree["memory_limit"].get<size_t>()),
       deferred_requests(tree["deferred_requests"].get<size_t>()),
       ipc_connections(tree["ipc_connections"].get<size_t>()),
-      rpc_connections(tree["rpc_connections"].get<size_t>()) {}
+      rpc_connections(tree["rpc_connections"].get<size_t>()),
+      compressed_blobs(tree.value("compressed_blobs", static_cast<size_t>(0))),
+      compressed_raw_bytes(
+          tree.value("compressed_raw_bytes", static_cast<size_t>(0))),
+      compressed_bytes(tree.value("compressed_bytes", static_cast<size_t>(0))),
+      compress_seconds(tree.value("compress_seconds", 0.0)),
+      decompress_seconds(tree.value("decompress_seconds", 0.0)) {}
 
 }  // namespace vineyard
@@ -383,6 +383,25 @@ class ClientBase {
    */
   Status PutName(const ObjectID id, std::string const& name);
 
+  /**
+   * @brief Associate the name with the object only if the name is currently
+   * associated with the `expected` object, or is not associated with any
+   * object when `expected` is `InvalidObjectID()`. The check and the update
+   * are atomic, which makes the name a compare-and-swap register.
+   *
+   * @param id The ID of the object.
+   * @param name The user-specific name that will be associated with the given
+   * object.
+   * @param expected The object that the name is expected to be associated
+   * with.
+   *
+   * @return Status that indicates whether the request has succeeded, an
+   * `ObjectExists` error is returned when the name has been associated with
+   * another object.
+   */
+  Status PutName(const ObjectID id, std::string const& name,
+                 const ObjectID expected);
+
   /**
    * @brief Retrieve the object ID by associated name.
    *
@@ -635,6 +654,14 @@ struct InstanceStatus {
   const size_t ipc_connections;
   /// How many RPCClient connects to this vineyard server.
   const size_t rpc_connections;
+  /// How many cold blobs are compressed in memory.
+  const size_t compressed_blobs;
+  /// The original size of the compressed blobs, in bytes.
+  const size_t compressed_raw_bytes;
+  /// The memory occupied by the compressed blobs, in bytes.
+  const size_t compressed_bytes;
+  /// The accumulated time of compressing and decompressing cold blobs.
+  const double compress_seconds, decompress_seconds;
 
   /**
    * @brief Initialize the status value using a json returned from the vineyard
@@ -17,6 +17,8 @@ limitations under the License.
 #define SRC_CLIENT_DS_I_OBJECT_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "client/ds/object_factory.h"
 #include "client/ds/object_meta.h"
@@ -179,6 +181,31 @@ class Object : public ObjectBase, public std::enable_shared_from_this<Object> {
   friend class ObjectMeta;
 };
 
+/**
+ * @brief Projectable is implemented by collection-like data structures, e.g.,
+ * `RecordBatch`, `Table` and `DataFrame`, that support pushing down the
+ * projection in `Client::GetObject(id, columns, object)`.
+ *
+ * It is a separate interface rather than a virtual method of `Object` to
+ * keep the vtable (and thus the ABI) of `Object` unchanged.
+ */
+class Projectable {
+ public:
+  virtual ~Projectable() {}
+
+  /**
+   * @brief `Project` prunes the metadata tree of the object to the given
+   * columns, before the object is constructed: only the blobs of the members
+   * that remain in the tree will be fetched and mapped, and only those
+   * members will be constructed.
+   *
+   * @param tree The metadata tree of the object, from the vineyard server.
+   * @param columns The names of columns to keep, in the given order.
+   */
+  virtual Status Project(json& tree,
+                         std::vector<std::string> const& columns) const = 0;
+};
+
 /**
  * Global object is an tag class to mark a type as a vineyard's GlobalObject.
  *
@@ -15,11 +15,15 @@ limitations under the License.
 
 #include "client/rpc_client.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -36,6 +40,91 @@ limitations under the License.
 
 namespace vineyard {
 
+constexpr size_t RPCClient::default_transfer_chunk_size;
+
+namespace detail {
+
+/**
+ * @brief Persistent threads that drive the extra stripes of transfers, one
+ * thread per stripe, thus the threads are bounded by the transfer concurrency
+ * and reused across transfers.
+ */
+class StripeWorkers {
+ public:
+  explicit StripeWorkers(const size_t n) {
+    for (size_t index = 0; index < n; ++index) {
+      workers_.emplace_back([this, index]() { this->work(index + 1); });
+    }
+  }
+
+  ~StripeWorkers() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  size_t size() const { return workers_.size(); }
+
+  /**
+   * @brief Run `task(1)`, ..., `task(n)` on the workers and `task(0)` on the
+   * calling thread, and wait for all of them.
+   */
+  void Run(std::function<void(size_t)> const& task) {
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ = &task;
+      pending_ = workers_.size();
+      generation_ += 1;
+    }
+    condition_.notify_all();
+    task(0);
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return pending_ == 0; });
+    task_ = nullptr;
+  }
+
+ private:
+  void work(const size_t index) {
+    uint64_t generation = 0;
+    while (true) {
+      std::function<void(size_t)> const* task = nullptr;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [&]() {
+          return stopped_ || generation_ != generation;
+        });
+        if (stopped_) {
+          return;
+        }
+        generation = generation_;
+        task = task_;
+      }
+      (*task)(index);
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+
+  std::mutex run_mutex_;  // serializes `Run()`
+  std::mutex mutex_;
+  std::condition_variable condition_, done_;
+  std::function<void(size_t)> const* task_ = nullptr;
+  uint64_t generation_ = 0;
+  size_t pending_ = 0;
+  bool stopped_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace detail
+
 RPCClient::~RPCClient() { Disconnect(); }
 
 Status RPCClient::Connect() {
@@ -116,8 +205,12 @@ Status RPCClient::Connect(const std::string& host, uint32_t port,
   bool store_match;
   RETURN_ON_ERROR(ReadRegisterReply(
       message_in, ipc_socket_value, rpc_endpoint_value, remote_instance_id_,
-      session_id_, server_version_, store_match, support_rpc_compression_));
+      session_id_, server_version_, store_match, support_rpc_compression_,
+      support_adaptive_compression_));
   ipc_socket_ = ipc_socket_value;
+  if (support_rpc_compression_ && support_adaptive_compression_) {
+    compression_policy_ = std::make_shared<CompressionPolicy>();
+  }
   connected_ = true;
 
   if (!compatible_server(server_version_)) {
@@ -300,33 +393,73 @@ std::vector<std::shared_ptr<Object>> RPCClient::ListObjects(
 
 namespace detail {
 
-Status compress_and_send(std::shared_ptr<Compressor> const& compressor, int fd,
-                         const char* buffer, const size_t buffer_size) {
+Status compress_and_send(std::shared_ptr<AdaptiveCompressor> const& compressor,
+                         int fd, const char* buffer, const size_t buffer_size) {
   RETURN_ON_ERROR(compressor->Compress(buffer, buffer_size));
+  CompressionCodec codec = CompressionCodec::kZSTD;
   void* chunk = nullptr;
   size_t chunk_size = 0;
-  while (compressor->Pull(chunk, chunk_size).ok()) {
+  while (compressor->Pull(codec, chunk, chunk_size).ok()) {
     if (chunk_size == 0) {
       continue;
     }
-    RETURN_ON_ERROR(send_bytes(fd, &chunk_size, sizeof(size_t)));
+    auto start = std::chrono::steady_clock::now();
+    size_t chunk_header = EncodeChunkHeader(codec, chunk_size);
+    RETURN_ON_ERROR(send_bytes(fd, &chunk_header, sizeof(size_t)));
     RETURN_ON_ERROR(send_bytes(fd, chunk, chunk_size));
+    compressor->Sent(chunk_size, std::chrono::duration<double>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+  }
+  return Status::OK();
+}
+
+Status send_chunks(std::shared_ptr<AdaptiveCompressor> const& compressor,
+                   int fd, const char* buffer,
+                   std::vector<PayloadChunk> const& chunks) {
+  for (auto const& chunk : chunks) {
+    if (compressor) {
+      RETURN_ON_ERROR(compress_and_send(compressor, fd,
+                                        buffer + chunk.offset, chunk.size));
+    } else {
+      RETURN_ON_ERROR(send_bytes(fd, buffer + chunk.offset, chunk.size));
+    }
   }
   return Status::OK();
 }
 
 Status recv_and_decompress(std::shared_ptr<Decompressor> const& decompressor,
-                           int fd, char* buffer, const size_t buffer_size) {
+                           int fd, char* buffer, const size_t buffer_size,
+                           TransferMetrics& metrics) {
   size_t decompressed_offset = 0;
   void* incoming_buffer = nullptr;
   size_t incoming_buffer_size = 0;
   while (true) {
     RETURN_ON_ERROR(
         decompressor->Buffer(incoming_buffer, incoming_buffer_size));
-    size_t nbytes = 0;
-    RETURN_ON_ERROR(recv_bytes(fd, &nbytes, sizeof(size_t)));
-    assert(nbytes <= incoming_buffer_size);
+    size_t chunk_header = 0, nbytes = 0;
+    CompressionCodec codec;
+    RETURN_ON_ERROR(recv_bytes(fd, &chunk_header, sizeof(size_t)));
+    RETURN_ON_ERROR(DecodeChunkHeader(chunk_header, codec, nbytes));
+    metrics.wire_bytes += nbytes;
+    if (codec == CompressionCodec::kNone) {
+      // uncompressed chunks are received into the destination directly
+      RETURN_ON_ASSERT(nbytes <= buffer_size - decompressed_offset,
+                       "Invalid uncompressed chunk size: " +
+                           std::to_string(nbytes));
+      RETURN_ON_ERROR(recv_bytes(fd, buffer + decompressed_offset, nbytes));
+      metrics.uncompressed_chunks += 1;
+      decompressed_offset += nbytes;
+      if (decompressed_offset == buffer_size) {
+        break;
+      }
+      continue;
+    }
+    RETURN_ON_ASSERT(nbytes <= incoming_buffer_size,
+                     "Invalid compressed chunk size: " +
+                         std::to_string(nbytes));
     RETURN_ON_ERROR(recv_bytes(fd, incoming_buffer, nbytes));
+    metrics.compressed_chunks += 1;
     RETURN_ON_ERROR(decompressor->Decompress(nbytes));
     size_t chunk_size = 0;
     while (decompressor
@@ -355,6 +488,30 @@ Status recv_and_decompress(std::shared_ptr<Decompressor> const& decompressor,
   return Status::OK();
 }
 
+Status recv_chunks(std::shared_ptr<Decompressor> const& decompressor, int fd,
+                   std::vector<char*> const& buffers,
+                   std::vector<PayloadChunk> const& chunks,
+                   TransferMetrics& metrics) {
+  for (auto const& chunk : chunks) {
+    char* buffer = buffers[chunk.index] + chunk.offset;
+    if (decompressor) {
+      RETURN_ON_ERROR(recv_and_decompress(decompressor, fd, buffer,
+                                          chunk.size, metrics));
+    } else {
+      RETURN_ON_ERROR(recv_bytes(fd, buffer, chunk.size));
+      metrics.wire_bytes += chunk.size;
+    }
+    metrics.raw_bytes += chunk.size;
+  }
+  return Status::OK();
+}
+
+inline double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
 }  // namespace detail
 
 bool RPCClient::IsFetchable(const ObjectMeta& meta) {
@@ -370,10 +527,11 @@ Status RPCClient::CreateRemoteBlob(
     std::shared_ptr<RemoteBlobWriter> const& buffer, ObjectID& id) {
   ENSURE_CONNECTED(this);
   VINEYARD_ASSERT(buffer != nullptr, "Expects a non-null remote blob rewriter");
-  std::shared_ptr<Compressor> compressor;
-  if (support_rpc_compression_) {
-    compressor = std::make_shared<Compressor>();
+  if (transfer_concurrency_ > 1 && buffer->size() > transfer_chunk_size_) {
+    return createRemoteBlobStriped(buffer, id);
   }
+  auto start = std::chrono::steady_clock::now();
+  auto compressor = makeCompressor();
 
   Payload payload;
   int fd_sent = -1;
@@ -402,6 +560,15 @@ Status RPCClient::CreateRemoteBlob(
   RETURN_ON_ASSERT(
       static_cast<size_t>(payload.data_size) == buffer->size(),
       "The result blob size doesn't match with the requested size");
+
+  TransferMetrics metrics;
+  if (compressor) {
+    metrics = compressor->metrics();
+  } else {
+    metrics.raw_bytes = metrics.wire_bytes = buffer->size();
+  }
+  metrics.transfer_seconds = detail::seconds_since(start);
+  upload_metrics_ += metrics;
   return Status::OK();
 }
 
@@ -413,6 +580,7 @@ Status RPCClient::GetRemoteBlob(const ObjectID& id,
 Status RPCClient::GetRemoteBlob(const ObjectID& id, const bool unsafe,
                                 std::shared_ptr<RemoteBlob>& buffer) {
   ENSURE_CONNECTED(this);
+  auto start = std::chrono::steady_clock::now();
   std::shared_ptr<Decompressor> decompressor;
   if (support_rpc_compression_) {
     decompressor = std::make_shared<Decompressor>();
@@ -433,14 +601,19 @@ Status RPCClient::GetRemoteBlob(const ObjectID& id, const bool unsafe,
   // read the actual payload
   buffer = std::shared_ptr<RemoteBlob>(new RemoteBlob(
       payloads[0].object_id, remote_instance_id_, payloads[0].data_size));
+  TransferMetrics metrics;
   if (decompressor && payloads[0].data_size > 0) {
-    RETURN_ON_ERROR(detail::recv_and_decompress(decompressor, vineyard_conn_,
-                                                buffer->mutable_data(),
-                                                payloads[0].data_size));
+    RETURN_ON_ERROR(detail::recv_and_decompress(
+        decompressor, vineyard_conn_, buffer->mutable_data(),
+        payloads[0].data_size, metrics));
   } else if (payloads[0].data_size > 0) {
     RETURN_ON_ERROR(recv_bytes(vineyard_conn_, buffer->mutable_data(),
                                payloads[0].data_size));
+    metrics.wire_bytes = payloads[0].data_size;
   }
+  metrics.raw_bytes = payloads[0].data_size;
+  metrics.transfer_seconds = detail::seconds_since(start);
+  download_metrics_ += metrics;
   return Status::OK();
 }
 
@@ -454,6 +627,10 @@ Status RPCClient::GetRemoteBlobs(
     std::vector<ObjectID> const& ids, const bool unsafe,
     std::vector<std::shared_ptr<RemoteBlob>>& remote_blobs) {
   ENSURE_CONNECTED(this);
+  if (transfer_concurrency_ > 1) {
+    return getRemoteBlobsStriped(ids, unsafe, remote_blobs);
+  }
+  auto start = std::chrono::steady_clock::now();
   std::shared_ptr<Decompressor> decompressor;
   if (support_rpc_compression_) {
     decompressor = std::make_shared<Decompressor>();
@@ -474,20 +651,25 @@ Status RPCClient::GetRemoteBlobs(
                        std::to_string(payloads.size()) + " vs. " +
                        std::to_string(id_set.size()));
 
+  TransferMetrics metrics;
   std::unordered_map<ObjectID, std::shared_ptr<RemoteBlob>> id_payload_map;
   for (auto const& payload : payloads) {
     auto remote_blob = std::shared_ptr<RemoteBlob>(new RemoteBlob(
         payload.object_id, remote_instance_id_, payload.data_size));
     if (decompressor && payload.data_size > 0) {
-      RETURN_ON_ERROR(detail::recv_and_decompress(decompressor, vineyard_conn_,
-                                                  remote_blob->mutable_data(),
-                                                  payload.data_size));
+      RETURN_ON_ERROR(detail::recv_and_decompress(
+          decompressor, vineyard_conn_, remote_blob->mutable_data(),
+          payload.data_size, metrics));
     } else {
       RETURN_ON_ERROR(recv_bytes(vineyard_conn_, remote_blob->mutable_data(),
                                  payload.data_size));
+      metrics.wire_bytes += payload.data_size;
     }
+    metrics.raw_bytes += payload.data_size;
     id_payload_map[payload.object_id] = remote_blob;
   }
+  metrics.transfer_seconds = detail::seconds_since(start);
+  download_metrics_ += metrics;
   // clear the result container
   remote_blobs.clear();
   for (auto const& id : ids) {
@@ -501,4 +683,272 @@ Status RPCClient::GetRemoteBlobs(
   return Status::OK();
 }
 
+Status RPCClient::SetTransferConcurrency(const size_t connections,
+                                         const size_t chunk_size) {
+  ENSURE_CONNECTED(this);
+  RETURN_ON_ASSERT(connections >= 1, "At least one connection is required");
+  RETURN_ON_ASSERT(chunk_size > 0, "The chunk size must be positive");
+  transfer_concurrency_ = connections;
+  transfer_chunk_size_ = chunk_size;
+  if (stripes_.size() >= connections) {
+    stripes_.resize(connections - 1);
+  }
+  return Status::OK();
+}
+
+Status RPCClient::ensureStripes() {
+  while (stripes_.size() + 1 < transfer_concurrency_) {
+    auto client = std::make_shared<RPCClient>();
+    RETURN_ON_ERROR(this->Fork(*client));
+    stripes_.emplace_back(client);
+  }
+  for (auto& client : stripes_) {
+    client->transfer_chunk_size_ = transfer_chunk_size_;
+  }
+  if (stripe_workers_ == nullptr ||
+      stripe_workers_->size() != stripes_.size()) {
+    stripe_workers_ = std::make_shared<detail::StripeWorkers>(stripes_.size());
+  }
+  return Status::OK();
+}
+
+Status RPCClient::createRemoteBlobStriped(
+    std::shared_ptr<RemoteBlobWriter> const& buffer, ObjectID& id) {
+  RETURN_ON_ERROR(ensureStripes());
+  const size_t stripes = stripes_.size() + 1;
+  auto start = std::chrono::steady_clock::now();
+
+  // the first stripe creates the blob, and the others write into it
+  ObjectID blob_id = InvalidObjectID();
+  RETURN_ON_ERROR(requestPutRemoteBufferChunks(InvalidObjectID(),
+                                               buffer->size(), 0, stripes,
+                                               blob_id));
+
+  std::vector<Status> statuses(stripes);
+  std::vector<TransferMetrics> metrics(stripes);
+  stripe_workers_->Run([&](const size_t stripe) {
+    if (stripe == 0) {
+      statuses[0] = sendRemoteBufferChunks(buffer->data(), buffer->size(), 0,
+                                           stripes, metrics[0]);
+      return;
+    }
+    auto& client = stripes_[stripe - 1];
+    ObjectID stripe_blob_id = InvalidObjectID();
+    statuses[stripe] = client->requestPutRemoteBufferChunks(
+        blob_id, buffer->size(), stripe, stripes, stripe_blob_id);
+    if (statuses[stripe].ok()) {
+      statuses[stripe] = client->sendRemoteBufferChunks(
+          buffer->data(), buffer->size(), stripe, stripes, metrics[stripe]);
+    }
+  });
+  for (auto const& status : statuses) {
+    if (!status.ok()) {
+      VINEYARD_DISCARD(DelData(blob_id));
+      return status;
+    }
+  }
+  id = blob_id;
+
+  // the stripes run in parallel, thus the wall time of the whole transfer
+  // is used
+  for (size_t stripe = 1; stripe < stripes; ++stripe) {
+    metrics[0] += metrics[stripe];
+  }
+  metrics[0].transfer_seconds = detail::seconds_since(start);
+  upload_metrics_ += metrics[0];
+  return Status::OK();
+}
+
+Status RPCClient::getRemoteBlobsStriped(
+    std::vector<ObjectID> const& ids, const bool unsafe,
+    std::vector<std::shared_ptr<RemoteBlob>>& remote_blobs) {
+  RETURN_ON_ERROR(ensureStripes());
+  const size_t stripes = stripes_.size() + 1;
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<ObjectID> unique_ids;
+  {
+    std::unordered_set<ObjectID> id_set;
+    for (auto const& id : ids) {
+      if (id_set.emplace(id).second) {
+        unique_ids.emplace_back(id);
+      }
+    }
+  }
+
+  // the first stripe allocates the destination buffers
+  std::vector<Payload> payloads;
+  RETURN_ON_ERROR(
+      requestGetRemoteBufferChunks(unique_ids, unsafe, 0, stripes, payloads));
+  std::vector<int64_t> sizes;
+  std::vector<char*> buffers;
+  std::unordered_map<ObjectID, std::shared_ptr<RemoteBlob>> id_payload_map;
+  for (auto const& payload : payloads) {
+    auto remote_blob = std::shared_ptr<RemoteBlob>(new RemoteBlob(
+        payload.object_id, remote_instance_id_, payload.data_size));
+    sizes.emplace_back(payload.data_size);
+    buffers.emplace_back(remote_blob->mutable_data());
+    id_payload_map[payload.object_id] = remote_blob;
+  }
+
+  std::vector<Status> statuses(stripes);
+  std::vector<TransferMetrics> metrics(stripes);
+  stripe_workers_->Run([&](const size_t stripe) {
+    if (stripe == 0) {
+      statuses[0] =
+          recvRemoteBufferChunks(sizes, buffers, 0, stripes, metrics[0]);
+      return;
+    }
+    auto& client = stripes_[stripe - 1];
+    std::vector<Payload> stripe_payloads;
+    statuses[stripe] = client->requestGetRemoteBufferChunks(
+        unique_ids, unsafe, stripe, stripes, stripe_payloads);
+    if (!statuses[stripe].ok()) {
+      return;
+    }
+    bool matched = stripe_payloads.size() == payloads.size();
+    for (size_t i = 0; matched && i < payloads.size(); ++i) {
+      matched = stripe_payloads[i].object_id == payloads[i].object_id &&
+                stripe_payloads[i].data_size == payloads[i].data_size;
+    }
+    if (!matched) {
+      // drain the connection as the payloads are being sent
+      std::vector<int64_t> stripe_sizes;
+      std::vector<std::unique_ptr<char[]>> holders;
+      std::vector<char*> stripe_buffers;
+      for (auto const& payload : stripe_payloads) {
+        stripe_sizes.emplace_back(payload.data_size);
+        holders.emplace_back(new char[payload.data_size]);
+        stripe_buffers.emplace_back(holders.back().get());
+      }
+      TransferMetrics drained;
+      VINEYARD_DISCARD(client->recvRemoteBufferChunks(
+          stripe_sizes, stripe_buffers, stripe, stripes, drained));
+      statuses[stripe] = Status::Invalid(
+          "The blobs have been changed during the striped transfer");
+      return;
+    }
+    statuses[stripe] = client->recvRemoteBufferChunks(
+        sizes, buffers, stripe, stripes, metrics[stripe]);
+  });
+  for (auto const& status : statuses) {
+    RETURN_ON_ERROR(status);
+  }
+  for (size_t stripe = 1; stripe < stripes; ++stripe) {
+    metrics[0] += metrics[stripe];
+  }
+  metrics[0].transfer_seconds = detail::seconds_since(start);
+  download_metrics_ += metrics[0];
+
+  // clear the result container
+  remote_blobs.clear();
+  for (auto const& id : ids) {
+    auto it = id_payload_map.find(id);
+    if (it == id_payload_map.end()) {
+      remote_blobs.emplace_back(nullptr);
+    } else {
+      remote_blobs.emplace_back(it->second);
+    }
+  }
+  return Status::OK();
+}
+
+Status RPCClient::requestPutRemoteBufferChunks(const ObjectID id,
+                                               const size_t size,
+                                               const size_t stripe,
+                                               const size_t stripes,
+                                               ObjectID& result_id) {
+  ENSURE_CONNECTED(this);
+  std::string message_out;
+  WritePutRemoteBufferChunksRequest(id, size, stripe, stripes,
+                                    transfer_chunk_size_,
+                                    support_rpc_compression_, message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+
+  // receive a confirm to continue
+  json message_in;
+  Payload payload;
+  int fd_sent = -1;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(
+      ReadCreateBufferReply(message_in, result_id, payload, fd_sent));
+  return Status::OK();
+}
+
+Status RPCClient::sendRemoteBufferChunks(const char* data, const size_t size,
+                                         const size_t stripe,
+                                         const size_t stripes,
+                                         TransferMetrics& metrics) {
+  ENSURE_CONNECTED(this);
+  auto compressor = makeCompressor();
+  auto chunks = StripePayloadChunks({static_cast<int64_t>(size)}, stripe,
+                                    stripes, transfer_chunk_size_);
+  RETURN_ON_ERROR(
+      detail::send_chunks(compressor, vineyard_conn_, data, chunks));
+  if (compressor) {
+    metrics += compressor->metrics();
+  } else {
+    for (auto const& chunk : chunks) {
+      metrics.raw_bytes += chunk.size;
+      metrics.wire_bytes += chunk.size;
+    }
+  }
+
+  json message_in;
+  ObjectID id = InvalidObjectID();
+  Payload payload;
+  int fd_sent = -1;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(ReadCreateBufferReply(message_in, id, payload, fd_sent));
+  RETURN_ON_ASSERT(
+      static_cast<size_t>(payload.data_size) == size,
+      "The result blob size doesn't match with the requested size");
+  return Status::OK();
+}
+
+Status RPCClient::requestGetRemoteBufferChunks(std::vector<ObjectID> const& ids,
+                                               const bool unsafe,
+                                               const size_t stripe,
+                                               const size_t stripes,
+                                               std::vector<Payload>& payloads) {
+  ENSURE_CONNECTED(this);
+  std::string message_out;
+  WriteGetRemoteBufferChunksRequest(ids, stripe, stripes, transfer_chunk_size_,
+                                    unsafe, support_rpc_compression_,
+                                    message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+  json message_in;
+  std::vector<int> fd_sent;
+  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(ReadGetBuffersReply(message_in, payloads, fd_sent));
+  RETURN_ON_ASSERT(payloads.size() == ids.size(),
+                   "The result size doesn't match with the requested sizes: " +
+                       std::to_string(payloads.size()) + " vs. " +
+                       std::to_string(ids.size()));
+  return Status::OK();
+}
+
+Status RPCClient::recvRemoteBufferChunks(std::vector<int64_t> const& sizes,
+                                         std::vector<char*> const& buffers,
+                                         const size_t stripe,
+                                         const size_t stripes,
+                                         TransferMetrics& metrics) {
+  ENSURE_CONNECTED(this);
+  std::shared_ptr<Decompressor> decompressor;
+  if (support_rpc_compression_) {
+    decompressor = std::make_shared<Decompressor>();
+  }
+  auto chunks =
+      StripePayloadChunks(sizes, stripe, stripes, transfer_chunk_size_);
+  return detail::recv_chunks(decompressor, vineyard_conn_, buffers, chunks,
+                             metrics);
+}
+
+std::shared_ptr<AdaptiveCompressor> RPCClient::makeCompressor() const {
+  if (!support_rpc_compression_) {
+    return nullptr;
+  }
+  return std::make_shared<AdaptiveCompressor>(compression_policy_);
+}
+
 }  // namespace vineyard
@@ -24,11 +24,17 @@ limitations under the License.
 #include "client/ds/i_object.h"
 #include "client/ds/object_meta.h"
 #include "client/ds/remote_blob.h"
+#include "common/compression/compressor.h"
+#include "common/memory/payload.h"
 #include "common/util/status.h"
 #include "common/util/uuid.h"
 
 namespace vineyard {
 
+namespace detail {
+class StripeWorkers;
+}  // namespace detail
+
 class Blob;
 class BlobWriter;
 
@@ -340,9 +346,79 @@ class RPCClient final : public ClientBase {
   Status GetRemoteBlobs(std::vector<ObjectID> const& ids, const bool unsafe,
                         std::vector<std::shared_ptr<RemoteBlob>>& remote_blobs);
 
+  /**
+   * @brief Transfer blobs in `CreateRemoteBlob` and `GetRemoteBlobs` over
+   * `connections` TCP connections to the same vineyard server.
+   *
+   * The payloads are split into chunks of `chunk_size` bytes and assigned to
+   * connections in a round-robin manner, each connection (de)compresses and
+   * transfers its own share of chunks on a separate thread, and chunks are
+   * written to the destination blob directly in whatever order they arrive.
+   *
+   * `connections` of 1 (the default) disables the striped transfer.
+   */
+  Status SetTransferConcurrency(
+      const size_t connections,
+      const size_t chunk_size = default_transfer_chunk_size);
+
+  static constexpr size_t default_transfer_chunk_size = 4 * 1024 * 1024;
+
+  /**
+   * @brief Statistics of `CreateRemoteBlob` calls, including the achieved
+   * bandwidth and the compression ratio.
+   */
+  TransferMetrics const& upload_metrics() const { return upload_metrics_; }
+
+  /**
+   * @brief Statistics of `GetRemoteBlob(s)` calls, including the achieved
+   * bandwidth and the compression ratio.
+   */
+  TransferMetrics const& download_metrics() const { return download_metrics_; }
+
  private:
+  Status ensureStripes();
+
+  Status createRemoteBlobStriped(
+      std::shared_ptr<RemoteBlobWriter> const& buffer, ObjectID& id);
+
+  Status getRemoteBlobsStriped(
+      std::vector<ObjectID> const& ids, const bool unsafe,
+      std::vector<std::shared_ptr<RemoteBlob>>& remote_blobs);
+
+  Status requestPutRemoteBufferChunks(const ObjectID id, const size_t size,
+                                      const size_t stripe, const size_t stripes,
+                                      ObjectID& result_id);
+
+  Status sendRemoteBufferChunks(const char* data, const size_t size,
+                                const size_t stripe, const size_t stripes,
+                                TransferMetrics& metrics);
+
+  Status requestGetRemoteBufferChunks(std::vector<ObjectID> const& ids,
+                                      const bool unsafe, const size_t stripe,
+                                      const size_t stripes,
+                                      std::vector<Payload>& payloads);
+
+  Status recvRemoteBufferChunks(std::vector<int64_t> const& sizes,
+                                std::vector<char*> const& buffers,
+                                const size_t stripe, const size_t stripes,
+                                TransferMetrics& metrics);
+
+  std::shared_ptr<AdaptiveCompressor> makeCompressor() const;
+
   InstanceID remote_instance_id_;
   bool support_rpc_compression_ = false;
+  bool support_adaptive_compression_ = false;
+
+  // chooses the codec of chunks sent to the server, the estimations of
+  // compression speed and link throughput are kept across requests
+  std::shared_ptr<CompressionPolicy> compression_policy_;
+  TransferMetrics upload_metrics_, download_metrics_;
+
+  // extra connections for striped transfer, driven by persistent workers
+  std::vector<std::shared_ptr<RPCClient>> stripes_;
+  std::shared_ptr<detail::StripeWorkers> stripe_workers_;
+  size_t transfer_concurrency_ = 1;
+  size_t transfer_chunk_size_ = default_transfer_chunk_size;
 
   friend class Client;
 };
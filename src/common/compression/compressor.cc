@@ -16,7 +16,11 @@ limitations under the License.
 #include "common/compression/compressor.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
 #include <string>
+#include <vector>
 
 #include "zstd/lib/zstd.h"
 
@@ -34,8 +38,16 @@ namespace vineyard {
   } while (0)
 #endif  // RETURN_ON_ZSTD_ERROR
 
-Compressor::Compressor() {
+constexpr int Compressor::default_level;
+constexpr size_t Compressor::default_accumulated_bytes;
+
+Compressor::Compressor(const int level, const size_t accumulated_bytes,
+                       const bool end_frames)
+    : maximum_accumulated_bytes(accumulated_bytes),
+      end_frames_(end_frames),
+      level_(level) {
   stream = ZSTD_createCStream();
+  ZSTD_CCtx_setParameter(stream, ZSTD_c_compressionLevel, level_);
   in_size_ = ZSTD_CStreamInSize();
   out_size_ = ZSTD_CStreamOutSize();
   accumulated_ = 0;
@@ -66,12 +78,29 @@ Compressor::~Compressor() {
   }
 }
 
+Status Compressor::SetLevel(const int level) {
+  if (level == level_) {
+    return Status::OK();
+  }
+  if (!finished_ || flushing_ || (started_ && !end_frames_)) {
+    return Status::Invalid(
+        "Compressor: the compression level can only be changed between "
+        "zstd frames");
+  }
+  RETURN_ON_ZSTD_ERROR(
+      ZSTD_CCtx_setParameter(stream, ZSTD_c_compressionLevel, level),
+      "ZSTD set compression level");
+  level_ = level;
+  return Status::OK();
+}
+
 Status Compressor::Compress(const void* data, const size_t size) {
   if (!finished_) {
     return Status::Invalid("Compressor: the zstd stream is not finished yet");
   }
   *input_ = ZSTD_inBuffer{data, size, 0};
   finished_ = false;
+  started_ = true;
   return Status::OK();
 }
 
@@ -84,6 +113,24 @@ Status Compressor::Pull(void*& data, size_t& size) {
   // reset output pointer
   output_->pos = 0;
 
+  if (end_frames_) {
+    // end the frame along with the last block of the input, rather than in
+    // a separate flush that yields an empty last block, thus the chunk that
+    // completes the frame always carries some payload, and the receivers,
+    // which stop once the expected bytes are decompressed, never leave the
+    // end of the frame unread in the stream.
+    size_t ret = ZSTD_compressStream2(stream, output_, input_,
+                                      ZSTD_EndDirective::ZSTD_e_end);
+    RETURN_ON_ZSTD_ERROR(ret, "ZSTD compress end");
+    if (ret == 0) {  // the frame is ended and fully flushed
+      finished_ = true;
+      flushing_ = false;
+    }
+    data = output_->dst;
+    size = output_->pos;
+    return Status::OK();
+  }
+
   // if reach a flush point, flush util empty to make the decompressor
   // can start work and avoid much memory consumption.
   if (accumulated_ >= maximum_accumulated_bytes) {
@@ -211,4 +258,307 @@ Status Decompressor::Pull(void* data, const size_t capacity, size_t& size) {
   return Status::OK();
 }
 
+Status CompressBuffer(const void* data, const size_t size, const int level,
+                      std::vector<uint8_t>& compressed) {
+  Compressor compressor(level, Compressor::default_accumulated_bytes, true);
+  RETURN_ON_ERROR(compressor.Compress(data, size));
+  while (true) {
+    void* chunk = nullptr;
+    size_t chunk_size = 0;
+    auto status = compressor.Pull(chunk, chunk_size);
+    if (status.IsStreamDrained()) {
+      break;
+    }
+    RETURN_ON_ERROR(status);
+    auto bytes = static_cast<const uint8_t*>(chunk);
+    compressed.insert(compressed.end(), bytes, bytes + chunk_size);
+  }
+  return Status::OK();
+}
+
+Status DecompressBuffer(const void* data, const size_t size, void* out,
+                        const size_t out_size) {
+  Decompressor decompressor;
+  auto input = static_cast<const uint8_t*>(data);
+  auto output = static_cast<uint8_t*>(out);
+  size_t consumed = 0, produced = 0;
+  while (consumed < size) {
+    void* buffer = nullptr;
+    size_t capacity = 0;
+    RETURN_ON_ERROR(decompressor.Buffer(buffer, capacity));
+    size_t nbytes = std::min(capacity, size - consumed);
+    memcpy(buffer, input + consumed, nbytes);
+    consumed += nbytes;
+    RETURN_ON_ERROR(decompressor.Decompress(nbytes));
+    // pull until the input is drained, with at least one byte of capacity
+    // to detect the unexpected trailing output
+    while (true) {
+      uint8_t overflow = 0;
+      size_t chunk_size = 0;
+      auto status =
+          produced < out_size
+              ? decompressor.Pull(output + produced, out_size - produced,
+                                  chunk_size)
+              : decompressor.Pull(&overflow, 1, chunk_size);
+      if (status.IsStreamDrained()) {
+        break;
+      }
+      RETURN_ON_ERROR(status);
+      if (produced == out_size && chunk_size > 0) {
+        return Status::IOError(
+            "Decompressor: the decompressed data exceeds the expected size " +
+            std::to_string(out_size));
+      }
+      produced += chunk_size;
+    }
+  }
+  if (produced != out_size) {
+    return Status::IOError("Decompressor: expects " + std::to_string(out_size) +
+                           " bytes, but got " + std::to_string(produced));
+  }
+  return Status::OK();
+}
+
+TransferMetrics& TransferMetrics::operator+=(TransferMetrics const& rhs) {
+  raw_bytes += rhs.raw_bytes;
+  wire_bytes += rhs.wire_bytes;
+  compressed_chunks += rhs.compressed_chunks;
+  uncompressed_chunks += rhs.uncompressed_chunks;
+  compress_seconds += rhs.compress_seconds;
+  transfer_seconds += rhs.transfer_seconds;
+  return *this;
+}
+
+namespace detail {
+
+// zstd levels to choose from, the negative level works as a LZ4-alike codec.
+static const int candidate_levels[] = {-5, 1, 3, 9};
+
+// initial estimations of the compression speed and ratio of each level,
+// relative to the speed and ratio measured when sampling (at level 1), as
+// both of them depend heavily on the content.
+static const double initial_speed_scales[] = {2.0, 1.0, 0.6, 0.15};
+static const double initial_ratio_scales[] = {1.2, 1.0, 0.92, 0.85};
+
+// assume a 10Gbps link before any observation
+static const double initial_link_throughput = 1.25e9;
+
+static const double smoothing_factor = 0.25;
+
+static const size_t samples = 4;
+static const size_t sample_size = 16 * 1024;
+
+inline double smooth(const double estimated, const double observed) {
+  return estimated * (1 - smoothing_factor) + observed * smoothing_factor;
+}
+
+}  // namespace detail
+
+constexpr size_t CompressionPolicy::minimum_sample_bytes;
+constexpr size_t CompressionPolicy::minimum_link_bytes;
+
+CompressionPolicy::CompressionPolicy()
+    : speed_scales_(std::begin(detail::initial_speed_scales),
+                    std::end(detail::initial_speed_scales)),
+      ratio_scales_(std::begin(detail::initial_ratio_scales),
+                    std::end(detail::initial_ratio_scales)),
+      link_throughput_(detail::initial_link_throughput) {}
+
+CompressionPolicy::~CompressionPolicy() {
+  if (sampler_) {
+    ZSTD_freeCCtx(sampler_);
+    sampler_ = nullptr;
+  }
+}
+
+double CompressionPolicy::Choose(const void* data, const size_t size,
+                                 CompressionCodec& codec, int& level) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size < minimum_sample_bytes) {
+    codec = last_codec_;
+    level = last_level_;
+    return last_ratio_;
+  }
+  double ratio = 1.0, speed = 0;
+  sample(data, size, ratio, speed);
+  last_speed_ = speed;
+
+  // compare the expected seconds of sending a byte
+  double best = 1.0 / link_throughput_;
+  codec = CompressionCodec::kNone;
+  level = last_level_;
+  for (size_t index = 0; speed > 0 && index < speed_scales_.size(); ++index) {
+    double cost = 1.0 / (speed * speed_scales_[index]) +
+                  std::min(1.0, ratio * ratio_scales_[index]) /
+                      link_throughput_;
+    if (cost < best) {
+      best = cost;
+      codec = CompressionCodec::kZSTD;
+      level = detail::candidate_levels[index];
+    }
+  }
+  last_codec_ = codec;
+  last_level_ = level;
+  last_ratio_ = ratio;
+  return ratio;
+}
+
+void CompressionPolicy::ObserveCompression(const int level,
+                                           const double sampled_ratio,
+                                           const size_t input_size,
+                                           const size_t output_size,
+                                           const double seconds) {
+  if (input_size < minimum_sample_bytes || seconds <= 0 ||
+      sampled_ratio <= 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (last_speed_ <= 0) {
+    return;
+  }
+  for (size_t index = 0; index < speed_scales_.size(); ++index) {
+    if (detail::candidate_levels[index] == level) {
+      speed_scales_[index] =
+          detail::smooth(speed_scales_[index],
+                         input_size / seconds / last_speed_);
+      ratio_scales_[index] = detail::smooth(
+          ratio_scales_[index],
+          static_cast<double>(output_size) / input_size / sampled_ratio);
+      break;
+    }
+  }
+}
+
+void CompressionPolicy::ObserveLink(const size_t size, const double seconds) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // small writes only measure the socket buffer, thus accumulates until
+  // enough bytes are written
+  link_bytes_ += size;
+  link_seconds_ += seconds;
+  if (link_bytes_ >= minimum_link_bytes && link_seconds_ > 0) {
+    link_throughput_ =
+        detail::smooth(link_throughput_, link_bytes_ / link_seconds_);
+    link_bytes_ = 0;
+    link_seconds_ = 0;
+  }
+}
+
+void CompressionPolicy::sample(const void* data, const size_t size,
+                               double& ratio, double& speed) {
+  if (sampler_ == nullptr) {
+    sampler_ = ZSTD_createCCtx();
+    sample_buffer_.resize(ZSTD_compressBound(detail::sample_size));
+  }
+  const size_t sample_size =
+      std::min(detail::sample_size, size / detail::samples);
+  const size_t stride = (size - sample_size) / (detail::samples - 1);
+  size_t input_size = 0, output_size = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t index = 0; index < detail::samples; ++index) {
+    size_t ret = ZSTD_compressCCtx(
+        sampler_, sample_buffer_.data(), sample_buffer_.size(),
+        static_cast<const char*>(data) + stride * index, sample_size, 1);
+    if (ZSTD_isError(ret)) {
+      ratio = 1.0;
+      speed = 0;
+      return;
+    }
+    input_size += sample_size;
+    output_size += ret;
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  ratio = static_cast<double>(output_size) / input_size;
+  // the sampling may be too fast to be measured
+  speed = input_size / std::max(seconds, 1e-6);
+}
+
+constexpr size_t AdaptiveCompressor::default_block_size;
+
+AdaptiveCompressor::AdaptiveCompressor(
+    std::shared_ptr<CompressionPolicy> const& policy, const size_t block_size)
+    : policy_(policy),
+      block_size_(policy ? block_size : std::numeric_limits<size_t>::max()),
+      compressor_(Compressor::default_level,
+                  Compressor::default_accumulated_bytes,
+                  policy != nullptr /* end frames to allow changing level */) {
+}
+
+Status AdaptiveCompressor::Compress(const void* data, const size_t size) {
+  if (compressing_ || input_offset_ < input_size_) {
+    return Status::Invalid(
+        "AdaptiveCompressor: the previous input is not finished yet");
+  }
+  input_ = static_cast<const char*>(data);
+  input_size_ = size;
+  input_offset_ = 0;
+  return Status::OK();
+}
+
+Status AdaptiveCompressor::Pull(CompressionCodec& codec, void*& data,
+                                size_t& size) {
+  if (compressing_) {
+    auto start = std::chrono::steady_clock::now();
+    auto s = compressor_.Pull(data, size);
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    block_seconds_ += seconds;
+    metrics_.compress_seconds += seconds;
+    if (s.ok()) {
+      codec = CompressionCodec::kZSTD;
+      block_output_ += size;
+      if (size > 0) {
+        metrics_.wire_bytes += size;
+        metrics_.compressed_chunks += 1;
+      }
+      return s;
+    }
+    if (!s.IsStreamDrained()) {
+      return s;
+    }
+    compressing_ = false;
+    if (policy_) {
+      policy_->ObserveCompression(level_, sampled_ratio_, block_input_,
+                                  block_output_, block_seconds_);
+    }
+  }
+
+  if (input_offset_ >= input_size_) {
+    size = 0;
+    return Status::StreamDrained();
+  }
+  const char* block = input_ + input_offset_;
+  const size_t block_size = std::min(block_size_, input_size_ - input_offset_);
+  input_offset_ += block_size;
+  metrics_.raw_bytes += block_size;
+
+  codec = CompressionCodec::kZSTD;
+  level_ = Compressor::default_level;
+  if (policy_) {
+    sampled_ratio_ = policy_->Choose(block, block_size, codec, level_);
+  }
+  if (codec == CompressionCodec::kNone) {
+    data = const_cast<char*>(block);
+    size = block_size;
+    metrics_.wire_bytes += size;
+    metrics_.uncompressed_chunks += 1;
+    return Status::OK();
+  }
+  RETURN_ON_ERROR(compressor_.SetLevel(level_));
+  RETURN_ON_ERROR(compressor_.Compress(block, block_size));
+  compressing_ = true;
+  block_input_ = block_size;
+  block_output_ = 0;
+  block_seconds_ = 0;
+  return Pull(codec, data, size);
+}
+
+void AdaptiveCompressor::Sent(const size_t size, const double seconds) {
+  if (policy_) {
+    policy_->ObserveLink(size, seconds);
+  }
+}
+
 }  // namespace vineyard
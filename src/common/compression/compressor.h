@@ -16,6 +16,14 @@ limitations under the License.
 #ifndef SRC_COMMON_COMPRESSION_COMPRESSOR_H_
 #define SRC_COMMON_COMPRESSION_COMPRESSOR_H_
 
+#include <stdint.h>
+
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "common/util/status.h"
 
 // forward declaration to avoid including zstd.h
@@ -40,27 +48,49 @@ namespace vineyard {
  */
 class Compressor {
  public:
+  static constexpr int default_level = 3;  // ZSTD_CLEVEL_DEFAULT
+  static constexpr size_t default_accumulated_bytes = 64 * 1024 * 1024;
+
   /**
-   * Whether to set the first word as the buffer length in `Pull`.
+   * @param level The zstd compression level.
+   * @param accumulated_bytes Flush the stream once so many compressed bytes
+   *        are produced, to let the decompressor start working.
+   * @param end_frames Whether to end the zstd frame (rather than flush it)
+   *        at the end of each input, thus the compression level can be
+   *        changed between inputs. The frame is ended along with the last
+   *        block of the input, and `accumulated_bytes` doesn't apply.
    */
-  Compressor();
+  explicit Compressor(
+      const int level = default_level,
+      const size_t accumulated_bytes = default_accumulated_bytes,
+      const bool end_frames = false);
   ~Compressor();
 
   size_t input_size() const { return in_size_; }
 
   size_t output_size() const { return out_size_; }
 
+  int level() const { return level_; }
+
   bool Finished() const { return finished_; }
 
+  /**
+   * Change the compression level for the next input. Only valid before the
+   * first input, or between inputs when frames are ended.
+   */
+  Status SetLevel(const int level);
+
   Status Compress(const void* data, const size_t size);
 
   Status Pull(void*& data, size_t& size);
 
  private:
-  const size_t maximum_accumulated_bytes = 64 * 1024 * 1024;  // 64MB
+  const size_t maximum_accumulated_bytes;
+  const bool end_frames_;
 
+  int level_;
   size_t in_size_, out_size_, accumulated_;
-  bool finished_ = true, flushing_ = false;
+  bool finished_ = true, flushing_ = false, started_ = false;
   struct ZSTD_inBuffer_s* input_ = nullptr;
   struct ZSTD_outBuffer_s* output_ = nullptr;
   ZSTD_CCtx_s* stream = nullptr;
@@ -112,6 +142,189 @@ class Decompressor {
   ZSTD_DCtx_s* stream = nullptr;
 };
 
+/**
+ * Compress the whole buffer as a single zstd frame, the compressed bytes are
+ * appended to `compressed`.
+ */
+Status CompressBuffer(const void* data, const size_t size, const int level,
+                      std::vector<uint8_t>& compressed);
+
+/**
+ * Decompress the frame produced by `CompressBuffer` into `out`, whose size
+ * must be exactly the size of the original buffer.
+ */
+Status DecompressBuffer(const void* data, const size_t size, void* out,
+                        const size_t out_size);
+
+/**
+ * The codec of a chunk on the wire.
+ *
+ * Each chunk is prefixed by a `size_t` header, where the lowest 56 bits are
+ * the size of the chunk and the highest 8 bits are the codec. The codec of
+ * zstd chunks is zero, thus the header is the same as the one used by peers
+ * that don't know adaptive compression.
+ */
+enum class CompressionCodec : uint8_t {
+  kZSTD = 0,
+  kNone = 1,
+};
+
+inline size_t EncodeChunkHeader(const CompressionCodec codec,
+                                const size_t size) {
+  return (static_cast<size_t>(codec) << 56) | size;
+}
+
+inline Status DecodeChunkHeader(const size_t header, CompressionCodec& codec,
+                                size_t& size) {
+  size = header & ((static_cast<size_t>(1) << 56) - 1);
+  codec = static_cast<CompressionCodec>(header >> 56);
+  if (codec != CompressionCodec::kZSTD && codec != CompressionCodec::kNone) {
+    return Status::IOError("Unknown compression codec in chunk header: " +
+                           std::to_string(header >> 56));
+  }
+  return Status::OK();
+}
+
+/**
+ * Statistics of blob transfers, see also `AdaptiveCompressor`.
+ */
+struct TransferMetrics {
+  size_t raw_bytes = 0;   // bytes of the payloads
+  size_t wire_bytes = 0;  // bytes of the chunks written to the link
+  size_t compressed_chunks = 0;
+  size_t uncompressed_chunks = 0;
+  double compress_seconds = 0;
+  double transfer_seconds = 0;  // wall time, including the compression
+
+  // the achieved bandwidth, in bytes of payloads per second
+  double bandwidth() const {
+    return transfer_seconds > 0 ? raw_bytes / transfer_seconds : 0;
+  }
+
+  double compression_ratio() const {
+    return raw_bytes > 0 ? static_cast<double>(wire_bytes) / raw_bytes : 1.0;
+  }
+
+  TransferMetrics& operator+=(TransferMetrics const& rhs);
+};
+
+/**
+ * Chooses the codec and the zstd level of each block of a transfer.
+ *
+ * The compression ratio and speed of a block are estimated by compressing a
+ * few small samples of it at a fast level, then the expected time of sending
+ * the block as is is compared with the time of compressing it at each
+ * candidate level plus sending the compressed bytes, where the estimations of
+ * each level are corrected by the compression and link throughput observed
+ * from previous blocks. Thus random or already-compressed
+ * data is sent as is on fast links, while highly compressible data (e.g.,
+ * sparse integer columns) is compressed harder on slow links.
+ *
+ * A policy lives as long as the connection, so the estimations survive across
+ * requests.
+ */
+class CompressionPolicy {
+ public:
+  CompressionPolicy();
+  ~CompressionPolicy();
+
+  /**
+   * Choose the codec and the level for the given block, and returns the
+   * sampled compression ratio.
+   */
+  double Choose(const void* data, const size_t size, CompressionCodec& codec,
+                int& level);
+
+  void ObserveCompression(const int level, const double sampled_ratio,
+                          const size_t input_size, const size_t output_size,
+                          const double seconds);
+
+  void ObserveLink(const size_t size, const double seconds);
+
+  // bytes per second
+  double link_throughput() const { return link_throughput_; }
+
+ private:
+  static constexpr size_t minimum_sample_bytes = 64 * 1024;
+  static constexpr size_t minimum_link_bytes = 1024 * 1024;
+
+  void sample(const void* data, const size_t size, double& ratio,
+              double& speed);
+
+  std::mutex mutex_;
+  ZSTD_CCtx_s* sampler_ = nullptr;
+  std::vector<char> sample_buffer_;
+
+  // estimations for each candidate level, relative to the sampled ones
+  std::vector<double> speed_scales_, ratio_scales_;
+  double link_throughput_;
+  size_t link_bytes_ = 0;
+  double link_seconds_ = 0;
+
+  // the decision for blocks that are too small to sample
+  CompressionCodec last_codec_ = CompressionCodec::kZSTD;
+  int last_level_ = 1;
+  double last_ratio_ = 1.0, last_speed_ = 0;
+};
+
+/**
+ * Compress the input in blocks, where each block is either compressed with
+ * zstd, at the level chosen by the `CompressionPolicy`, or passed through as
+ * is. Without a policy, it works as a plain `Compressor` and the output is
+ * understandable by peers that don't know adaptive compression.
+ *
+ * Usage:
+ *
+ *  auto compressor = AdaptiveCompressor(policy);
+ *  compressor.Compress(data, data_size);
+ *
+ *  CompressionCodec codec;
+ *  void *chunk;
+ *  size_t size;
+ *  while (compressor.Pull(codec, chunk, size).ok()) {
+ *      // send [EncodeChunkHeader(codec, size), chunk]
+ *      compressor.Sent(size, elapsed_seconds);
+ *  }
+ */
+class AdaptiveCompressor {
+ public:
+  static constexpr size_t default_block_size = 4 * 1024 * 1024;  // 4MB
+
+  explicit AdaptiveCompressor(
+      std::shared_ptr<CompressionPolicy> const& policy = nullptr,
+      const size_t block_size = default_block_size);
+
+  bool adaptive() const { return policy_ != nullptr; }
+
+  TransferMetrics const& metrics() const { return metrics_; }
+
+  Status Compress(const void* data, const size_t size);
+
+  Status Pull(CompressionCodec& codec, void*& data, size_t& size);
+
+  /**
+   * Record the time spent on writing a chunk to the link.
+   */
+  void Sent(const size_t size, const double seconds);
+
+ private:
+  std::shared_ptr<CompressionPolicy> policy_;
+  const size_t block_size_;
+  Compressor compressor_;
+
+  const char* input_ = nullptr;
+  size_t input_size_ = 0, input_offset_ = 0;
+
+  // the block being compressed
+  bool compressing_ = false;
+  int level_ = Compressor::default_level;
+  double sampled_ratio_ = 1.0;
+  size_t block_input_ = 0, block_output_ = 0;
+  double block_seconds_ = 0;
+
+  TransferMetrics metrics_;
+};
+
 }  // namespace vineyard
 
 #endif  // SRC_COMMON_COMPRESSION_COMPRESSOR_H_
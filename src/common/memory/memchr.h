@@ -0,0 +1,124 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef SRC_COMMON_MEMORY_MEMCHR_H_
+#define SRC_COMMON_MEMORY_MEMCHR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace vineyard {
+
+namespace memory {
+
+#if defined(__x86_64__) && defined(__SSE2__)
+
+/**
+ * @brief Find the first occurrence of `c` in `[data, data + size)`.
+ *
+ * The scanner compares 64 bytes per iteration using SSE2 and falls back to
+ * the scalar loop for the (short) head and tail, the semantic is the same
+ * with `memchr`, but it can be inlined into the hot loop of line readers.
+ */
+static inline const char* inline_memchr(const char* data, const char c,
+                                        size_t size) {
+  const char* end = data + size;
+  const __m128i pattern = _mm_set1_epi8(c);
+
+  // align to 16 bytes boundary for the aligned loads below
+  while (data < end && (reinterpret_cast<uintptr_t>(data) & 15) != 0) {
+    if (*data == c) {
+      return data;
+    }
+    ++data;
+  }
+
+  while (data + 64 <= end) {
+    const __m128i* p = reinterpret_cast<const __m128i*>(data);
+    __m128i c0 = _mm_cmpeq_epi8(_mm_load_si128(p + 0), pattern);
+    __m128i c1 = _mm_cmpeq_epi8(_mm_load_si128(p + 1), pattern);
+    __m128i c2 = _mm_cmpeq_epi8(_mm_load_si128(p + 2), pattern);
+    __m128i c3 = _mm_cmpeq_epi8(_mm_load_si128(p + 3), pattern);
+    __m128i any = _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3));
+    if (_mm_movemask_epi8(any) != 0) {
+      uint64_t mask =
+          static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c0))) |
+          static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c1)))
+              << 16 |
+          static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c2)))
+              << 32 |
+          static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(c3)))
+              << 48;
+      return data + __builtin_ctzll(mask);
+    }
+    data += 64;
+  }
+
+  while (data + 16 <= end) {
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(data)), pattern));
+    if (mask != 0) {
+      return data + __builtin_ctz(mask);
+    }
+    data += 16;
+  }
+
+  while (data < end) {
+    if (*data == c) {
+      return data;
+    }
+    ++data;
+  }
+  return nullptr;
+}
+
+#else
+
+static inline const char* inline_memchr(const char* data, const char c,
+                                        size_t size) {
+  return static_cast<const char*>(memchr(data, c, size));
+}
+
+#endif
+
+/**
+ * @brief Find the last occurrence of `c` in `[data, data + size)`.
+ *
+ * Used to locate the end of the last complete record in a chunk, where the
+ * trailing partial record is expected to be short, thus a scalar backward
+ * scan is sufficient.
+ */
+static inline const char* inline_memrchr(const char* data, const char c,
+                                         size_t size) {
+  const char* p = data + size;
+  while (p > data) {
+    --p;
+    if (*p == c) {
+      return p;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace memory
+
+}  // namespace vineyard
+
+#endif  // SRC_COMMON_MEMORY_MEMCHR_H_
@@ -0,0 +1,411 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "common/memory/memcpy.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/util/env.h"
+
+namespace vineyard {
+
+namespace memory {
+
+namespace detail {
+
+static size_t parse_cache_size(std::string const& value) {
+  // e.g., "48K", "1280K", "32M"
+  size_t size = 0, index = 0;
+  while (index < value.size() && value[index] >= '0' && value[index] <= '9') {
+    size = size * 10 + (value[index++] - '0');
+  }
+  if (index < value.size()) {
+    if (value[index] == 'K' || value[index] == 'k') {
+      size *= 1024;
+    } else if (value[index] == 'M' || value[index] == 'm') {
+      size *= 1024 * 1024;
+    }
+  }
+  return size;
+}
+
+static size_t read_cache_size(const int level, const size_t default_size) {
+#if defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+  long size =  // NOLINT(runtime/int)
+      sysconf(level == 2 ? _SC_LEVEL2_CACHE_SIZE : _SC_LEVEL3_CACHE_SIZE);
+  if (size > 0) {
+    return static_cast<size_t>(size);
+  }
+#endif
+  // fallback to sysfs, e.g., when glibc doesn't known the cpu model
+  for (int index = 0; index < 8; ++index) {
+    std::string prefix = "/sys/devices/system/cpu/cpu0/cache/index" +
+                         std::to_string(index) + "/";
+    std::ifstream level_file(prefix + "level"), size_file(prefix + "size");
+    int cache_level = 0;
+    std::string cache_size;
+    if (!(level_file >> cache_level) || !(size_file >> cache_size)) {
+      break;
+    }
+    if (cache_level == level && parse_cache_size(cache_size) > 0) {
+      return parse_cache_size(cache_size);
+    }
+  }
+  return default_size;
+}
+
+static size_t read_env_size(const char* name, const size_t default_value) {
+  std::string value = read_env(name);
+  if (value.empty()) {
+    return default_value;
+  }
+  try {
+    return std::stoull(value);
+  } catch (...) {
+    return default_value;
+  }
+}
+
+static MemcpyProfile make_memcpy_profile() {
+  MemcpyProfile profile;
+  profile.l2_cache_size = read_cache_size(2, 1024 * 1024);
+  profile.l3_cache_size = read_cache_size(3, 32 * 1024 * 1024);
+  long page_size = sysconf(_SC_PAGESIZE);  // NOLINT(runtime/int)
+  profile.page_size = page_size > 0 ? static_cast<size_t>(page_size) : 4096;
+  profile.min_chunk_size =
+      std::max<size_t>(profile.l2_cache_size, 256 * 1024);
+  profile.concurrent_threshold = read_env_size(
+      "VINEYARD_MEMCPY_THRESHOLD", 2 * profile.min_chunk_size);
+  profile.nontemporal_threshold = read_env_size(
+      "VINEYARD_MEMCPY_NONTEMPORAL_THRESHOLD", profile.l3_cache_size / 2);
+  profile.concurrency = read_env_size("VINEYARD_MEMCPY_CONCURRENCY", 0);
+  // the memory bandwidth saturates long before using all cores of large hosts
+  size_t hardware_concurrency =
+      std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  profile.max_concurrency = std::max(
+      std::min<size_t>(hardware_concurrency, 32), profile.concurrency);
+  return profile;
+}
+
+/**
+ * @brief A persistent pool of copying threads, where the calling thread
+ * takes a share of the work as well. The pool grows to the largest requested
+ * concurrency lazily.
+ */
+class MemcpyThreadPool {
+ public:
+  /**
+   * @brief Run `task(0)`, ..., `task(n - 1)`, and `task(0)` runs on the
+   * calling thread.
+   */
+  void Run(const size_t n, std::function<void(size_t)> const& task) {
+    if (n <= 1) {
+      task(0);
+      return;
+    }
+    ensureWorkers(n - 1);
+
+    size_t pending = n - 1;
+    std::mutex done_mutex;
+    std::condition_variable done;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t index = 1; index < n; ++index) {
+        tasks_.emplace_back([&, index]() {
+          task(index);
+          // notify under the lock, as the waiter destroys the states once
+          // it observes the pending count drops to zero
+          std::lock_guard<std::mutex> lock(done_mutex);
+          if (--pending == 0) {
+            done.notify_one();
+          }
+        });
+      }
+    }
+    condition_.notify_all();
+    task(0);
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done.wait(lock, [&pending]() { return pending == 0; });
+  }
+
+ private:
+  void ensureWorkers(const size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (workers_.size() < n) {
+      workers_.emplace_back([this]() { this->work(); });
+      workers_.back().detach();
+    }
+  }
+
+  void work() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this]() { return !tasks_.empty(); });
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief The self-tuning policy of the concurrency, see also Notes on
+ * [Concurrent memcpy].
+ */
+class MemcpyTuner {
+ public:
+  explicit MemcpyTuner(const size_t max_concurrency) {
+    for (size_t concurrency = 1; concurrency < max_concurrency;
+         concurrency *= 2) {
+      candidates_.emplace_back(concurrency);
+    }
+    candidates_.emplace_back(max_concurrency);
+    arms_.resize(max_size_class - min_size_class + 1,
+                 std::vector<arm_t>(candidates_.size()));
+    rounds_.resize(arms_.size(), 0);
+  }
+
+  size_t Candidates() const { return candidates_.size(); }
+
+  size_t Candidate(const size_t index) const { return candidates_[index]; }
+
+  size_t Choose(const size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& arms = arms_[sizeClass(size)];
+    // try every candidate once, starting from the largest concurrency
+    for (size_t index = arms.size(); index > 0; --index) {
+      if (arms[index - 1].samples == 0) {
+        return index - 1;
+      }
+    }
+    size_t best = 0;
+    for (size_t index = 1; index < arms.size(); ++index) {
+      if (arms[index].bandwidth > arms[best].bandwidth) {
+        best = index;
+      }
+    }
+    // occasionally explore the neighbours, as the bandwidth varies with the
+    // load of the host
+    size_t round = rounds_[sizeClass(size)]++;
+    if (round % explore_interval == explore_interval - 1) {
+      if ((round / explore_interval) % 2 == 0) {
+        return best + 1 < arms.size() ? best + 1 : best;
+      } else {
+        return best > 0 ? best - 1 : best;
+      }
+    }
+    return best;
+  }
+
+  void Observe(const size_t size, const size_t index, const double seconds) {
+    if (seconds <= 0) {
+      return;
+    }
+    double bandwidth = static_cast<double>(size) / seconds;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& arm = arms_[sizeClass(size)][index];
+    if (arm.samples == 0) {
+      arm.bandwidth = bandwidth;
+    } else {
+      arm.bandwidth = (1 - smoothing) * arm.bandwidth + smoothing * bandwidth;
+    }
+    arm.samples += 1;
+  }
+
+ private:
+  static constexpr size_t min_size_class = 16;  // 64KB
+  static constexpr size_t max_size_class = 40;  // 1TB
+  static constexpr size_t explore_interval = 16;
+  static constexpr double smoothing = 0.2;
+
+  struct arm_t {
+    double bandwidth = 0;
+    size_t samples = 0;
+  };
+
+  size_t sizeClass(size_t size) const {
+    size_t size_class = 0;
+    while (size >>= 1) {
+      size_class += 1;
+    }
+    return std::min(std::max(size_class, min_size_class), max_size_class) -
+           min_size_class;
+  }
+
+  std::mutex mutex_;
+  std::vector<size_t> candidates_;
+  std::vector<std::vector<arm_t>> arms_;
+  std::vector<size_t> rounds_;
+};
+
+constexpr size_t MemcpyTuner::min_size_class;
+constexpr size_t MemcpyTuner::max_size_class;
+constexpr size_t MemcpyTuner::explore_interval;
+constexpr double MemcpyTuner::smoothing;
+
+struct MemcpyContext {
+  MemcpyContext() : pid(getpid()) {}
+
+  const pid_t pid;
+  MemcpyThreadPool pool;
+  MemcpyTuner tuner{memcpy_profile().max_concurrency};
+};
+
+static MemcpyContext& memcpy_context() {
+  // the context is never destroyed as the worker threads are detached, and
+  // is recreated in forked children, as the threads are not inherited.
+  static std::atomic<MemcpyContext*> context{nullptr};
+  MemcpyContext* current = context.load();
+  if (current == nullptr || current->pid != getpid()) {
+    static std::mutex mutex;
+    std::lock_guard<std::mutex> lock(mutex);
+    current = context.load();
+    if (current == nullptr || current->pid != getpid()) {
+      current = new MemcpyContext();
+      context.store(current);
+    }
+  }
+  return *current;
+}
+
+static void copy_in_parallel(void* __restrict dst_, const void* __restrict src_,
+                             const size_t size, size_t concurrency,
+                             const bool nontemporal) {
+  auto const& profile = memcpy_profile();
+  concurrency = std::max<size_t>(
+      std::min(concurrency, size / profile.min_chunk_size), 1);
+
+  uint8_t* dst = static_cast<uint8_t*>(dst_);
+  const uint8_t* src = static_cast<const uint8_t*>(src_);
+  uintptr_t base = reinterpret_cast<uintptr_t>(dst);
+  size_t page_size = profile.page_size;
+  size_t share = (size + concurrency - 1) / concurrency;
+  // align the boundaries of shares to pages of the destination
+  auto boundary = [&](const size_t index) -> size_t {
+    if (index == 0) {
+      return 0;
+    }
+    if (index >= concurrency) {
+      return size;
+    }
+    uintptr_t aligned = (base + index * share + page_size - 1) &
+                        ~static_cast<uintptr_t>(page_size - 1);
+    return std::min<size_t>(aligned - base, size);
+  };
+  memcpy_context().pool.Run(concurrency, [&](const size_t index) {
+    size_t begin = boundary(index), end = boundary(index + 1);
+    if (end <= begin) {
+      return;
+    }
+    if (nontemporal) {
+      nontemporal_memcpy(dst + begin, src + begin, end - begin);
+    } else {
+      inline_memcpy(dst + begin, src + begin, end - begin);
+    }
+  });
+}
+
+}  // namespace detail
+
+MemcpyProfile const& memcpy_profile() {
+  static MemcpyProfile profile = detail::make_memcpy_profile();
+  return profile;
+}
+
+void* concurrent_memcpy(void* __restrict dst_, const void* __restrict src_,
+                        size_t size, const size_t concurrency) {
+  auto const& profile = memcpy_profile();
+  if ((dst_ >= src_ && dst_ <= static_cast<const uint8_t*>(src_) + size) ||
+      (src_ >= dst_ && src_ <= static_cast<uint8_t*>(dst_) + size)) {
+    return inline_memcpy(dst_, src_, size);
+  }
+  bool nontemporal = size >= profile.nontemporal_threshold;
+  if (size < profile.concurrent_threshold) {
+    return nontemporal ? nontemporal_memcpy(dst_, src_, size)
+                       : inline_memcpy(dst_, src_, size);
+  }
+  if (concurrency != 0 || profile.concurrency != 0) {
+    detail::copy_in_parallel(
+        dst_, src_, size, concurrency != 0 ? concurrency : profile.concurrency,
+        nontemporal);
+    return dst_;
+  }
+
+  auto& tuner = detail::memcpy_context().tuner;
+  size_t candidate = tuner.Choose(size);
+  auto start = std::chrono::steady_clock::now();
+  detail::copy_in_parallel(dst_, src_, size, tuner.Candidate(candidate),
+                           nontemporal);
+  tuner.Observe(size, candidate,
+                std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+  return dst_;
+}
+
+void calibrate_memcpy(const size_t max_size) {
+  auto const& profile = memcpy_profile();
+  if (max_size < profile.concurrent_threshold) {
+    return;
+  }
+  std::unique_ptr<uint8_t[]> src(new uint8_t[max_size]);
+  std::unique_ptr<uint8_t[]> dst(new uint8_t[max_size]);
+  // fault in the pages before measuring
+  memset(src.get(), 1, max_size);
+  memset(dst.get(), 0, max_size);
+
+  auto& tuner = detail::memcpy_context().tuner;
+  for (size_t size = profile.concurrent_threshold; size <= max_size;
+       size *= 2) {
+    for (size_t candidate = 0; candidate < tuner.Candidates(); ++candidate) {
+      for (int round = 0; round < 3; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        detail::copy_in_parallel(dst.get(), src.get(), size,
+                                 tuner.Candidate(candidate),
+                                 size >= profile.nontemporal_threshold);
+        tuner.Observe(size, candidate,
+                      std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start)
+                          .count());
+      }
+    }
+  }
+}
+
+}  // namespace memory
+
+}  // namespace vineyard
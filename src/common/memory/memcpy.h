@@ -254,40 +254,141 @@ static inline void * inline_memcpy(void * __restrict dst_, const void * __restri
 
 // clang-format on
 
-// use the same default concurrency as apache-arrow.
-static constexpr size_t default_memcpy_concurrency = 6;
-
-static inline void* concurrent_memcpy(void* __restrict dst_,
-                                      const void* __restrict src_, size_t size,
-                                      const size_t concurrency = default_memcpy_concurrency) {
-  static constexpr size_t concurrent_memcpy_threshold = 1024 * 1024 * 4;
-  if (size < concurrent_memcpy_threshold) {
-    inline_memcpy(dst_, src_, size);
-  } else if ((dst_ >= src_ &&
-              dst_ <= static_cast<const uint8_t*>(src_) + size) ||
-             (src_ >= dst_ && src_ <= static_cast<uint8_t*>(dst_) + size)) {
-    inline_memcpy(dst_, src_, size);
-  } else {
-    static constexpr size_t alignment = 1024 * 1024 * 4;
-    size_t chunk_size = (size / concurrency + alignment - 1) & ~(alignment - 1);
-    std::vector<std::thread> threads;
-    for (size_t i = 0; i < concurrency; ++i) {
-      if (size <= i * chunk_size) {
-        break;
-      }
-      size_t chunk = std::min(chunk_size, size - i * chunk_size);
-      threads.emplace_back([=]() {
-        inline_memcpy(static_cast<uint8_t*>(dst_) + i * chunk_size,
-                      static_cast<const uint8_t*>(src_) + i * chunk_size,
-                      chunk);
-      });
-    }
-    for (auto &thread: threads) {
-      thread.join();
-    }
+#if defined(__x86_64__) && !defined(__VINEYARD_NO_RDTSC) && !defined(__VPP)
+/**
+ * @brief Like `inline_memcpy`, but uses non-temporal (cache bypassing) stores
+ * for the bulk of the copy, which avoids evicting the working set from the
+ * cache when copying buffers larger than the (shared) last level cache.
+ */
+static inline void* nontemporal_memcpy(void* __restrict dst_,
+                                       const void* __restrict src_,
+                                       size_t size) {
+  char* __restrict dst = reinterpret_cast<char* __restrict>(dst_);
+  const char* __restrict src = reinterpret_cast<const char* __restrict>(src_);
+  if (size < 256) {
+    return inline_memcpy(dst_, src_, size);
+  }
+
+  // align the destination to 16 bytes, as required by streaming stores
+  size_t padding = (16 - (reinterpret_cast<size_t>(dst) & 15)) & 15;
+  if (padding > 0) {
+    inline_memcpy(dst, src, padding);
+    dst += padding;
+    src += padding;
+    size -= padding;
+  }
+
+  __m128i c0, c1, c2, c3, c4, c5, c6, c7;
+  while (size >= 128) {
+    c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 0);
+    c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 1);
+    c2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 2);
+    c3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 3);
+    c4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 4);
+    c5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 5);
+    c6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 6);
+    c7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + 7);
+    src += 128;
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 0), c0);
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 1), c1);
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 2), c2);
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 3), c3);
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 4), c4);
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 5), c5);
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 6), c6);
+    _mm_stream_si128((reinterpret_cast<__m128i*>(dst) + 7), c7);
+    dst += 128;
+    size -= 128;
   }
+  // make the streaming stores visible before returning
+  _mm_sfence();
+  inline_memcpy(dst, src, size);
   return dst_;
 }
+#else
+static inline void* nontemporal_memcpy(void* __restrict dst_,
+                                       const void* __restrict src_,
+                                       size_t size) {
+  return memcpy(dst_, src_, size);
+}
+#endif
+
+/**
+ * @brief The concurrency `0` means the concurrency is chosen by the
+ * self-tuning policy, see also Notes on [Concurrent memcpy].
+ */
+static constexpr size_t default_memcpy_concurrency = 0;
+
+/**
+ * @brief The parameters of `concurrent_memcpy`, derived from the cache
+ * hierarchy of the host, and could be overridden by the environment
+ * variables:
+ *
+ *  - VINEYARD_MEMCPY_CONCURRENCY: always use the given concurrency for
+ *    buffers larger than the threshold.
+ *  - VINEYARD_MEMCPY_THRESHOLD: buffers smaller than that are always copied
+ *    by the calling thread.
+ *  - VINEYARD_MEMCPY_NONTEMPORAL_THRESHOLD: buffers larger than that are
+ *    copied using non-temporal stores.
+ */
+struct MemcpyProfile {
+  size_t l2_cache_size;
+  size_t l3_cache_size;
+  size_t page_size;
+  // buffers smaller than the threshold won't be copied concurrently
+  size_t concurrent_threshold;
+  // buffers larger than the threshold will be copied with non-temporal stores
+  size_t nontemporal_threshold;
+  // the minimal size of the share of a copying thread
+  size_t min_chunk_size;
+  // the size of the copying thread pool
+  size_t max_concurrency;
+  // fixed concurrency, 0 means self-tuned
+  size_t concurrency;
+};
+
+MemcpyProfile const& memcpy_profile();
+
+/**
+ * @brief Copy the buffer with multiple threads from a persistent thread pool,
+ * where the calling thread copies a share as well.
+ *
+ * If `concurrency` is 0, the concurrency is chosen by the self-tuning policy
+ * for the size class of the buffer.
+ */
+void* concurrent_memcpy(void* __restrict dst_, const void* __restrict src_,
+                        size_t size,
+                        const size_t concurrency = default_memcpy_concurrency);
+
+/**
+ * @brief Measure the bandwidth of copying buffers with different sizes and
+ * concurrency upfront, rather than exploring during `concurrent_memcpy`.
+ *
+ * `max_size` bounds the size of the scratch buffers.
+ */
+void calibrate_memcpy(const size_t max_size = 256 * 1024 * 1024);
+
+/**
+ * Notes on [Concurrent memcpy]
+ *
+ * - The copying threads are a persistent pool that is started lazily, and
+ *   the calling thread always copies the first share by itself.
+ *
+ * - The buffer is split into contiguous shares whose boundaries are aligned
+ *   to pages of the destination, thus each page is only touched by one
+ *   thread (which places the newly faulted pages on the node of that thread
+ *   on NUMA hosts), and each share is at least as large as the L2 cache.
+ *
+ * - Buffers larger than half of the L3 cache are copied with non-temporal
+ *   stores, as the destination won't fit in the cache anyway.
+ *
+ * - The self-tuning policy keeps the moving average of the bandwidth of each
+ *   candidate concurrency (1, 2, 4, ..., and the pool size) for each power of
+ *   two size class, tries every candidate once, and then sticks to the best
+ *   one while occasionally exploring the neighbours of the best. Thus both
+ *   the concurrency and the effective threshold (the size classes where 1 is
+ *   the best) are calibrated at runtime.
+ */
 
 }  // namespace memory
 
@@ -15,10 +15,37 @@ limitations under the License.
 
 #include "common/memory/payload.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace vineyard {
 
+std::string ContentDigestToString(ContentDigest const& digest) {
+  static const char hex_chars[] = "0123456789abcdef";
+  std::string value(digest.size() * 2, '\0');
+  for (size_t i = 0; i < digest.size(); ++i) {
+    value[i * 2] = hex_chars[digest[i] >> 4];
+    value[i * 2 + 1] = hex_chars[digest[i] & 0x0f];
+  }
+  return value;
+}
+
+bool ContentDigestFromString(std::string const& value, ContentDigest& digest) {
+  // digests of other lengths come from peers with another digest algorithm
+  if (value.size() != digest.size() * 2 ||
+      value.find_first_not_of("0123456789abcdef") != std::string::npos) {
+    return false;
+  }
+  for (size_t i = 0; i < digest.size(); ++i) {
+    digest[i] = static_cast<uint8_t>(std::stoul(value.substr(i * 2, 2),
+                                                nullptr, 16));
+  }
+  return true;
+}
+
 Payload::Payload()
     : object_id(EmptyBlobID()),
       store_fd(-1),
@@ -82,6 +109,7 @@ Payload::Payload(const Payload& payload) {
   is_owner = payload.is_owner;
   is_spilled = payload.is_spilled;
   is_gpu = payload.is_gpu;
+  std::atomic_store(&content_digest, payload.CachedDigest());
   pinned.store(payload.pinned.load());
 }
 
@@ -98,6 +126,7 @@ Payload& Payload::operator=(const Payload& payload) {
   is_owner = payload.is_owner;
   is_spilled = payload.is_spilled;
   is_gpu = payload.is_gpu;
+  std::atomic_store(&content_digest, payload.CachedDigest());
   pinned.store(payload.pinned.load());
   return *this;
 }
@@ -107,6 +136,37 @@ std::shared_ptr<Payload> Payload::MakeEmpty() {
   return payload;
 }
 
+Status Payload::Digest(ContentDigest& digest) {
+  auto cached = CachedDigest();
+  if (cached) {
+    digest = *cached;
+    return Status::OK();
+  }
+  if (!is_sealed) {
+    return Status::ObjectNotSealed(
+        "The digest is only available for sealed blobs: " +
+        ObjectIDToString(object_id));
+  }
+  if (is_gpu || is_spilled || (pointer == nullptr && data_size > 0)) {
+    return Status::Invalid("The content of blob is not in memory: " +
+                           ObjectIDToString(object_id));
+  }
+  digest = sha256(pointer, data_size);
+  SetDigest(digest);
+  return Status::OK();
+}
+
+void Payload::SetDigest(ContentDigest const& digest) {
+  // concurrent callers always store the same digest of the sealed content
+  std::atomic_store(&content_digest,
+                    std::shared_ptr<const ContentDigest>(
+                        std::make_shared<ContentDigest>(digest)));
+}
+
+std::shared_ptr<const ContentDigest> Payload::CachedDigest() const {
+  return std::atomic_load(&content_digest);
+}
+
 bool Payload::operator==(const Payload& other) const {
   return ((object_id == other.object_id) && (store_fd == other.store_fd) &&
           (data_offset == other.data_offset) && (data_size == other.data_size));
@@ -189,4 +249,39 @@ PlasmaPayload PlasmaPayload::FromJSON1(const json& tree) {
   return plasma_payload;
 }
 
+std::vector<PayloadChunk> StripePayloadChunks(
+    std::vector<int64_t> const& sizes, const size_t stripe,
+    const size_t stripes, const size_t chunk_size) {
+  std::vector<PayloadChunk> chunks;
+  size_t chunk_index = 0;
+  for (size_t index = 0; index < sizes.size(); ++index) {
+    size_t size = static_cast<size_t>(sizes[index]);
+    size_t step = chunk_size == 0 ? size : chunk_size;
+    for (size_t offset = 0; offset < size; offset += step) {
+      if (chunk_index++ % stripes == stripe) {
+        chunks.emplace_back(
+            PayloadChunk{index, offset, std::min(step, size - offset)});
+      }
+    }
+  }
+  return chunks;
+}
+
+std::vector<std::shared_ptr<Payload>> SlicePayloads(
+    std::vector<std::shared_ptr<Payload>> const& objects,
+    std::vector<PayloadChunk> const& chunks) {
+  std::vector<std::shared_ptr<Payload>> slices;
+  for (auto const& chunk : chunks) {
+    auto slice = std::make_shared<Payload>(*objects[chunk.index]);
+    slice->data_offset += chunk.offset;
+    slice->data_size = chunk.size;
+    slice->pointer += chunk.offset;
+    slice->RemoveOwner();
+    std::atomic_store(&slice->content_digest,
+                      std::shared_ptr<const ContentDigest>());
+    slices.emplace_back(slice);
+  }
+  return slices;
+}
+
 }  // namespace vineyard
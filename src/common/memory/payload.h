@@ -19,15 +19,28 @@ limitations under the License.
 #include <atomic>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "common/util/json.h"
 #include "common/util/likely.h"
+#include "common/util/sha256.h"
+#include "common/util/status.h"
 #include "common/util/uuid.h"
 
 namespace vineyard {
 
 struct PlasmaPayload;
 
+/**
+ * @brief The SHA-256 digest of the content of a blob, see `Payload::Digest`.
+ */
+using ContentDigest = sha256_digest_t;
+
+std::string ContentDigestToString(ContentDigest const& digest);
+
+bool ContentDigestFromString(std::string const& value, ContentDigest& digest);
+
 class BulkStore;
 
 struct Payload {
@@ -53,6 +66,10 @@ struct Payload {
   };
   Kind kind = Kind::kMalloc;
 
+  // the cached content digest, see `Digest()`, accessed atomically as it
+  // may be set and read by different connections
+  std::shared_ptr<const ContentDigest> content_digest;
+
   Payload();
 
   Payload(ObjectID object_id, int64_t size, uint8_t* ptr, int fd, int64_t msize,
@@ -85,6 +102,24 @@ struct Payload {
 
   inline bool IsGPU() { return is_gpu; }
 
+  /**
+   * @brief Get the digest of the blob content, which is computed at the first
+   * call and cached. Only sealed blobs in (host) memory have digests, as the
+   * content of sealed blobs won't change anymore.
+   */
+  Status Digest(ContentDigest& digest);
+
+  /**
+   * @brief Set the digest when it is known in advance, e.g., the blob is
+   * copied from another instance.
+   */
+  void SetDigest(ContentDigest const& digest);
+
+  /**
+   * @brief Return the cached digest, or nullptr if it hasn't been computed.
+   */
+  std::shared_ptr<const ContentDigest> CachedDigest() const;
+
   /**
    * @brief Pin the payload, return true is the payload is already pinned.
    */
@@ -183,6 +218,39 @@ struct PlasmaPayload : public Payload {
   static PlasmaPayload FromJSON1(const json& tree);
 };
 
+/**
+ * @brief A chunk of payloads to be transferred by one of the striped
+ * connections, i.e., `size` bytes starting from `offset` of the `index`-th
+ * payload.
+ *
+ * See also Notes on [Transferring remote blobs] in "server/util/remote.h".
+ */
+struct PayloadChunk {
+  size_t index;
+  size_t offset;
+  size_t size;
+};
+
+/**
+ * @brief Split payloads of the given sizes into chunks of `chunk_size` bytes,
+ * and assign the chunks to `stripes` connections in a round-robin manner.
+ * Returns the chunks that belong to the `stripe`-th connection.
+ *
+ * Both the sender and the receiver derive the chunks from the same list of
+ * payloads, thus the chunk boundaries are never transferred.
+ */
+std::vector<PayloadChunk> StripePayloadChunks(
+    std::vector<int64_t> const& sizes, const size_t stripe,
+    const size_t stripes, const size_t chunk_size);
+
+/**
+ * @brief Make payloads that view the given chunks of `objects`, the views
+ * share the memory of the original payloads and won't be freed by their own.
+ */
+std::vector<std::shared_ptr<Payload>> SlicePayloads(
+    std::vector<std::shared_ptr<Payload>> const& objects,
+    std::vector<PayloadChunk> const& chunks);
+
 template <typename T>
 struct ID_traits {};
 
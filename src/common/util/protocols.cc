@@ -76,6 +76,14 @@ const std::string command_t::CREATE_REMOTE_BUFFER_REQUEST =
     "create_remote_buffer_request";
 const std::string command_t::GET_REMOTE_BUFFERS_REQUEST =
     "get_remote_buffers_request";
+const std::string command_t::PUT_REMOTE_BUFFER_CHUNKS_REQUEST =
+    "put_remote_buffer_chunks_request";
+const std::string command_t::GET_REMOTE_BUFFER_CHUNKS_REQUEST =
+    "get_remote_buffer_chunks_request";
+const std::string command_t::GET_BUFFER_DIGESTS_REQUEST =
+    "get_buffer_digests_request";
+const std::string command_t::GET_BUFFER_DIGESTS_REPLY =
+    "get_buffer_digests_reply";
 
 const std::string command_t::INCREASE_REFERENCE_COUNT_REQUEST =
     "increase_reference_count_request";
@@ -186,6 +194,8 @@ const std::string command_t::IS_SPILLED_REQUEST = "is_spilled_request";
 const std::string command_t::IS_SPILLED_REPLY = "is_spilled_reply";
 const std::string command_t::IS_IN_USE_REQUEST = "is_in_use_request";
 const std::string command_t::IS_IN_USE_REPLY = "is_in_use_reply";
+const std::string command_t::IS_COMPRESSED_REQUEST = "is_compressed_request";
+const std::string command_t::IS_COMPRESSED_REPLY = "is_compressed_reply";
 
 // Meta APIs
 const std::string command_t::CLUSTER_META_REQUEST = "cluster_meta";
@@ -222,6 +232,8 @@ void WriteRegisterRequest(std::string& msg, StoreType const& bulk_store_type,
   root["session_id"] = session_id;
   root["username"] = username;
   root["password"] = password;
+  // the tagged chunks of adaptive compression can always be decoded
+  root["support_adaptive_compression"] = true;
 
   encode_msg(root, msg);
 }
@@ -229,6 +241,15 @@ void WriteRegisterRequest(std::string& msg, StoreType const& bulk_store_type,
 Status ReadRegisterRequest(const json& root, std::string& version,
                            StoreType& store_type, SessionID& session_id,
                            std::string& username, std::string& password) {
+  bool support_adaptive_compression = false;
+  return ReadRegisterRequest(root, version, store_type, session_id, username,
+                             password, support_adaptive_compression);
+}
+
+Status ReadRegisterRequest(const json& root, std::string& version,
+                           StoreType& store_type, SessionID& session_id,
+                           std::string& username, std::string& password,
+                           bool& support_adaptive_compression) {
   CHECK_IPC_ERROR(root, command_t::REGISTER_REQUEST);
 
   // When the "version" field is missing from the client, we treat it
@@ -256,6 +277,8 @@ Status ReadRegisterRequest(const json& root, std::string& version,
   username = root.value("username", /* default */ "");
   password = root.value("password", /* default */ "");
 
+  support_adaptive_compression =
+      root.value("support_adaptive_compression", false);
   return Status::OK();
 }
 
@@ -263,7 +286,9 @@ void WriteRegisterReply(const std::string& ipc_socket,
                         const std::string& rpc_endpoint,
                         const InstanceID instance_id,
                         const SessionID session_id, const bool store_match,
-                        const bool support_rpc_compression, std::string& msg) {
+                        const bool support_rpc_compression,
+                        const bool support_adaptive_compression,
+                        std::string& msg) {
   json root;
   root["type"] = command_t::REGISTER_REPLY;
   root["ipc_socket"] = ipc_socket;
@@ -273,6 +298,7 @@ void WriteRegisterReply(const std::string& ipc_socket,
   root["version"] = vineyard_version();
   root["store_match"] = store_match;
   root["support_rpc_compression"] = support_rpc_compression;
+  root["support_adaptive_compression"] = support_adaptive_compression;
   encode_msg(root, msg);
 }
 
@@ -280,6 +306,18 @@ Status ReadRegisterReply(const json& root, std::string& ipc_socket,
                          std::string& rpc_endpoint, InstanceID& instance_id,
                          SessionID& session_id, std::string& version,
                          bool& store_match, bool& support_rpc_compression) {
+  bool support_adaptive_compression = false;
+  return ReadRegisterReply(root, ipc_socket, rpc_endpoint, instance_id,
+                           session_id, version, store_match,
+                           support_rpc_compression,
+                           support_adaptive_compression);
+}
+
+Status ReadRegisterReply(const json& root, std::string& ipc_socket,
+                         std::string& rpc_endpoint, InstanceID& instance_id,
+                         SessionID& session_id, std::string& version,
+                         bool& store_match, bool& support_rpc_compression,
+                         bool& support_adaptive_compression) {
   CHECK_IPC_ERROR(root, command_t::REGISTER_REPLY);
   ipc_socket = root["ipc_socket"].get_ref<std::string const&>();
   rpc_endpoint = root["rpc_endpoint"].get_ref<std::string const&>();
@@ -292,6 +330,8 @@ Status ReadRegisterReply(const json& root, std::string& ipc_socket,
 
   store_match = root.value("store_match", true);
   support_rpc_compression = root.value("support_rpc_compression", false);
+  support_adaptive_compression =
+      root.value("support_adaptive_compression", false);
   return Status::OK();
 }
 
@@ -728,6 +768,126 @@ Status ReadGetRemoteBuffersRequest(const json& root, std::vector<ObjectID>& ids,
   return Status::OK();
 }
 
+void WritePutRemoteBufferChunksRequest(const ObjectID id, const size_t size,
+                                       const size_t stripe,
+                                       const size_t stripes,
+                                       const size_t chunk_size,
+                                       const bool compress, std::string& msg) {
+  json root;
+  root["type"] = command_t::PUT_REMOTE_BUFFER_CHUNKS_REQUEST;
+  root["id"] = id;
+  root["size"] = size;
+  root["stripe"] = stripe;
+  root["stripes"] = stripes;
+  root["chunk_size"] = chunk_size;
+  root["compress"] = compress;
+
+  encode_msg(root, msg);
+}
+
+Status ReadPutRemoteBufferChunksRequest(const json& root, ObjectID& id,
+                                        size_t& size, size_t& stripe,
+                                        size_t& stripes, size_t& chunk_size,
+                                        bool& compress) {
+  CHECK_IPC_ERROR(root, command_t::PUT_REMOTE_BUFFER_CHUNKS_REQUEST);
+  id = root["id"].get<ObjectID>();
+  size = root["size"].get<size_t>();
+  stripe = root["stripe"].get<size_t>();
+  stripes = root["stripes"].get<size_t>();
+  chunk_size = root["chunk_size"].get<size_t>();
+  compress = root.value("compress", false);
+  RETURN_ON_ASSERT(stripes > 0 && stripe < stripes,
+                   "Invalid stripe index: " + std::to_string(stripe) + " of " +
+                       std::to_string(stripes));
+  return Status::OK();
+}
+
+void WriteGetBufferDigestsRequest(const std::vector<ObjectID>& ids,
+                                  std::string& msg) {
+  json root;
+  root["type"] = command_t::GET_BUFFER_DIGESTS_REQUEST;
+  root["ids"] = ids;
+
+  encode_msg(root, msg);
+}
+
+Status ReadGetBufferDigestsRequest(const json& root,
+                                   std::vector<ObjectID>& ids) {
+  CHECK_IPC_ERROR(root, command_t::GET_BUFFER_DIGESTS_REQUEST);
+  ids = root["ids"].get<std::vector<ObjectID>>();
+  return Status::OK();
+}
+
+void WriteGetBufferDigestsReply(
+    const std::vector<std::shared_ptr<Payload>>& objects, std::string& msg) {
+  json root;
+  root["type"] = command_t::GET_BUFFER_DIGESTS_REPLY;
+  json digests = json::array();
+  for (auto const& object : objects) {
+    // blobs without digests (e.g., spilled) are always transferred
+    ContentDigest digest;
+    if (object->data_size > 0 && object->Digest(digest).ok()) {
+      digests.push_back(json{{"id", object->object_id},
+                             {"size", object->data_size},
+                             {"digest", ContentDigestToString(digest)}});
+    }
+  }
+  root["digests"] = digests;
+
+  encode_msg(root, msg);
+}
+
+Status ReadGetBufferDigestsReply(
+    const json& root,
+    std::map<ObjectID, std::pair<int64_t, ContentDigest>>& digests) {
+  CHECK_IPC_ERROR(root, command_t::GET_BUFFER_DIGESTS_REPLY);
+  for (auto const& item : root["digests"]) {
+    ContentDigest digest;
+    if (ContentDigestFromString(
+            item["digest"].get_ref<std::string const&>(), digest)) {
+      digests.emplace(item["id"].get<ObjectID>(),
+                      std::make_pair(item["size"].get<int64_t>(), digest));
+    }
+  }
+  return Status::OK();
+}
+
+void WriteGetRemoteBufferChunksRequest(const std::vector<ObjectID>& ids,
+                                       const size_t stripe,
+                                       const size_t stripes,
+                                       const size_t chunk_size,
+                                       const bool unsafe, const bool compress,
+                                       std::string& msg) {
+  json root;
+  root["type"] = command_t::GET_REMOTE_BUFFER_CHUNKS_REQUEST;
+  root["ids"] = ids;
+  root["stripe"] = stripe;
+  root["stripes"] = stripes;
+  root["chunk_size"] = chunk_size;
+  root["unsafe"] = unsafe;
+  root["compress"] = compress;
+
+  encode_msg(root, msg);
+}
+
+Status ReadGetRemoteBufferChunksRequest(const json& root,
+                                        std::vector<ObjectID>& ids,
+                                        size_t& stripe, size_t& stripes,
+                                        size_t& chunk_size, bool& unsafe,
+                                        bool& compress) {
+  CHECK_IPC_ERROR(root, command_t::GET_REMOTE_BUFFER_CHUNKS_REQUEST);
+  ids = root["ids"].get<std::vector<ObjectID>>();
+  stripe = root["stripe"].get<size_t>();
+  stripes = root["stripes"].get<size_t>();
+  chunk_size = root["chunk_size"].get<size_t>();
+  unsafe = root.value("unsafe", false);
+  compress = root.value("compress", false);
+  RETURN_ON_ASSERT(stripes > 0 && stripe < stripes,
+                   "Invalid stripe index: " + std::to_string(stripe) + " of " +
+                       std::to_string(stripes));
+  return Status::OK();
+}
+
 void WriteIncreaseReferenceCountRequest(const std::vector<ObjectID>& ids,
                                         std::string& msg) {
   json root;
@@ -1548,11 +1708,25 @@ void WritePutNameRequest(const ObjectID object_id, const std::string& name,
   encode_msg(root, msg);
 }
 
+void WritePutNameRequest(const ObjectID object_id, const std::string& name,
+                         const ObjectID expected, std::string& msg) {
+  json root;
+  root["type"] = command_t::PUT_NAME_REQUEST;
+  root["object_id"] = object_id;
+  root["name"] = name;
+  root["expected"] = expected;
+
+  encode_msg(root, msg);
+}
+
 Status ReadPutNameRequest(const json& root, ObjectID& object_id,
-                          std::string& name) {
+                          std::string& name, bool& compare,
+                          ObjectID& expected) {
   CHECK_IPC_ERROR(root, command_t::PUT_NAME_REQUEST);
   object_id = root["object_id"].get<ObjectID>();
   name = root["name"].get_ref<std::string const&>();
+  compare = root.contains("expected");
+  expected = root.value("expected", InvalidObjectID());
   return Status::OK();
 }
 
@@ -1718,14 +1892,19 @@ Status ReadFinalizeArenaRequest(const json& root, int& fd,
   return Status::OK();
 }
 
-void WriteFinalizeArenaReply(std::string& msg) {
+void WriteFinalizeArenaReply(std::vector<ObjectID> const& ids,
+                             std::string& msg) {
   json root;
   root["type"] = command_t::FINALIZE_ARENA_REPLY;
+  root["ids"] = ids;
   encode_msg(root, msg);
 }
 
-Status ReadFinalizeArenaReply(const json& root) {
+Status ReadFinalizeArenaReply(const json& root, std::vector<ObjectID>& ids) {
   CHECK_IPC_ERROR(root, command_t::FINALIZE_ARENA_REPLY);
+  if (root.contains("ids")) {
+    root["ids"].get_to(ids);
+  }
   return Status::OK();
 }
 
@@ -1967,6 +2146,32 @@ Status ReadIsInUseReply(json const& root, bool& is_in_use) {
   return Status::OK();
 }
 
+void WriteIsCompressedRequest(const ObjectID& id, std::string& msg) {
+  json root;
+  root["type"] = command_t::IS_COMPRESSED_REQUEST;
+  root["id"] = id;
+  encode_msg(root, msg);
+}
+
+Status ReadIsCompressedRequest(json const& root, ObjectID& id) {
+  CHECK_IPC_ERROR(root, command_t::IS_COMPRESSED_REQUEST);
+  id = root["id"].get<ObjectID>();
+  return Status::OK();
+}
+
+void WriteIsCompressedReply(const bool is_compressed, std::string& msg) {
+  json root;
+  root["type"] = command_t::IS_COMPRESSED_REPLY;
+  root["is_compressed"] = is_compressed;
+  encode_msg(root, msg);
+}
+
+Status ReadIsCompressedReply(json const& root, bool& is_compressed) {
+  CHECK_IPC_ERROR(root, command_t::IS_COMPRESSED_REPLY);
+  is_compressed = root["is_compressed"].get<bool>();
+  return Status::OK();
+}
+
 void WriteClusterMetaRequest(std::string& msg) {
   json root;
   root["type"] = command_t::CLUSTER_META_REQUEST;
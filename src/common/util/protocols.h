@@ -22,6 +22,7 @@ limitations under the License.
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "common/memory/payload.h"
@@ -61,6 +62,10 @@ struct command_t {
 
   static const std::string CREATE_REMOTE_BUFFER_REQUEST;
   static const std::string GET_REMOTE_BUFFERS_REQUEST;
+  static const std::string PUT_REMOTE_BUFFER_CHUNKS_REQUEST;
+  static const std::string GET_REMOTE_BUFFER_CHUNKS_REQUEST;
+  static const std::string GET_BUFFER_DIGESTS_REQUEST;
+  static const std::string GET_BUFFER_DIGESTS_REPLY;
 
   static const std::string INCREASE_REFERENCE_COUNT_REQUEST;
   static const std::string INCREASE_REFERENCE_COUNT_REPLY;
@@ -154,6 +159,8 @@ struct command_t {
   static const std::string IS_SPILLED_REPLY;
   static const std::string IS_IN_USE_REQUEST;
   static const std::string IS_IN_USE_REPLY;
+  static const std::string IS_COMPRESSED_REQUEST;
+  static const std::string IS_COMPRESSED_REPLY;
 
   // Meta APIs
   static const std::string CLUSTER_META_REQUEST;
@@ -188,17 +195,30 @@ Status ReadRegisterRequest(const json& msg, std::string& version,
                            StoreType& bulk_store_type, SessionID& session_id,
                            std::string& username, std::string& password);
 
+Status ReadRegisterRequest(const json& msg, std::string& version,
+                           StoreType& bulk_store_type, SessionID& session_id,
+                           std::string& username, std::string& password,
+                           bool& support_adaptive_compression);
+
 void WriteRegisterReply(const std::string& ipc_socket,
                         const std::string& rpc_endpoint,
                         const InstanceID instance_id,
                         const SessionID session_id, const bool store_match,
-                        const bool support_rpc_compression, std::string& msg);
+                        const bool support_rpc_compression,
+                        const bool support_adaptive_compression,
+                        std::string& msg);
 
 Status ReadRegisterReply(const json& msg, std::string& ipc_socket,
                          std::string& rpc_endpoint, InstanceID& instance_id,
                          SessionID& sessionid, std::string& version,
                          bool& store_match, bool& support_rpc_compression);
 
+Status ReadRegisterReply(const json& msg, std::string& ipc_socket,
+                         std::string& rpc_endpoint, InstanceID& instance_id,
+                         SessionID& sessionid, std::string& version,
+                         bool& store_match, bool& support_rpc_compression,
+                         bool& support_adaptive_compression);
+
 void WriteExitRequest(std::string& msg);
 
 void WriteCreateBufferRequest(const size_t size, std::string& msg);
@@ -330,6 +350,43 @@ void WriteGetRemoteBuffersRequest(const std::unordered_set<ObjectID>& ids,
 Status ReadGetRemoteBuffersRequest(const json& root, std::vector<ObjectID>& ids,
                                    bool& unsafe, bool& compress);
 
+void WritePutRemoteBufferChunksRequest(const ObjectID id, const size_t size,
+                                       const size_t stripe,
+                                       const size_t stripes,
+                                       const size_t chunk_size,
+                                       const bool compress, std::string& msg);
+
+Status ReadPutRemoteBufferChunksRequest(const json& root, ObjectID& id,
+                                        size_t& size, size_t& stripe,
+                                        size_t& stripes, size_t& chunk_size,
+                                        bool& compress);
+
+void WriteGetRemoteBufferChunksRequest(const std::vector<ObjectID>& ids,
+                                       const size_t stripe,
+                                       const size_t stripes,
+                                       const size_t chunk_size,
+                                       const bool unsafe, const bool compress,
+                                       std::string& msg);
+
+Status ReadGetRemoteBufferChunksRequest(const json& root,
+                                        std::vector<ObjectID>& ids,
+                                        size_t& stripe, size_t& stripes,
+                                        size_t& chunk_size, bool& unsafe,
+                                        bool& compress);
+
+void WriteGetBufferDigestsRequest(const std::vector<ObjectID>& ids,
+                                  std::string& msg);
+
+Status ReadGetBufferDigestsRequest(const json& root,
+                                   std::vector<ObjectID>& ids);
+
+void WriteGetBufferDigestsReply(
+    const std::vector<std::shared_ptr<Payload>>& objects, std::string& msg);
+
+Status ReadGetBufferDigestsReply(
+    const json& root,
+    std::map<ObjectID, std::pair<int64_t, ContentDigest>>& digests);
+
 void WriteIncreaseReferenceCountRequest(const std::vector<ObjectID>& ids,
                                         std::string& msg);
 
@@ -596,8 +653,11 @@ Status ReadDropStreamReply(const json& root);
 void WritePutNameRequest(const ObjectID object_id, const std::string& name,
                          std::string& msg);
 
+void WritePutNameRequest(const ObjectID object_id, const std::string& name,
+                         const ObjectID expected, std::string& msg);
+
 Status ReadPutNameRequest(const json& root, ObjectID& object_id,
-                          std::string& name);
+                          std::string& name, bool& compare, ObjectID& expected);
 
 void WritePutNameReply(std::string& msg);
 
@@ -650,9 +710,10 @@ Status ReadFinalizeArenaRequest(const json& root, int& fd,
                                 std::vector<size_t>& offsets,
                                 std::vector<size_t>& sizes);
 
-void WriteFinalizeArenaReply(std::string& msg);
+void WriteFinalizeArenaReply(std::vector<ObjectID> const& ids,
+                             std::string& msg);
 
-Status ReadFinalizeArenaReply(const json& root);
+Status ReadFinalizeArenaReply(const json& root, std::vector<ObjectID>& ids);
 
 void WriteNewSessionRequest(std::string& msg, StoreType const& bulk_store_type);
 
@@ -727,6 +788,14 @@ void WriteIsInUseReply(const bool is_in_use, std::string& msg);
 
 Status ReadIsInUseReply(json const& root, bool& is_in_use);
 
+void WriteIsCompressedRequest(const ObjectID& id, std::string& msg);
+
+Status ReadIsCompressedRequest(json const& root, ObjectID& id);
+
+void WriteIsCompressedReply(const bool is_compressed, std::string& msg);
+
+Status ReadIsCompressedReply(json const& root, bool& is_compressed);
+
 void WriteClusterMetaRequest(std::string& msg);
 
 Status ReadClusterMetaRequest(const json& root);
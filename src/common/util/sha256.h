@@ -0,0 +1,34 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef SRC_COMMON_UTIL_SHA256_H_
+#define SRC_COMMON_UTIL_SHA256_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace vineyard {
+
+using sha256_digest_t = std::array<uint8_t, 32>;
+
+/**
+ * @brief The SHA-256 (FIPS 180-4) digest of the given buffer.
+ */
+sha256_digest_t sha256(const uint8_t* data, size_t size);
+
+}  // namespace vineyard
+
+#endif  // SRC_COMMON_UTIL_SHA256_H_
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "server/async/socket_server.h"
 
+#include <chrono>
 #include <limits>
 #include <map>
 #include <memory>
@@ -23,6 +24,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "common/compression/compressor.h"
 #include "common/memory/cuda_ipc.h"
 #include "common/memory/fling.h"
 #include "common/util/callback.h"
@@ -76,6 +78,8 @@ bool SocketConnection::Stop() {
       LOG(WARNING) << "Failed to release the connection '" << this->getConnId()
                    << "' from object dependency: " << status.ToString();
     }
+    // the unfinished stripes of blobs being put by this connection
+    socket_server_ptr_->AbortStripedBlobs(this->getConnId());
   }
 
   // do cleanup: clean up streams associated with this client
@@ -263,6 +267,12 @@ bool SocketConnection::processMessage(const std::string& message_in) {
     return doCreateRemoteBuffer(root);
   } else if (cmd == command_t::GET_REMOTE_BUFFERS_REQUEST) {
     return doGetRemoteBuffers(root);
+  } else if (cmd == command_t::PUT_REMOTE_BUFFER_CHUNKS_REQUEST) {
+    return doPutRemoteBufferChunks(root);
+  } else if (cmd == command_t::GET_REMOTE_BUFFER_CHUNKS_REQUEST) {
+    return doGetRemoteBufferChunks(root);
+  } else if (cmd == command_t::GET_BUFFER_DIGESTS_REQUEST) {
+    return doGetBufferDigests(root);
   } else if (cmd == command_t::INCREASE_REFERENCE_COUNT_REQUEST) {
     return doIncreaseReferenceCount(root);
   } else if (cmd == command_t::RELEASE_REQUEST) {
@@ -341,6 +351,8 @@ bool SocketConnection::processMessage(const std::string& message_in) {
     return doIsSpilled(root);
   } else if (cmd == command_t::IS_IN_USE_REQUEST) {
     return doIsInUse(root);
+  } else if (cmd == command_t::IS_COMPRESSED_REQUEST) {
+    return doIsCompressed(root);
   } else if (cmd == command_t::CLUSTER_META_REQUEST) {
     return doClusterMeta(root);
   } else if (cmd == command_t::INSTANCE_STATUS_REQUEST) {
@@ -363,8 +375,14 @@ bool SocketConnection::doRegister(const json& root) {
   StoreType bulk_store_type;
   SessionID session_id;
   std::string username, password;
+  bool support_adaptive_compression = false;
   TRY_READ_REQUEST(ReadRegisterRequest, root, client_version, bulk_store_type,
-                   session_id, username, password);
+                   session_id, username, password,
+                   support_adaptive_compression);
+  if (support_adaptive_compression &&
+      server_ptr_->GetSpec().value("adaptive_compression", true)) {
+    compression_policy_ = std::make_shared<CompressionPolicy>();
+  }
   RESPONSE_ON_ERROR(server_ptr_->Verify(
       username, password,
       [self, bulk_store_type, session_id](const Status& status) -> Status {
@@ -378,7 +396,9 @@ bool SocketConnection::doRegister(const json& root) {
                                self->server_ptr_->RPCEndpoint(),
                                self->server_ptr_->instance_id(),
                                self->server_ptr_->session_id(), store_match,
-                               true /* support_rpc_compression */, message_out);
+                               true /* support_rpc_compression */,
+                               true /* support_adaptive_compression */,
+                               message_out);
           } else {
             WriteErrorReply(s, message_out);
           }
@@ -668,7 +688,8 @@ bool SocketConnection::doGetRemoteBuffers(const json& root) {
 
   this->doWrite(message_out, [self, objects, compress](const Status& status) {
     SendRemoteBuffers(
-        self->socket_, objects, 0, compress, [self](const Status& status) {
+        self->socket_, objects, 0, compress, self->compression_policy_,
+        [self](const Status& status) {
           if (!status.ok()) {
             VLOG(100) << "Failed to send buffers to remote client: "
                       << status.ToString();
@@ -680,6 +701,137 @@ bool SocketConnection::doGetRemoteBuffers(const json& root) {
   return false;
 }
 
+bool SocketConnection::doPutRemoteBufferChunks(const json& root) {
+  auto self(shared_from_this());
+  ObjectID object_id = InvalidObjectID();
+  size_t size = 0, stripe = 0, stripes = 1, chunk_size = 0;
+  bool compress = false;
+  std::shared_ptr<Payload> object;
+
+  TRY_READ_REQUEST(ReadPutRemoteBufferChunksRequest, root, object_id, size,
+                   stripe, stripes, chunk_size, compress);
+  if (object_id == InvalidObjectID()) {
+    // the first stripe is responsible for creating the blob, which is sealed
+    // after all stripes have been received
+    RESPONSE_ON_ERROR(bulk_store_->Create(size, object_id, object));
+    socket_server_ptr_->BeginStripedBlob(object_id, stripes, stripe,
+                                         getConnId(), bulk_store_);
+  } else {
+    RESPONSE_ON_ERROR(
+        socket_server_ptr_->JoinStripedBlob(object_id, stripe, getConnId()));
+    Status status = bulk_store_->GetUnsafe(object_id, true, object);
+    if (status.ok() && static_cast<size_t>(object->data_size) != size) {
+      status = Status::Invalid(
+          "The size of blob doesn't match with the requested size: " +
+          std::to_string(object->data_size) + " vs. " + std::to_string(size));
+    }
+    if (!status.ok()) {
+      // counts as a failed stripe, otherwise the blob would never finish
+      Status blob_status;
+      if (socket_server_ptr_->FinishStripedBlob(object_id, stripe, status,
+                                                blob_status)) {
+        VINEYARD_DISCARD(bulk_store_->Delete(object_id));
+      }
+      RESPONSE_ON_ERROR(status);
+    }
+  }
+  auto chunks = SlicePayloads(
+      {object}, StripePayloadChunks({object->data_size}, stripe, stripes,
+                                    chunk_size));
+
+  auto callback = [self, this, compress, object, chunks,
+                   stripe](const Status& status) -> Status {
+    ReceiveRemoteBuffers(
+        socket_, chunks, 0, 0, compress,
+        [self, object, stripe](const Status& status) -> Status {
+          // the last finished stripe seals the blob, or deletes it if any
+          // stripe has failed, before replying
+          Status result = status;
+          Status blob_status;
+          if (self->socket_server_ptr_->FinishStripedBlob(
+                  object->object_id, stripe, status, blob_status)) {
+            if (blob_status.ok()) {
+              blob_status = self->bulk_store_->Seal(object->object_id);
+            }
+            if (!blob_status.ok()) {
+              VINEYARD_DISCARD(self->bulk_store_->Delete(object->object_id));
+            }
+            result += blob_status;
+          } else if (!blob_status.ok()) {
+            result += blob_status;
+          }
+          std::string message_out;
+          if (result.ok()) {
+            WriteCreateBufferReply(object->object_id, object, -1, message_out);
+          } else {
+            WriteErrorReply(result, message_out);
+          }
+          self->doWrite(message_out);
+          return Status::OK();
+        });
+    LOG_SUMMARY("instances_memory_usage_bytes",
+                self->server_ptr_->instance_id(),
+                self->bulk_store_->Footprint());
+    return Status::OK();
+  };
+
+  // ok to continue
+  std::string message_out;
+  WriteCreateBufferReply(object->object_id, object, -1, message_out);
+  self->doWrite(message_out, callback, true);
+  return false;
+}
+
+bool SocketConnection::doGetRemoteBufferChunks(const json& root) {
+  auto self(shared_from_this());
+  std::vector<ObjectID> ids;
+  size_t stripe = 0, stripes = 1, chunk_size = 0;
+  bool unsafe = false;
+  bool compress = false;
+  std::vector<std::shared_ptr<Payload>> objects;
+  std::string message_out;
+
+  TRY_READ_REQUEST(ReadGetRemoteBufferChunksRequest, root, ids, stripe,
+                   stripes, chunk_size, unsafe, compress);
+  RESPONSE_ON_ERROR(bulk_store_->GetUnsafe(ids, unsafe, objects));
+  RESPONSE_ON_ERROR(bulk_store_->AddDependency(
+      std::unordered_set<ObjectID>(ids.begin(), ids.end()), this->getConnId()));
+  WriteGetBuffersReply(objects, {}, compress, message_out);
+
+  std::vector<int64_t> sizes;
+  for (auto const& object : objects) {
+    sizes.emplace_back(object->data_size);
+  }
+  auto chunks = SlicePayloads(
+      objects, StripePayloadChunks(sizes, stripe, stripes, chunk_size));
+
+  this->doWrite(message_out, [self, chunks, compress](const Status& status) {
+    SendRemoteBuffers(
+        self->socket_, chunks, 0, compress, self->compression_policy_,
+        [self](const Status& status) {
+          if (!status.ok()) {
+            VLOG(100) << "Failed to send buffer chunks to remote client: "
+                      << status.ToString();
+          }
+          return Status::OK();
+        });
+    return Status::OK();
+  });
+  return false;
+}
+
+bool SocketConnection::doGetBufferDigests(const json& root) {
+  std::vector<ObjectID> ids;
+  std::vector<std::shared_ptr<Payload>> objects;
+  std::string message_out;
+
+  TRY_READ_REQUEST(ReadGetBufferDigestsRequest, root, ids);
+  RESPONSE_ON_ERROR(bulk_store_->GetUnsafe(ids, false, objects));
+  WriteGetBufferDigestsReply(objects, message_out);
+  this->doWrite(message_out);
+  return false;
+}
+
 bool SocketConnection::doIncreaseReferenceCount(json const& root) {
   auto self(shared_from_this());
   std::vector<ObjectID> ids;
@@ -1228,12 +1380,14 @@ bool SocketConnection::doDropStream(const json& root) {
 
 bool SocketConnection::doPutName(const json& root) {
   auto self(shared_from_this());
-  ObjectID object_id;
+  ObjectID object_id, expected;
   std::string name;
-  TRY_READ_REQUEST(ReadPutNameRequest, root, object_id, name);
+  bool compare;
+  TRY_READ_REQUEST(ReadPutNameRequest, root, object_id, name, compare,
+                   expected);
   name = escape_json_pointer(name);
-  RESPONSE_ON_ERROR(
-      server_ptr_->PutName(object_id, name, [self](const Status& status) {
+  RESPONSE_ON_ERROR(server_ptr_->PutName(
+      object_id, name, compare, expected, [self](const Status& status) {
         std::string message_out;
         if (status.ok()) {
           WritePutNameReply(message_out);
@@ -1374,11 +1528,12 @@ bool SocketConnection::doFinalizeArena(const json& root) {
   auto self(shared_from_this());
   int fd = -1;
   std::vector<size_t> offsets, sizes;
+  std::vector<ObjectID> ids;
   std::string message_out;
 
   TRY_READ_REQUEST(ReadFinalizeArenaRequest, root, fd, offsets, sizes);
-  RESPONSE_ON_ERROR(bulk_store_->FinalizeArena(fd, offsets, sizes));
-  WriteFinalizeArenaReply(message_out);
+  RESPONSE_ON_ERROR(bulk_store_->FinalizeArena(fd, offsets, sizes, ids));
+  WriteFinalizeArenaReply(ids, message_out);
 
   this->doWrite(message_out);
   return false;
@@ -1570,6 +1725,18 @@ bool SocketConnection::doIsInUse(json const& root) {
   return false;
 }
 
+bool SocketConnection::doIsCompressed(json const& root) {
+  auto self(shared_from_this());
+  ObjectID id;  // Must be a blob id.
+  TRY_READ_REQUEST(ReadIsCompressedRequest, root, id);
+  bool is_compressed = false;
+  RESPONSE_ON_ERROR(bulk_store_->IsCompressed(id, is_compressed));
+  std::string message_out;
+  WriteIsCompressedReply(is_compressed, message_out);
+  this->doWrite(message_out);
+  return false;
+}
+
 bool SocketConnection::doClusterMeta(const json& root) {
   auto self(shared_from_this());
   TRY_READ_REQUEST(ReadClusterMetaRequest, root);
@@ -1772,4 +1939,147 @@ size_t SocketServer::AliveConnections() const {
   return connections_.size();
 }
 
+constexpr int SocketServer::striped_blob_timeout_seconds;
+
+void SocketServer::BeginStripedBlob(
+    const ObjectID id, const size_t stripes, const size_t stripe,
+    const int conn_id, std::shared_ptr<BulkStore> const& bulk_store) {
+  std::lock_guard<std::mutex> scope_lock(this->striped_blobs_mutex_);
+  auto& blob = striped_blobs_[id];
+  blob.stripes = stripes;
+  blob.remaining = stripes;
+  blob.joined.emplace(stripe, conn_id);
+  blob.bulk_store = bulk_store;
+  if (stripes > 1) {
+    blob.timer = std::make_shared<asio::steady_timer>(
+        vs_ptr_->GetContext(),
+        std::chrono::seconds(striped_blob_timeout_seconds));
+    blob.timer->async_wait([this, id](const boost::system::error_code& ec) {
+      // cancelled once all stripes have joined, or the blob is untracked
+      if (!ec) {
+        this->expireStripedBlob(id);
+      }
+    });
+  }
+}
+
+Status SocketServer::JoinStripedBlob(const ObjectID id, const size_t stripe,
+                                     const int conn_id) {
+  std::lock_guard<std::mutex> scope_lock(this->striped_blobs_mutex_);
+  auto iter = striped_blobs_.find(id);
+  if (iter == striped_blobs_.end() || iter->second.expired) {
+    return Status::Invalid(
+        "The blob is not being put by striped connections: " +
+        ObjectIDToString(id));
+  }
+  auto& blob = iter->second;
+  if (stripe >= blob.stripes || blob.joined.find(stripe) != blob.joined.end()) {
+    return Status::Invalid("Invalid or duplicated stripe " +
+                           std::to_string(stripe) + " of the blob " +
+                           ObjectIDToString(id));
+  }
+  blob.joined.emplace(stripe, conn_id);
+  if (blob.joined.size() == blob.stripes && blob.timer) {
+    blob.timer->cancel();
+  }
+  return Status::OK();
+}
+
+bool SocketServer::FinishStripedBlob(const ObjectID id, const size_t stripe,
+                                     const Status& status, Status& result) {
+  std::lock_guard<std::mutex> scope_lock(this->striped_blobs_mutex_);
+  auto iter = striped_blobs_.find(id);
+  if (iter == striped_blobs_.end()) {
+    result = Status::ObjectNotExists("the striped blob has been finished: " +
+                                     ObjectIDToString(id));
+    return false;
+  }
+  auto joined = iter->second.joined.find(stripe);
+  if (joined == iter->second.joined.end() || joined->second == -1) {
+    // has been aborted along with its connection
+    result = Status::Invalid("The stripe " + std::to_string(stripe) +
+                             " of the blob has been finished: " +
+                             ObjectIDToString(id));
+    return false;
+  }
+  joined->second = -1;
+  return finishStripe(iter, status, result);
+}
+
+void SocketServer::AbortStripedBlobs(const int conn_id) {
+  std::vector<std::pair<ObjectID, std::shared_ptr<BulkStore>>> failed;
+  {
+    std::lock_guard<std::mutex> scope_lock(this->striped_blobs_mutex_);
+    for (auto iter = striped_blobs_.begin(); iter != striped_blobs_.end();) {
+      auto current = iter++;
+      for (auto& joined : current->second.joined) {
+        if (joined.second != conn_id) {
+          continue;
+        }
+        joined.second = -1;
+        ObjectID id = current->first;
+        auto bulk_store = current->second.bulk_store;
+        Status result;
+        if (finishStripe(current,
+                         Status::IOError("The connection of the stripe " +
+                                         std::to_string(joined.first) +
+                                         " has been closed"),
+                         result)) {
+          failed.emplace_back(id, bulk_store);
+          break;
+        }
+      }
+    }
+  }
+  for (auto const& item : failed) {
+    VINEYARD_DISCARD(item.second->Delete(item.first));
+  }
+}
+
+bool SocketServer::finishStripe(
+    std::unordered_map<ObjectID, striped_blob_t>::iterator iter,
+    const Status& status, Status& result) {
+  if (iter->second.status.ok() && !status.ok()) {
+    iter->second.status = status;
+  }
+  if (--iter->second.remaining > 0) {
+    return false;
+  }
+  result = iter->second.status;
+  striped_blobs_.erase(iter);
+  return true;
+}
+
+void SocketServer::expireStripedBlob(const ObjectID id) {
+  std::shared_ptr<BulkStore> bulk_store;
+  {
+    std::lock_guard<std::mutex> scope_lock(this->striped_blobs_mutex_);
+    auto iter = striped_blobs_.find(id);
+    if (iter == striped_blobs_.end()) {
+      return;
+    }
+    auto& blob = iter->second;
+    size_t missing = blob.stripes - blob.joined.size();
+    if (missing == 0) {
+      return;
+    }
+    VLOG(100) << "Timed out waiting for " << missing << " stripes of the blob "
+              << ObjectIDToString(id);
+    blob.expired = true;
+    if (blob.status.ok()) {
+      blob.status = Status::IOError(
+          "Timed out waiting for the stripes of the blob " +
+          ObjectIDToString(id));
+    }
+    blob.remaining -= missing;
+    if (blob.remaining > 0) {
+      // the joined stripes delete the blob once they finish
+      return;
+    }
+    bulk_store = blob.bulk_store;
+    striped_blobs_.erase(iter);
+  }
+  VINEYARD_DISCARD(bulk_store->Delete(id));
+}
+
 }  // namespace vineyard
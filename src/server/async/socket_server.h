@@ -38,6 +38,7 @@ class SocketServer;
 class IPCServer;
 class RPCServer;
 class BulkStore;
+class CompressionPolicy;
 class PlasmaBulkStore;
 class VineyardServer;
 
@@ -85,6 +86,20 @@ class SocketConnection : public std::enable_shared_from_this<SocketConnection> {
    */
   bool doGetRemoteBuffers(json const& root);
 
+  /**
+   * @brief The striped variants of doCreateRemoteBuffer and
+   * doGetRemoteBuffers, where each connection only transfers its own share
+   * of chunks, see also Notes on [Transferring remote blobs].
+   */
+  bool doPutRemoteBufferChunks(json const& root);
+  bool doGetRemoteBufferChunks(json const& root);
+
+  /**
+   * @brief Reply the content digests of blobs, which are used to skip
+   * transferring blobs that already exist on the peer during migration.
+   */
+  bool doGetBufferDigests(json const& root);
+
   bool doIncreaseReferenceCount(json const& root);
   bool doRelease(json const& root);
   bool doDelDataWithFeedbacks(json const& root);
@@ -131,6 +146,7 @@ class SocketConnection : public std::enable_shared_from_this<SocketConnection> {
   bool doUnpinObjects(json const& root);
   bool doIsSpilled(json const& root);
   bool doIsInUse(json const& root);
+  bool doIsCompressed(json const& root);
 
   bool doClusterMeta(json const& root);
   bool doInstanceStatus(json const& root);
@@ -199,6 +215,10 @@ class SocketConnection : public std::enable_shared_from_this<SocketConnection> {
   int conn_id_;
   std::atomic_bool running_;
 
+  // chooses the codec of chunks sent to the peer, only available when the
+  // peer supports adaptive compression
+  std::shared_ptr<CompressionPolicy> compression_policy_;
+
   asio::streambuf buf_;
 
   std::unordered_set<int> used_fds_;
@@ -267,6 +287,39 @@ class SocketServer {
   virtual Status Register(std::shared_ptr<SocketConnection> conn,
                           const SessionID session_id) = 0;
 
+  /**
+   * Track a blob that is being put by `stripes` connections (see
+   * `doPutRemoteBufferChunks`), the blob stays unsealed until all stripes
+   * finish. The @stripe@ of the blob is received by @conn_id@.
+   *
+   * The blob is deleted if not all stripes arrive within
+   * `striped_blob_timeout_seconds`.
+   */
+  void BeginStripedBlob(const ObjectID id, const size_t stripes,
+                        const size_t stripe, const int conn_id,
+                        std::shared_ptr<BulkStore> const& bulk_store);
+
+  /**
+   * Join the @stripe@ received by @conn_id@ to a blob that is still being
+   * put by stripes.
+   */
+  Status JoinStripedBlob(const ObjectID id, const size_t stripe,
+                         const int conn_id);
+
+  /**
+   * Record the @status@ of a finished stripe, returns true if it is the last
+   * stripe of the blob, where @result@ is the first failure of all stripes,
+   * if any.
+   */
+  bool FinishStripedBlob(const ObjectID id, const size_t stripe,
+                         const Status& status, Status& result);
+
+  /**
+   * Fail the stripes that are being received by the closed connection, the
+   * blob is deleted once all its stripes finish.
+   */
+  void AbortStripedBlobs(const int conn_id);
+
  protected:
   std::atomic_bool stopped_;  // if the socket server being stopped.
 
@@ -276,6 +329,31 @@ class SocketServer {
   std::unordered_map<int, std::shared_ptr<SocketConnection>> connections_;
   mutable std::recursive_mutex connections_mutex_;  // protect `connections_`
 
+  static constexpr int striped_blob_timeout_seconds = 60;
+
+  struct striped_blob_t {
+    size_t stripes;
+    size_t remaining;
+    Status status;
+    // the joined stripes and their connections, -1 once finished
+    std::unordered_map<size_t, int> joined;
+    // the stripes that haven't joined have been failed by the timer
+    bool expired = false;
+    std::shared_ptr<asio::steady_timer> timer;
+    // where the blob has been created
+    std::shared_ptr<BulkStore> bulk_store;
+  };
+
+  // returns true if the stripe is the last one of the blob, which is
+  // untracked then
+  bool finishStripe(std::unordered_map<ObjectID, striped_blob_t>::iterator iter,
+                    const Status& status, Status& result);
+
+  void expireStripedBlob(const ObjectID id);
+
+  std::unordered_map<ObjectID, striped_blob_t> striped_blobs_;
+  mutable std::mutex striped_blobs_mutex_;  // protect `striped_blobs_`
+
  private:
   virtual void doAccept() = 0;
 };
@@ -35,8 +35,12 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include "common/util/logging.h"  // IWYU pragma: keep
@@ -507,7 +511,8 @@ Status BulkStoreBase<ID, P>::PreAllocate(const size_t size,
 template <typename ID, typename P>
 Status BulkStoreBase<ID, P>::FinalizeArena(const int fd,
                                            std::vector<size_t> const& offsets,
-                                           std::vector<size_t> const& sizes) {
+                                           std::vector<size_t> const& sizes,
+                                           std::vector<ID>& ids) {
   VLOG(2) << "finalizing arena (fd) " << fd << "...";
   auto arena = arenas_.find(fd);
   if (arena == arenas_.end()) {
@@ -530,6 +535,7 @@ Status BulkStoreBase<ID, P>::FinalizeArena(const int fd,
                     std::make_shared<P>(object_id, sizes[idx],
                                         reinterpret_cast<uint8_t*>(pointer), fd,
                                         mmap_size, offsets[idx]));
+    ids.emplace_back(object_id);
     // record the span, will be used to release memory back to OS when deleting
     // blobs
     Arena::spans.emplace(object_id);
@@ -598,6 +604,15 @@ Status BulkStore::Create(const size_t data_size, ObjectID& object_id,
   ptrdiff_t offset = 0;
   uint8_t* pointer = nullptr;
   pointer = AllocateMemoryWithSpill(data_size, &fd, &map_size, &offset);
+  if (pointer == nullptr && remote_blob_cache_) {
+    // evict released local copies of remote blobs and try again
+    std::vector<ObjectID> blobs_to_delete;
+    remote_blob_cache_->Shrink(data_size, blobs_to_delete);
+    if (!blobs_to_delete.empty()) {
+      VINEYARD_DISCARD(deleteBlobs(blobs_to_delete));
+      pointer = AllocateMemoryWithSpill(data_size, &fd, &map_size, &offset);
+    }
+  }
   if (pointer == nullptr) {
     return Status::NotEnoughMemory(
         "Failed to allocate memory of size " + std::to_string(data_size) +
@@ -638,10 +653,23 @@ Status BulkStore::FetchAndModify(const ObjectID& id, int64_t& ref_cnt,
 }
 
 Status BulkStore::OnDelete(ObjectID const& id) {
+  if (remote_blob_cache_ && remote_blob_cache_->Release(id)) {
+    // the local copy of a remote blob is kept until evicted from the cache
+    return Status::OK();
+  }
   RETURN_ON_ERROR(this->RemoveFromColdList(id, true));
   return Delete(id);
 }
 
+Status BulkStore::deleteBlobs(std::vector<ObjectID> const& ids) {
+  Status status;
+  for (auto const& id : ids) {
+    status += this->RemoveFromColdList(id, true);
+    status += Delete(id);
+  }
+  return status;
+}
+
 Status BulkStore::Shrink(ObjectID const& id, size_t const& size) {
   Status status;
   bool found = objects_.update_fn(
@@ -668,6 +696,191 @@ Status BulkStore::Shrink(ObjectID const& id, size_t const& size) {
   return status;
 }
 
+BulkStore::BulkStore() : hasher_state_(std::make_shared<BlobHasherState>()) {}
+
+BulkStore::~BulkStore() {
+  {
+    std::lock_guard<std::mutex> locked(hasher_state_->mu);
+    hasher_state_->stopped = true;
+  }
+  hasher_state_->cv.notify_all();
+  if (hasher_.joinable()) {
+    // the last reference of the bulk store may be released by the hasher
+    // itself
+    if (hasher_.get_id() == std::this_thread::get_id()) {
+      hasher_.detach();
+    } else {
+      hasher_.join();
+    }
+  }
+}
+
+Status BulkStore::Seal(ObjectID const& id) {
+  RETURN_ON_ERROR(BulkStoreBase<ObjectID, Payload>::Seal(id));
+  std::shared_ptr<Payload> object;
+  if (id == EmptyBlobID<ObjectID>() || !GetUnsafe(id, false, object).ok() ||
+      object->IsGPU() || object->data_size <= 0) {
+    return Status::OK();
+  }
+  // the digest may be known in advance, e.g., blobs received by migration
+  auto digest = object->CachedDigest();
+  {
+    std::lock_guard<std::mutex> guard(digest_index_mutex_);
+    if (digest) {
+      digest_index_[std::make_pair(object->data_size, *digest)].emplace(id);
+      return Status::OK();
+    }
+    if (!hash_sealed_blobs_) {
+      return Status::OK();
+    }
+    unhashed_blobs_.emplace(id);
+    if (!hasher_.joinable()) {
+      std::weak_ptr<BulkStore> store = shared_from_this();
+      hasher_ = std::thread(&BulkStore::hashInBackground, store, hasher_state_);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> locked(hasher_state_->mu);
+    hasher_state_->pending.emplace_back(id);
+  }
+  hasher_state_->cv.notify_one();
+  return Status::OK();
+}
+
+Status BulkStore::Delete(ObjectID const& id) {
+  std::shared_ptr<Payload> object;
+  if (id != EmptyBlobID<ObjectID>() && GetUnsafe(id, true, object).ok() &&
+      object->IsOwner() && object->data_size > 0) {
+    auto digest = object->CachedDigest();
+    std::lock_guard<std::mutex> guard(digest_index_mutex_);
+    unhashed_blobs_.erase(id);
+    if (digest) {
+      auto key = std::make_pair(object->data_size, *digest);
+      auto identical = digest_index_.find(key);
+      if (identical != digest_index_.end() && identical->second.erase(id) &&
+          identical->second.empty()) {
+        digest_index_.erase(identical);
+      }
+    }
+  }
+  return BulkStoreBase<ObjectID, Payload>::Delete(id);
+}
+
+Status BulkStore::FindIdenticalBlobs(
+    std::map<ObjectID, std::pair<int64_t, ContentDigest>> const& digests,
+    std::map<ObjectID, ObjectID>& identical_blobs) {
+  std::lock_guard<std::mutex> guard(digest_index_mutex_);
+  for (auto const& item : digests) {
+    auto identical = digest_index_.find(item.second);
+    if (identical != digest_index_.end()) {
+      identical_blobs.emplace(item.first, *identical->second.begin());
+    }
+  }
+  return Status::OK();
+}
+
+void BulkStore::hashSealedBlob(ObjectID const& id) {
+  std::shared_ptr<Payload> object;
+  if (!GetUnsafe(id, false, object).ok()) {
+    return;
+  }
+  // pin the blob to avoid it being spilled during hashing, spilled blobs are
+  // left unhashed and won't be deduplicated
+  object->Pin();
+  ContentDigest digest;
+  bool hashed = !object->IsSpilled() && object->Digest(digest).ok();
+  object->Unpin();
+  if (!hashed) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard(digest_index_mutex_);
+  // skip blobs that have been deleted during hashing
+  if (unhashed_blobs_.erase(id)) {
+    digest_index_[std::make_pair(object->data_size, digest)].emplace(id);
+  }
+}
+
+void BulkStore::hashInBackground(
+    std::weak_ptr<BulkStore> store,
+    std::shared_ptr<BlobHasherState> const& state) {
+  while (true) {
+    ObjectID id = InvalidObjectID();
+    {
+      std::unique_lock<std::mutex> locked(state->mu);
+      state->cv.wait(locked, [&state]() {
+        return state->stopped || !state->pending.empty();
+      });
+      if (state->stopped) {
+        return;
+      }
+      id = state->pending.front();
+      state->pending.pop_front();
+    }
+    if (auto bulk_store = store.lock()) {
+      bulk_store->hashSealedBlob(id);
+    }
+  }
+}
+
+void BulkStore::SetRemoteBlobCacheCapacity(const size_t capacity) {
+  if (capacity == 0) {
+    remote_blob_cache_ = nullptr;
+  } else {
+    remote_blob_cache_ = std::make_shared<RemoteBlobCache>(capacity);
+  }
+}
+
+Status BulkStore::LookupRemoteBlobs(const InstanceID instance_id,
+                                    std::set<ObjectID> const& blobs,
+                                    std::map<ObjectID, ObjectID>& local_blobs) {
+  if (!remote_blob_cache_) {
+    return Status::OK();
+  }
+  std::map<ObjectID, ObjectID> cached_blobs;
+  remote_blob_cache_->Lookup(instance_id, blobs, cached_blobs);
+  for (auto const& item : cached_blobs) {
+    bool sealed = false;
+    objects_.find_fn(item.second,
+                     [&sealed](const std::shared_ptr<Payload>& object) {
+                       sealed = object->IsSealed();
+                     });
+    if (sealed) {
+      local_blobs.emplace(item.first, item.second);
+    } else {
+      remote_blob_cache_->Erase(item.second);
+    }
+  }
+  return Status::OK();
+}
+
+Status BulkStore::CacheRemoteBlobs(const InstanceID instance_id,
+                                   std::map<ObjectID, ObjectID> const& blobs) {
+  if (!remote_blob_cache_) {
+    return Status::OK();
+  }
+  std::vector<ObjectID> blobs_to_delete;
+  for (auto const& item : blobs) {
+    int64_t size = 0;
+    objects_.find_fn(item.second,
+                     [&size](const std::shared_ptr<Payload>& object) {
+                       size = object->data_size;
+                     });
+    remote_blob_cache_->Insert(instance_id, item.first, item.second,
+                               static_cast<size_t>(size), blobs_to_delete);
+  }
+  return deleteBlobs(blobs_to_delete);
+}
+
+Status BulkStore::InvalidateRemoteBlobs(const InstanceID instance_id,
+                                        std::set<ObjectID> const& blobs) {
+  if (!remote_blob_cache_) {
+    return Status::OK();
+  }
+  std::vector<ObjectID> blobs_to_delete;
+  remote_blob_cache_->Invalidate(instance_id, blobs, blobs_to_delete);
+  return deleteBlobs(blobs_to_delete);
+}
+
 Status BulkStore::CreateGPU(const size_t data_size, ObjectID& object_id,
                             std::shared_ptr<Payload>& object) {
 #ifndef ENABLE_CUDA
@@ -29,13 +29,18 @@
 #ifndef SRC_SERVER_MEMORY_MEMORY_H_
 #define SRC_SERVER_MEMORY_MEMORY_H_
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "libcuckoo/cuckoohash_map.hh"
@@ -44,6 +49,7 @@
 #include "common/util/logging.h"  // IWYU pragma: keep
 #include "common/util/macros.h"
 #include "common/util/status.h"
+#include "server/memory/remote_blob_cache.h"
 #include "server/memory/usage.h"
 
 namespace vineyard {
@@ -99,8 +105,12 @@ class BulkStoreBase {
       std::string const& allocator = "mimalloc");
 #endif
 
+  /**
+   * @brief Register the given slices of the arena as (unsealed) blobs, the
+   * blob ids are returned in the same order of `offsets`.
+   */
   Status FinalizeArena(int const fd, std::vector<size_t> const& offsets,
-                       std::vector<size_t> const& sizes);
+                       std::vector<size_t> const& sizes, std::vector<ID>& ids);
 
   Status MoveOwnership(std::map<ID, P> const& to_process_ids);
 
@@ -140,11 +150,27 @@ class BulkStoreBase {
   int64_t mem_spill_lower_bound_;
 };
 
+/**
+ * @brief The sealed blobs to be hashed by the background hasher of the bulk
+ * store. It is shared with the hasher thread, as the thread may outlive the
+ * bulk store for a short while.
+ */
+struct BlobHasherState {
+  std::mutex mu;
+  std::condition_variable cv;
+  bool stopped = false;
+  std::deque<ObjectID> pending;
+};
+
 class BulkStore
     : public BulkStoreBase<ObjectID, Payload>,
       public detail::ColdObjectTracker<ObjectID, Payload, BulkStore>,
       public std::enable_shared_from_this<BulkStore> {
  public:
+  BulkStore();
+
+  ~BulkStore();
+
   /*
    * @brief Allocate space for a new blob.
    */
@@ -176,6 +202,62 @@ class BulkStore
    */
   Status Release_GPU(ObjectID const& id, int conn);
 
+  /*
+   * @brief Seal the blob, and index it for `FindIdenticalBlobs`, the digest
+   * of the blob is computed by a background thread.
+   */
+  Status Seal(ObjectID const& id);
+
+  /*
+   * @brief Delete the blob, and drop it from the index of sealed blobs.
+   */
+  Status Delete(ObjectID const& id);
+
+  /*
+   * @brief Find sealed local blobs that have the same content with the given
+   * (size, digest) pairs.
+   *
+   * Sealed blobs are hashed in the background after sealing (hashing them in
+   * `Seal` would slow down all clients for a feature that only migration
+   * uses), and indexed by their (size, digest) pairs. Only the index is
+   * looked up, blobs that haven't been hashed yet are not found, and will be
+   * transferred as usual.
+   */
+  Status FindIdenticalBlobs(
+      std::map<ObjectID, std::pair<int64_t, ContentDigest>> const& digests,
+      std::map<ObjectID, ObjectID>& identical_blobs);
+
+  /*
+   * @brief Enable hashing sealed blobs in the background, which is required
+   * by `FindIdenticalBlobs` to find the blobs that don't have a digest yet.
+   */
+  void SetBlobHashing(const bool enabled) { hash_sealed_blobs_ = enabled; }
+
+  /*
+   * @brief Enable caching the local copies of remote blobs, see also
+   * `RemoteBlobCache`.
+   */
+  void SetRemoteBlobCacheCapacity(const size_t capacity);
+
+  /*
+   * @brief Lookup the cached local copies of the given remote blobs.
+   */
+  Status LookupRemoteBlobs(const InstanceID instance_id,
+                           std::set<ObjectID> const& blobs,
+                           std::map<ObjectID, ObjectID>& local_blobs);
+
+  /*
+   * @brief Cache the local copies (remote id to local id) of remote blobs.
+   */
+  Status CacheRemoteBlobs(const InstanceID instance_id,
+                          std::map<ObjectID, ObjectID> const& blobs);
+
+  /*
+   * @brief Drop the cached local copies of the deleted remote blobs.
+   */
+  Status InvalidateRemoteBlobs(const InstanceID instance_id,
+                               std::set<ObjectID> const& blobs);
+
  protected:
   /**
    * @brief change the reference count of the object on the client-side cache.
@@ -204,6 +286,28 @@ class BulkStore
     return shared_from_this();
   }
 
+  Status deleteBlobs(std::vector<ObjectID> const& ids);
+
+  /*
+   * @brief Compute the digest of a sealed blob, and move it from the unhashed
+   * blobs to the digest index.
+   */
+  void hashSealedBlob(ObjectID const& id);
+
+  static void hashInBackground(std::weak_ptr<BulkStore> store,
+                               std::shared_ptr<BlobHasherState> const& state);
+
+  std::shared_ptr<RemoteBlobCache> remote_blob_cache_;
+
+  // the index of sealed blobs for `FindIdenticalBlobs`
+  std::mutex digest_index_mutex_;
+  std::set<ObjectID> unhashed_blobs_;
+  std::map<std::pair<int64_t, ContentDigest>, std::set<ObjectID>>
+      digest_index_;
+  bool hash_sealed_blobs_ = true;
+  std::shared_ptr<BlobHasherState> hasher_state_;
+  std::thread hasher_;
+
   friend class detail::ColdObjectTracker<ObjectID, Payload, BulkStore>;
   friend class SocketConnection;
   friend class VineyardServer;
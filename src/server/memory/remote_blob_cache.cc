@@ -0,0 +1,128 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include "server/memory/remote_blob_cache.h"
+
+#include <iterator>
+
+namespace vineyard {
+
+RemoteBlobCache::RemoteBlobCache(const size_t capacity) : capacity_(capacity) {}
+
+void RemoteBlobCache::Lookup(const InstanceID instance_id,
+                             std::set<ObjectID> const& blobs,
+                             std::map<ObjectID, ObjectID>& local_blobs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto const& blob : blobs) {
+    auto iter = entries_.find(std::make_pair(instance_id, blob));
+    if (iter == entries_.end()) {
+      continue;
+    }
+    iter->second->released = false;
+    lru_.splice(lru_.begin(), lru_, iter->second);
+    local_blobs.emplace(blob, iter->second->local_id);
+  }
+}
+
+void RemoteBlobCache::Insert(const InstanceID instance_id,
+                             const ObjectID remote_id, const ObjectID local_id,
+                             const size_t size,
+                             std::vector<ObjectID>& blobs_to_delete) {
+  if (size == 0 || size > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  key_t key = std::make_pair(instance_id, remote_id);
+  if (entries_.find(key) != entries_.end() ||
+      local_entries_.find(local_id) != local_entries_.end()) {
+    // keep the existing copy, the new one will be deleted with its owner
+    return;
+  }
+  lru_.push_front(entry_t{key, local_id, size, false});
+  entries_.emplace(key, lru_.begin());
+  local_entries_.emplace(local_id, lru_.begin());
+  size_ += size;
+
+  while (size_ > capacity_ && !lru_.empty()) {
+    erase(std::prev(lru_.end()), blobs_to_delete);
+  }
+}
+
+bool RemoteBlobCache::Release(const ObjectID local_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = local_entries_.find(local_id);
+  if (iter == local_entries_.end()) {
+    return false;
+  }
+  iter->second->released = true;
+  return true;
+}
+
+void RemoteBlobCache::Invalidate(const InstanceID instance_id,
+                                 std::set<ObjectID> const& remote_ids,
+                                 std::vector<ObjectID>& blobs_to_delete) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto const& remote_id : remote_ids) {
+    auto iter = entries_.find(std::make_pair(instance_id, remote_id));
+    if (iter != entries_.end()) {
+      erase(iter->second, blobs_to_delete);
+    }
+  }
+}
+
+void RemoteBlobCache::Shrink(const size_t size,
+                             std::vector<ObjectID>& blobs_to_delete) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t freed = 0;
+  // from the least recently used copies
+  auto iter = lru_.end();
+  while (iter != lru_.begin() && freed < size) {
+    auto current = std::prev(iter);
+    if (current->released) {
+      freed += current->size;
+      erase(current, blobs_to_delete);
+    } else {
+      iter = current;
+    }
+  }
+}
+
+void RemoteBlobCache::Erase(const ObjectID local_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = local_entries_.find(local_id);
+  if (iter != local_entries_.end()) {
+    std::vector<ObjectID> blobs_to_delete;
+    iter->second->released = false;
+    erase(iter->second, blobs_to_delete);
+  }
+}
+
+size_t RemoteBlobCache::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+void RemoteBlobCache::erase(lru_t::iterator iter,
+                            std::vector<ObjectID>& blobs_to_delete) {
+  if (iter->released) {
+    blobs_to_delete.emplace_back(iter->local_id);
+  }
+  size_ -= iter->size;
+  entries_.erase(iter->key);
+  local_entries_.erase(iter->local_id);
+  lru_.erase(iter);
+}
+
+}  // namespace vineyard
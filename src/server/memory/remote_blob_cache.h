@@ -0,0 +1,122 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#ifndef SRC_SERVER_MEMORY_REMOTE_BLOB_CACHE_H_
+#define SRC_SERVER_MEMORY_REMOTE_BLOB_CACHE_H_
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/util/uuid.h"
+
+namespace vineyard {
+
+/**
+ * @brief RemoteBlobCache records the local copies of blobs that have been
+ * pulled from other instances, keyed by (instance, remote blob id). Blobs
+ * are sealed and immutable, thus a local copy can be reused by later
+ * migrations of objects that share the same remote blobs.
+ *
+ * The cache itself is only the bookkeeping: the local copies live in the
+ * bulk store, and the bulk store consults the cache before deleting a blob.
+ * When the object that owns a cached local copy is deleted, the deletion of
+ * the copy is deferred (the copy is "released") until it is evicted, either
+ * when the total size of cached copies exceeds the capacity, when the remote
+ * blob is deleted, or when the bulk store runs out of memory.
+ *
+ * Released copies are not referenced by any client and are cold objects of
+ * the bulk store, thus can be spilled as well.
+ */
+class RemoteBlobCache {
+ public:
+  explicit RemoteBlobCache(const size_t capacity);
+
+  /**
+   * @brief Lookup local copies of the given remote blobs, the hit copies are
+   * marked as in use again.
+   */
+  void Lookup(const InstanceID instance_id, std::set<ObjectID> const& blobs,
+              std::map<ObjectID, ObjectID>& local_blobs);
+
+  /**
+   * @brief Record the local copy of a remote blob, returns the released
+   * local copies that are evicted and should be deleted.
+   */
+  void Insert(const InstanceID instance_id, const ObjectID remote_id,
+              const ObjectID local_id, const size_t size,
+              std::vector<ObjectID>& blobs_to_delete);
+
+  /**
+   * @brief Mark the local copy as released by its owner, returns false if
+   * the blob is not cached thus should be deleted immediately.
+   */
+  bool Release(const ObjectID local_id);
+
+  /**
+   * @brief Remove the local copies of the given blobs of the instance since
+   * the remote blobs have been deleted.
+   */
+  void Invalidate(const InstanceID instance_id,
+                  std::set<ObjectID> const& remote_ids,
+                  std::vector<ObjectID>& blobs_to_delete);
+
+  /**
+   * @brief Evict released local copies until at least `size` bytes could
+   * be freed.
+   */
+  void Shrink(const size_t size, std::vector<ObjectID>& blobs_to_delete);
+
+  /**
+   * @brief Forget the local copy, e.g., when it has been deleted anyway.
+   */
+  void Erase(const ObjectID local_id);
+
+  size_t Capacity() const { return capacity_; }
+
+  size_t Size() const;
+
+ private:
+  using key_t = std::pair<InstanceID, ObjectID>;
+
+  struct entry_t {
+    key_t key;
+    ObjectID local_id;
+    size_t size;
+    bool released;
+  };
+
+  using lru_t = std::list<entry_t>;
+
+  void erase(lru_t::iterator iter, std::vector<ObjectID>& blobs_to_delete);
+
+  const size_t capacity_;
+  size_t size_ = 0;
+
+  mutable std::mutex mutex_;
+  // most recently used copies are at the front
+  lru_t lru_;
+  std::map<key_t, lru_t::iterator> entries_;
+  std::unordered_map<ObjectID, lru_t::iterator> local_entries_;
+};
+
+}  // namespace vineyard
+
+#endif  // SRC_SERVER_MEMORY_REMOTE_BLOB_CACHE_H_
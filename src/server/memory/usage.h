@@ -17,17 +17,23 @@ limitations under the License.
 #define SRC_SERVER_MEMORY_USAGE_H_
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "flat_hash_map/flat_hash_map.hpp"
 #include "libcuckoo/cuckoohash_map.hh"
 
+#include "common/compression/compressor.h"
 #include "common/memory/payload.h"
 #include "common/util/arrow.h"
 #include "common/util/lifecycle.h"
@@ -39,8 +45,46 @@ limitations under the License.
 
 namespace vineyard {
 
+/**
+ * @brief Statistics of the in-memory compression tier of cold blobs, see
+ * also `ColdObjectTracker::CompressColdObjectFor`.
+ */
+struct ColdCompressionMetrics {
+  size_t compressed_blobs = 0;  // blobs that are compressed currently
+  size_t raw_bytes = 0;         // original size of the compressed blobs
+  size_t compressed_bytes = 0;  // memory occupied by the compressed blobs
+  double compress_seconds = 0;  // accumulated time of compression
+  double decompress_seconds = 0;
+
+  double compression_ratio() const {
+    return raw_bytes > 0 ? static_cast<double>(compressed_bytes) / raw_bytes
+                         : 1.0;
+  }
+};
+
 namespace detail {
 
+/**
+ * @brief The compressed content of a cold blob, which is allocated from the
+ * bulk store as well.
+ */
+struct CompressedBuffer {
+  uint8_t* pointer = nullptr;
+  size_t size = 0;
+};
+
+/**
+ * @brief The requests to the background compressor of cold blobs. It is
+ * shared with the compressor thread, as the thread may outlive the bulk
+ * store for a short while.
+ */
+struct ColdCompressorState {
+  std::mutex mu;
+  std::condition_variable cv;
+  bool stopped = false;
+  int64_t requested = 0;  // bytes to release
+};
+
 /**
  * @brief DependencyTracker is a CRTP class provides the dependency tracking for
  * its derived classes. It record which blobs is been used by each
@@ -235,8 +279,25 @@ class ColdObjectTracker
     Status Unref(const ID id, const bool fast_delete,
                  const std::shared_ptr<Der>& bulk_store) {
       std::lock_guard<decltype(mu_)> locked(mu_);
+      if (fast_delete) {
+        // the blob is about to be freed: wait if it is being read by the
+        // compressor, see also `CompressFor`
+        std::unique_lock<std::mutex> guard(compressing_mu_);
+        compressing_cv_.wait(guard, [this, id]() {
+          return compressing_.find(id) == compressing_.end();
+        });
+      }
+      incompressible_.erase(id);
       auto it = map_.find(id);
       if (it == map_.end()) {
+        if (compressed_obj_.find(id) != compressed_obj_.end()) {
+          if (!fast_delete) {
+            return this->decompress(id, bulk_store);
+          }
+          bulk_store->FreeCompressedPayload(compressed_obj_[id].second);
+          this->forget_compressed(id);
+          return Status::OK();
+        }
         auto spilled = spilled_obj_.find(id);
         if (spilled == spilled_obj_.end()) {
           return Status::OK();
@@ -304,6 +365,103 @@ class ColdObjectTracker
       return Status::OK();
     }
 
+    /**
+     * @brief Compress the least recently used blobs in memory until `sz`
+     * bytes are released. The blobs that don't compress well are left
+     * as is and will be skipped by later attempts.
+     *
+     * The candidates are picked and pinned under the lock, but compressed
+     * without holding it, thus accessing other blobs is not blocked by the
+     * compression. The result is discarded if the blob is accessed during
+     * compression, and deleting the blob waits for the compression.
+     */
+    Status CompressFor(const size_t sz, const std::shared_ptr<Der>& bulk_store,
+                       size_t& released) {
+      released = 0;
+      std::vector<value_t> candidates;
+      {
+        std::lock_guard<decltype(mu_)> locked(mu_);
+        std::lock_guard<std::mutex> guard(compressing_mu_);
+        size_t expected = 0;
+        for (auto it = list_.rbegin(); it != list_.rend() && expected < sz;
+             ++it) {
+          auto const& payload = it->second;
+          if (payload->IsPinned() || payload->is_spilled ||
+              incompressible_.find(it->first) != incompressible_.end() ||
+              compressing_.find(it->first) != compressing_.end()) {
+            continue;
+          }
+          if (!bulk_store->IsCompressible(payload)) {
+            incompressible_.emplace(it->first);
+            continue;
+          }
+          payload->Pin();
+          compressing_.emplace(it->first);
+          candidates.emplace_back(*it);
+          // assumes that blobs are compressed by half
+          expected += payload->data_size / 2;
+        }
+      }
+
+      auto status = Status::OK();
+      for (auto const& candidate : candidates) {
+        auto const& payload = candidate.second;
+        std::vector<uint8_t> compressed;
+        auto start = std::chrono::steady_clock::now();
+        auto s = status.ok() ? bulk_store->CompressPayload(payload, compressed)
+                             : Status::NotEnoughMemory("skipped");
+        auto seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+        {
+          std::lock_guard<std::mutex> guard(compressing_mu_);
+          compressing_.erase(candidate.first);
+        }
+        compressing_cv_.notify_all();
+        payload->Unpin();
+
+        std::lock_guard<decltype(mu_)> locked(mu_);
+        compression_metrics_.compress_seconds += seconds;
+        if (s.IsNotEnoughMemory()) {
+          continue;
+        }
+        if (!s.ok()) {
+          incompressible_.emplace(candidate.first);
+          continue;
+        }
+        auto loc = map_.find(candidate.first);
+        if (loc == map_.end() || payload->IsPinned() || payload->is_spilled) {
+          // accessed, spilled or deleted during compression
+          continue;
+        }
+        CompressedBuffer buffer;
+        s = bulk_store->StoreCompressedPayload(payload, compressed, buffer);
+        if (!s.ok()) {
+          status += s;
+          continue;
+        }
+        released += payload->data_size - buffer.size;
+        compressed_obj_.emplace(candidate.first,
+                                std::make_pair(payload, buffer));
+        compression_metrics_.compressed_blobs += 1;
+        compression_metrics_.raw_bytes += payload->data_size;
+        compression_metrics_.compressed_bytes += buffer.size;
+        list_.erase(loc->second);
+        map_.erase(loc);
+      }
+      return status;
+    }
+
+    ColdCompressionMetrics CompressionMetrics() const {
+      std::lock_guard<decltype(mu_)> locked(mu_);
+      return compression_metrics_;
+    }
+
+    bool CheckCompressed(const ID& id) const {
+      std::lock_guard<decltype(mu_)> locked(mu_);
+      return compressed_obj_.find(id) != compressed_obj_.end();
+    }
+
     Status SpillObjects(
         const std::map<ObjectID, std::shared_ptr<Payload>>& objects,
         const std::shared_ptr<Der>& bulk_store) {
@@ -357,6 +515,9 @@ class ColdObjectTracker
       if (!payload->is_spilled) {
         return Status::OK();
       }
+      if (compressed_obj_.find(object_id) != compressed_obj_.end()) {
+        return this->decompress(object_id, bulk_store);
+      }
       {
         auto loc = spilled_obj_.find(object_id);
         if (loc != spilled_obj_.end()) {
@@ -366,19 +527,66 @@ class ColdObjectTracker
       return bulk_store->ReloadPayload(object_id, payload);
     }
 
+    Status decompress(const ID id, const std::shared_ptr<Der>& bulk_store) {
+      std::lock_guard<decltype(mu_)> locked(mu_);
+      // n.b.: copy the entry, as the allocation for decompressing may
+      // compress other blobs and rehash the map
+      auto entry = compressed_obj_[id];
+      auto start = std::chrono::steady_clock::now();
+      RETURN_ON_ERROR(bulk_store->DecompressPayload(entry.first, entry.second));
+      compression_metrics_.decompress_seconds +=
+          std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                        start)
+              .count();
+      this->forget_compressed(id);
+      return Status::OK();
+    }
+
+    void forget_compressed(const ID id) {
+      auto loc = compressed_obj_.find(id);
+      compression_metrics_.compressed_blobs -= 1;
+      compression_metrics_.raw_bytes -= loc->second.first->data_size;
+      compression_metrics_.compressed_bytes -= loc->second.second.size;
+      compressed_obj_.erase(loc);
+    }
+
     mutable std::recursive_mutex mu_;
     // protected by mu_
     lru_map_t map_;
     lru_list_t list_;
     ska::flat_hash_map<ID, std::shared_ptr<P>> spilled_obj_;
+    ska::flat_hash_map<ID, std::pair<std::shared_ptr<P>, CompressedBuffer>>
+        compressed_obj_;
+    ska::flat_hash_set<ID> incompressible_;
+    ColdCompressionMetrics compression_metrics_;
+
+    // blobs that are being compressed without holding mu_
+    std::mutex compressing_mu_;
+    std::condition_variable compressing_cv_;
+    ska::flat_hash_set<ID> compressing_;
   };
 
  public:
   using base_t = DependencyTracker<ID, P, ColdObjectTracker<ID, P, Der>>;
   using lru_t = LRU;
 
-  ColdObjectTracker() {}
+  ColdObjectTracker()
+      : compressor_state_(std::make_shared<ColdCompressorState>()) {}
   ~ColdObjectTracker() {
+    {
+      std::lock_guard<std::mutex> locked(compressor_state_->mu);
+      compressor_state_->stopped = true;
+    }
+    compressor_state_->cv.notify_all();
+    if (compressor_.joinable()) {
+      // the last reference of the bulk store may be released by the
+      // compressor itself
+      if (compressor_.get_id() == std::this_thread::get_id()) {
+        compressor_.detach();
+      } else {
+        compressor_.join();
+      }
+    }
     if (!spill_path_.empty()) {
       io::FileIOAdaptor io_adaptor(spill_path_);
       DISCARD_ARROW_ERROR(io_adaptor.DeleteDir());
@@ -450,6 +658,66 @@ class ColdObjectTracker
     return Status::OK();
   }
 
+  /**
+   * @brief check if a blob is compressed in memory. Return true if it is
+   * compressed.
+   */
+  Status IsCompressed(const ID id, bool& is_compressed) {
+    is_compressed = cold_obj_lru_.CheckCompressed(id);
+    return Status::OK();
+  }
+
+  /**
+   * @brief Compress cold blobs in memory, before spilling them to disk, when
+   * memory usage is above the watermark. The blobs are compressed by a
+   * background thread, and allocations only compress blobs by themselves
+   * when running out of memory.
+   *
+   * @param level The zstd compression level, negative levels are faster
+   *        (LZ4-alike) but compress less.
+   */
+  void SetColdCompression(const bool enabled, const int level) {
+    compress_cold_objects_ = enabled;
+    cold_compression_level_ = level;
+    if (enabled && !compressor_.joinable()) {
+      std::weak_ptr<Der> store = shared_from_self();
+      compressor_ = std::thread(&ColdObjectTracker::compressInBackground,
+                                store, compressor_state_);
+    }
+  }
+
+  /**
+   * @brief Ask the background compressor to release `sz` bytes by
+   * compressing cold blobs, without waiting for it.
+   */
+  void RequestColdCompression(const int64_t sz) {
+    if (!compress_cold_objects_ || sz <= 0) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> locked(compressor_state_->mu);
+      compressor_state_->requested =
+          std::max(compressor_state_->requested, sz);
+    }
+    compressor_state_->cv.notify_one();
+  }
+
+  ColdCompressionMetrics GetColdCompressionMetrics() const {
+    return cold_obj_lru_.CompressionMetrics();
+  }
+
+  /**
+   * @brief Compress cold blobs in memory until `sz` bytes are released, the
+   * released size is returned by `released`.
+   */
+  Status CompressColdObjectFor(const int64_t sz, size_t& released) {
+    released = 0;
+    if (!compress_cold_objects_ || sz <= 0) {
+      return Status::OK();
+    }
+    return cold_obj_lru_.CompressFor(sz, shared_from_self(), released);
+  }
+
   /**
    * @brief Only triggered when detected OOM, this function will spill cold-obj
    * to disk till memory usage back to allowed watermark.
@@ -506,7 +774,7 @@ class ColdObjectTracker
     uint8_t* pointer = nullptr;
     pointer = self().AllocateMemory(size, fd, map_size, offset);
     // no spill will be conducted
-    if (spill_path_.empty()) {
+    if (spill_path_.empty() && !compress_cold_objects_) {
       return pointer;
     }
 
@@ -529,9 +797,28 @@ class ColdObjectTracker
                                          self().mem_spill_lower_bound_);
       }
 
-      auto s = SpillColdObjectFor(min_spill_size);
-      if (!s.ok()) {
-        DLOG(ERROR) << "Error during spilling cold object: " << s.ToString();
+      if (compress_cold_objects_) {
+        if (pointer != nullptr) {
+          // above the watermark: compress the cold blobs in background
+          // rather than blocking the allocation
+          RequestColdCompression(min_spill_size);
+          return pointer;
+        }
+        // out of memory: compress the cold blobs in memory first, then
+        // spill the remaining to disk
+        size_t compressed_size = 0;
+        auto s = CompressColdObjectFor(min_spill_size, compressed_size);
+        if (!s.ok()) {
+          DLOG(ERROR) << "Error during compressing cold object: "
+                      << s.ToString();
+        }
+        min_spill_size -= static_cast<int64_t>(compressed_size);
+      }
+      if (!spill_path_.empty() && min_spill_size > 0) {
+        auto s = SpillColdObjectFor(min_spill_size);
+        if (!s.ok()) {
+          DLOG(ERROR) << "Error during spilling cold object: " << s.ToString();
+        }
       }
 
       // try to allocate again if needed
@@ -581,9 +868,96 @@ class ColdObjectTracker
       io::SpillFileReader reader(spill_path_);
       RETURN_ON_ERROR(reader.Read(payload, shared_from_self()));
     }
+    payload->is_spilled = false;
     return this->DeletePayloadFile(id);
   }
 
+  /**
+   * @brief Whether the blob can be compressed: blobs on GPU, on disk, or on
+   * user-provided arenas are left as is.
+   */
+  bool IsCompressible(const std::shared_ptr<P>& payload) const {
+    return payload->is_sealed && !payload->is_gpu &&
+           payload->kind == Payload::Kind::kMalloc &&
+           payload->arena_fd == -1 && payload->pointer != nullptr &&
+           payload->data_size >= minimum_compressible_size;
+  }
+
+  /**
+   * @brief Compress the content of the blob, without holding any lock, the
+   * payload must have been pinned.
+   */
+  Status CompressPayload(const std::shared_ptr<P>& payload,
+                         std::vector<uint8_t>& compressed) const {
+    if (payload->is_spilled) {
+      return Status::ObjectSpilled(payload->object_id);
+    }
+    if (!IsCompressible(payload)) {
+      return Status::Invalid("payload cannot be compressed: " +
+                             ObjectIDToString(payload->object_id));
+    }
+    RETURN_ON_ERROR(CompressBuffer(payload->pointer, payload->data_size,
+                                   cold_compression_level_, compressed));
+    if (compressed.size() >
+        static_cast<size_t>(payload->data_size * maximum_compression_ratio)) {
+      return Status::Invalid("payload is not compressible: " +
+                             ObjectIDToString(payload->object_id));
+    }
+    return Status::OK();
+  }
+
+  /**
+   * @brief Replace the content of the blob with the compressed one.
+   */
+  Status StoreCompressedPayload(const std::shared_ptr<P>& payload,
+                                std::vector<uint8_t> const& compressed,
+                                CompressedBuffer& buffer) {
+    int fd = -1;
+    int64_t map_size = 0;
+    ptrdiff_t offset = 0;
+    buffer.pointer =
+        self().AllocateMemory(compressed.size(), &fd, &map_size, &offset);
+    if (buffer.pointer == nullptr) {
+      return Status::NotEnoughMemory(
+          "Failed to allocate memory of size " +
+          std::to_string(compressed.size()) + " for the compressed payload");
+    }
+    buffer.size = compressed.size();
+    memcpy(buffer.pointer, compressed.data(), compressed.size());
+    BulkAllocator::Free(payload->pointer, payload->data_size);
+    payload->store_fd = -1;
+    payload->pointer = nullptr;
+    payload->is_spilled = true;
+    return Status::OK();
+  }
+
+  Status DecompressPayload(const std::shared_ptr<P>& payload,
+                           CompressedBuffer const& buffer) {
+    payload->pointer = AllocateMemoryWithSpill(
+        payload->data_size, &(payload->store_fd), &(payload->map_size),
+        &(payload->data_offset));
+    if (payload->pointer == nullptr) {
+      return Status::NotEnoughMemory("Failed to allocate memory of size " +
+                                     std::to_string(payload->data_size) +
+                                     " while decompressing payload");
+    }
+    auto status = DecompressBuffer(buffer.pointer, buffer.size,
+                                   payload->pointer, payload->data_size);
+    if (!status.ok()) {
+      BulkAllocator::Free(payload->pointer, payload->data_size);
+      payload->store_fd = -1;
+      payload->pointer = nullptr;
+      return status;
+    }
+    FreeCompressedPayload(buffer);
+    payload->is_spilled = false;
+    return Status::OK();
+  }
+
+  void FreeCompressedPayload(CompressedBuffer const& buffer) {
+    BulkAllocator::Free(buffer.pointer, buffer.size);
+  }
+
   Status DeletePayloadFile(const ID id) {
     io::FileIOAdaptor io_adaptor(spill_path_);
     RETURN_ON_ERROR(io_adaptor.RemoveFile(spill_path_ + std::to_string(id)));
@@ -615,9 +989,44 @@ class ColdObjectTracker
   inline Der& self() { return static_cast<Der&>(*this); }
   virtual std::shared_ptr<Der> shared_from_self() = 0;
 
+  static void compressInBackground(
+      std::weak_ptr<Der> store,
+      std::shared_ptr<ColdCompressorState> const& state) {
+    while (true) {
+      int64_t sz = 0;
+      {
+        std::unique_lock<std::mutex> locked(state->mu);
+        state->cv.wait(locked, [&state]() {
+          return state->stopped || state->requested > 0;
+        });
+        if (state->stopped) {
+          return;
+        }
+        std::swap(sz, state->requested);
+      }
+      if (auto bulk_store = store.lock()) {
+        size_t released = 0;
+        auto s = bulk_store->CompressColdObjectFor(sz, released);
+        if (!s.ok()) {
+          DLOG(ERROR) << "Error during compressing cold object: "
+                      << s.ToString();
+        }
+      }
+    }
+  }
+
+  // blobs that are too small are not worth compressing
+  static constexpr int64_t minimum_compressible_size = 64 * 1024;
+  // keep the blob as is if the compressed size is above the ratio
+  static constexpr double maximum_compression_ratio = 0.8;
+
   lru_t cold_obj_lru_;
   std::string spill_path_;
   std::mutex spill_mu_;
+  bool compress_cold_objects_ = false;
+  int cold_compression_level_ = 1;
+  std::shared_ptr<ColdCompressorState> compressor_state_;
+  std::thread compressor_;
 };
 
 }  // namespace detail
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "server/server/vineyard_server.h"
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -142,6 +143,18 @@ Status VineyardServer::Serve(StoreType const& bulk_store_type) {
     bulk_store_->SetMemSpillLowBound(memory_limit * spill_lower_bound_rate);
     bulk_store_->SetSpillPath(
         spec_["bulkstore_spec"]["spill_path"].get<std::string>());
+    bulk_store_->SetColdCompression(
+        spec_["bulkstore_spec"].value("compress_cold_objects", false),
+        spec_["bulkstore_spec"].value("cold_compression_level", 1));
+
+    // setup cache of remote blobs
+    auto remote_blob_cache_rate = std::max(
+        spec_["bulkstore_spec"].value("remote_blob_cache_rate", 0.0), 0.0);
+    bulk_store_->SetRemoteBlobCacheCapacity(
+        static_cast<size_t>(memory_limit * remote_blob_cache_rate));
+
+    // sealed blobs are only hashed for the dedup of migration
+    bulk_store_->SetBlobHashing(spec_.value("migration_dedup", true));
 
     // setup stream store
     stream_store_ = std::make_shared<StreamStore>(
@@ -753,7 +766,13 @@ Status VineyardServer::DelData(
   return Status::OK();
 }
 
-Status VineyardServer::DeleteBlobBatch(const std::set<ObjectID>& ids) {
+Status VineyardServer::DeleteBlobBatch(
+    const std::set<ObjectID>& ids,
+    const std::map<InstanceID, std::set<ObjectID>>& remote_blobs) {
+  for (auto const& item : remote_blobs) {
+    VINEYARD_SUPPRESS(
+        this->bulk_store_->InvalidateRemoteBlobs(item.first, item.second));
+  }
   for (auto object_id : ids) {
     VINEYARD_SUPPRESS(this->bulk_store_->OnDelete(object_id));
   }
@@ -779,12 +798,14 @@ Status VineyardServer::DeleteAllAt(const json& meta,
 }
 
 Status VineyardServer::PutName(const ObjectID object_id,
-                               const std::string& name, callback_t<> callback) {
+                               const std::string& name, const bool compare,
+                               const ObjectID expected, callback_t<> callback) {
   ENSURE_VINEYARDD_READY();
   auto self(shared_from_this());
   meta_service_ptr_->RequestToPersist(
-      [object_id, name](const Status& status, const json& meta,
-                        std::vector<meta_tree::op_t>& ops) {
+      [object_id, name, compare, expected](const Status& status,
+                                           const json& meta,
+                                           std::vector<meta_tree::op_t>& ops) {
         if (status.ok()) {
           // TODO: do proper validation:
           // 1. global objects can have name, local ones cannot.
@@ -820,6 +841,26 @@ Status VineyardServer::PutName(const ObjectID object_id,
                 "transient objects cannot have name, please persist it first");
           }
 
+          if (compare) {
+            // the meta tree is locked during the request, thus the check
+            // and the update is atomic
+            std::string key = name;
+            ObjectID current = InvalidObjectID();
+            auto names = meta.value("names", json(nullptr));
+            if (names.is_object()) {
+              auto iter = names.find(unescape_json_pointer(key));
+              if (iter != names.end() && !iter->is_null()) {
+                current = iter->get<ObjectID>();
+              }
+            }
+            if (current != expected) {
+              return Status::ObjectExists(
+                  "failed to put name: '" + key + "' is associated with " +
+                  ObjectIDToString(current) + " rather than the expected " +
+                  ObjectIDToString(expected));
+            }
+          }
+
           ops.emplace_back(meta_tree::op_t::Put("/names/" + name, object_id));
           ops.emplace_back(meta_tree::op_t::Put(
               "/data/" + ObjectIDToString(object_id) + "/__name",
@@ -1183,6 +1224,16 @@ Status VineyardServer::InstanceStatus(callback_t<const json&> callback) {
   status["memory_usage"] = bulk_store_->Footprint();
   status["memory_limit"] = bulk_store_->FootprintLimit();
   status["deferred_requests"] = deferred_.size();
+  {
+    auto metrics = bulk_store_->GetColdCompressionMetrics();
+    status["compressed_blobs"] = metrics.compressed_blobs;
+    status["compressed_raw_bytes"] = metrics.raw_bytes;
+    status["compressed_bytes"] = metrics.compressed_bytes;
+    status["compress_seconds"] = metrics.compress_seconds;
+    status["decompress_seconds"] = metrics.decompress_seconds;
+    LOG_SUMMARY("cold_compression_ratio", instance_id_,
+                metrics.compression_ratio());
+  }
   if (ipc_server_ptr_) {
     status["ipc_connections"] = ipc_server_ptr_->AliveConnections();
   } else {
@@ -144,11 +144,23 @@ class VineyardServer : public std::enable_shared_from_this<VineyardServer> {
                  const bool deep, const bool fastpath,
                  callback_t<std::vector<ObjectID> const&> callback);
 
-  Status DeleteBlobBatch(const std::set<ObjectID>& blobs);
+  /**
+   * @brief Delete the blobs, and drop the cached local copies of the deleted
+   * blobs of other instances, see also `RemoteBlobCache`.
+   */
+  Status DeleteBlobBatch(
+      const std::set<ObjectID>& blobs,
+      const std::map<InstanceID, std::set<ObjectID>>& remote_blobs);
 
   Status DeleteAllAt(const json& meta, InstanceID const instance_id);
 
+  /**
+   * @brief Associate the name with the object. If `compare` is true, the name
+   * is only updated when it is currently associated with `expected`, or is
+   * not associated with any object when `expected` is `InvalidObjectID()`.
+   */
   Status PutName(const ObjectID object_id, const std::string& name,
+                 const bool compare, const ObjectID expected,
                  callback_t<> callback);
 
   Status GetName(const std::string& name, const bool wait,
@@ -954,7 +954,9 @@ void IMetaService::delVal(std::string const& key) {
 
 void IMetaService::delVal(const kv_t& kv) { delVal(kv.key); }
 
-void IMetaService::delVal(ObjectID const& target, std::set<ObjectID>& blobs) {
+void IMetaService::delVal(
+    ObjectID const& target, std::set<ObjectID>& blobs,
+    std::map<InstanceID, std::set<ObjectID>>& remote_blobs) {
   if (target == InvalidObjectID()) {
     return;
   }
@@ -963,6 +965,15 @@ void IMetaService::delVal(ObjectID const& target, std::set<ObjectID>& blobs) {
     // if deletable blob: delete blob
     if (IsBlob(target)) {
       blobs.emplace(target);
+      // local copies of blobs on other instances may have been cached
+      if (meta_.contains(targetkey) &&
+          meta_[targetkey].contains("instance_id") &&
+          meta_[targetkey]["instance_id"].is_number_unsigned()) {
+        auto instance_id = meta_[targetkey]["instance_id"].get<InstanceID>();
+        if (instance_id != server_ptr_->instance_id()) {
+          remote_blobs[instance_id].emplace(target);
+        }
+      }
     }
     delVal(targetkey);
   } else if (target != InvalidObjectID()) {
@@ -978,6 +989,7 @@ void IMetaService::delVal(ObjectID const& target, std::set<ObjectID>& blobs) {
 template <class RangeT>
 void IMetaService::metaUpdate(const RangeT& ops, bool const from_remote) {
   std::set<ObjectID> blobs_to_delete;
+  std::map<InstanceID, std::set<ObjectID>> remote_blobs_to_delete;
 
   std::vector<op_t> add_sigs, drop_sigs;
   std::vector<op_t> add_objects, drop_objects;
@@ -1096,7 +1108,7 @@ void IMetaService::metaUpdate(const RangeT& ops, bool const from_remote) {
 
     // 3. execute delete for every object
     for (auto const target : processed_delete_set) {
-      delVal(target, blobs_to_delete);
+      delVal(target, blobs_to_delete, remote_blobs_to_delete);
     }
   }
 
@@ -1118,7 +1130,8 @@ void IMetaService::metaUpdate(const RangeT& ops, bool const from_remote) {
   }
 #endif
 
-  VINEYARD_SUPPRESS(server_ptr_->DeleteBlobBatch(blobs_to_delete));
+  VINEYARD_SUPPRESS(
+      server_ptr_->DeleteBlobBatch(blobs_to_delete, remote_blobs_to_delete));
   VINEYARD_SUPPRESS(server_ptr_->ProcessDeferred(meta_));
 }
 
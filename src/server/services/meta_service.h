@@ -215,7 +215,8 @@ class IMetaService : public std::enable_shared_from_this<IMetaService> {
   void putVal(const kv_t& kv, bool const from_remote);
   void delVal(std::string const& key);
   void delVal(const kv_t& kv);
-  void delVal(ObjectID const& target, std::set<ObjectID>& blobs);
+  void delVal(ObjectID const& target, std::set<ObjectID>& blobs,
+              std::map<InstanceID, std::set<ObjectID>>& remote_blobs);
 
   template <class RangeT>
   void metaUpdate(const RangeT& ops, bool const from_remote);
@@ -13,8 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <atomic>
 #include <chrono>
 #include <limits>
+#include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <thread>
 #include <utility>
@@ -24,6 +28,7 @@ limitations under the License.
 #include "common/util/asio.h"
 #include "common/util/protocols.h"
 #include "server/server/vineyard_server.h"
+#include "server/util/metrics.h"
 #include "server/util/remote.h"
 
 namespace vineyard {
@@ -31,13 +36,17 @@ namespace vineyard {
 RemoteClient::RemoteClient(const std::shared_ptr<VineyardServer> server_ptr)
     : server_ptr_(server_ptr),
       context_(server_ptr->GetIOContext()),
-      remote_tcp_socket_(context_),
       socket_(context_),
-      connected_(false) {}
+      connected_(false),
+      chunk_size_(server_ptr->GetSpec().value(
+          "migration_chunk_size", static_cast<size_t>(4 * 1024 * 1024))) {}
 
 RemoteClient::~RemoteClient() {
   boost::system::error_code ec;
   ec = socket_.close(ec);
+  for (auto& stripe : stripes_) {
+    ec = stripe->close(ec);
+  }
 }
 
 Status RemoteClient::Connect(const std::string& rpc_endpoint,
@@ -59,15 +68,33 @@ Status RemoteClient::Connect(const std::string& host, const uint32_t port,
   if (this->connected_) {
     return Status::OK();
   }
+  RETURN_ON_ERROR(connect(host, port, session_id, socket_));
+
+  size_t connections = server_ptr_->GetSpec().value(
+      "migration_connections", static_cast<size_t>(1));
+  for (size_t index = 1; index < connections; ++index) {
+    auto stripe =
+        std::make_shared<asio::generic::stream_protocol::socket>(context_);
+    RETURN_ON_ERROR(connect(host, port, session_id, *stripe));
+    stripes_.emplace_back(stripe);
+  }
+  this->connected_ = true;
+  return Status::OK();
+}
+
+Status RemoteClient::connect(const std::string& host, const uint32_t port,
+                             const SessionID session_id,
+                             asio::generic::stream_protocol::socket& socket) {
+  asio::ip::tcp::socket remote_tcp_socket(context_);
   asio::ip::tcp::resolver resolver(context_);
   int retries = 0, max_connect_retries = 10;
   boost::system::error_code ec;
   while (retries < max_connect_retries) {
 #if BOOST_VERSION >= 106600
-    asio::connect(remote_tcp_socket_,
+    asio::connect(remote_tcp_socket,
                   resolver.resolve(host, std::to_string(port)), ec);
 #else
-    asio::connect(remote_tcp_socket_,
+    asio::connect(remote_tcp_socket,
                   resolver.resolve(asio::ip::tcp::resolver::query(
                       host, std::to_string(port))),
                   ec);
@@ -84,13 +111,13 @@ Status RemoteClient::Connect(const std::string& host, const uint32_t port,
                            std::to_string(max_connect_retries) +
                            " retries: " + ec.message());
   }
-  socket_ = std::move(remote_tcp_socket_);
+  socket = std::move(remote_tcp_socket);
 
   std::string message_out;
   WriteRegisterRequest(message_out, StoreType::kDefault, session_id);
-  RETURN_ON_ERROR(doWrite(message_out));
+  RETURN_ON_ERROR(doWrite(socket, message_out));
   json message_in;
-  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(doRead(socket, message_in));
   std::string ipc_socket_value, rpc_endpoint_value;
   bool store_match, support_rpc_compression;
   SessionID session_id_;
@@ -98,7 +125,6 @@ Status RemoteClient::Connect(const std::string& host, const uint32_t port,
   RETURN_ON_ERROR(ReadRegisterReply(
       message_in, ipc_socket_value, rpc_endpoint_value, remote_instance_id_,
       session_id_, server_version_, store_match, support_rpc_compression));
-  this->connected_ = true;
   return Status::OK();
 }
 
@@ -231,16 +257,68 @@ Status RemoteClient::migrateBuffers(
   bool compress = server_ptr_->GetSpec().value(
       "compression", true);  // enable compression for migration
 
+  // reuse the local copies of remote blobs that have been migrated before
+  std::map<ObjectID, ObjectID> cached_blobs;
+  RETURN_ON_ERROR(server_ptr_->GetBulkStore()->LookupRemoteBlobs(
+      remote_instance_id_, blobs, cached_blobs));
+  std::set<ObjectID> uncached_blobs;
+  for (auto const& blob : blobs) {
+    if (cached_blobs.find(blob) == cached_blobs.end()) {
+      uncached_blobs.emplace(blob);
+    }
+  }
+  if (!cached_blobs.empty()) {
+    LOG_SUMMARY("remote_blob_cache_hits", server_ptr_->instance_id(),
+                cached_blobs.size());
+  }
+
+  // skip blobs whose content already exists locally, or duplicates
+  // another blob in this migration, see also Notes on [Dedup-aware migration]
+  std::map<ObjectID, std::pair<int64_t, ContentDigest>> digests;
+  std::map<ObjectID, ObjectID> identical_blobs, aliased_blobs;
+  if (!uncached_blobs.empty() &&
+      server_ptr_->GetSpec().value("migration_dedup", true)) {
+    RETURN_ON_ERROR(this->dedupBuffers(uncached_blobs, digests,
+                                       identical_blobs, aliased_blobs));
+  }
+  std::set<ObjectID> blobs_to_migrate;
+  size_t nbytes_skipped = 0;
+  for (auto const& blob : uncached_blobs) {
+    if (identical_blobs.find(blob) == identical_blobs.end() &&
+        aliased_blobs.find(blob) == aliased_blobs.end()) {
+      blobs_to_migrate.emplace(blob);
+    } else {
+      nbytes_skipped += digests.at(blob).first;
+    }
+  }
+  if (nbytes_skipped > 0) {
+    LOG_SUMMARY("migration_dedup_bytes", server_ptr_->instance_id(),
+                nbytes_skipped);
+  }
+  identical_blobs.insert(cached_blobs.begin(), cached_blobs.end());
+  if (blobs_to_migrate.empty()) {
+    VINEYARD_DISCARD(callback(Status::OK(), identical_blobs));
+    return Status::OK();
+  }
+
+  std::vector<ObjectID> ids(blobs_to_migrate.begin(), blobs_to_migrate.end());
   std::string message_out;
-  WriteGetRemoteBuffersRequest(blobs, false, compress, message_out);
+  if (stripes_.empty()) {
+    WriteGetRemoteBuffersRequest(blobs_to_migrate, false, compress,
+                                 message_out);
+  } else {
+    WriteGetRemoteBufferChunksRequest(ids, 0, stripes_.size() + 1,
+                                      chunk_size_, false, compress,
+                                      message_out);
+  }
   RETURN_ON_ERROR(doWrite(message_out));
   json message_in;
   RETURN_ON_ERROR(doRead(message_in));
   RETURN_ON_ERROR(ReadGetBuffersReply(message_in, payloads, fd_sent, compress));
-  RETURN_ON_ASSERT(payloads.size() == blobs.size(),
+  RETURN_ON_ASSERT(payloads.size() == blobs_to_migrate.size(),
                    "The result size doesn't match with the requested sizes: " +
                        std::to_string(payloads.size()) + " vs. " +
-                       std::to_string(blobs.size()));
+                       std::to_string(blobs_to_migrate.size()));
 
   std::vector<std::shared_ptr<Payload>> results;
   Status status = Status::OK();
@@ -269,53 +347,192 @@ Status RemoteClient::migrateBuffers(
   }
 
   auto self(shared_from_this());
-  ReceiveRemoteBuffers(
-      socket_, results, 0, 0, compress,
-      [self, callback, payloads, results](const Status& status) {
-        std::map<ObjectID, ObjectID> result_blobs;
-        if (status.ok()) {
-          for (size_t i = 0; i < payloads.size(); ++i) {
-            VINEYARD_DISCARD(
-                self->server_ptr_->GetBulkStore()->Seal(results[i]->object_id));
-            result_blobs.emplace(payloads[i].object_id, results[i]->object_id);
-          }
+  auto start = std::chrono::steady_clock::now();
+  auto callback_after_finish = [self, callback, payloads, results, digests,
+                                identical_blobs, aliased_blobs,
+                                start](const Status& status) {
+    std::map<ObjectID, ObjectID> result_blobs = identical_blobs;
+    if (status.ok()) {
+      std::map<ObjectID, ObjectID> migrated_blobs;
+      size_t nbytes = 0;
+      for (size_t i = 0; i < payloads.size(); ++i) {
+        // the digest has been computed by the peer, reuse it for later
+        // migrations from this instance
+        auto digest = digests.find(payloads[i].object_id);
+        if (digest != digests.end() && results[i]->data_size > 0 &&
+            digest->second.first == results[i]->data_size) {
+          results[i]->SetDigest(digest->second.second);
         }
-        return callback(status, result_blobs);
-      });
+        VINEYARD_DISCARD(
+            self->server_ptr_->GetBulkStore()->Seal(results[i]->object_id));
+        result_blobs.emplace(payloads[i].object_id, results[i]->object_id);
+        if (results[i]->data_size > 0) {
+          migrated_blobs.emplace(payloads[i].object_id,
+                                 results[i]->object_id);
+        }
+        nbytes += payloads[i].data_size;
+      }
+      VINEYARD_DISCARD(self->server_ptr_->GetBulkStore()->CacheRemoteBlobs(
+          self->remote_instance_id_, migrated_blobs));
+      for (auto const& item : aliased_blobs) {
+        result_blobs.emplace(item.first, result_blobs.at(item.second));
+      }
+      double seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+      if (seconds > 0) {
+        LOG_SUMMARY("migration_bandwidth_bytes_per_second",
+                    self->server_ptr_->instance_id(), nbytes / seconds);
+      }
+    }
+    return callback(status, result_blobs);
+  };
+  if (stripes_.empty()) {
+    ReceiveRemoteBuffers(socket_, results, 0, 0, compress,
+                         callback_after_finish);
+    return Status::OK();
+  } else {
+    return receiveStripedBuffers(ids, payloads, results, compress,
+                                 callback_after_finish);
+  }
+}
+
+Status RemoteClient::dedupBuffers(
+    std::set<ObjectID> const& blobs,
+    std::map<ObjectID, std::pair<int64_t, ContentDigest>>& digests,
+    std::map<ObjectID, ObjectID>& identical_blobs,
+    std::map<ObjectID, ObjectID>& aliased_blobs) {
+  std::string message_out;
+  std::vector<ObjectID> ids(blobs.begin(), blobs.end());
+  WriteGetBufferDigestsRequest(ids, message_out);
+  RETURN_ON_ERROR(doWrite(message_out));
+  json message_in;
+  RETURN_ON_ERROR(doRead(message_in));
+  auto status = ReadGetBufferDigestsReply(message_in, digests);
+  if (!status.ok()) {
+    // the peer doesn't support digests, fallback to transfer all blobs
+    VLOG(100) << "Failed to get digests of remote blobs, skip dedup: "
+              << status.ToString();
+    digests.clear();
+    return Status::OK();
+  }
+  RETURN_ON_ERROR(server_ptr_->GetBulkStore()->FindIdenticalBlobs(
+      digests, identical_blobs));
+
+  // transfer only one copy for blobs with the same content
+  std::map<std::pair<int64_t, ContentDigest>, ObjectID> representatives;
+  for (auto const& item : digests) {
+    if (identical_blobs.find(item.first) != identical_blobs.end()) {
+      continue;
+    }
+    auto representative = representatives.emplace(item.second, item.first);
+    if (!representative.second) {
+      aliased_blobs.emplace(item.first, representative.first->second);
+    }
+  }
+  return Status::OK();
+}
+
+Status RemoteClient::receiveStripedBuffers(
+    std::vector<ObjectID> const& ids, std::vector<Payload> const& payloads,
+    std::vector<std::shared_ptr<Payload>> const& results, const bool compress,
+    callback_t<> callback) {
+  const size_t stripes = stripes_.size() + 1;
+  // the first stripe has been requested by the caller
+  for (size_t stripe = 1; stripe < stripes; ++stripe) {
+    auto& socket = *stripes_[stripe - 1];
+    std::vector<Payload> stripe_payloads;
+    std::vector<int> fd_sent;
+    bool stripe_compress = compress;
+    std::string message_out;
+    WriteGetRemoteBufferChunksRequest(ids, stripe, stripes, chunk_size_, false,
+                                      compress, message_out);
+    RETURN_ON_ERROR(doWrite(socket, message_out));
+    json message_in;
+    RETURN_ON_ERROR(doRead(socket, message_in));
+    RETURN_ON_ERROR(ReadGetBuffersReply(message_in, stripe_payloads, fd_sent,
+                                        stripe_compress));
+    bool matched = stripe_payloads.size() == payloads.size();
+    for (size_t i = 0; matched && i < payloads.size(); ++i) {
+      matched = stripe_payloads[i].object_id == payloads[i].object_id &&
+                stripe_payloads[i].data_size == payloads[i].data_size;
+    }
+    RETURN_ON_ASSERT(matched,
+                     "The blobs have been changed during the migration");
+  }
+
+  std::vector<int64_t> sizes;
+  for (auto const& payload : payloads) {
+    sizes.emplace_back(payload.data_size);
+  }
+  auto statuses = std::make_shared<std::vector<Status>>(stripes);
+  auto remaining = std::make_shared<std::atomic_size_t>(stripes);
+  for (size_t stripe = 0; stripe < stripes; ++stripe) {
+    auto& socket = stripe == 0 ? socket_ : *stripes_[stripe - 1];
+    auto chunks = SlicePayloads(
+        results, StripePayloadChunks(sizes, stripe, stripes, chunk_size_));
+    ReceiveRemoteBuffers(
+        socket, chunks, 0, 0, compress,
+        [statuses, remaining, stripe, callback](const Status& status) {
+          (*statuses)[stripe] = status;
+          if (remaining->fetch_sub(1) == 1) {
+            for (auto const& s : *statuses) {
+              if (!s.ok()) {
+                return callback(s);
+              }
+            }
+            return callback(Status::OK());
+          }
+          return Status::OK();
+        });
+  }
   return Status::OK();
 }
 
 Status RemoteClient::doWrite(const std::string& message_out) {
+  return doWrite(socket_, message_out);
+}
+
+Status RemoteClient::doRead(std::string& message_in) {
+  return doRead(socket_, message_in);
+}
+
+Status RemoteClient::doRead(json& root) { return doRead(socket_, root); }
+
+Status RemoteClient::doWrite(asio::generic::stream_protocol::socket& socket,
+                             const std::string& message_out) {
   boost::system::error_code ec;
   size_t length = message_out.length();
-  asio::write(socket_, asio::const_buffer(&length, sizeof(size_t)), ec);
+  asio::write(socket, asio::const_buffer(&length, sizeof(size_t)), ec);
   RETURN_ON_ASIO_ERROR(ec);
-  asio::write(socket_,
+  asio::write(socket,
               asio::const_buffer(message_out.data(), message_out.length()), ec);
   RETURN_ON_ASIO_ERROR(ec);
   return Status::OK();
 }
 
-Status RemoteClient::doRead(std::string& message_in) {
+Status RemoteClient::doRead(asio::generic::stream_protocol::socket& socket,
+                            std::string& message_in) {
   boost::system::error_code ec;
   size_t length = std::numeric_limits<size_t>::max();
-  asio::read(socket_, asio::buffer(&length, sizeof(size_t)), ec);
+  asio::read(socket, asio::buffer(&length, sizeof(size_t)), ec);
   RETURN_ON_ASIO_ERROR(ec);
   if (length > 64 * 1024 * 1024) {  // 64M bytes
     return Status::IOError("Invalid message header value: " +
                            std::to_string(length));
   }
   message_in.resize(length);
-  asio::read(socket_,
+  asio::read(socket,
              asio::mutable_buffer(const_cast<char*>(message_in.data()), length),
              ec);
   RETURN_ON_ASIO_ERROR(ec);
   return Status::OK();
 }
 
-Status RemoteClient::doRead(json& root) {
+Status RemoteClient::doRead(asio::generic::stream_protocol::socket& socket,
+                            json& root) {
   std::string message_in;
-  RETURN_ON_ERROR(doRead(message_in));
+  RETURN_ON_ERROR(doRead(socket, message_in));
   Status status;
   CATCH_JSON_ERROR(root, status, json::parse(message_in));
   return status;
@@ -323,7 +540,8 @@ Status RemoteClient::doRead(json& root) {
 
 void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
                        std::vector<std::shared_ptr<Payload>> const& objects,
-                       size_t index, std::shared_ptr<Compressor> compressor,
+                       size_t index,
+                       std::shared_ptr<AdaptiveCompressor> compressor,
                        callback_t<> callback_after_finish);
 
 namespace detail {
@@ -346,14 +564,15 @@ static void send_chunk(asio::generic::stream_protocol::socket& socket,
 static void send_chunk_compressed(
     asio::generic::stream_protocol::socket& socket,
     std::vector<std::shared_ptr<Payload>> const& objects, size_t index,
-    std::shared_ptr<Compressor> compressor, std::shared_ptr<size_t> chunk_size,
-    callback_t<> callback_after_finish) {
+    std::shared_ptr<AdaptiveCompressor> compressor,
+    std::shared_ptr<size_t> chunk_header, callback_t<> callback_after_finish) {
+  CompressionCodec codec = CompressionCodec::kZSTD;
   void* data = nullptr;
   size_t size = 0;
   Status s;
   do {
     size = 0;
-    s = compressor->Pull(data, size);
+    s = compressor->Pull(codec, data, size);
     if (!s.ok() || size != 0) {
       break;
     }
@@ -362,11 +581,16 @@ static void send_chunk_compressed(
     VINEYARD_DISCARD(callback_after_finish(Status::OK()));
     return;
   }
-  *chunk_size = size;
+  if (!s.ok()) {
+    VINEYARD_DISCARD(callback_after_finish(s));
+    return;
+  }
+  *chunk_header = EncodeChunkHeader(codec, size);
+  auto start = std::chrono::steady_clock::now();
   asio::async_write(
-      socket, asio::buffer(chunk_size.get(), sizeof(size_t)),
+      socket, asio::buffer(chunk_header.get(), sizeof(size_t)),
       [&socket, objects, index, compressor, callback_after_finish, data, size,
-       chunk_size](boost::system::error_code ec, std::size_t) {
+       chunk_header, start](boost::system::error_code ec, std::size_t) {
         if (ec) {
           VINEYARD_DISCARD(callback_after_finish(Status::IOError(
               "Failed to write buffer size to client: " + ec.message())));
@@ -374,16 +598,20 @@ static void send_chunk_compressed(
         }
         asio::async_write(
             socket, asio::buffer(data, size),
-            [&socket, objects, index, compressor, chunk_size,
+            [&socket, objects, index, compressor, chunk_header, size, start,
              callback_after_finish](boost::system::error_code ec, std::size_t) {
               if (ec) {
                 VINEYARD_DISCARD(callback_after_finish(Status::IOError(
                     "Failed to write buffer to client: " + ec.message())));
                 return;
               }
+              compressor->Sent(size,
+                               std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count());
               // continue on the next loop
               send_chunk_compressed(socket, objects, index, compressor,
-                                    chunk_size, callback_after_finish);
+                                    chunk_header, callback_after_finish);
             });
       });
 }
@@ -392,7 +620,8 @@ static void send_chunk_compressed(
 
 void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
                        std::vector<std::shared_ptr<Payload>> const& objects,
-                       size_t index, std::shared_ptr<Compressor> compressor,
+                       size_t index,
+                       std::shared_ptr<AdaptiveCompressor> compressor,
                        callback_t<> callback_after_finish) {
   while (index < objects.size() && objects[index]->data_size == 0) {
     index += 1;
@@ -417,10 +646,10 @@ void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
       VINEYARD_DISCARD(callback_after_finish(s));
       return;
     }
-    // we need the `size` leave in heap to keep it alive inside callback
-    std::shared_ptr<size_t> chunk_size = std::make_shared<size_t>(0);
+    // we need the `header` leave in heap to keep it alive inside callback
+    std::shared_ptr<size_t> chunk_header = std::make_shared<size_t>(0);
     detail::send_chunk_compressed(socket, objects, index, compressor,
-                                  chunk_size, callback);
+                                  chunk_header, callback);
   } else {
     detail::send_chunk(socket, objects, index, callback);
   }
@@ -430,11 +659,39 @@ void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
                        std::vector<std::shared_ptr<Payload>> const& objects,
                        size_t index, const bool compress,
                        callback_t<> callback_after_finish) {
-  std::shared_ptr<Compressor> compressor;
-  if (compress) {
-    compressor = std::make_shared<Compressor>();
+  SendRemoteBuffers(socket, objects, index, compress, nullptr,
+                    callback_after_finish);
+}
+
+void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
+                       std::vector<std::shared_ptr<Payload>> const& objects,
+                       size_t index, const bool compress,
+                       std::shared_ptr<CompressionPolicy> const& policy,
+                       callback_t<> callback_after_finish) {
+  if (!compress) {
+    SendRemoteBuffers(socket, objects, index,
+                      std::shared_ptr<AdaptiveCompressor>(nullptr),
+                      callback_after_finish);
+    return;
   }
-  SendRemoteBuffers(socket, objects, index, compressor, callback_after_finish);
+  auto compressor = std::make_shared<AdaptiveCompressor>(policy);
+  auto start = std::chrono::steady_clock::now();
+  SendRemoteBuffers(
+      socket, objects, index, compressor,
+      [compressor, start, callback_after_finish](const Status& status) {
+        if (status.ok()) {
+          TransferMetrics metrics = compressor->metrics();
+          metrics.transfer_seconds = std::chrono::duration<double>(
+                                         std::chrono::steady_clock::now() -
+                                         start)
+                                         .count();
+          LOG_SUMMARY("rpc_send_bandwidth_bytes_per_second", "",
+                      metrics.bandwidth());
+          LOG_SUMMARY("rpc_send_compression_ratio", "",
+                      metrics.compression_ratio());
+        }
+        return callback_after_finish(status);
+      });
 }
 
 void ReceiveRemoteBuffers(asio::generic::stream_protocol::socket& socket,
@@ -528,26 +785,69 @@ static void read_chunk(asio::generic::stream_protocol::socket& socket,
       });
 }
 
+static void read_raw_chunk(asio::generic::stream_protocol::socket& socket,
+                           std::vector<std::shared_ptr<Payload>> const& objects,
+                           size_t index, size_t offset,
+                           std::shared_ptr<Decompressor> decompressor,
+                           const size_t size,
+                           callback_t<> callback_after_finish) {
+  asio::async_read(
+      socket, asio::buffer(objects[index]->pointer + offset, size),
+      [&socket, objects, index, offset, decompressor, size,
+       callback_after_finish](boost::system::error_code ec, std::size_t) {
+        if (ec) {
+          VINEYARD_DISCARD(callback_after_finish(Status::IOError(
+              "Failed to read buffer from client: " + ec.message())));
+          return;
+        }
+        ReceiveRemoteBuffers(socket, objects, index, offset + size,
+                             decompressor, callback_after_finish);
+      });
+}
+
 static void read_sized_chunk(
     asio::generic::stream_protocol::socket& socket,
     std::vector<std::shared_ptr<Payload>> const& objects, size_t index,
     size_t offset, std::shared_ptr<Decompressor> decompressor,
     asio::mutable_buffer buffer, callback_t<> callback_after_finish) {
-  // we need the `size` leave in heap to keep it alive inside callback
-  std::shared_ptr<size_t> chunk_size = std::make_shared<size_t>(0);
+  // we need the `header` leave in heap to keep it alive inside callback
+  std::shared_ptr<size_t> chunk_header = std::make_shared<size_t>(0);
   asio::async_read(
-      socket, asio::buffer(chunk_size.get(), sizeof(size_t)),
+      socket, asio::buffer(chunk_header.get(), sizeof(size_t)),
       [&socket, objects, index, offset, decompressor, buffer,
        callback_after_finish,
-       chunk_size](boost::system::error_code ec, std::size_t) {
+       chunk_header](boost::system::error_code ec, std::size_t) {
         if (ec) {
-          auto status = Status::IOError(
-              "Failed to read buffer size from client: " + ec.message());
+          VINEYARD_DISCARD(callback_after_finish(Status::IOError(
+              "Failed to read buffer size from client: " + ec.message())));
           return;
         }
-        read_chunk(socket, objects, index, offset, decompressor,
-                   asio::mutable_buffer(buffer.data(), *chunk_size),
-                   callback_after_finish);
+        CompressionCodec codec;
+        size_t chunk_size = 0;
+        auto s = DecodeChunkHeader(*chunk_header, codec, chunk_size);
+        if (s.ok() && codec == CompressionCodec::kNone &&
+            chunk_size >
+                static_cast<size_t>(objects[index]->data_size) - offset) {
+          s = Status::IOError("Invalid uncompressed chunk size: " +
+                              std::to_string(chunk_size));
+        }
+        if (s.ok() && codec == CompressionCodec::kZSTD &&
+            chunk_size > buffer.size()) {
+          s = Status::IOError("Invalid compressed chunk size: " +
+                              std::to_string(chunk_size));
+        }
+        if (!s.ok()) {
+          VINEYARD_DISCARD(callback_after_finish(s));
+          return;
+        }
+        if (codec == CompressionCodec::kNone) {
+          read_raw_chunk(socket, objects, index, offset, decompressor,
+                         chunk_size, callback_after_finish);
+        } else {
+          read_chunk(socket, objects, index, offset, decompressor,
+                     asio::mutable_buffer(buffer.data(), chunk_size),
+                     callback_after_finish);
+        }
       });
 }
 
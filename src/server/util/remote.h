@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/memory/payload.h"
@@ -30,6 +31,7 @@ limitations under the License.
 
 namespace vineyard {
 
+class CompressionPolicy;
 class VineyardServer;
 
 class RemoteClient : public std::enable_shared_from_this<RemoteClient> {
@@ -50,24 +52,53 @@ class RemoteClient : public std::enable_shared_from_this<RemoteClient> {
       const std::set<ObjectID> blobs,
       callback_t<const std::map<ObjectID, ObjectID>&> results);
 
+  Status dedupBuffers(
+      std::set<ObjectID> const& blobs,
+      std::map<ObjectID, std::pair<int64_t, ContentDigest>>& digests,
+      std::map<ObjectID, ObjectID>& identical_blobs,
+      std::map<ObjectID, ObjectID>& aliased_blobs);
+
+  Status receiveStripedBuffers(
+      std::vector<ObjectID> const& ids, std::vector<Payload> const& payloads,
+      std::vector<std::shared_ptr<Payload>> const& results,
+      const bool compress, callback_t<> callback);
+
   Status collectRemoteBlobs(const json& tree, std::set<ObjectID>& blobs);
 
   Status recreateMetadata(json const& metadata, json& target,
                           std::map<ObjectID, ObjectID> const& result_blobs);
 
  private:
+  Status connect(const std::string& host, const uint32_t port,
+                 const SessionID session_id,
+                 asio::generic::stream_protocol::socket& socket);
+
   Status doWrite(const std::string& message_out);
 
+  Status doWrite(asio::generic::stream_protocol::socket& socket,
+                 const std::string& message_out);
+
   Status doRead(std::string& message_in);
 
+  Status doRead(asio::generic::stream_protocol::socket& socket,
+                std::string& message_in);
+
   Status doRead(json& root);
+
+  Status doRead(asio::generic::stream_protocol::socket& socket, json& root);
+
   InstanceID remote_instance_id_;
 
   std::shared_ptr<VineyardServer> server_ptr_;
   asio::io_context& context_;
-  asio::ip::tcp::socket remote_tcp_socket_;
   asio::generic::stream_protocol::socket socket_;
   bool connected_;
+
+  // extra connections for striped migration, see also
+  // Notes on [Transferring remote blobs]
+  std::vector<std::shared_ptr<asio::generic::stream_protocol::socket>>
+      stripes_;
+  size_t chunk_size_;
 };
 
 /**
@@ -79,8 +110,49 @@ class RemoteClient : public std::enable_shared_from_this<RemoteClient> {
  *    that are empty are skipped.
  *
  *  - if compression is enabled, each blob will be compressed as several
- *    chunks, and each chunk will be sent as [chunk_size, chunk], where
- *    the chunk_size is a `size_t`.
+ *    chunks, and each chunk will be sent as [chunk_header, chunk], where
+ *    the chunk_header is a `size_t` of the chunk size and the codec of the
+ *    chunk (see `EncodeChunkHeader`).
+ *
+ *  - if both peers support adaptive compression (negotiated when registering),
+ *    the sender splits blobs into blocks and chooses the codec (zstd of some
+ *    level, or none) for each block using the `CompressionPolicy`, otherwise
+ *    all chunks are zstd chunks of the default level.
+ *
+ *  - for striped transfer (`*_REMOTE_BUFFER_CHUNKS` requests), the blobs are
+ *    split into chunks of a fixed size (see `StripePayloadChunks`), and the
+ *    i-th chunk goes with the (i % stripes)-th connection. Each connection
+ *    transfers its own chunks as if they are standalone blobs using the
+ *    protocol above, thus chunks are (de)compressed independently and in
+ *    parallel, and are written to the destination blobs directly in
+ *    whatever order they arrive.
+ */
+
+/**
+ * Notes on [Dedup-aware migration]
+ *
+ * Before pulling blobs from the peer, the destination asks for the SHA-256
+ * content digests (`GET_BUFFER_DIGESTS`, cached in the payload, and usually
+ * computed by the background hasher of the bulk store after sealing) of the
+ * blobs to migrate, and
+ *
+ *  - blobs whose (size, digest) matches a sealed local blob are not
+ *    transferred, the migrated metadata refers to the local blob instead,
+ *
+ *  - blobs with the same (size, digest) in the same migration are
+ *    transferred only once.
+ *
+ * Blobs are aliased without comparing the bytes, which would require the
+ * transfer that dedup avoids, and the cryptographic digest makes accidental
+ * collisions practically impossible. Local blobs are looked up by the index
+ * of sealed blobs in the bulk store, see `BulkStore::FindIdenticalBlobs`.
+ *
+ * Peers that don't support digests reply an error and all blobs are
+ * transferred as before. The dedup can be disabled by `--migration_dedup`.
+ *
+ * Blobs that have been migrated from the same instance before are looked up
+ * in the `RemoteBlobCache` of the bulk store first, and are neither hashed
+ * nor transferred again.
  */
 
 void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
@@ -88,6 +160,12 @@ void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
                        size_t index, const bool compress,
                        callback_t<> callback_after_finish);
 
+void SendRemoteBuffers(asio::generic::stream_protocol::socket& socket,
+                       std::vector<std::shared_ptr<Payload>> const& objects,
+                       size_t index, const bool compress,
+                       std::shared_ptr<CompressionPolicy> const& policy,
+                       callback_t<> callback_after_finish);
+
 void ReceiveRemoteBuffers(asio::generic::stream_protocol::socket& socket,
                           std::vector<std::shared_ptr<Payload>> const& objects,
                           size_t index, size_t offset, const bool decompress,
@@ -14,6 +14,7 @@ limitations under the License.
 */
 
 // #include <cstdlib>
+#include <algorithm>
 #include <exception>
 
 #include "gflags/gflags.h"
@@ -82,6 +83,18 @@ DEFINE_double(spill_lower_rate, 0.3,
               "low watermark of triggering memory spilling");
 DEFINE_double(spill_upper_rate, 0.8,
               "high watermark of triggering memory spilling");
+DEFINE_bool(compress_cold_objects, false,
+            "Compress cold blobs in shared memory when memory usage is above "
+            "the spill watermark, before spilling them to disk");
+DEFINE_int32(cold_compression_level, 1,
+             "zstd level for compressing cold blobs, negative levels are "
+             "faster (LZ4-alike) but compress less");
+
+// cache of remote blobs
+DEFINE_double(remote_blob_cache_rate, 0.0,
+              "fraction of shared memory for keeping the local copies of "
+              "blobs migrated from other instances after their owners have "
+              "been deleted, 0 means disabled");
 
 // ipc
 DEFINE_string(
@@ -98,6 +111,18 @@ DEFINE_bool(sync_crds, false, "Synchronize CRDs when persisting objects");
 
 // IO: spill and migration
 DEFINE_bool(compression, true, "Compress before migration or spilling");
+DEFINE_bool(adaptive_compression, true,
+            "Choose the codec and level for each chunk of RPC transfers and "
+            "migration by sampling the content and the link throughput");
+DEFINE_int32(migration_connections, 1,
+             "Number of TCP connections for migrating blobs from remote "
+             "instances, blobs are split into chunks and transferred over "
+             "these connections in parallel");
+DEFINE_int64(migration_chunk_size, 4 * 1024 * 1024,
+             "Size of chunks when migrating blobs over multiple connections");
+DEFINE_bool(migration_dedup, true,
+            "Skip transferring blobs whose content already exists on the "
+            "destination instance during migration");
 
 // metrics and prometheus
 DEFINE_bool(prometheus, false,
@@ -164,6 +189,9 @@ json BulkstoreSpecResolver::resolve() const {
   spec["spill_path"] = FLAGS_spill_path;
   spec["spill_lower_bound_rate"] = FLAGS_spill_lower_rate;
   spec["spill_upper_bound_rate"] = FLAGS_spill_upper_rate;
+  spec["compress_cold_objects"] = FLAGS_compress_cold_objects;
+  spec["cold_compression_level"] = FLAGS_cold_compression_level;
+  spec["remote_blob_cache_rate"] = FLAGS_remote_blob_cache_rate;
   return spec;
 }
 
@@ -214,6 +242,12 @@ json ServerSpecResolver::resolve() const {
   json spec;
   spec["deployment"] = FLAGS_deployment;
   spec["compression"] = FLAGS_compression;
+  spec["adaptive_compression"] = FLAGS_adaptive_compression;
+  spec["migration_connections"] =
+      static_cast<size_t>(std::max<int32_t>(FLAGS_migration_connections, 1));
+  spec["migration_chunk_size"] =
+      static_cast<size_t>(std::max<int64_t>(FLAGS_migration_chunk_size, 1));
+  spec["migration_dedup"] = FLAGS_migration_dedup;
   spec["sync_crds"] =
       FLAGS_sync_crds || (read_env("VINEYARD_SYNC_CRDS") == "1");
   spec["metastore_spec"] = Resolver::get("metastore").resolve();
@@ -13,15 +13,19 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <unistd.h>
+
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
 #include "arrow/stl.h"
 
 #include "basic/ds/arrow.h"
+#include "basic/ds/arrow_shim/concatenate.h"
 #include "basic/ds/arrow_utils.h"
 #include "client/client.h"
 #include "client/ds/object_meta.h"
@@ -320,6 +324,17 @@ int main(int argc, char** argv) {
     auto sliced_internal_array = r3->GetArray();
     CHECK(sliced_internal_array->Equals(a3));
 
+    // test multiple (sliced) chunks
+    std::vector<std::shared_ptr<arrow::ListArray>> chunks{a1, a3, a1};
+    ListArrayBuilder chunked_array_builder(client, chunks);
+    VINEYARD_CHECK_OK(chunked_array_builder.Seal(client, object));
+    auto r4 = std::dynamic_pointer_cast<ListArray>(object);
+    std::shared_ptr<arrow::Array> expected;
+    CHECK_ARROW_ERROR_AND_ASSIGN(expected,
+                                 arrow_shim::Concatenate({a1, a3, a1}));
+    CHECK(r4->GetArray()->Equals(*expected));
+    CHECK_EQ(r4->GetArray()->null_count(), 3);
+
     LOG(INFO) << "Passed list array wrapper tests...";
   }
 
@@ -359,6 +374,123 @@ int main(int argc, char** argv) {
     LOG(INFO) << "Passed large list array wrapper tests...";
   }
 
+  {
+    LOG(INFO) << "######### Dictionary Array Test ######";
+    arrow::StringBuilder b1, b2;
+    CHECK_ARROW_ERROR(b1.AppendValues({"CN", "US", "JP"}));
+    CHECK_ARROW_ERROR(b2.AppendValues({"US", "FR"}));
+    arrow::Int32Builder b3, b4;
+    CHECK_ARROW_ERROR(b3.AppendValues({0, 1}));
+    CHECK_ARROW_ERROR(b3.AppendNull());
+    CHECK_ARROW_ERROR(b3.AppendValues({2, 0}));
+    CHECK_ARROW_ERROR(b4.AppendValues({1, 0, 1}));
+    std::shared_ptr<arrow::Array> dict1, dict2, indices1, indices2;
+    CHECK_ARROW_ERROR(b1.Finish(&dict1));
+    CHECK_ARROW_ERROR(b2.Finish(&dict2));
+    CHECK_ARROW_ERROR(b3.Finish(&indices1));
+    CHECK_ARROW_ERROR(b4.Finish(&indices2));
+    auto type = arrow::dictionary(arrow::int32(), arrow::utf8());
+    std::shared_ptr<arrow::Array> a1, a2;
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        a1, arrow::DictionaryArray::FromArrays(type, indices1, dict1));
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        a2, arrow::DictionaryArray::FromArrays(type, indices2, dict2));
+
+    DictionaryArrayBuilder array_builder(
+        client, std::dynamic_pointer_cast<arrow::DictionaryArray>(a1));
+    std::shared_ptr<Object> object;
+    VINEYARD_CHECK_OK(array_builder.Seal(client, object));
+    auto r1 = std::dynamic_pointer_cast<DictionaryArray>(object);
+    VINEYARD_CHECK_OK(client.Persist(r1->id()));
+    auto r2 =
+        std::dynamic_pointer_cast<DictionaryArray>(client.GetObject(r1->id()));
+    CHECK(r2->GetArray()->Equals(*a1));
+    CHECK_EQ(r2->GetArray()->null_count(), 1);
+    // the indices are not copied when reconstructing the arrow array
+    auto r2_indices = std::dynamic_pointer_cast<Int32Array>(r2->GetIndices());
+    CHECK_EQ(r2->GetArray()->indices()->data()->buffers[1]->data(),
+             r2_indices->GetArray()->values()->data());
+
+    // share the sealed dictionary, only the indices are copied
+    DictionaryArrayBuilder shared_builder(client, r1->GetDictionary(),
+                                          indices2);
+    VINEYARD_CHECK_OK(shared_builder.Seal(client, object));
+    auto r3 = std::dynamic_pointer_cast<DictionaryArray>(object);
+    CHECK_EQ(r3->GetDictionary()->id(), r1->GetDictionary()->id());
+    std::shared_ptr<arrow::Array> expected;
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        expected, arrow::DictionaryArray::FromArrays(type, indices2, dict1));
+    CHECK(r3->GetArray()->Equals(*expected));
+
+    // indices out of the range of the shared dictionary are rejected
+    {
+      arrow::Int32Builder b5;
+      CHECK_ARROW_ERROR(b5.AppendValues({0, 3}));
+      std::shared_ptr<arrow::Array> indices3;
+      CHECK_ARROW_ERROR(b5.Finish(&indices3));
+      DictionaryArrayBuilder invalid_builder(client, r1->GetDictionary(),
+                                             indices3);
+      CHECK(invalid_builder.Seal(client, object).IsInvalid());
+    }
+
+    // chunks with different dictionaries are unified into one dictionary
+    auto decode = [](std::shared_ptr<arrow::DictionaryArray> const& array) {
+      auto dictionary =
+          std::dynamic_pointer_cast<arrow::StringArray>(array->dictionary());
+      std::vector<std::string> values;
+      for (int64_t i = 0; i < array->length(); ++i) {
+        values.emplace_back(array->IsNull(i) ? "<null>"
+                                             : dictionary->GetString(
+                                                   array->GetValueIndex(i)));
+      }
+      return values;
+    };
+    DictionaryArrayBuilder chunked_builder(
+        client, std::make_shared<arrow::ChunkedArray>(
+                    arrow::ArrayVector{a1, a2, a1}, type));
+    VINEYARD_CHECK_OK(chunked_builder.Seal(client, object));
+    auto r4 = std::dynamic_pointer_cast<DictionaryArray>(object);
+    CHECK_EQ(r4->length(), 13);
+    CHECK_EQ(r4->GetArray()->dictionary()->length(), 4);
+    std::vector<std::string> expected_values = {
+        "CN", "US", "<null>", "JP", "CN", "FR", "US",
+        "FR", "CN", "US", "<null>", "JP", "CN"};
+    CHECK(decode(r4->GetArray()) == expected_values);
+
+    // dictionary columns in record batches
+    auto batch = arrow::RecordBatch::Make(
+        arrow::schema({arrow::field("country", type)}), a1->length(), {a1});
+    RecordBatchBuilder batch_builder(client, batch);
+    VINEYARD_CHECK_OK(batch_builder.Seal(client, object));
+    auto r5 = std::dynamic_pointer_cast<RecordBatch>(object);
+    CHECK(r5->GetRecordBatch()->Equals(*batch));
+
+    // the batches of a table share one dictionary
+    auto batch2 = arrow::RecordBatch::Make(
+        arrow::schema({arrow::field("country", type)}), a2->length(), {a2});
+    std::shared_ptr<arrow::Table> arrow_table;
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        arrow_table, arrow::Table::FromRecordBatches({batch, batch2}));
+    TableBuilder table_builder(client, arrow_table);
+    VINEYARD_CHECK_OK(table_builder.Seal(client, object));
+    auto r6 = std::dynamic_pointer_cast<Table>(object);
+    CHECK_EQ(r6->batch_num(), 2);
+    auto c1 = std::dynamic_pointer_cast<DictionaryArray>(
+        r6->batches()[0]->columns()[0]);
+    auto c2 = std::dynamic_pointer_cast<DictionaryArray>(
+        r6->batches()[1]->columns()[0]);
+    CHECK_EQ(c1->GetDictionary()->id(), c2->GetDictionary()->id());
+    CHECK_EQ(c1->GetArray()->dictionary()->length(), 4);
+    CHECK(decode(c1->GetArray()) ==
+          std::vector<std::string>({"CN", "US", "<null>", "JP", "CN"}));
+    CHECK(decode(c2->GetArray()) ==
+          std::vector<std::string>({"FR", "US", "FR"}));
+
+    VINEYARD_CHECK_OK(client.DelData(
+        {r1->id(), r3->id(), r4->id(), r5->id(), r6->id()}, false, true));
+    LOG(INFO) << "Passed dictionary array wrapper tests...";
+  }
+
   {
     LOG(INFO) << "#########  Record Batch Test #######";
     arrow::LargeStringBuilder key_builder;
@@ -477,6 +609,29 @@ int main(int argc, char** argv) {
     auto internal_table = r2->GetTable();
     CHECK(internal_table->Equals(*table));
 
+    LOG(INFO) << "#########  Table Export/Import Test #############";
+    for (bool file_format : {true, false}) {
+      std::string path = "/tmp/arrow_data_structure_test_" +
+                         std::to_string(getpid()) + ".arrow";
+      VINEYARD_CHECK_OK(ExportTable(r2, path, file_format));
+      std::shared_ptr<Table> imported;
+      VINEYARD_CHECK_OK(ImportTable(client, path, imported));
+      CHECK(imported->GetTable()->Equals(*table));
+      VINEYARD_CHECK_OK(client.DelData(imported->id()));
+      unlink(path.c_str());
+    }
+
+    LOG(INFO) << "#########  Table Projection Test #############";
+    {
+      std::shared_ptr<Table> projected;
+      VINEYARD_CHECK_OK(client.GetObject(id, {"f2"}, projected));
+      CHECK_EQ(projected->num_columns(), 1);
+      std::shared_ptr<arrow::Table> expected;
+      CHECK_ARROW_ERROR_AND_ASSIGN(expected, table->SelectColumns({1}));
+      CHECK(projected->GetTable()->Equals(*expected));
+      CHECK(client.GetObject(id, {"f3"}, projected).IsKeyError());
+    }
+
     LOG(INFO) << "#########  Table Extender Test #############";
     TableExtender extender(client, r2);
     VINEYARD_CHECK_OK(extender.AddColumn(client, "f7", array1));
@@ -509,6 +664,12 @@ int main(int argc, char** argv) {
     auto r6 = std::dynamic_pointer_cast<Table>(client.GetObject(id5));
     CHECK_EQ(r6->schema()->num_fields(), 3);
 
+    std::shared_ptr<arrow::Table> consolidated;
+    VINEYARD_CHECK_OK(vineyard::ConsolidateColumns(
+        table, std::vector<std::string>{"f1", "f8"}, "merged", consolidated));
+    CHECK(r6->GetTable()->GetColumnByName("merged")->Equals(
+        consolidated->GetColumnByName("merged")));
+
     // validate the content of the table
     //
     // LOG(INFO) << r6->GetTable()->ToString();
@@ -583,6 +744,196 @@ int main(int argc, char** argv) {
     LOG(INFO) << "Passed large table with multiple chunks tests...";
   }
 
+  {
+    LOG(INFO) << "######### Parallel Table Builder Test ######";
+    size_t ncolumns = 64, nchunks = 3;
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    for (size_t cindex = 0; cindex < ncolumns; ++cindex) {
+      std::vector<std::shared_ptr<arrow::Array>> chunks;
+      for (size_t chunk_index = 0; chunk_index < nchunks; ++chunk_index) {
+        std::shared_ptr<arrow::Array> chunk;
+        if (cindex % 2 == 0) {
+          arrow::Int64Builder b1;
+          for (size_t i = 0; i < 1024; ++i) {
+            CHECK_ARROW_ERROR(b1.Append(cindex * i + chunk_index));
+          }
+          CHECK_ARROW_ERROR(b1.Finish(&chunk));
+        } else {
+          arrow::StringBuilder b1;
+          for (size_t i = 0; i < 1024; ++i) {
+            CHECK_ARROW_ERROR(b1.Append(std::to_string(cindex * i)));
+          }
+          CHECK_ARROW_ERROR(b1.Finish(&chunk));
+        }
+        chunks.emplace_back(chunk);
+      }
+      fields.emplace_back(
+          arrow::field("f" + std::to_string(cindex), chunks[0]->type()));
+      columns.emplace_back(std::make_shared<arrow::ChunkedArray>(chunks));
+    }
+    auto table = arrow::Table::Make(arrow::schema(fields), columns);
+
+    // parallel over columns (merged), and over batches (2 < 3 chunks)
+    for (bool merge_chunks : {true, false}) {
+      TableBuilder builder(client, table, merge_chunks);
+      builder.set_concurrency(merge_chunks ? 8 : 2);
+      std::shared_ptr<Object> object;
+      VINEYARD_CHECK_OK(builder.Seal(client, object));
+      auto sealed = std::dynamic_pointer_cast<Table>(object);
+      CHECK_EQ(sealed->num_columns(), ncolumns);
+      CHECK(sealed->GetTable()->Equals(*table));
+      VINEYARD_CHECK_OK(client.DelData(sealed->id(), false, true));
+    }
+    LOG(INFO) << "Passed parallel table builder tests...";
+  }
+
+  {
+    LOG(INFO) << "######### Append-only Table Test ######";
+    auto schema = arrow::schema({arrow::field("f1", arrow::int64()),
+                                 arrow::field("f2", arrow::utf8())});
+    auto make_batch = [&](int64_t begin, int64_t end) {
+      arrow::Int64Builder b1;
+      arrow::StringBuilder b2;
+      for (int64_t i = begin; i < end; ++i) {
+        CHECK_ARROW_ERROR(b1.Append(i));
+        CHECK_ARROW_ERROR(b2.Append(std::to_string(i)));
+      }
+      std::shared_ptr<arrow::Array> a1, a2;
+      CHECK_ARROW_ERROR(b1.Finish(&a1));
+      CHECK_ARROW_ERROR(b2.Finish(&a2));
+      return arrow::RecordBatch::Make(schema, end - begin, {a1, a2});
+    };
+
+    const std::string name = "append_only_table_test";
+    std::vector<std::shared_ptr<Table>> versions;
+    {
+      std::shared_ptr<Table> table;
+      TableAppender appender(client, schema);
+      VINEYARD_CHECK_OK(appender.Append(client, make_batch(0, 100)));
+      VINEYARD_CHECK_OK(appender.Publish(client, name, table));
+      versions.emplace_back(table);
+    }
+    for (int64_t round = 1; round < 4; ++round) {
+      std::shared_ptr<Table> current, table;
+      VINEYARD_CHECK_OK(TableAppender::Latest(client, name, current));
+      CHECK_EQ(current->id(), versions.back()->id());
+      TableAppender appender(client, current);
+      appender.set_compact(true);
+      VINEYARD_CHECK_OK(
+          appender.Append(client, make_batch(round * 100, round * 100 + 10)));
+      VINEYARD_CHECK_OK(appender.Publish(client, name, table));
+      versions.emplace_back(table);
+    }
+
+    // a batch of another schema cannot be appended
+    {
+      arrow::DoubleBuilder b1;
+      CHECK_ARROW_ERROR(b1.Append(1.0));
+      std::shared_ptr<arrow::Array> a1;
+      CHECK_ARROW_ERROR(b1.Finish(&a1));
+      auto batch = arrow::RecordBatch::Make(
+          arrow::schema({arrow::field("f1", arrow::float64())}), 1, {a1});
+      TableAppender appender(client, versions.back());
+      CHECK(appender.Append(client, batch).IsInvalid());
+    }
+
+    // a writer that appends to a stale version cannot publish
+    {
+      std::shared_ptr<Table> table;
+      TableAppender appender(client, versions[1]);
+      VINEYARD_CHECK_OK(appender.Append(client, make_batch(1000, 1010)));
+      CHECK(appender.Publish(client, name, table).IsObjectExists());
+      TableAppender creator(client, schema);
+      VINEYARD_CHECK_OK(creator.Append(client, make_batch(1000, 1010)));
+      CHECK(creator.Publish(client, name, table).IsObjectExists());
+    }
+
+    std::shared_ptr<Table> latest;
+    VINEYARD_CHECK_OK(TableAppender::Latest(client, name, latest));
+    CHECK_EQ(latest->id(), versions.back()->id());
+    CHECK_EQ(latest->version(), 3);
+    CHECK_EQ(latest->num_rows(), 130);
+    // the small appended batches have been merged: [100, 30]
+    CHECK_EQ(latest->batch_num(), 2);
+    CHECK_EQ(latest->batches()[1]->num_rows(), 30);
+    for (size_t index = 1; index < versions.size(); ++index) {
+      CHECK_EQ(versions[index]->version(), index);
+      CHECK_EQ(versions[index]->previous_version(), versions[index - 1]->id());
+      // the record batches of previous versions are shared
+      CHECK_EQ(versions[index]->batches()[0]->id(),
+               versions[0]->batches()[0]->id());
+    }
+    CHECK_EQ(versions[0]->previous_version(), InvalidObjectID());
+
+    // readers that pin the first version are not affected by appends
+    auto pinned = std::dynamic_pointer_cast<Table>(
+        client.GetObject(versions[0]->id()));
+    CHECK_EQ(pinned->num_rows(), 100);
+    std::shared_ptr<arrow::Table> expected;
+    CHECK_ARROW_ERROR_AND_ASSIGN(
+        expected, arrow::Table::FromRecordBatches({make_batch(0, 100)}));
+    CHECK(pinned->GetTable()->Equals(*expected));
+    CHECK_EQ(latest->GetTable()->num_rows(), 130);
+    {
+      std::shared_ptr<arrow::Table> expected;
+      CHECK_ARROW_ERROR_AND_ASSIGN(
+          expected, arrow::Table::FromRecordBatches(
+                        {make_batch(0, 100), make_batch(100, 110),
+                         make_batch(200, 210), make_batch(300, 310)}));
+      CHECK(latest->GetTable()->Equals(*expected));
+    }
+
+    // without compaction (the default) every appended batch is kept
+    {
+      std::shared_ptr<Object> object;
+      TableAppender appender(client, latest);
+      VINEYARD_CHECK_OK(appender.Append(client, make_batch(400, 410)));
+      VINEYARD_CHECK_OK(appender.Seal(client, object));
+      auto table = std::dynamic_pointer_cast<Table>(object);
+      CHECK_EQ(table->batch_num(), 3);
+      VINEYARD_CHECK_OK(client.DelData(table->id(), false, true));
+    }
+
+    // the rows of the previous version that a build rewrites are bounded
+    {
+      std::shared_ptr<Object> object;
+      TableAppender appender(client, latest);
+      appender.set_compact(true, 20);
+      VINEYARD_CHECK_OK(appender.Append(client, make_batch(400, 420)));
+      VINEYARD_CHECK_OK(appender.Seal(client, object));
+      auto table = std::dynamic_pointer_cast<Table>(object);
+      // merging [30] would rewrite more than 20 rows: [100, 30, 20]
+      CHECK_EQ(table->batch_num(), 3);
+      VINEYARD_CHECK_OK(client.DelData(table->id(), false, true));
+    }
+    {
+      std::shared_ptr<Object> object;
+      TableAppender appender(client, latest);
+      appender.set_compact(true, 30);
+      VINEYARD_CHECK_OK(appender.Append(client, make_batch(400, 420)));
+      VINEYARD_CHECK_OK(appender.Seal(client, object));
+      auto table = std::dynamic_pointer_cast<Table>(object);
+      // merges [30], but stops before [100]: [100, 50]
+      CHECK_EQ(table->batch_num(), 2);
+      CHECK_EQ(table->batches()[1]->num_rows(), 50);
+      VINEYARD_CHECK_OK(client.DelData(table->id(), false, true));
+    }
+
+    // deleting old versions deeply keeps the record batches that are shared
+    // with the latest version
+    VINEYARD_CHECK_OK(client.DropName(name));
+    for (size_t index = 0; index + 1 < versions.size(); ++index) {
+      VINEYARD_CHECK_OK(client.DelData(versions[index]->id(), false, true));
+    }
+    CHECK_EQ(std::dynamic_pointer_cast<Table>(client.GetObject(latest->id()))
+                 ->GetTable()
+                 ->num_rows(),
+             130);
+    VINEYARD_CHECK_OK(client.DelData(latest->id(), false, true));
+    LOG(INFO) << "Passed append-only table tests...";
+  }
+
   client.Disconnect();
 
   return 0;
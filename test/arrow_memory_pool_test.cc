@@ -0,0 +1,105 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow_shim/memory_pool.h"
+#include "basic/ds/arrow_utils.h"
+#include "client/client.h"
+#include "client/ds/blob.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./arrow_memory_pool_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  {
+    LOG(INFO) << "#########  Pooled Builder Test #############";
+    memory::VineyardMemoryPool pool(client, 64 * 1024 * 1024);
+    std::vector<std::shared_ptr<arrow::Int64Array>> arrays;
+    for (int64_t index = 0; index < 1024; ++index) {
+      arrow::Int64Builder builder(&pool);
+      for (int64_t value = 0; value < index; ++value) {
+        CHECK_ARROW_ERROR(builder.Append(index + value));
+      }
+      std::shared_ptr<arrow::Int64Array> array;
+      CHECK_ARROW_ERROR(builder.Finish(&array));
+      arrays.emplace_back(array);
+    }
+    CHECK_GT(pool.bytes_allocated(), 0);
+
+    std::vector<ObjectID> blob_ids;
+    for (int64_t index = 1; index < 1024; ++index) {
+      std::shared_ptr<Blob> blob;
+      VINEYARD_CHECK_OK(pool.Take(arrays[index]->values(), blob));
+      CHECK(IsBlob(blob->id()));
+      CHECK_GE(blob->allocated_size(), index * sizeof(int64_t));
+      blob_ids.emplace_back(blob->id());
+    }
+
+    // the blobs are sealed and visible to the server
+    for (int64_t index = 1; index < 1024; ++index) {
+      std::shared_ptr<Blob> blob;
+      VINEYARD_CHECK_OK(client.GetBlob(blob_ids[index - 1], blob));
+      auto values = reinterpret_cast<const int64_t*>(blob->data());
+      for (int64_t value = 0; value < index; ++value) {
+        CHECK_EQ(values[value], index + value);
+      }
+    }
+    VINEYARD_CHECK_OK(client.DelData(blob_ids));
+    LOG(INFO) << "Passed pooled builder tests...";
+  }
+
+  {
+    LOG(INFO) << "#########  Pooled Large Buffer Test #############";
+    memory::VineyardMemoryPool pool(client, 1024 * 1024);
+    uint8_t *small = nullptr, *large = nullptr;
+    CHECK_ARROW_ERROR(pool.Allocate(1024, &small));
+    CHECK_ARROW_ERROR(pool.Allocate(1024 * 1024, &large));
+    // grow in place as the last allocation in the slab
+    uint8_t* grown = small;
+    CHECK_ARROW_ERROR(pool.Reallocate(1024, 4096, &grown));
+    CHECK_EQ(grown, small);
+
+    // large buffers are still separated blobs
+    std::unique_ptr<BlobWriter> writer;
+    VINEYARD_CHECK_OK(pool.Take(large, writer));
+    VINEYARD_CHECK_OK(writer->Abort(client));
+    // slices of slabs can only be taken as sealed blobs
+    CHECK(pool.Take(small, writer).IsInvalid());
+    pool.Free(small, 4096);
+    CHECK_EQ(pool.bytes_allocated(), 0);
+    LOG(INFO) << "Passed pooled large buffer tests...";
+  }
+
+  LOG(INFO) << "Passed arrow memory pool tests...";
+
+  client.Disconnect();
+
+  return 0;
+}
@@ -0,0 +1,119 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basic/ds/array.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+#include "common/util/status.h"
+#include "common/util/uuid.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+// the server is launched with a 16MB memory limit, see also `runner.py`
+constexpr size_t num_arrays = 32;
+constexpr size_t array_length = 128 * 1024;  // 1MB of doubles
+
+template <typename T>
+ObjectID GetBufferID(const std::shared_ptr<Array<T>>& sealed_array) {
+  return ObjectIDFromString(sealed_array->meta()
+                                .MetaData()["buffer_"]["id"]
+                                .template get_ref<std::string const&>());
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./cold_compression_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  std::vector<double> values(array_length);
+  for (size_t i = 0; i < array_length; ++i) {
+    values[i] = static_cast<double>(i % 64);
+  }
+
+  // twice the memory limit, which only fits when the cold ones are compressed
+  std::vector<ObjectID> ids, blob_ids;
+  for (size_t index = 0; index < num_arrays; ++index) {
+    ArrayBuilder<double> builder(client, values);
+    auto array = std::dynamic_pointer_cast<Array<double>>(builder.Seal(client));
+    ids.emplace_back(array->id());
+    blob_ids.emplace_back(GetBufferID(array));
+    VINEYARD_CHECK_OK(client.Release({ids.back(), blob_ids.back()}));
+  }
+
+  {
+    // the coldest blob is compressed, either by the background compressor
+    // or by the allocations that run out of memory
+    bool is_compressed{false};
+    for (int retry = 0; retry < 100 && !is_compressed; ++retry) {
+      VINEYARD_CHECK_OK(client.IsCompressed(blob_ids.front(), is_compressed));
+      if (!is_compressed) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    CHECK(is_compressed);
+    // no spill path is given, see also `runner.py`
+    bool is_spilled{true};
+    VINEYARD_CHECK_OK(client.IsSpilled(blob_ids.front(), is_spilled));
+    CHECK(!is_spilled);
+
+    std::shared_ptr<struct InstanceStatus> status;
+    VINEYARD_CHECK_OK(client.InstanceStatus(status));
+    CHECK_GT(status->compressed_blobs, 0);
+    CHECK_LT(status->compressed_bytes * 4, status->compressed_raw_bytes);
+    CHECK_LE(status->memory_usage, status->memory_limit);
+    LOG(INFO) << "Compressed " << status->compressed_blobs << " blobs, from "
+              << status->compressed_raw_bytes << " bytes to "
+              << status->compressed_bytes << " bytes";
+  }
+
+  // compressed blobs are decompressed transparently when being accessed
+  for (size_t index = 0; index < num_arrays; index += 7) {
+    auto array = client.GetObject<Array<double>>(ids[index]);
+    CHECK_EQ(array->size(), array_length);
+    for (size_t i = 0; i < array_length; ++i) {
+      CHECK_EQ((*array)[i], values[i]);
+    }
+    bool is_compressed{true};
+    VINEYARD_CHECK_OK(client.IsCompressed(blob_ids[index], is_compressed));
+    CHECK(!is_compressed);
+    VINEYARD_CHECK_OK(client.Release({ids[index], blob_ids[index]}));
+  }
+
+  {
+    std::shared_ptr<struct InstanceStatus> status;
+    VINEYARD_CHECK_OK(client.InstanceStatus(status));
+    CHECK_GT(status->decompress_seconds, 0);
+  }
+
+  VINEYARD_CHECK_OK(client.DelData(ids, false, true));
+
+  LOG(INFO) << "Passed cold compression tests...";
+
+  client.Disconnect();
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/compressed_string_array.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./compressed_string_array_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  // URL-like keys, with a few empty and binary ones
+  std::vector<std::string> values;
+  arrow::LargeStringBuilder builder;
+  for (int i = 0; i < 100000; ++i) {
+    values.emplace_back("http://www.example.org/resource/Person_" +
+                        std::to_string(i));
+  }
+  values.emplace_back("");
+  values.emplace_back(std::string("\xff\x00\xfe", 3));
+  CHECK_ARROW_ERROR(builder.AppendValues(values));
+  std::shared_ptr<arrow::Array> array;
+  CHECK_ARROW_ERROR(builder.Finish(&array));
+
+  CompressedStringArrayBuilder compressed_builder(
+      client, std::dynamic_pointer_cast<arrow::LargeStringArray>(array));
+  auto sealed = std::dynamic_pointer_cast<CompressedStringArray>(
+      compressed_builder.Seal(client));
+  auto compressed = std::dynamic_pointer_cast<CompressedStringArray>(
+      client.GetObject(sealed->id()));
+  CHECK_EQ(compressed->length(), values.size());
+
+  std::string value;
+  size_t compressed_bytes = 0;
+  for (size_t index = 0; index < values.size(); ++index) {
+    compressed->GetString(index, value);
+    CHECK_EQ(value, values[index]);
+    CHECK_EQ(compressed->Find(values[index]), static_cast<int64_t>(index));
+    compressed_bytes += compressed->GetCompressedView(index).size();
+  }
+  CHECK_EQ(compressed->Find("http://www.example.org/resource/Person_"), -1);
+  CHECK_EQ(compressed->Find("not exists"), -1);
+  CHECK_LT(compressed_bytes * 2, compressed->raw_bytes());
+  LOG(INFO) << "Compressed " << compressed->raw_bytes() << " bytes into "
+            << compressed_bytes << " bytes with "
+            << compressed->symbol_table().symbol_num() << " symbols";
+
+  VINEYARD_CHECK_OK(client.DelData(sealed->id(), true, true));
+
+  // null strings are rejected rather than compressed as empty strings
+  {
+    arrow::LargeStringBuilder null_builder;
+    CHECK_ARROW_ERROR(null_builder.Append("http://www.example.org/"));
+    CHECK_ARROW_ERROR(null_builder.AppendNull());
+    std::shared_ptr<arrow::Array> nulls;
+    CHECK_ARROW_ERROR(null_builder.Finish(&nulls));
+    CompressedStringArrayBuilder null_compressed_builder(
+        client, std::dynamic_pointer_cast<arrow::LargeStringArray>(nulls));
+    std::shared_ptr<Object> object;
+    CHECK(!null_compressed_builder.Seal(client, object).ok());
+  }
+  LOG(INFO) << "Passed compressed string array tests...";
+
+  client.Disconnect();
+  return 0;
+}
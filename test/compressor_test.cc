@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <thread>
@@ -112,8 +113,110 @@ void CompressSingleBlobTest() {
   VINEYARD_ASSERT(data == decompressed);
 }
 
+// Sends the blobs as `compress_and_send` in rpc_client.cc does.
+void SendBlobs(AdaptiveCompressor& compressor,
+               const std::vector<std::string>& blobs, std::string& wire) {
+  for (auto const& blob : blobs) {
+    VINEYARD_CHECK_OK(compressor.Compress(blob.data(), blob.size()));
+    CompressionCodec codec = CompressionCodec::kZSTD;
+    void* chunk = nullptr;
+    size_t chunk_size = 0;
+    while (compressor.Pull(codec, chunk, chunk_size).ok()) {
+      if (chunk_size == 0) {
+        continue;
+      }
+      size_t chunk_header = EncodeChunkHeader(codec, chunk_size);
+      wire.append(reinterpret_cast<const char*>(&chunk_header),
+                  sizeof(size_t));
+      wire.append(static_cast<const char*>(chunk), chunk_size);
+      // pretend a 100MB/s link to make compression worthwhile
+      compressor.Sent(chunk_size, chunk_size / 1e8);
+    }
+  }
+}
+
+// Receives a blob as `recv_and_decompress` in rpc_client.cc does, which stops
+// reading the wire once the expected bytes are decompressed.
+void ReceiveBlob(Decompressor& decompressor, const std::string& wire,
+                 size_t& offset, std::string& blob) {
+  char* buffer = const_cast<char*>(blob.data());
+  size_t decompressed_offset = 0;
+  while (decompressed_offset < blob.size()) {
+    size_t chunk_header = 0, nbytes = 0;
+    CompressionCodec codec;
+    VINEYARD_ASSERT(offset + sizeof(size_t) <= wire.size());
+    memcpy(&chunk_header, wire.data() + offset, sizeof(size_t));
+    offset += sizeof(size_t);
+    VINEYARD_CHECK_OK(DecodeChunkHeader(chunk_header, codec, nbytes));
+    VINEYARD_ASSERT(offset + nbytes <= wire.size());
+    if (codec == CompressionCodec::kNone) {
+      VINEYARD_ASSERT(nbytes <= blob.size() - decompressed_offset);
+      memcpy(buffer + decompressed_offset, wire.data() + offset, nbytes);
+      offset += nbytes;
+      decompressed_offset += nbytes;
+      continue;
+    }
+    void* incoming_buffer = nullptr;
+    size_t incoming_buffer_size = 0;
+    VINEYARD_CHECK_OK(
+        decompressor.Buffer(incoming_buffer, incoming_buffer_size));
+    VINEYARD_ASSERT(nbytes <= incoming_buffer_size);
+    memcpy(incoming_buffer, wire.data() + offset, nbytes);
+    offset += nbytes;
+    VINEYARD_CHECK_OK(decompressor.Decompress(nbytes));
+    size_t size = 0;
+    while (decompressed_offset < blob.size() &&
+           decompressor
+               .Pull(buffer + decompressed_offset,
+                     blob.size() - decompressed_offset, size)
+               .ok()) {
+      decompressed_offset += size;
+    }
+    char overflow;
+    while (!decompressor.Pull(&overflow, 1, size).IsStreamDrained()) {
+      VINEYARD_ASSERT(size == 0);
+    }
+  }
+}
+
+void AdaptiveCompressBackToBackTest() {
+  // block-aligned sizes, where the ends of the zstd frames used to be sent
+  // in separate chunks and left in the wire by the receivers
+  const std::vector<size_t> sizes = {9 * 1024 * 1024, 3 * 1024 * 1024 + 17,
+                                     5 * 1024 * 1024, 20 * 1024 * 1024};
+  std::vector<std::string> blobs;
+  for (size_t size : sizes) {
+    std::string blob(size, '\0');
+    const std::string block = generate_random(4096);
+    for (size_t i = 0; i < size; ++i) {
+      blob[i] = block[(i + i / 4096) % block.size()];
+    }
+    blobs.emplace_back(std::move(blob));
+  }
+
+  AdaptiveCompressor compressor(std::make_shared<CompressionPolicy>());
+  std::string wire;
+  SendBlobs(compressor, blobs, wire);
+  VINEYARD_ASSERT(compressor.metrics().compressed_chunks > 0);
+
+  Decompressor decompressor;
+  size_t offset = 0;
+  for (auto const& expected : blobs) {
+    std::string blob(expected.size(), '\0');
+    ReceiveBlob(decompressor, wire, offset, blob);
+    VINEYARD_ASSERT(blob == expected);
+  }
+  // nothing is left in the wire for the next message
+  VINEYARD_ASSERT(offset == wire.size());
+  LOG(INFO) << "sent " << blobs.size() << " blobs in "
+            << compressor.metrics().compressed_chunks << " compressed and "
+            << compressor.metrics().uncompressed_chunks
+            << " uncompressed chunks";
+}
+
 int main(int argc, char** argv) {
   CompressSingleBlobTest();
+  AdaptiveCompressBackToBackTest();
 
   LOG(INFO) << "Passed compressor tests...";
   return 0;
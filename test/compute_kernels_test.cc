@@ -0,0 +1,221 @@
+/** Copyright 2020-2023 Alibaba Group Holding Limited.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+
+#include "basic/ds/arrow.h"
+#include "basic/ds/compute.h"
+#include "basic/ds/tensor.h"
+#include "client/client.h"
+#include "common/util/logging.h"
+
+using namespace vineyard;  // NOLINT(build/namespaces)
+
+template <typename T>
+std::shared_ptr<NumericArray<T>> seal_array(
+    Client& client, std::shared_ptr<arrow::Array> const& array) {
+  NumericArrayBuilder<T> builder(
+      client, std::dynamic_pointer_cast<ArrowArrayType<T>>(array));
+  std::shared_ptr<Object> object;
+  VINEYARD_CHECK_OK(builder.Seal(client, object));
+  return std::dynamic_pointer_cast<NumericArray<T>>(object);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("usage ./compute_kernels_test <ipc_socket>");
+    return 1;
+  }
+  std::string ipc_socket = std::string(argv[1]);
+
+  Client client;
+  VINEYARD_CHECK_OK(client.Connect(ipc_socket));
+  LOG(INFO) << "Connected to IPCServer: " << ipc_socket;
+
+  const int64_t length = 100003;
+  std::vector<compute::ComputeOptions> options(2);
+  options[1].concurrency = 4;
+  options[1].chunk_size = 4096;
+
+  {
+    LOG(INFO) << "#########  Reduction Test #############";
+    arrow::Int64Builder b1;
+    int64_t sum = 0, count = 0;
+    for (int64_t i = 0; i < length; ++i) {
+      if (i % 7 == 3) {
+        CHECK_ARROW_ERROR(b1.AppendNull());
+      } else {
+        CHECK_ARROW_ERROR(b1.Append(i - 1000));
+        sum += i - 1000;
+        count += 1;
+      }
+    }
+    std::shared_ptr<arrow::Array> a1;
+    CHECK_ARROW_ERROR(b1.Finish(&a1));
+    auto array = seal_array<int64_t>(client, a1);
+    // sliced arrays have unaligned validity bitmaps
+    auto sliced = seal_array<int64_t>(client, a1->Slice(5, length - 10));
+
+    for (auto const& opts : options) {
+      int64_t result = 0, min_value = 0, max_value = 0;
+      size_t num_values = 0;
+      VINEYARD_CHECK_OK(compute::Sum(*array, result, opts));
+      CHECK_EQ(result, sum);
+      VINEYARD_CHECK_OK(compute::Count(*array, num_values, opts));
+      CHECK_EQ(num_values, count);
+      VINEYARD_CHECK_OK(compute::Min(*array, min_value, opts));
+      CHECK_EQ(min_value, -1000);
+      VINEYARD_CHECK_OK(compute::Max(*array, max_value, opts));
+      CHECK_EQ(max_value, length - 1 - 1000);
+
+      int64_t sliced_sum = 0;
+      size_t sliced_count = 0;
+      for (int64_t i = 5; i < length - 5; ++i) {
+        if (i % 7 != 3) {
+          sliced_sum += i - 1000;
+          sliced_count += 1;
+        }
+      }
+      VINEYARD_CHECK_OK(compute::Sum(*sliced, result, opts));
+      CHECK_EQ(result, sliced_sum);
+      VINEYARD_CHECK_OK(compute::Count(*sliced, num_values, opts));
+      CHECK_EQ(num_values, sliced_count);
+      VINEYARD_CHECK_OK(compute::Min(*sliced, min_value, opts));
+      CHECK_EQ(min_value, 5 - 1000);
+    }
+
+    arrow::Int64Builder b2;
+    CHECK_ARROW_ERROR(b2.AppendNulls(10));
+    std::shared_ptr<arrow::Array> a2;
+    CHECK_ARROW_ERROR(b2.Finish(&a2));
+    auto nulls = seal_array<int64_t>(client, a2);
+    int64_t min_value = 0;
+    CHECK(compute::Min(*nulls, min_value).IsInvalid());
+
+    VINEYARD_CHECK_OK(client.DelData({array->id(), sliced->id(), nulls->id()},
+                                     false, true));
+    LOG(INFO) << "Passed reduction tests...";
+  }
+
+  {
+    LOG(INFO) << "#########  Filter/Take/Cast Test #############";
+    arrow::DoubleBuilder b1;
+    arrow::BooleanBuilder b2;
+    arrow::Int64Builder b3;
+    for (int64_t i = 0; i < length; ++i) {
+      CHECK_ARROW_ERROR(b1.Append(i * 0.5));
+      if (i % 11 == 0) {
+        CHECK_ARROW_ERROR(b2.AppendNull());
+      } else {
+        CHECK_ARROW_ERROR(b2.Append(i % 3 != 0));
+      }
+      CHECK_ARROW_ERROR(b3.Append((i * 7919) % length));
+    }
+    std::shared_ptr<arrow::Array> a1, a2, a3;
+    CHECK_ARROW_ERROR(b1.Finish(&a1));
+    CHECK_ARROW_ERROR(b2.Finish(&a2));
+    CHECK_ARROW_ERROR(b3.Finish(&a3));
+    auto array = seal_array<double>(client, a1);
+    auto indices = seal_array<int64_t>(client, a3);
+    BooleanArrayBuilder mask_builder(
+        client, std::dynamic_pointer_cast<arrow::BooleanArray>(a2));
+    auto mask = std::dynamic_pointer_cast<BooleanArray>(
+        mask_builder.Seal(client));
+
+    for (auto const& opts : options) {
+      std::shared_ptr<NumericArray<double>> filtered;
+      VINEYARD_CHECK_OK(compute::Filter(client, *array, *mask, filtered, opts));
+      size_t index = 0;
+      for (int64_t i = 0; i < length; ++i) {
+        if (i % 11 != 0 && i % 3 != 0) {
+          CHECK_EQ(filtered->raw_values()[index++], i * 0.5);
+        }
+      }
+      CHECK_EQ(filtered->length(), index);
+
+      std::shared_ptr<NumericArray<double>> taken;
+      VINEYARD_CHECK_OK(compute::Take(client, *array, *indices, taken, opts));
+      CHECK_EQ(taken->length(), length);
+      for (int64_t i = 0; i < length; ++i) {
+        CHECK_EQ(taken->raw_values()[i], ((i * 7919) % length) * 0.5);
+      }
+
+      std::shared_ptr<NumericArray<int32_t>> casted;
+      VINEYARD_CHECK_OK(compute::Cast(client, *array, casted, opts));
+      CHECK_EQ(casted->length(), length);
+      for (int64_t i = 0; i < length; ++i) {
+        CHECK_EQ(casted->raw_values()[i], static_cast<int32_t>(i * 0.5));
+      }
+      VINEYARD_CHECK_OK(client.DelData(
+          {filtered->id(), taken->id(), casted->id()}, false, true));
+    }
+
+    // out-of-bound indices
+    std::shared_ptr<NumericArray<double>> taken;
+    std::shared_ptr<arrow::Array> a4;
+    arrow::Int64Builder b4;
+    CHECK_ARROW_ERROR(b4.AppendValues({0, length}));
+    CHECK_ARROW_ERROR(b4.Finish(&a4));
+    auto invalid_indices = seal_array<int64_t>(client, a4);
+    CHECK(compute::Take(client, *array, *invalid_indices, taken).IsInvalid());
+
+    VINEYARD_CHECK_OK(client.DelData({array->id(), indices->id(), mask->id(),
+                                      invalid_indices->id()},
+                                     false, true));
+    LOG(INFO) << "Passed filter/take/cast tests...";
+  }
+
+  {
+    LOG(INFO) << "#########  Tensor Test #############";
+    TensorBuilder<int32_t> builder(client, {100, 101});
+    int64_t sum = 0;
+    for (int32_t i = 0; i < 100 * 101; ++i) {
+      builder.data()[i] = i - 5000;
+      sum += i - 5000;
+    }
+    auto tensor =
+        std::dynamic_pointer_cast<Tensor<int32_t>>(builder.Seal(client));
+    for (auto const& opts : options) {
+      int64_t result = 0;
+      int32_t min_value = 0, max_value = 0;
+      VINEYARD_CHECK_OK(compute::Sum(*tensor, result, opts));
+      CHECK_EQ(result, sum);
+      VINEYARD_CHECK_OK(compute::Min(*tensor, min_value, opts));
+      CHECK_EQ(min_value, -5000);
+      VINEYARD_CHECK_OK(compute::Max(*tensor, max_value, opts));
+      CHECK_EQ(max_value, 100 * 101 - 1 - 5000);
+
+      std::shared_ptr<Tensor<double>> casted;
+      VINEYARD_CHECK_OK(compute::Cast(client, *tensor, casted, opts));
+      CHECK(casted->shape() == tensor->shape());
+      for (int32_t i = 0; i < 100 * 101; ++i) {
+        CHECK_EQ(casted->data()[i], i - 5000.0);
+      }
+      VINEYARD_CHECK_OK(client.DelData(casted->id(), false, true));
+    }
+    VINEYARD_CHECK_OK(client.DelData(tensor->id(), false, true));
+    LOG(INFO) << "Passed tensor tests...";
+  }
+
+  LOG(INFO) << "Passed compute kernels tests...";
+
+  client.Disconnect();
+
+  return 0;
+}
@@ -38,7 +38,7 @@ void testing_memcpy(const size_t size) {
     if (size_to_test > size) {
       continue;
     }
-    for (size_t concurrency = 1; concurrency <= 8; ++concurrency) {
+    for (size_t concurrency = 0; concurrency <= 8; ++concurrency) {
       memset(dst.get(), 0, size_to_test);
       memory::concurrent_memcpy(dst.get(), src.get(), size_to_test,
                                 concurrency);
@@ -149,6 +149,25 @@ int main(int argc, char** argv) {
     }
   }
 
+  // get the dataframe with only the column 'b' and 2
+  {
+    std::shared_ptr<DataFrame> projected;
+    VINEYARD_CHECK_OK(client.GetObject(seal_df->id(), {"2", "b"}, projected));
+    auto const& columns = projected->Columns();
+    CHECK_EQ(columns.size(), 2);
+    CHECK_EQ(columns[0], 2);
+    CHECK_EQ(columns[1], "b");
+
+    auto column_b =
+        std::dynamic_pointer_cast<Tensor<int64_t>>(projected->Column("b"));
+    CHECK_EQ(column_b->shape()[0], 100);
+    auto data = column_b->data();
+    for (size_t i = 0; i < 100; ++i) {
+      CHECK_EQ(data[i], i * i * i);
+    }
+    CHECK(client.GetObject(seal_df->id(), {"c"}, projected).IsKeyError());
+  }
+
   LOG(INFO) << "Passed dataframe tests...";
 
   client.Disconnect();
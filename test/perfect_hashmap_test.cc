@@ -16,6 +16,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
@@ -71,6 +72,49 @@ int main(int argc, char** argv) {
 
   LOG(INFO) << "Passed double perfect hashmap tests...";
 
+  {
+    // tuned building of a larger map, reloaded from the aligned blob
+    const int64_t n = 1000000;
+    std::vector<int64_t> large_keys(n);
+    for (int64_t i = 0; i < n; ++i) {
+      large_keys[i] = i * 7919 + 3;
+    }
+    for (double gamma : {1.0, 2.5}) {
+      PerfectHashmapBuilder<int64_t, int64_t> large_builder(client);
+      large_builder.set_concurrency(4);
+      large_builder.set_gamma(gamma);
+      large_builder.set_fastmode_ratio(gamma > 2.0 ? 0.03f : 0.0f);
+      VINEYARD_CHECK_OK(large_builder.ComputeHash(client, large_keys.data(),
+                                                  static_cast<int64_t>(0), n));
+      auto sealed = std::dynamic_pointer_cast<PerfectHashmap<int64_t, int64_t>>(
+          large_builder.Seal(client));
+      auto loaded = std::dynamic_pointer_cast<PerfectHashmap<int64_t, int64_t>>(
+          client.GetObject(sealed->id()));
+      CHECK_EQ(loaded->size(), static_cast<size_t>(n));
+      for (int64_t i = 0; i < n; ++i) {
+        CHECK_EQ(i, sealed->at(large_keys[i]));
+        CHECK_EQ(i, loaded->at(large_keys[i]));
+      }
+      for (int64_t i = 0; i < n; i += 1000) {
+        CHECK_EQ(loaded->count(large_keys[i] + 1), 0);
+      }
+      VINEYARD_CHECK_OK(client.DelData(sealed->id(), true, true));
+    }
+  }
+
+  {
+    PerfectHashmapBuilder<int64_t, int64_t> empty_builder(client);
+    VINEYARD_CHECK_OK(empty_builder.ComputeHash(
+        client, static_cast<const int64_t*>(nullptr), static_cast<int64_t>(0),
+        0));
+    auto empty = std::dynamic_pointer_cast<PerfectHashmap<int64_t, int64_t>>(
+        client.GetObject(empty_builder.Seal(client)->id()));
+    CHECK(empty->empty());
+    CHECK_EQ(empty->count(1), 0);
+  }
+
+  LOG(INFO) << "Passed tuned and empty perfect hashmap tests...";
+
   client.Disconnect();
 
   return 0;
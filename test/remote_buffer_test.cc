@@ -14,8 +14,10 @@ limitations under the License.
 */
 
 #include <memory>
+#include <random>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
@@ -131,6 +133,89 @@ void RemoteCreateAndGetTest(Client& ipc_client, RPCClient& rpc_client) {
   LOG(INFO) << "Passed remote buffer (remote create & remote get) tests...";
 }
 
+void RemoteStripedCreateAndGetTest(Client& ipc_client,
+                                   RPCClient& rpc_client) {
+  // chunks of 1000 bytes over 3 connections, with an uneven tail
+  VINEYARD_CHECK_OK(rpc_client.SetTransferConcurrency(3, 1000));
+
+  std::vector<ObjectID> blob_ids;
+  std::vector<std::string> contents;
+  for (size_t size : {10, 2999, 12345, 100000}) {
+    std::string content(size, '\0');
+    for (size_t index = 0; index < size; ++index) {
+      content[index] = static_cast<char>((index * 31 + size) % 251);
+    }
+    auto remote_blob_writer = std::make_shared<RemoteBlobWriter>(size);
+    std::memcpy(remote_blob_writer->data(), content.data(), size);
+    ObjectID blob_id = InvalidObjectID();
+    VINEYARD_CHECK_OK(rpc_client.CreateRemoteBlob(remote_blob_writer, blob_id));
+    CHECK_NE(blob_id, InvalidObjectID());
+
+    // check with the local buffer
+    std::shared_ptr<Blob> local_buffer;
+    VINEYARD_CHECK_OK(ipc_client.GetBlob(blob_id, local_buffer));
+    CHECK_EQ(local_buffer->allocated_size(), size);
+    CHECK_EQ(std::string(local_buffer->data(), size), content);
+
+    blob_ids.emplace_back(blob_id);
+    contents.emplace_back(content);
+  }
+
+  // get remote buffers, with duplicated ids
+  std::vector<ObjectID> ids = blob_ids;
+  ids.emplace_back(blob_ids[0]);
+  std::vector<std::shared_ptr<RemoteBlob>> remote_buffers;
+  VINEYARD_CHECK_OK(rpc_client.GetRemoteBlobs(ids, remote_buffers));
+  CHECK_EQ(remote_buffers.size(), ids.size());
+  for (size_t index = 0; index < ids.size(); ++index) {
+    auto const& content = contents[index % blob_ids.size()];
+    CHECK_EQ(remote_buffers[index]->id(), ids[index]);
+    CHECK_EQ(remote_buffers[index]->allocated_size(), content.size());
+    CHECK_EQ(std::string(remote_buffers[index]->data(), content.size()),
+             content);
+  }
+
+  VINEYARD_CHECK_OK(rpc_client.SetTransferConcurrency(1));
+  LOG(INFO) << "Passed remote buffer (striped create & get) tests...";
+}
+
+void RemoteMixedContentTest(Client& ipc_client, RPCClient& rpc_client) {
+  // random and zero-filled megabytes, to make blocks take different codecs
+  const size_t size = 9 * 1024 * 1024 + 123;
+  std::string content(size, '\0');
+  std::mt19937 rng(42);
+  for (size_t index = 0; index < size; ++index) {
+    if ((index >> 20) % 2 == 0) {
+      content[index] = static_cast<char>(rng());
+    }
+  }
+
+  size_t uploaded = rpc_client.upload_metrics().raw_bytes;
+  size_t downloaded = rpc_client.download_metrics().raw_bytes;
+
+  auto remote_blob_writer = std::make_shared<RemoteBlobWriter>(size);
+  std::memcpy(remote_blob_writer->data(), content.data(), size);
+  ObjectID blob_id = InvalidObjectID();
+  VINEYARD_CHECK_OK(rpc_client.CreateRemoteBlob(remote_blob_writer, blob_id));
+  std::shared_ptr<Blob> local_buffer;
+  VINEYARD_CHECK_OK(ipc_client.GetBlob(blob_id, local_buffer));
+  CHECK_EQ(local_buffer->allocated_size(), size);
+  CHECK_EQ(std::string(local_buffer->data(), size), content);
+
+  std::shared_ptr<RemoteBlob> remote_buffer;
+  VINEYARD_CHECK_OK(rpc_client.GetRemoteBlob(blob_id, remote_buffer));
+  CHECK_EQ(remote_buffer->allocated_size(), size);
+  CHECK_EQ(std::string(remote_buffer->data(), size), content);
+
+  CHECK_EQ(rpc_client.upload_metrics().raw_bytes, uploaded + size);
+  CHECK_EQ(rpc_client.download_metrics().raw_bytes, downloaded + size);
+  CHECK_GT(rpc_client.upload_metrics().bandwidth(), 0);
+  LOG(INFO) << "Upload: " << rpc_client.upload_metrics().bandwidth()
+            << " bytes/s, compression ratio "
+            << rpc_client.upload_metrics().compression_ratio();
+  LOG(INFO) << "Passed remote buffer (mixed content) tests...";
+}
+
 int main(int argc, char** argv) {
   if (argc < 3) {
     printf("usage ./remote_buffer_test <ipc_socket> <rpc_endpoint>");
@@ -150,6 +235,8 @@ int main(int argc, char** argv) {
   RemoteCreateTest(ipc_client, rpc_client);
   RemoteGetTest(ipc_client, rpc_client);
   RemoteCreateAndGetTest(ipc_client, rpc_client);
+  RemoteStripedCreateAndGetTest(ipc_client, rpc_client);
+  RemoteMixedContentTest(ipc_client, rpc_client);
 
   LOG(INFO) << "Passed remote buffer tests...";
 
@@ -212,6 +212,7 @@ def start_vineyardd(
     spill_path="",
     spill_upper_rate=0.8,
     spill_lower_rate=0.3,
+    compress_cold_objects=False,
     **kw,
 ):
     rpc_socket_port = find_port()
@@ -227,6 +228,8 @@ def start_vineyardd(
         spill_settings = ['--spill_path', spill_path]
     else:
         spill_settings = []
+    if compress_cold_objects:
+        spill_settings.extend(['--compress_cold_objects', 'true'])
     with contextlib.ExitStack() as stack:
         proc = start_program(
             'vineyardd',
@@ -432,7 +435,11 @@ def run_vineyard_cpp_tests(meta, allocator, endpoints, tests):
         # FIXME: cannot be safely dtor after #350 and #354.
         # run_test('allocator_test')
         run_test(tests, 'arrow_data_structure_test')
+        run_test(tests, 'arrow_memory_pool_test')
         run_test(tests, 'clear_test')
+        run_test(tests, 'compressed_string_array_test')
+        run_test(tests, 'compressor_test')
+        run_test(tests, 'compute_kernels_test')
         run_test(tests, 'concurrent_memcpy_test')
         run_test(tests, 'custom_vector_test')
         run_test(tests, 'dataframe_test')
@@ -489,6 +496,19 @@ def run_vineyard_spill_tests(meta, allocator, endpoints, tests):
         run_test(tests, 'spill_test')
 
 
+def run_vineyard_cold_compression_tests(meta, allocator, endpoints, tests):
+    meta_prefix = 'vineyard_test_%s' % time.time()
+    metadata_settings = make_metadata_settings(meta, endpoints, meta_prefix)
+    with start_vineyardd(
+        metadata_settings,
+        ['--allocator', allocator],
+        size=16 * 1024 * 1024,
+        default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
+        compress_cold_objects=True,
+    ):
+        run_test(tests, 'cold_compression_test')
+
+
 def run_graph_extend_test(tests):
     data_dir = os.getenv('VINEYARD_DATA_DIR')
     vdata = pd.read_csv(data_dir + '/p2p_v.csv')
@@ -524,6 +544,48 @@ def run_graph_tests(meta, allocator, endpoints, tests):
     ) as (_, rpc_socket_port):
         run_test(tests, 'arrow_fragment_test')
         run_graph_extend_test(tests)
+        run_test(
+            tests,
+            'arrow_fragment_streaming_test',
+            '$VINEYARD_DATA_DIR/p2p_v.csv',
+            '$VINEYARD_DATA_DIR/p2p_e.csv',
+            '1M',
+            nproc=2,
+        )
+        run_test(
+            tests,
+            'arrow_fragment_compact_edges_test',
+            '$VINEYARD_DATA_DIR/p2p_v.csv',
+            '$VINEYARD_DATA_DIR/p2p_e.csv',
+            nproc=2,
+        )
+        run_test(
+            tests,
+            'arrow_fragment_delta_edges_test',
+            '$VINEYARD_DATA_DIR/p2p_v.csv',
+            '$VINEYARD_DATA_DIR/p2p_e.csv',
+        )
+        run_test(
+            tests,
+            'arrow_fragment_reorder_test',
+            '$VINEYARD_DATA_DIR/p2p_v.csv',
+            '$VINEYARD_DATA_DIR/p2p_e.csv',
+            nproc=2,
+        )
+        run_test(
+            tests,
+            'arrow_fragment_compressed_oids_test',
+            '$VINEYARD_DATA_DIR/p2p_v.csv',
+            '$VINEYARD_DATA_DIR/p2p_e.csv',
+            nproc=2,
+        )
+        run_test(
+            tests,
+            'arrow_fragment_partitioner_test',
+            '$VINEYARD_DATA_DIR/p2p_v.csv',
+            '$VINEYARD_DATA_DIR/p2p_e.csv',
+            nproc=4,
+        )
         run_test(
             tests,
             'arrow_fragment_gar_test',
@@ -687,11 +749,14 @@ def run_python_deploy_tests(meta, allocator, endpoints, test_args, with_migratio
 
     instance_size = 2
     extra_args = []
+    server_args = ['--allocator', allocator]
     if with_migration:
         extra_args.append('--with-migration')
+        # the cache of remote blobs is disabled by default
+        server_args.extend(['--remote_blob_cache_rate', '0.1'])
     with start_multiple_vineyardd(
         metadata_settings,
-        ['--allocator', allocator],
+        server_args,
         default_ipc_socket=VINEYARD_CI_IPC_SOCKET,
         instance_size=instance_size,
         nowait=True,
@@ -913,6 +978,9 @@ def execute_tests(args):
         with start_metadata_engine(args.meta) as (_, endpoints):
             run_vineyard_cpp_tests(args.meta, args.allocator, endpoints, args.tests)
             run_vineyard_spill_tests(args.meta, args.allocator, endpoints, args.tests)
+            run_vineyard_cold_compression_tests(
+                args.meta, args.allocator, endpoints, args.tests
+            )
 
     if args.with_graph:
         with start_metadata_engine(args.meta) as (_, endpoints):
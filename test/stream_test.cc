@@ -13,10 +13,12 @@ See the License for the specific language governing permissions and
 limitations under the License.
 */
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "arrow/api.h"
 #include "arrow/io/api.h"
@@ -105,6 +107,72 @@ void testByteStream(Client& client, std::string const& ipc_socket) {
   }
 }
 
+void testByteStreamReadLine(Client& client, std::string const& ipc_socket) {
+  ObjectID stream_id = InvalidObjectID();
+  {
+    std::unordered_map<std::string, std::string> params{
+        {"kind", "test"}, {"test_name", "stream_test"}};
+    stream_id = StreamBuilder<ByteStream>::Make(client, params);
+    CHECK(stream_id != InvalidObjectID());
+  }
+
+  std::vector<std::string> lines;
+  std::string content;
+  for (size_t idx = 0; idx < 1000; ++idx) {
+    lines.emplace_back("line-" + std::to_string(idx) + "-" +
+                       std::string(idx % 37, 'x'));
+    content += lines.back() + "\n";
+  }
+  // the last line has no trailing '\n'
+  lines.emplace_back("the-last-line");
+  content += lines.back();
+
+  std::thread send_thrd([&]() {
+    Client writer_client;
+    VINEYARD_CHECK_OK(writer_client.Connect(ipc_socket));
+
+    auto byte_stream = writer_client.GetObject<ByteStream>(stream_id);
+    CHECK(byte_stream != nullptr);
+    VINEYARD_CHECK_OK(byte_stream->OpenWriter(&writer_client));
+
+    // small chunks with arbitrary boundaries to split records across chunks
+    byte_stream->SetBufferSizeLimit(97);
+    for (size_t offset = 0; offset < content.size(); offset += 13) {
+      size_t length = std::min<size_t>(13, content.size() - offset);
+      VINEYARD_CHECK_OK(
+          byte_stream->WriteBytes(content.data() + offset, length));
+    }
+    VINEYARD_CHECK_OK(byte_stream->FlushBuffer());
+    VINEYARD_CHECK_OK(byte_stream->Finish());
+  });
+
+  std::thread recv_thrd([&]() {
+    Client reader_client;
+    VINEYARD_CHECK_OK(reader_client.Connect(ipc_socket));
+
+    auto byte_stream = reader_client.GetObject<ByteStream>(stream_id);
+    CHECK(byte_stream != nullptr);
+    VINEYARD_CHECK_OK(byte_stream->OpenReader(&reader_client));
+
+    size_t index = 0;
+    while (true) {
+      arrow_string_view line;
+      auto status = byte_stream->ReadLine(line);
+      if (status.IsEndOfFile()) {
+        break;
+      }
+      VINEYARD_CHECK_OK(status);
+      CHECK_LT(index, lines.size());
+      CHECK_EQ(std::string(line.data(), line.size()), lines[index]);
+      index += 1;
+    }
+    CHECK_EQ(index, lines.size());
+  });
+
+  send_thrd.join();
+  recv_thrd.join();
+}
+
 void testByteStreamFailed(Client& client, std::string const& ipc_socket) {
   ObjectID stream_id = InvalidObjectID();
   {
@@ -304,6 +372,13 @@ int main(int argc, char** argv) {
   CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
   CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
 
+  testByteStreamReadLine(client, ipc_socket);
+  LOG(INFO) << "Passed bytestream readline test...";
+
+  VINEYARD_CHECK_OK(client.InstanceStatus(status_after));
+  CHECK_EQ(status_before->memory_limit, status_after->memory_limit);
+  CHECK_EQ(status_before->memory_usage, status_after->memory_usage);
+
   LOG(INFO) << "Passed stream tests...";
 
   client.Disconnect();
@@ -526,29 +526,34 @@ class bitVector {
   }
 
   ~bitVector() {
-    if (_bitArray != nullptr)
+    if (_bitArray != nullptr && !_borrowed)
       free(_bitArray);
   }
 
   // copy constructor
-  bitVector(bitVector const& r) {
-    _size = r._size;
-    _nchar = r._nchar;
-    _ranks = r._ranks;
-    _bitArray = (uint64_t*) calloc(_nchar, sizeof(uint64_t));
-    memcpy(_bitArray, r._bitArray, _nchar * sizeof(uint64_t));
-  }
+  bitVector(bitVector const& r) : _bitArray(nullptr), _size(0) { *this = r; }
 
   // Copy assignment operator
+  //
+  // Copies of a view (see `view()`) are views of the same memory as well.
   bitVector& operator=(bitVector const& r) {
     if (&r != this) {
+      if (_bitArray != nullptr && !_borrowed)
+        free(_bitArray);
       _size = r._size;
       _nchar = r._nchar;
-      _ranks = r._ranks;
-      if (_bitArray != nullptr)
-        free(_bitArray);
-      _bitArray = (uint64_t*) calloc(_nchar, sizeof(uint64_t));
-      memcpy(_bitArray, r._bitArray, _nchar * sizeof(uint64_t));
+      _borrowed = r._borrowed;
+      if (r._borrowed) {
+        _ranks.clear();
+        _bitArray = r._bitArray;
+        _rank_data = r._rank_data;
+        _nranks = r._nranks;
+      } else {
+        _ranks = r._ranks;
+        _bitArray = (uint64_t*) calloc(_nchar, sizeof(uint64_t));
+        memcpy(_bitArray, r._bitArray, _nchar * sizeof(uint64_t));
+        sync_ranks();
+      }
     }
     return *this;
   }
@@ -557,14 +562,21 @@ class bitVector {
   bitVector& operator=(bitVector&& r) {
     // printf("bitVector move assignment \n");
     if (&r != this) {
-      if (_bitArray != nullptr)
+      if (_bitArray != nullptr && !_borrowed)
         free(_bitArray);
 
       _size = std::move(r._size);
       _nchar = std::move(r._nchar);
       _ranks = std::move(r._ranks);
       _bitArray = r._bitArray;
+      _borrowed = r._borrowed;
       r._bitArray = nullptr;
+      if (_borrowed) {
+        _rank_data = r._rank_data;
+        _nranks = r._nranks;
+      } else {
+        sync_ranks();
+      }
     }
     return *this;
   }
@@ -573,8 +585,32 @@ class bitVector {
     *this = std::move(r);
   }
 
+  // Make the bit vector a read-only view of the bits and the ranks that are
+  // kept elsewhere, e.g., in a memory-mapped blob, without copying them.
+  void view(uint64_t size, uint64_t nchar, const uint64_t* bits,
+            const uint64_t* ranks, size_t nranks) {
+    if (_bitArray != nullptr && !_borrowed)
+      free(_bitArray);
+    _size = size;
+    _nchar = nchar;
+    _bitArray = const_cast<uint64_t*>(bits);
+    _ranks.clear();
+    _rank_data = ranks;
+    _nranks = nranks;
+    _borrowed = true;
+  }
+
+  bool borrowed() const { return _borrowed; }
+
   void resize(uint64_t newsize) {
     // printf("bitvector resize from  %llu bits to %llu \n",_size,newsize);
+    if (_borrowed) {
+      // detach from the viewed memory
+      _bitArray = nullptr;
+      _borrowed = false;
+      _ranks.clear();
+      sync_ranks();
+    }
     _nchar = (1ULL + newsize / 64ULL);
     _bitArray = (uint64_t*) realloc(_bitArray, _nchar * sizeof(uint64_t));
     _size = newsize;
@@ -583,7 +619,7 @@ class bitVector {
   size_t size() const { return _size; }
 
   uint64_t bitSize() const {
-    return (_nchar * 64ULL + _ranks.capacity() * 64ULL);
+    return (_nchar * 64ULL + _nranks * 64ULL);
   }
 
   // clear whole array
@@ -619,10 +655,10 @@ class bitVector {
     }
     printf("\n");
 
-    printf("rank array : size %lu \n", _ranks.size());
-    for (uint64_t ii = 0; ii < _ranks.size(); ii++) {
+    printf("rank array : size %lu \n", _nranks);
+    for (uint64_t ii = 0; ii < _nranks; ii++) {
       printf("%llu :  %lli,  ", (long long unsigned int) ii,
-             (long long int) _ranks[ii]);
+             (long long int) _rank_data[ii]);
     }
     printf("\n");
   }
@@ -672,6 +708,7 @@ class bitVector {
       }
       curent_rank += popcount_64(_bitArray[ii]);
     }
+    sync_ranks();
 
     return curent_rank;
   }
@@ -680,7 +717,7 @@ class bitVector {
     uint64_t word_idx = pos / 64ULL;
     uint64_t word_offset = pos % 64;
     uint64_t block = pos / _nb_bits_per_rank_sample;
-    uint64_t r = _ranks[block];
+    uint64_t r = _rank_data[block];
     for (uint64_t w = block * _nb_bits_per_rank_sample / 64; w < word_idx;
          ++w) {
       r += popcount_64(_bitArray[w]);
@@ -696,10 +733,10 @@ class bitVector {
     os.write(reinterpret_cast<char const*>(&_nchar), sizeof(_nchar));
     os.write(reinterpret_cast<char const*>(_bitArray),
              (std::streamsize)(sizeof(uint64_t) * _nchar));
-    size_t sizer = _ranks.size();
+    size_t sizer = _nranks;
     os.write(reinterpret_cast<char const*>(&sizer), sizeof(size_t));
-    os.write(reinterpret_cast<char const*>(_ranks.data()),
-             (std::streamsize)(sizeof(_ranks[0]) * _ranks.size()));
+    os.write(reinterpret_cast<char const*>(_rank_data),
+             (std::streamsize)(sizeof(uint64_t) * _nranks));
   }
 
   void load(std::istream& is) {
@@ -714,6 +751,7 @@ class bitVector {
     _ranks.resize(sizer);
     is.read(reinterpret_cast<char*>(_ranks.data()),
             (std::streamsize)(sizeof(_ranks[0]) * _ranks.size()));
+    sync_ranks();
   }
 
  protected:
@@ -728,6 +766,17 @@ class bitVector {
   // additional size for rank is epsilon * _size
   static const uint64_t _nb_bits_per_rank_sample = 512;  // 512 seems ok
   std::vector<uint64_t> _ranks;
+
+  // the ranks used by lookups, i.e., `_ranks`, or the viewed memory
+  const uint64_t* _rank_data = nullptr;
+  size_t _nranks = 0;
+  // whether `_bitArray` and `_rank_data` are views of outside memory
+  bool _borrowed = false;
+
+  void sync_ranks() {
+    _rank_data = _ranks.data();
+    _nranks = _ranks.size();
+  }
 };
 
 ////////////////////////////////////////////////////////////////
@@ -802,6 +851,13 @@ class mphf {
 
   ~mphf() {}
 
+  // the user-declared destructor suppresses the implicit move operations,
+  // which makes `bphf = mphf(...)` a deep copy of all levels
+  mphf(mphf const&) = default;
+  mphf(mphf&&) = default;
+  mphf& operator=(mphf const&) = default;
+  mphf& operator=(mphf&&) = default;
+
   // allow perc_elem_loaded  elements to be loaded in ram for faster
   // construction (default 3%), set to 0 to desactivate
   template <typename Range>